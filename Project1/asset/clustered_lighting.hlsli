@@ -0,0 +1,81 @@
+
+// クラスタ化ライティングの描画側（light_clusters.h / light_cluster_pass.h と対応）
+// ピクセルの属するクラスタを引き、そのクラスタに割り当てられたライトだけを足し合わせる
+// レジスタはインクルードする前に CLUSTER_CONSTANTS_REGISTER などを定義すれば変えられる
+
+#ifndef CLUSTER_CONSTANTS_REGISTER
+#define CLUSTER_CONSTANTS_REGISTER b1
+#endif
+#ifndef CLUSTER_LIGHTS_REGISTER
+#define CLUSTER_LIGHTS_REGISTER t1
+#endif
+#ifndef CLUSTER_RANGES_REGISTER
+#define CLUSTER_RANGES_REGISTER t2
+#endif
+#ifndef CLUSTER_INDICES_REGISTER
+#define CLUSTER_INDICES_REGISTER t3
+#endif
+
+struct ClusterLight
+{
+    float3 position; // ビュー空間
+    float radius;
+    float3 color;
+    float intensity;
+};
+
+cbuffer ClusterShadingConstants : register(CLUSTER_CONSTANTS_REGISTER)
+{
+    float4 clusterProjection;  // m00, m11, m22, m23
+    float2 clusterTilesPerPixel;
+    float clusterSliceScale;
+    float clusterSliceBias;
+    uint3 clusterTiles;        // 横・縦のタイル数、スライス数
+    uint clusterLightCount;
+};
+
+StructuredBuffer<ClusterLight> clusterLights : register(CLUSTER_LIGHTS_REGISTER);
+StructuredBuffer<uint2> clusterRanges : register(CLUSTER_RANGES_REGISTER);
+StructuredBuffer<uint> clusterIndices : register(CLUSTER_INDICES_REGISTER);
+
+// ピクセルの属するクラスタ（light_clusters.cpp の findCluster と同じ）
+uint findCluster(float2 pixel, float viewZ)
+{
+    const uint2 tile = min(uint2(max(pixel * clusterTilesPerPixel, 0.0)), clusterTiles.xy - 1);
+    const float slice = floor(log(max(viewZ, 1.0e-6)) * clusterSliceScale + clusterSliceBias);
+    const uint z = uint(clamp(slice, 0.0, float(clusterTiles.z - 1)));
+    return (z * clusterTiles.y + tile.y) * clusterTiles.x + tile.x;
+}
+
+// SV_Position からビュー空間の位置を戻す（z = m23 / (depth - m22)）
+float3 reconstructViewPosition(float4 svPosition)
+{
+    const float viewZ = clusterProjection.w / (svPosition.z - clusterProjection.z);
+    const float2 viewport = float2(clusterTiles.xy) / clusterTilesPerPixel;
+    const float2 ndc = float2(svPosition.x / viewport.x * 2.0 - 1.0, 1.0 - svPosition.y / viewport.y * 2.0);
+    return float3(ndc * viewZ / clusterProjection.xy, viewZ);
+}
+
+// 半径で 0 になる距離減衰（半径の外のライトを割り当てから外しても見た目が変わらない）
+float clusterAttenuation(float distance, float radius)
+{
+    const float ratio = saturate(1.0 - (distance * distance) / (radius * radius));
+    return ratio * ratio / (1.0 + distance * distance);
+}
+
+// ピクセルのクラスタに割り当てられたライトだけでランバート拡散を足し合わせる
+float3 shadeClusteredLights(float2 pixel, float3 viewPosition, float3 normal, float3 albedo)
+{
+    const uint2 range = clusterRanges[findCluster(pixel, viewPosition.z)];
+
+    float3 result = 0.0;
+    for (uint i = 0; i < range.y; ++i)
+    {
+        const ClusterLight light = clusterLights[clusterIndices[range.x + i]];
+        const float3 toLight = light.position - viewPosition;
+        const float distance = length(toLight);
+        const float lambert = saturate(dot(normal, toLight / max(distance, 1.0e-4)));
+        result += light.color * (light.intensity * lambert * clusterAttenuation(distance, light.radius));
+    }
+    return result * albedo;
+}
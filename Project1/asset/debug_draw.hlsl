@@ -0,0 +1,34 @@
+// デバッグ描画の線（debug_draw.h の DebugVertex と対応）
+// ライン リストで描き、色はそのまま塗る
+
+cbuffer DebugConstants : register(b0)
+{
+    float4 viewProjection[4]; // 行ごと（clip = M * p）
+};
+
+struct VS_IN
+{
+    float3 position : POSITION;
+    float4 color : COLOR;
+};
+
+struct PS_IN
+{
+    float4 pos : SV_POSITION;
+    float4 color : COLOR;
+};
+
+PS_IN vs(VS_IN input)
+{
+    const float4 world = float4(input.position, 1.0);
+
+    PS_IN o;
+    o.pos = float4(dot(viewProjection[0], world), dot(viewProjection[1], world), dot(viewProjection[2], world), dot(viewProjection[3], world));
+    o.color = input.color;
+    return o;
+}
+
+float4 ps(PS_IN input) : SV_TARGET
+{
+    return input.color;
+}
@@ -0,0 +1,159 @@
+
+// GPU 駆動描画のカリングと詰め込み（indirect_cull.cpp の cullAndCompact と同じ手順）
+// 1. cullCS    : 64 個ずつ視錐台と判定し、グループごとの可視数を数える
+// 2. scanCS    : グループの可視数を排他的累積和にして開始位置にし、総数を描画数バッファへ書く
+// 3. compactCS : グループ内の順番を保ってコマンドを書き込む
+// 原子的加算の順番に依存しないので、出力はオブジェクト順になり CPU 版と一致する
+
+#define GROUP_SIZE 64
+#define SCAN_SIZE 1024
+
+struct DrawObject
+{
+    float4 transform[3];
+    float4 color;
+    float4 bounds;       // 中心 XYZ, 半径
+    uint vertexCount;
+    uint startVertex;
+    uint2 reserved;
+};
+
+struct IndirectDrawCommand
+{
+    uint objectIndex;
+    uint vertexCountPerInstance;
+    uint instanceCount;
+    uint startVertexLocation;
+    uint startInstanceLocation;
+};
+
+cbuffer CullConstants : register(b0)
+{
+    float4 planes[6];
+    uint objectCount;
+    uint groupCount;
+};
+
+StructuredBuffer<DrawObject> objects : register(t0);
+RWStructuredBuffer<uint> visibility : register(u0);
+RWStructuredBuffer<uint> groupOffsets : register(u1);
+RWStructuredBuffer<IndirectDrawCommand> commands : register(u2);
+RWByteAddressBuffer drawCount : register(u3);
+
+groupshared uint gsCount;
+groupshared uint gsFlags[GROUP_SIZE];
+groupshared uint gsScan[SCAN_SIZE];
+groupshared uint gsCarry;
+
+bool isSphereInFrustum(float4 bounds)
+{
+    [unroll]
+    for (uint i = 0; i < 6; ++i)
+    {
+        // CPU 版と同じ評価順。precise で FMA への融合と並べ替えを禁止する
+        precise float distance = planes[i].x * bounds.x;
+        distance = distance + planes[i].y * bounds.y;
+        distance = distance + planes[i].z * bounds.z;
+        distance = distance + planes[i].w;
+        if (distance < -bounds.w)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void cullCS(uint3 groupId : SV_GroupID, uint groupIndex : SV_GroupIndex, uint3 dispatchId : SV_DispatchThreadID)
+{
+    if (groupIndex == 0)
+    {
+        gsCount = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (dispatchId.x < objectCount)
+    {
+        const uint visible = isSphereInFrustum(objects[dispatchId.x].bounds) ? 1 : 0;
+        visibility[dispatchId.x] = visible;
+        if (visible)
+        {
+            InterlockedAdd(gsCount, 1);
+        }
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    if (groupIndex == 0)
+    {
+        groupOffsets[groupId.x] = gsCount;
+    }
+}
+
+[numthreads(SCAN_SIZE, 1, 1)]
+void scanCS(uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex == 0)
+    {
+        gsCarry = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint base = 0; base < groupCount; base += SCAN_SIZE)
+    {
+        const uint index = base + groupIndex;
+        const uint value = index < groupCount ? groupOffsets[index] : 0;
+        gsScan[groupIndex] = value;
+        GroupMemoryBarrierWithGroupSync();
+
+        // Hillis-Steele の包含的累積和
+        for (uint offset = 1; offset < SCAN_SIZE; offset <<= 1)
+        {
+            const uint add = groupIndex >= offset ? gsScan[groupIndex - offset] : 0;
+            GroupMemoryBarrierWithGroupSync();
+            gsScan[groupIndex] += add;
+            GroupMemoryBarrierWithGroupSync();
+        }
+
+        if (index < groupCount)
+        {
+            groupOffsets[index] = gsCarry + gsScan[groupIndex] - value;
+        }
+        GroupMemoryBarrierWithGroupSync();
+        if (groupIndex == SCAN_SIZE - 1)
+        {
+            gsCarry += gsScan[groupIndex];
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (groupIndex == 0)
+    {
+        drawCount.Store(0, gsCarry);
+    }
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void compactCS(uint3 groupId : SV_GroupID, uint groupIndex : SV_GroupIndex, uint3 dispatchId : SV_DispatchThreadID)
+{
+    const uint visible = dispatchId.x < objectCount ? visibility[dispatchId.x] : 0;
+    gsFlags[groupIndex] = visible;
+    GroupMemoryBarrierWithGroupSync();
+
+    if (visible)
+    {
+        uint local = 0;
+        for (uint i = 0; i < groupIndex; ++i)
+        {
+            local += gsFlags[i];
+        }
+
+        const DrawObject object = objects[dispatchId.x];
+        IndirectDrawCommand command;
+        command.objectIndex = dispatchId.x;
+        command.vertexCountPerInstance = object.vertexCount;
+        command.instanceCount = 1;
+        command.startVertexLocation = object.startVertex;
+        command.startInstanceLocation = 0;
+        commands[groupOffsets[groupId.x] + local] = command;
+    }
+}
@@ -0,0 +1,48 @@
+
+// GPU 駆動描画の頂点・ピクセルシェーダ
+// オブジェクト番号は ExecuteIndirect のコマンドからルート定数で渡される
+
+struct DrawObject
+{
+    float4 transform[3];
+    float4 color;
+    float4 bounds;
+    uint vertexCount;
+    uint startVertex;
+    uint2 reserved;
+};
+
+cbuffer DrawConstants : register(b0)
+{
+    uint objectIndex;
+};
+
+StructuredBuffer<DrawObject> objects : register(t0);
+
+struct VS_IN
+{
+    float3 pos : POSITION;
+    float4 color : COLOR;
+};
+
+struct PS_IN
+{
+    float4 pos : SV_POSITION;
+    float4 color : COLOR;
+};
+
+PS_IN vs(VS_IN input)
+{
+    const DrawObject object = objects[objectIndex];
+    const float4 pos = float4(input.pos, 1.0);
+
+    PS_IN o;
+    o.pos = float4(dot(object.transform[0], pos), dot(object.transform[1], pos), dot(object.transform[2], pos), 1.0);
+    o.color = input.color * object.color;
+    return o;
+}
+
+float4 ps(PS_IN input) : SV_TARGET
+{
+    return input.color;
+}
@@ -0,0 +1,144 @@
+
+// クラスタ化ライティングのライト割り当て（light_clusters.cpp の assignLightsReference と同じ結果）
+// 1. countCS : クラスタごとに掛かるライトを数える
+// 2. scanCS  : ライト数を排他的累積和にしてライト番号の配列の開始位置にする
+// 3. fillCS  : もう一度判定して、ライト番号をライト順に書き込み、範囲を書く
+// 1 スレッドが 1 クラスタを受け持ち、ライトはグループで共有メモリに読み込んで使い回す
+
+#define GROUP_SIZE 64
+#define SCAN_SIZE 1024
+
+struct ClusterLight
+{
+    float3 position; // ビュー空間
+    float radius;
+    float3 color;
+    float intensity;
+};
+
+struct ClusterBounds
+{
+    float4 minimum;
+    float4 maximum;
+};
+
+cbuffer AssignConstants : register(b0)
+{
+    uint clusterCount;
+    uint lightCount;
+    uint indexCapacity;
+};
+
+StructuredBuffer<ClusterLight> lights : register(t0);
+StructuredBuffer<ClusterBounds> bounds : register(t1);
+RWStructuredBuffer<uint> offsets : register(u0);
+RWStructuredBuffer<uint2> ranges : register(u1);
+RWStructuredBuffer<uint> indices : register(u2);
+
+groupshared float4 gsLights[GROUP_SIZE];
+groupshared uint gsScan[SCAN_SIZE];
+groupshared uint gsCarry;
+
+bool isLightInCluster(float4 light, ClusterBounds cluster)
+{
+    // CPU 版と同じ評価順。precise で FMA への融合と並べ替えを禁止する
+    precise float3 d = max(max(cluster.minimum.xyz - light.xyz, light.xyz - cluster.maximum.xyz), 0.0);
+    precise float d2 = d.x * d.x + d.y * d.y;
+    d2 = d2 + d.z * d.z;
+    precise float r2 = light.w * light.w;
+    return d2 <= r2;
+}
+
+// ライトを GROUP_SIZE 個ずつ共有メモリに読み込み、クラスタと判定する
+// write が真なら indices[start + 見つかった数] に書き込む（容量を超えた分は書かない）
+uint assign(uint groupIndex, uint cluster, bool write, uint start)
+{
+    const bool active = cluster < clusterCount;
+    const ClusterBounds clusterBounds = bounds[active ? cluster : 0];
+
+    uint count = 0;
+    for (uint base = 0; base < lightCount; base += GROUP_SIZE)
+    {
+        const uint lightIndex = base + groupIndex;
+        if (lightIndex < lightCount)
+        {
+            const ClusterLight light = lights[lightIndex];
+            gsLights[groupIndex] = float4(light.position, light.radius);
+        }
+        GroupMemoryBarrierWithGroupSync();
+
+        const uint batch = min(lightCount - base, GROUP_SIZE);
+        for (uint i = 0; active && i < batch; ++i)
+        {
+            if (isLightInCluster(gsLights[i], clusterBounds))
+            {
+                if (write && start + count < indexCapacity)
+                {
+                    indices[start + count] = base + i;
+                }
+                ++count;
+            }
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+    return count;
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void countCS(uint groupIndex : SV_GroupIndex, uint3 dispatchId : SV_DispatchThreadID)
+{
+    const uint count = assign(groupIndex, dispatchId.x, false, 0);
+    if (dispatchId.x < clusterCount)
+    {
+        offsets[dispatchId.x] = count;
+    }
+}
+
+[numthreads(SCAN_SIZE, 1, 1)]
+void scanCS(uint groupIndex : SV_GroupIndex)
+{
+    if (groupIndex == 0)
+    {
+        gsCarry = 0;
+    }
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint base = 0; base < clusterCount; base += SCAN_SIZE)
+    {
+        const uint index = base + groupIndex;
+        const uint value = index < clusterCount ? offsets[index] : 0;
+        gsScan[groupIndex] = value;
+        GroupMemoryBarrierWithGroupSync();
+
+        // Hillis-Steele の包含的累積和
+        for (uint offset = 1; offset < SCAN_SIZE; offset <<= 1)
+        {
+            const uint add = groupIndex >= offset ? gsScan[groupIndex - offset] : 0;
+            GroupMemoryBarrierWithGroupSync();
+            gsScan[groupIndex] += add;
+            GroupMemoryBarrierWithGroupSync();
+        }
+
+        if (index < clusterCount)
+        {
+            offsets[index] = gsCarry + gsScan[groupIndex] - value;
+        }
+        GroupMemoryBarrierWithGroupSync();
+        if (groupIndex == SCAN_SIZE - 1)
+        {
+            gsCarry += gsScan[groupIndex];
+        }
+        GroupMemoryBarrierWithGroupSync();
+    }
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void fillCS(uint groupIndex : SV_GroupIndex, uint3 dispatchId : SV_DispatchThreadID)
+{
+    const uint start = dispatchId.x < clusterCount ? offsets[dispatchId.x] : 0;
+    const uint count = assign(groupIndex, dispatchId.x, true, start);
+    if (dispatchId.x < clusterCount)
+    {
+        ranges[dispatchId.x] = uint2(start, min(count, indexCapacity > start ? indexCapacity - start : 0));
+    }
+}
@@ -0,0 +1,46 @@
+// パーティクルのビルボード描画（particle_system.h の ParticleInstance と対応）
+// 頂点バッファは使わず、SV_VertexID (0～3) から四角形の角を作ってトライアングルストリップで描く
+// ビルボードはカメラの右と上の向きに広げるので、常に画面に正対する
+
+struct ParticleInstance
+{
+    float3 position;
+    float size;
+    float4 color;
+};
+
+cbuffer BillboardConstants : register(b0)
+{
+    float4 viewProjection[4]; // 行ごと（clip = M * p）
+    float4 right;             // カメラの右（xyz）
+    float4 up;                // カメラの上（xyz）
+};
+
+StructuredBuffer<ParticleInstance> instances : register(t0);
+
+struct PS_IN
+{
+    float4 pos : SV_POSITION;
+    float2 corner : TEXCOORD;
+    float4 color : COLOR;
+};
+
+PS_IN vs(uint vertexId : SV_VertexID, uint instanceId : SV_InstanceID)
+{
+    const ParticleInstance instance = instances[instanceId];
+    const float2 corner = float2(vertexId & 1, vertexId >> 1) * 2.0 - 1.0;
+    const float4 world = float4(instance.position + (right.xyz * corner.x + up.xyz * corner.y) * instance.size, 1.0);
+
+    PS_IN o;
+    o.pos = float4(dot(viewProjection[0], world), dot(viewProjection[1], world), dot(viewProjection[2], world), dot(viewProjection[3], world));
+    o.corner = corner;
+    o.color = instance.color;
+    return o;
+}
+
+float4 ps(PS_IN input) : SV_TARGET
+{
+    // 中心から縁へなめらかに消える丸
+    const float falloff = saturate(1.0 - dot(input.corner, input.corner));
+    return float4(input.color.rgb, input.color.a * falloff * falloff);
+}
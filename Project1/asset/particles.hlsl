@@ -0,0 +1,122 @@
+// パーティクルの GPU シミュレーション（particle_system.cpp の ParticleSystem::update と同じ積分）
+// 1. resetCS    : 書き込み先の生存数を 0 にする
+// 2. simulateCS : 読み込み元の生きているパーティクルを積分し、生き残ったものを書き込み先に追加する
+// 3. emitCS     : CPU が ParticleSystem::spawn で作った新しいパーティクルを書き込み先に追加する
+// 4. argsCS     : 書き込み先の生存数から DrawInstanced の間接引数を書く
+// 状態バッファは 2 本を毎フレーム入れ替えて使う。追加はアトミックなので並び順は CPU 版と一致しない
+
+#define GROUP_SIZE 64
+
+struct ParticleState
+{
+    float3 position;
+    float age;
+    float3 velocity;
+    float lifetime;
+    uint emitter;
+    uint3 reserved;
+};
+
+struct ParticleLook
+{
+    float4 startColor;
+    float4 endColor;
+    float startSize;
+    float endSize;
+    float2 reserved;
+};
+
+struct ParticleInstance
+{
+    float3 position;
+    float size;
+    float4 color;
+};
+
+cbuffer SimulateConstants : register(b0)
+{
+    float3 gravity;
+    float drag;
+    float3 wind;
+    float deltaTime;
+    uint capacity;
+    uint spawnCount;
+    uint sourceCounter; // 読み込み元の生存数の番号（書き込み先は反対側）
+};
+
+StructuredBuffer<ParticleState> spawned : register(t0);
+StructuredBuffer<ParticleLook> looks : register(t1);
+RWStructuredBuffer<ParticleState> source : register(u0);
+RWStructuredBuffer<ParticleState> destination : register(u1);
+RWStructuredBuffer<ParticleInstance> instances : register(u2);
+// 0, 4: 状態バッファ 2 本の生存数, 8～: DrawInstanced の間接引数
+RWByteAddressBuffer counters : register(u3);
+
+// 生き残ったパーティクルを書き込み先の末尾に追加し、描画するビルボードも書く（容量を超えた分は捨てる）
+void append(ParticleState particle)
+{
+    uint index;
+    counters.InterlockedAdd((sourceCounter ^ 1) * 4, 1, index);
+    if (index >= capacity)
+    {
+        return;
+    }
+    destination[index] = particle;
+
+    const ParticleLook look = looks[particle.emitter];
+    const float t = particle.age / particle.lifetime;
+    ParticleInstance instance;
+    instance.position = particle.position;
+    instance.size = look.startSize + (look.endSize - look.startSize) * t;
+    instance.color = look.startColor + (look.endColor - look.startColor) * t;
+    instances[index] = instance;
+}
+
+[numthreads(1, 1, 1)]
+void resetCS()
+{
+    counters.Store((sourceCounter ^ 1) * 4, 0);
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void simulateCS(uint3 id : SV_DispatchThreadID)
+{
+    // 追加の数は容量を超えることがあるので、書けた数で抑える
+    const uint count = min(counters.Load(sourceCounter * 4), capacity);
+    if (id.x >= count)
+    {
+        return;
+    }
+
+    // CPU 版と同じ評価順。precise で FMA への融合と並べ替えを禁止する
+    ParticleState particle = source[id.x];
+    precise float3 acceleration = gravity + (wind - particle.velocity) * drag;
+    precise float3 velocity = particle.velocity + acceleration * deltaTime;
+    precise float3 position = particle.position + velocity * deltaTime;
+    precise float age = particle.age + deltaTime;
+    if (!(age < particle.lifetime))
+    {
+        return;
+    }
+    particle.position = position;
+    particle.velocity = velocity;
+    particle.age = age;
+    append(particle);
+}
+
+[numthreads(GROUP_SIZE, 1, 1)]
+void emitCS(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x < spawnCount)
+    {
+        append(spawned[id.x]);
+    }
+}
+
+[numthreads(1, 1, 1)]
+void argsCS()
+{
+    // 頂点 4 つのトライアングルストリップを生存数だけインスタンス描画する
+    const uint count = min(counters.Load((sourceCounter ^ 1) * 4), capacity);
+    counters.Store4(8, uint4(4, count, 0, 0));
+}
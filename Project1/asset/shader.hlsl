@@ -1,7 +1,33 @@
+
+// パーミュテーション用の機能キー（shader_features.h と対応）
+// 定義が無い場合は従来と同じ頂点カラーそのままの出力になる
+#ifndef COLOR_SOURCE_VERTEX
+#define COLOR_SOURCE_VERTEX 0
+#define COLOR_SOURCE_POSITION 1
+#define COLOR_SOURCE_WHITE 2
+#endif
+#ifndef COLOR_SOURCE
+#define COLOR_SOURCE COLOR_SOURCE_VERTEX
+#endif
+#ifndef USE_GRAYSCALE
+#define USE_GRAYSCALE 0
+#endif
+#ifndef USE_INSTANCING
+#define USE_INSTANCING 0
+#endif
+
 struct VS_IN
 {
     float3 pos : POSITION;
     float4 color : COLOR;
+#if USE_INSTANCING
+    // スロット 1 のインスタンス単位データ（instance_batcher.h の InstanceData と同じ並び）
+    float4 instanceRow0 : INSTANCE_DATA0;
+    float4 instanceRow1 : INSTANCE_DATA1;
+    float4 instanceRow2 : INSTANCE_DATA2;
+    float4 instanceColor : INSTANCE_DATA3;
+    uint materialIndex : INSTANCE_DATA4;
+#endif
 };
 
 struct PS_IN
@@ -13,12 +39,30 @@ struct PS_IN
 PS_IN vs(VS_IN input)
 {
     PS_IN o;
+#if USE_INSTANCING
+    const float4 pos = float4(input.pos, 1.0);
+    o.pos = float4(dot(input.instanceRow0, pos), dot(input.instanceRow1, pos), dot(input.instanceRow2, pos), 1.0);
+#else
     o.pos = float4(input.pos, 1.0);
+#endif
+#if COLOR_SOURCE == COLOR_SOURCE_POSITION
+    o.color = float4(input.pos * 0.5 + 0.5, 1.0);
+#elif COLOR_SOURCE == COLOR_SOURCE_WHITE
+    o.color = float4(1.0, 1.0, 1.0, input.color.a);
+#else
     o.color = input.color;
+#endif
+#if USE_INSTANCING
+    o.color *= input.instanceColor;
+#endif
     return o;
 }
 
 float4 ps(PS_IN input) : SV_TARGET
 {
-    return input.color;
+    float4 color = input.color;
+#if USE_GRAYSCALE
+    color.rgb = dot(color.rgb, float3(0.299, 0.587, 0.114));
+#endif
+    return color;
 }
@@ -0,0 +1,22 @@
+
+// キャッシュのシャドウマップを Live アトラスのタイルに写す（shadow_atlas_texture.h と対応）
+// 深度テクスチャの CopyTextureRegion はサブリソース全体しか写せないので、タイルを覆う三角形で SV_Depth に書く
+// ビューポートとシザーは写し先のタイルに設定しておく
+
+cbuffer CopyConstants : register(b0)
+{
+    int2 sourceOffset; // 写し元のタイルの左上 - 写し先のタイルの左上（テクセル）
+};
+
+Texture2D<float> sourceDepth : register(t0);
+
+float4 vs(uint vertexId : SV_VertexID) : SV_POSITION
+{
+    const float2 corner = float2((vertexId << 1) & 2, vertexId & 2);
+    return float4(corner * float2(2.0, -2.0) + float2(-1.0, 1.0), 0.0, 1.0);
+}
+
+float ps(float4 pos : SV_POSITION) : SV_DEPTH
+{
+    return sourceDepth.Load(int3(int2(pos.xy) + sourceOffset, 0));
+}
@@ -0,0 +1,48 @@
+
+// スプライト描画（sprite_batch.h の SpriteInstance と対応）
+// 頂点バッファは使わず、SV_VertexID (0～3) から四角形の角を作ってトライアングルストリップで描く
+
+cbuffer SpriteConstants : register(b0)
+{
+    float2 inverseViewportSize; // 1 / ビューポートのピクセルサイズ
+};
+
+Texture2D spriteTexture : register(t0);
+SamplerState spriteSampler : register(s0);
+
+struct VS_IN
+{
+    uint vertexId : SV_VertexID;
+    float4 rect : INSTANCE_RECT;         // 中心 XY, 幅, 高さ
+    float4 uv : INSTANCE_UV;             // u0, v0, u1, v1
+    float2 rotation : INSTANCE_ROTATION; // cos, sin
+    float4 color : INSTANCE_COLOR;
+};
+
+struct PS_IN
+{
+    float4 pos : SV_POSITION;
+    float2 uv : TEXCOORD;
+    float4 color : COLOR;
+};
+
+PS_IN vs(VS_IN input)
+{
+    const float2 corner = float2(input.vertexId & 1, input.vertexId >> 1);
+    const float2 local = (corner - 0.5) * input.rect.zw;
+    const float2 rotated = float2(
+        local.x * input.rotation.x - local.y * input.rotation.y,
+        local.x * input.rotation.y + local.y * input.rotation.x);
+    const float2 pixel = input.rect.xy + rotated;
+
+    PS_IN o;
+    o.pos = float4(pixel * inverseViewportSize * float2(2.0, -2.0) + float2(-1.0, 1.0), 0.0, 1.0);
+    o.uv = lerp(input.uv.xy, input.uv.zw, corner);
+    o.color = input.color;
+    return o;
+}
+
+float4 ps(PS_IN input) : SV_TARGET
+{
+    return spriteTexture.Sample(spriteSampler, input.uv) * input.color;
+}
@@ -0,0 +1,53 @@
+// UI 描画（ui_batch.h の UiQuad と対応）
+// 頂点バッファは使わず、SV_VertexID (0～3) から四角形の角を作ってトライアングルストリップで描く
+// sdfRange が 0 なら単色、正ならアトラスの距離場から文字の輪郭を求める
+
+cbuffer UiConstants : register(b0)
+{
+    float2 inverseViewportSize; // 1 / ビューポートのピクセルサイズ
+};
+
+Texture2D<float> glyphAtlas : register(t0);
+SamplerState atlasSampler : register(s0);
+
+struct VS_IN
+{
+    uint vertexId : SV_VertexID;
+    float4 rect : QUAD_RECT;        // 左上 XY, 右下 XY
+    float4 uv : QUAD_UV;            // u0, v0, u1, v1
+    float4 color : QUAD_COLOR;
+    float sdfRange : QUAD_SDF_RANGE; // アトラスの値 0～1 が表す距離の幅（画面のピクセル）
+};
+
+struct PS_IN
+{
+    float4 pos : SV_POSITION;
+    float2 uv : TEXCOORD;
+    float4 color : COLOR;
+    nointerpolation float sdfRange : SDF_RANGE;
+};
+
+PS_IN vs(VS_IN input)
+{
+    const float2 corner = float2(input.vertexId & 1, input.vertexId >> 1);
+    const float2 pixel = lerp(input.rect.xy, input.rect.zw, corner);
+
+    PS_IN o;
+    o.pos = float4(pixel * inverseViewportSize * float2(2.0, -2.0) + float2(-1.0, 1.0), 0.0, 1.0);
+    o.uv = lerp(input.uv.xy, input.uv.zw, corner);
+    o.color = input.color;
+    o.sdfRange = input.sdfRange;
+    return o;
+}
+
+float4 ps(PS_IN input) : SV_TARGET
+{
+    float4 color = input.color;
+    if (input.sdfRange > 0.0)
+    {
+        // 輪郭 (0.5) からの距離を画面のピクセルに直し、1 ピクセル幅でなめらかにする
+        const float distance = (glyphAtlas.Sample(atlasSampler, input.uv) - 0.5) * input.sdfRange;
+        color.a *= saturate(distance + 0.5);
+    }
+    return color;
+}
@@ -0,0 +1,33 @@
+
+// 縮小して描いたシーンを画面全体に引き伸ばす（scaled_render_target.h と対応）
+// 頂点バッファは使わず、SV_VertexID (0～2) から画面を覆う三角形を作る
+
+cbuffer UpscaleConstants : register(b0)
+{
+    float2 uvScale; // 描いた範囲の幅・高さ / テクスチャの幅・高さ
+    float2 uvMax;   // サンプルする UV の上限（描いた範囲の外をにじませない）
+};
+
+Texture2D sceneTexture : register(t0);
+SamplerState sceneSampler : register(s0);
+
+struct PS_IN
+{
+    float4 pos : SV_POSITION;
+    float2 uv : TEXCOORD;
+};
+
+PS_IN vs(uint vertexId : SV_VertexID)
+{
+    const float2 corner = float2((vertexId << 1) & 2, vertexId & 2);
+
+    PS_IN o;
+    o.pos = float4(corner * float2(2.0, -2.0) + float2(-1.0, 1.0), 0.0, 1.0);
+    o.uv = corner * uvScale;
+    return o;
+}
+
+float4 ps(PS_IN input) : SV_TARGET
+{
+    return sceneTexture.SampleLevel(sceneSampler, min(input.uv, uvMax), 0);
+}
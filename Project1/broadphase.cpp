@@ -0,0 +1,477 @@
+// Փ˂̃u[htF[YiXC[vAhv[j
+
+#include "broadphase.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define BROADPHASE_SSE 1
+#include <immintrin.h>
+#endif
+#if defined(__AVX2__)
+#define BROADPHASE_AVX2 1
+#endif
+
+namespace {
+
+/// 񏈗 1 ͈͂̐̕
+constexpr uint32_t RangeSize = 1024;
+/// т̕î̕ς̑傫̔{j
+constexpr double SlabWidthScale = 4.0;
+/// т̐̏
+constexpr uint32_t MaxSlabs = 64;
+/// т̌̔ԕ̐iSIMD ̕j
+constexpr uint32_t SentinelCount = 8;
+/// }\[gœĂ悢񐔁i̐̔{Bגj
+constexpr uint64_t InsertionBudget = 8;
+/// ς镪U̔i߂̊ԂŖt[גȂ悤Ɂj
+constexpr double AxisHysteresis = 1.2;
+
+/// 폜̂̋E{bNXiŏWȂ̂ŕт̖֍sAƂdȂȂj
+constexpr Aabb EmptyBounds = {
+    { std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() },
+    { -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() },
+};
+
+/// т̕
+struct SlabGrid {
+    float    origin;         ///< ŏ̑т̎n܂
+    float    inverseWidth;   ///< т̋̕t
+    float    lastSlab;       ///< Ō̑т̔ԍ
+    uint32_t slab;           ///< |Ă
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	W̓т߂
+ * @details	SIMD łƓZ̏ɂāAg𐔂т̔肪߃Zbgɂ炸ɂȂ悤ɂ
+ */
+inline uint32_t slabOf(const SlabGrid& grid, float value) noexcept {
+    const float t = std::min(std::max((value - grid.origin) * grid.inverseWidth, 0.0f), grid.lastSlab);
+    return static_cast<uint32_t>(t);
+}
+
+/// т̒̕т̏̋E̔z
+struct SweepArrays {
+    const float*    minA;    ///< ׂĂ鎲̍ŏW
+    const float*    maxA;    ///< ׂĂ鎲̍őW
+    const float*    minB;    ///< т̎̍ŏW
+    const float*    maxB;    ///< т̎̍őW
+    const float*    minC;    ///< c̎̍ŏW
+    const float*    maxC;    ///< c̎̍őW
+    const uint32_t* bodies;  ///< ̔ԍ
+    uint32_t        count;   ///< ̐iɔԕj
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	gǉiԍ̏ a ɂj
+ */
+inline void addPair(std::vector<BroadphasePair>& pairs, uint32_t a, uint32_t b) {
+    pairs.push_back(a < b ? BroadphasePair{ a, b } : BroadphasePair{ b, a });
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	т̒ [begin, end) ̂̑̕gTiXJ[Łj
+ * @details	т̎̏dȂ̎n܂i2 ̍ŏW̑傫j̑тɂg𐔂
+ */
+void sweepScalar(const SweepArrays& s, const SlabGrid& grid, uint32_t begin, uint32_t end, std::vector<BroadphasePair>& pairs) {
+    for (uint32_t k = begin; k < end; ++k) {
+        const float maxA = s.maxA[k];
+        const float minB = s.minB[k], maxB = s.maxB[k];
+        const float minC = s.minC[k], maxC = s.maxC[k];
+        for (uint32_t j = k + 1; j < s.count && s.minA[j] <= maxA; ++j) {
+            if (s.minB[j] <= maxB && s.maxB[j] >= minB && s.minC[j] <= maxC && s.maxC[j] >= minC &&
+                slabOf(grid, std::max(s.minB[j], minB)) == grid.slab) {
+                addPair(pairs, s.bodies[k], s.bodies[j]);
+            }
+        }
+    }
+}
+
+#if BROADPHASE_SSE
+//---------------------------------------------------------------------------------
+/**
+ * @brief	т̒ [begin, end) ̂̑̕g SSE  4 T
+ * @details	ׂĂ鎲ŏdȂȂȂ̂͑SďdȂȂ̂ŁA4 ̂ǂꂩOꂽł؂
+ *			т̌̔ԕ͍ŏWȂ̂ŁAǂ݉߂ĂKO
+ */
+void sweepSse(const SweepArrays& s, const SlabGrid& grid, uint32_t begin, uint32_t end, std::vector<BroadphasePair>& pairs) {
+    const __m128  origin = _mm_set1_ps(grid.origin);
+    const __m128  inverseWidth = _mm_set1_ps(grid.inverseWidth);
+    const __m128  lastSlab = _mm_set1_ps(grid.lastSlab);
+    const __m128  zero = _mm_setzero_ps();
+    const __m128i slab = _mm_set1_epi32(static_cast<int>(grid.slab));
+    for (uint32_t k = begin; k < end; ++k) {
+        const __m128 maxA = _mm_set1_ps(s.maxA[k]);
+        const __m128 minB = _mm_set1_ps(s.minB[k]), maxB = _mm_set1_ps(s.maxB[k]);
+        const __m128 minC = _mm_set1_ps(s.minC[k]), maxC = _mm_set1_ps(s.maxC[k]);
+        for (uint32_t j = k + 1; j < s.count; j += 4) {
+            const __m128 inRange = _mm_cmple_ps(_mm_loadu_ps(s.minA + j), maxA);
+            const __m128 otherMinB = _mm_loadu_ps(s.minB + j);
+            __m128       overlap = _mm_and_ps(inRange, _mm_cmple_ps(otherMinB, maxB));
+            overlap = _mm_and_ps(overlap, _mm_cmpge_ps(_mm_loadu_ps(s.maxB + j), minB));
+            overlap = _mm_and_ps(overlap, _mm_cmple_ps(_mm_loadu_ps(s.minC + j), maxC));
+            overlap = _mm_and_ps(overlap, _mm_cmpge_ps(_mm_loadu_ps(s.maxC + j), minC));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(overlap));
+            if (mask) {
+                const __m128 t = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(_mm_max_ps(otherMinB, minB), origin), inverseWidth), zero), lastSlab);
+                mask &= static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_cvttps_epi32(t), slab))));
+                for (uint32_t lane = 0; lane < 4; ++lane) {
+                    if ((mask >> lane) & 1) {
+                        addPair(pairs, s.bodies[k], s.bodies[j + lane]);
+                    }
+                }
+            }
+            if (_mm_movemask_ps(inRange) != 0xF) {
+                break;
+            }
+        }
+    }
+}
+#endif
+
+#if BROADPHASE_AVX2
+//---------------------------------------------------------------------------------
+/**
+ * @brief	т̒ [begin, end) ̂̑̕g AVX2  8 T
+ */
+void sweepAvx2(const SweepArrays& s, const SlabGrid& grid, uint32_t begin, uint32_t end, std::vector<BroadphasePair>& pairs) {
+    const __m256  origin = _mm256_set1_ps(grid.origin);
+    const __m256  inverseWidth = _mm256_set1_ps(grid.inverseWidth);
+    const __m256  lastSlab = _mm256_set1_ps(grid.lastSlab);
+    const __m256  zero = _mm256_setzero_ps();
+    const __m256i slab = _mm256_set1_epi32(static_cast<int>(grid.slab));
+    for (uint32_t k = begin; k < end; ++k) {
+        const __m256 maxA = _mm256_set1_ps(s.maxA[k]);
+        const __m256 minB = _mm256_set1_ps(s.minB[k]), maxB = _mm256_set1_ps(s.maxB[k]);
+        const __m256 minC = _mm256_set1_ps(s.minC[k]), maxC = _mm256_set1_ps(s.maxC[k]);
+        for (uint32_t j = k + 1; j < s.count; j += 8) {
+            const __m256 inRange = _mm256_cmp_ps(_mm256_loadu_ps(s.minA + j), maxA, _CMP_LE_OQ);
+            const __m256 otherMinB = _mm256_loadu_ps(s.minB + j);
+            __m256       overlap = _mm256_and_ps(inRange, _mm256_cmp_ps(otherMinB, maxB, _CMP_LE_OQ));
+            overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(_mm256_loadu_ps(s.maxB + j), minB, _CMP_GE_OQ));
+            overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(_mm256_loadu_ps(s.minC + j), maxC, _CMP_LE_OQ));
+            overlap = _mm256_and_ps(overlap, _mm256_cmp_ps(_mm256_loadu_ps(s.maxC + j), minC, _CMP_GE_OQ));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(overlap));
+            if (mask) {
+                const __m256 t =
+                    _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_sub_ps(_mm256_max_ps(otherMinB, minB), origin), inverseWidth), zero), lastSlab);
+                mask &= static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_cvttps_epi32(t), slab))));
+                for (uint32_t lane = 0; lane < 8; ++lane) {
+                    if ((mask >> lane) & 1) {
+                        addPair(pairs, s.bodies[k], s.bodies[j + lane]);
+                    }
+                }
+            }
+            if (_mm256_movemask_ps(inRange) != 0xFF) {
+                break;
+            }
+        }
+    }
+}
+#endif
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Sč폜
+ */
+void SweepAndPrune::clear() noexcept {
+    bounds_.clear();
+    freeBodies_.clear();
+    order_.clear();
+    keys_.clear();
+    slabOffsets_.clear();
+    slabCounts_.clear();
+    tasks_.clear();
+    std::fill(std::begin(variance_), std::end(variance_), 0.0);
+    size_ = 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̂ǉ
+ * @param	bounds	E{bNX
+ * @return	̔ԍi폜ꂽԍg񂷁j
+ */
+uint32_t SweepAndPrune::add(const Aabb& bounds) {
+    ++size_;
+    // g񂷔ԍ͕тɎcĂ̂ŁA findPairs ̕גňʒu܂
+    if (!freeBodies_.empty()) {
+        const uint32_t body = freeBodies_.back();
+        freeBodies_.pop_back();
+        bounds_[body] = bounds;
+        return body;
+    }
+    const uint32_t body = static_cast<uint32_t>(bounds_.size());
+    bounds_.push_back(bounds);
+    order_.push_back(body);
+    keys_.push_back(0.0f);
+    return body;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̂폜
+ * @param	body	̔ԍ
+ */
+void SweepAndPrune::remove(uint32_t body) noexcept {
+    bounds_[body] = EmptyBounds;
+    freeBodies_.push_back(body);
+    --size_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̂̋E{bNXXV
+ * @param	body	̔ԍ
+ * @param	bounds	VE{bNX
+ */
+void SweepAndPrune::setBounds(uint32_t body, const Aabb& bounds) noexcept {
+    bounds_[body] = bounds;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	E{bNXdȂgSċ߂
+ * @param	pairs		ʁi㏑BgƂ a < bj
+ * @param	jobSystem	ɏꍇ̃WuVXe
+ * @param	simd		g߃Zbgiʂ͖߃Zbgɂ炸j
+ */
+void SweepAndPrune::findPairs(std::vector<BroadphasePair>& pairs, JobSystem* jobSystem, CullSimd simd) {
+    simd = simd > bestCullSimd() ? bestCullSimd() : simd;
+    sort();
+
+    // т͎̎c 2 ̂Ȗ傫
+    const uint32_t second = (axis_ + 1) % 3, third = (axis_ + 2) % 3;
+    const uint32_t slabAxis = variance_[second] >= variance_[third] ? second : third;
+    const uint32_t axes[3] = { axis_, slabAxis, 3 - axis_ - slabAxis };
+
+    // т͕̂̕̕ς̑傫 SlabWidthScale {iׂƑт܂̂j
+    float  lower = std::numeric_limits<float>::infinity(), upper = -std::numeric_limits<float>::infinity();
+    double sizeSum = 0.0;
+    for (uint32_t k = 0; k < size_; ++k) {
+        const Aabb& bounds = bounds_[order_[k]];
+        lower = std::min(lower, bounds.min[slabAxis]);
+        upper = std::max(upper, bounds.max[slabAxis]);
+        sizeSum += double(bounds.max[slabAxis]) - bounds.min[slabAxis];
+    }
+    uint32_t slabCount = 1;
+    if (size_ > 0 && sizeSum > 0.0) {
+        const double width = sizeSum / size_ * SlabWidthScale;
+        slabCount = static_cast<uint32_t>(std::clamp((double(upper) - lower) / width, 1.0, double(MaxSlabs)));
+    }
+    SlabGrid grid{ size_ > 0 ? lower : 0.0f, 1.0f, float(slabCount - 1), 0 };
+    if (slabCount > 1) {
+        grid.inverseWidth = static_cast<float>(slabCount / (double(upper) - lower));
+    }
+
+    // тƂɕт̏ɏW߁Aт̌ɔԕu
+    slabCounts_.assign(slabCount, 0);
+    for (uint32_t k = 0; k < size_; ++k) {
+        const Aabb& bounds = bounds_[order_[k]];
+        const uint32_t last = slabOf(grid, bounds.max[slabAxis]);
+        for (uint32_t slab = slabOf(grid, bounds.min[slabAxis]); slab <= last; ++slab) {
+            ++slabCounts_[slab];
+        }
+    }
+    slabOffsets_.resize(slabCount);
+    uint32_t total = 0;
+    for (uint32_t slab = 0; slab < slabCount; ++slab) {
+        slabOffsets_[slab] = total;
+        total += slabCounts_[slab] + SentinelCount;
+    }
+    for (auto& values : sweep_) {
+        values.resize(total);
+    }
+    sweepBodies_.resize(total);
+    std::vector<uint32_t>& cursors = slabCounts_;
+    std::fill(cursors.begin(), cursors.end(), 0u);
+    for (uint32_t k = 0; k < size_; ++k) {
+        const uint32_t body = order_[k];
+        const Aabb&    bounds = bounds_[body];
+        const uint32_t last = slabOf(grid, bounds.max[slabAxis]);
+        for (uint32_t slab = slabOf(grid, bounds.min[slabAxis]); slab <= last; ++slab) {
+            const uint32_t position = slabOffsets_[slab] + cursors[slab]++;
+            for (uint32_t a = 0; a < 3; ++a) {
+                sweep_[a * 2][position] = bounds.min[axes[a]];
+                sweep_[a * 2 + 1][position] = bounds.max[axes[a]];
+            }
+            sweepBodies_[position] = body;
+        }
+    }
+    for (uint32_t slab = 0; slab < slabCount; ++slab) {
+        const uint32_t end = slabOffsets_[slab] + slabCounts_[slab];
+        for (uint32_t position = end; position < end + SentinelCount; ++position) {
+            for (uint32_t a = 0; a < 3; ++a) {
+                sweep_[a * 2][position] = std::numeric_limits<float>::infinity();
+                sweep_[a * 2 + 1][position] = -std::numeric_limits<float>::infinity();
+            }
+            sweepBodies_[position] = 0;
+        }
+    }
+
+    // т̒̕т͈͂ɕĕɒT
+    tasks_.clear();
+    for (uint32_t slab = 0; slab < slabCount; ++slab) {
+        for (uint32_t begin = 0; begin < slabCounts_[slab]; begin += RangeSize) {
+            tasks_.push_back({ slab, begin, std::min(begin + RangeSize, slabCounts_[slab]) });
+        }
+    }
+    if (taskPairs_.size() < tasks_.size()) {
+        taskPairs_.resize(tasks_.size());
+    }
+    const auto sweep = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t index = begin; index < end; ++index) {
+            const SweepTask&             task = tasks_[index];
+            const uint32_t               offset = slabOffsets_[task.slab];
+            std::vector<BroadphasePair>& out = taskPairs_[index];
+            const SweepArrays            arrays{
+                sweep_[0].data() + offset, sweep_[1].data() + offset, sweep_[2].data() + offset, sweep_[3].data() + offset,
+                sweep_[4].data() + offset, sweep_[5].data() + offset, sweepBodies_.data() + offset, slabCounts_[task.slab],
+            };
+            SlabGrid slabGrid = grid;
+            slabGrid.slab = task.slab;
+            out.clear();
+            switch (simd) {
+#if BROADPHASE_AVX2
+            case CullSimd::Avx2:
+                sweepAvx2(arrays, slabGrid, task.begin, task.end, out);
+                break;
+#endif
+#if BROADPHASE_SSE
+            case CullSimd::Sse:
+                sweepSse(arrays, slabGrid, task.begin, task.end, out);
+                break;
+#endif
+            default:
+                sweepScalar(arrays, slabGrid, task.begin, task.end, out);
+                break;
+            }
+        }
+    };
+    const uint32_t taskCount = static_cast<uint32_t>(tasks_.size());
+    if (jobSystem) {
+        jobSystem->parallelFor(taskCount, 1, sweep);
+    }
+    else {
+        sweep(0, taskCount);
+    }
+
+    // Pʂ̏ɂȂ
+    size_t pairCount = 0;
+    for (uint32_t index = 0; index < taskCount; ++index) {
+        pairCount += taskPairs_[index].size();
+    }
+    pairs.clear();
+    pairs.reserve(pairCount);
+    for (uint32_t index = 0; index < taskCount; ++index) {
+        pairs.insert(pairs.end(), taskPairs_[index].begin(), taskPairs_[index].end());
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ׂĂ鎲擾
+ * @return	0 = XA1 = YA2 = Z
+ */
+uint32_t SweepAndPrune::axis() const noexcept {
+    return axis_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	O findPairs őSĕג
+ * @return	גĂ truei}\[gŒꍇ falsej
+ */
+bool SweepAndPrune::resorted() const noexcept {
+    return resorted_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	O findPairs ŕт̐擾
+ * @return	т̐i1 Ȃ番ĂȂj
+ */
+uint32_t SweepAndPrune::slabCount() const noexcept {
+    return static_cast<uint32_t>(slabOffsets_.size());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̐擾
+ * @return	̐i폜̂͊܂܂Ȃj
+ */
+uint32_t SweepAndPrune::size() const noexcept {
+    return size_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ׂ鎲IсAт𒼂
+ */
+void SweepAndPrune::sort() {
+    // S̕Uł傫ŕׂƁAׂĂ鎲ŏdȂi肷jgłȂȂ
+    double sum[3] = {}, squareSum[3] = {};
+    for (const Aabb& bounds : bounds_) {
+        if (!(bounds.min[0] <= bounds.max[0])) {
+            continue;
+        }
+        for (uint32_t a = 0; a < 3; ++a) {
+            const double center = (double(bounds.min[a]) + bounds.max[a]) * 0.5;
+            sum[a] += center;
+            squareSum[a] += center * center;
+        }
+    }
+    for (uint32_t a = 0; a < 3; ++a) {
+        const double mean = size_ ? sum[a] / size_ : 0.0;
+        variance_[a] = size_ ? squareSum[a] / size_ - mean * mean : 0.0;
+    }
+    const uint32_t best = static_cast<uint32_t>(std::max_element(variance_, variance_ + 3) - variance_);
+    bool           resort = false;
+    if (best != axis_ && variance_[best] > variance_[axis_] * AxisHysteresis) {
+        axis_ = best;
+        resort = true;
+    }
+
+    const uint32_t count = static_cast<uint32_t>(order_.size());
+    for (uint32_t k = 0; k < count; ++k) {
+        keys_[k] = bounds_[order_[k]].min[axis_];
+    }
+
+    // W͕̔ԍ̏ɂA}\[głגłтɂ
+    const auto less = [](float keyA, uint32_t bodyA, float keyB, uint32_t bodyB) {
+        return keyA < keyB || (keyA == keyB && bodyA < bodyB);
+    };
+    if (!resort) {
+        // Õt[̕т͂قڑĂ̂ő}\[gŒB񐔂\Z𒴂߂ĕג
+        uint64_t budget = InsertionBudget * count;
+        for (uint32_t k = 1; k < count && !resort; ++k) {
+            const float    key = keys_[k];
+            const uint32_t body = order_[k];
+            uint32_t       j = k;
+            for (; j > 0 && less(key, body, keys_[j - 1], order_[j - 1]); --j) {
+                keys_[j] = keys_[j - 1];
+                order_[j] = order_[j - 1];
+                if (--budget == 0) {
+                    resort = true;
+                    break;
+                }
+            }
+            keys_[j] = key;
+            order_[j] = body;
+        }
+    }
+    resorted_ = resort;
+    if (resort) {
+        std::sort(order_.begin(), order_.end(), [&](uint32_t a, uint32_t b) { return less(bounds_[a].min[axis_], a, bounds_[b].min[axis_], b); });
+        for (uint32_t k = 0; k < count; ++k) {
+            keys_[k] = bounds_[order_[k]].min[axis_];
+        }
+    }
+}
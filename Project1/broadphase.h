@@ -0,0 +1,126 @@
+// Փ˂̃u[htF[YiXC[vAhv[j
+
+#pragma once
+
+#include "bvh.h"
+#include "frustum_culling.h"
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+/// E{bNXdȂ镨̂̑gia < bj
+struct BroadphasePair {
+    uint32_t a;  ///< ̔ԍij
+    uint32_t b;  ///< ̔ԍi傫j
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	XC[vAhv[NX
+ * @details	̂ 1 ̎iS̕Uł傫j̍ŏWŕׁAêցA
+ *			ŏW̍őW𒴂܂ł̂̕Ǝc 2 ̏dȂ SIMD ł܂Ƃ߂Ĕ肷
+ *			͖̂t[Ȃ̂ŁAÕt[̕т}\[gŒi傫ĂΕגj
+ *			̂ƕׂŏdȂ鑊肪Ȃ̂ŁA2 ԖڂɕȖ傫тɕAтƂɑ|
+ *			iт܂̂͗ɓBg 2 ̏dȂ̎n܂肪тł̂ŏdȂj
+ *			тƕт͈̔͂ƂɃWuVXeŕɒTA܂ɂȂ̂ŁA
+ *			g̕т̓Xbh▽߃Zbgɂ炸ɂȂ
+ *			E{bNX͕ԂƂĈiʂڂĂΏdȂjBW͗Lł邱
+ */
+class SweepAndPrune final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Sč폜
+     */
+    void clear() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̂ǉ
+     * @param	bounds	E{bNX
+     * @return	̔ԍi폜ꂽԍg񂷁j
+     */
+    uint32_t add(const Aabb& bounds);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̂폜
+     * @param	body	̔ԍ
+     */
+    void remove(uint32_t body) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̂̋E{bNXXV
+     * @param	body	̔ԍ
+     * @param	bounds	VE{bNX
+     */
+    void setBounds(uint32_t body, const Aabb& bounds) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	E{bNXdȂgSċ߂
+     * @param	pairs		ʁi㏑BgƂ a < bj
+     * @param	jobSystem	ɏꍇ̃WuVXe
+     * @param	simd		g߃Zbgiʂ͖߃Zbgɂ炸j
+     */
+    void findPairs(std::vector<BroadphasePair>& pairs, JobSystem* jobSystem = nullptr, CullSimd simd = bestCullSimd());
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ׂĂ鎲擾
+     * @return	0 = XA1 = YA2 = Z
+     */
+    [[nodiscard]] uint32_t axis() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	O findPairs őSĕג
+     * @return	גĂ truei}\[gŒꍇ falsej
+     */
+    [[nodiscard]] bool resorted() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	O findPairs ŕт̐擾
+     * @return	т̐i1 Ȃ番ĂȂj
+     */
+    [[nodiscard]] uint32_t slabCount() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̐擾
+     * @return	̐i폜̂͊܂܂Ȃj
+     */
+    [[nodiscard]] uint32_t size() const noexcept;
+
+private:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ׂ鎲IсAт𒼂
+     */
+    void sort();
+
+    /// ɒTPʁiт̒̕т͈̔́j
+    struct SweepTask {
+        uint32_t slab;   ///< 
+        uint32_t begin;  ///< т̒̊Jnʒu
+        uint32_t end;    ///< т̒̏Iʒu
+    };
+
+    std::vector<Aabb>                        bounds_{};        /// ̂Ƃ̋E{bNXi폜̂͋j
+    std::vector<uint32_t>                    freeBodies_{};    /// 󂢂Ă镨̔ԍ
+    std::vector<uint32_t>                    order_{};         /// ŏW̏̔̕ԍi폜͖̂֍sj
+    std::vector<float>                       keys_{};          /// order_ ׂ̕Ă鎲̍ŏW
+    std::vector<float>                       sweep_[6]{};      /// тƂɕт̏ɏW߂EiׂĂ鎲Eт̎Ec̎̍ŏƍőj
+    std::vector<uint32_t>                    sweepBodies_{};   /// sweep_ ̔̕ԍ
+    std::vector<uint32_t>                    slabOffsets_{};   /// тƂ sweep_ ̊Jnʒuiт̌ɔԕuj
+    std::vector<uint32_t>                    slabCounts_{};    /// тƂ̐̕
+    std::vector<SweepTask>                   tasks_{};         /// ɒTP
+    std::vector<std::vector<BroadphasePair>> taskPairs_{};     /// PʂƂ̑g
+    double                                   variance_[3]{};   /// Ƃ̒S̕U
+    uint32_t                                 axis_{};          /// ׂĂ鎲
+    uint32_t                                 size_{};          /// ̐
+    bool                                     resorted_{};      /// O findPairs őSĕג
+};
@@ -0,0 +1,680 @@
+// I BVH
+
+#include "bvh.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define BVH_SSE 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/// SAH ̃r
+constexpr uint32_t BinCount = 16;
+
+/// ȉ̗vfȂ番Ȃꍇɗtɂ
+constexpr uint32_t MaxLeafObjects = 4;
+
+/// m[hHRXgivf 1 ̔RXg 1 Ƃj
+constexpr float TraversalCost = 1.0f;
+
+/// ̔ŊOƕƂ̒l
+constexpr uint32_t OutsideMask = UINT32_MAX;
+
+/// tm[ĥ̊𒴂A֒H炸ɑSm[h납瑖 refit 
+constexpr size_t RefitSweepRatio = 64;
+
+/// 6 ʑSĂ𔻒肷}XN
+constexpr uint32_t AllPlanes = 0x3f;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	\ʐς̔߂i邾Ȃ̂Ŕŗǂj
+ */
+float halfArea(const float min[3], const float max[3]) noexcept {
+    const float x = max[0] - min[0];
+    const float y = max[1] - min[1];
+    const float z = max[2] - min[2];
+    return x * y + y * z + z * x;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	EL
+ */
+void grow(float min[3], float max[3], const float otherMin[3], const float otherMax[3]) noexcept {
+    for (int axis = 0; axis < 3; ++axis) {
+        min[axis] = std::min(min[axis], otherMin[axis]);
+        max[axis] = std::max(max[axis], otherMax[axis]);
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̋Ei grow Ăujɂ
+ */
+void makeEmpty(float min[3], float max[3]) noexcept {
+    for (int axis = 0; axis < 3; ++axis) {
+        min[axis] = std::numeric_limits<float>::max();
+        max[axis] = -std::numeric_limits<float>::max();
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	E{bNXƎ̊֌W𒲂ׂ
+ * @param	frustum	
+ * @param	mask	肷镽ʂ̃rbg
+ * @param	min		ŏW
+ * @param	max		őW
+ * @return	OȂ OutsideMaskAȊO͊SɓɂȂʂ𗎂Ƃ}XN
+ * @details	SƔ̑傫̋ߕE] BoundingBoxes / cullBoxes Ɠ
+ */
+uint32_t classifyBox(const CullFrustum& frustum, uint32_t mask, const float min[3], const float max[3]) noexcept {
+    const float center[3] = { (min[0] + max[0]) * 0.5f, (min[1] + max[1]) * 0.5f, (min[2] + max[2]) * 0.5f };
+    const float extent[3] = { (max[0] - min[0]) * 0.5f, (max[1] - min[1]) * 0.5f, (max[2] - min[2]) * 0.5f };
+    for (uint32_t p = 0; p < 6; ++p) {
+        if (!(mask & (1u << p))) {
+            continue;
+        }
+        const float* plane = frustum.planes[p];
+        float distance = plane[0] * center[0];
+        distance = distance + plane[1] * center[1];
+        distance = distance + plane[2] * center[2];
+        distance = distance + plane[3];
+        float radius = std::fabs(plane[0]) * extent[0];
+        radius = radius + std::fabs(plane[1]) * extent[1];
+        radius = radius + std::fabs(plane[2]) * extent[2];
+        if (distance < -radius) {
+            return OutsideMask;
+        }
+        if (distance >= radius) {
+            mask &= ~(1u << p);
+        }
+    }
+    return mask;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	E{bNXmdȂ邩ׂiڂĂΏdȂ鈵j
+ */
+bool overlaps(const float min[3], const float max[3], const Aabb& bounds) noexcept {
+    return min[0] <= bounds.max[0] && max[0] >= bounds.min[0] &&
+           min[1] <= bounds.max[1] && max[1] >= bounds.min[1] &&
+           min[2] <= bounds.max[2] && max[2] >= bounds.min[2];
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CƋE{bNX̃Xu
+ * @param	min			ŏW
+ * @param	max			őW
+ * @param	origin		n_
+ * @param	inverse		̋t
+ * @param	limit		艓_͖
+ * @param	distance	ʒuin_Ȃ 0j
+ * @return	 true
+ * @details	raycast4  SSE łƓZɂĂ̂ŁAʂ̓rbgPʂňv
+ */
+bool intersectRay(const float min[3], const float max[3], const float origin[3], const float inverse[3], float limit, float& distance) noexcept {
+    float nearest = 0.0f;
+    float farthest = limit;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float t0 = (min[axis] - origin[axis]) * inverse[axis];
+        const float t1 = (max[axis] - origin[axis]) * inverse[axis];
+        nearest = std::max(nearest, std::min(t0, t1));
+        farthest = std::min(farthest, std::max(t0, t1));
+    }
+    distance = nearest;
+    return nearest <= farthest;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	O̓ȂuiȂԍ̏j
+ */
+void closerHit(RayHit& hit, uint32_t object, float distance) noexcept {
+    if (distance < hit.distance || (distance == hit.distance && object < hit.object)) {
+        hit = { object, distance };
+    }
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	\z
+ * @param	bounds	IuWFNg̋E{bNX
+ * @param	count	IuWFNg
+ */
+void Bvh::build(const Aabb* bounds, uint32_t count) {
+    bounds_.assign(bounds, bounds + count);
+    objects_.resize(count);
+    leafOf_.assign(count, 0);
+    dirtyLeaves_.clear();
+    nodes_.clear();
+    parents_.clear();
+    nodeDirty_.clear();
+    if (count == 0) {
+        return;
+    }
+
+    // m[h͍X 2n - 1BrōĊmۂȂ悤Ɋmۂ
+    nodes_.reserve(size_t(count) * 2);
+    parents_.reserve(size_t(count) * 2);
+
+    // \z͋EƒS܂Ƃ߂zבւiԍoR̃_ANZXj
+    struct Entry {
+        Aabb     bounds;
+        float    centroid[3];
+        uint32_t object;
+    };
+    std::vector<Entry> entries(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        entries[i].bounds = bounds[i];
+        for (int axis = 0; axis < 3; ++axis) {
+            entries[i].centroid[axis] = (bounds[i].min[axis] + bounds[i].max[axis]) * 0.5f;
+        }
+        entries[i].object = i;
+    }
+
+    // bounds Ηvf狁߂
+    const auto makeNode = [&](uint32_t first, uint32_t n, uint32_t parent, const BvhNode* bounds) {
+        BvhNode node{ {}, first, {}, n };
+        if (bounds) {
+            std::memcpy(node.min, bounds->min, sizeof(node.min));
+            std::memcpy(node.max, bounds->max, sizeof(node.max));
+        }
+        else {
+            makeEmpty(node.min, node.max);
+            for (uint32_t i = first; i < first + n; ++i) {
+                grow(node.min, node.max, entries[i].bounds.min, entries[i].bounds.max);
+            }
+        }
+        nodes_.push_back(node);
+        parents_.push_back(parent);
+    };
+    makeNode(0, count, InvalidObject, nullptr);
+
+    std::vector<uint32_t> pending{ 0 };
+    while (!pending.empty()) {
+        const uint32_t node = pending.back();
+        pending.pop_back();
+        const uint32_t first = nodes_[node].first;
+        const uint32_t n = nodes_[node].count;
+        if (n <= 1) {
+            continue;
+        }
+
+        // S_͈̔
+        float centroidMin[3];
+        float centroidMax[3];
+        makeEmpty(centroidMin, centroidMax);
+        for (uint32_t i = first; i < first + n; ++i) {
+            grow(centroidMin, centroidMax, entries[i].centroid, entries[i].centroid);
+        }
+        float scale[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            const float extent = centroidMax[axis] - centroidMin[axis];
+            scale[axis] = extent > 0.0f ? BinCount / extent : 0.0f;
+        }
+        const auto binOf = [&](const Entry& entry, int axis) {
+            return std::min(BinCount - 1, static_cast<uint32_t>((entry.centroid[axis] - centroidMin[axis]) * scale[axis]));
+        };
+
+        // 3 ܂Ƃ߂ 1 ̑ŃrɐU蕪
+        uint32_t binCounts[3][BinCount]{};
+        float    binMin[3][BinCount][3];
+        float    binMax[3][BinCount][3];
+        for (int axis = 0; axis < 3; ++axis) {
+            for (uint32_t b = 0; b < BinCount; ++b) {
+                makeEmpty(binMin[axis][b], binMax[axis][b]);
+            }
+        }
+        for (uint32_t i = first; i < first + n; ++i) {
+            const Entry& entry = entries[i];
+            for (int axis = 0; axis < 3; ++axis) {
+                const uint32_t bin = binOf(entry, axis);
+                ++binCounts[axis][bin];
+                grow(binMin[axis][bin], binMax[axis][bin], entry.bounds.min, entry.bounds.max);
+            }
+        }
+
+        // ẽrEŕƂ SAH RXgŏ̂̂T
+        int      bestAxis = -1;
+        uint32_t bestBin = 0;
+        float    bestCost = std::numeric_limits<float>::max();
+        for (int axis = 0; axis < 3; ++axis) {
+            if (scale[axis] == 0.0f) {
+                continue;
+            }
+
+            // ݐςʐρ~
+            float    leftCost[BinCount - 1];
+            uint32_t leftCount = 0;
+            float    runMin[3];
+            float    runMax[3];
+            makeEmpty(runMin, runMax);
+            for (uint32_t b = 0; b < BinCount - 1; ++b) {
+                leftCount += binCounts[axis][b];
+                grow(runMin, runMax, binMin[axis][b], binMax[axis][b]);
+                leftCost[b] = leftCount ? halfArea(runMin, runMax) * leftCount : 0.0f;
+            }
+
+            // EݐςȂr
+            uint32_t rightCount = 0;
+            makeEmpty(runMin, runMax);
+            for (uint32_t b = BinCount - 1; b > 0; --b) {
+                rightCount += binCounts[axis][b];
+                grow(runMin, runMax, binMin[axis][b], binMax[axis][b]);
+                if (rightCount == 0 || rightCount == n) {
+                    continue;
+                }
+                const float cost = leftCost[b - 1] + halfArea(runMin, runMax) * rightCount;
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = b;
+                }
+            }
+        }
+
+        uint32_t middle = n / 2;
+        BvhNode  childBounds[2];
+        bool     binnedBounds = false;
+        if (bestAxis >= 0) {
+            // t̂܂܂̕AvfȂΕȂ
+            const float nodeArea = halfArea(nodes_[node].min, nodes_[node].max);
+            const float splitCost = TraversalCost + (nodeArea > 0.0f ? bestCost / nodeArea : 0.0f);
+            if (n <= MaxLeafObjects && splitCost >= float(n)) {
+                continue;
+            }
+            const auto it = std::partition(entries.begin() + first, entries.begin() + first + n,
+                                           [&](const Entry& entry) { return binOf(entry, bestAxis) < bestBin; });
+            middle = static_cast<uint32_t>(it - (entries.begin() + first));
+
+            // q̋E̓r̋E킹Ηǂ̂ŗvfH蒼Ȃ
+            for (int side = 0; side < 2; ++side) {
+                makeEmpty(childBounds[side].min, childBounds[side].max);
+            }
+            for (uint32_t b = 0; b < BinCount; ++b) {
+                BvhNode& child = childBounds[b < bestBin ? 0 : 1];
+                grow(child.min, child.max, binMin[bestAxis][b], binMax[bestAxis][b]);
+            }
+            binnedBounds = true;
+        }
+        else if (n <= MaxLeafObjects) {
+            // SSēʒuBȂΗtɂ
+            continue;
+        }
+        if (middle == 0 || middle == n) {
+            middle = n / 2;
+        }
+
+        const uint32_t left = static_cast<uint32_t>(nodes_.size());
+        makeNode(first, middle, node, binnedBounds ? &childBounds[0] : nullptr);
+        makeNode(first + middle, n - middle, node, binnedBounds ? &childBounds[1] : nullptr);
+        nodes_[node].first = left;
+        nodes_[node].count = 0;
+        pending.push_back(left + 1);
+        pending.push_back(left);
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        objects_[i] = entries[i].object;
+    }
+    nodeDirty_.assign(nodes_.size(), 0);
+    for (uint32_t node = 0; node < nodes_.size(); ++node) {
+        const BvhNode& n = nodes_[node];
+        for (uint32_t i = n.first; i < n.first + n.count; ++i) {
+            leafOf_[objects_[i]] = node;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	IuWFNg̋E{bNXXV
+ * @param	object	IuWFNgԍ
+ * @param	bounds	VE{bNX
+ */
+void Bvh::setBounds(uint32_t object, const Aabb& bounds) {
+    bounds_[object] = bounds;
+    dirtyLeaves_.push_back(leafOf_[object]);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	setBounds ŕςt獪ɌċE{bNX𒼂
+ */
+void Bvh::refit() noexcept {
+    if (dirtyLeaves_.size() < nodes_.size() / RefitSweepRatio) {
+        // ȂΗt獪֒HAEςȂȂł؂
+        for (const uint32_t leaf : dirtyLeaves_) {
+            for (uint32_t node = leaf; node != InvalidObject && updateNodeBounds(node); node = parents_[node]) {
+            }
+        }
+    }
+    else {
+        // ΈtāAqeɂт𗘗pČ납 1 Œ
+        for (const uint32_t leaf : dirtyLeaves_) {
+            for (uint32_t node = leaf; node != InvalidObject && !nodeDirty_[node]; node = parents_[node]) {
+                nodeDirty_[node] = 1;
+            }
+        }
+        for (uint32_t node = static_cast<uint32_t>(nodes_.size()); node-- > 0;) {
+            if (nodeDirty_[node]) {
+                updateNodeBounds(node);
+                nodeDirty_[node] = 0;
+            }
+        }
+    }
+    dirtyLeaves_.clear();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ƌIuWFNgW߂
+ * @param	frustum	
+ * @param	objects	IuWFNgԍ̒ǉ
+ */
+void Bvh::queryFrustum(const CullFrustum& frustum, std::vector<uint32_t>& objects) const {
+    if (nodes_.empty()) {
+        return;
+    }
+
+    struct Entry {
+        uint32_t node;
+        uint32_t mask;  ///< ܂肪v镽
+    };
+    static thread_local std::vector<Entry> stack;
+    stack.clear();
+    stack.push_back({ 0, AllPlanes });
+    while (!stack.empty()) {
+        const Entry entry = stack.back();
+        stack.pop_back();
+        const BvhNode& node = nodes_[entry.node];
+        const uint32_t mask = entry.mask ? classifyBox(frustum, entry.mask, node.min, node.max) : 0;
+        if (mask == OutsideMask) {
+            continue;
+        }
+        if (node.count == 0) {
+            stack.push_back({ node.first + 1, mask });
+            stack.push_back({ node.first, mask });
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            const Aabb& bounds = bounds_[objects_[i]];
+            if (mask == 0 || classifyBox(frustum, mask, bounds.min, bounds.max) != OutsideMask) {
+                objects.push_back(objects_[i]);
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	E{bNXƏdȂIuWFNgW߂
+ * @param	bounds	E{bNX
+ * @param	objects	IuWFNgԍ̒ǉ
+ */
+void Bvh::queryOverlap(const Aabb& bounds, std::vector<uint32_t>& objects) const {
+    if (nodes_.empty()) {
+        return;
+    }
+
+    static thread_local std::vector<uint32_t> stack;
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const BvhNode& node = nodes_[stack.back()];
+        stack.pop_back();
+        if (!overlaps(node.min, node.max, bounds)) {
+            continue;
+        }
+        if (node.count == 0) {
+            stack.push_back(node.first + 1);
+            stack.push_back(node.first);
+            continue;
+        }
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            const Aabb& object = bounds_[objects_[i]];
+            if (overlaps(object.min, object.max, bounds)) {
+                objects.push_back(objects_[i]);
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CƍŏɌIuWFNg̋E{bNX߂
+ * @param	origin		n_
+ * @param	direction	
+ * @param	maxDistance	ő勗
+ * @param	hit			
+ * @return	 true
+ */
+[[nodiscard]] bool Bvh::raycast(const float origin[3], const float direction[3], float maxDistance, RayHit& hit) const noexcept {
+    hit = { InvalidObject, maxDistance };
+    float distance = 0.0f;
+    if (nodes_.empty()) {
+        return false;
+    }
+    const float inverse[3] = { 1.0f / direction[0], 1.0f / direction[1], 1.0f / direction[2] };
+    if (!intersectRay(nodes_[0].min, nodes_[0].max, origin, inverse, hit.distance, distance)) {
+        return false;
+    }
+
+    // ߂qHA̓艓m[ĥ͎Ă
+    struct Entry {
+        uint32_t node;
+        float    distance;
+    };
+    static thread_local std::vector<Entry> stack;
+    stack.clear();
+    stack.push_back({ 0, distance });
+    while (!stack.empty()) {
+        const Entry entry = stack.back();
+        stack.pop_back();
+        if (entry.distance > hit.distance) {
+            continue;
+        }
+        const BvhNode& node = nodes_[entry.node];
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                const uint32_t object = objects_[i];
+                if (intersectRay(bounds_[object].min, bounds_[object].max, origin, inverse, hit.distance, distance)) {
+                    closerHit(hit, object, distance);
+                }
+            }
+            continue;
+        }
+
+        float      leftDistance = 0.0f;
+        float      rightDistance = 0.0f;
+        const bool leftHit = intersectRay(nodes_[node.first].min, nodes_[node.first].max, origin, inverse, hit.distance, leftDistance);
+        const bool rightHit = intersectRay(nodes_[node.first + 1].min, nodes_[node.first + 1].max, origin, inverse, hit.distance, rightDistance);
+        if (leftHit && rightHit) {
+            const bool leftFirst = leftDistance <= rightDistance;
+            stack.push_back(leftFirst ? Entry{ node.first + 1, rightDistance } : Entry{ node.first, leftDistance });
+            stack.push_back(leftFirst ? Entry{ node.first, leftDistance } : Entry{ node.first + 1, rightDistance });
+        }
+        else if (leftHit) {
+            stack.push_back({ node.first, leftDistance });
+        }
+        else if (rightHit) {
+            stack.push_back({ node.first + 1, rightDistance });
+        }
+    }
+    return hit.object != InvalidObject;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	4 {̃C܂Ƃ߂ĒHAꂼŏɌIuWFNg߂
+ * @param	origins		n_
+ * @param	directions	
+ * @param	maxDistance	ő勗
+ * @param	hits		
+ */
+void Bvh::raycast4(const float origins[4][3], const float directions[4][3], float maxDistance, RayHit hits[4]) const noexcept {
+#if BVH_SSE
+    for (int ray = 0; ray < 4; ++ray) {
+        hits[ray] = { InvalidObject, maxDistance };
+    }
+    if (nodes_.empty()) {
+        return;
+    }
+
+    __m128 origin[3];
+    __m128 inverse[3];
+    for (int axis = 0; axis < 3; ++axis) {
+        origin[axis] = _mm_setr_ps(origins[0][axis], origins[1][axis], origins[2][axis], origins[3][axis]);
+        inverse[axis] = _mm_div_ps(_mm_set1_ps(1.0f), _mm_setr_ps(directions[0][axis], directions[1][axis], directions[2][axis], directions[3][axis]));
+    }
+    __m128 limit = _mm_set1_ps(maxDistance);
+
+    // 4 {̃XuiintersectRay ƓZjB[̃rbgԂ
+    const auto intersect = [&](const float min[3], const float max[3], __m128& nearest) {
+        nearest = _mm_setzero_ps();
+        __m128 farthest = limit;
+        for (int axis = 0; axis < 3; ++axis) {
+            const __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(min[axis]), origin[axis]), inverse[axis]);
+            const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(max[axis]), origin[axis]), inverse[axis]);
+            nearest = _mm_max_ps(nearest, _mm_min_ps(t0, t1));
+            farthest = _mm_min_ps(farthest, _mm_max_ps(t0, t1));
+        }
+        return _mm_movemask_ps(_mm_cmple_ps(nearest, farthest));
+    };
+
+    static thread_local std::vector<uint32_t> stack;
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const BvhNode& node = nodes_[stack.back()];
+        stack.pop_back();
+        __m128 distance;
+        if (!intersect(node.min, node.max, distance)) {
+            continue;
+        }
+        if (node.count == 0) {
+            // 1 {ڂɓĂ郌[ŋ߂ɐςށiɒHj
+            __m128    leftDistance;
+            __m128    rightDistance;
+            const int leftMask = intersect(nodes_[node.first].min, nodes_[node.first].max, leftDistance);
+            const int rightMask = intersect(nodes_[node.first + 1].min, nodes_[node.first + 1].max, rightDistance);
+            if (leftMask && rightMask) {
+                alignas(16) float left[4];
+                alignas(16) float right[4];
+                _mm_store_ps(left, leftDistance);
+                _mm_store_ps(right, rightDistance);
+                int lane = 0;
+                while (!((leftMask & rightMask) & (1 << lane)) && lane < 3) {
+                    ++lane;
+                }
+                const bool leftFirst = left[lane] <= right[lane];
+                stack.push_back(leftFirst ? node.first + 1 : node.first);
+                stack.push_back(leftFirst ? node.first : node.first + 1);
+            }
+            else if (leftMask) {
+                stack.push_back(node.first);
+            }
+            else if (rightMask) {
+                stack.push_back(node.first + 1);
+            }
+            continue;
+        }
+
+        for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+            const uint32_t object = objects_[i];
+            const int      mask = intersect(bounds_[object].min, bounds_[object].max, distance);
+            if (!mask) {
+                continue;
+            }
+            alignas(16) float distances[4];
+            _mm_store_ps(distances, distance);
+            for (int ray = 0; ray < 4; ++ray) {
+                if (mask & (1 << ray)) {
+                    closerHit(hits[ray], object, distances[ray]);
+                }
+            }
+            limit = _mm_setr_ps(hits[0].distance, hits[1].distance, hits[2].distance, hits[3].distance);
+        }
+    }
+#else
+    for (int ray = 0; ray < 4; ++ray) {
+        (void)raycast(origins[ray], directions[ray], maxDistance, hits[ray]);
+    }
+#endif
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SAH RXg߂
+ * @return	RXg
+ */
+[[nodiscard]] float Bvh::sahCost() const noexcept {
+    if (nodes_.empty()) {
+        return 0.0f;
+    }
+    const float rootArea = halfArea(nodes_[0].min, nodes_[0].max);
+    if (!(rootArea > 0.0f)) {
+        return 0.0f;
+    }
+    float cost = 0.0f;
+    for (const auto& node : nodes_) {
+        cost += halfArea(node.min, node.max) * (node.count ? float(node.count) : TraversalCost);
+    }
+    return cost / rootArea;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	m[h擾
+ * @return	m[h
+ */
+[[nodiscard]] uint32_t Bvh::nodeCount() const noexcept {
+    return static_cast<uint32_t>(nodes_.size());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	IuWFNg擾
+ * @return	IuWFNg
+ */
+[[nodiscard]] uint32_t Bvh::objectCount() const noexcept {
+    return static_cast<uint32_t>(bounds_.size());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	m[h̋E{bNXqitȂvfj狁ߒ
+ * @param	node	m[hԍ
+ * @return	E{bNXς true
+ */
+bool Bvh::updateNodeBounds(uint32_t node) noexcept {
+    BvhNode& n = nodes_[node];
+    float    min[3];
+    float    max[3];
+    makeEmpty(min, max);
+    if (n.count > 0) {
+        for (uint32_t i = n.first; i < n.first + n.count; ++i) {
+            grow(min, max, bounds_[objects_[i]].min, bounds_[objects_[i]].max);
+        }
+    }
+    else {
+        grow(min, max, nodes_[n.first].min, nodes_[n.first].max);
+        grow(min, max, nodes_[n.first + 1].min, nodes_[n.first + 1].max);
+    }
+
+    const bool changed = std::memcmp(min, n.min, sizeof(min)) != 0 || std::memcmp(max, n.max, sizeof(max)) != 0;
+    std::memcpy(n.min, min, sizeof(min));
+    std::memcpy(n.max, max, sizeof(max));
+    return changed;
+}
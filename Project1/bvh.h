@@ -0,0 +1,143 @@
+// I BVH
+
+#pragma once
+
+#include "indirect_cull.h"
+#include <cstdint>
+#include <vector>
+
+/// ɕsȋE{bNX
+struct Aabb {
+    float min[3];  ///< ŏW
+    float max[3];  ///< őW
+};
+
+/// BVH ̃m[hi32 oCgBZׂ͗荇킹ɒû 2  1 LbVCj
+struct BvhNode {
+    float    min[3];  ///< E{bNX̍ŏW
+    uint32_t first;   ///< m[hȂ獶̎qiE̎q first + 1jAtȂ擪vf̈ʒu
+    float    max[3];  ///< E{bNX̍őW
+    uint32_t count;   ///< t̗vfim[h 0j
+};
+static_assert(sizeof(BvhNode) == 32, "BvhNode  32 oCgɂ");
+
+/// CLXǧ
+struct RayHit {
+    uint32_t object;    ///< IuWFNg̔ԍ
+    float    distance;  ///< C̎n_̋idirection ̒ 1 Ƃ tj
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	I BVH NX
+ * @details	SAH ̃rō\zAIuWFNgt獪ɌċE𒼂irefitj
+ *			m[h 1 {̔zɐ[DŕׁAZׂɒuB؂̗vf͗vfz̘AԂɂȂ
+ *			refit JԂƖ؂̎̂ŁAsahCost() \z傫 build 
+ */
+class Bvh final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	\z
+     * @param	bounds	IuWFNg̋E{bNXiԍ = IuWFNgԍj
+     * @param	count	IuWFNg
+     */
+    void build(const Aabb* bounds, uint32_t count);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	IuWFNg̋E{bNXXVirefit() ĂԂ܂Ŗ؂ɂ͔fȂj
+     * @param	object	IuWFNgԍ
+     * @param	bounds	VE{bNX
+     */
+    void setBounds(uint32_t object, const Aabb& bounds);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	setBounds ŕςt獪ɌċE{bNX𒼂
+     * @details	IuWFNgȂ΋E{bNXςȂȂm[hőł؂A
+     *			ΑSm[h 1 񂾂납璼
+     */
+    void refit() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ƌIuWFNgW߂
+     * @param	frustum	
+     * @param	objects	IuWFNgԍ̒ǉiԂ͖؂̕сj
+     * @details	SɓɂȂʂ͂ȍ~̎qŔ肵Ȃ
+     */
+    void queryFrustum(const CullFrustum& frustum, std::vector<uint32_t>& objects) const;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	E{bNXƏdȂIuWFNgW߂
+     * @param	bounds	E{bNX
+     * @param	objects	IuWFNgԍ̒ǉiԂ͖؂̕сj
+     */
+    void queryOverlap(const Aabb& bounds, std::vector<uint32_t>& objects) const;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	CƍŏɌIuWFNg̋E{bNX߂
+     * @param	origin		n_
+     * @param	direction	iKȂĂ悢j
+     * @param	maxDistance	ő勗idirection Pʁj
+     * @param	hit			ʁiȂԍ̏IuWFNgj
+     * @return	 true
+     */
+    [[nodiscard]] bool raycast(const float origin[3], const float direction[3], float maxDistance, RayHit& hit) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	4 {̃C܂Ƃ߂ĒHAꂼŏɌIuWFNg߂
+     * @param	origins		n_
+     * @param	directions	
+     * @param	maxDistance	ő勗idirection Pʁj
+     * @param	hits		ʁiȂC object  InvalidObjectj
+     * @details	SSE  4 {𓯎ɃXu肵Aǂꂩ 1 {łԂ͍~Bʂ raycast Ɠ
+     */
+    void raycast4(const float origins[4][3], const float directions[4][3], float maxDistance, RayHit hits[4]) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	SAH RXg߂i̕\ʐςŊlj
+     * @return	RXg
+     */
+    [[nodiscard]] float sahCost() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	m[h擾
+     * @return	m[h
+     */
+    [[nodiscard]] uint32_t nodeCount() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	IuWFNg擾
+     * @return	IuWFNg
+     */
+    [[nodiscard]] uint32_t objectCount() const noexcept;
+
+    /// ȂƂ̃IuWFNgԍ
+    static constexpr uint32_t InvalidObject = UINT32_MAX;
+
+private:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	m[h̋E{bNXqitȂvfj狁ߒ
+     * @param	node	m[hԍ
+     * @return	E{bNXς true
+     */
+    bool updateNodeBounds(uint32_t node) noexcept;
+
+private:
+    std::vector<BvhNode>  nodes_{};        /// m[hi0 j
+    std::vector<uint32_t> parents_{};      /// m[hƂ̐ei InvalidObjectj
+    std::vector<uint32_t> objects_{};      /// tQƂIuWFNgԍ
+    std::vector<uint32_t> leafOf_{};       /// IuWFNgĂt
+    std::vector<Aabb>     bounds_{};       /// IuWFNg̋E{bNX
+    std::vector<uint32_t> dirtyLeaves_{};  /// refit ҂̗t
+    std::vector<uint8_t>  nodeDirty_{};    /// refit ł܂Ƃ߂Ēm[ḧ
+};
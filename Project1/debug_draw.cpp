@@ -0,0 +1,297 @@
+// fobO`iEEEj
+
+#include "debug_draw.h"
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+/// ̉~ 1 ̕
+constexpr uint32_t CircleSegments = 16;
+
+/// ɐUXbhԍ
+std::atomic<uint32_t> nextThreadIndex{ 0 };
+
+/// Pʉ~̓_icos, sinjBςނтɎOp֐Ă΂Ȃ悤ŏɍĂ
+const std::array<std::array<float, 2>, CircleSegments + 1> unitCircle = [] {
+    std::array<std::array<float, 2>, CircleSegments + 1> points{};
+    for (uint32_t i = 0; i <= CircleSegments; ++i) {
+        const float angle = 6.28318530718f * float(i % CircleSegments) / CircleSegments;
+        points[i] = { std::cos(angle), std::sin(angle) };
+    }
+    return points;
+}();
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ĂяoXbh̔ԍ擾iŏɌĂ񂾎ɐUj
+ * @return	Xbhԍ
+ */
+uint32_t threadIndex() noexcept {
+    thread_local const uint32_t index = nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_
+ */
+void setVertex(DebugVertex& vertex, float x, float y, float z, uint32_t color) noexcept {
+    vertex.position[0] = x;
+    vertex.position[1] = y;
+    vertex.position[2] = z;
+    vertex.color = color;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	3 ʂ̌_߂
+ * @param	a, b, c	ʁiax + by + cz + d = 0j
+ * @param	point	_̊i[
+ * @return	_ 1 Ɍ܂ true
+ */
+bool intersectPlanes(const float a[4], const float b[4], const float c[4], float point[3]) noexcept {
+    const float bc[3] = { b[1] * c[2] - b[2] * c[1], b[2] * c[0] - b[0] * c[2], b[0] * c[1] - b[1] * c[0] };
+    const float ca[3] = { c[1] * a[2] - c[2] * a[1], c[2] * a[0] - c[0] * a[2], c[0] * a[1] - c[1] * a[0] };
+    const float ab[3] = { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+    const float determinant = a[0] * bc[0] + a[1] * bc[1] + a[2] * bc[2];
+    if (std::fabs(determinant) < 1.0e-6f) {
+        return false;
+    }
+    for (int i = 0; i < 3; ++i) {
+        point[i] = -(a[3] * bc[i] + b[3] * ca[i] + c[3] * ab[i]) / determinant;
+    }
+    return true;
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	maxThreads			ςރXbh̍ő吔
+ * @param	verticesPerThread	1 Xbh 1 t[ɐς߂ő̒_
+ * @return	 true
+ */
+[[nodiscard]] bool DebugDraw::create(uint32_t maxThreads, uint32_t verticesPerThread) {
+    if (maxThreads == 0 || verticesPerThread < 2) {
+        assert(false && "fobO`̃obt@ł");
+        return false;
+    }
+    maxThreads_ = maxThreads;
+    verticesPerThread_ = verticesPerThread;
+    vertexStorage_.assign(size_t(maxThreads) * verticesPerThread, DebugVertex{});
+    threads_ = std::make_unique<ThreadBuffer[]>(maxThreads);
+    for (uint32_t i = 0; i < maxThreads; ++i) {
+        threads_[i] = { vertexStorage_.data() + size_t(i) * verticesPerThread, 0, 0 };
+    }
+    lostCount_.store(0, std::memory_order_relaxed);
+    dropped_ = 0;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ςނǂݒ肷
+ * @param	enabled	ςނȂ true
+ */
+void DebugDraw::setEnabled(bool enabled) noexcept {
+    enabled_ = enabled;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ς
+ * @param	from	n_
+ * @param	to		I_
+ * @param	color	F (0xAABBGGRR)
+ */
+void DebugDraw::line(const float from[3], const float to[3], uint32_t color) noexcept {
+    if (!enabled_) {
+        return;
+    }
+    DebugVertex* v = allocate(2);
+    if (!v) {
+        return;
+    }
+    setVertex(v[0], from[0], from[1], from[2], color);
+    setVertex(v[1], to[0], to[1], to[2], color);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ɉς
+ * @param	min		ŏW
+ * @param	max		őW
+ * @param	color	F (0xAABBGGRR)
+ */
+void DebugDraw::box(const float min[3], const float max[3], uint32_t color) noexcept {
+    if (!enabled_) {
+        return;
+    }
+    DebugVertex* v = allocate(24);
+    if (!v) {
+        return;
+    }
+    // X, Y, Z ̕ӂ 4 {
+    const float* corners[2] = { min, max };
+    for (int i = 0; i < 4; ++i) {
+        const float y = corners[i & 1][1];
+        const float z = corners[i >> 1][2];
+        setVertex(*v++, min[0], y, z, color);
+        setVertex(*v++, max[0], y, z, color);
+    }
+    for (int i = 0; i < 4; ++i) {
+        const float x = corners[i & 1][0];
+        const float z = corners[i >> 1][2];
+        setVertex(*v++, x, min[1], z, color);
+        setVertex(*v++, x, max[1], z, color);
+    }
+    for (int i = 0; i < 4; ++i) {
+        const float x = corners[i & 1][0];
+        const float y = corners[i >> 1][1];
+        setVertex(*v++, x, y, min[2], color);
+        setVertex(*v++, x, y, max[2], color);
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ςށiɐ 3 ̉~j
+ * @param	center	S
+ * @param	radius	a
+ * @param	color	F (0xAABBGGRR)
+ */
+void DebugDraw::sphere(const float center[3], float radius, uint32_t color) noexcept {
+    if (!enabled_) {
+        return;
+    }
+    DebugVertex* v = allocate(CircleSegments * 6);
+    if (!v) {
+        return;
+    }
+    const float cx = center[0];
+    const float cy = center[1];
+    const float cz = center[2];
+    for (uint32_t i = 0; i < CircleSegments; ++i) {
+        const float c0 = unitCircle[i][0] * radius;
+        const float s0 = unitCircle[i][1] * radius;
+        const float c1 = unitCircle[i + 1][0] * radius;
+        const float s1 = unitCircle[i + 1][1] * radius;
+        setVertex(v[0], cx + c0, cy + s0, cz, color);  // XY 
+        setVertex(v[1], cx + c1, cy + s1, cz, color);
+        setVertex(v[2], cx, cy + c0, cz + s0, color);  // YZ 
+        setVertex(v[3], cx, cy + c1, cz + s1, color);
+        setVertex(v[4], cx + s0, cy, cz + c0, color);  // ZX 
+        setVertex(v[5], cx + s1, cy, cz + c1, color);
+        v += 6;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ς
+ * @param	frustum	imakeCullFrustum ṓj
+ * @param	color	F (0xAABBGGRR)
+ */
+void DebugDraw::frustum(const CullFrustum& frustum, uint32_t color) noexcept {
+    if (!enabled_) {
+        return;
+    }
+    // p̔ԍ bit0: E, bit1: , bit2: O
+    float corners[8][3];
+    for (int i = 0; i < 8; ++i) {
+        if (!intersectPlanes(frustum.planes[i & 1], frustum.planes[2 + ((i >> 1) & 1)], frustum.planes[4 + (i >> 2)], corners[i])) {
+            return;
+        }
+    }
+    DebugVertex* v = allocate(24);
+    if (!v) {
+        return;
+    }
+    // epԍ 1 rbgႤp֐LтӁieӂ 1 񂸂j
+    for (int i = 0; i < 8; ++i) {
+        for (int bit = 1; bit < 8; bit <<= 1) {
+            if (i & bit) {
+                continue;
+            }
+            const float* a = corners[i];
+            const float* b = corners[i | bit];
+            setVertex(*v++, a[0], a[1], a[2], color);
+            setVertex(*v++, b[0], b[1], b[2], color);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ς܂ꂽ_̑擾
+ * @return	_
+ */
+[[nodiscard]] uint32_t DebugDraw::vertexCount() const noexcept {
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < maxThreads_; ++i) {
+        count += threads_[i].count;
+    }
+    return count;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SXbh̒_ 1 {ɋl߁Aobt@ɂ
+ * @param	out			ݐiC Xgj
+ * @param	maxVertices	߂ő̒_
+ * @return	񂾒_
+ * @details	肫Ȃ͐ 1 {}` 1 ƂĎ̂Ăɑ
+ */
+uint32_t DebugDraw::gather(DebugVertex* out, uint32_t maxVertices) noexcept {
+    maxVertices &= ~1u;
+    uint32_t written = 0;
+    dropped_ = lostCount_.exchange(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < maxThreads_; ++i) {
+        ThreadBuffer&  thread = threads_[i];
+        const uint32_t count = thread.count < maxVertices - written ? thread.count : maxVertices - written;
+        if (count > 0) {
+            std::memcpy(out + written, thread.vertices, sizeof(DebugVertex) * count);
+            written += count;
+        }
+        dropped_ += thread.dropped + (thread.count - count) / 2;
+        thread.count = 0;
+        thread.dropped = 0;
+    }
+    return written;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	O gather ܂łɂӂĎ̂Ă}`̐擾
+ * @return	}`̐
+ */
+[[nodiscard]] uint32_t DebugDraw::droppedCount() const noexcept {
+    return dropped_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ĂяoXbh̃obt@璸_mۂ
+ * @param	count	_
+ * @return	ݐBӂꂽ nullptr
+ */
+DebugVertex* DebugDraw::allocate(uint32_t count) noexcept {
+    assert(threads_ && "fobO`悪쐬ł");
+    const uint32_t index = threadIndex();
+    if (index >= maxThreads_) {
+        lostCount_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    ThreadBuffer& thread = threads_[index];
+    if (verticesPerThread_ - thread.count < count) {
+        ++thread.dropped;
+        return nullptr;
+    }
+    DebugVertex* vertices = thread.vertices + thread.count;
+    thread.count += count;
+    return vertices;
+}
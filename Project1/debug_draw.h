@@ -0,0 +1,136 @@
+// fobO`iEEEj
+
+#pragma once
+
+#include "indirect_cull.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// fobO`̒_iPOSITION / COLORj
+struct DebugVertex {
+    float    position[3];  ///< [hW
+    uint32_t color;        ///< F (0xAABBGGRR)
+};
+static_assert(sizeof(DebugVertex) == 16, "fobO`̒_CAEgƂĂ܂");
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	fobO`NX
+ * @details	ǂ̃Xbhłς߂BXbhɂ͍ŏɐς񂾎ɃvZXŒʂ̔ԍUA
+ *			̔ԍ̃obt@ɂ̂ŁAςގɃbN atomic ȏ݂
+ *			obt@ create ŊmۂŒ蒷ŁAӂꂽ}`͕`ɐ邾
+ *			gather ̓t[̋؂iǂ̃XbhςłȂj 1 ĂсASXbh̕ 1 {ɋl߂
+ */
+class DebugDraw final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    DebugDraw() = default;
+
+    // Rs[֎~
+    DebugDraw(const DebugDraw&) = delete;
+    DebugDraw& operator=(const DebugDraw&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	maxThreads			ςރXbh̍ő吔iԍȏ̃Xbh̐}`͎̂Ăj
+     * @param	verticesPerThread	1 Xbh 1 t[ɐς߂ő̒_i 1 { 2 _j
+     * @return	 true
+     */
+    [[nodiscard]] bool create(uint32_t maxThreads, uint32_t verticesPerThread);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ςނǂݒ肷ifalse ̊Ԃ͑SĂ̐}`ŏ̕򂾂Ŗ߂j
+     * @param	enabled	ςނȂ true
+     */
+    void setEnabled(bool enabled) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ς
+     * @param	from	n_
+     * @param	to		I_
+     * @param	color	F (0xAABBGGRR)
+     */
+    void line(const float from[3], const float to[3], uint32_t color) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ɉςށi12 {j
+     * @param	min		ŏW
+     * @param	max		őW
+     * @param	color	F (0xAABBGGRR)
+     */
+    void box(const float min[3], const float max[3], uint32_t color) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ςށiɐ 3 ̉~j
+     * @param	center	S
+     * @param	radius	a
+     * @param	color	F (0xAABBGGRR)
+     */
+    void sphere(const float center[3], float radius, uint32_t color) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ςށi12 {j
+     * @param	frustum	imakeCullFrustum ṓj
+     * @param	color	F (0xAABBGGRR)
+     * @details	3 ʂ̌_p߂B̕ʂi̎ˉej͕`Ȃ
+     */
+    void frustum(const CullFrustum& frustum, uint32_t color) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ς܂ꂽ_̑擾igather ƓAǂ̃XbhςłȂɌĂԁj
+     * @return	_
+     */
+    [[nodiscard]] uint32_t vertexCount() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	SXbh̒_ 1 {ɋl߁Aobt@ɂ
+     * @param	out			ݐiC Xgj
+     * @param	maxVertices	߂ő̒_
+     * @return	񂾒_
+     */
+    uint32_t gather(DebugVertex* out, uint32_t maxVertices) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	O gather ܂łɂӂĎ̂Ă}`̐擾
+     * @return	}`̐
+     */
+    [[nodiscard]] uint32_t droppedCount() const noexcept;
+
+private:
+    /// 1 Xbh̃obt@ĩXbh̃JE^ƓLbVCɍڂȂj
+    struct alignas(64) ThreadBuffer {
+        DebugVertex* vertices;  ///< _ivertexStorage_ ̈ꕔj
+        uint32_t     count;     ///< gĂ钸_
+        uint32_t     dropped;   ///< ӂĎ̂Ă}`̐
+    };
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ĂяoXbh̃obt@璸_mۂ
+     * @param	count	_
+     * @return	ݐBӂꂽ nullptr
+     */
+    DebugVertex* allocate(uint32_t count) noexcept;
+
+    std::unique_ptr<ThreadBuffer[]> threads_{};            /// XbhƂ̃obt@
+    std::vector<DebugVertex>        vertexStorage_{};      /// SXbh̒_
+    uint32_t                        maxThreads_{};         /// Xbh̍ő吔
+    uint32_t                        verticesPerThread_{};  /// 1 Xbh̒_
+    std::atomic<uint32_t>           lostCount_{};          /// obt@̖XbĥĂ}`̐
+    uint32_t                        dropped_{};            /// O gather ܂łɎ̂Ă}`̐
+    bool                            enabled_ = true;       /// ςނȂ true
+};
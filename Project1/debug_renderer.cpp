@@ -0,0 +1,89 @@
+// fobO`NXiGPU j
+
+#include "debug_renderer.h"
+#include "pipline_state_object.h"
+#include "root_signature_builder.h"
+#include <cassert>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	device				foCXNX̃CX^X
+ * @param	rootSignatureCache	[gVOl`LbV
+ * @param	pipelineCache		pCvCXe[gLbV
+ * @param	maxVertices			1 t[ɕ`ő̒_
+ * @param	frameCount			 GPU QƂt[
+ * @param	renderTargetFormat	`ރ_[^[Qbǧ`
+ * @param	depth				[xobt@̎g
+ * @return	 true
+ */
+[[nodiscard]] bool DebugRenderer::create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache,
+                                         uint32_t maxVertices, uint32_t frameCount, DXGI_FORMAT renderTargetFormat, const DepthSetup& depth) noexcept {
+    if (!shader_.create(device, L"asset/debug_draw.hlsl", {})) {
+        return false;
+    }
+
+    // b0: r[ˉesi[g萔j
+    RootSignatureBuilder builder;
+    builder.addConstants(16, 0, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+    rootSignature_ = rootSignatureCache.getOrCreate(device, builder);
+    if (!rootSignature_) {
+        return false;
+    }
+
+    // ̐Fg悤At@ɂA[x̓eXg
+    PipelineStateDesc desc = PiplineStateObject::defaultDesc();
+    desc.inputLayout = {
+        { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, false, 0 },
+        { "COLOR", 0, DXGI_FORMAT_R8G8B8A8_UNORM, 0, 12, false, 0 },
+    };
+    desc.blend = BlendMode::Alpha;
+    desc.cull = CullMode::None;
+    desc.topology = PrimitiveTopology::Line;
+    desc.renderTargetFormats[0] = static_cast<uint32_t>(renderTargetFormat);
+    pipelineCache_ = &pipelineCache;
+    pipeline_ = pipelineCache.request(makeDepthPipelineDesc(desc, depth, DepthPass::Color), shader_, *rootSignature_);
+
+    maxVertices_ = maxVertices & ~1u;
+    return ring_.create(device, uint64_t(sizeof(DebugVertex)) * maxVertices_, frameCount);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ς܂ꂽ`悵ADebugDraw ɂ
+ * @param	commandList		R}hXg
+ * @param	debugDraw		fobO`
+ * @param	frameIndex		t[ԍ
+ * @param	viewProjection	r[ˉesiclip = M * pj
+ * @return	`悵_
+ */
+uint32_t DebugRenderer::render(ID3D12GraphicsCommandList* commandList, DebugDraw& debugDraw, uint32_t frameIndex,
+                               const float viewProjection[4][4]) noexcept {
+    assert(rootSignature_ && "fobO`悪쐬ł");
+
+    ring_.beginFrame(frameIndex);
+
+    // SXbh̕ꎞobt@O֒ڋl߂ipCvC쐬͎̂̂Ăj
+    ID3D12PipelineState*   pipelineState = pipelineCache_->get(pipeline_);
+    const uint32_t         requested = debugDraw.vertexCount();
+    const uint32_t         reserved = requested < maxVertices_ ? requested : maxVertices_;
+    UploadRing::Allocation allocation{};
+    if (!pipelineState || reserved == 0 || !ring_.allocate(uint64_t(sizeof(DebugVertex)) * reserved, alignof(DebugVertex), allocation)) {
+        debugDraw.gather(nullptr, 0);
+        return 0;
+    }
+    const uint32_t count = debugDraw.gather(static_cast<DebugVertex*>(allocation.cpuAddress), reserved);
+
+    D3D12_VERTEX_BUFFER_VIEW view{};
+    view.BufferLocation = allocation.gpuAddress;
+    view.SizeInBytes = static_cast<UINT>(sizeof(DebugVertex) * count);
+    view.StrideInBytes = sizeof(DebugVertex);
+
+    commandList->SetGraphicsRootSignature(rootSignature_->get());
+    commandList->SetGraphicsRoot32BitConstants(0, 16, viewProjection, 0);
+    commandList->SetPipelineState(pipelineState);
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_LINELIST);
+    commandList->IASetVertexBuffers(0, 1, &view);
+    commandList->DrawInstanced(count, 1, 0, 0);
+    return count;
+}
@@ -0,0 +1,65 @@
+// fobO`NXiGPU j
+
+#pragma once
+
+#include "debug_draw.h"
+#include "device.h"
+#include "pipeline_state_cache.h"
+#include "root_signature_cache.h"
+#include "shader.h"
+#include "upload_ring.h"
+#include <cstdint>
+#include <d3d12.h>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	fobO`NXiGPU j
+ * @details	DebugDraw ̑SXbh̒_Abv[hO֒ڋl߁AC Xg̃pCvC 1  1 ŕ`
+ *			[x̓eXgď܂ȂiV[ɖꂽ͉Bj
+ */
+class DebugRenderer final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    DebugRenderer() = default;
+
+    // Rs[֎~
+    DebugRenderer(const DebugRenderer&) = delete;
+    DebugRenderer& operator=(const DebugRenderer&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	device				foCXNX̃CX^X
+     * @param	rootSignatureCache	[gVOl`LbV
+     * @param	pipelineCache		pCvCXe[gLbV
+     * @param	maxVertices			1 t[ɕ`ő̒_
+     * @param	frameCount			 GPU QƂt[
+     * @param	renderTargetFormat	`ރ_[^[Qbǧ`
+     * @param	depth				[xobt@̎giV[Ɠ́j
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache, uint32_t maxVertices,
+                              uint32_t frameCount, DXGI_FORMAT renderTargetFormat, const DepthSetup& depth) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ς܂ꂽ`悵ADebugDraw ɂ
+     * @param	commandList		R}hXgi_[^[QbgE[xEr[|[g͐ݒς݂̂Ɓj
+     * @param	debugDraw		fobO`iǂ̃XbhςłȂɌĂԁj
+     * @param	frameIndex		t[ԍ
+     * @param	viewProjection	r[ˉesiclip = M * pj
+     * @return	`悵_ipCvC쐬Ȃ 0j
+     */
+    uint32_t render(ID3D12GraphicsCommandList* commandList, DebugDraw& debugDraw, uint32_t frameIndex, const float viewProjection[4][4]) noexcept;
+
+private:
+    Shader                     shader_{};         /// ̃VF[_
+    const RootSignature*       rootSignature_{};  /// [gVOl`iLbVLj
+    PipelineStateCache*        pipelineCache_{};  /// pCvCXe[gLbV
+    PipelineStateCache::Handle pipeline_{};       /// C Xg̃pCvC
+    UploadRing                 ring_{};           /// _̃O
+    uint32_t                   maxVertices_{};    /// 1 t[̍ő咸_
+};
@@ -21,9 +21,12 @@ DepthBuffer::~DepthBuffer() {
  * @param	device			foCXNX̃CX^X
  * @param	heap			o^̃fBXNv^q[ṽCX^X
  * @param	window			EBhENX̃CX^X
+ * @param	reverseZ		O 1A 0 ɂ
  * @return	̐
  */
-[[nodiscard]] bool DepthBuffer::create(const Device& device, const DescriptorHeap& heap, const Window& window) noexcept {
+[[nodiscard]] bool DepthBuffer::create(const Device& device, const DescriptorHeap& heap, const Window& window, bool reverseZ) noexcept {
+    reverseZ_ = reverseZ;
+
     // EBhETCY擾
     const auto [w, h] = window.size();
 
@@ -36,7 +39,7 @@ DepthBuffer::~DepthBuffer() {
     depthDesc.Height = h;
     depthDesc.DepthOrArraySize = 1;
     depthDesc.MipLevels = 1;
-    depthDesc.Format = DXGI_FORMAT_D32_FLOAT;
+    depthDesc.Format = Format;
     depthDesc.SampleDesc.Count = 1;
     depthDesc.SampleDesc.Quality = 0;
     depthDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
@@ -45,7 +48,7 @@ DepthBuffer::~DepthBuffer() {
     // fvXobt@̃NAl̐ݒ
     D3D12_CLEAR_VALUE clearValue{};
     clearValue.Format = depthDesc.Format;
-    clearValue.DepthStencil.Depth = 1.0f;
+    clearValue.DepthStencil.Depth = clearDepth();
     clearValue.DepthStencil.Stencil = 0;
 
     const auto res = device.get()->CreateCommittedResource(
@@ -65,7 +68,7 @@ DepthBuffer::~DepthBuffer() {
     auto heapType = heap.getType();
     if (heapType != D3D12_DESCRIPTOR_HEAP_TYPE_DSV) {
         assert(false && "fBXNv^q[ṽ^Cv DSV ł͂܂");
-        false;
+        return false;
     }
 
     // fvXr[̐ݒ
@@ -101,3 +104,21 @@ DepthBuffer::~DepthBuffer() {
     assert(depthBuffer_ && "fvXobt@ł");
     return handle_;
 }
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NA[x擾
+ * @return	reverseZ Ȃ 0AłȂ 1
+ */
+[[nodiscard]] float DepthBuffer::clearDepth() const noexcept {
+    return reverseZ_ ? 0.0f : 1.0f;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	reverseZ ǂ擾
+ * @return	reverseZ Ȃ true
+ */
+[[nodiscard]] bool DepthBuffer::isReverseZ() const noexcept {
+    return reverseZ_;
+}
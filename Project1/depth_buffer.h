@@ -9,9 +9,14 @@
 //---------------------------------------------------------------------------------
 /**
  * @brief	fvXobt@NX
+ * @details	` 32bit floatBreverseZ ł͎O 1A 0 ɂA0 ŃNA
+ *			ifloat  0 t߂قǍׂ̂ŁA̐x̗e 1/z Ƒłj
  */
 class DepthBuffer final {
 public:
+    /// [x̌`
+    static constexpr DXGI_FORMAT Format = DXGI_FORMAT_D32_FLOAT;
+
     //---------------------------------------------------------------------------------
     /**
      * @brief    RXgN^
@@ -30,9 +35,10 @@ public:
      * @param	device			foCXNX̃CX^X
      * @param	heap			o^̃fBXNv^q[ṽCX^X
      * @param	window			EBhENX̃CX^X
+     * @param	reverseZ		O 1A 0 ɂ
      * @return	̐
      */
-    [[nodiscard]] bool create(const Device& device, const DescriptorHeap& heap, const Window& window) noexcept;
+    [[nodiscard]] bool create(const Device& device, const DescriptorHeap& heap, const Window& window, bool reverseZ = true) noexcept;
 
     //---------------------------------------------------------------------------------
     /**
@@ -48,7 +54,22 @@ public:
      */
     [[nodiscard]] D3D12_CPU_DESCRIPTOR_HANDLE getCpuDescriptorHandle() const noexcept;
 
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	NA[x擾
+     * @return	reverseZ Ȃ 0AłȂ 1
+     */
+    [[nodiscard]] float clearDepth() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	reverseZ ǂ擾
+     * @return	reverseZ Ȃ true
+     */
+    [[nodiscard]] bool isReverseZ() const noexcept;
+
 private:
-    ID3D12Resource* depthBuffer_;  /// _[^[Qbg\[X̔z
+    ID3D12Resource* depthBuffer_{};            /// fvXobt@̃\[X
     D3D12_CPU_DESCRIPTOR_HANDLE handle_{};     /// fBXNv^nh
+    bool reverseZ_{};                          /// O 1A 0 ɂ邩
 };
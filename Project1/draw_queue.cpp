@@ -0,0 +1,221 @@
+// \[gL[t̕`L[
+
+#include "draw_queue.h"
+#include "radix_sort.h"
+#include <cassert>
+#include <cstring>
+
+namespace {
+
+// L[̃rbg
+constexpr uint32_t IndexBits        = 18;
+constexpr uint32_t DepthBits        = 16;  // O
+constexpr uint32_t CoarseDepthBits  = 10;  // Ԃł܂Ƃ߂ꍇ
+constexpr uint32_t VertexBufferBits = 8;
+constexpr uint32_t MaterialBits     = 10;
+constexpr uint32_t PipelineBits     = 10;
+constexpr uint32_t LayerBits        = 4;
+constexpr uint32_t PassBits         = 4;
+constexpr uint32_t LayerShift       = IndexBits + CoarseDepthBits + VertexBufferBits + MaterialBits + PipelineBits;
+constexpr uint32_t PassShift        = LayerShift + LayerBits;
+constexpr uint64_t IndexMask        = (1ull << IndexBits) - 1;
+static_assert(PassShift + PassBits == 64, "L[̃rbg 64 ɂȂĂ܂");
+static_assert(IndexBits + DepthBits + MaterialBits + PipelineBits <= LayerShift, "O̕т̃rbg܂");
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[x bitCount rbgɂi float ̃rbg̏ʁB 0 ɂj
+ */
+uint32_t quantizeDepth(float depth, uint32_t bitCount) noexcept {
+    if (!(depth > 0.0f)) {
+        return 0;
+    }
+    uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof(bits));
+    return bits >> (31 - bitCount);
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	\[gL[
+ * @param	pass		pXi0 ` 15Bقǐɕ`j
+ * @param	layer		C[i0 ` 15BpX̒ŏقǐɕ`j
+ * @param	pipeline		pCvC̔ԍi0 ` 1023j
+ * @param	material		}eA̔ԍi0 ` 1023j
+ * @param	vertexBuffer	_obt@̑g̔ԍi0 ` 255j
+ * @param	depth			J̋i0 ȏj
+ * @param	order			pX̕ו
+ * @return	L[i 18bit  DrawQueue ǉ̔ԍɎĝ 0j
+ */
+[[nodiscard]] uint64_t makeDrawKey(uint32_t pass, uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t vertexBuffer, float depth,
+                                   DrawOrder order) noexcept {
+    assert(pass < (1u << PassBits) && layer < (1u << LayerBits) && "pXC[傫܂");
+    assert(pipeline < (1u << PipelineBits) && material < (1u << MaterialBits) && "pCvC}eA̔ԍ傫܂");
+    assert(vertexBuffer < (1u << VertexBufferBits) && "_obt@̔ԍ傫܂");
+
+    const uint64_t state = (static_cast<uint64_t>(pipeline) << MaterialBits) | material;
+
+    uint64_t middle;
+    if (order == DrawOrder::StateFirst) {
+        const uint64_t quantized = quantizeDepth(depth, CoarseDepthBits);
+        middle = (((state << VertexBufferBits) | vertexBuffer) << CoarseDepthBits) | quantized;
+    }
+    else {
+        // ]ʂ̃rbg 0 ̂܂
+        const uint64_t reversed = quantizeDepth(depth, DepthBits) ^ ((1u << DepthBits) - 1);
+        middle = ((reversed << (PipelineBits + MaterialBits)) | state) << (LayerShift - IndexBits - DepthBits - PipelineBits - MaterialBits);
+    }
+    return (static_cast<uint64_t>(pass) << PassShift) | (static_cast<uint64_t>(layer) << LayerShift) | (middle << IndexBits);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	L^̂āA̐ݒKʂiR}hXg̐擪AÕR[hԂςɌĂԁj
+ */
+void DrawStateTracker::invalidate() noexcept {
+    rootSignature_ = Unset;
+    pipeline_ = Unset;
+    vertexBuffer_ = Unset;
+    material_ = Unset;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	񐔂 0 ɖ߂
+ */
+void DrawStateTracker::resetStats() noexcept {
+    stats_ = {};
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[gVOl`ςKv邩ׁAL^
+ * @param	rootSignature	[gVOl`̔ԍ
+ * @return	ݒ肪KvȂ true
+ */
+[[nodiscard]] bool DrawStateTracker::changeRootSignature(uint32_t rootSignature) noexcept {
+    if (rootSignature_ == rootSignature) {
+        return false;
+    }
+    rootSignature_ = rootSignature;
+    // [g̓[gVOl`ςƑSď
+    material_ = Unset;
+    ++stats_.rootSignatureChanges;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvCςKv邩ׁAL^
+ * @param	pipeline	pCvC̔ԍ
+ * @return	ݒ肪KvȂ true
+ */
+[[nodiscard]] bool DrawStateTracker::changePipeline(uint32_t pipeline) noexcept {
+    if (pipeline_ == pipeline) {
+        return false;
+    }
+    pipeline_ = pipeline;
+    ++stats_.pipelineChanges;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_obt@ςKv邩ׁAL^
+ * @param	vertexBuffer	_obt@̑g̔ԍ
+ * @return	ݒ肪KvȂ true
+ */
+[[nodiscard]] bool DrawStateTracker::changeVertexBuffer(uint32_t vertexBuffer) noexcept {
+    if (vertexBuffer_ == vertexBuffer) {
+        return false;
+    }
+    vertexBuffer_ = vertexBuffer;
+    ++stats_.vertexBufferChanges;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	}eAςKv邩ׁAL^
+ * @param	material	}eA̔ԍ
+ * @return	ݒ肪KvȂ true
+ */
+[[nodiscard]] bool DrawStateTracker::changeMaterial(uint32_t material) noexcept {
+    if (material_ == material) {
+        return false;
+    }
+    material_ = material;
+    ++stats_.materialChanges;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ς񂾕`SĎ̂Ăimۍς݂̗eʂ͎cj
+ */
+void DrawQueue::clear() noexcept {
+    packets_.clear();
+    keys_.clear();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`ς
+ * @param	key		makeDrawKey ōL[
+ * @param	packet	`
+ */
+void DrawQueue::add(uint64_t key, const DrawPacket& packet) {
+    assert(packets_.size() < MaxPackets && "`悪܂");
+    assert((key & IndexMask) == 0 && "L[̉ʃrbg͒ǉ̔ԍɎg܂");
+
+    keys_.push_back(key | packets_.size());
+    packets_.push_back(packet);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	L[̏ɕׂ
+ */
+void DrawQueue::sort() {
+    // ǉ̔ԍ͍ŏ珸Ȃ̂ŁȀ̃rbgבւ
+    // SĂ̕`œigĂȂpX⃌C[Ȃǁj radixSort ǂݔ΂
+    scratch_.resize(keys_.size());
+    radixSort(keys_.data(), scratch_.data(), keys_.size(), IndexBits, 64);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ׂ̕`擾isort ̌ɌĂԁj
+ * @param	order	Ԗڂ
+ * @return	`
+ */
+[[nodiscard]] const DrawPacket& DrawQueue::packet(uint32_t order) const noexcept {
+    return packets_[keys_[order] & IndexMask];
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ς񂾕`̐擾
+ * @return	`搔
+ */
+[[nodiscard]] uint32_t DrawQueue::size() const noexcept {
+    return static_cast<uint32_t>(packets_.size());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̏ŒoƂ̏Ԃ̐؂ւ񐔂𐔂iۂɂ͉ݒ肵Ȃj
+ * @param	tracker	Ԃ̋L^iĒoꍇ͑ȌԂpj
+ */
+void DrawQueue::simulate(DrawStateTracker& tracker) const noexcept {
+    for (uint32_t i = 0; i < size(); ++i) {
+        const auto& p = packet(i);
+        (void)tracker.changeRootSignature(p.rootSignature);
+        (void)tracker.changePipeline(p.pipeline);
+        (void)tracker.changeVertexBuffer(p.vertexBuffer);
+        (void)tracker.changeMaterial(p.material);
+        tracker.countDraw();
+    }
+}
@@ -0,0 +1,196 @@
+// \[gL[t̕`L[
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/// 1 ̕`iԂ͔ԍŎÂ͒oɕ\j
+struct DrawPacket {
+    uint32_t rootSignature;  ///< [gVOl`̔ԍ
+    uint32_t pipeline;       ///< pCvC̔ԍ
+    uint32_t vertexBuffer;   ///< _obt@̑g̔ԍ
+    uint32_t material;       ///< }eA̔ԍ
+    uint32_t vertexCount;    ///< _
+    uint32_t instanceCount;  ///< CX^X
+    uint32_t startVertex;    ///< Jn_
+    uint32_t startInstance;  ///< JnCX^X
+};
+
+/// pX̕ו
+enum class DrawOrder : uint8_t {
+    StateFirst,   ///< ԁipCvC}eA_obt@jł܂Ƃ߁AԂ͎̒Oisj
+    BackToFront,  ///< OցB[x̒͏Ԃł܂Ƃ߂ij
+};
+
+/// Ԃ̐؂ւ
+struct DrawStats {
+    uint32_t draws;                 ///< `搔
+    uint32_t rootSignatureChanges;  ///< SetGraphicsRootSignature ̉
+    uint32_t pipelineChanges;       ///< SetPipelineState ̉
+    uint32_t vertexBufferChanges;   ///< IASetVertexBuffers ̉
+    uint32_t materialChanges;       ///< }eAݒ肵
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	\[gL[
+ * @param	pass		pXi0 ` 15Bقǐɕ`j
+ * @param	layer		C[i0 ` 15BpX̒ŏقǐɕ`j
+ * @param	pipeline		pCvC̔ԍi0 ` 1023j
+ * @param	material		}eA̔ԍi0 ` 1023j
+ * @param	vertexBuffer	_obt@̑g̔ԍi0 ` 255j
+ * @param	depth			J̋i0 ȏj
+ * @param	order			pX̕ו
+ * @return	L[i 18bit  DrawQueue ǉ̔ԍɎĝ 0j
+ * @details	rbgzuiʂj:
+ *			StateFirst:  pX 4 | C[ 4 | pCvC 10 | }eA 10 | _obt@ 8 | e[x 10 | ǉ 18
+ *			BackToFront: pX 4 | C[ 4 | ][x 16 | pCvC 10 | }eA 10 | gp 2 | ǉ 18
+ *			[x float ̃rbg̕ʁi float ͐ƂĔׂĂjŁA
+ *			16bit Ȃ瑊ΐx͖ 0.4%A10bit Ȃ 25%iԂ̒܂ɎOׂ邾Ɏgj
+ *			O̕тł͐[xقڏdȂȂ̂ŁA_obt@̓L[ɓȂ
+ */
+[[nodiscard]] uint64_t makeDrawKey(uint32_t pass, uint32_t layer, uint32_t pipeline, uint32_t material, uint32_t vertexBuffer, float depth,
+                                   DrawOrder order = DrawOrder::StateFirst) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	璷ȏԐݒȂ߂݂̌̏Ԃ̋L^
+ * @details	changeZZ  true ԂƂۂɐݒ肷B[gVOl`ς
+ *			[ĝŁA}eAݒ肵ɂȂ
+ */
+class DrawStateTracker final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	L^̂āA̐ݒKʂiR}hXg̐擪AÕR[hԂςɌĂԁj
+     */
+    void invalidate() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	񐔂 0 ɖ߂
+     */
+    void resetStats() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[gVOl`ςKv邩ׁAL^
+     * @param	rootSignature	[gVOl`̔ԍ
+     * @return	ݒ肪KvȂ true
+     */
+    [[nodiscard]] bool changeRootSignature(uint32_t rootSignature) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	pCvCςKv邩ׁAL^
+     * @param	pipeline	pCvC̔ԍ
+     * @return	ݒ肪KvȂ true
+     */
+    [[nodiscard]] bool changePipeline(uint32_t pipeline) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	_obt@ςKv邩ׁAL^
+     * @param	vertexBuffer	_obt@̑g̔ԍ
+     * @return	ݒ肪KvȂ true
+     */
+    [[nodiscard]] bool changeVertexBuffer(uint32_t vertexBuffer) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	}eAςKv邩ׁAL^
+     * @param	material	}eA̔ԍ
+     * @return	ݒ肪KvȂ true
+     */
+    [[nodiscard]] bool changeMaterial(uint32_t material) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	` 1 񐔂
+     */
+    void countDraw() noexcept { ++stats_.draws; }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	؂ւ񐔂擾
+     * @return	resetStats ̉
+     */
+    [[nodiscard]] const DrawStats& stats() const noexcept { return stats_; }
+
+private:
+    static constexpr uint32_t Unset = UINT32_MAX;
+
+    uint32_t  rootSignature_{Unset};  /// ̃[gVOl`
+    uint32_t  pipeline_{Unset};       /// ̃pCvC
+    uint32_t  vertexBuffer_{Unset};   /// ̒_obt@
+    uint32_t  material_{Unset};       /// ̃}eA
+    DrawStats stats_{};               /// ؂ւ
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`L[NX
+ * @details	` 64bit L[ƈꏏɐς݁ALSD \[gŕׂ
+ *			L[̉ 18bit ͒ǉ̔ԍŁAL[̒ł͒ǉۂ
+ */
+class DrawQueue final {
+public:
+    /// 1 ɐς߂ő吔iL[̔ԍ̃rbgŌ܂j
+    static constexpr uint32_t MaxPackets = 1u << 18;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ς񂾕`SĎ̂Ăimۍς݂̗eʂ͎cj
+     */
+    void clear() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	`ς
+     * @param	key		makeDrawKey ōL[
+     * @param	packet	`
+     */
+    void add(uint64_t key, const DrawPacket& packet);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	L[̏ɕׂ
+     */
+    void sort();
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ׂ̕`擾isort ̌ɌĂԁj
+     * @param	order	Ԗڂ
+     * @return	`
+     */
+    [[nodiscard]] const DrawPacket& packet(uint32_t order) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ׂ̃L[擾i 18bit ͒ǉ̔ԍj
+     * @param	order	Ԗڂ
+     * @return	L[
+     */
+    [[nodiscard]] uint64_t key(uint32_t order) const noexcept { return keys_[order]; }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ς񂾕`̐擾
+     * @return	`搔
+     */
+    [[nodiscard]] uint32_t size() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̏ŒoƂ̏Ԃ̐؂ւ񐔂𐔂iۂɂ͉ݒ肵Ȃj
+     * @param	tracker	Ԃ̋L^iĒoꍇ͑ȌԂpj
+     */
+    void simulate(DrawStateTracker& tracker) const noexcept;
+
+private:
+    std::vector<DrawPacket> packets_{};  /// ǉ̕`
+    std::vector<uint64_t>   keys_{};     /// \[gL[
+    std::vector<uint64_t>   scratch_{};  /// \[g̍Ɨ̈
+};
@@ -0,0 +1,43 @@
+// `L[̒o
+
+#include "draw_submitter.h"
+#include <cassert>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ׂ`L[R}hXgɐς
+ * @param	commandList	R}hXg
+ * @param	queue		`L[isort ς݁j
+ * @param	resources	ԍ̂߂̔z
+ * @param	tracker		̏Ԃ̋L^BO̕`ƓԂ̐ݒ͐ς܂Ȃ
+ */
+void submitDrawQueue(ID3D12GraphicsCommandList* commandList, const DrawQueue& queue, const DrawResources& resources,
+                     DrawStateTracker& tracker) {
+    assert(commandList);
+    if (queue.size() == 0) {
+        return;
+    }
+
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    for (uint32_t i = 0; i < queue.size(); ++i) {
+        const auto& packet = queue.packet(i);
+        assert(packet.rootSignature < resources.rootSignatures.size() && packet.pipeline < resources.pipelines.size() &&
+               packet.vertexBuffer < resources.vertexBuffers.size() && "z͈̔͊O̔ԍł");
+
+        if (tracker.changeRootSignature(packet.rootSignature)) {
+            commandList->SetGraphicsRootSignature(resources.rootSignatures[packet.rootSignature]);
+        }
+        if (tracker.changePipeline(packet.pipeline)) {
+            commandList->SetPipelineState(resources.pipelines[packet.pipeline]);
+        }
+        if (tracker.changeVertexBuffer(packet.vertexBuffer)) {
+            const auto& binding = resources.vertexBuffers[packet.vertexBuffer];
+            commandList->IASetVertexBuffers(0, binding.count, binding.views);
+        }
+        if (tracker.changeMaterial(packet.material) && resources.bindMaterial) {
+            resources.bindMaterial(commandList, packet.material);
+        }
+        commandList->DrawInstanced(packet.vertexCount, packet.instanceCount, packet.startVertex, packet.startInstance);
+        tracker.countDraw();
+    }
+}
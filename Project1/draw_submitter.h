@@ -0,0 +1,40 @@
+// `L[̒o
+
+#pragma once
+
+#include "draw_queue.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <functional>
+#include <vector>
+
+/// 1  IASetVertexBuffers Őݒ肷钸_obt@̑giXbg 0 j
+struct DrawVertexBinding {
+    static constexpr uint32_t MaxViews = 2;
+
+    D3D12_VERTEX_BUFFER_VIEW views[MaxViews];  ///< _obt@
+    uint32_t                 count;            ///< g
+};
+
+/// DrawPacket ̔ԍ̂߂̔z
+struct DrawResources {
+    /// }eÃ[gݒ肷֐i}eA[gVOl`ςƂĂ΂j
+    using MaterialBinder = std::function<void(ID3D12GraphicsCommandList* commandList, uint32_t material)>;
+
+    std::vector<ID3D12RootSignature*> rootSignatures{};  ///< [gVOl`
+    std::vector<ID3D12PipelineState*> pipelines{};       ///< pCvCi쐬҂̊Ԃ͑̂́j
+    std::vector<DrawVertexBinding>    vertexBuffers{};   ///< _obt@̑g
+    MaterialBinder                    bindMaterial{};    ///< }eA̐ݒiΉȂj
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ׂ`L[R}hXgɐς
+ * @param	commandList	R}hXg
+ * @param	queue		`L[isort ς݁j
+ * @param	resources	ԍ̂߂̔z
+ * @param	tracker		̏Ԃ̋L^BO̕`ƓԂ̐ݒ͐ς܂Ȃ
+ * @details	g|W͎Op`XgɌŒ肷BL[̊OŏԂς tracker.invalidate() ĂԂ
+ */
+void submitDrawQueue(ID3D12GraphicsCommandList* commandList, const DrawQueue& queue, const DrawResources& resources,
+                     DrawStateTracker& tracker);
@@ -0,0 +1,142 @@
+// GeBeBR}hobt@NX
+
+#include "entity_command_buffer.h"
+#include <cstring>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeB̍쐬L^
+ * @param	mask	R|[lg̑gݍ킹il͑ setCreated ŗ^B^Ȃ 0 Ŗ߂j
+ */
+void EntityCommandBuffer::create(ComponentMask mask) {
+    push(Op::Create, 0, { static_cast<uint32_t>(mask), static_cast<uint32_t>(mask >> 32) }, nullptr, 0);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	OɋL^ create ̃GeBeBւ̃R|[lg̒lL^
+ * @param	id		R|[lg̎ނ̔ԍ
+ * @param	value	liR|[lg̃oCgj
+ */
+void EntityCommandBuffer::setCreated(ComponentId id, const void* value) {
+    push(Op::SetCreated, id, {}, value, componentInfo(id).size);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeB̍폜L^
+ * @param	entity	GeBeB
+ */
+void EntityCommandBuffer::destroy(Entity entity) {
+    push(Op::Destroy, 0, entity, nullptr, 0);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R|[lg̒ǉL^ifɊɎĂΏ㏑j
+ * @param	entity	GeBeB
+ * @param	id		R|[lg̎ނ̔ԍ
+ * @param	value	liR|[lg̃oCgj
+ */
+void EntityCommandBuffer::add(Entity entity, ComponentId id, const void* value) {
+    push(Op::Add, id, entity, value, componentInfo(id).size);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R|[lg̍폜L^
+ * @param	entity	GeBeB
+ * @param	id		R|[lg̎ނ̔ԍ
+ */
+void EntityCommandBuffer::remove(Entity entity, ComponentId id) {
+    push(Op::Remove, id, entity, nullptr, 0);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	L^ɔfċɂ
+ * @param	world	f
+ */
+void EntityCommandBuffer::playback(EntityWorld& world) {
+    Entity created{};
+    for (size_t position = 0; position < bytes_.size();) {
+        Header header;
+        std::memcpy(&header, bytes_.data() + position, sizeof(Header));
+        position += sizeof(Header) / sizeof(uint64_t);
+        const Entity   entity{ header.index, header.generation };
+        const void*    value = bytes_.data() + position;
+        const uint32_t size = header.op == Op::SetCreated || header.op == Op::Add ? componentInfo(header.component).size : 0;
+        position += (size + 7) / 8;
+
+        switch (header.op) {
+        case Op::Create: {
+            const ComponentMask mask = ComponentMask{ header.index } | (ComponentMask{ header.generation } << 32);
+            created = world.create(mask);
+            // l^ȂR|[lg𖢏̂܂܂ɂȂ
+            for (ComponentId id = 0; id < MaxComponents; ++id) {
+                if (mask & (ComponentMask{ 1 } << id)) {
+                    std::memset(world.get(created, id), 0, componentInfo(id).size);
+                }
+            }
+            break;
+        }
+        case Op::SetCreated:
+            std::memcpy(world.get(created, header.component), value, size);
+            break;
+        case Op::Destroy:
+            world.destroy(entity);
+            break;
+        case Op::Add:
+            if (world.isAlive(entity)) {
+                std::memcpy(world.add(entity, header.component), value, size);
+            }
+            break;
+        case Op::Remove:
+            world.remove(entity, header.component);
+            break;
+        }
+    }
+    clear();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	L^̂Ăimۍς݂̗eʂ͎cj
+ */
+void EntityCommandBuffer::clear() noexcept {
+    bytes_.clear();
+    commandCount_ = 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	L^
+ * @return	 true
+ */
+bool EntityCommandBuffer::empty() const noexcept {
+    return commandCount_ == 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	L^擾
+ * @return	L^
+ */
+uint32_t EntityCommandBuffer::commandCount() const noexcept {
+    return commandCount_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	L^ǉ
+ */
+void EntityCommandBuffer::push(Op op, ComponentId component, Entity entity, const void* value, uint32_t size) {
+    const size_t position = bytes_.size();
+    bytes_.resize(position + sizeof(Header) / sizeof(uint64_t) + (size + 7) / 8);
+    const Header header{ op, component, entity.index, entity.generation };
+    std::memcpy(&bytes_[position], &header, sizeof(Header));
+    if (size > 0) {
+        std::memcpy(&bytes_[position + sizeof(Header) / sizeof(uint64_t)], value, size);
+    }
+    ++commandCount_;
+}
@@ -0,0 +1,145 @@
+// GeBeBR}hobt@NX
+
+#pragma once
+
+#include "entity_world.h"
+#include <cstdint>
+#include <vector>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeBR}hobt@NX
+ * @details	`NɏĂԂ̓GeBeB̍쐬E폜R|[lg̒ǉE폜łȂ̂ŁA
+ *			ɋL^ĂAIĂ playback ŋL^ EntityWorld ֔f
+ *			R|[lg̒l͋L^ɃoCg֎ʂ̂ŁAL^Ɍ̕ϐςĂ悢
+ *			1 ̃obt@ 1 XbhL^邱ƁiXbh`NƂɕʂ̃obt@gj
+ */
+class EntityCommandBuffer final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeB̍쐬L^
+     * @param	mask	R|[lg̑gݍ킹il͑ setCreated ŗ^B^Ȃ 0 Ŗ߂j
+     */
+    void create(ComponentMask mask);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	OɋL^ create ̃GeBeBւ̃R|[lg̒lL^
+     * @param	id		R|[lg̎ނ̔ԍ
+     * @param	value	liR|[lg̃oCgj
+     */
+    void setCreated(ComponentId id, const void* value);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lgăGeBeB̍쐬L^
+     * @param	components	R|[lg
+     */
+    template <typename... T>
+    void create(const T&... components) {
+        create(componentMask<T...>());
+        (setCreated(componentId<T>(), &components), ...);
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeB̍폜L^
+     * @param	entity	GeBeB
+     */
+    void destroy(Entity entity);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lg̒ǉL^ifɊɎĂΏ㏑j
+     * @param	entity	GeBeB
+     * @param	id		R|[lg̎ނ̔ԍ
+     * @param	value	liR|[lg̃oCgj
+     */
+    void add(Entity entity, ComponentId id, const void* value);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lg̒ǉL^
+     * @param	entity		GeBeB
+     * @param	component	R|[lg
+     */
+    template <typename T>
+    void add(Entity entity, const T& component) {
+        add(entity, componentId<T>(), &component);
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lg̍폜L^
+     * @param	entity	GeBeB
+     * @param	id		R|[lg̎ނ̔ԍ
+     */
+    void remove(Entity entity, ComponentId id);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lg̍폜L^
+     * @param	entity	GeBeB
+     */
+    template <typename T>
+    void remove(Entity entity) {
+        remove(entity, componentId<T>());
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	L^ɔfċɂ
+     * @param	world	f
+     * @details	ɍ폜ꂽGeBeBւ̋L^͔΂
+     */
+    void playback(EntityWorld& world);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	L^̂Ăimۍς݂̗eʂ͎cj
+     */
+    void clear() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	L^
+     * @return	 true
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	L^擾
+     * @return	L^
+     */
+    [[nodiscard]] uint32_t commandCount() const noexcept;
+
+private:
+    /// L^̎
+    enum class Op : uint32_t {
+        Create,
+        SetCreated,
+        Destroy,
+        Add,
+        Remove,
+    };
+
+    /// L^̐擪ilL^͂̌ 8 oCgPʂɑĒluj
+    struct Header {
+        Op          op;          ///< 
+        ComponentId component;   ///< R|[lg̎ނ̔ԍ
+        uint32_t    index;       ///< Ώۂ̃GeBeB̔ԍiCreate ł͑gݍ킹̉ 32 rbgj
+        uint32_t    generation;  ///< Ώۂ̃GeBeB̐iCreate ł͑gݍ킹̏ 32 rbgj
+    };
+    static_assert(sizeof(Header) == 16, "L^̐擪 8 oCg̔{ɂ");
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	L^ǉ
+     */
+    void push(Op op, ComponentId component, Entity entity, const void* value, uint32_t size);
+
+    std::vector<uint64_t> bytes_{};         /// L^i8 oCgPʁj
+    uint32_t              commandCount_{};  /// L^
+};
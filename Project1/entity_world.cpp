@@ -0,0 +1,494 @@
+// GeBeB[hNXiA[L^Cv^ ECSj
+
+#include "entity_world.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+
+namespace {
+
+/// ԍ̖Ƃ\l
+constexpr uint32_t None = UINT32_MAX;
+
+/// o^ꂽR|[lg̎
+ComponentInfo components[MaxComponents]{};
+
+/// o^ꂽR|[lg̎ނ̐
+std::atomic<uint32_t> registeredCount{ 0 };
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	l𑵂
+ */
+constexpr uint32_t alignUp(uint32_t value, uint32_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R|[lg̎ނo^icomponentId Ă΂j
+ * @param	size		oCg
+ * @param	alignment	ACg
+ * @param	name		O
+ * @return	R|[lg̎ނ̔ԍ
+ */
+ComponentId registerComponent(uint32_t size, uint32_t alignment, const char* name) noexcept {
+    const ComponentId id = registeredCount.fetch_add(1);
+    assert(id < MaxComponents && "R|[lg̎ނ܂");
+    components[id] = { size, alignment, name };
+    return id;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R|[lg̎ނ̏擾
+ * @param	id	R|[lg̎ނ̔ԍ
+ * @return	
+ */
+const ComponentInfo& componentInfo(ComponentId id) noexcept {
+    return components[id];
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	OR|[lg̎ނT
+ * @param	name	O
+ * @return	R|[lg̎ނ̔ԍio^ĂȂ UINT32_MAXj
+ */
+ComponentId findComponent(const char* name) noexcept {
+    const uint32_t count = std::min(registeredCount.load(), MaxComponents);
+    for (ComponentId id = 0; id < count; ++id) {
+        if (std::strcmp(components[id].name, name) == 0) {
+            return id;
+        }
+    }
+    return None;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	o^ꂽR|[lg̎ނ̐擾
+ * @return	ނ̐
+ */
+uint32_t componentCount() noexcept {
+    return registeredCount.load();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    RXgN^
+ */
+EntityWorld::EntityWorld() {
+    // R|[lgȂGeBeB̒u
+    findArchetype(0);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+EntityWorld::~EntityWorld() = default;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeB쐬iR|[lg̒g͖j
+ * @param	mask	R|[lg̑gݍ킹
+ * @return	GeBeB
+ */
+Entity EntityWorld::create(ComponentMask mask) {
+    const uint32_t archetype = findArchetype(mask);
+    const Entity   entity = allocateEntity();
+    Record&        record = records_[entity.index];
+    record.archetype = archetype;
+    allocateRow(archetype, record.chunk, record.row);
+    reinterpret_cast<Entity*>(archetypes_[archetype]->chunks[record.chunk]->data)[record.row] = entity;
+    return entity;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeB܂Ƃ߂č쐬iR|[lg̒g͖j
+ * @param	mask	R|[lg̑gݍ킹
+ * @param	count	쐬鐔
+ * @param	func	߂`NƂ func(`N, `N̊Jnʒu, 쐬̊Jnԍ) ̌`ŌĂ΂鏈
+ */
+void EntityWorld::createBatch(ComponentMask mask, uint32_t count, const std::function<void(const ChunkView&, uint32_t, uint32_t)>& func) {
+    const uint32_t index = findArchetype(mask);
+    Archetype&     archetype = *archetypes_[index];
+    for (uint32_t created = 0; created < count;) {
+        // Ō̃`N̋󂫂ɂ܂Ƃ߂ē
+        uint32_t chunk, row;
+        allocateRow(index, chunk, row);
+        const uint32_t room = std::min(archetype.capacity - row, count - created);
+        // allocateRow Ŋmۂ̂ 1 sȂ̂ŁAc̍s𑫂
+        archetype.counts[chunk] += room - 1;
+        archetype.size += room - 1;
+
+        Entity* entities = reinterpret_cast<Entity*>(archetype.chunks[chunk]->data);
+        for (uint32_t i = 0; i < room; ++i) {
+            const Entity entity = allocateEntity();
+            records_[entity.index] = { index, chunk, row + i, entity.generation };
+            entities[row + i] = entity;
+        }
+        func(view(archetype, chunk), row, created);
+        created += room;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeB폜
+ * @param	entity	GeBeB
+ * @return	폜 trueiɖȂ falsej
+ */
+bool EntityWorld::destroy(Entity entity) {
+    if (!isAlive(entity)) {
+        return false;
+    }
+    Record& record = records_[entity.index];
+    freeRow(record.archetype, record.chunk, record.row);
+    record.archetype = None;
+    ++record.generation;
+    freeEntities_.push_back(entity.index);
+    --size_;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeBL
+ * @param	entity	GeBeB
+ * @return	LȂ true
+ */
+bool EntityWorld::isAlive(Entity entity) const noexcept {
+    return entity.index < records_.size() && records_[entity.index].generation == entity.generation && records_[entity.index].archetype != None;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R|[lgǉiɎĂ΍̒l̏ꏊԂj
+ * @param	entity	GeBeB
+ * @param	id		R|[lg̎ނ̔ԍ
+ * @return	R|[lg̏ꏊiǉꍇ͖j
+ */
+void* EntityWorld::add(Entity entity, ComponentId id) {
+    assert(isAlive(entity));
+    const uint32_t source = records_[entity.index].archetype;
+    if (!(archetypes_[source]->mask & (ComponentMask{ 1 } << id))) {
+        uint32_t destination = archetypes_[source]->addEdges[id];
+        if (destination == None) {
+            destination = findArchetype(archetypes_[source]->mask | (ComponentMask{ 1 } << id));
+            archetypes_[source]->addEdges[id] = destination;
+        }
+        move(entity, destination);
+    }
+    return get(entity, id);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R|[lg폜
+ * @param	entity	GeBeB
+ * @param	id		R|[lg̎ނ̔ԍ
+ * @return	폜 true
+ */
+bool EntityWorld::remove(Entity entity, ComponentId id) {
+    if (!isAlive(entity)) {
+        return false;
+    }
+    const uint32_t source = records_[entity.index].archetype;
+    if (!(archetypes_[source]->mask & (ComponentMask{ 1 } << id))) {
+        return false;
+    }
+    uint32_t destination = archetypes_[source]->removeEdges[id];
+    if (destination == None) {
+        destination = findArchetype(archetypes_[source]->mask & ~(ComponentMask{ 1 } << id));
+        archetypes_[source]->removeEdges[id] = destination;
+    }
+    move(entity, destination);
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R|[lg̏ꏊ擾
+ * @param	entity	GeBeB
+ * @param	id		R|[lg̎ނ̔ԍ
+ * @return	ꏊiĂȂ nullptrj
+ */
+void* EntityWorld::get(Entity entity, ComponentId id) const noexcept {
+    if (!isAlive(entity)) {
+        return nullptr;
+    }
+    const Record&    record = records_[entity.index];
+    const Archetype& archetype = *archetypes_[record.archetype];
+    const uint32_t   offset = archetype.offsets[id];
+    if (offset == None) {
+        return nullptr;
+    }
+    return archetype.chunks[record.chunk]->data + offset + size_t(record.row) * components[id].size;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeB̃R|[lg̑gݍ킹擾
+ * @param	entity	GeBeB
+ * @return	gݍ킹
+ */
+ComponentMask EntityWorld::mask(Entity entity) const noexcept {
+    return isAlive(entity) ? archetypes_[records_[entity.index].archetype]->mask : 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NGĩNG΂Ԃj
+ * @param	all		SĎĂR|[lg
+ * @param	none	1 ĂȂR|[lg
+ * @return	NG̔ԍ
+ */
+QueryId EntityWorld::createQuery(ComponentMask all, ComponentMask none) {
+    for (QueryId id = 0; id < queries_.size(); ++id) {
+        if (queries_[id].all == all && queries_[id].none == none) {
+            return id;
+        }
+    }
+    Query query{ all, none, {} };
+    for (uint32_t i = 0; i < archetypes_.size(); ++i) {
+        const ComponentMask mask = archetypes_[i]->mask;
+        if ((mask & all) == all && !(mask & none)) {
+            query.archetypes.push_back(i);
+        }
+    }
+    queries_.push_back(std::move(query));
+    return static_cast<QueryId>(queries_.size() - 1);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NGɍ`NW߂
+ * @param	query	NG̔ԍ
+ * @param	chunks	`N̒ǉ
+ */
+void EntityWorld::collectChunks(QueryId query, std::vector<ChunkView>& chunks) const {
+    for (const uint32_t index : queries_[query].archetypes) {
+        const Archetype& archetype = *archetypes_[index];
+        for (uint32_t chunk = 0; chunk < archetype.chunks.size(); ++chunk) {
+            chunks.push_back(view(archetype, chunk));
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NGɍ`NƂɏ
+ * @param	query	NG̔ԍ
+ * @param	func	func(`N) ̌`ŌĂ΂鏈iō\ςȂƁj
+ */
+void EntityWorld::forEachChunk(QueryId query, const std::function<void(const ChunkView&)>& func) const {
+    for (const uint32_t index : queries_[query].archetypes) {
+        const Archetype& archetype = *archetypes_[index];
+        for (uint32_t chunk = 0; chunk < archetype.chunks.size(); ++chunk) {
+            func(view(archetype, chunk));
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NGɍGeBeB擾
+ * @param	query	NG̔ԍ
+ * @return	GeBeB
+ */
+uint32_t EntityWorld::count(QueryId query) const noexcept {
+    uint32_t total = 0;
+    for (const uint32_t index : queries_[query].archetypes) {
+        total += archetypes_[index]->size;
+    }
+    return total;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	LȃGeBeB擾
+ * @return	GeBeB
+ */
+uint32_t EntityWorld::size() const noexcept {
+    return size_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	A[L^Cv̐擾
+ * @return	A[L^Cv̐
+ */
+uint32_t EntityWorld::archetypeCount() const noexcept {
+    return static_cast<uint32_t>(archetypes_.size());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	mۂĂ`N擾ig񂷂߂ɎĂ镪܂ށj
+ * @return	`N
+ */
+uint32_t EntityWorld::allocatedChunkCount() const noexcept {
+    return chunkCount_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	gݍ킹̃A[L^CvTi΍j
+ */
+uint32_t EntityWorld::findArchetype(ComponentMask mask) {
+    const auto found = lookup_.find(mask);
+    if (found != lookup_.end()) {
+        return found->second;
+    }
+
+    auto archetype = std::make_unique<Archetype>();
+    archetype->mask = mask;
+    archetype->offsets.fill(None);
+    archetype->addEdges.fill(None);
+    archetype->removeEdges.fill(None);
+    uint32_t rowBytes = sizeof(Entity);
+    for (ComponentId id = 0; id < MaxComponents; ++id) {
+        if (mask & (ComponentMask{ 1 } << id)) {
+            archetype->components.push_back(id);
+            rowBytes += components[id].size;
+        }
+    }
+
+    // т̐擪𑵂͂ݏoƂ̂ŁA܂܂ 1 s炷
+    for (uint32_t capacity = ChunkBytes / rowBytes; capacity > 0; --capacity) {
+        uint32_t offset = sizeof(Entity) * capacity;
+        for (const ComponentId id : archetype->components) {
+            offset = alignUp(offset, components[id].alignment);
+            archetype->offsets[id] = offset;
+            offset += components[id].size * capacity;
+        }
+        if (offset <= ChunkBytes) {
+            archetype->capacity = capacity;
+            break;
+        }
+    }
+    assert(archetype->capacity > 0 && "R|[lg傫ă`N 1 ܂");
+
+    const uint32_t index = static_cast<uint32_t>(archetypes_.size());
+    archetypes_.push_back(std::move(archetype));
+    lookup_.emplace(mask, index);
+
+    // ĂNGɂ
+    for (Query& query : queries_) {
+        if ((mask & query.all) == query.all && !(mask & query.none)) {
+            query.archetypes.push_back(index);
+        }
+    }
+    return index;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	A[L^Cv̖ɍsmۂ
+ */
+void EntityWorld::allocateRow(uint32_t index, uint32_t& chunk, uint32_t& row) {
+    Archetype& archetype = *archetypes_[index];
+    if (archetype.chunks.empty() || archetype.counts.back() == archetype.capacity) {
+        if (freeChunks_.empty()) {
+            archetype.chunks.push_back(std::make_unique<Chunk>());
+            ++chunkCount_;
+        }
+        else {
+            archetype.chunks.push_back(std::move(freeChunks_.back()));
+            freeChunks_.pop_back();
+        }
+        archetype.counts.push_back(0);
+    }
+    chunk = static_cast<uint32_t>(archetype.chunks.size() - 1);
+    row = archetype.counts.back()++;
+    ++archetype.size;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	s󂯂iŌ̍sڂĖ߂j
+ */
+void EntityWorld::freeRow(uint32_t index, uint32_t chunk, uint32_t row) noexcept {
+    Archetype&     archetype = *archetypes_[index];
+    const uint32_t lastChunk = static_cast<uint32_t>(archetype.chunks.size() - 1);
+    const uint32_t lastRow = archetype.counts[lastChunk] - 1;
+    if (chunk != lastChunk || row != lastRow) {
+        uint8_t*       to = archetype.chunks[chunk]->data;
+        const uint8_t* from = archetype.chunks[lastChunk]->data;
+        const Entity   moved = reinterpret_cast<const Entity*>(from)[lastRow];
+        reinterpret_cast<Entity*>(to)[row] = moved;
+        for (const ComponentId id : archetype.components) {
+            const uint32_t size = components[id].size;
+            std::memcpy(to + archetype.offsets[id] + size_t(row) * size, from + archetype.offsets[id] + size_t(lastRow) * size, size);
+        }
+        records_[moved.index].chunk = chunk;
+        records_[moved.index].row = row;
+    }
+    --archetype.size;
+    if (--archetype.counts[lastChunk] == 0) {
+        freeChunks_.push_back(std::move(archetype.chunks.back()));
+        archetype.chunks.pop_back();
+        archetype.counts.pop_back();
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeBʂ̃A[L^Cvֈڂiʂ̃R|[lg͎ʂj
+ */
+void EntityWorld::move(Entity entity, uint32_t destination) {
+    Record&        record = records_[entity.index];
+    const uint32_t source = record.archetype;
+    uint32_t       chunk, row;
+    allocateRow(destination, chunk, row);
+
+    const Archetype& from = *archetypes_[source];
+    const Archetype& to = *archetypes_[destination];
+    uint8_t*         toData = to.chunks[chunk]->data;
+    const uint8_t*   fromData = from.chunks[record.chunk]->data;
+    reinterpret_cast<Entity*>(toData)[row] = entity;
+    for (const ComponentId id : from.components) {
+        if (to.offsets[id] != None) {
+            const uint32_t size = components[id].size;
+            std::memcpy(toData + to.offsets[id] + size_t(row) * size, fromData + from.offsets[id] + size_t(record.row) * size, size);
+        }
+    }
+
+    freeRow(source, record.chunk, record.row);
+    record.archetype = destination;
+    record.chunk = chunk;
+    record.row = row;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeB̔ԍmۂ
+ */
+Entity EntityWorld::allocateEntity() {
+    ++size_;
+    if (!freeEntities_.empty()) {
+        const uint32_t index = freeEntities_.back();
+        freeEntities_.pop_back();
+        return { index, records_[index].generation };
+    }
+    records_.push_back({ None, 0, 0, 0 });
+    return { static_cast<uint32_t>(records_.size() - 1), 0 };
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`N̓ǂݏ
+ */
+ChunkView EntityWorld::view(const Archetype& archetype, uint32_t chunk) const noexcept {
+    ChunkView result;
+    result.data_ = archetype.chunks[chunk]->data;
+    result.offsets_ = archetype.offsets.data();
+    result.count_ = archetype.counts[chunk];
+    return result;
+}
@@ -0,0 +1,463 @@
+// GeBeB[hNXiA[L^Cv^ ECSj
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+/// R|[lg̎ނ̔ԍ
+using ComponentId = uint32_t;
+
+/// R|[lg̑gݍ킹iComponentId Ԗڂ̃rbgĂΎj
+using ComponentMask = uint64_t;
+
+/// NG̔ԍ
+using QueryId = uint32_t;
+
+/// R|[lg̎ނ̍ő吔
+constexpr uint32_t MaxComponents = 64;
+
+/// `N 1 ̃oCg
+constexpr uint32_t ChunkBytes = 16 * 1024;
+
+/// GeBeBiԍƐB폜Ɛオi݁AÂnh͖ɂȂj
+struct Entity {
+    uint32_t index = UINT32_MAX;  ///< ԍ
+    uint32_t generation = 0;      ///< 
+
+    bool operator==(const Entity& other) const noexcept {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const Entity& other) const noexcept {
+        return !(*this == other);
+    }
+};
+
+/// R|[lg̎ނ̏
+struct ComponentInfo {
+    uint32_t    size;       ///< oCg
+    uint32_t    alignment;  ///< ACg
+    const char* name;       ///< OiV[̕ۑȂǂŎgj
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R|[lg̎ނo^icomponentId Ă΂j
+ * @param	size		oCg
+ * @param	alignment	ACg
+ * @param	name		O
+ * @return	R|[lg̎ނ̔ԍ
+ */
+ComponentId registerComponent(uint32_t size, uint32_t alignment, const char* name) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R|[lg̎ނ̏擾
+ * @param	id	R|[lg̎ނ̔ԍ
+ * @return	
+ */
+const ComponentInfo& componentInfo(ComponentId id) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	o^ꂽR|[lg̎ނ̐擾
+ * @return	ނ̐
+ */
+uint32_t componentCount() noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	OR|[lg̎ނT
+ * @param	name	O
+ * @return	R|[lg̎ނ̔ԍio^ĂȂ UINT32_MAXj
+ */
+ComponentId findComponent(const char* name) noexcept;
+
+/// R|[lg̖Oi^ static constexpr const char* ComponentName ΂A΃RpC[̌^j
+template <typename T, typename = void>
+struct ComponentNameOf {
+    static const char* get() noexcept { return typeid(T).name(); }
+};
+template <typename T>
+struct ComponentNameOf<T, std::void_t<decltype(T::ComponentName)>> {
+    static const char* get() noexcept { return T::ComponentName; }
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R|[lg̎ނ̔ԍ擾iŏɌĂ΂ꂽɓo^j
+ * @tparam	T	R|[lgi`N memcpy ŏoꂷ̂ trivially copyable ɌB
+ *				t@CɕۑȂ static constexpr const char* ComponentName ŃRpC[ɂȂOtj
+ * @return	R|[lg̎ނ̔ԍ
+ */
+template <typename T>
+ComponentId componentId() noexcept {
+    static_assert(std::is_trivially_copyable<T>::value, "R|[lg memcpy ňڂ^ɂĂ");
+    static const ComponentId id = registerComponent(sizeof(T), alignof(T), ComponentNameOf<T>::get());
+    return id;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R|[lg̑gݍ킹
+ * @tparam	T	R|[lg
+ * @return	gݍ킹
+ */
+template <typename... T>
+ComponentMask componentMask() noexcept {
+    return (ComponentMask{} | ... | (ComponentMask{ 1 } << componentId<T>()));
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`N 1 ̓ǂݏ
+ * @details	`N̒͐Ƃ̔ziSoAjŁAR|[lg size() 
+ *			\̕ύXiGeBeB̍쐬E폜AR|[lg̒ǉE폜jƖɂȂ
+ */
+class ChunkView final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeB擾
+     * @return	GeBeB
+     */
+    [[nodiscard]] uint32_t size() const noexcept {
+        return count_;
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeB̕т擾
+     * @return	size() ̃GeBeB
+     */
+    [[nodiscard]] const Entity* entities() const noexcept {
+        return reinterpret_cast<const Entity*>(data_);
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lg̕т擾
+     * @param	id	R|[lg̎ނ̔ԍ
+     * @return	size() ̃R|[lgiĂȂ nullptrj
+     */
+    [[nodiscard]] void* column(ComponentId id) const noexcept {
+        return offsets_[id] == UINT32_MAX ? nullptr : data_ + offsets_[id];
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lg̕т擾
+     * @tparam	T	R|[lg
+     * @return	size() ̃R|[lgiĂȂ nullptrj
+     */
+    template <typename T>
+    [[nodiscard]] T* get() const noexcept {
+        return static_cast<T*>(column(componentId<T>()));
+    }
+
+private:
+    friend class EntityWorld;
+
+    uint8_t*        data_{};     /// `N̐擪
+    const uint32_t* offsets_{};  /// R|[lg̎ނƂ̕т̊JnʒuiĂȂ UINT32_MAXj
+    uint32_t        count_{};    /// GeBeB
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeB[hNX
+ * @details	R|[lg̑gݍ킹iA[L^Cvj̃GeBeB 16KB ̃`N SoA ŋl߂
+ *			`N͑Ol߂ĎgA폜͍Ō̃GeBeBŌ𖄂߂̂ŁAԂłȂ
+ *			A[L^CvԂ̈ړ̓R|[lgƂɊoĂA2 ڂ͒TȂ
+ *			NG͍ɍA[L^CvW߂ĂAォłA[L^Cv̎ɑ
+ *			\̕ύX͂̃NX𒼐ڌĂԂAɏԂ EntityCommandBuffer ɋL^ČŔf
+ */
+class EntityWorld final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    EntityWorld();
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~EntityWorld();
+
+    // Rs[֎~
+    EntityWorld(const EntityWorld&) = delete;
+    EntityWorld& operator=(const EntityWorld&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeB쐬iR|[lg̒g͖j
+     * @param	mask	R|[lg̑gݍ킹
+     * @return	GeBeB
+     */
+    Entity create(ComponentMask mask);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeB܂Ƃ߂č쐬iR|[lg̒g͖j
+     * @param	mask	R|[lg̑gݍ킹
+     * @param	count	쐬鐔
+     * @param	func	߂`NƂ func(`N, `N̊Jnʒu, 쐬̊Jnԍ) ̌`ŌĂ΂鏈
+     * @details	`NƂɌĂԂ̂ŁAR|[lg̔z܂Ƃ߂ memcpy ł
+     */
+    void createBatch(ComponentMask mask, uint32_t count, const std::function<void(const ChunkView&, uint32_t, uint32_t)>& func);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lgăGeBeB쐬
+     * @param	components	R|[lg
+     * @return	GeBeB
+     */
+    template <typename... T>
+    Entity create(const T&... components) {
+        const Entity entity = create(componentMask<T...>());
+        ((*get<T>(entity) = components), ...);
+        return entity;
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeB폜
+     * @param	entity	GeBeB
+     * @return	폜 trueiɖȂ falsej
+     */
+    bool destroy(Entity entity);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeBL
+     * @param	entity	GeBeB
+     * @return	LȂ true
+     */
+    [[nodiscard]] bool isAlive(Entity entity) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lgǉiɎĂ΍̒l̏ꏊԂj
+     * @param	entity	GeBeB
+     * @param	id		R|[lg̎ނ̔ԍ
+     * @return	R|[lg̏ꏊiǉꍇ͖j
+     */
+    void* add(Entity entity, ComponentId id);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lg폜
+     * @param	entity	GeBeB
+     * @param	id		R|[lg̎ނ̔ԍ
+     * @return	폜 true
+     */
+    bool remove(Entity entity, ComponentId id);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lg̏ꏊ擾
+     * @param	entity	GeBeB
+     * @param	id		R|[lg̎ނ̔ԍ
+     * @return	ꏊiĂȂ nullptrj
+     */
+    [[nodiscard]] void* get(Entity entity, ComponentId id) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lgǉiɎĂΏ㏑j
+     * @param	entity		GeBeB
+     * @param	component	R|[lg
+     */
+    template <typename T>
+    void add(Entity entity, const T& component) {
+        *static_cast<T*>(add(entity, componentId<T>())) = component;
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lg폜
+     * @param	entity	GeBeB
+     * @return	폜 true
+     */
+    template <typename T>
+    bool remove(Entity entity) {
+        return remove(entity, componentId<T>());
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	R|[lg擾
+     * @param	entity	GeBeB
+     * @return	R|[lgiĂȂ nullptrj
+     */
+    template <typename T>
+    [[nodiscard]] T* get(Entity entity) const noexcept {
+        return static_cast<T*>(get(entity, componentId<T>()));
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeB̃R|[lg̑gݍ킹擾
+     * @param	entity	GeBeB
+     * @return	gݍ킹
+     */
+    [[nodiscard]] ComponentMask mask(Entity entity) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	NGĩNG΂Ԃj
+     * @param	all		SĎĂR|[lg
+     * @param	none	1 ĂȂR|[lg
+     * @return	NG̔ԍ
+     */
+    QueryId createQuery(ComponentMask all, ComponentMask none = 0);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	NGɍ`NW߂
+     * @param	query	NG̔ԍ
+     * @param	chunks	`N̒ǉ
+     */
+    void collectChunks(QueryId query, std::vector<ChunkView>& chunks) const;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	NGɍ`NƂɏ
+     * @param	query	NG̔ԍ
+     * @param	func	func(`N) ̌`ŌĂ΂鏈iō\ςȂƁj
+     */
+    void forEachChunk(QueryId query, const std::function<void(const ChunkView&)>& func) const;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	NGɍGeBeBƂɏ
+     * @param	query	NG̔ԍiT SĎƁj
+     * @param	func	func(T&...) ̌`ŌĂ΂鏈iō\ςȂƁj
+     */
+    template <typename... T, typename Func>
+    void each(QueryId query, Func&& func) const {
+        forEachChunk(query, [&](const ChunkView& chunk) {
+            const std::tuple<T*...> columns{ chunk.get<T>()... };
+            for (uint32_t i = 0; i < chunk.size(); ++i) {
+                func(std::get<T*>(columns)[i]...);
+            }
+        });
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	NGɍGeBeB擾
+     * @param	query	NG̔ԍ
+     * @return	GeBeB
+     */
+    [[nodiscard]] uint32_t count(QueryId query) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	LȃGeBeB擾
+     * @return	GeBeB
+     */
+    [[nodiscard]] uint32_t size() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	A[L^Cv̐擾
+     * @return	A[L^Cv̐
+     */
+    [[nodiscard]] uint32_t archetypeCount() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	mۂĂ`N擾ig񂷂߂ɎĂ镪܂ށj
+     * @return	`N
+     */
+    [[nodiscard]] uint32_t allocatedChunkCount() const noexcept;
+
+private:
+    /// `Ñ
+    struct alignas(64) Chunk {
+        uint8_t data[ChunkBytes];
+    };
+
+    /// A[L^CviR|[lg̑gݍ킹̃GeBeB̏W܂j
+    struct Archetype {
+        ComponentMask                          mask{};          ///< R|[lg̑gݍ킹
+        std::vector<ComponentId>               components{};    ///< ĂR|[lgiԍj
+        std::array<uint32_t, MaxComponents>    offsets{};       ///< R|[lg̎ނƂ̕т̊Jnʒui UINT32_MAXj
+        std::array<uint32_t, MaxComponents>    addEdges{};      ///< R|[lg𑫂̈ړiT UINT32_MAXj
+        std::array<uint32_t, MaxComponents>    removeEdges{};   ///< R|[lg̈ړiT UINT32_MAXj
+        std::vector<std::unique_ptr<Chunk>>    chunks{};        ///< `NiŌȊO͖tj
+        std::vector<uint32_t>                  counts{};        ///< `NƂ̃GeBeB
+        uint32_t                               capacity{};      ///< 1 `ÑGeBeB
+        uint32_t                               size{};          ///< GeBeB
+    };
+
+    /// GeBeB̋ꏊ
+    struct Record {
+        uint32_t archetype;   ///< A[L^Cv̔ԍi폜ς݂Ȃ UINT32_MAXj
+        uint32_t chunk;       ///< `N̔ԍ
+        uint32_t row;         ///< `N̈ʒu
+        uint32_t generation;  ///< 
+    };
+
+    /// NG
+    struct Query {
+        ComponentMask         all{};         ///< SĎĂR|[lg
+        ComponentMask         none{};        ///< 1 ĂȂR|[lg
+        std::vector<uint32_t> archetypes{};  ///< A[L^Cv
+    };
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	gݍ킹̃A[L^CvTi΍j
+     */
+    uint32_t findArchetype(ComponentMask mask);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	A[L^Cv̖ɍsmۂ
+     */
+    void allocateRow(uint32_t archetype, uint32_t& chunk, uint32_t& row);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	s󂯂iŌ̍sڂĖ߂j
+     */
+    void freeRow(uint32_t archetype, uint32_t chunk, uint32_t row) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeBʂ̃A[L^Cvֈڂiʂ̃R|[lg͎ʂj
+     */
+    void move(Entity entity, uint32_t destination);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeB̔ԍmۂ
+     */
+    Entity allocateEntity();
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	`N̓ǂݏ
+     */
+    ChunkView view(const Archetype& archetype, uint32_t chunk) const noexcept;
+
+    std::vector<std::unique_ptr<Archetype>> archetypes_{};   /// A[L^Cvi0 Ԃ̓R|[lgj
+    std::unordered_map<ComponentMask, uint32_t> lookup_{};   /// gݍ킹A[L^Cv̔ԍ
+    std::vector<Record>                     records_{};      /// GeBeB̔ԍƂ̋ꏊ
+    std::vector<uint32_t>                   freeEntities_{}; /// 󂢂ĂGeBeB̔ԍ
+    std::vector<std::unique_ptr<Chunk>>     freeChunks_{};   /// g񂷃`N
+    std::vector<Query>                      queries_{};      /// NG
+    uint32_t                                chunkCount_{};   /// mۂ`N
+    uint32_t                                size_{};         /// LȃGeBeB
+};
@@ -0,0 +1,482 @@
+// JO
+
+#include "frustum_culling.h"
+#include "job_system.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define FRUSTUM_CULLING_SSE 1
+#include <immintrin.h>
+#endif
+#if defined(__AVX2__)
+#define FRUSTUM_CULLING_AVX2 1
+#endif
+
+namespace {
+
+/// 񏈗 1 `N̗vfiSIMD ̔{j
+constexpr uint32_t CullChunkSize = 4096;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	E 1 𔻒肷
+ * @return	 true
+ */
+bool isSphereVisible(const CullFrustum& frustum, float x, float y, float z, float radius) noexcept {
+    for (const auto& plane : frustum.planes) {
+        // ] isSphereInFrustum Ɠ ((x + y) + z) + w
+        float distance = plane[0] * x;
+        distance = distance + plane[1] * y;
+        distance = distance + plane[2] * z;
+        distance = distance + plane[3];
+        if (distance < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	AABB 1 𔻒肷
+ * @return	 true
+ */
+bool isBoxVisible(const CullFrustum& frustum, const BoundingBoxes& boxes, uint32_t i) noexcept {
+    for (const auto& plane : frustum.planes) {
+        float distance = plane[0] * boxes.centerX()[i];
+        distance = distance + plane[1] * boxes.centerY()[i];
+        distance = distance + plane[2] * boxes.centerZ()[i];
+        distance = distance + plane[3];
+        float radius = std::fabs(plane[0]) * boxes.extentX()[i];
+        radius = radius + std::fabs(plane[1]) * boxes.extentY()[i];
+        radius = radius + std::fabs(plane[2]) * boxes.extentZ()[i];
+        if (distance < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[begin, end) ̋EXJ[Ŕ肷
+ * @return	out ɏ񂾐
+ */
+uint32_t cullSpheresScalar(const CullFrustum& frustum, const BoundingSpheres& spheres, uint32_t begin, uint32_t end, uint32_t* out) noexcept {
+    uint32_t count = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+        out[count] = i;
+        count += isSphereVisible(frustum, spheres.x()[i], spheres.y()[i], spheres.z()[i], spheres.radius()[i]) ? 1 : 0;
+    }
+    return count;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[begin, end)  AABB XJ[Ŕ肷
+ * @return	out ɏ񂾐
+ */
+uint32_t cullBoxesScalar(const CullFrustum& frustum, const BoundingBoxes& boxes, uint32_t begin, uint32_t end, uint32_t* out) noexcept {
+    uint32_t count = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+        out[count] = i;
+        count += isBoxVisible(frustum, boxes, i) ? 1 : 0;
+    }
+    return count;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	}XN̗Ăԍ𕪊򂹂ɏ
+ * @param	mask	}XNiʃrbg first, first + 1, ...j
+ * @param	width	}XÑrbg
+ * @param	first	擪̔ԍ
+ * @param	out		ݐ
+ * @param	count	ݍς݂̐iXVj
+ * @details	Ȃvfނ̗vfŏ㏑B݈ʒu͏ɔς݂̗vfȉȂ̂Ŕ͈͊Oɂ͏oȂ
+ */
+inline void writeVisible(uint32_t mask, uint32_t width, uint32_t first, uint32_t* out, uint32_t& count) noexcept {
+    for (uint32_t lane = 0; lane < width; ++lane) {
+        out[count] = first + lane;
+        count += (mask >> lane) & 1;
+    }
+}
+
+#if FRUSTUM_CULLING_SSE
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[begin, end) ̋E SSE  4 肷
+ * @return	out ɏ񂾐
+ */
+uint32_t cullSpheresSse(const CullFrustum& frustum, const BoundingSpheres& spheres, uint32_t begin, uint32_t end, uint32_t* out) noexcept {
+    __m128 planes[6][4];
+    for (int p = 0; p < 6; ++p) {
+        for (int c = 0; c < 4; ++c) {
+            planes[p][c] = _mm_set1_ps(frustum.planes[p][c]);
+        }
+    }
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    uint32_t count = 0;
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const __m128 x = _mm_loadu_ps(spheres.x() + i);
+        const __m128 y = _mm_loadu_ps(spheres.y() + i);
+        const __m128 z = _mm_loadu_ps(spheres.z() + i);
+        const __m128 negativeRadius = _mm_xor_ps(_mm_loadu_ps(spheres.radius() + i), signBit);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const auto& plane : planes) {
+            __m128 distance = _mm_mul_ps(plane[0], x);
+            distance = _mm_add_ps(distance, _mm_mul_ps(plane[1], y));
+            distance = _mm_add_ps(distance, _mm_mul_ps(plane[2], z));
+            distance = _mm_add_ps(distance, plane[3]);
+            // !(distance < -radius)BNaN ̓XJ[łƓ鈵
+            inside = _mm_and_ps(inside, _mm_cmpnlt_ps(distance, negativeRadius));
+        }
+        writeVisible(static_cast<uint32_t>(_mm_movemask_ps(inside)), 4, i, out, count);
+    }
+    return count + cullSpheresScalar(frustum, spheres, i, end, out + count);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[begin, end)  AABB  SSE  4 肷
+ * @return	out ɏ񂾐
+ */
+uint32_t cullBoxesSse(const CullFrustum& frustum, const BoundingBoxes& boxes, uint32_t begin, uint32_t end, uint32_t* out) noexcept {
+    __m128 planes[6][4];
+    __m128 absPlanes[6][3];
+    for (int p = 0; p < 6; ++p) {
+        for (int c = 0; c < 4; ++c) {
+            planes[p][c] = _mm_set1_ps(frustum.planes[p][c]);
+        }
+        for (int c = 0; c < 3; ++c) {
+            absPlanes[p][c] = _mm_set1_ps(std::fabs(frustum.planes[p][c]));
+        }
+    }
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    uint32_t count = 0;
+    uint32_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const __m128 cx = _mm_loadu_ps(boxes.centerX() + i);
+        const __m128 cy = _mm_loadu_ps(boxes.centerY() + i);
+        const __m128 cz = _mm_loadu_ps(boxes.centerZ() + i);
+        const __m128 ex = _mm_loadu_ps(boxes.extentX() + i);
+        const __m128 ey = _mm_loadu_ps(boxes.extentY() + i);
+        const __m128 ez = _mm_loadu_ps(boxes.extentZ() + i);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m128 distance = _mm_mul_ps(planes[p][0], cx);
+            distance = _mm_add_ps(distance, _mm_mul_ps(planes[p][1], cy));
+            distance = _mm_add_ps(distance, _mm_mul_ps(planes[p][2], cz));
+            distance = _mm_add_ps(distance, planes[p][3]);
+            __m128 radius = _mm_mul_ps(absPlanes[p][0], ex);
+            radius = _mm_add_ps(radius, _mm_mul_ps(absPlanes[p][1], ey));
+            radius = _mm_add_ps(radius, _mm_mul_ps(absPlanes[p][2], ez));
+            inside = _mm_and_ps(inside, _mm_cmpnlt_ps(distance, _mm_xor_ps(radius, signBit)));
+        }
+        writeVisible(static_cast<uint32_t>(_mm_movemask_ps(inside)), 4, i, out, count);
+    }
+    return count + cullBoxesScalar(frustum, boxes, i, end, out + count);
+}
+#endif
+
+#if FRUSTUM_CULLING_AVX2
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[begin, end) ̋E AVX2  8 肷
+ * @return	out ɏ񂾐
+ */
+uint32_t cullSpheresAvx2(const CullFrustum& frustum, const BoundingSpheres& spheres, uint32_t begin, uint32_t end, uint32_t* out) noexcept {
+    __m256 planes[6][4];
+    for (int p = 0; p < 6; ++p) {
+        for (int c = 0; c < 4; ++c) {
+            planes[p][c] = _mm256_set1_ps(frustum.planes[p][c]);
+        }
+    }
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+    uint32_t count = 0;
+    uint32_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        const __m256 x = _mm256_loadu_ps(spheres.x() + i);
+        const __m256 y = _mm256_loadu_ps(spheres.y() + i);
+        const __m256 z = _mm256_loadu_ps(spheres.z() + i);
+        const __m256 negativeRadius = _mm256_xor_ps(_mm256_loadu_ps(spheres.radius() + i), signBit);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const auto& plane : planes) {
+            __m256 distance = _mm256_mul_ps(plane[0], x);
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(plane[1], y));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(plane[2], z));
+            distance = _mm256_add_ps(distance, plane[3]);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negativeRadius, _CMP_NLT_UQ));
+        }
+        writeVisible(static_cast<uint32_t>(_mm256_movemask_ps(inside)), 8, i, out, count);
+    }
+    return count + cullSpheresSse(frustum, spheres, i, end, out + count);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[begin, end)  AABB  AVX2  8 肷
+ * @return	out ɏ񂾐
+ */
+uint32_t cullBoxesAvx2(const CullFrustum& frustum, const BoundingBoxes& boxes, uint32_t begin, uint32_t end, uint32_t* out) noexcept {
+    __m256 planes[6][4];
+    __m256 absPlanes[6][3];
+    for (int p = 0; p < 6; ++p) {
+        for (int c = 0; c < 4; ++c) {
+            planes[p][c] = _mm256_set1_ps(frustum.planes[p][c]);
+        }
+        for (int c = 0; c < 3; ++c) {
+            absPlanes[p][c] = _mm256_set1_ps(std::fabs(frustum.planes[p][c]));
+        }
+    }
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+    uint32_t count = 0;
+    uint32_t i = begin;
+    for (; i + 8 <= end; i += 8) {
+        const __m256 cx = _mm256_loadu_ps(boxes.centerX() + i);
+        const __m256 cy = _mm256_loadu_ps(boxes.centerY() + i);
+        const __m256 cz = _mm256_loadu_ps(boxes.centerZ() + i);
+        const __m256 ex = _mm256_loadu_ps(boxes.extentX() + i);
+        const __m256 ey = _mm256_loadu_ps(boxes.extentY() + i);
+        const __m256 ez = _mm256_loadu_ps(boxes.extentZ() + i);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m256 distance = _mm256_mul_ps(planes[p][0], cx);
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(planes[p][1], cy));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(planes[p][2], cz));
+            distance = _mm256_add_ps(distance, planes[p][3]);
+            __m256 radius = _mm256_mul_ps(absPlanes[p][0], ex);
+            radius = _mm256_add_ps(radius, _mm256_mul_ps(absPlanes[p][1], ey));
+            radius = _mm256_add_ps(radius, _mm256_mul_ps(absPlanes[p][2], ez));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_xor_ps(radius, signBit), _CMP_NLT_UQ));
+        }
+        writeVisible(static_cast<uint32_t>(_mm256_movemask_ps(inside)), 8, i, out, count);
+    }
+    return count + cullBoxesSse(frustum, boxes, i, end, out + count);
+}
+#endif
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[0, count) `NɕĔ肵Aʂԍɋl߂
+ * @param	count		vf
+ * @param	visible		ݐicount j
+ * @param	jobSystem	WuVXeinullptr Ȃ璀j
+ * @param	kernel		kernel(begin, end, out)  [begin, end) 𔻒肵Aout ɏԂ
+ * @return	vf
+ */
+template <typename Kernel>
+uint32_t cullChunks(uint32_t count, uint32_t* visible, JobSystem* jobSystem, const Kernel& kernel) {
+    if (!jobSystem || count <= CullChunkSize) {
+        return kernel(0, count, visible);
+    }
+
+    // e`N͎̐擪ʒu珑AőOɋl߂
+    const uint32_t chunkCount = (count + CullChunkSize - 1) / CullChunkSize;
+    static thread_local std::vector<uint32_t> chunkVisible;
+    chunkVisible.resize(chunkCount);
+    uint32_t* counts = chunkVisible.data();
+    jobSystem->parallelFor(chunkCount, 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t chunk = begin; chunk < end; ++chunk) {
+            const uint32_t first = chunk * CullChunkSize;
+            const uint32_t last = first + CullChunkSize < count ? first + CullChunkSize : count;
+            counts[chunk] = kernel(first, last, visible + first);
+        }
+    });
+
+    uint32_t total = counts[0];
+    for (uint32_t chunk = 1; chunk < chunkCount; ++chunk) {
+        std::memmove(visible + total, visible + chunk * CullChunkSize, counts[chunk] * sizeof(uint32_t));
+        total += counts[chunk];
+    }
+    return total;
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̃rhŎgł̍L߃Zbg擾
+ * @return	߃Zbg
+ */
+[[nodiscard]] CullSimd bestCullSimd() noexcept {
+#if FRUSTUM_CULLING_AVX2
+    return CullSimd::Avx2;
+#elif FRUSTUM_CULLING_SSE
+    return CullSimd::Sse;
+#else
+    return CullSimd::Scalar;
+#endif
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Sč폜
+ */
+void BoundingSpheres::clear() noexcept {
+    x_.clear();
+    y_.clear();
+    z_.clear();
+    radius_.clear();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Eǉ
+ * @param	center	S
+ * @param	radius	a
+ * @return	ǉE̔ԍ
+ */
+uint32_t BoundingSpheres::add(const float center[3], float radius) {
+    x_.push_back(center[0]);
+    y_.push_back(center[1]);
+    z_.push_back(center[2]);
+    radius_.push_back(radius);
+    return static_cast<uint32_t>(radius_.size() - 1);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	EXV
+ * @param	index	ԍ
+ * @param	center	S
+ * @param	radius	a
+ */
+void BoundingSpheres::set(uint32_t index, const float center[3], float radius) noexcept {
+    x_[index] = center[0];
+    y_[index] = center[1];
+    z_[index] = center[2];
+    radius_[index] = radius;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	E̐擾
+ * @return	E̐
+ */
+[[nodiscard]] uint32_t BoundingSpheres::size() const noexcept {
+    return static_cast<uint32_t>(radius_.size());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Sč폜
+ */
+void BoundingBoxes::clear() noexcept {
+    centerX_.clear();
+    centerY_.clear();
+    centerZ_.clear();
+    extentX_.clear();
+    extentY_.clear();
+    extentZ_.clear();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	AABB ǉ
+ * @param	min	ŏW
+ * @param	max	őW
+ * @return	ǉ AABB ̔ԍ
+ */
+uint32_t BoundingBoxes::add(const float min[3], const float max[3]) {
+    centerX_.push_back(0.0f);
+    centerY_.push_back(0.0f);
+    centerZ_.push_back(0.0f);
+    extentX_.push_back(0.0f);
+    extentY_.push_back(0.0f);
+    extentZ_.push_back(0.0f);
+    const uint32_t index = static_cast<uint32_t>(centerX_.size() - 1);
+    set(index, min, max);
+    return index;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	AABB XV
+ * @param	index	ԍ
+ * @param	min		ŏW
+ * @param	max		őW
+ */
+void BoundingBoxes::set(uint32_t index, const float min[3], const float max[3]) noexcept {
+    centerX_[index] = (min[0] + max[0]) * 0.5f;
+    centerY_[index] = (min[1] + max[1]) * 0.5f;
+    centerZ_[index] = (min[2] + max[2]) * 0.5f;
+    extentX_[index] = (max[0] - min[0]) * 0.5f;
+    extentY_[index] = (max[1] - min[1]) * 0.5f;
+    extentZ_[index] = (max[2] - min[2]) * 0.5f;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	AABB ̐擾
+ * @return	AABB ̐
+ */
+[[nodiscard]] uint32_t BoundingBoxes::size() const noexcept {
+    return static_cast<uint32_t>(centerX_.size());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	EJOÂ̔ԍl߂ď
+ * @param	frustum		
+ * @param	spheres		E
+ * @param	visible		ԍ̏ݐispheres.size() j
+ * @param	jobSystem	ɏꍇ̃WuVXe
+ * @param	simd		g߃Zbg
+ * @return	鋫E̐
+ */
+uint32_t cullSpheres(const CullFrustum& frustum, const BoundingSpheres& spheres, uint32_t* visible, JobSystem* jobSystem, CullSimd simd) {
+    simd = simd > bestCullSimd() ? bestCullSimd() : simd;
+    return cullChunks(spheres.size(), visible, jobSystem, [&](uint32_t begin, uint32_t end, uint32_t* out) {
+        switch (simd) {
+#if FRUSTUM_CULLING_AVX2
+        case CullSimd::Avx2:
+            return cullSpheresAvx2(frustum, spheres, begin, end, out);
+#endif
+#if FRUSTUM_CULLING_SSE
+        case CullSimd::Sse:
+            return cullSpheresSse(frustum, spheres, begin, end, out);
+#endif
+        default:
+            return cullSpheresScalar(frustum, spheres, begin, end, out);
+        }
+    });
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	AABB JOÂ̔ԍl߂ď
+ * @param	frustum		
+ * @param	boxes		AABB
+ * @param	visible		ԍ̏ݐiboxes.size() j
+ * @param	jobSystem	ɏꍇ̃WuVXe
+ * @param	simd		g߃Zbg
+ * @return	 AABB ̐
+ */
+uint32_t cullBoxes(const CullFrustum& frustum, const BoundingBoxes& boxes, uint32_t* visible, JobSystem* jobSystem, CullSimd simd) {
+    simd = simd > bestCullSimd() ? bestCullSimd() : simd;
+    return cullChunks(boxes.size(), visible, jobSystem, [&](uint32_t begin, uint32_t end, uint32_t* out) {
+        switch (simd) {
+#if FRUSTUM_CULLING_AVX2
+        case CullSimd::Avx2:
+            return cullBoxesAvx2(frustum, boxes, begin, end, out);
+#endif
+#if FRUSTUM_CULLING_SSE
+        case CullSimd::Sse:
+            return cullBoxesSse(frustum, boxes, begin, end, out);
+#endif
+        default:
+            return cullBoxesScalar(frustum, boxes, begin, end, out);
+        }
+    });
+}
@@ -0,0 +1,155 @@
+// JO
+
+#pragma once
+
+#include "indirect_cull.h"
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+/// JOɎg߃Zbg
+enum class CullSimd : uint8_t {
+    Scalar,  ///< SIMD gȂ
+    Sse,     ///< SSEi4 vfj
+    Avx2,    ///< AVX2i8 vfj
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̃rhŎgł̍L߃Zbg擾
+ * @return	߃Zbgix64 Ȃ SSE ȏAAVX2  /arch:AVX2 ȂǂŃrhꍇ̂݁j
+ */
+[[nodiscard]] CullSimd bestCullSimd() noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	E SoA zNX
+ * @details	S XYZ ƔaʁX̔zɒuASIMD ł܂Ƃ߂Ĕł悤ɂ
+ */
+class BoundingSpheres final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Sč폜
+     */
+    void clear() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Eǉ
+     * @param	center	S
+     * @param	radius	a
+     * @return	ǉE̔ԍiJOʂ̔ԍj
+     */
+    uint32_t add(const float center[3], float radius);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	EXV
+     * @param	index	ԍ
+     * @param	center	S
+     * @param	radius	a
+     */
+    void set(uint32_t index, const float center[3], float radius) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	E̐擾
+     * @return	E̐
+     */
+    [[nodiscard]] uint32_t size() const noexcept;
+
+    const float* x() const noexcept { return x_.data(); }
+    const float* y() const noexcept { return y_.data(); }
+    const float* z() const noexcept { return z_.data(); }
+    const float* radius() const noexcept { return radius_.data(); }
+
+private:
+    std::vector<float> x_{};       /// S X
+    std::vector<float> y_{};       /// S Y
+    std::vector<float> z_{};       /// S Z
+    std::vector<float> radius_{};  /// a
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	AABB  SoA zNX
+ * @details	SƔ̑傫ŎASIMD ł܂Ƃ߂Ĕł悤ɂ
+ */
+class BoundingBoxes final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Sč폜
+     */
+    void clear() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	AABB ǉ
+     * @param	min	ŏW
+     * @param	max	őW
+     * @return	ǉ AABB ̔ԍiJOʂ̔ԍj
+     */
+    uint32_t add(const float min[3], const float max[3]);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	AABB XV
+     * @param	index	ԍ
+     * @param	min		ŏW
+     * @param	max		őW
+     */
+    void set(uint32_t index, const float min[3], const float max[3]) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	AABB ̐擾
+     * @return	AABB ̐
+     */
+    [[nodiscard]] uint32_t size() const noexcept;
+
+    const float* centerX() const noexcept { return centerX_.data(); }
+    const float* centerY() const noexcept { return centerY_.data(); }
+    const float* centerZ() const noexcept { return centerZ_.data(); }
+    const float* extentX() const noexcept { return extentX_.data(); }
+    const float* extentY() const noexcept { return extentY_.data(); }
+    const float* extentZ() const noexcept { return extentZ_.data(); }
+
+private:
+    std::vector<float> centerX_{};  /// S X
+    std::vector<float> centerY_{};  /// S Y
+    std::vector<float> centerZ_{};  /// S Z
+    std::vector<float> extentX_{};  /// ̑傫 X
+    std::vector<float> extentY_{};  /// ̑傫 Y
+    std::vector<float> extentZ_{};  /// ̑傫 Z
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	EJOÂ̔ԍl߂ď
+ * @param	frustum		imakeCullFrustum ṓj
+ * @param	spheres		E
+ * @param	visible		ԍ̏ݐispheres.size() j
+ * @param	jobSystem	ɏꍇ̃WuVXeinullptr ȂĂяoXbhŏj
+ * @param	simd		g߃ZbgĩrhŎgȂ̂ bestCullSimd() ɗƂj
+ * @return	鋫E̐
+ * @details	ԍ͏ɕԁB莮 isSphereInFrustum Ɠ
+ */
+uint32_t cullSpheres(const CullFrustum& frustum, const BoundingSpheres& spheres, uint32_t* visible, JobSystem* jobSystem = nullptr,
+                     CullSimd simd = bestCullSimd());
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	AABB JOÂ̔ԍl߂ď
+ * @param	frustum		imakeCullFrustum ṓj
+ * @param	boxes		AABB
+ * @param	visible		ԍ̏ݐiboxes.size() j
+ * @param	jobSystem	ɏꍇ̃WuVXeinullptr ȂĂяoXbhŏj
+ * @param	simd		g߃ZbgĩrhŎgȂ̂ bestCullSimd() ɗƂj
+ * @return	 AABB ̐
+ * @details	ԍ͏ɕԁBʂƂ AABB ̕ʕւ̓ea߂ċƓŔ肷
+ */
+uint32_t cullBoxes(const CullFrustum& frustum, const BoundingBoxes& boxes, uint32_t* visible, JobSystem* jobSystem = nullptr,
+                   CullSimd simd = bestCullSimd());
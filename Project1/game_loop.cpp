@@ -0,0 +1,316 @@
+// Q[[viŒ݂̍̃V~[Vƕ`̕ԁj
+
+#include "game_loop.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    RXgN^
+ * @param	settings	ݒ
+ */
+FixedTimestep::FixedTimestep(const FixedTimestepSettings& settings) noexcept : settings_(settings) {
+    settings_.maxTicksPerFrame = std::max(settings_.maxTicksPerFrame, 1u);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Ԃ߂ɖ߂
+ */
+void FixedTimestep::reset() noexcept {
+    accumulator_ = 0.0;
+    tickCount_ = 0;
+    droppedSeconds_ = 0.0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	oߎԂ𗭂߂
+ * @param	elapsedSeconds	O advance ̌oߕbiȂ 0 Ƃ݂Ȃj
+ * @return	񂷃V~[V̉񐔁imaxTicksPerFrame ܂Łj
+ */
+uint32_t FixedTimestep::advance(double elapsedSeconds) noexcept {
+    accumulator_ += std::max(elapsedSeconds, 0.0);
+    double ticks = std::floor(accumulator_ / settings_.tickSeconds);
+    // 𒴂͉񂳂Ɏ̂Ăi[͎ĉŁA݂̗̍Ԋu͕ςȂj
+    if (ticks > settings_.maxTicksPerFrame) {
+        const double dropped = (ticks - settings_.maxTicksPerFrame) * settings_.tickSeconds;
+        droppedSeconds_ += dropped;
+        accumulator_ -= dropped;
+        ticks = settings_.maxTicksPerFrame;
+    }
+    accumulator_ = std::max(accumulator_ - ticks * settings_.tickSeconds, 0.0);
+    tickCount_ += static_cast<uint64_t>(ticks);
+    return static_cast<uint32_t>(ticks);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Ԃ̊擾
+ * @return	݂̂܂Ďg؂Ȃ [0, 1)
+ */
+float FixedTimestep::alpha() const noexcept {
+    return std::min(static_cast<float>(accumulator_ / settings_.tickSeconds), std::nextafter(1.0f, 0.0f));
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	V~[V̎擾îĂԂoߎԁj
+ * @return	񂵂񐔕̎ + ܂Ă鎞
+ */
+double FixedTimestep::time() const noexcept {
+    return tickTime() + accumulator_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Ōɉ񂵂V~[V̏I̎擾
+ * @return	񂵂 * 
+ */
+double FixedTimestep::tickTime() const noexcept {
+    return static_cast<double>(tickCount_) * settings_.tickSeconds;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̃V~[V܂ł̎Ԃ擾
+ * @return	b
+ */
+double FixedTimestep::untilNextTick() const noexcept {
+    return std::max(settings_.tickSeconds - accumulator_, 0.0);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	񂵂񐔂擾
+ * @return	
+ */
+uint64_t FixedTimestep::tickCount() const noexcept {
+    return tickCount_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	𒴂Ď̂ĂԂ擾
+ * @return	b
+ */
+double FixedTimestep::droppedSeconds() const noexcept {
+    return droppedSeconds_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	݂擾
+ * @return	b
+ */
+double FixedTimestep::tickSeconds() const noexcept {
+    return settings_.tickSeconds;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	XibvVbguiV~[V̌ɌĂԁj
+ * @param	transforms	gXtH[
+ * @param	count		iÕXibvVbg葝͕ԂVlgj
+ * @param	time		V~[V̎
+ */
+void TransformSnapshots::publish(const Transform* transforms, uint32_t count, double time) {
+    uint32_t slot = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (slot == latest_ || slot == previous_ || slot == reading_[0] || slot == reading_[1]) {
+            ++slot;
+        }
+    }
+    Snapshot& snapshot = slots_[slot];
+    snapshot.transforms.assign(transforms, transforms + count);
+    snapshot.time = time;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    previous_ = latest_;
+    latest_ = slot;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`掞̃gXtH[߂
+ * @param	time	`掞iÕXibvVbg͈̔͂Ɏ߂j
+ * @param	out		ʁiŐṼXibvVbg̐ɂj
+ * @return	XibvVbg false
+ */
+bool TransformSnapshots::interpolate(double time, std::vector<Transform>& out) {
+    uint32_t from, to;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (latest_ == None) {
+            return false;
+        }
+        from = previous_;
+        to = latest_;
+        reading_[0] = from;
+        reading_[1] = to;
+    }
+
+    const Snapshot& next = slots_[to];
+    out.assign(next.transforms.begin(), next.transforms.end());
+    if (from != None && next.time > slots_[from].time) {
+        const Snapshot& prior = slots_[from];
+        const float     t = static_cast<float>(std::clamp((time - prior.time) / (next.time - prior.time), 0.0, 1.0));
+        const size_t    count = std::min(prior.transforms.size(), out.size());
+        for (size_t i = 0; i < count; ++i) {
+            const Transform& a = prior.transforms[i];
+            const Transform& b = next.transforms[i];
+            out[i].position = lerp(a.position, b.position, t);
+            out[i].rotation = nlerp(a.rotation, b.rotation, t);
+            out[i].scale = lerp(a.scale, b.scale, t);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    reading_[0] = None;
+    reading_[1] = None;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	uXibvVbĝĂ
+ */
+void TransformSnapshots::clear() noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    latest_ = None;
+    previous_ = None;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+GameLoop::~GameLoop() {
+    stop();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Jn
+ * @param	settings	ݒ
+ * @param	clock		v
+ * @param	tick		V~[V 1 񕪂̏ithreaded Ȃp̃XbhĂ΂j
+ * @return	 true
+ */
+bool GameLoop::start(const GameLoopSettings& settings, ClockFunc clock, TickFunc tick) {
+    stop();
+    if (!clock || !tick || !(settings.timestep.tickSeconds > 0.0)) {
+        return false;
+    }
+    clock_ = std::move(clock);
+    tick_ = std::move(tick);
+    timestep_ = FixedTimestep(settings.timestep);
+    lastClock_ = clock_();
+    publishedClock_ = lastClock_;
+    publishedTime_ = 0.0;
+    publishedTickTime_ = 0.0;
+    quit_ = false;
+    if (settings.threaded) {
+        try {
+            thread_ = std::thread(&GameLoop::simulationMain, this);
+        }
+        catch (...) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	~߂ithreaded ȂXbh̏I҂j
+ */
+void GameLoop::stop() noexcept {
+    if (thread_.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            quit_ = true;
+        }
+        wakeup_.notify_all();
+        thread_.join();
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`̑OɌĂ
+ * @return	`掞iV~[V̎ŁAŐṼV~[V̎ 1 ݈ȓj
+ * @details	threaded łȂΗ܂̃V~[Vŉ
+ */
+double GameLoop::frame() {
+    if (!thread_.joinable()) {
+        step();
+    }
+    // 񂵏I_̌oߎԂ𑫂AŐṼV~[Vւ͐i߂Ȃ
+    const double                now = clock_();
+    std::lock_guard<std::mutex> lock(mutex_);
+    const double                time = publishedTime_ + std::max(now - publishedClock_, 0.0) - timestep_.tickSeconds();
+    return std::min(time, publishedTickTime_);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	񂵂񐔂擾
+ * @return	
+ */
+uint64_t GameLoop::tickCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timestep_.tickCount();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	𒴂Ď̂ĂԂ擾
+ * @return	b
+ */
+double GameLoop::droppedSeconds() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return timestep_.droppedSeconds();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	vė܂̃V~[V
+ */
+void GameLoop::step() {
+    const double now = clock_();
+    uint32_t     ticks;
+    uint64_t     first;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ticks = timestep_.advance(now - lastClock_);
+        first = timestep_.tickCount() - ticks;
+    }
+    lastClock_ = now;
+    for (uint32_t i = 1; i <= ticks; ++i) {
+        tick_(static_cast<double>(first + i) * timestep_.tickSeconds(), timestep_.tickSeconds());
+    }
+
+    // `掞͉񂵏IĂi߂i񂵂Ăr̃V~[V͕̎ԂȂj
+    std::lock_guard<std::mutex> lock(mutex_);
+    publishedClock_ = now;
+    publishedTime_ = timestep_.time();
+    publishedTickTime_ = timestep_.tickTime();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	V~[ṼXbh̏
+ */
+void GameLoop::simulationMain() {
+    for (;;) {
+        step();
+        std::unique_lock<std::mutex> lock(mutex_);
+        const auto                   wait = std::chrono::duration<double>(timestep_.untilNextTick());
+        if (wakeup_.wait_for(lock, wait, [this] { return quit_; })) {
+            break;
+        }
+    }
+}
@@ -0,0 +1,259 @@
+// Q[[viŒ݂̍̃V~[Vƕ`̕ԁj
+
+#pragma once
+
+#include "transform_hierarchy.h"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Œ݂̍̐ݒ
+struct FixedTimestepSettings {
+    double   tickSeconds = 1.0 / 60.0;  ///< V~[V 1 Ői߂b
+    uint32_t maxTicksPerFrame = 5;      ///< 1  advance ŉ񂷏i̎Ԃ͎̂Ăj
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Œ̍
+ * @details	oߎԂ𗭂߁A 1 񕪗܂邲ƂɃV~[V 1 
+ *			`̓t[ƂɁA܂Ďg؂ȂialphajőȌԂԂ
+ *			V~[V݂dƁAx߂߂ɉ񂷉񐔂ĂɒxĩXpCĵŁA
+ *			1  advance ŉ񂷉񐔂ɏ݂A̎Ԃ͎̂Ăi̊Ԃ̓Q[iށj
+ *			voߎԂ󂯎邾Ȃ̂ŁALinux łU̎vŊm߂
+ */
+class FixedTimestep final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     * @param	settings	ݒ
+     */
+    explicit FixedTimestep(const FixedTimestepSettings& settings = {}) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Ԃ߂ɖ߂
+     */
+    void reset() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	oߎԂ𗭂߂
+     * @param	elapsedSeconds	O advance ̌oߕbiȂ 0 Ƃ݂Ȃj
+     * @return	񂷃V~[V̉񐔁imaxTicksPerFrame ܂Łj
+     */
+    uint32_t advance(double elapsedSeconds) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Ԃ̊擾
+     * @return	݂̂܂Ďg؂Ȃ [0, 1)
+     */
+    [[nodiscard]] float alpha() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	V~[V̎擾îĂԂoߎԁj
+     * @return	񂵂񐔕̎ + ܂Ă鎞
+     */
+    [[nodiscard]] double time() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Ōɉ񂵂V~[V̏I̎擾
+     * @return	񂵂 * 
+     */
+    [[nodiscard]] double tickTime() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̃V~[V܂ł̎Ԃ擾
+     * @return	b
+     */
+    [[nodiscard]] double untilNextTick() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	񂵂񐔂擾
+     * @return	
+     */
+    [[nodiscard]] uint64_t tickCount() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	𒴂Ď̂ĂԂ擾
+     * @return	b
+     */
+    [[nodiscard]] double droppedSeconds() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	݂擾
+     * @return	b
+     */
+    [[nodiscard]] double tickSeconds() const noexcept;
+
+private:
+    FixedTimestepSettings settings_{};        /// ݒ
+    double                accumulator_{};     /// ܂Ă鎞
+    uint64_t              tickCount_{};       /// 񂵂
+    double                droppedSeconds_{};  /// ̂Ă
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	gXtH[̃XibvVbg
+ * @details	V~[V邽тɑSẴgXtH[ʂĎƈꏏɒuA
+ *			`͍ŐV 1 ÕXibvVbg`掞ŕԂiʒuƊg͐`A] nlerpj
+ *			V~[Vƕ`悪ʂ̃Xbhł悢B 1 Eǂޑ 1 ܂
+ *			ǂł 2 EŐVE1 ÔǂƂႤuꏊɏ̂ŁAʂԂ̓bNȂ
+ */
+class TransformSnapshots final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	XibvVbguiV~[V̌ɌĂԁj
+     * @param	transforms	gXtH[
+     * @param	count		iÕXibvVbg葝͕ԂVlgj
+     * @param	time		V~[V̎
+     */
+    void publish(const Transform* transforms, uint32_t count, double time);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	`掞̃gXtH[߂
+     * @param	time	`掞iÕXibvVbg͈̔͂Ɏ߂j
+     * @param	out		ʁiŐṼXibvVbg̐ɂj
+     * @return	XibvVbg false
+     */
+    bool interpolate(double time, std::vector<Transform>& out);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	uXibvVbĝĂ
+     */
+    void clear() noexcept;
+
+private:
+    /// uꏊ̐iǂł 2 EŐVE1 OSĈĂꏊc鐔j
+    static constexpr uint32_t SlotCount = 5;
+    /// uꏊƂ\ԍ
+    static constexpr uint32_t None = UINT32_MAX;
+
+    /// XibvVbg
+    struct Snapshot {
+        std::vector<Transform> transforms;  ///< gXtH[
+        double                 time = 0.0;  ///< V~[V̎
+    };
+
+    Snapshot   slots_[SlotCount]{};         /// uꏊ
+    uint32_t   latest_ = None;              /// ŐV
+    uint32_t   previous_ = None;            /// 1 O
+    uint32_t   reading_[2] = { None, None }; /// `悪ǂłuꏊ
+    std::mutex mutex_{};                    /// uꏊ̔ԍ̕ی
+};
+
+/// Q[[v̐ݒ
+struct GameLoopSettings {
+    FixedTimestepSettings timestep{};  ///< Œ̍
+    bool                  threaded{};  ///< V~[Vp̃Xbhŉ񂷂
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Q[[v
+ * @details	V~[VŒ݂̍ŉ񂵁A`ɂ 1 ݒxꂽ`掞Ԃ
+ *			`掞͏ɍŐV 1 ÕV~[V̊Ԃɂ̂ŁATransformSnapshots ŕԂΊ炩ɓ
+ *			threaded Ȃp̃Xbhvč݂ƂɃV~[V񂵁A`iPresent ̐҂܂ށjƏdȂȂ
+ *			łȂ frame ̒ŗ܂񂷁Bǂv͍ւiU̎vŊm߂j
+ */
+class GameLoop final {
+public:
+    /// vibԂj
+    using ClockFunc = std::function<double()>;
+    /// V~[V 1 񕪂̏ func(񂵂̃V~[V̎, )
+    using TickFunc = std::function<void(double, double)>;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    GameLoop() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~GameLoop();
+
+    // Rs[֎~
+    GameLoop(const GameLoop&) = delete;
+    GameLoop& operator=(const GameLoop&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Jn
+     * @param	settings	ݒ
+     * @param	clock		v
+     * @param	tick		V~[V 1 񕪂̏ithreaded Ȃp̃XbhĂ΂j
+     * @return	 true
+     */
+    [[nodiscard]] bool start(const GameLoopSettings& settings, ClockFunc clock, TickFunc tick);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	~߂ithreaded ȂXbh̏I҂j
+     */
+    void stop() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	`̑OɌĂ
+     * @return	`掞iV~[V̎ŁAŐṼV~[V̎ 1 ݈ȓj
+     * @details	threaded łȂΗ܂̃V~[Vŉ
+     */
+    double frame();
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	񂵂񐔂擾
+     * @return	
+     */
+    [[nodiscard]] uint64_t tickCount() const;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	𒴂Ď̂ĂԂ擾
+     * @return	b
+     */
+    [[nodiscard]] double droppedSeconds() const;
+
+private:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	vė܂̃V~[V
+     */
+    void step();
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	V~[ṼXbh̏
+     */
+    void simulationMain();
+
+    ClockFunc               clock_{};             /// v
+    TickFunc                tick_{};              /// V~[V 1 񕪂̏
+    FixedTimestep           timestep_{};          /// Œ̍
+    double                  lastClock_{};         /// OɎv
+    double                  publishedClock_{};    /// 񂵏IV~[V̎̕v̎
+    double                  publishedTime_{};     /// ̎̃V~[V̎
+    double                  publishedTickTime_{}; /// ̎̍Ō̃V~[V̏I̎
+    std::thread             thread_{};            /// V~[ṼXbh
+    mutable std::mutex      mutex_{};             /// Ɖ񐔂̕ی
+    std::condition_variable wakeup_{};            /// ~̒ʒm
+    bool                    quit_{};              /// ~v
+};
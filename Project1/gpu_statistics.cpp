@@ -0,0 +1,107 @@
+// pCvCvNGNX
+
+#include "gpu_statistics.h"
+#include <cassert>
+#include <cstring>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+GpuStatistics::~GpuStatistics() {
+    if (readbackBuffer_) {
+        readbackBuffer_->Release();
+        readbackBuffer_ = nullptr;
+    }
+    if (queryHeap_) {
+        queryHeap_->Release();
+        queryHeap_ = nullptr;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NGq[vƃ[hobNobt@쐬
+ * @param	device		foCXNX̃CX^X
+ * @param	frameCount	 GPU t[
+ * @return	 true
+ */
+[[nodiscard]] bool GpuStatistics::create(const Device& device, uint32_t frameCount) noexcept {
+    assert(frameCount > 0);
+    frameCount_ = frameCount;
+
+    D3D12_QUERY_HEAP_DESC heapDesc{};
+    heapDesc.Type = D3D12_QUERY_HEAP_TYPE_PIPELINE_STATISTICS;
+    heapDesc.Count = frameCount;
+    if (FAILED(device.get()->CreateQueryHeap(&heapDesc, IID_PPV_ARGS(&queryHeap_)))) {
+        assert(false && "NGq[v̍쐬Ɏs");
+        return false;
+    }
+
+    D3D12_HEAP_PROPERTIES heapProps{};
+    heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+
+    D3D12_RESOURCE_DESC resDesc{};
+    resDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    resDesc.Width = UINT64(sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS)) * frameCount;
+    resDesc.Height = 1;
+    resDesc.DepthOrArraySize = 1;
+    resDesc.MipLevels = 1;
+    resDesc.SampleDesc.Count = 1;
+    resDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    const auto res = device.get()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resDesc, D3D12_RESOURCE_STATE_COPY_DEST,
+                                                           nullptr, IID_PPV_ARGS(&readbackBuffer_));
+    if (FAILED(res)) {
+        assert(false && "ṽ[hobNobt@̍쐬Ɏs");
+        return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	vn߂
+ * @param	commandList	R}hXg
+ * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+ */
+void GpuStatistics::begin(ID3D12GraphicsCommandList* commandList, uint32_t frameIndex) const noexcept {
+    assert(queryHeap_ && frameIndex < frameCount_);
+    commandList->BeginQuery(queryHeap_, D3D12_QUERY_TYPE_PIPELINE_STATISTICS, frameIndex);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	vIČʂ[hobNobt@ɉ
+ * @param	commandList	R}hXg
+ * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+ */
+void GpuStatistics::end(ID3D12GraphicsCommandList* commandList, uint32_t frameIndex) const noexcept {
+    assert(queryHeap_ && frameIndex < frameCount_);
+    commandList->EndQuery(queryHeap_, D3D12_QUERY_TYPE_PIPELINE_STATISTICS, frameIndex);
+    commandList->ResolveQueryData(queryHeap_, D3D12_QUERY_TYPE_PIPELINE_STATISTICS, frameIndex, 1, readbackBuffer_,
+                                  UINT64(sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS)) * frameIndex);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ʂǂށĩt[ GPU IĂĂԁj
+ * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+ * @param	statistics	
+ * @return	ǂ߂ true
+ */
+[[nodiscard]] bool GpuStatistics::read(uint32_t frameIndex, D3D12_QUERY_DATA_PIPELINE_STATISTICS& statistics) const noexcept {
+    assert(readbackBuffer_ && frameIndex < frameCount_);
+
+    // ǂޔ͈͂w肵ACPU ͏܂Ȃ̂ŏݔ͈͂͋ɂ
+    const SIZE_T offset = sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS) * frameIndex;
+    D3D12_RANGE  readRange{offset, offset + sizeof(D3D12_QUERY_DATA_PIPELINE_STATISTICS)};
+    void*        mapped{};
+    if (FAILED(readbackBuffer_->Map(0, &readRange, &mapped))) {
+        return false;
+    }
+    std::memcpy(&statistics, static_cast<const uint8_t*>(mapped) + offset, sizeof(statistics));
+    D3D12_RANGE writeRange{0, 0};
+    readbackBuffer_->Unmap(0, &writeRange);
+    return true;
+}
@@ -0,0 +1,72 @@
+// pCvCvNGNX
+
+#pragma once
+
+#include "device.h"
+#include <cstdint>
+#include <d3d12.h>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvCvNGNX
+ * @details	t[̕` begin / end ŋ݁AsNZVF[_̎s񐔂Ȃǂ GPU ɐ
+ *			ʂ̓[hobNobt@ɉÃt[ GPU IĂ read œǂ
+ *			PSInvocations ʂ̃sNZŊƃI[o[h[i1 sNZhjɂȂ
+ */
+class GpuStatistics final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    GpuStatistics() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~GpuStatistics();
+
+    // Rs[֎~
+    GpuStatistics(const GpuStatistics&) = delete;
+    GpuStatistics& operator=(const GpuStatistics&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	NGq[vƃ[hobNobt@쐬
+     * @param	device		foCXNX̃CX^X
+     * @param	frameCount	 GPU t[
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, uint32_t frameCount) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	vn߂
+     * @param	commandList	R}hXg
+     * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+     */
+    void begin(ID3D12GraphicsCommandList* commandList, uint32_t frameIndex) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	vIČʂ[hobNobt@ɉ
+     * @param	commandList	R}hXg
+     * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+     */
+    void end(ID3D12GraphicsCommandList* commandList, uint32_t frameIndex) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ʂǂށĩt[ GPU IĂĂԁj
+     * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+     * @param	statistics	
+     * @return	ǂ߂ true
+     */
+    [[nodiscard]] bool read(uint32_t frameIndex, D3D12_QUERY_DATA_PIPELINE_STATISTICS& statistics) const noexcept;
+
+private:
+    ID3D12QueryHeap* queryHeap_{};       /// NGq[vit[j
+    ID3D12Resource*  readbackBuffer_{};  /// i[hobNq[vj
+    uint32_t         frameCount_{};      /// t[
+};
@@ -0,0 +1,116 @@
+// GPU ԌvNX
+
+#include "gpu_timer.h"
+#include <cassert>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+GpuTimer::~GpuTimer() {
+    if (readbackBuffer_) {
+        readbackBuffer_->Release();
+        readbackBuffer_ = nullptr;
+    }
+    if (queryHeap_) {
+        queryHeap_->Release();
+        queryHeap_ = nullptr;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NGq[vƃ[hobNobt@쐬
+ * @param	device			foCXNX̃CX^X
+ * @param	commandQueue	vR}hsL[i^CX^v̎gj
+ * @param	frameCount		 GPU t[
+ * @return	 true
+ */
+[[nodiscard]] bool GpuTimer::create(const Device& device, const CommandQueue& commandQueue, uint32_t frameCount) noexcept {
+    assert(frameCount > 0);
+    frameCount_ = frameCount;
+
+    if (FAILED(commandQueue.get()->GetTimestampFrequency(&frequency_)) || frequency_ == 0) {
+        assert(false && "^CX^v̎g̎擾Ɏs");
+        return false;
+    }
+
+    D3D12_QUERY_HEAP_DESC heapDesc{};
+    heapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+    heapDesc.Count = frameCount * 2;
+    if (FAILED(device.get()->CreateQueryHeap(&heapDesc, IID_PPV_ARGS(&queryHeap_)))) {
+        assert(false && "NGq[v̍쐬Ɏs");
+        return false;
+    }
+
+    D3D12_HEAP_PROPERTIES heapProps{};
+    heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+
+    D3D12_RESOURCE_DESC resDesc{};
+    resDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    resDesc.Width = UINT64(sizeof(uint64_t)) * 2 * frameCount;
+    resDesc.Height = 1;
+    resDesc.DepthOrArraySize = 1;
+    resDesc.MipLevels = 1;
+    resDesc.SampleDesc.Count = 1;
+    resDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    const auto res = device.get()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resDesc, D3D12_RESOURCE_STATE_COPY_DEST,
+                                                           nullptr, IID_PPV_ARGS(&readbackBuffer_));
+    if (FAILED(res)) {
+        assert(false && "^CX^ṽ[hobNobt@̍쐬Ɏs");
+        return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	vn߂
+ * @param	commandList	R}hXg
+ * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+ */
+void GpuTimer::begin(ID3D12GraphicsCommandList* commandList, uint32_t frameIndex) const noexcept {
+    assert(queryHeap_ && frameIndex < frameCount_);
+    commandList->EndQuery(queryHeap_, D3D12_QUERY_TYPE_TIMESTAMP, frameIndex * 2);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	vIČʂ[hobNobt@ɉ
+ * @param	commandList	R}hXg
+ * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+ */
+void GpuTimer::end(ID3D12GraphicsCommandList* commandList, uint32_t frameIndex) const noexcept {
+    assert(queryHeap_ && frameIndex < frameCount_);
+    commandList->EndQuery(queryHeap_, D3D12_QUERY_TYPE_TIMESTAMP, frameIndex * 2 + 1);
+    commandList->ResolveQueryData(queryHeap_, D3D12_QUERY_TYPE_TIMESTAMP, frameIndex * 2, 2, readbackBuffer_,
+                                  UINT64(sizeof(uint64_t)) * 2 * frameIndex);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ʂǂށĩt[ GPU IĂĂԁj
+ * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+ * @return	GPU ԁi~bjBǂ߂Ȃ 0
+ */
+[[nodiscard]] float GpuTimer::read(uint32_t frameIndex) const noexcept {
+    assert(readbackBuffer_ && frameIndex < frameCount_);
+
+    const SIZE_T offset = sizeof(uint64_t) * 2 * frameIndex;
+    D3D12_RANGE  readRange{offset, offset + sizeof(uint64_t) * 2};
+    void*        mapped{};
+    if (FAILED(readbackBuffer_->Map(0, &readRange, &mapped))) {
+        return 0.0f;
+    }
+    const auto* timestamps = reinterpret_cast<const uint64_t*>(static_cast<const uint8_t*>(mapped) + offset);
+    const uint64_t begin = timestamps[0];
+    const uint64_t end = timestamps[1];
+    D3D12_RANGE writeRange{0, 0};
+    readbackBuffer_->Unmap(0, &writeRange);
+
+    if (end <= begin) {
+        return 0.0f;
+    }
+    return static_cast<float>(double(end - begin) * 1000.0 / double(frequency_));
+}
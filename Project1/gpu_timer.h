@@ -0,0 +1,73 @@
+// GPU ԌvNX
+
+#pragma once
+
+#include "command_queue.h"
+#include "device.h"
+#include <cstdint>
+#include <d3d12.h>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GPU ԌvNX
+ * @details	t[̃R}h begin / end ̃^CX^vŋ݁A GPU ԂƂ
+ *			ʂ̓[hobNobt@ɉÃt[ GPU IĂ read œǂ
+ */
+class GpuTimer final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    GpuTimer() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~GpuTimer();
+
+    // Rs[֎~
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	NGq[vƃ[hobNobt@쐬
+     * @param	device			foCXNX̃CX^X
+     * @param	commandQueue	vR}hsL[i^CX^v̎gj
+     * @param	frameCount		 GPU t[
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, const CommandQueue& commandQueue, uint32_t frameCount) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	vn߂
+     * @param	commandList	R}hXg
+     * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+     */
+    void begin(ID3D12GraphicsCommandList* commandList, uint32_t frameIndex) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	vIČʂ[hobNobt@ɉ
+     * @param	commandList	R}hXg
+     * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+     */
+    void end(ID3D12GraphicsCommandList* commandList, uint32_t frameIndex) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ʂǂށĩt[ GPU IĂĂԁj
+     * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+     * @return	GPU ԁi~bjBǂ߂Ȃ 0
+     */
+    [[nodiscard]] float read(uint32_t frameIndex) const noexcept;
+
+private:
+    ID3D12QueryHeap* queryHeap_{};       /// ^CX^ṽNGq[vit[Ƃ 2 j
+    ID3D12Resource*  readbackBuffer_{};  /// i[hobNq[vj
+    uint64_t         frequency_{};       /// ^CX^v 1 b̍ݐ
+    uint32_t         frameCount_{};      /// t[
+};
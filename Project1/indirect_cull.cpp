@@ -0,0 +1,127 @@
+// Ԑڕ`̃JO
+
+#include "indirect_cull.h"
+#include "job_system.h"
+#include <cmath>
+#include <vector>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	r[ˉes񂩂王
+ * @param	viewProjection	sD 4x4 ̃r[ˉes
+ * @return	K
+ */
+[[nodiscard]] CullFrustum makeCullFrustum(const float viewProjection[4][4]) noexcept {
+    const auto* m = viewProjection;
+    CullFrustum frustum{};
+    for (int i = 0; i < 4; ++i) {
+        frustum.planes[0][i] = m[3][i] + m[0][i];  // 
+        frustum.planes[1][i] = m[3][i] - m[0][i];  // E
+        frustum.planes[2][i] = m[3][i] + m[1][i];  // 
+        frustum.planes[3][i] = m[3][i] - m[1][i];  // 
+        frustum.planes[4][i] = m[2][i];            // O (z >= 0)
+        frustum.planes[5][i] = m[3][i] - m[2][i];  // 
+    }
+
+    // aƔׂ̂Ŗ@̒ 1 ɂ
+    for (auto& plane : frustum.planes) {
+        const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (length > 0.0f) {
+            for (auto& value : plane) {
+                value /= length;
+            }
+        }
+    }
+    return frustum;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	E̓ɂ邩肷
+ * @param	frustum	
+ * @param	bounds	EiS XYZ, aj
+ * @return	ꕔłȂ true
+ */
+[[nodiscard]] bool isSphereInFrustum(const CullFrustum& frustum, const float bounds[4]) noexcept {
+    for (const auto& plane : frustum.planes) {
+        // ] HLSL Ɠ ((x + y) + z) + wBꍇ𑵂͗邱
+        float distance = plane[0] * bounds[0];
+        distance = distance + plane[1] * bounds[1];
+        distance = distance + plane[2] * bounds[2];
+        distance = distance + plane[3];
+        if (distance < -bounds[3]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	JOČIuWFNg̕`R}hl߂iGPU ł CPU j
+ * @param	objects		IuWFNg
+ * @param	count		IuWFNg
+ * @param	frustum		
+ * @param	commands	R}h̏ݐicount j
+ * @param	jobSystem	ɏꍇ̃WuVXe
+ * @return	񂾃R}h
+ */
+uint32_t cullAndCompact(const DrawObject* objects, uint32_t count, const CullFrustum& frustum, IndirectDrawCommand* commands, JobSystem* jobSystem) {
+    const uint32_t groupCount = (count + IndirectCullGroupSize - 1) / IndirectCullGroupSize;
+
+    // ĂяoXbhƂ̍Ɨ̈BIuWFNg肷Ίmۂ͋NȂ
+    static thread_local std::vector<uint8_t> visibility;
+    static thread_local std::vector<uint32_t> groupOffsets;
+    visibility.resize(count);
+    groupOffsets.resize(groupCount);
+    uint8_t* visible = visibility.data();
+    uint32_t* offsets = groupOffsets.data();
+
+    const auto forEachGroup = [jobSystem, groupCount](const auto& func) {
+        const auto range = [&func](uint32_t begin, uint32_t end) {
+            for (uint32_t group = begin; group < end; ++group) {
+                func(group);
+            }
+        };
+        if (jobSystem) {
+            jobSystem->parallelFor(groupCount, 64, range);
+        }
+        else {
+            range(0, groupCount);
+        }
+    };
+
+    // 1. O[vƂɔ肵ĉ𐔂 (cullCS)
+    forEachGroup([&](uint32_t group) {
+        const uint32_t begin = group * IndirectCullGroupSize;
+        const uint32_t end = begin + IndirectCullGroupSize < count ? begin + IndirectCullGroupSize : count;
+        uint32_t groupVisible = 0;
+        for (uint32_t i = begin; i < end; ++i) {
+            visible[i] = isSphereInFrustum(frustum, objects[i].bounds) ? 1 : 0;
+            groupVisible += visible[i];
+        }
+        offsets[group] = groupVisible;
+    });
+
+    // 2. O[v̊JnʒurIݐϘaŋ߂ (scanCS)
+    uint32_t total = 0;
+    for (uint32_t group = 0; group < groupCount; ++group) {
+        const uint32_t groupVisible = offsets[group];
+        offsets[group] = total;
+        total += groupVisible;
+    }
+
+    // 3. O[v̏Ԃۂċl߂ (compactCS)
+    forEachGroup([&](uint32_t group) {
+        const uint32_t begin = group * IndirectCullGroupSize;
+        const uint32_t end = begin + IndirectCullGroupSize < count ? begin + IndirectCullGroupSize : count;
+        uint32_t write = offsets[group];
+        for (uint32_t i = begin; i < end; ++i) {
+            if (visible[i]) {
+                commands[write++] = { i, objects[i].vertexCount, 1, objects[i].startVertex, 0 };
+            }
+        }
+    });
+
+    return total;
+}
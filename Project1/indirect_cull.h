@@ -0,0 +1,68 @@
+// Ԑڕ`̃JO
+
+#pragma once
+
+#include <cstdint>
+
+class JobSystem;
+
+/// JÕXbhO[v̑傫iasset/indirect_cull.hlsl  numthreads Ɠj
+inline constexpr uint32_t IndirectCullGroupSize = 64;
+
+/// GPU 쓮`̃IuWFNgiasset/indirect_cull.hlsl / indirect_draw.hlsl  DrawObject Ɠсj
+struct DrawObject {
+    float    transform[3][4];  ///< sD 3x4 ̕ϊs
+    float    color[4];         ///< ZJ[
+    float    bounds[4];        ///< [hԂ̋EiS XYZ, aj
+    uint32_t vertexCount;      ///< _
+    uint32_t startVertex;      ///< Jn_
+    uint32_t reserved[2];      ///< 16 oCgEɑ邽߂̗\
+};
+static_assert(sizeof(DrawObject) == 96, "HLSL  DrawObject ƂĂ܂");
+
+/// Ԑڕ` 1 R}hi[g萔 1  + D3D12_DRAW_ARGUMENTSj
+struct IndirectDrawCommand {
+    uint32_t objectIndex;             ///< [g萔œnIuWFNgԍ
+    uint32_t vertexCountPerInstance;  ///< D3D12_DRAW_ARGUMENTS
+    uint32_t instanceCount;
+    uint32_t startVertexLocation;
+    uint32_t startInstanceLocation;
+};
+static_assert(sizeof(IndirectDrawCommand) == 20, "R}hVOl`̃XgChƂĂ܂");
+
+/// JOɎgiax + by + cz + d >= 0 j
+struct CullFrustum {
+    float planes[6][4];  ///< EEEEEOE
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	r[ˉes񂩂王
+ * @param	viewProjection	sD 4x4 ̃r[ˉesiclip = M * pAD3D  z  0`1j
+ * @return	K
+ */
+[[nodiscard]] CullFrustum makeCullFrustum(const float viewProjection[4][4]) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	E̓ɂ邩肷
+ * @param	frustum	
+ * @param	bounds	EiS XYZ, aj
+ * @return	ꕔłȂ true
+ * @details	GPU łƓE]ŌvZiHLSL  precise  FMA ƕבւ֎~Ăj
+ */
+[[nodiscard]] bool isSphereInFrustum(const CullFrustum& frustum, const float bounds[4]) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	JOČIuWFNg̕`R}hl߂iGPU ł CPU j
+ * @param	objects		IuWFNg
+ * @param	count		IuWFNg
+ * @param	frustum		
+ * @param	commands	R}h̏ݐicount j
+ * @param	jobSystem	ɏꍇ̃WuVXeinullptr ȂĂяoXbhŏj
+ * @return	񂾃R}h
+ * @details	GPU łƓO[vPʂ̉O[v̊Jnʒu̗ݐρO[v̋lߍ݂ 3 iKŁA
+ *			IuWFNgۂ܂܋l߂Bʂ͕񐔂ɂ炸 GPU łƃrbgPʂňv
+ */
+uint32_t cullAndCompact(const DrawObject* objects, uint32_t count, const CullFrustum& frustum, IndirectDrawCommand* commands, JobSystem* jobSystem = nullptr);
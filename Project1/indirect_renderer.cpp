@@ -0,0 +1,352 @@
+// GPU 쓮`NX
+
+#include "indirect_renderer.h"
+#include "pipline_state_object.h"
+#include "root_signature_builder.h"
+#include <cassert>
+#include <cstring>
+#include <Windows.h>
+#include <D3Dcompiler.h>
+#pragma comment(lib, "d3dcompiler.lib")
+
+namespace {
+
+/// JOp̃[g萔iasset/indirect_cull.hlsl  CullConstants Ɠсj
+struct CullConstants {
+    float    planes[6][4];
+    uint32_t objectCount;
+    uint32_t groupCount;
+};
+
+// [gp[^̔ԍ
+enum ComputeRootParameter : UINT {
+    ComputeRootConstants,
+    ComputeRootObjects,
+    ComputeRootVisibility,
+    ComputeRootGroupOffsets,
+    ComputeRootCommands,
+    ComputeRootDrawCount,
+};
+enum DrawRootParameter : UINT {
+    DrawRootObjectIndex,
+    DrawRootObjects,
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Rs[gpCvC쐬
+ * @param	device			foCX
+ * @param	rootSignature	[gVOl`
+ * @param	entry			Gg|Cg
+ * @return	pCvCBsꍇ nullptr
+ */
+ID3D12PipelineState* createComputePipeline(ID3D12Device* device, ID3D12RootSignature* rootSignature, const char* entry) noexcept {
+    ID3DBlob* shader = nullptr;
+    ID3DBlob* error = nullptr;
+    const auto res = D3DCompileFromFile(L"asset/indirect_cull.hlsl", nullptr, nullptr, entry, "cs_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &shader, &error);
+    if (error) {
+        OutputDebugStringA(static_cast<const char*>(error->GetBufferPointer()));
+        error->Release();
+    }
+    if (FAILED(res)) {
+        assert(false && "JOpVF[_̃RpCɎs");
+        return nullptr;
+    }
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC desc{};
+    desc.pRootSignature = rootSignature;
+    desc.CS = { shader->GetBufferPointer(), shader->GetBufferSize() };
+
+    ID3D12PipelineState* pipelineState = nullptr;
+    if (FAILED(device->CreateComputePipelineState(&desc, IID_PPV_ARGS(&pipelineState)))) {
+        pipelineState = nullptr;
+    }
+    shader->Release();
+    return pipelineState;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	obt@쐬
+ * @param	device		foCX
+ * @param	size		oCg
+ * @param	heapType	q[v̎
+ * @param	state		
+ * @return	obt@Bsꍇ nullptr
+ */
+ID3D12Resource* createBuffer(ID3D12Device* device, UINT64 size, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES state) noexcept {
+    D3D12_HEAP_PROPERTIES heapProps{};
+    heapProps.Type = heapType;
+
+    D3D12_RESOURCE_DESC resDesc{};
+    resDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    resDesc.Width = size;
+    resDesc.Height = 1;
+    resDesc.DepthOrArraySize = 1;
+    resDesc.MipLevels = 1;
+    resDesc.SampleDesc.Count = 1;
+    resDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    resDesc.Flags = heapType == D3D12_HEAP_TYPE_DEFAULT ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE;
+
+    ID3D12Resource* buffer = nullptr;
+    if (FAILED(device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resDesc, state, nullptr, IID_PPV_ARGS(&buffer)))) {
+        return nullptr;
+    }
+    return buffer;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ԑJڂ̃oA
+ * @param	resource	\[X
+ * @param	before		JڑȌ
+ * @param	after		Jڌ̏
+ * @return	oA
+ */
+D3D12_RESOURCE_BARRIER makeTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after) noexcept {
+    D3D12_RESOURCE_BARRIER barrier{};
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Transition.pResource = resource;
+    barrier.Transition.StateBefore = before;
+    barrier.Transition.StateAfter = after;
+    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    return barrier;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	COM IuWFNg
+ * @param	object	IuWFNginullptr ɂj
+ */
+template <class T>
+void safeRelease(T*& object) noexcept {
+    if (object) {
+        object->Release();
+        object = nullptr;
+    }
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+IndirectRenderer::~IndirectRenderer() {
+    destroy();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	device				foCXNX̃CX^X
+ * @param	rootSignatureCache	[gVOl`LbV
+ * @param	pipelineCache		pCvCXe[gLbV
+ * @param	maxObjects			őIuWFNg
+ * @param	depth				[xobt@̎giprepass Ȃ[x̃pXɕ`j
+ * @return	 true
+ */
+[[nodiscard]] bool IndirectRenderer::create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache, uint32_t maxObjects,
+                                            const DepthSetup& depth) noexcept {
+    assert(maxObjects > 0);
+    maxObjects_ = maxObjects;
+    pipelineCache_ = &pipelineCache;
+    auto* d3dDevice = device.get();
+
+    // JO: 萔 b0, IuWFNg t0, Ɨp u0`u3 ͑Să[gɒڒuifBXNv^q[vsvj
+    RootSignatureBuilder computeBuilder;
+    computeBuilder.addConstants(sizeof(CullConstants) / 4, 0)
+        .addSRV(0)
+        .addUAV(0)
+        .addUAV(1)
+        .addUAV(2)
+        .addUAV(3)
+        .setFlags(D3D12_ROOT_SIGNATURE_FLAG_NONE);
+    computeRootSignature_ = rootSignatureCache.getOrCreate(device, computeBuilder);
+
+    // `: IuWFNgԍ b0iR}hݒj, IuWFNg t0
+    RootSignatureBuilder drawBuilder;
+    drawBuilder.addConstants(1, 0, 0, D3D12_SHADER_VISIBILITY_VERTEX)
+        .addSRV(0, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+    drawRootSignature_ = rootSignatureCache.getOrCreate(device, drawBuilder);
+    if (!computeRootSignature_ || !drawRootSignature_) {
+        return false;
+    }
+
+    cullPipeline_ = createComputePipeline(d3dDevice, computeRootSignature_->get(), "cullCS");
+    scanPipeline_ = createComputePipeline(d3dDevice, computeRootSignature_->get(), "scanCS");
+    compactPipeline_ = createComputePipeline(d3dDevice, computeRootSignature_->get(), "compactCS");
+    if (!cullPipeline_ || !scanPipeline_ || !compactPipeline_) {
+        return false;
+    }
+
+    if (!drawShader_.create(device, L"asset/indirect_draw.hlsl", {})) {
+        return false;
+    }
+    const auto drawDesc = PiplineStateObject::defaultDesc();
+    drawPipeline_ = pipelineCache.request(makeDepthPipelineDesc(drawDesc, depth, DepthPass::Color), drawShader_, *drawRootSignature_);
+    prepass_ = depth.format != 0 && depth.prepass;
+    if (prepass_) {
+        prepassPipeline_ = pipelineCache.request(makeDepthPipelineDesc(drawDesc, depth, DepthPass::Prepass), drawShader_, *drawRootSignature_);
+    }
+
+    // R}h 1  = [g萔 1  + DrawInstanced ̈
+    D3D12_INDIRECT_ARGUMENT_DESC arguments[2]{};
+    arguments[0].Type = D3D12_INDIRECT_ARGUMENT_TYPE_CONSTANT;
+    arguments[0].Constant.RootParameterIndex = DrawRootObjectIndex;
+    arguments[0].Constant.DestOffsetIn32BitValues = 0;
+    arguments[0].Constant.Num32BitValuesToSet = 1;
+    arguments[1].Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
+
+    D3D12_COMMAND_SIGNATURE_DESC signatureDesc{};
+    signatureDesc.ByteStride = sizeof(IndirectDrawCommand);
+    signatureDesc.NumArgumentDescs = 2;
+    signatureDesc.pArgumentDescs = arguments;
+    if (FAILED(d3dDevice->CreateCommandSignature(&signatureDesc, drawRootSignature_->get(), IID_PPV_ARGS(&commandSignature_)))) {
+        assert(false && "R}hVOl`̍쐬Ɏs");
+        return false;
+    }
+
+    const UINT64 groupCount = (maxObjects + IndirectCullGroupSize - 1) / IndirectCullGroupSize;
+    objectBuffer_ = createBuffer(d3dDevice, UINT64(sizeof(DrawObject)) * maxObjects, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+    visibilityBuffer_ = createBuffer(d3dDevice, UINT64(sizeof(uint32_t)) * maxObjects, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    groupOffsetBuffer_ = createBuffer(d3dDevice, sizeof(uint32_t) * groupCount, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    commandBuffer_ = createBuffer(d3dDevice, UINT64(sizeof(IndirectDrawCommand)) * maxObjects, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    countBuffer_ = createBuffer(d3dDevice, sizeof(uint32_t), D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    if (!objectBuffer_ || !visibilityBuffer_ || !groupOffsetBuffer_ || !commandBuffer_ || !countBuffer_) {
+        assert(false && "GPU 쓮`̃obt@쐬Ɏs");
+        return false;
+    }
+
+    D3D12_RANGE readRange{ 0, 0 };
+    if (FAILED(objectBuffer_->Map(0, &readRange, reinterpret_cast<void**>(&mappedObjects_)))) {
+        return false;
+    }
+    argumentsReadable_ = false;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Sĉ
+ */
+void IndirectRenderer::destroy() noexcept {
+    if (objectBuffer_ && mappedObjects_) {
+        objectBuffer_->Unmap(0, nullptr);
+        mappedObjects_ = nullptr;
+    }
+    safeRelease(countBuffer_);
+    safeRelease(commandBuffer_);
+    safeRelease(groupOffsetBuffer_);
+    safeRelease(visibilityBuffer_);
+    safeRelease(objectBuffer_);
+    safeRelease(commandSignature_);
+    safeRelease(compactPipeline_);
+    safeRelease(scanPipeline_);
+    safeRelease(cullPipeline_);
+    objectCount_ = 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	IuWFNg
+ * @param	objects	IuWFNg
+ * @param	count	IuWFNg
+ */
+void IndirectRenderer::update(const DrawObject* objects, uint32_t count) noexcept {
+    assert(mappedObjects_ && "GPU 쓮`悪쐬ł");
+    assert(count <= maxObjects_ && "IuWFNg܂");
+    std::memcpy(mappedObjects_, objects, sizeof(DrawObject) * count);
+    objectCount_ = count;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	JOƋlߍ݂̃Rs[gpXς
+ * @param	commandList	R}hXg
+ * @param	frustum		
+ */
+void IndirectRenderer::cull(ID3D12GraphicsCommandList* commandList, const CullFrustum& frustum) noexcept {
+    const uint32_t groupCount = (objectCount_ + IndirectCullGroupSize - 1) / IndirectCullGroupSize;
+
+    // Õt[ŊԐڈƂēǂ񂾃obt@݉\ɖ߂
+    if (argumentsReadable_) {
+        const D3D12_RESOURCE_BARRIER toUav[] = {
+            makeTransition(commandBuffer_, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+            makeTransition(countBuffer_, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+        };
+        commandList->ResourceBarrier(2, toUav);
+    }
+
+    CullConstants constants{};
+    std::memcpy(constants.planes, frustum.planes, sizeof(constants.planes));
+    constants.objectCount = objectCount_;
+    constants.groupCount = groupCount;
+
+    commandList->SetComputeRootSignature(computeRootSignature_->get());
+    commandList->SetComputeRoot32BitConstants(ComputeRootConstants, sizeof(CullConstants) / 4, &constants, 0);
+    commandList->SetComputeRootShaderResourceView(ComputeRootObjects, objectBuffer_->GetGPUVirtualAddress());
+    commandList->SetComputeRootUnorderedAccessView(ComputeRootVisibility, visibilityBuffer_->GetGPUVirtualAddress());
+    commandList->SetComputeRootUnorderedAccessView(ComputeRootGroupOffsets, groupOffsetBuffer_->GetGPUVirtualAddress());
+    commandList->SetComputeRootUnorderedAccessView(ComputeRootCommands, commandBuffer_->GetGPUVirtualAddress());
+    commandList->SetComputeRootUnorderedAccessView(ComputeRootDrawCount, countBuffer_->GetGPUVirtualAddress());
+
+    // 3 iK̊Ԃ͑O̒iK݂̏悤 UAV oA
+    D3D12_RESOURCE_BARRIER uavBarrier{};
+    uavBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+
+    commandList->SetPipelineState(cullPipeline_);
+    if (groupCount) {
+        commandList->Dispatch(groupCount, 1, 1);
+    }
+    commandList->ResourceBarrier(1, &uavBarrier);
+
+    // IuWFNg 0 ł`搔 0 ߕKs
+    commandList->SetPipelineState(scanPipeline_);
+    commandList->Dispatch(1, 1, 1);
+    commandList->ResourceBarrier(1, &uavBarrier);
+
+    commandList->SetPipelineState(compactPipeline_);
+    if (groupCount) {
+        commandList->Dispatch(groupCount, 1, 1);
+    }
+
+    // ԐڈƂēǂ߂Ԃɂ
+    const D3D12_RESOURCE_BARRIER toArgument[] = {
+        makeTransition(commandBuffer_, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT),
+        makeTransition(countBuffer_, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT),
+    };
+    commandList->ResourceBarrier(2, toArgument);
+    argumentsReadable_ = true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	IuWFNg ExecuteIndirect ŕ`
+ * @param	commandList		R}hXg
+ * @param	vertexBuffer	SIuWFNgŋL钸_obt@
+ */
+void IndirectRenderer::draw(ID3D12GraphicsCommandList* commandList, const D3D12_VERTEX_BUFFER_VIEW& vertexBuffer) noexcept {
+    assert(argumentsReadable_ && "cull ̌ɌĂł");
+
+    // pCvC쐬͕̂`Ȃ
+    ID3D12PipelineState* drawPipeline = pipelineCache_->get(drawPipeline_);
+    if (!drawPipeline) {
+        return;
+    }
+
+    commandList->SetGraphicsRootSignature(drawRootSignature_->get());
+    commandList->SetGraphicsRootShaderResourceView(DrawRootObjects, objectBuffer_->GetGPUVirtualAddress());
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    commandList->IASetVertexBuffers(0, 1, &vertexBuffer);
+
+    // `搔 GPU lgAő吔͑SIuWFNgŗ}
+    // vpXňԎO̐[x܂̂ŁAF̃pXŉBꂽsNZ̃VF[_͑Ȃ
+    // vpX̃pCvCoオ܂ł͐F̃pXŕ`i[x͏ȂAeXg͒ʂj
+    if (ID3D12PipelineState* prepassPipeline = prepass_ ? pipelineCache_->get(prepassPipeline_) : nullptr) {
+        commandList->SetPipelineState(prepassPipeline);
+        commandList->ExecuteIndirect(commandSignature_, objectCount_, commandBuffer_, 0, countBuffer_, 0);
+    }
+    commandList->SetPipelineState(drawPipeline);
+    commandList->ExecuteIndirect(commandSignature_, objectCount_, commandBuffer_, 0, countBuffer_, 0);
+}
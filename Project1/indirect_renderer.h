@@ -0,0 +1,106 @@
+// GPU 쓮`NX
+
+#pragma once
+
+#include "device.h"
+#include "indirect_cull.h"
+#include "pipeline_state_cache.h"
+#include "root_signature_cache.h"
+#include "shader.h"
+#include <cstdint>
+#include <d3d12.h>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GPU 쓮`NX
+ * @details	IuWFNg\obt@ɒuARs[gVF[_ŎJOƋlߍ݂s
+ *			Ԑڈobt@ƕ`搔A1  ExecuteIndirect ŕ`
+ *			JO̎菇 indirect_cull.cpp  cullAndCompact ƓŁAʂ̓rbgPʂňv
+ */
+class IndirectRenderer final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    IndirectRenderer() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~IndirectRenderer();
+
+    // Rs[֎~
+    IndirectRenderer(const IndirectRenderer&) = delete;
+    IndirectRenderer& operator=(const IndirectRenderer&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	device				foCXNX̃CX^X
+     * @param	rootSignatureCache	[gVOl`LbV
+     * @param	pipelineCache		pCvCXe[gLbV
+     * @param	maxObjects			őIuWFNg
+     * @param	depth				[xobt@̎giprepass Ȃ[x̃pXɕ`j
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache, uint32_t maxObjects,
+                              const DepthSetup& depth = {}) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Sĉ
+     */
+    void destroy() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	IuWFNgށiÕt[ GPU IĂĂԁj
+     * @param	objects	IuWFNg
+     * @param	count	IuWFNg
+     */
+    void update(const DrawObject* objects, uint32_t count) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	JOƋlߍ݂̃Rs[gpXς
+     * @param	commandList	R}hXg
+     * @param	frustum		
+     */
+    void cull(ID3D12GraphicsCommandList* commandList, const CullFrustum& frustum) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	IuWFNg ExecuteIndirect ŕ`
+     * @details	[xvpX΁AԐڈŐ[x`ĂFh
+     *			pCvC쐬͉̂`Ȃ
+     * @param	commandList		R}hXgi_[^[QbgE[xobt@Er[|[g͐ݒς݂̂Ɓj
+     * @param	vertexBuffer	SIuWFNgŋL钸_obt@
+     */
+    void draw(ID3D12GraphicsCommandList* commandList, const D3D12_VERTEX_BUFFER_VIEW& vertexBuffer) noexcept;
+
+private:
+    Shader                     drawShader_{};             /// `pVF[_
+    const RootSignature*       drawRootSignature_{};      /// `p[gVOl`iLbVLj
+    const RootSignature*       computeRootSignature_{};   /// JOp[gVOl`iLbVLj
+    PipelineStateCache*        pipelineCache_{};          /// pCvCXe[gLbV
+    PipelineStateCache::Handle drawPipeline_{};           /// `ppCvC
+    PipelineStateCache::Handle prepassPipeline_{};        /// [xvpXppCvC
+    bool                       prepass_{};                /// [xvpX`Ȃ true
+    ID3D12PipelineState*       cullPipeline_{};           /// cullCS
+    ID3D12PipelineState*       scanPipeline_{};           /// scanCS
+    ID3D12PipelineState*       compactPipeline_{};        /// compactCS
+    ID3D12CommandSignature*    commandSignature_{};       /// [g萔 + `̃R}hVOl`
+
+    ID3D12Resource*            objectBuffer_{};           /// IuWFNgiAbv[hq[vj
+    DrawObject*                mappedObjects_{};          /// objectBuffer_  Map 
+    ID3D12Resource*            visibilityBuffer_{};       /// IuWFNgƂ̉tO
+    ID3D12Resource*            groupOffsetBuffer_{};      /// O[vƂ̉Jnʒu
+    ID3D12Resource*            commandBuffer_{};          /// Ԑڈ
+    ID3D12Resource*            countBuffer_{};            /// `搔
+
+    uint32_t                   maxObjects_{};             /// őIuWFNg
+    uint32_t                   objectCount_{};            /// ݂̃IuWFNg
+    bool                       argumentsReadable_{};      /// Ԑڈ INDIRECT_ARGUMENT ԂȂ true
+};
@@ -0,0 +1,130 @@
+// CX^Xob`[NX
+
+#include "instance_batcher.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t[̕`vSĎ̂Ăimۍς݂̗eʂ͎cj
+ */
+void InstanceBatcher::clear() noexcept {
+    instances_.clear();
+    batchIndices_.clear();
+    localIndices_.clear();
+    sorted_.clear();
+
+    // ob`̓o^͎̃t[łg񂷁iL[̑gݍ킹̓t[ԂłقڕςȂj
+    for (auto& batch : batches_) {
+        batch.instanceCount = 0;
+    }
+    lastBatch_ = UINT32_MAX;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`vǉ
+ * @param	pipeline	pCvC̃nh
+ * @param	mesh		bV̔ԍ
+ * @param	data		CX^XPʂ̃f[^
+ */
+void InstanceBatcher::add(uint64_t pipeline, uint32_t mesh, const InstanceData& data) {
+    const Key key{ pipeline, mesh };
+
+    // gݍ킹Ƃ̂ŁAOƓȂnbVȂ
+    if (lastBatch_ == UINT32_MAX || !(key == lastKey_)) {
+        const auto [it, inserted] = lookup_.try_emplace(key, static_cast<uint32_t>(batches_.size()));
+        if (inserted) {
+            batches_.push_back({ pipeline, mesh, 0, 0 });
+        }
+        lastKey_   = key;
+        lastBatch_ = it->second;
+    }
+
+    instances_.push_back(data);
+    batchIndices_.push_back(lastBatch_);
+    localIndices_.push_back(batches_[lastBatch_].instanceCount++);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ob`̕тƊJnʒu߂
+ * @return	pCvCEbVɕׂob`
+ */
+const std::vector<InstanceBatcher::Batch>& InstanceBatcher::build() {
+    // pCvC̐؂ւŏɂȂ悤ApCvCbV̏ɕׂ
+    sorted_.clear();
+    for (const auto& batch : batches_) {
+        if (batch.instanceCount != 0) {
+            sorted_.push_back(batch);
+        }
+    }
+    std::sort(sorted_.begin(), sorted_.end(), [](const Batch& a, const Batch& b) {
+        return a.pipeline != b.pipeline ? a.pipeline < b.pipeline : a.mesh < b.mesh;
+    });
+
+    uint32_t first = 0;
+    for (auto& batch : sorted_) {
+        batch.firstInstance = first;
+        first += batch.instanceCount;
+
+        // pack ͓o^̃ob`ԍň̂ŁAJnʒu߂Ă
+        batches_[lookup_.find({ batch.pipeline, batch.mesh })->second].firstInstance = batch.firstInstance;
+    }
+    return sorted_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CX^Xf[^ob`ɋl߂ibuild ̌ɌĂԁj
+ * @param	destination	ݐiinstanceCount BAbv[hq[v Map ł悢j
+ * @param	jobSystem	ɋl߂ꍇ̃WuVXeinullptr ȂĂяoXbhŋl߂j
+ */
+void InstanceBatcher::pack(InstanceData* destination, JobSystem* jobSystem) const noexcept {
+    assert(destination);
+
+    const auto packRange = [this, destination](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const auto& batch = batches_[batchIndices_[i]];
+            std::memcpy(&destination[batch.firstInstance + localIndices_[i]], &instances_[i], sizeof(InstanceData));
+        }
+    };
+
+    const auto count = instanceCount();
+    if (jobSystem) {
+        // ݐ͊eCX^XŌ܂Ă̂ŁAbNŕł
+        jobSystem->parallelFor(count, 4096, packRange);
+    }
+    else {
+        packRange(0, count);
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ǉꂽCX^X擾
+ * @return	CX^X
+ */
+[[nodiscard]] uint32_t InstanceBatcher::instanceCount() const noexcept {
+    return static_cast<uint32_t>(instances_.size());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	INSTANCE_DATA ̒_CAEg擾
+ * @param	slot	̓Xbg
+ * @return	_CAEg
+ */
+[[nodiscard]] std::vector<PipelineInputElement> InstanceBatcher::inputLayout(uint32_t slot) {
+    // DXGI_FORMAT_R32G32B32A32_FLOAT / DXGI_FORMAT_R32_UINT
+    constexpr uint32_t Float4 = 2;
+    constexpr uint32_t UInt = 42;
+
+    std::vector<PipelineInputElement> layout;
+    for (uint32_t i = 0; i < 5; ++i) {
+        layout.push_back({ "INSTANCE_DATA", i, i < 4 ? Float4 : UInt, slot, PipelineStateDesc::AppendAligned, true, 1 });
+    }
+    return layout;
+}
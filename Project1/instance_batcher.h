@@ -0,0 +1,122 @@
+// CX^Xob`[NX
+
+#pragma once
+
+#include "pipeline_state_desc.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class JobSystem;
+
+/// CX^XPʂ̃f[^i_Xbg 1  INSTANCE_DATA0`4 ɑΉj
+struct InstanceData {
+    float    transform[3][4];  ///< sD 3x4 ̕ϊsiINSTANCE_DATA0`2j
+    float    color[4];         ///< ZJ[iINSTANCE_DATA3j
+    uint32_t materialIndex;    ///< }eAԍiINSTANCE_DATA4j
+};
+static_assert(sizeof(InstanceData) == 68, "INSTANCE_DATA ̃CAEgƂĂ܂");
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CX^Xob`[NX
+ * @details	bVƃpCvCIuWFNg 1  DrawInstanced ɂ܂Ƃ߂
+ *			add Ńt[̕`vW߁Abuild Ńob`̕тƊJnʒu߁A
+ *			pack ŃCX^Xobt@֋l߂BeCX^X̃ob`̈ʒu add 
+ *			m肵Ă̂ŁApack ̓CX^XƂɓƗĕɏ߂
+ *			clear ͗eʂĉŁA肷Ζt[̃mۂ͋NȂ
+ */
+class InstanceBatcher final {
+public:
+    /// 1 ̕`ɂ܂Ƃ߂CX^X
+    struct Batch {
+        uint64_t pipeline;       ///< pCvC̃nh
+        uint32_t mesh;           ///< bV̔ԍ
+        uint32_t firstInstance;  ///< CX^Xobt@̊JnʒuiStartInstanceLocation ɓnj
+        uint32_t instanceCount;  ///< CX^X
+    };
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    InstanceBatcher() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~InstanceBatcher() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	t[̕`vSĎ̂Ăimۍς݂̗eʂ͎cj
+     */
+    void clear() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	`vǉ
+     * @param	pipeline	pCvC̃nh
+     * @param	mesh		bV̔ԍ
+     * @param	data		CX^XPʂ̃f[^
+     */
+    void add(uint64_t pipeline, uint32_t mesh, const InstanceData& data);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ob`̕тƊJnʒu߂
+     * @return	pCvCEbVɕׂob`
+     */
+    const std::vector<Batch>& build();
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	CX^Xf[^ob`ɋl߂ibuild ̌ɌĂԁj
+     * @param	destination	ݐiinstanceCount BAbv[hq[v Map ł悢j
+     * @param	jobSystem	ɋl߂ꍇ̃WuVXeinullptr ȂĂяoXbhŋl߂j
+     */
+    void pack(InstanceData* destination, JobSystem* jobSystem = nullptr) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ǉꂽCX^X擾
+     * @return	CX^X
+     */
+    [[nodiscard]] uint32_t instanceCount() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	INSTANCE_DATA ̒_CAEg擾
+     * @param	slot	̓Xbg
+     * @return	_CAEgitNVgȂꍇɒ_̃CAEg֒ǉj
+     */
+    [[nodiscard]] static std::vector<PipelineInputElement> inputLayout(uint32_t slot = 1);
+
+private:
+    /// ob`ʂL[
+    struct Key {
+        uint64_t pipeline;
+        uint32_t mesh;
+
+        bool operator==(const Key& other) const noexcept {
+            return pipeline == other.pipeline && mesh == other.mesh;
+        }
+    };
+
+    /// L[̃nbV
+    struct KeyHash {
+        size_t operator()(const Key& key) const noexcept {
+            return static_cast<size_t>(key.pipeline ^ (static_cast<uint64_t>(key.mesh) * 0x9e3779b97f4a7c15ull));
+        }
+    };
+
+    std::vector<InstanceData>                   instances_{};     /// ǉ̃CX^Xf[^
+    std::vector<uint32_t>                       batchIndices_{};  /// CX^XƂ̃ob`ԍ
+    std::vector<uint32_t>                       localIndices_{};  /// CX^XƂ̃ob`̈ʒu
+    std::vector<Batch>                          batches_{};       /// o^̃ob`
+    std::vector<Batch>                          sorted_{};        /// build ŕבւob`
+    std::unordered_map<Key, uint32_t, KeyHash>  lookup_{};        /// L[ob`ԍ
+    Key                                         lastKey_{};       /// OɒǉL[
+    uint32_t                                    lastBatch_ = UINT32_MAX;  /// Oɒǉob`ԍ
+};
@@ -0,0 +1,99 @@
+// CX^Xobt@NX
+
+#include "instance_buffer.h"
+#include <cassert>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+InstanceBuffer::~InstanceBuffer() {
+    if (buffer_) {
+        buffer_->Unmap(0, nullptr);
+        buffer_->Release();
+        buffer_ = nullptr;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	obt@쐬
+ * @param	device		foCXNX̃CX^X
+ * @param	strideBytes	1 CX^X̃oCg
+ * @param	capacity	1 t[ɏ߂őCX^X
+ * @param	frameCount	 GPU QƂt[
+ * @return	 true
+ */
+[[nodiscard]] bool InstanceBuffer::create(const Device& device, uint32_t strideBytes, uint32_t capacity, uint32_t frameCount) noexcept {
+    assert(strideBytes > 0 && capacity > 0 && frameCount > 0);
+
+    strideBytes_ = strideBytes;
+    capacity_ = capacity;
+    frameCount_ = frameCount;
+
+    D3D12_HEAP_PROPERTIES heapProps{};
+    heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+    D3D12_RESOURCE_DESC resDesc{};
+    resDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    resDesc.Width = UINT64(strideBytes) * capacity * frameCount;
+    resDesc.Height = 1;
+    resDesc.DepthOrArraySize = 1;
+    resDesc.MipLevels = 1;
+    resDesc.SampleDesc.Count = 1;
+    resDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    const auto res = device.get()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resDesc,
+                                                           D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&buffer_));
+    if (FAILED(res)) {
+        assert(false && "CX^Xobt@̍쐬Ɏs");
+        return false;
+    }
+
+    // Abv[hq[v Map ܂܂ł悢BCPU ǂ܂Ȃ̂œǂݎ͈͂͋ɂ
+    D3D12_RANGE readRange{ 0, 0 };
+    if (FAILED(buffer_->Map(0, &readRange, reinterpret_cast<void**>(&mapped_)))) {
+        assert(false && "CX^Xobt@ Map Ɏs");
+        return false;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t[̏ݐ擾
+ * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+ * @return	ݐicapacity j
+ */
+[[nodiscard]] void* InstanceBuffer::data(uint32_t frameIndex) const noexcept {
+    assert(mapped_ && frameIndex < frameCount_);
+    return mapped_ + size_t(strideBytes_) * capacity_ * frameIndex;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t[̒_obt@r[擾
+ * @param	frameIndex		t[ԍ
+ * @param	instanceCount	񂾃CX^X
+ * @return	_obt@r[
+ */
+[[nodiscard]] D3D12_VERTEX_BUFFER_VIEW InstanceBuffer::view(uint32_t frameIndex, uint32_t instanceCount) const noexcept {
+    assert(buffer_ && frameIndex < frameCount_);
+    assert(instanceCount <= capacity_ && "CX^Xobt@̗eʂ𒴂Ă܂");
+
+    D3D12_VERTEX_BUFFER_VIEW view{};
+    view.BufferLocation = buffer_->GetGPUVirtualAddress() + UINT64(strideBytes_) * capacity_ * frameIndex;
+    view.SizeInBytes = strideBytes_ * instanceCount;
+    view.StrideInBytes = strideBytes_;
+    return view;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	1 t[ɏ߂őCX^X擾
+ * @return	őCX^X
+ */
+[[nodiscard]] uint32_t InstanceBuffer::capacity() const noexcept {
+    return capacity_;
+}
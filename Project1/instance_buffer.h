@@ -0,0 +1,74 @@
+// CX^Xobt@NX
+
+#pragma once
+
+#include "device.h"
+#include <cstdint>
+#include <d3d12.h>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CX^Xobt@NX
+ * @details	Abv[hq[v쐬 1 񂾂 Map At[ CPU 璼ڏ
+ *			GPU ǂł̈㏑Ȃ悤At[̗̈ďɎg
+ */
+class InstanceBuffer final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    InstanceBuffer() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~InstanceBuffer();
+
+    // Rs[֎~
+    InstanceBuffer(const InstanceBuffer&) = delete;
+    InstanceBuffer& operator=(const InstanceBuffer&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	obt@쐬
+     * @param	device		foCXNX̃CX^X
+     * @param	strideBytes	1 CX^X̃oCg
+     * @param	capacity	1 t[ɏ߂őCX^X
+     * @param	frameCount	 GPU QƂt[
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, uint32_t strideBytes, uint32_t capacity, uint32_t frameCount) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	t[̏ݐ擾
+     * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+     * @return	ݐicapacity j
+     */
+    [[nodiscard]] void* data(uint32_t frameIndex) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	t[̒_obt@r[擾
+     * @param	frameIndex		t[ԍ
+     * @param	instanceCount	񂾃CX^X
+     * @return	_obt@r[iob` StartInstanceLocation ŋʂj
+     */
+    [[nodiscard]] D3D12_VERTEX_BUFFER_VIEW view(uint32_t frameIndex, uint32_t instanceCount) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	1 t[ɏ߂őCX^X擾
+     * @return	őCX^X
+     */
+    [[nodiscard]] uint32_t capacity() const noexcept;
+
+private:
+    ID3D12Resource* buffer_{};       /// Abv[hq[ṽobt@
+    uint8_t*        mapped_{};       /// Map 
+    uint32_t        strideBytes_{};  /// 1 CX^X̃oCg
+    uint32_t        capacity_{};     /// 1 t[̍őCX^X
+    uint32_t        frameCount_{};   /// t[
+};
@@ -0,0 +1,172 @@
+// WuVXeNX
+
+#include "job_system.h"
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+JobSystem::~JobSystem() {
+    destroy();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[J[XbhN
+ * @param	workerCount	[J[i0 ̏ꍇ͘_RA - 1j
+ * @return	 true
+ */
+[[nodiscard]] bool JobSystem::create(uint32_t workerCount) noexcept {
+    if (!workers_.empty()) {
+        assert(false && "WuVXe͍쐬ς݂ł");
+        return false;
+    }
+
+    if (workerCount == 0) {
+        const uint32_t cores = std::thread::hardware_concurrency();
+        workerCount = cores > 1 ? cores - 1 : 1;
+    }
+
+    quit_ = false;
+    workers_.reserve(workerCount);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back([this] { workerMain(); });
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[J[Xbh~is̃Wu͎sĂ~܂j
+ */
+void JobSystem::destroy() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+    }
+    wakeup_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	PWu𓊓i͑҂Ȃj
+ * @param	job	s鏈
+ */
+void JobSystem::submit(std::function<void()> job) noexcept {
+    // [J[Ȃ΂̏Ŏs
+    if (workers_.empty()) {
+        job();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push(std::move(job));
+    }
+    wakeup_.notify_one();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[0, count) `NɕĕsASďI܂ő҂
+ * @param	count		vf
+ * @param	grainSize	1 `N̗vf
+ * @param	func		func(begin, end) ̌`ŌĂ΂鏈
+ */
+void JobSystem::parallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& func) noexcept {
+    if (count == 0) {
+        return;
+    }
+    grainSize = std::max(grainSize, 1u);
+
+    const uint32_t chunkCount = (count + grainSize - 1) / grainSize;
+    if (workers_.empty() || chunkCount == 1) {
+        func(0, count);
+        return;
+    }
+
+    // [J[ parallelFor ߂ɐGĂSȂ悤ALԂ̓q[vɒu
+    struct State {
+        std::atomic<uint32_t> nextChunk{};
+        std::atomic<uint32_t> doneChunks{};
+        std::mutex            mutex{};
+        std::condition_variable finished{};
+    };
+    auto state = std::make_shared<State>();
+
+    // `N荇ď
+    auto run = [state, count, grainSize, chunkCount, &func] {
+        for (;;) {
+            const uint32_t chunk = state->nextChunk.fetch_add(1);
+            if (chunk >= chunkCount) {
+                return;
+            }
+            const uint32_t begin = chunk * grainSize;
+            const uint32_t end   = std::min(begin + grainSize, count);
+            func(begin, end);
+
+            if (state->doneChunks.fetch_add(1) + 1 == chunkCount) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    // ĂяoXbh 1 lƂĐ
+    const uint32_t helperCount = std::min<uint32_t>(static_cast<uint32_t>(workers_.size()), chunkCount - 1);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (uint32_t i = 0; i < helperCount; ++i) {
+            jobs_.push(run);
+        }
+    }
+    wakeup_.notify_all();
+
+    run();
+
+    // ̃Xbh̃`N҂
+    // func ͂̊֐̃X^bNQƂĂ̂ŁAS`N܂Ŗ߂Ă͂Ȃ
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&] { return state->doneChunks.load() == chunkCount; });
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[J[擾
+ * @return	[J[Xbh
+ */
+[[nodiscard]] uint32_t JobSystem::workerCount() const noexcept {
+    return static_cast<uint32_t>(workers_.size());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[J[Xbh̏
+ */
+void JobSystem::workerMain() noexcept {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wakeup_.wait(lock, [this] { return quit_ || !jobs_.empty(); });
+            if (jobs_.empty()) {
+                // quit_ L[
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop();
+        }
+        job();
+    }
+}
@@ -0,0 +1,89 @@
+// WuVXeNX
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	WuVXeNX
+ * @details	[J[Xbh풓APWu̓Ɣ͈͕̕ss
+ *			Windows ˑ̂ Linux ̃c[x`}[Npł
+ */
+class JobSystem final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    JobSystem() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~JobSystem();
+
+    // Rs[֎~
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[J[XbhN
+     * @param	workerCount	[J[i0 ̏ꍇ͘_RA - 1j
+     * @return	 true
+     */
+    [[nodiscard]] bool create(uint32_t workerCount = 0) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[J[Xbh~is̃Wu͎sĂ~܂j
+     */
+    void destroy() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	PWu𓊓i͑҂Ȃj
+     * @param	job	s鏈
+     */
+    void submit(std::function<void()> job) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[0, count) `NɕĕsASďI܂ő҂
+     * @param	count		vf
+     * @param	grainSize	1 `N̗vf
+     * @param	func		func(begin, end) ̌`ŌĂ΂鏈
+     * @details	ĂяoXbhɎQB[J[NȂ璀sɂȂ
+     */
+    void parallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& func) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[J[擾
+     * @return	[J[Xbh
+     */
+    [[nodiscard]] uint32_t workerCount() const noexcept;
+
+private:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[J[Xbh̏
+     */
+    void workerMain() noexcept;
+
+private:
+    std::vector<std::thread>          workers_{};  /// [J[Xbh
+    std::queue<std::function<void()>> jobs_{};     /// s̃Wu
+    std::mutex                        mutex_{};    /// jobs_ ̕ی
+    std::condition_variable           wakeup_{};   /// [J[Np
+    bool                              quit_{};     /// ~v
+};
@@ -0,0 +1,319 @@
+// NX^CeBÕCg蓖ăpX
+
+#include "light_cluster_pass.h"
+#include "root_signature_builder.h"
+#include <cassert>
+#include <cstring>
+#include <vector>
+#include <Windows.h>
+#include <D3Dcompiler.h>
+#pragma comment(lib, "d3dcompiler.lib")
+
+namespace {
+
+/// 蓖ėp̃[g萔iasset/light_clusters.hlsl  AssignConstants Ɠсj
+struct AssignConstants {
+    uint32_t clusterCount;
+    uint32_t lightCount;
+    uint32_t indexCapacity;
+};
+
+// [gp[^̔ԍ
+enum AssignRootParameter : UINT {
+    AssignRootConstants,
+    AssignRootLights,
+    AssignRootBounds,
+    AssignRootOffsets,
+    AssignRootRanges,
+    AssignRootIndices,
+};
+
+/// `摤ǂޏ
+constexpr D3D12_RESOURCE_STATES ShaderResourceState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Rs[gpCvC쐬
+ * @param	device			foCX
+ * @param	rootSignature	[gVOl`
+ * @param	entry			Gg|Cg
+ * @return	pCvCBsꍇ nullptr
+ */
+ID3D12PipelineState* createComputePipeline(ID3D12Device* device, ID3D12RootSignature* rootSignature, const char* entry) noexcept {
+    ID3DBlob* shader = nullptr;
+    ID3DBlob* error = nullptr;
+    const auto res = D3DCompileFromFile(L"asset/light_clusters.hlsl", nullptr, nullptr, entry, "cs_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &shader, &error);
+    if (error) {
+        OutputDebugStringA(static_cast<const char*>(error->GetBufferPointer()));
+        error->Release();
+    }
+    if (FAILED(res)) {
+        assert(false && "Cg蓖ėpVF[_̃RpCɎs");
+        return nullptr;
+    }
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC desc{};
+    desc.pRootSignature = rootSignature;
+    desc.CS = { shader->GetBufferPointer(), shader->GetBufferSize() };
+
+    ID3D12PipelineState* pipelineState = nullptr;
+    if (FAILED(device->CreateComputePipelineState(&desc, IID_PPV_ARGS(&pipelineState)))) {
+        pipelineState = nullptr;
+    }
+    shader->Release();
+    return pipelineState;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	obt@쐬
+ * @param	device		foCX
+ * @param	size		oCg
+ * @param	heapType	q[v̎
+ * @param	state		
+ * @return	obt@Bsꍇ nullptr
+ */
+ID3D12Resource* createBuffer(ID3D12Device* device, UINT64 size, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES state) noexcept {
+    D3D12_HEAP_PROPERTIES heapProps{};
+    heapProps.Type = heapType;
+
+    D3D12_RESOURCE_DESC resDesc{};
+    resDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    resDesc.Width = size;
+    resDesc.Height = 1;
+    resDesc.DepthOrArraySize = 1;
+    resDesc.MipLevels = 1;
+    resDesc.SampleDesc.Count = 1;
+    resDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    resDesc.Flags = heapType == D3D12_HEAP_TYPE_DEFAULT ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE;
+
+    ID3D12Resource* buffer = nullptr;
+    if (FAILED(device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resDesc, state, nullptr, IID_PPV_ARGS(&buffer)))) {
+        return nullptr;
+    }
+    return buffer;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ԑJڂ̃oA
+ * @param	resource	\[X
+ * @param	before		JڑȌ
+ * @param	after		Jڌ̏
+ * @return	oA
+ */
+D3D12_RESOURCE_BARRIER makeTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after) noexcept {
+    D3D12_RESOURCE_BARRIER barrier{};
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Transition.pResource = resource;
+    barrier.Transition.StateBefore = before;
+    barrier.Transition.StateAfter = after;
+    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    return barrier;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	COM IuWFNg
+ * @param	object	IuWFNginullptr ɂj
+ */
+template <class T>
+void safeRelease(T*& object) noexcept {
+    if (object) {
+        object->Release();
+        object = nullptr;
+    }
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+LightClusterPass::~LightClusterPass() {
+    destroy();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	device				foCXNX̃CX^X
+ * @param	rootSignatureCache	[gVOl`LbV
+ * @param	grid				NX^̕
+ * @param	maxLights			ő僉Cg
+ * @param	indexCapacity		Cgԍ̔z̍ő吔
+ * @return	 true
+ */
+[[nodiscard]] bool LightClusterPass::create(const Device& device, RootSignatureCache& rootSignatureCache, const ClusterGrid& grid, uint32_t maxLights,
+                                            uint32_t indexCapacity) noexcept {
+    assert(maxLights > 0 && indexCapacity > 0);
+    grid_ = grid;
+    maxLights_ = maxLights;
+    indexCapacity_ = indexCapacity;
+    auto* d3dDevice = device.get();
+
+    // 萔 b0, Cg t0, AABB t1, Ɨp u0`u2 ͑Să[gɒڒuifBXNv^q[vsvj
+    RootSignatureBuilder builder;
+    builder.addConstants(sizeof(AssignConstants) / 4, 0)
+        .addSRV(0)
+        .addSRV(1)
+        .addUAV(0)
+        .addUAV(1)
+        .addUAV(2)
+        .setFlags(D3D12_ROOT_SIGNATURE_FLAG_NONE);
+    rootSignature_ = rootSignatureCache.getOrCreate(device, builder);
+    if (!rootSignature_) {
+        return false;
+    }
+
+    countPipeline_ = createComputePipeline(d3dDevice, rootSignature_->get(), "countCS");
+    scanPipeline_ = createComputePipeline(d3dDevice, rootSignature_->get(), "scanCS");
+    fillPipeline_ = createComputePipeline(d3dDevice, rootSignature_->get(), "fillCS");
+    if (!countPipeline_ || !scanPipeline_ || !fillPipeline_) {
+        return false;
+    }
+
+    const UINT64 clusterCount = grid.clusterCount();
+    lightBuffer_ = createBuffer(d3dDevice, UINT64(sizeof(ClusterLight)) * maxLights, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+    boundsBuffer_ = createBuffer(d3dDevice, sizeof(ClusterBounds) * clusterCount, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+    offsetBuffer_ = createBuffer(d3dDevice, sizeof(uint32_t) * clusterCount, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    rangeBuffer_ = createBuffer(d3dDevice, sizeof(ClusterRange) * clusterCount, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    indexBuffer_ = createBuffer(d3dDevice, UINT64(sizeof(uint32_t)) * indexCapacity, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    if (!lightBuffer_ || !boundsBuffer_ || !offsetBuffer_ || !rangeBuffer_ || !indexBuffer_) {
+        assert(false && "Cg蓖Ẵobt@쐬Ɏs");
+        return false;
+    }
+
+    // AABB ͕Ō܂̂ňx
+    D3D12_RANGE readRange{ 0, 0 };
+    void*       mappedBounds = nullptr;
+    if (FAILED(boundsBuffer_->Map(0, &readRange, &mappedBounds))) {
+        return false;
+    }
+    std::vector<ClusterBounds> bounds(grid.clusterCount());
+    computeClusterBounds(grid, bounds.data());
+    std::memcpy(mappedBounds, bounds.data(), sizeof(ClusterBounds) * bounds.size());
+    boundsBuffer_->Unmap(0, nullptr);
+
+    if (FAILED(lightBuffer_->Map(0, &readRange, reinterpret_cast<void**>(&mappedLights_)))) {
+        return false;
+    }
+    resultReadable_ = false;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Sĉ
+ */
+void LightClusterPass::destroy() noexcept {
+    if (lightBuffer_ && mappedLights_) {
+        lightBuffer_->Unmap(0, nullptr);
+        mappedLights_ = nullptr;
+    }
+    safeRelease(indexBuffer_);
+    safeRelease(rangeBuffer_);
+    safeRelease(offsetBuffer_);
+    safeRelease(boundsBuffer_);
+    safeRelease(lightBuffer_);
+    safeRelease(fillPipeline_);
+    safeRelease(scanPipeline_);
+    safeRelease(countPipeline_);
+    lightCount_ = 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Cg
+ * @param	lights	r[Ԃ̃Cg
+ * @param	count	Cg
+ */
+void LightClusterPass::update(const ClusterLight* lights, uint32_t count) noexcept {
+    assert(mappedLights_ && "Cg蓖ăpX쐬ł");
+    assert(count <= maxLights_ && "Cg܂");
+    std::memcpy(mappedLights_, lights, sizeof(ClusterLight) * count);
+    lightCount_ = count;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Cg蓖ẴRs[gpXς
+ * @param	commandList	R}hXg
+ */
+void LightClusterPass::dispatch(ID3D12GraphicsCommandList* commandList) noexcept {
+    const uint32_t clusterCount = grid_.clusterCount();
+    const uint32_t groupCount = (clusterCount + LightClusterGroupSize - 1) / LightClusterGroupSize;
+
+    // Õt[ŕ`摤ǂ񂾃obt@݉\ɖ߂
+    if (resultReadable_) {
+        const D3D12_RESOURCE_BARRIER toUav[] = {
+            makeTransition(rangeBuffer_, ShaderResourceState, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+            makeTransition(indexBuffer_, ShaderResourceState, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+        };
+        commandList->ResourceBarrier(2, toUav);
+    }
+
+    const AssignConstants constants{ clusterCount, lightCount_, indexCapacity_ };
+    commandList->SetComputeRootSignature(rootSignature_->get());
+    commandList->SetComputeRoot32BitConstants(AssignRootConstants, sizeof(AssignConstants) / 4, &constants, 0);
+    commandList->SetComputeRootShaderResourceView(AssignRootLights, lightBuffer_->GetGPUVirtualAddress());
+    commandList->SetComputeRootShaderResourceView(AssignRootBounds, boundsBuffer_->GetGPUVirtualAddress());
+    commandList->SetComputeRootUnorderedAccessView(AssignRootOffsets, offsetBuffer_->GetGPUVirtualAddress());
+    commandList->SetComputeRootUnorderedAccessView(AssignRootRanges, rangeBuffer_->GetGPUVirtualAddress());
+    commandList->SetComputeRootUnorderedAccessView(AssignRootIndices, indexBuffer_->GetGPUVirtualAddress());
+
+    // 3 iK̊Ԃ͑O̒iK݂̏悤 UAV oA
+    D3D12_RESOURCE_BARRIER uavBarrier{};
+    uavBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+
+    commandList->SetPipelineState(countPipeline_);
+    commandList->Dispatch(groupCount, 1, 1);
+    commandList->ResourceBarrier(1, &uavBarrier);
+
+    commandList->SetPipelineState(scanPipeline_);
+    commandList->Dispatch(1, 1, 1);
+    commandList->ResourceBarrier(1, &uavBarrier);
+
+    commandList->SetPipelineState(fillPipeline_);
+    commandList->Dispatch(groupCount, 1, 1);
+
+    // _EsNZVF[_ǂ߂Ԃɂ
+    const D3D12_RESOURCE_BARRIER toShaderResource[] = {
+        makeTransition(rangeBuffer_, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, ShaderResourceState),
+        makeTransition(indexBuffer_, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, ShaderResourceState),
+    };
+    commandList->ResourceBarrier(2, toShaderResource);
+    resultReadable_ = true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`p̃[gp[^ɃCgÉ͈ECgԍݒ肷
+ * @param	commandList			R}hXg
+ * @param	firstRootParameter	Cg̃[g SRV ̔ԍ
+ */
+void LightClusterPass::bind(ID3D12GraphicsCommandList* commandList, UINT firstRootParameter) const noexcept {
+    assert(resultReadable_ && "dispatch ̌ɌĂł");
+    commandList->SetGraphicsRootShaderResourceView(firstRootParameter, lightBuffer_->GetGPUVirtualAddress());
+    commandList->SetGraphicsRootShaderResourceView(firstRootParameter + 1, rangeBuffer_->GetGPUVirtualAddress());
+    commandList->SetGraphicsRootShaderResourceView(firstRootParameter + 2, indexBuffer_->GetGPUVirtualAddress());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NX^̕擾
+ * @return	
+ */
+[[nodiscard]] const ClusterGrid& LightClusterPass::grid() const noexcept {
+    return grid_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	݂̃Cg擾
+ * @return	Cg
+ */
+[[nodiscard]] uint32_t LightClusterPass::lightCount() const noexcept {
+    return lightCount_;
+}
@@ -0,0 +1,111 @@
+// NX^CeBÕCg蓖ăpX
+
+#pragma once
+
+#include "device.h"
+#include "light_clusters.h"
+#include "root_signature_cache.h"
+#include <cstdint>
+#include <d3d12.h>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NX^CeBÕCg蓖ăpX
+ * @details	Cg\obt@ɒuARs[gVF[_ŃNX^Ƃ̃Cgԍ͈̔͂Ɣz
+ *			蓖Ă̎菇 light_clusters.cpp  assignLightsReference ƓŁAʂ̓rbgPʂňv
+ *			`摤 asset/clustered_lighting.hlsli CN[hAbind ŃCgÉ͈ECgԍn
+ */
+class LightClusterPass final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    LightClusterPass() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~LightClusterPass();
+
+    // Rs[֎~
+    LightClusterPass(const LightClusterPass&) = delete;
+    LightClusterPass& operator=(const LightClusterPass&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	device				foCXNX̃CX^X
+     * @param	rootSignatureCache	[gVOl`LbV
+     * @param	grid				NX^̕iAABB ͂ŌvZ GPU ɒuj
+     * @param	maxLights			ő僉Cg
+     * @param	indexCapacity		Cgԍ̔z̍ő吔i͊蓖ĂȂj
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, RootSignatureCache& rootSignatureCache, const ClusterGrid& grid, uint32_t maxLights,
+                              uint32_t indexCapacity) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Sĉ
+     */
+    void destroy() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	CgށiÕt[ GPU IĂĂԁj
+     * @param	lights	r[Ԃ̃Cg
+     * @param	count	Cg
+     */
+    void update(const ClusterLight* lights, uint32_t count) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Cg蓖ẴRs[gpXς
+     * @param	commandList	R}hXg
+     * @details	IƔ͈͂ƃCgԍ̓VF[_ǂ߂ԂɂȂ
+     */
+    void dispatch(ID3D12GraphicsCommandList* commandList) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	`p̃[gp[^ɃCgÉ͈ECgԍݒ肷
+     * @param	commandList			R}hXgi`p[gVOl`͐ݒς݂̂Ɓj
+     * @param	firstRootParameter	Cg̃[g SRV ̔ԍí͈ECgԍ͑ԍɒuƁj
+     */
+    void bind(ID3D12GraphicsCommandList* commandList, UINT firstRootParameter) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	NX^̕擾
+     * @return	
+     */
+    [[nodiscard]] const ClusterGrid& grid() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	݂̃Cg擾
+     * @return	Cg
+     */
+    [[nodiscard]] uint32_t lightCount() const noexcept;
+
+private:
+    const RootSignature* rootSignature_{};     /// 蓖ėp[gVOl`iLbVLj
+    ID3D12PipelineState* countPipeline_{};     /// countCS
+    ID3D12PipelineState* scanPipeline_{};      /// scanCS
+    ID3D12PipelineState* fillPipeline_{};      /// fillCS
+
+    ID3D12Resource*      lightBuffer_{};       /// CgiAbv[hq[vj
+    ClusterLight*        mappedLights_{};      /// lightBuffer_  Map 
+    ID3D12Resource*      boundsBuffer_{};      /// NX^ AABBiAbv[hq[vj
+    ID3D12Resource*      offsetBuffer_{};      /// NX^Ƃ̃CgJnʒu
+    ID3D12Resource*      rangeBuffer_{};       /// NX^Ƃ͈̔
+    ID3D12Resource*      indexBuffer_{};       /// Cgԍ
+
+    ClusterGrid          grid_{};              /// NX^̕
+    uint32_t             maxLights_{};         /// ő僉Cg
+    uint32_t             indexCapacity_{};     /// Cgԍ̔z̍ő吔
+    uint32_t             lightCount_{};        /// ݂̃Cg
+    bool                 resultReadable_{};    /// ͈͂ƃCgԍVF[_\[XԂȂ true
+};
@@ -0,0 +1,444 @@
+// NX^CeBÕCg蓖
+
+#include "light_clusters.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define LIGHT_CLUSTERS_SSE 1
+#include <immintrin.h>
+#endif
+#if defined(__AVX2__)
+#define LIGHT_CLUSTERS_AVX2 1
+#endif
+
+namespace {
+
+/// ^C̍š⃉CgiSoAj
+struct RowCandidates {
+    std::vector<float>    x;       ///< S X
+    std::vector<float>    dy2;     ///< s Y ͈͂܂ł̋ 2 
+    std::vector<float>    dz2;     ///< XCX Z ͈͂܂ł̋ 2 
+    std::vector<float>    r2;      ///< a 2 
+    std::vector<uint32_t> index;   ///< Cgԍ
+
+    void clear() noexcept {
+        x.clear();
+        dy2.clear();
+        dz2.clear();
+        r2.clear();
+        index.clear();
+    }
+};
+
+/// XCX̌⃉Cg
+struct SliceCandidate {
+    uint32_t index;  ///< Cgԍ
+    float    dz2;    ///< XCX Z ͈͂܂ł̋ 2 
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	͈ [min, max] ܂ł̋߂iisLightInCluster Ɠj
+ */
+inline float distanceToRange(float value, float min, float max) noexcept {
+    return std::max(std::max(min - value, value - max), 0.0f);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	š^C 1 Ɣ肷
+ * @param	candidates	š
+ * @param	minX		^C X ̍ŏ
+ * @param	maxX		^C X ̍ő
+ * @param	out			|郉Cgԍ̒ǉ
+ */
+void testTileScalar(const RowCandidates& candidates, size_t begin, float minX, float maxX, std::vector<uint32_t>& out) {
+    for (size_t i = begin; i < candidates.x.size(); ++i) {
+        const float dx = distanceToRange(candidates.x[i], minX, maxX);
+        float       d2 = dx * dx + candidates.dy2[i];
+        d2 = d2 + candidates.dz2[i];
+        if (d2 <= candidates.r2[i]) {
+            out.push_back(candidates.index[i]);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	}XN̗ẴCgԍǉ
+ * @param	mask		茋ʁiʃrbg first, first + 1, ...j
+ * @param	width		}XÑrbg
+ * @param	candidates	š
+ * @param	first		擪̌̈ʒu
+ * @param	out			ǉ
+ */
+inline void appendMasked(uint32_t mask, uint32_t width, const RowCandidates& candidates, size_t first, std::vector<uint32_t>& out) {
+    for (uint32_t lane = 0; lane < width; ++lane) {
+        if ((mask >> lane) & 1) {
+            out.push_back(candidates.index[first + lane]);
+        }
+    }
+}
+
+#if LIGHT_CLUSTERS_SSE
+//---------------------------------------------------------------------------------
+/**
+ * @brief	š^C 1 Ɣ肷iSSE  4 j
+ */
+void testTileSse(const RowCandidates& candidates, float minX, float maxX, std::vector<uint32_t>& out) {
+    const size_t count = candidates.x.size();
+    const __m128 tileMin = _mm_set1_ps(minX);
+    const __m128 tileMax = _mm_set1_ps(maxX);
+    const __m128 zero = _mm_setzero_ps();
+    size_t       i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(&candidates.x[i]);
+        const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(tileMin, x), _mm_sub_ps(x, tileMax)), zero);
+        __m128       d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_loadu_ps(&candidates.dy2[i]));
+        d2 = _mm_add_ps(d2, _mm_loadu_ps(&candidates.dz2[i]));
+        appendMasked(static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(d2, _mm_loadu_ps(&candidates.r2[i])))), 4, candidates, i, out);
+    }
+    testTileScalar(candidates, i, minX, maxX, out);
+}
+#endif
+
+#if LIGHT_CLUSTERS_AVX2
+//---------------------------------------------------------------------------------
+/**
+ * @brief	š^C 1 Ɣ肷iAVX2  8 j
+ */
+void testTileAvx2(const RowCandidates& candidates, float minX, float maxX, std::vector<uint32_t>& out) {
+    const size_t count = candidates.x.size();
+    const __m256 tileMin = _mm256_set1_ps(minX);
+    const __m256 tileMax = _mm256_set1_ps(maxX);
+    const __m256 zero = _mm256_setzero_ps();
+    size_t       i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x = _mm256_loadu_ps(&candidates.x[i]);
+        const __m256 dx = _mm256_max_ps(_mm256_max_ps(_mm256_sub_ps(tileMin, x), _mm256_sub_ps(x, tileMax)), zero);
+        __m256       d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_loadu_ps(&candidates.dy2[i]));
+        d2 = _mm256_add_ps(d2, _mm256_loadu_ps(&candidates.dz2[i]));
+        appendMasked(static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(d2, _mm256_loadu_ps(&candidates.r2[i]), _CMP_LE_OQ))), 8, candidates, i,
+                     out);
+    }
+    testTileScalar(candidates, i, minX, maxX, out);
+}
+#endif
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	XCX 1 ̃NX^ɃCg蓖Ă
+ * @param	grid		
+ * @param	bounds		NX^ AABB
+ * @param	lights		Cg
+ * @param	lightCount	Cg
+ * @param	slice		XCXԍ
+ * @param	simd		g߃Zbg
+ * @param	counts		NX^Ƃ̃Cg̏ݐiSNX^j
+ * @param	out			XCX̃Cgԍ̏ݐiNX^ɕԁj
+ */
+void assignSlice(const ClusterGrid& grid, const ClusterBounds* bounds, const ClusterLight* lights, uint32_t lightCount, uint32_t slice,
+                 CullSimd simd, uint32_t* counts, std::vector<uint32_t>& out) {
+    static thread_local std::vector<SliceCandidate> sliceCandidates;
+    static thread_local RowCandidates               row;
+
+    const uint32_t tilesPerSlice = grid.tilesX * grid.tilesY;
+    const auto&    sliceBounds = bounds[slice * tilesPerSlice];
+
+    // XCX̉sɊ|郉CgiZ ̋Ŕ莮ɂij
+    sliceCandidates.clear();
+    for (uint32_t i = 0; i < lightCount; ++i) {
+        const auto& light = lights[i];
+        const float dz = distanceToRange(light.position[2], sliceBounds.min[2], sliceBounds.max[2]);
+        if (dz * dz <= light.radius * light.radius) {
+            sliceCandidates.push_back({ i, dz * dz });
+        }
+    }
+
+    out.clear();
+    for (uint32_t y = 0; y < grid.tilesY; ++y) {
+        const uint32_t rowBase = slice * tilesPerSlice + y * grid.tilesX;
+        const auto&    rowBounds = bounds[rowBase];
+
+        // s Y ͈͂Ɋ|郉CgB莮 ((dx^2 + dy^2) + dz^2)  (dy^2 + dz^2) 菬ȂȂ̂Ŋɂ
+        row.clear();
+        for (const auto& candidate : sliceCandidates) {
+            const auto& light = lights[candidate.index];
+            const float dy = distanceToRange(light.position[1], rowBounds.min[1], rowBounds.max[1]);
+            const float r2 = light.radius * light.radius;
+            if (dy * dy + candidate.dz2 <= r2) {
+                row.x.push_back(light.position[0]);
+                row.dy2.push_back(dy * dy);
+                row.dz2.push_back(candidate.dz2);
+                row.r2.push_back(r2);
+                row.index.push_back(candidate.index);
+            }
+        }
+
+        for (uint32_t x = 0; x < grid.tilesX; ++x) {
+            const auto&  tile = bounds[rowBase + x];
+            const size_t before = out.size();
+            switch (simd) {
+#if LIGHT_CLUSTERS_AVX2
+            case CullSimd::Avx2:
+                testTileAvx2(row, tile.min[0], tile.max[0], out);
+                break;
+#endif
+#if LIGHT_CLUSTERS_SSE
+            case CullSimd::Sse:
+                testTileSse(row, tile.min[0], tile.max[0], out);
+                break;
+#endif
+            default:
+                testTileScalar(row, 0, tile.min[0], tile.max[0], out);
+                break;
+            }
+            counts[rowBase + x] = static_cast<uint32_t>(out.size() - before);
+        }
+    }
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ˉes񂩂NX^̕
+ * @param	projection	sD 4x4 ̓es
+ * @param	nearZ		ŏ̃XCX̎O
+ * @param	farZ		Ō̃XCX̉
+ * @param	tilesX		̃^C
+ * @param	tilesY		c̃^C
+ * @param	slices		s̃XCX
+ * @return	
+ */
+[[nodiscard]] ClusterGrid makeClusterGrid(const float projection[4][4], float nearZ, float farZ, uint32_t tilesX, uint32_t tilesY,
+                                          uint32_t slices) noexcept {
+    assert(nearZ > 0.0f && farZ > nearZ && tilesX > 0 && tilesY > 0 && slices > 0);
+    ClusterGrid grid;
+    grid.tilesX = tilesX;
+    grid.tilesY = tilesY;
+    grid.slices = slices;
+    grid.nearZ = nearZ;
+    grid.farZ = farZ;
+    grid.xScale = projection[0][0];
+    grid.yScale = projection[1][1];
+    return grid;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NX^̃r[Ԃ AABB vZ
+ * @param	grid	
+ * @param	bounds	ݐigrid.clusterCount() j
+ */
+void computeClusterBounds(const ClusterGrid& grid, ClusterBounds* bounds) noexcept {
+    const double ratio = double(grid.farZ) / double(grid.nearZ);
+    for (uint32_t slice = 0; slice < grid.slices; ++slice) {
+        // s͎wIɕiقǌBeŉʏ̑傫낤j
+        const float nearZ = slice == 0 ? grid.nearZ : static_cast<float>(grid.nearZ * std::pow(ratio, double(slice) / grid.slices));
+        const float farZ = slice + 1 == grid.slices ? grid.farZ : static_cast<float>(grid.nearZ * std::pow(ratio, double(slice + 1) / grid.slices));
+
+        for (uint32_t y = 0; y < grid.tilesY; ++y) {
+            // ^C y ͉ʂ̏ォBNDC  y ͏オ +1
+            const float top = 1.0f - 2.0f * float(y) / float(grid.tilesY);
+            const float bottom = 1.0f - 2.0f * float(y + 1) / float(grid.tilesY);
+            const float minY = std::min(bottom * nearZ, bottom * farZ) / grid.yScale;
+            const float maxY = std::max(top * nearZ, top * farZ) / grid.yScale;
+
+            for (uint32_t x = 0; x < grid.tilesX; ++x) {
+                const float left = -1.0f + 2.0f * float(x) / float(grid.tilesX);
+                const float right = -1.0f + 2.0f * float(x + 1) / float(grid.tilesX);
+                auto&       b = bounds[(slice * grid.tilesY + y) * grid.tilesX + x];
+                b.min[0] = std::min(left * nearZ, left * farZ) / grid.xScale;
+                b.min[1] = minY;
+                b.min[2] = nearZ;
+                b.min[3] = 0.0f;
+                b.max[0] = std::max(right * nearZ, right * farZ) / grid.xScale;
+                b.max[1] = maxY;
+                b.max[2] = farZ;
+                b.max[3] = 0.0f;
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`掞̃NX^QƗp̒萔
+ * @param	grid			
+ * @param	projection		ˉes
+ * @param	viewportWidth	r[|[g̕isNZj
+ * @param	viewportHeight	r[|[g̍
+ * @param	lightCount		Cg
+ * @return	萔
+ */
+[[nodiscard]] ClusterShadingConstants makeClusterShadingConstants(const ClusterGrid& grid, const float projection[4][4], uint32_t viewportWidth,
+                                                                  uint32_t viewportHeight, uint32_t lightCount) noexcept {
+    assert(viewportWidth > 0 && viewportHeight > 0);
+    const float logRatio = std::log(grid.farZ / grid.nearZ);
+
+    ClusterShadingConstants constants{};
+    constants.projection[0] = projection[0][0];
+    constants.projection[1] = projection[1][1];
+    constants.projection[2] = projection[2][2];
+    constants.projection[3] = projection[2][3];
+    constants.tilesPerPixel[0] = float(grid.tilesX) / float(viewportWidth);
+    constants.tilesPerPixel[1] = float(grid.tilesY) / float(viewportHeight);
+    constants.sliceScale = float(grid.slices) / logRatio;
+    constants.sliceBias = -float(grid.slices) * std::log(grid.nearZ) / logRatio;
+    constants.tiles[0] = grid.tilesX;
+    constants.tiles[1] = grid.tilesY;
+    constants.tiles[2] = grid.slices;
+    constants.lightCount = lightCount;
+    return constants;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	sNZ̑NX^߂
+ * @param	constants	萔
+ * @param	pixelX		sNZ XiSV_Position.xj
+ * @param	pixelY		sNZ Y
+ * @param	viewZ		r[Ԃ Z
+ * @return	NX^ԍ
+ */
+[[nodiscard]] uint32_t findCluster(const ClusterShadingConstants& constants, float pixelX, float pixelY, float viewZ) noexcept {
+    const uint32_t x = std::min(static_cast<uint32_t>(std::max(pixelX * constants.tilesPerPixel[0], 0.0f)), constants.tiles[0] - 1);
+    const uint32_t y = std::min(static_cast<uint32_t>(std::max(pixelY * constants.tilesPerPixel[1], 0.0f)), constants.tiles[1] - 1);
+    const float    slice = std::floor(std::log(std::max(viewZ, 1.0e-6f)) * constants.sliceScale + constants.sliceBias);
+    const uint32_t z = static_cast<uint32_t>(std::clamp(slice, 0.0f, float(constants.tiles[2] - 1)));
+    return (z * constants.tiles[1] + y) * constants.tiles[0] + x;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Cg̉e͈͂NX^Ɋ|邩肷
+ * @param	light	Cg
+ * @param	bounds	NX^ AABB
+ * @return	| true
+ */
+[[nodiscard]] bool isLightInCluster(const ClusterLight& light, const ClusterBounds& bounds) noexcept {
+    const float dx = distanceToRange(light.position[0], bounds.min[0], bounds.max[0]);
+    const float dy = distanceToRange(light.position[1], bounds.min[1], bounds.max[1]);
+    const float dz = distanceToRange(light.position[2], bounds.min[2], bounds.max[2]);
+    float       d2 = dx * dx + dy * dy;
+    d2 = d2 + dz * dz;
+    return d2 <= light.radius * light.radius;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SNX^ƑSCg𑍓Ŕ肵Ċ蓖Ă
+ * @param	grid			
+ * @param	bounds			NX^ AABB
+ * @param	lights			Cg
+ * @param	lightCount		Cg
+ * @param	indexCapacity	Cgԍ̔z̍ő吔
+ * @param	ranges			NX^Ƃ͈̔͂̏ݐ
+ * @param	indices			Cgԍ̏ݐ
+ * @return	ÕCgԍ̑
+ */
+uint32_t assignLightsReference(const ClusterGrid& grid, const ClusterBounds* bounds, const ClusterLight* lights, uint32_t lightCount,
+                               uint32_t indexCapacity, ClusterRange* ranges, uint32_t* indices) {
+    uint32_t total = 0;
+    for (uint32_t cluster = 0; cluster < grid.clusterCount(); ++cluster) {
+        uint32_t count = 0;
+        for (uint32_t i = 0; i < lightCount; ++i) {
+            if (isLightInCluster(lights[i], bounds[cluster])) {
+                if (total + count < indexCapacity) {
+                    indices[total + count] = i;
+                }
+                ++count;
+            }
+        }
+        ranges[cluster] = { total, std::min(count, indexCapacity > total ? indexCapacity - total : 0u) };
+        total += count;
+    }
+    return total;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	蓖Ă
+ * @param	grid			
+ * @param	bounds			NX^ AABB
+ * @param	lights			Cg
+ * @param	lightCount		Cg
+ * @param	indexCapacity	Cgԍ̔z̍ő吔
+ * @param	jobSystem		ɏꍇ̃WuVXe
+ * @param	simd			g߃Zbg
+ * @return	ÕCgԍ̑
+ */
+uint32_t LightClusterBuilder::build(const ClusterGrid& grid, const ClusterBounds* bounds, const ClusterLight* lights, uint32_t lightCount,
+                                    uint32_t indexCapacity, JobSystem* jobSystem, CullSimd simd) {
+    simd = simd > bestCullSimd() ? bestCullSimd() : simd;
+    const uint32_t clusterCount = grid.clusterCount();
+    const uint32_t tilesPerSlice = grid.tilesX * grid.tilesY;
+    counts_.resize(clusterCount);
+    ranges_.resize(clusterCount);
+    if (sliceIndices_.size() < grid.slices) {
+        sliceIndices_.resize(grid.slices);
+    }
+
+    // XCXƂɓƗĊ蓖Ă
+    const auto assign = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t slice = begin; slice < end; ++slice) {
+            assignSlice(grid, bounds, lights, lightCount, slice, simd, counts_.data(), sliceIndices_[slice]);
+        }
+    };
+    if (jobSystem) {
+        jobSystem->parallelFor(grid.slices, 1, assign);
+    }
+    else {
+        assign(0, grid.slices);
+    }
+
+    // NX^̔rIݐϘaiGPU ł scanCS ƓjBeʂ𒴂͐Ȃ
+    uint32_t total = 0;
+    for (uint32_t cluster = 0; cluster < clusterCount; ++cluster) {
+        ranges_[cluster] = { total, std::min(counts_[cluster], indexCapacity > total ? indexCapacity - total : 0u) };
+        total += counts_[cluster];
+    }
+    indices_.resize(std::min(total, indexCapacity));
+
+    // XCX̃Cgԍ̓NX^ɕł̂ŁA͈͂ƂɎʂ
+    const auto gather = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t slice = begin; slice < end; ++slice) {
+            const auto& source = sliceIndices_[slice];
+            uint32_t    cursor = 0;
+            for (uint32_t cluster = slice * tilesPerSlice; cluster < (slice + 1) * tilesPerSlice; ++cluster) {
+                const auto& range = ranges_[cluster];
+                std::copy_n(source.begin() + cursor, range.count, indices_.begin() + range.offset);
+                cursor += counts_[cluster];
+            }
+        }
+    };
+    if (jobSystem) {
+        jobSystem->parallelFor(grid.slices, 1, gather);
+    }
+    else {
+        gather(0, grid.slices);
+    }
+    return total;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NX^Ƃ͈̔͂擾
+ * @return	͈
+ */
+[[nodiscard]] const std::vector<ClusterRange>& LightClusterBuilder::ranges() const noexcept {
+    return ranges_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Cgԍ̔z擾
+ * @return	Cgԍ
+ */
+[[nodiscard]] const std::vector<uint32_t>& LightClusterBuilder::indices() const noexcept {
+    return indices_;
+}
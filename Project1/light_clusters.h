@@ -0,0 +1,176 @@
+// NX^CeBÕCg蓖
+
+#pragma once
+
+#include "frustum_culling.h"
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+/// 蓖ẴXbhO[v̑傫iasset/light_clusters.hlsl  numthreads Ɠj
+inline constexpr uint32_t LightClusterGroupSize = 64;
+
+/// |CgCgiasset/light_clusters.hlsl / clustered_lighting.hlsli  ClusterLight Ɠсj
+struct ClusterLight {
+    float position[3];  ///< r[Ԃ̈ʒu
+    float radius;       ///< e͈͂̔ai̊O 0 ɂȂj
+    float color[3];     ///< F
+    float intensity;    ///< 
+};
+static_assert(sizeof(ClusterLight) == 32, "HLSL  ClusterLight ƂĂ܂");
+
+/// NX^̃r[Ԃ AABBiHLSL  ClusterBounds Ɠсj
+struct ClusterBounds {
+    float min[4];  ///< ŏ XYZiw ͖gpj
+    float max[4];  ///< ő XYZiw ͖gpj
+};
+static_assert(sizeof(ClusterBounds) == 32, "HLSL  ClusterBounds ƂĂ܂");
+
+/// NX^̃Cgԍ͈̔́iHLSL  uint2 Ɠсj
+struct ClusterRange {
+    uint32_t offset;  ///< Cgԍ̔z̊Jnʒu
+    uint32_t count;   ///< Cg
+};
+
+/// NX^̕iʂ^CɁAswIȃXCXɕj
+struct ClusterGrid {
+    uint32_t tilesX = 16;     ///< ̃^C
+    uint32_t tilesY = 9;      ///< c̃^C
+    uint32_t slices = 24;     ///< s̃XCX
+    float    nearZ = 0.1f;    ///< ŏ̃XCX̎Oir[Ԃ Zj
+    float    farZ = 1000.0f;  ///< Ō̃XCX̉
+    float    xScale = 1.0f;   ///< ˉes m00ir[Ԃ x / z  NDC  x ɂ{j
+    float    yScale = 1.0f;   ///< ˉes m11
+
+    /// NX^
+    [[nodiscard]] uint32_t clusterCount() const noexcept { return tilesX * tilesY * slices; }
+};
+
+/// `掞̃NX^QƗp̒萔iclustered_lighting.hlsli  ClusterShadingConstants Ɠсj
+struct ClusterShadingConstants {
+    float    projection[4];       ///< m00, m11, m22, m23i[xr[Ԃ Z ߂: z = m23 / (depth - m22)j
+    float    tilesPerPixel[2];    ///< ^C / r[|[g̃sNZ
+    float    sliceScale;          ///< slice = log(z) * sliceScale + sliceBias
+    float    sliceBias;
+    uint32_t tiles[3];            ///< Ec̃^CAXCX
+    uint32_t lightCount;          ///< Cg
+};
+static_assert(sizeof(ClusterShadingConstants) == 48, "HLSL  ClusterShadingConstants ƂĂ܂");
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ˉes񂩂NX^̕
+ * @param	projection	sD 4x4 ̓esimakePerspectiveProjection ̌`j
+ * @param	nearZ		ŏ̃XCX̎O
+ * @param	farZ		Ō̃XCX̉
+ * @param	tilesX		̃^C
+ * @param	tilesY		c̃^C
+ * @param	slices		s̃XCX
+ * @return	
+ */
+[[nodiscard]] ClusterGrid makeClusterGrid(const float projection[4][4], float nearZ, float farZ, uint32_t tilesX = 16, uint32_t tilesY = 9,
+                                          uint32_t slices = 24) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NX^̃r[Ԃ AABB vZ
+ * @param	grid	
+ * @param	bounds	ݐigrid.clusterCount() Bԍ = (slice * tilesY + y) * tilesX + xAy ͉ʂ̏ォj
+ * @details	ςvZ΂悢BGPU ł̌ʂ̂܂܎ĝŁA蓖Ă CPU łƈv
+ */
+void computeClusterBounds(const ClusterGrid& grid, ClusterBounds* bounds) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`掞̃NX^QƗp̒萔
+ * @param	grid			
+ * @param	projection		ˉesigrid ̂Ɠj
+ * @param	viewportWidth	r[|[g̕isNZj
+ * @param	viewportHeight	r[|[g̍
+ * @param	lightCount		Cg
+ * @return	萔
+ */
+[[nodiscard]] ClusterShadingConstants makeClusterShadingConstants(const ClusterGrid& grid, const float projection[4][4], uint32_t viewportWidth,
+                                                                  uint32_t viewportHeight, uint32_t lightCount) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	sNZ̑NX^߂iclustered_lighting.hlsli  findCluster  CPU j
+ * @param	constants	萔
+ * @param	pixelX		sNZ XiSV_Position.xj
+ * @param	pixelY		sNZ Y
+ * @param	viewZ		r[Ԃ Z
+ * @return	NX^ԍ
+ */
+[[nodiscard]] uint32_t findCluster(const ClusterShadingConstants& constants, float pixelX, float pixelY, float viewZ) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Cg̉e͈͂NX^Ɋ|邩肷
+ * @param	light	Cg
+ * @param	bounds	NX^ AABB
+ * @return	| true
+ * @details	GPU łƓE]ŌvZiHLSL  precise  FMA ƕבւ֎~Ăj
+ */
+[[nodiscard]] bool isLightInCluster(const ClusterLight& light, const ClusterBounds& bounds) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SNX^ƑSCg𑍓Ŕ肵Ċ蓖ĂimFp̑fpȎj
+ * @param	grid			
+ * @param	bounds			NX^ AABB
+ * @param	lights			Cg
+ * @param	lightCount		Cg
+ * @param	indexCapacity	Cgԍ̔z̍ő吔i͐Ȃj
+ * @param	ranges			NX^Ƃ͈̔͂̏ݐigrid.clusterCount() j
+ * @param	indices			Cgԍ̏ݐiindexCapacity j
+ * @return	ÕCgԍ̑
+ */
+uint32_t assignLightsReference(const ClusterGrid& grid, const ClusterBounds* bounds, const ClusterLight* lights, uint32_t lightCount,
+                               uint32_t indexCapacity, ClusterRange* ranges, uint32_t* indices);
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Cg̃NX^蓖ăNXiGPU ł CPU j
+ * @details	XCXƂɕɏBXCX̉sɊ|郉CgIсAɃ^C̍sƂɍiĂA
+ *			c SIMD ł܂Ƃ߂Ĕ肷Bi荞݂͔莮Kɂ̂Ōʂ͑ƓŁA
+ *			NX^̃Cg͔ԍɕԁBƗp̔z͎g񂷂̂ŁAt[̊mۂ͋NȂ
+ */
+class LightClusterBuilder final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	蓖Ă
+     * @param	grid			
+     * @param	bounds			NX^ AABB
+     * @param	lights			Cg
+     * @param	lightCount		Cg
+     * @param	indexCapacity	Cgԍ̔z̍ő吔i͐ȂBGPU ł̃obt@̑傫ɍ킹j
+     * @param	jobSystem		ɏꍇ̃WuVXeinullptr ȂĂяoXbhŏj
+     * @param	simd			g߃Zbg
+     * @return	ÕCgԍ̑
+     */
+    uint32_t build(const ClusterGrid& grid, const ClusterBounds* bounds, const ClusterLight* lights, uint32_t lightCount, uint32_t indexCapacity,
+                   JobSystem* jobSystem = nullptr, CullSimd simd = bestCullSimd());
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	NX^Ƃ͈̔͂擾
+     * @return	͈́igrid.clusterCount() j
+     */
+    [[nodiscard]] const std::vector<ClusterRange>& ranges() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Cgԍ̔z擾
+     * @return	Cgԍiꂽj
+     */
+    [[nodiscard]] const std::vector<uint32_t>& indices() const noexcept;
+
+private:
+    std::vector<std::vector<uint32_t>> sliceIndices_{};  /// XCXƂ̃Cgԍ
+    std::vector<uint32_t>              counts_{};        /// NX^Ƃ̃Cg
+    std::vector<ClusterRange>          ranges_{};        /// NX^Ƃ͈̔
+    std::vector<uint32_t>              indices_{};       /// Cgԍ
+};
@@ -0,0 +1,97 @@
+// ʏ̌덷ɂ LOD I
+
+#include "lod_selection.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+/// ɏƂ 1 WũCX^X
+constexpr uint32_t LodGrainSize = 4096;
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ẻʏ̑傫̌W߂
+ * @param	viewportHeight	r[|[g̏cisNZj
+ * @param	fovY			c̉piWAj
+ * @return	viewportHeight / (2 tan(fovY / 2))
+ */
+[[nodiscard]] float lodProjectionScale(float viewportHeight, float fovY) noexcept {
+    return viewportHeight / (2.0f * std::tan(fovY * 0.5f));
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	LOD I
+ * @param	lods		LODi덷͒iiނقǑ傫Ɓj
+ * @param	lodCount	LOD 
+ * @param	distance	J狫E̕\ʂ܂ł̋
+ * @param	previousLod	Õt[ LODiInvalidLod Ȃ疳j
+ * @param	settings	ݒ
+ * @return	ʏ̌덷 threshold ȉɂȂłe LOD
+ * @details	O LOD ê͎̒ǐ덷 threshold * (1 - hysteresis) ȉɂȂĂA
+ *			ׂ͍̂̒ǐ덷 threshold * (1 + hysteresis) 𒴂Ă
+ */
+[[nodiscard]] uint32_t selectLod(const MeshLod* lods, uint32_t lodCount, float distance, uint32_t previousLod,
+                                 const LodSelectionSettings& settings) noexcept {
+    if (lodCount <= 1) {
+        return 0;
+    }
+
+    // 덷̃sNZׂɁA臒lIuWFNgԂ̋ɒĔׂ
+    const float threshold = settings.threshold * std::exp2(settings.bias) * std::max(distance, settings.minDistance) / settings.projectionScale;
+
+    if (previousLod >= lodCount) {
+        uint32_t lod = 0;
+        while (lod + 1 < lodCount && lods[lod + 1].error <= threshold) {
+            ++lod;
+        }
+        return lod;
+    }
+
+    uint32_t lod = previousLod;
+    if (lods[lod].error > threshold * (1.0f + settings.hysteresis)) {
+        while (lod > 0 && lods[lod].error > threshold) {
+            --lod;
+        }
+    } else {
+        while (lod + 1 < lodCount && lods[lod + 1].error <= threshold * (1.0f - settings.hysteresis)) {
+            ++lod;
+        }
+    }
+    return lod;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	bVg̃CX^X LOD ܂Ƃ߂đI
+ * @param	lods			LOD
+ * @param	lodCount		LOD 
+ * @param	cameraPosition	J̈ʒu
+ * @param	spheres			CX^X̋EiS XYZ Ɣaj
+ * @param	count			CX^X
+ * @param	selected		Õt[ LOD ĂA LOD ŏ㏑
+ * @param	settings		ݒ
+ * @param	jobSystem		ɏꍇ̃WuVXe
+ */
+void selectLods(const MeshLod* lods, uint32_t lodCount, const float cameraPosition[3], const float (*spheres)[4], uint32_t count,
+                uint32_t* selected, const LodSelectionSettings& settings, JobSystem* jobSystem) {
+    const auto kernel = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const float dx = spheres[i][0] - cameraPosition[0];
+            const float dy = spheres[i][1] - cameraPosition[1];
+            const float dz = spheres[i][2] - cameraPosition[2];
+            const float distance = std::sqrt(dx * dx + dy * dy + dz * dz) - spheres[i][3];
+            selected[i] = selectLod(lods, lodCount, distance, selected[i], settings);
+        }
+    };
+
+    if (!jobSystem || count <= LodGrainSize) {
+        kernel(0, count);
+        return;
+    }
+    jobSystem->parallelFor(count, LodGrainSize, kernel);
+}
@@ -0,0 +1,59 @@
+// ʏ̌덷ɂ LOD I
+
+#pragma once
+
+#include "mesh.h"
+#include <cstdint>
+
+class JobSystem;
+
+/// LOD I̐ݒ
+struct LodSelectionSettings {
+    float projectionScale = 1.0f;  ///<  1 ̒ 1 sNZɂȂ邩ilodProjectionScale ŋ߂j
+    float threshold = 1.0f;        ///< ʏ̌덷isNZj
+    float hysteresis = 0.25f;      ///< ؂ւ̕ithreshold ɑ΂䗦jBڂ LOD sȂ悤ɂ
+    float bias = 0.0f;             ///< Ŝ LOD oCAXithreshold  2^bias {BőeAōׂj
+    float minDistance = 0.1f;      ///< ̉iE̒ɓƂj
+};
+
+/// ܂ LOD IłȂƂ̈iqXeVXg킸ɑIԁj
+constexpr uint32_t InvalidLod = UINT32_MAX;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ẻʏ̑傫̌W߂
+ * @param	viewportHeight	r[|[g̏cisNZj
+ * @param	fovY			c̉piWAj
+ * @return	viewportHeight / (2 tan(fovY / 2))
+ */
+[[nodiscard]] float lodProjectionScale(float viewportHeight, float fovY) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	LOD I
+ * @param	lods		LODi덷͒iiނقǑ傫Ɓj
+ * @param	lodCount	LOD 
+ * @param	distance	J狫E̕\ʂ܂ł̋
+ * @param	previousLod	Õt[ LODiInvalidLod Ȃ疳j
+ * @param	settings	ݒ
+ * @return	ʏ̌덷 threshold ȉɂȂłe LOD
+ * @details	O LOD ê͎̒ǐ덷 threshold * (1 - hysteresis) ȉɂȂĂA
+ *			ׂ͍̂̒ǐ덷 threshold * (1 + hysteresis) 𒴂Ă
+ */
+[[nodiscard]] uint32_t selectLod(const MeshLod* lods, uint32_t lodCount, float distance, uint32_t previousLod,
+                                 const LodSelectionSettings& settings) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	bVg̃CX^X LOD ܂Ƃ߂đI
+ * @param	lods			LOD
+ * @param	lodCount		LOD 
+ * @param	cameraPosition	J̈ʒu
+ * @param	spheres			CX^X̋EiS XYZ Ɣaj
+ * @param	count			CX^X
+ * @param	selected		Õt[ LOD ĂA LOD ŏ㏑
+ * @param	settings		ݒ
+ * @param	jobSystem		ɏꍇ̃WuVXe
+ */
+void selectLods(const MeshLod* lods, uint32_t lodCount, const float cameraPosition[3], const float (*spheres)[4], uint32_t count,
+                uint32_t* selected, const LodSelectionSettings& settings, JobSystem* jobSystem = nullptr);
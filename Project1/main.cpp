@@ -1,5 +1,10 @@
 #include <Windows.h>
 #include <d3d12.h>
+#include <cstdio>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <vector>
 
 #include "window.h"
 #include "DXGI.h"
@@ -10,10 +15,37 @@
 #include "swap_chain.h"
 #include "descriptor_heap.h"
 #include "render_target.h"
+#include "depth_buffer.h"
+#include "gpu_statistics.h"
+#include "gpu_timer.h"
+#include "resolution_controller.h"
+#include "scaled_render_target.h"
 #include "root_signature.h"
+#include "root_signature_cache.h"
 #include "shader.h"
+#include "shader_library.h"
+#include "shader_reflection.h"
+#include "shader_features.h"
+#include "job_system.h"
+#include "game_loop.h"
 #include "pipline_state_object.h"
+#include "pipeline_state_cache.h"
 #include "vertex_buffer.h"
+#include "instance_batcher.h"
+#include "instance_buffer.h"
+#include "bvh.h"
+#include "frustum_culling.h"
+#include "occlusion_buffer.h"
+#include "indirect_renderer.h"
+#include "particle_renderer.h"
+#include "particle_system.h"
+#include "sdf_font.h"
+#include "ui_batch.h"
+#include "ui_renderer.h"
+#include "draw_submitter.h"
+#include "debug_draw.h"
+#include "debug_renderer.h"
+#include "simd_math.h"
 
 // 傢֗Fs瑦I
 static void Die(const char* msg)
@@ -82,23 +114,87 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
         Die("RenderTarget::createBackBuffer failed");
     }
 
+    // --------------------
+    // DSV Heap / DepthBuffer
+    // --------------------
+    // reverseZiO 1A 0j 32bit floatBvpXgƕsɐ[xŕ`A
+    // F̃pXł͈ԎÕsNZVF[_𑖂点
+    constexpr bool UseDepthPrepass = true;
+    DescriptorHeap dsvHeap;
+    if (!dsvHeap.create(device, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 1)) {
+        Die("DescriptorHeap(DSV)::create failed");
+    }
+
+    DepthBuffer depthBuffer;
+    if (!depthBuffer.create(device, dsvHeap, window, true)) {
+        Die("DepthBuffer::create failed");
+    }
+    const DepthSetup depthSetup{ static_cast<uint32_t>(DepthBuffer::Format), depthBuffer.isReverseZ(), UseDepthPrepass };
+
+    // ĴŃIuWFNg̓NbvԂɒڒu
+    // reverseZ ł̓NA[x 0 ԉȂ̂ŁA[x 0.5 ɒu
+    constexpr float ObjectDepth = 0.5f;
+
     // --------------------
     // RootSignature / Shader / Pipeline
     // --------------------
-    RootSignature rootSignature;
-    if (!rootSignature.create(device)) {
-        Die("RootSignature::create failed");
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        Die("JobSystem::create failed");
+    }
+
+    // SoAgRpCAĝL[ň
+    ShaderLibrary shaderLibrary;
+    if (!shaderLibrary.create(device, jobSystem, makeSceneShaderPermutation())) {
+        Die("ShaderLibrary::create failed (shader.hlsl path?)");
+    }
+
+    const auto& permutation = shaderLibrary.permutation();
+    const ShaderPermutation::Key shaderKey =
+        permutation.makeKey(permutation.findFeature("COLOR_SOURCE"), 0) |
+        permutation.makeKey(permutation.findFeature("USE_GRAYSCALE"), 0) |
+        permutation.makeKey(permutation.findFeature("USE_INSTANCING"), 1);
+    const Shader* shader = shaderLibrary.find(shaderKey);
+    if (!shader) {
+        Die("ShaderLibrary::find failed");
+    }
+
+    // _CAEgƃ[gVOl`̓VF[_gݗĂ
+    // DXIL (.cso) ̓tNVłȂ̂Ŋ̃CAEĝ܂܂ɂ
+    ShaderReflectionData vertexReflection;
+    ShaderReflectionData pixelReflection;
+    const bool reflected =
+        reflectShader(shader->vertexShader(), vertexReflection) &&
+        reflectShader(shader->pixelShader(), pixelReflection);
+
+    // CAEg͓[gVOl`L
+    RootSignatureCache rootSignatureCache;
+    const RootSignature* rootSignature = rootSignatureCache.getOrCreate(
+        device, reflected ? makeRootSignatureBuilder(vertexReflection, pixelReflection) : RootSignatureBuilder{});
+    if (!rootSignature) {
+        Die("RootSignatureCache::getOrCreate failed");
     }
 
-    Shader shader;
-    if (!shader.create(device)) {
-        Die("Shader::create failed (shader.hlsl path?)");
+    PipelineStateDesc sceneDesc = PiplineStateObject::defaultDesc();
+    if (reflected) {
+        sceneDesc.inputLayout = makeInputLayout(vertexReflection);
+    }
+    else {
+        const auto instanceLayout = InstanceBatcher::inputLayout();
+        sceneDesc.inputLayout.insert(sceneDesc.inputLayout.end(), instanceLayout.begin(), instanceLayout.end());
     }
 
-    PiplineStateObject pipeline;
-    if (!pipeline.create(device, shader, rootSignature)) {
-        Die("PiplineStateObject::create failed");
+    const PipelineStateDesc prepassDesc = makeDepthPipelineDesc(sceneDesc, depthSetup, DepthPass::Prepass);
+    sceneDesc = makeDepthPipelineDesc(sceneDesc, depthSetup, DepthPass::Color);
+
+    // pCvC̓LbVoRŔ񓯊ɍA܂ł͊iq`Ȃ
+    // hCõRpCʂ͏IɕۑAN̓[hōς
+    PipelineStateCache pipelineCache;
+    if (!pipelineCache.create(device, jobSystem, L"pipeline_cache.bin")) {
+        Die("PipelineStateCache::create failed");
     }
+    const auto scenePipeline = pipelineCache.request(sceneDesc, *shader, *rootSignature);
+    const auto prepassPipeline = pipelineCache.request(prepassDesc, *shader, *rootSignature);
 
     // --------------------
     // Vertex Buffer
@@ -119,6 +215,253 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
         Die("VertexBuffer::create failed");
     }
 
+    // --------------------
+    // Instancing
+    // --------------------
+    // bVƃpCvC̃IuWFNg 1  DrawInstanced ɂ܂Ƃ߂
+    constexpr uint32_t GridSize = 32;
+    constexpr uint32_t FrameCount = 2;
+    InstanceBatcher instanceBatcher;
+    InstanceBuffer instanceBuffer;
+    if (!instanceBuffer.create(device, sizeof(InstanceData), GridSize * GridSize, FrameCount)) {
+        Die("InstanceBuffer::create failed");
+    }
+
+    // iq̊eZ̋Eiԍ = y * GridSize + xjBZob`ɐς
+    BoundingSpheres gridBounds;
+    for (uint32_t y = 0; y < GridSize; ++y) {
+        for (uint32_t x = 0; x < GridSize; ++x) {
+            const float scale = 1.0f / GridSize;
+            const float center[3] = { -1.0f + (x * 2 + 1) * scale, -1.0f + (y * 2 + 1) * scale, ObjectDepth };
+            gridBounds.add(center, scale * 0.71f);
+        }
+    }
+    std::vector<uint32_t> visibleCells(gridBounds.size());
+
+    // ob`̓\[gL[tŐς݁AԂ̐ݒȂĒo
+    // ԍ: [gVOl` 0 = rootSignatureApCvC 0 = scenePipelineE1 = prepassPipelineA
+    //       _obt@̑g 0 = Op` + CX^X
+    // pX: 0 = [xvpXA1 = F
+    DrawQueue drawQueue;
+    DrawResources drawResources;
+    drawResources.rootSignatures = { rootSignature->get() };
+    drawResources.pipelines = { nullptr, nullptr };
+    drawResources.vertexBuffers = { {} };
+    DrawStateTracker drawState;
+
+    // --------------------
+    // GPU Driven
+    // --------------------
+    // JOƋlߍ݂ GPU ōsAExecuteIndirect 1 ŕ`
+    // F2  CPU ŁiJO  CX^VO  `L[̃\[gƒojɐ؂ւ
+    bool useGpuDriven = true;
+    constexpr uint32_t IndirectGridSize = 48;
+    IndirectRenderer indirectRenderer;
+    // iq̌ɎO̕ǂƕ̌ 1 u
+    if (!indirectRenderer.create(device, rootSignatureCache, pipelineCache, IndirectGridSize * IndirectGridSize + 2, depthSetup)) {
+        Die("IndirectRenderer::create failed");
+    }
+
+    // ʂLׁA͂ݏo GPU ̃JOŗƂ
+    std::vector<DrawObject> drawObjects;
+    for (uint32_t y = 0; y < IndirectGridSize; ++y) {
+        for (uint32_t x = 0; x < IndirectGridSize; ++x) {
+            const float scale = 1.5f / IndirectGridSize;
+            const float tx = -1.5f + (x * 2 + 1) * scale;
+            const float ty = -1.5f + (y * 2 + 1) * scale;
+            drawObjects.push_back({
+                { { scale, 0.0f, 0.0f, tx }, { 0.0f, scale, 0.0f, ty }, { 0.0f, 0.0f, 1.0f, ObjectDepth } },
+                { 1.0f, float(x) / IndirectGridSize, float(y) / IndirectGridSize, 1.0f },
+                { tx, ty, ObjectDepth, scale * 0.71f },
+                3, 0, {},
+            });
+        }
+    }
+
+    // EɊiqO̕ǁi傫ȎOp`juBCPU łł̓IN[_[ɂ
+    constexpr float WallScale = 1.2f;
+    constexpr float WallX = 0.35f;
+    constexpr float WallY = 0.3f;
+    constexpr float WallDepth = 0.7f;  // reverseZ Ȃ̂ŊiqiObjectDepthjO
+    const uint32_t wallObject = static_cast<uint32_t>(drawObjects.size());
+    drawObjects.push_back({
+        { { WallScale, 0.0f, 0.0f, WallX }, { 0.0f, WallScale, 0.0f, WallY }, { 0.0f, 0.0f, 1.0f, WallDepth } },
+        { 0.45f, 0.45f, 0.5f, 1.0f },
+        { WallX, WallY, WallDepth, WallScale * 0.71f },
+        3, 0, {},
+    });
+    indirectRenderer.update(drawObjects.data(), static_cast<uint32_t>(drawObjects.size()));
+
+    // NbNIuWFNg BVH ̃CLXgŒTiԍ = drawObjects ̔ԍj
+    std::vector<Aabb> objectBounds;
+    for (const auto& object : drawObjects) {
+        const float* b = object.bounds;
+        objectBounds.push_back({ { b[0] - b[3], b[1] - b[3], b[2] - b[3] }, { b[0] + b[3], b[1] + b[3], b[2] + b[3] } });
+    }
+    Bvh sceneBvh;
+    sceneBvh.build(objectBounds.data(), static_cast<uint32_t>(objectBounds.size()));
+
+    // ĴŃNbvԂ̂̂ɂ
+    constexpr Mat4    identity = Mat4::identity();
+    const CullFrustum frustum = makeCullFrustum(identity.m);
+
+    // --------------------
+    // Occlusion Culling
+    // --------------------
+    // CPU łł͎ɎcẐAǂɉBꂽ̂\tgEFÃIN[WJOŗƂ
+    // 𑜓x͔̑eɂȂ̂ŉʂ菬
+    OcclusionBuffer occlusionBuffer;
+    if (!occlusionBuffer.create(320, 180)) {
+        Die("OcclusionBuffer::create failed");
+    }
+    // OcclusionBuffer ̐[x͎O 0 Ȃ̂ŁAreverseZ ̐[x𗠕Ԃ
+    const float occlusionViewProjection[4][4] = {
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, depthSetup.reverseZ ? -1.0f : 1.0f, depthSetup.reverseZ ? 1.0f : 0.0f },
+        { 0.0f, 0.0f, 0.0f, 1.0f },
+    };
+    float wallPositions[9];
+    for (uint32_t v = 0; v < 3; ++v) {
+        wallPositions[v * 3 + 0] = triangle[v].pos[0] * WallScale + WallX;
+        wallPositions[v * 3 + 1] = triangle[v].pos[1] * WallScale + WallY;
+        wallPositions[v * 3 + 2] = WallDepth;
+    }
+    const uint32_t     wallIndices[3] = { 0, 1, 2 };
+    const OccluderMesh wallOccluder{ wallPositions, wallIndices, 1 };
+
+    std::vector<Aabb> gridAabbs;
+    for (uint32_t i = 0; i < gridBounds.size(); ++i) {
+        const float center[3] = { gridBounds.x()[i], gridBounds.y()[i], gridBounds.z()[i] };
+        const float r = gridBounds.radius()[i];
+        gridAabbs.push_back({ { center[0] - r, center[1] - r, center[2] - r }, { center[0] + r, center[1] + r, center[2] + r } });
+    }
+
+    // --------------------
+    // Particles
+    // --------------------
+    //  GPU ŃV~[Vifalse Ȃ CPU  SIMD łŌvZăr{[h𑗂j
+    // ĴŃNbvԂɒuAIuWFNgOireverseZ Ȃ̂ő傫[xjo
+    constexpr bool UseGpuParticles = true;
+    constexpr uint32_t MaxParticles = 65536;
+    constexpr float ParticleDeltaTime = 1.0f / 60.0f;  // V~[V̌Œ̍݁iGame Loopj
+    ParticleSystem particleSystem;
+    if (!particleSystem.create(MaxParticles)) {
+        Die("ParticleSystem::create failed");
+    }
+    ParticleForces particleForces;
+    particleForces.gravity[1] = -2.0f;
+    particleSystem.setForces(particleForces);
+
+    ParticleEmitter fountain;
+    fountain.position[1] = -0.9f;
+    fountain.position[2] = 0.75f;
+    fountain.positionJitter = 0.02f;
+    fountain.velocity[1] = 1.8f;
+    fountain.velocityJitter = 0.15f;
+    fountain.rate = 8000.0f;
+    fountain.minLifetime = 1.5f;
+    fountain.maxLifetime = 2.0f;
+    fountain.look = { { 1.0f, 0.9f, 0.5f, 1.0f }, { 1.0f, 0.3f, 0.1f, 0.0f }, 0.01f, 0.004f };
+    particleSystem.addEmitter(fountain);
+
+    // ͍̌EɉBoʒu̓V~[V݂̍ƂɓA
+    // ̖ڈ͍݂ƂɒuXibvVbg`掞ŕԂĕ`isbLȎΏۂɂ͂Ȃj
+    constexpr float FountainSwayWidth = 0.6f;
+    constexpr float FountainSwayPeriod = 4.0f;  // ɂb
+    constexpr float NozzleScale = 0.04f;
+    const auto fountainPosition = [&](double time) {
+        const double phase = std::fmod(time / FountainSwayPeriod, 1.0) * 6.283185307179586;
+        return Vec3{ FountainSwayWidth * static_cast<float>(std::sin(phase)), fountain.position[1], fountain.position[2] };
+    };
+    const uint32_t nozzleObject = static_cast<uint32_t>(drawObjects.size());
+    drawObjects.push_back({
+        { { NozzleScale, 0.0f, 0.0f, 0.0f }, { 0.0f, NozzleScale, 0.0f, fountain.position[1] }, { 0.0f, 0.0f, 1.0f, fountain.position[2] } },
+        { 1.0f, 0.6f, 0.2f, 1.0f },
+        { 0.0f, fountain.position[1], fountain.position[2], NozzleScale * 0.71f },
+        3, 0, {},
+    });
+    TransformSnapshots nozzleSnapshots;
+    std::vector<Transform> nozzleTransforms;
+
+    ParticleRenderer particleRenderer;
+    if (!particleRenderer.create(device, rootSignatureCache, pipelineCache, MaxParticles, 1024, 1, DXGI_FORMAT_R8G8B8A8_UNORM, depthSetup)) {
+        Die("ParticleRenderer::create failed");
+    }
+    ParticleCamera particleCamera{};
+    std::memcpy(particleCamera.viewProjection, identity.m, sizeof(identity.m));
+    particleCamera.right[0] = 1.0f;
+    particleCamera.up[1] = 1.0f;
+
+    // --------------------
+    // Debug Draw
+    // --------------------
+    // F1 Ŋiq̃Z̋EiCPU ł̃JOΏہjŏd˂B̓WuVXe̊eXbhς
+    DebugDraw debugDraw;
+    DebugRenderer debugRenderer;
+    constexpr uint32_t MaxDebugVertices = GridSize * GridSize * 96;
+    if (!debugDraw.create(jobSystem.workerCount() + 1, MaxDebugVertices) ||
+        !debugRenderer.create(device, rootSignatureCache, pipelineCache, MaxDebugVertices, FrameCount, DXGI_FORMAT_R8G8B8A8_UNORM, depthSetup)) {
+        Die("DebugRenderer::create failed");
+    }
+    bool showDebugDraw = false;
+
+    // --------------------
+    // Pipeline Statistics
+    // --------------------
+    // sNZVF[_̎s񐔂𐔂Aʂ̃sNZŊăI[o[h[
+    GpuStatistics gpuStatistics;
+    if (!gpuStatistics.create(device, FrameCount)) {
+        Die("GpuStatistics::create failed");
+    }
+
+    // --------------------
+    // Dynamic Resolution
+    // --------------------
+    // 3D V[͏k`p̃^[Qbgɕ`AGPU Ԃ\ZɎ܂悤k𖈃t[߂
+    // `͈͂̓obNobt@ŜɈL΂
+    const auto [windowWidth, windowHeight] = window.size();
+    ScaledRenderTarget sceneTarget;
+    if (!sceneTarget.create(device, rootSignatureCache, pipelineCache, windowWidth, windowHeight, DXGI_FORMAT_R8G8B8A8_UNORM)) {
+        Die("ScaledRenderTarget::create failed");
+    }
+
+    GpuTimer gpuTimer;
+    if (!gpuTimer.create(device, commandQueue, FrameCount)) {
+        Die("GpuTimer::create failed");
+    }
+
+    ResolutionControllerSettings resolutionSettings;
+    resolutionSettings.targetMilliseconds = 1000.0f / 60.0f;
+    resolutionSettings.minScale = 0.5f;
+    resolutionSettings.maxScale = 1.0f;
+    resolutionSettings.latency = FrameCount;
+    ResolutionController resolutionController(resolutionSettings);
+
+    // --------------------
+    // UI Overlay
+    // --------------------
+    // Ă SDF tHgitools/sdf_font_baker ōj΁AGPU ԂƏkobNobt@̍ɕ`
+    // lp`ƕ 1 {̃Oɋl߂ 1 ŕ`
+    SdfFont uiFont;
+    const bool hasUiFont = loadSdfFont("asset/ui_font.sdffont", uiFont);
+    UiBatch uiBatch;
+    UiRenderer uiRenderer;
+    if (!uiBatch.create(4096) || !uiRenderer.create(device, rootSignatureCache, pipelineCache, 4096, FrameCount, DXGI_FORMAT_R8G8B8A8_UNORM)) {
+        Die("UiRenderer::create failed");
+    }
+    if (hasUiFont) {
+        if (!uiRenderer.setFont(device, uiFont)) {
+            Die("UiRenderer::setFont failed");
+        }
+        uiBatch.setFont(&uiFont);
+    }
+
+    uint64_t frameNumber = 0;
+    uint32_t lastFrameIndex = 0;
+    uint32_t renderWidth = windowWidth;
+    uint32_t renderHeight = windowHeight;
+
     // --------------------
     // Fence (GPU) ꖳƗ₷
     // --------------------
@@ -130,6 +473,36 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
     HRESULT hr = device.get()->CreateFence(0, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence));
     if (FAILED(hr) || !fence) Die("CreateFence failed");
 
+    // --------------------
+    // Game Loop
+    // --------------------
+    // V~[V͌Œ݂̍ŉ񂵁A`̃t[[giPresent ̐҂jɍEȂ悤ɂ
+    // p̃Xbh͎gȂ̂ŁȀ݂̓R}hXgJ gameLoop.frame() ̒ŌĂ΂
+    // GPU ł̃p[eBN͍݂ƂɃRs[gpXς݁ACPU ł͍݂Ƃɐi߂ăt[ 1 񂾂
+    GameLoopSettings gameLoopSettings;
+    gameLoopSettings.timestep.tickSeconds = ParticleDeltaTime;
+    GameLoop gameLoop;
+    uint32_t particleTicks = 0;
+    Transform nozzle;
+    nozzle.position = fountainPosition(0.0);
+    nozzleSnapshots.publish(&nozzle, 1, 0.0);
+    const auto gameClock = [] { return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count(); };
+    if (!gameLoop.start(gameLoopSettings, gameClock, [&](double time, double tickSeconds) {
+            // 𓮂Ăoi݂̍ŏop[eBN͍݂̏Ïʒuoj
+            nozzle.position = fountainPosition(time);
+            particleSystem.emitter(0).position[0] = nozzle.position.x;
+            if (UseGpuParticles) {
+                particleRenderer.simulate(commandList.get(), particleSystem, static_cast<float>(tickSeconds));
+            }
+            else {
+                particleSystem.update(static_cast<float>(tickSeconds), &jobSystem);
+            }
+            nozzleSnapshots.publish(&nozzle, 1, time);
+            ++particleTicks;
+        })) {
+        Die("GameLoop::start failed");
+    }
+
     // --------------------
     // Main Loop
     // --------------------
@@ -141,6 +514,46 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
             WaitForSingleObject(fenceEvent, INFINITE);
         }
 
+        // Õt[ GPU ͏IĂ̂œv GPU Ԃǂ߂
+        // v 3D V[̕Ȃ̂ŁAI[o[h[͕`sNZŊ
+        const float gpuMilliseconds = frameNumber > 0 ? gpuTimer.read(lastFrameIndex) : 0.0f;
+        D3D12_QUERY_DATA_PIPELINE_STATISTICS statistics{};
+        if (frameNumber > 0 && frameNumber % 120 == 0 && gpuStatistics.read(lastFrameIndex, statistics)) {
+            char text[200];
+            std::snprintf(text, sizeof(text), "GPU %.2f ms, scale %.2f (%ux%u), PS invocations %llu, overdraw %.2f (depth prepass %s, %s)\n",
+                gpuMilliseconds, resolutionController.scale(), renderWidth, renderHeight,
+                static_cast<unsigned long long>(statistics.PSInvocations),
+                double(statistics.PSInvocations) / (double(renderWidth) * renderHeight), UseDepthPrepass ? "on" : "off",
+                useGpuDriven ? "gpu driven" : "cpu instancing");
+            OutputDebugStringA(text);
+        }
+        resolutionController.update(gpuMilliseconds);
+        resolutionController.renderSize(sceneTarget.width(), sceneTarget.height(), renderWidth, renderHeight);
+
+        // `؂ւiJOƕ`̗̃t[̒lgj
+        if (GetAsyncKeyState(VK_F2) & 1) {
+            useGpuDriven = !useGpuDriven;
+        }
+
+        // sbLOiĴŃNbvԂŎO牜փC΂jBIuWFNg𔒂
+        // reverseZ ł͐[x̑傫OȂ̂ŁA+Z  -Z ɔ΂
+        if (useGpuDriven && (GetAsyncKeyState(VK_LBUTTON) & 1)) {
+            POINT cursor{};
+            GetCursorPos(&cursor);
+            ScreenToClient(window.handle(), &cursor);
+            const auto [width, height] = window.size();
+            const float nearZ = depthSetup.reverseZ ? 2.0f : -1.0f;
+            const float origin[3] = { cursor.x * 2.0f / width - 1.0f, 1.0f - cursor.y * 2.0f / height, nearZ };
+            const float direction[3] = { 0.0f, 0.0f, depthSetup.reverseZ ? -1.0f : 1.0f };
+            RayHit hit{};
+            if (sceneBvh.raycast(origin, direction, 3.0f, hit)) {
+                for (auto& value : drawObjects[hit.object].color) {
+                    value = 1.0f;
+                }
+                indirectRenderer.update(drawObjects.data(), static_cast<uint32_t>(drawObjects.size()));
+            }
+        }
+
         const UINT backIndex = swapChain.get()->GetCurrentBackBufferIndex();
         ID3D12Resource* backBuffer = renderTarget.get(backIndex);
         auto rtv = renderTarget.getDescriptorHandle(device, rtvHeap, backIndex);
@@ -148,6 +561,32 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
         commandAllocator.reset();
         commandList.reset(commandAllocator);
 
+        const uint32_t frameIndex = backIndex % FrameCount;
+        gpuTimer.begin(commandList.get(), frameIndex);
+
+        // Rs[g̓pCvC㏑̂ŕ`̐ݒɐς
+        // ܂̃V~[V񂷁iGPU ł̃p[eBN͂ō݂ƂɃpXς܂j
+        particleRenderer.beginFrame();
+        const double renderTime = gameLoop.frame();
+        if (particleTicks > 0) {
+            if (!UseGpuParticles) {
+                particleRenderer.upload(particleSystem, &jobSystem);
+            }
+            particleTicks = 0;
+        }
+
+        // ̖̌ڈ`掞̈ʒuɓ
+        if (nozzleSnapshots.interpolate(renderTime, nozzleTransforms)) {
+            DrawObject& object = drawObjects[nozzleObject];
+            const Vec3  position = nozzleTransforms[0].position;
+            object.transform[0][3] = position.x;
+            object.bounds[0] = position.x;
+            indirectRenderer.update(drawObjects.data(), static_cast<uint32_t>(drawObjects.size()));
+        }
+        if (useGpuDriven) {
+            indirectRenderer.cull(commandList.get(), frustum);
+        }
+
         // Present -> RenderTarget
         D3D12_RESOURCE_BARRIER toRT{};
         toRT.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
@@ -157,10 +596,89 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
         toRT.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
         commandList.get()->ResourceBarrier(1, &toRT);
 
-        commandList.get()->SetGraphicsRootSignature(rootSignature.get());
-        commandList.get()->SetPipelineState(pipeline.get());
+        // [gVOl`ƃpCvC͕`悷鑤KvȂƂݒ肷
+        drawState.invalidate();
+
+        // 3D V[͏k`p̃^[Qbg̍ renderWidth x renderHeight ɕ`
+        const float clearColor[] = { 0.1f, 0.1f, 0.3f, 1.0f };
+        const auto dsv = depthBuffer.getCpuDescriptorHandle();
+        sceneTarget.begin(commandList.get(), renderWidth, renderHeight, clearColor, &dsv);
+        commandList.get()->ClearDepthStencilView(dsv, D3D12_CLEAR_FLAG_DEPTH, depthBuffer.clearDepth(), 0, 0, nullptr);
+        gpuStatistics.begin(commandList.get(), frameIndex);
 
-        // viewport / scissor
+        if (useGpuDriven) {
+            indirectRenderer.draw(commandList.get(), vertexBuffer.view());
+        }
+        else {
+            // Op`iqɕׂ
+            instanceBatcher.clear();
+            uint32_t visibleCount = cullSpheres(frustum, gridBounds, visibleCells.data(), &jobSystem);
+            occlusionBuffer.beginFrame(occlusionViewProjection);
+            occlusionBuffer.rasterize(&wallOccluder, 1, &jobSystem);
+            visibleCount = occlusionBuffer.filterVisible(gridAabbs.data(), visibleCells.data(), visibleCount, visibleCells.data(), &jobSystem);
+            for (uint32_t i = 0; i < visibleCount; ++i) {
+                const uint32_t x = visibleCells[i] % GridSize;
+                const uint32_t y = visibleCells[i] / GridSize;
+                const float scale = 1.0f / GridSize;
+                const float tx = -1.0f + (x * 2 + 1) * scale;
+                const float ty = -1.0f + (y * 2 + 1) * scale;
+                const InstanceData instance{
+                    { { scale, 0.0f, 0.0f, tx }, { 0.0f, scale, 0.0f, ty }, { 0.0f, 0.0f, 1.0f, ObjectDepth } },
+                    { float(x) / GridSize, float(y) / GridSize, 1.0f, 1.0f },
+                    0,
+                };
+                instanceBatcher.add(scenePipeline, 0, instance);
+            }
+            // ǂƕ̌ GPU łƓ̂`
+            for (const uint32_t object : { wallObject, nozzleObject }) {
+                InstanceData instance{};
+                std::memcpy(instance.transform, drawObjects[object].transform, sizeof(instance.transform));
+                std::memcpy(instance.color, drawObjects[object].color, sizeof(instance.color));
+                instanceBatcher.add(scenePipeline, 0, instance);
+            }
+            const auto& batches = instanceBatcher.build();
+            instanceBatcher.pack(static_cast<InstanceData*>(instanceBuffer.data(frameIndex)), &jobSystem);
+
+            // 񓯊쐬 nullptr Ȃ̂ŁApCvC͖̎̂t[
+            drawResources.pipelines[0] = pipelineCache.get(scenePipeline, nullptr);
+            drawResources.pipelines[1] = pipelineCache.get(prepassPipeline, nullptr);
+            drawResources.vertexBuffers[0] = { { vertexBuffer.view(), instanceBuffer.view(frameIndex, instanceBatcher.instanceCount()) }, 2 };
+
+            drawQueue.clear();
+            // F̃pCvCoオ܂ł͉ς܂ȂiN̐t[͔wiɂȂj
+            // vpX̃pCvCoオ܂ł͐F̃pXŕ`i[x͏ȂAeXg͒ʂ̂Ōڂ͓j
+            const bool color = drawResources.pipelines[0] != nullptr;
+            const bool prepass = color && UseDepthPrepass && drawResources.pipelines[1];
+            for (const auto& batch : batches) {
+                if (prepass) {
+                    drawQueue.add(makeDrawKey(0, 0, 1, 0, 0, 0.0f), { 0, 1, 0, 0, 3, batch.instanceCount, 0, batch.firstInstance });
+                }
+                if (color) {
+                    drawQueue.add(makeDrawKey(1, 0, 0, 0, 0, 0.0f), { 0, 0, 0, 0, 3, batch.instanceCount, 0, batch.firstInstance });
+                }
+            }
+            drawQueue.sort();
+            submitDrawQueue(commandList.get(), drawQueue, drawResources, drawState);
+        }
+        // ZȂ̂ŕšɐ[x̃eXgĕ`
+        particleRenderer.draw(commandList.get(), particleCamera);
+
+        if (GetAsyncKeyState(VK_F1) & 1) {
+            showDebugDraw = !showDebugDraw;
+        }
+        debugDraw.setEnabled(showDebugDraw);
+        if (showDebugDraw) {
+            jobSystem.parallelFor(gridBounds.size(), 64, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    const float center[3] = { gridBounds.x()[i], gridBounds.y()[i], gridBounds.z()[i] };
+                    debugDraw.sphere(center, gridBounds.radius()[i], 0xFF00FF00);
+                }
+            });
+        }
+        debugRenderer.render(commandList.get(), debugDraw, frameIndex, identity.m);
+        gpuStatistics.end(commandList.get(), frameIndex);
+
+        // obNobt@ŜɈL΂
         auto [w, h] = window.size();
         D3D12_VIEWPORT viewport{};
         viewport.Width = (float)w;
@@ -174,16 +692,25 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
 
         commandList.get()->RSSetViewports(1, &viewport);
         commandList.get()->RSSetScissorRects(1, &scissor);
-
         commandList.get()->OMSetRenderTargets(1, &rtv, FALSE, nullptr);
+        // L΂̃pCvC쐬͔̂wiFœhĂ
+        if (!sceneTarget.upscale(commandList.get())) {
+            commandList.get()->ClearRenderTargetView(rtv, clearColor, 0, nullptr);
+        }
 
-        float clearColor[] = { 0.1f, 0.1f, 0.3f, 1.0f };
-        commandList.get()->ClearRenderTargetView(rtv, clearColor, 0, nullptr);
-
-        auto vbView = vertexBuffer.view();
-        commandList.get()->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-        commandList.get()->IASetVertexBuffers(0, 1, &vbView);
-        commandList.get()->DrawInstanced(3, 1, 0, 0);
+        // UI ̓obNobt@̉𑜓x̂܂܏k`̌ɏd˂
+        if (hasUiFont) {
+            char overlay[64];
+            std::snprintf(overlay, sizeof(overlay), "GPU %.2f ms\nscale %.2f (%ux%u)", gpuMilliseconds, resolutionController.scale(), renderWidth,
+                          renderHeight);
+            float overlayWidth = 0.0f;
+            float overlayHeight = 0.0f;
+            uiBatch.clear();
+            uiBatch.measure(overlay, 20.0f, overlayWidth, overlayHeight);
+            uiBatch.rect(8.0f, 8.0f, overlayWidth + 16.0f, overlayHeight + 8.0f, 0xA0000000);
+            uiBatch.text(16.0f, 12.0f, overlay, 20.0f, 0xFFFFFFFF);
+            uiRenderer.render(commandList.get(), uiBatch, frameIndex, float(w), float(h));
+        }
 
         // RenderTarget -> Present
         D3D12_RESOURCE_BARRIER toPresent = toRT;
@@ -191,6 +718,10 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
         toPresent.Transition.StateAfter = D3D12_RESOURCE_STATE_PRESENT;
         commandList.get()->ResourceBarrier(1, &toPresent);
 
+        gpuTimer.end(commandList.get(), frameIndex);
+        lastFrameIndex = frameIndex;
+        ++frameNumber;
+
         commandList.get()->Close();
 
         ID3D12CommandList* lists[] = { commandList.get() };
@@ -0,0 +1,126 @@
+// bV
+
+#include "mesh.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace {
+
+/// t@C̐擪
+struct MeshFileHeader {
+    uint32_t magic;         ///< MeshMagic
+    uint32_t version;       ///< MeshVersion
+    uint32_t vertexCount;   ///< _
+    uint32_t indexCount;    ///< CfbNX
+    uint32_t lodCount;      ///< LOD 
+    float    center[3];     ///< E̒S
+    float    radius;        ///< E̔a
+};
+
+constexpr uint32_t MeshMagic = 0x4853454D;  // "MESH"
+constexpr uint32_t MeshVersion = 1;
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_狫E߂iAABB ̒SƁAł_܂ł̋j
+ * @param	mesh	bV
+ */
+void computeMeshBounds(Mesh& mesh) noexcept {
+    if (mesh.vertices.empty()) {
+        mesh.center[0] = mesh.center[1] = mesh.center[2] = 0.0f;
+        mesh.radius = 0.0f;
+        return;
+    }
+
+    float lower[3] = {mesh.vertices[0].position[0], mesh.vertices[0].position[1], mesh.vertices[0].position[2]};
+    float upper[3] = {lower[0], lower[1], lower[2]};
+    for (const auto& v : mesh.vertices) {
+        for (int axis = 0; axis < 3; ++axis) {
+            lower[axis] = std::min(lower[axis], v.position[axis]);
+            upper[axis] = std::max(upper[axis], v.position[axis]);
+        }
+    }
+
+    float radius2 = 0.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        mesh.center[axis] = (lower[axis] + upper[axis]) * 0.5f;
+    }
+    for (const auto& v : mesh.vertices) {
+        const float dx = v.position[0] - mesh.center[0];
+        const float dy = v.position[1] - mesh.center[1];
+        const float dz = v.position[2] - mesh.center[2];
+        radius2 = std::max(radius2, dx * dx + dy * dy + dz * dz);
+    }
+    mesh.radius = std::sqrt(radius2);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	bVt@Cɏo
+ * @param	path	t@CpX
+ * @param	mesh	bV
+ * @return	 true
+ */
+[[nodiscard]] bool saveMesh(const std::string& path, const Mesh& mesh) {
+    MeshFileHeader header{};
+    header.magic = MeshMagic;
+    header.version = MeshVersion;
+    header.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+    header.lodCount = static_cast<uint32_t>(mesh.lods.size());
+    std::copy(mesh.center, mesh.center + 3, header.center);
+    header.radius = mesh.radius;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(mesh.vertices.data()), static_cast<std::streamsize>(mesh.vertices.size() * sizeof(MeshVertex)));
+    file.write(reinterpret_cast<const char*>(mesh.indices.data()), static_cast<std::streamsize>(mesh.indices.size() * sizeof(uint32_t)));
+    file.write(reinterpret_cast<const char*>(mesh.lods.data()), static_cast<std::streamsize>(mesh.lods.size() * sizeof(MeshLod)));
+    return static_cast<bool>(file);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	bVt@Cǂݍ
+ * @param	path	t@CpX
+ * @param	mesh	ǂݍݐ
+ * @return	 truei`łႤꍇ falsej
+ */
+[[nodiscard]] bool loadMesh(const std::string& path, Mesh& mesh) {
+    std::ifstream file(path, std::ios::binary);
+    MeshFileHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+    if (header.magic != MeshMagic || header.version != MeshVersion) {
+        return false;
+    }
+
+    mesh.vertices.resize(header.vertexCount);
+    mesh.indices.resize(header.indexCount);
+    mesh.lods.resize(header.lodCount);
+    file.read(reinterpret_cast<char*>(mesh.vertices.data()), static_cast<std::streamsize>(mesh.vertices.size() * sizeof(MeshVertex)));
+    file.read(reinterpret_cast<char*>(mesh.indices.data()), static_cast<std::streamsize>(mesh.indices.size() * sizeof(uint32_t)));
+    file.read(reinterpret_cast<char*>(mesh.lods.data()), static_cast<std::streamsize>(mesh.lods.size() * sizeof(MeshLod)));
+    if (!file) {
+        return false;
+    }
+    std::copy(header.center, header.center + 3, mesh.center);
+    mesh.radius = header.radius;
+
+    // ꂽt@CŔ͈͊Oǂ܂Ȃ悤ɂ
+    for (const auto& lod : mesh.lods) {
+        if (uint64_t(lod.firstIndex) + lod.indexCount > mesh.indices.size()) {
+            return false;
+        }
+    }
+    for (const auto index : mesh.indices) {
+        if (index >= header.vertexCount) {
+            return false;
+        }
+    }
+    return true;
+}
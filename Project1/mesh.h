@@ -0,0 +1,56 @@
+// bV
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// bV̒_
+struct MeshVertex {
+    float position[3];  ///< ʒu
+    float normal[3];    ///< @
+    float uv[2];        ///< eNX`W
+};
+static_assert(sizeof(MeshVertex) == 32, "MeshVertex  32 oCgɂ");
+
+/// LOD 1 iiS LOD Œ_obt@LACfbNX͈̔͂Ⴄj
+struct MeshLod {
+    uint32_t firstIndex;  ///< indices ̐擪ʒu
+    uint32_t indexCount;  ///< CfbNX
+    float    error;       ///< ̌`󂩂̌덷iIuWFNgԂ̋j
+};
+
+/// bViLOD 0 ̌`j
+struct Mesh {
+    std::vector<MeshVertex> vertices{};  ///< _
+    std::vector<uint32_t>   indices{};   ///< S LOD ̃CfbNX LOD ɕׂ
+    std::vector<MeshLod>    lods{};      ///< LOD
+    float                   center[3]{};  ///< E̒S
+    float                   radius{};    ///< E̔a
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_狫E߂iAABB ̒SƁAł_܂ł̋j
+ * @param	mesh	bV
+ */
+void computeMeshBounds(Mesh& mesh) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	bVt@Cɏo
+ * @param	path	t@CpX
+ * @param	mesh	bV
+ * @return	 true
+ */
+[[nodiscard]] bool saveMesh(const std::string& path, const Mesh& mesh);
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	bVt@Cǂݍ
+ * @param	path	t@CpX
+ * @param	mesh	ǂݍݐ
+ * @return	 truei`łႤꍇ falsej
+ */
+[[nodiscard]] bool loadMesh(const std::string& path, Mesh& mesh);
@@ -0,0 +1,708 @@
+// bV̊ȗ LOD `F[iItCj
+
+#include "mesh_simplifier.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// t񎟌덷̎iʒu 3 + @ 3 + UV 2j
+constexpr int AttributeDimension = 8;
+
+/// _kނ̌ɂȂȂ
+constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	N ̓񎟌덷 x^T A x + 2 b^T x + ciA ͑Ώ̂Ȃ̂ŏOpj
+ */
+template <int N>
+struct Quadric {
+    static constexpr int MatrixSize = N * (N + 1) / 2;
+
+    double a[MatrixSize]{};  ///< s A ̏Op
+    double b[N]{};           ///< xNg b
+    double c{};              ///< 萔 c
+    double weight{};         ///< 񂾎Op`̖ʐς̍vi덷𕽋ςɂ邽߁j
+
+    void add(const Quadric& other) noexcept {
+        for (int i = 0; i < MatrixSize; ++i) {
+            a[i] += other.a[i];
+        }
+        for (int i = 0; i < N; ++i) {
+            b[i] += other.b[i];
+        }
+        c += other.c;
+        weight += other.weight;
+    }
+
+    [[nodiscard]] double evaluate(const double* x) const noexcept {
+        double result = c;
+        int    k = 0;
+        for (int i = 0; i < N; ++i) {
+            result += 2.0 * b[i] * x[i];
+            result += a[k++] * x[i] * x[i];
+            for (int j = i + 1; j < N; ++j) {
+                result += 2.0 * a[k++] * x[i] * x[j];
+            }
+        }
+        return std::max(result, 0.0);
+    }
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Op`̒镽ʂ܂ł̋̓\񎟌덷iGarland-Heckbert 1998j
+ * @param	p, q, r		N ̒_
+ * @param	scale		덷Ɋ|d
+ * @param	quadric		
+ * @return	Op`ԂĂ false
+ */
+template <int N>
+bool makeTriangleQuadric(const double* p, const double* q, const double* r, double scale, Quadric<N>& quadric) noexcept {
+    double e1[N];
+    double e2[N];
+    double length1 = 0.0;
+    for (int i = 0; i < N; ++i) {
+        e1[i] = q[i] - p[i];
+        length1 += e1[i] * e1[i];
+    }
+    if (length1 <= 1.0e-24) {
+        return false;
+    }
+    length1 = 1.0 / std::sqrt(length1);
+    double projection = 0.0;
+    for (int i = 0; i < N; ++i) {
+        e1[i] *= length1;
+        projection += e1[i] * (r[i] - p[i]);
+    }
+    double length2 = 0.0;
+    for (int i = 0; i < N; ++i) {
+        e2[i] = r[i] - p[i] - projection * e1[i];
+        length2 += e2[i] * e2[i];
+    }
+    if (length2 <= 1.0e-24) {
+        return false;
+    }
+    length2 = 1.0 / std::sqrt(length2);
+    double pe1 = 0.0;
+    double pe2 = 0.0;
+    double pp = 0.0;
+    for (int i = 0; i < N; ++i) {
+        e2[i] *= length2;
+        pe1 += p[i] * e1[i];
+        pe2 += p[i] * e2[i];
+        pp += p[i] * p[i];
+    }
+
+    // A = I - e1 e1^T - e2 e2^T, b = (p.e1) e1 + (p.e2) e2 - p, c = p.p - (p.e1)^2 - (p.e2)^2
+    int k = 0;
+    for (int i = 0; i < N; ++i) {
+        for (int j = i; j < N; ++j) {
+            quadric.a[k++] = ((i == j ? 1.0 : 0.0) - e1[i] * e1[j] - e2[i] * e2[j]) * scale;
+        }
+        quadric.b[i] = (pe1 * e1[i] + pe2 * e2[i] - p[i]) * scale;
+    }
+    quadric.c = (pp - pe1 * pe1 - pe2 * pe2) * scale;
+    quadric.weight = scale;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	3 xNg̊O
+ */
+void cross(const double* a, const double* b, double* result) noexcept {
+    result[0] = a[1] * b[2] - a[2] * b[1];
+    result[1] = a[2] * b[0] - a[0] * b[2];
+    result[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Op`̖@iKȂj
+ */
+void triangleNormal(const double* p, const double* q, const double* r, double* normal) noexcept {
+    const double e1[3] = {q[0] - p[0], q[1] - p[1], q[2] - p[2]};
+    const double e2[3] = {r[0] - p[0], r[1] - p[1], r[2] - p[2]};
+    cross(e1, e2, normal);
+}
+
+/// kނ̌iʒuO[v from  to Ɋ񂹂j
+struct Collapse {
+    double   cost;         ///< ׂ鏇iɏkނj
+    double   error;        ///< ʒǔ덷̓
+    uint32_t from;         ///< ʒuO[v
+    uint32_t to;           ///< cʒuO[v
+    uint32_t fromVersion;  ///< Ƃ from ̔
+    uint32_t toVersion;    ///< Ƃ to ̔
+
+    bool operator>(const Collapse& other) const noexcept {
+        if (cost != other.cost) {
+            return cost > other.cost;
+        }
+        return std::make_pair(from, to) > std::make_pair(other.from, other.to);
+    }
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ӂ̏kނɂȗ̍Ə
+ * @details	ʒu̒_iEFbWj܂Ƃ߂uʒuO[vvPʂɏkނ
+ *			ʒǔ덷̓O[vƁǍ덷̓EFbWƂɎ
+ */
+class Simplifier final {
+public:
+    Simplifier(const MeshVertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, const SimplifyOptions& options)
+        : vertices_(vertices), triangles_(indices, indices + indexCount), triangleAlive_(indexCount / 3, 1), triangleCount_(indexCount / 3),
+          wedgeTriangles_(vertexCount), groupOf_(vertexCount, InvalidIndex), points_(vertexCount), attributes_(vertexCount) {
+        normalize();
+        buildGroups(vertexCount);
+        buildQuadrics(options);
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Op`ڕWȉɂȂ邩AkނłӂȂ܂ŏkނ
+     * @param	targetTriangleCount	ڕW̎Op`
+     * @param	maxError			덷iIuWFNgԂ̋j
+     * @return	܂łɏkނōő̈ʒǔ덷iIuWFNgԂ̋j
+     * @details	ڕWȂ牽xĂׂi덷͏Ɍ̌`ɑ΂lj
+     */
+    float run(uint32_t targetTriangleCount, float maxError) {
+        const double maxError2 = double(maxError) * maxError / (scale_ * scale_);
+
+        if (!started_) {
+            std::vector<std::pair<uint32_t, uint32_t>> neighbors;
+            for (uint32_t group = 0; group < groupCount(); ++group) {
+                gatherNeighbors(group, neighbors);
+                for (const auto& neighbor : neighbors) {
+                    pushCollapse(group, neighbor.first);
+                }
+            }
+            started_ = true;
+        }
+
+        while (triangleCount_ > targetTriangleCount && !heap_.empty()) {
+            const Collapse collapse = heap_.top();
+            heap_.pop();
+            if (!groupAlive_[collapse.from] || !groupAlive_[collapse.to] || groupVersion_[collapse.from] != collapse.fromVersion ||
+                groupVersion_[collapse.to] != collapse.toVersion) {
+                continue;
+            }
+            if (collapse.error > maxError2 || !canCollapse(collapse.from, collapse.to)) {
+                continue;
+            }
+            perform(collapse.from, collapse.to);
+            worst_ = std::max(worst_, collapse.error);
+            pushCollapses(collapse.to);
+        }
+        return static_cast<float>(std::sqrt(worst_) * scale_);
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	cOp`̏Ԃŏo
+     * @param	destination	ݐ
+     * @return	CfbNX
+     */
+    uint32_t write(uint32_t* destination) const noexcept {
+        uint32_t count = 0;
+        for (size_t t = 0; t < triangleAlive_.size(); ++t) {
+            if (triangleAlive_[t]) {
+                destination[count++] = triangles_[t * 3 + 0];
+                destination[count++] = triangles_[t * 3 + 1];
+                destination[count++] = triangles_[t * 3 + 2];
+            }
+        }
+        return count;
+    }
+
+private:
+    [[nodiscard]] uint32_t groupCount() const noexcept { return static_cast<uint32_t>(groupWedges_.size()); }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	gĂ钸_̋E߂iʒu͂ŐKj
+     */
+    void normalize() noexcept {
+        float lower[3] = {1.0e30f, 1.0e30f, 1.0e30f};
+        float upper[3] = {-1.0e30f, -1.0e30f, -1.0e30f};
+        for (const auto index : triangles_) {
+            for (int axis = 0; axis < 3; ++axis) {
+                lower[axis] = std::min(lower[axis], vertices_[index].position[axis]);
+                upper[axis] = std::max(upper[axis], vertices_[index].position[axis]);
+            }
+        }
+        double radius2 = 0.0;
+        for (int axis = 0; axis < 3; ++axis) {
+            center_[axis] = (double(lower[axis]) + upper[axis]) * 0.5;
+        }
+        for (const auto index : triangles_) {
+            double d2 = 0.0;
+            for (int axis = 0; axis < 3; ++axis) {
+                const double d = vertices_[index].position[axis] - center_[axis];
+                d2 += d * d;
+            }
+            radius2 = std::max(radius2, d2);
+        }
+        scale_ = radius2 > 0.0 ? std::sqrt(radius2) : 1.0;
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ʒuSɈv钸_ʒuO[vɂ܂Ƃ߂
+     */
+    void buildGroups(uint32_t vertexCount) {
+        std::vector<uint32_t> used;
+        std::vector<uint8_t>  referenced(vertexCount, 0);
+        for (const auto index : triangles_) {
+            if (!referenced[index]) {
+                referenced[index] = 1;
+                used.push_back(index);
+            }
+        }
+        std::sort(used.begin(), used.end(), [this](uint32_t a, uint32_t b) {
+            const int order = std::memcmp(vertices_[a].position, vertices_[b].position, sizeof(float) * 3);
+            return order != 0 ? order < 0 : a < b;
+        });
+        for (size_t i = 0; i < used.size(); ++i) {
+            const uint32_t vertex = used[i];
+            if (i == 0 || std::memcmp(vertices_[used[i - 1]].position, vertices_[vertex].position, sizeof(float) * 3) != 0) {
+                groupWedges_.emplace_back();
+                double position[3];
+                for (int axis = 0; axis < 3; ++axis) {
+                    position[axis] = (vertices_[vertex].position[axis] - center_[axis]) / scale_;
+                }
+                groupPositions_.push_back({position[0], position[1], position[2]});
+            }
+            groupOf_[vertex] = groupCount() - 1;
+            groupWedges_.back().push_back(vertex);
+        }
+        groupAlive_.assign(groupCount(), 1);
+        groupVersion_.assign(groupCount(), 0);
+
+        for (uint32_t t = 0; t < triangleCount_; ++t) {
+            for (int corner = 0; corner < 3; ++corner) {
+                wedgeTriangles_[triangles_[t * 3 + corner]].push_back(t);
+            }
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Op`ƊJ񎟌덷
+     */
+    void buildQuadrics(const SimplifyOptions& options) {
+        for (uint32_t vertex = 0; vertex < groupOf_.size(); ++vertex) {
+            if (groupOf_[vertex] == InvalidIndex) {
+                continue;
+            }
+            const auto& v = vertices_[vertex];
+            const auto& p = groupPositions_[groupOf_[vertex]];
+            auto&       point = points_[vertex];
+            point = {p[0], p[1], p[2], v.normal[0] * double(options.normalWeight), v.normal[1] * double(options.normalWeight),
+                     v.normal[2] * double(options.normalWeight), v.uv[0] * double(options.uvWeight), v.uv[1] * double(options.uvWeight)};
+        }
+        geometry_.assign(groupCount(), Quadric<3>{});
+
+        // Op`Ƃ̕ʁiʐςŏdݕtj
+        std::unordered_map<uint64_t, uint32_t> edgeUses;
+        edgeUses.reserve(triangles_.size());
+        for (uint32_t t = 0; t < triangleCount_; ++t) {
+            const uint32_t* corners = &triangles_[t * 3];
+            const double*   p[3] = {groupPositions_[groupOf_[corners[0]]].data(), groupPositions_[groupOf_[corners[1]]].data(),
+                                    groupPositions_[groupOf_[corners[2]]].data()};
+            double          normal[3];
+            triangleNormal(p[0], p[1], p[2], normal);
+            const double area = 0.5 * std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+            Quadric<3> plane{};
+            if (makeTriangleQuadric<3>(p[0], p[1], p[2], area, plane)) {
+                for (int corner = 0; corner < 3; ++corner) {
+                    geometry_[groupOf_[corners[corner]]].add(plane);
+                }
+            }
+            Quadric<AttributeDimension> attribute{};
+            if (makeTriangleQuadric<AttributeDimension>(points_[corners[0]].data(), points_[corners[1]].data(), points_[corners[2]].data(),
+                                                        area, attribute)) {
+                for (int corner = 0; corner < 3; ++corner) {
+                    attributes_[corners[corner]].add(attribute);
+                }
+            }
+            for (int corner = 0; corner < 3; ++corner) {
+                ++edgeUses[edgeKey(groupOf_[corners[corner]], groupOf_[corners[(corner + 1) % 3]])];
+            }
+        }
+
+        // Jɂ́A܂ݎOp`ɐȕʂ𑫂ĉk܂Ȃ悤ɂ
+        for (uint32_t t = 0; t < triangleCount_; ++t) {
+            const uint32_t* corners = &triangles_[t * 3];
+            const double*   p[3] = {groupPositions_[groupOf_[corners[0]]].data(), groupPositions_[groupOf_[corners[1]]].data(),
+                                    groupPositions_[groupOf_[corners[2]]].data()};
+            double          normal[3];
+            triangleNormal(p[0], p[1], p[2], normal);
+            const double length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            if (length <= 0.0) {
+                continue;
+            }
+            for (int corner = 0; corner < 3; ++corner) {
+                const uint32_t a = groupOf_[corners[corner]];
+                const uint32_t b = groupOf_[corners[(corner + 1) % 3]];
+                if (edgeUses[edgeKey(a, b)] != 1) {
+                    continue;
+                }
+                const double* pa = p[corner];
+                const double* pb = p[(corner + 1) % 3];
+                const double  raised[3] = {pa[0] + normal[0] / length, pa[1] + normal[1] / length, pa[2] + normal[2] / length};
+                double        edge2 = 0.0;
+                for (int axis = 0; axis < 3; ++axis) {
+                    edge2 += (pb[axis] - pa[axis]) * (pb[axis] - pa[axis]);
+                }
+                Quadric<3> border{};
+                if (makeTriangleQuadric<3>(pa, pb, raised, edge2 * options.borderWeight, border)) {
+                    border.weight = 0.0;
+                    geometry_[a].add(border);
+                    geometry_[b].add(border);
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] static uint64_t edgeKey(uint32_t a, uint32_t b) noexcept {
+        return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ʒuO[vׂ̗W߂
+     * @param	group		ʒuO[v
+     * @param	neighbors	ׂ̈ʒuO[vƁA̕ӂLOp`̐iԍj
+     * @details	łɎ񂾎Op`EFbẄꗗO
+     */
+    void gatherNeighbors(uint32_t group, std::vector<std::pair<uint32_t, uint32_t>>& neighbors) {
+        thread_local std::vector<uint32_t> others;
+        others.clear();
+        for (const auto wedge : groupWedges_[group]) {
+            auto& list = wedgeTriangles_[wedge];
+            list.erase(std::remove_if(list.begin(), list.end(), [this](uint32_t t) { return !triangleAlive_[t]; }), list.end());
+            for (const auto t : list) {
+                for (int corner = 0; corner < 3; ++corner) {
+                    const uint32_t other = groupOf_[triangles_[t * 3 + corner]];
+                    if (other != group) {
+                        others.push_back(other);
+                    }
+                }
+            }
+        }
+        std::sort(others.begin(), others.end());
+        neighbors.clear();
+        for (const auto other : others) {
+            if (!neighbors.empty() && neighbors.back().first == other) {
+                ++neighbors.back().second;
+            } else {
+                neighbors.emplace_back(other, 1u);
+            }
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	from ̃EFbWƂɊ񂹐 to ̃EFbW߂
+     * @param	from, to	ʒuO[v
+     * @param	mapping		(from ̃EFbW, to ̃EFbW) ̈ꗗ
+     * @return	SẴEFbWɊ񂹐悪 1  trueipڂ܂kނ falsej
+     */
+    bool mapWedges(uint32_t from, uint32_t to, std::vector<std::pair<uint32_t, uint32_t>>& mapping) const {
+        mapping.clear();
+        for (const auto wedge : groupWedges_[from]) {
+            uint32_t target = InvalidIndex;
+            bool     hasTriangle = false;
+            for (const auto t : wedgeTriangles_[wedge]) {
+                if (!triangleAlive_[t]) {
+                    continue;
+                }
+                hasTriangle = true;
+                for (int corner = 0; corner < 3; ++corner) {
+                    const uint32_t other = triangles_[t * 3 + corner];
+                    if (groupOf_[other] != to) {
+                        continue;
+                    }
+                    if (target != InvalidIndex && target != other) {
+                        return false;
+                    }
+                    target = other;
+                }
+            }
+            if (!hasTriangle) {
+                continue;
+            }
+            if (target == InvalidIndex) {
+                return false;
+            }
+            mapping.emplace_back(wedge, target);
+        }
+        return !mapping.empty();
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ʒuO[vokނ̌ƁAĂkނ̌ς
+     */
+    void pushCollapses(uint32_t group) {
+        thread_local std::vector<std::pair<uint32_t, uint32_t>> neighbors;
+        gatherNeighbors(group, neighbors);
+        for (const auto& neighbor : neighbors) {
+            pushCollapse(group, neighbor.first);
+            pushCollapse(neighbor.first, group);
+        }
+    }
+
+    void pushCollapse(uint32_t from, uint32_t to) {
+        thread_local std::vector<std::pair<uint32_t, uint32_t>> mapping;
+        if (!mapWedges(from, to, mapping)) {
+            return;
+        }
+
+        Quadric<3> geometry = geometry_[from];
+        geometry.add(geometry_[to]);
+        const double error = geometry.evaluate(groupPositions_[to].data()) / std::max(geometry.weight, 1.0e-30);
+
+        double attributeError = 0.0;
+        for (const auto& [wedge, target] : mapping) {
+            Quadric<AttributeDimension> attribute = attributes_[wedge];
+            attribute.add(attributes_[target]);
+            attributeError += attribute.evaluate(points_[target].data()) / std::max(attribute.weight, 1.0e-30);
+        }
+        heap_.push({error + attributeError, error, from, to, groupVersion_[from], groupVersion_[to]});
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	kނĂ`Ȃׂ
+     * @details	- from Jɂ΁AɉkނŁAŕĂȂ
+     *			- Lׂ̗ӂގOp`̐ƓƁiNBƔ񑽗l̂ɂȂj
+     *			- Op`ԂԂꂽ肵Ȃ
+     */
+    bool canCollapse(uint32_t from, uint32_t to) {
+        thread_local std::vector<std::pair<uint32_t, uint32_t>> fromNeighbors;
+        thread_local std::vector<std::pair<uint32_t, uint32_t>> toNeighbors;
+        gatherNeighbors(from, fromNeighbors);
+        gatherNeighbors(to, toNeighbors);
+
+        uint32_t shared = 0;
+        uint32_t borderEdges = 0;
+        bool     borderToTarget = false;
+        for (const auto& [neighbor, count] : fromNeighbors) {
+            if (count > 2) {
+                return false;
+            }
+            if (count == 1) {
+                ++borderEdges;
+                borderToTarget = borderToTarget || neighbor == to;
+            }
+            if (neighbor == to) {
+                shared = count;
+            }
+        }
+        if (shared == 0 || (borderEdges != 0 && (borderEdges != 2 || !borderToTarget))) {
+            return false;
+        }
+
+        uint32_t common = 0;
+        auto     a = fromNeighbors.begin();
+        auto     b = toNeighbors.begin();
+        while (a != fromNeighbors.end() && b != toNeighbors.end()) {
+            if (a->first < b->first) {
+                ++a;
+            } else if (b->first < a->first) {
+                ++b;
+            } else {
+                ++common;
+                ++a;
+                ++b;
+            }
+        }
+        if (common != shared) {
+            return false;
+        }
+
+        if (!mapWedges(from, to, mapping_)) {
+            return false;
+        }
+        const double* target = groupPositions_[to].data();
+        for (const auto& [wedge, targetWedge] : mapping_) {
+            for (const auto t : wedgeTriangles_[wedge]) {
+                if (!triangleAlive_[t]) {
+                    continue;
+                }
+                const uint32_t* corners = &triangles_[t * 3];
+                if (corners[0] == targetWedge || corners[1] == targetWedge || corners[2] == targetWedge) {
+                    continue;
+                }
+                const double* before[3];
+                const double* after[3];
+                for (int corner = 0; corner < 3; ++corner) {
+                    before[corner] = groupPositions_[groupOf_[corners[corner]]].data();
+                    after[corner] = corners[corner] == wedge ? target : before[corner];
+                }
+                double n0[3];
+                double n1[3];
+                triangleNormal(before[0], before[1], before[2], n0);
+                triangleNormal(after[0], after[1], after[2], n1);
+                const double dot = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+                const double length0 = n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2];
+                const double length1 = n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2];
+                //  75 xȏς邩Aʐςق 0 ɂȂkނ͔F߂Ȃ
+                if (!(dot > 0.25 * std::sqrt(length0 * length1)) || length1 <= length0 * 1.0e-6) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	kނiO canCollapse ōEFbW̑Ήgj
+     */
+    void perform(uint32_t from, uint32_t to) {
+        for (const auto& [wedge, target] : mapping_) {
+            for (const auto t : wedgeTriangles_[wedge]) {
+                if (!triangleAlive_[t]) {
+                    continue;
+                }
+                uint32_t* corners = &triangles_[t * 3];
+                if (corners[0] == target || corners[1] == target || corners[2] == target) {
+                    triangleAlive_[t] = 0;
+                    --triangleCount_;
+                    continue;
+                }
+                for (int corner = 0; corner < 3; ++corner) {
+                    if (corners[corner] == wedge) {
+                        corners[corner] = target;
+                    }
+                }
+                wedgeTriangles_[target].push_back(t);
+            }
+            wedgeTriangles_[wedge].clear();
+            attributes_[target].add(attributes_[wedge]);
+        }
+        geometry_[to].add(geometry_[from]);
+        groupAlive_[from] = 0;
+        ++groupVersion_[from];
+        ++groupVersion_[to];
+    }
+
+private:
+    using Point = std::array<double, AttributeDimension>;
+    using CollapseHeap = std::priority_queue<Collapse, std::vector<Collapse>, std::greater<>>;
+
+    const MeshVertex*                                   vertices_;            /// ̒_
+    std::vector<uint32_t>                               triangles_;           /// Op`i_ԍj
+    std::vector<uint8_t>                                triangleAlive_;       /// Op`cĂ邩
+    uint32_t                                            triangleCount_;       /// cĂOp`̐
+    std::vector<std::vector<uint32_t>>                  wedgeTriangles_;      /// _Ƃ̎Op`i񂾂̂܂ނƂj
+    std::vector<uint32_t>                               groupOf_;             /// _̈ʒuO[v
+    std::vector<std::vector<uint32_t>>                  groupWedges_;         /// ʒuO[v̒_
+    std::vector<std::array<double, 3>>                  groupPositions_;      /// ʒuO[v̐Kʒu
+    std::vector<uint8_t>                                groupAlive_;          /// ʒuO[vcĂ邩
+    std::vector<uint32_t>                               groupVersion_;        /// ʒuO[v̔ŁǐÂj
+    std::vector<Point>                                  points_;              /// _̑t̓_
+    std::vector<Quadric<3>>                             geometry_;            /// ʒuO[v̈ʒǔ덷
+    std::vector<Quadric<AttributeDimension>>            attributes_;          /// _̑ť덷
+    CollapseHeap                                        heap_{};              /// kނ̌
+    std::vector<std::pair<uint32_t, uint32_t>>          mapping_{};           /// canCollapse ōEFbW̑Ή
+    double                                              center_[3]{};         /// K̒S
+    double                                              scale_{1.0};          /// K̔a
+    double                                              worst_{};             /// ܂ł̈ʒǔ덷̓̍ő
+    bool                                                started_{};           /// ς񂾂
+};
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	bVȗ
+ * @param	vertices			_
+ * @param	vertexCount			_
+ * @param	indices				Op`Xg̃CfbNX
+ * @param	indexCount			CfbNX
+ * @param	targetIndexCount	ڕW̃CfbNX
+ * @param	maxError			덷iIuWFNgԂ̋j
+ * @param	destination			ʂ̏ݐiindexCount jB_ԍ͌̂܂
+ * @param	resultError			ʂ̌덷̏ݐisvȂ nullptrj
+ * @param	options				ݒ
+ * @return	ʂ̃CfbNX
+ * @details	t񎟌덷iGarland-HeckbertjŕӂkނA_̒_Ɋ񂹂iV_͍Ȃj
+ *			ʒuɂ钸_iUV @̌pځj͂܂Ƃ߂ēApڂɉkނ̂ŊȂ
+ *			덷͌̎Op`̕ʂ܂ł̋ʐςŏdݕt敽ς̌ς
+ */
+uint32_t simplifyMesh(const MeshVertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, uint32_t targetIndexCount,
+                      float maxError, uint32_t* destination, float* resultError, const SimplifyOptions& options) {
+    if (targetIndexCount >= indexCount || indexCount < 3) {
+        std::copy(indices, indices + indexCount, destination);
+        if (resultError) {
+            *resultError = 0.0f;
+        }
+        return indexCount;
+    }
+
+    Simplifier  simplifier(vertices, vertexCount, indices, indexCount, options);
+    const float error = simplifier.run(targetIndexCount / 3, maxError);
+    if (resultError) {
+        *resultError = error;
+    }
+    return simplifier.write(destination);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	LOD `F[
+ * @param	mesh		bVilods  LOD 0A indices Ŝ̌`ƂAindices  lods 蒼j
+ * @param	settings	ݒ
+ * @details	1 ̊ȗڕWȂ瑱Ařʂeiɂi덷͏Ɍ̌`ɑ΂lŁAiiނقǑ傫j
+ *			Op`قƂǌȂȂiőł؂
+ */
+void generateLodChain(Mesh& mesh, const LodChainSettings& settings) {
+    std::vector<uint32_t> base;
+    if (mesh.lods.empty()) {
+        base = mesh.indices;
+    } else {
+        const auto& lod0 = mesh.lods[0];
+        base.assign(mesh.indices.begin() + lod0.firstIndex, mesh.indices.begin() + lod0.firstIndex + lod0.indexCount);
+    }
+
+    const auto baseCount = static_cast<uint32_t>(base.size());
+    mesh.indices = base;
+    mesh.lods.assign(1, MeshLod{0, baseCount, 0.0f});
+
+    if (baseCount < 3) {
+        return;
+    }
+    std::vector<uint32_t> buffer(baseCount);
+    Simplifier            simplifier(mesh.vertices.data(), static_cast<uint32_t>(mesh.vertices.size()), base.data(), baseCount, settings.simplify);
+    uint32_t              previousCount = baseCount;
+    while (mesh.lods.size() < settings.maxLodCount) {
+        const uint32_t target = std::max(static_cast<uint32_t>(float(previousCount / 3) * settings.reduction), settings.minTriangleCount) * 3;
+        if (target >= previousCount) {
+            break;
+        }
+        const float    error = simplifier.run(target / 3, settings.maxError);
+        const uint32_t count = simplifier.write(buffer.data());
+        // 5% Ȃ΁Aȏ͉pڂŎ~܂Ă
+        if (uint64_t(count) * 20 > uint64_t(previousCount) * 19) {
+            break;
+        }
+        mesh.lods.push_back(MeshLod{static_cast<uint32_t>(mesh.indices.size()), count, error});
+        mesh.indices.insert(mesh.indices.end(), buffer.begin(), buffer.begin() + count);
+        previousCount = count;
+    }
+}
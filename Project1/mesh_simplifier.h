@@ -0,0 +1,52 @@
+// bV̊ȗ LOD `F[iItCj
+
+#pragma once
+
+#include "mesh.h"
+#include <cstdint>
+
+/// ȗ̐ݒ
+struct SimplifyOptions {
+    float normalWeight = 0.5f;    ///< @̍̏d݁iE̔a 1 Ƃɑ΂āj
+    float uvWeight = 1.0f;        ///< UV ̍̏d݁ij
+    float borderWeight = 10.0f;   ///< Jۂ߂̕ʂ̏d
+};
+
+/// LOD `F[̐ݒ
+struct LodChainSettings {
+    uint32_t        maxLodCount = 6;         ///< LOD 0 ܂ލői
+    float           reduction = 0.5f;        ///< 1 iƂ̎Op`̔䗦
+    float           maxError = 1.0e30f;      ///< 덷iIuWFNgԂ̋jBi͍Ȃ
+    uint32_t        minTriangleCount = 16;   ///< 菭Ȃ͂Ȃ
+    SimplifyOptions simplify{};              ///< ȗ̐ݒ
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	bVȗ
+ * @param	vertices			_
+ * @param	vertexCount			_
+ * @param	indices				Op`Xg̃CfbNX
+ * @param	indexCount			CfbNX
+ * @param	targetIndexCount	ڕW̃CfbNX
+ * @param	maxError			덷iIuWFNgԂ̋j
+ * @param	destination			ʂ̏ݐiindexCount jB_ԍ͌̂܂
+ * @param	resultError			ʂ̌덷̏ݐisvȂ nullptrj
+ * @param	options				ݒ
+ * @return	ʂ̃CfbNX
+ * @details	t񎟌덷iGarland-HeckbertjŕӂkނA_̒_Ɋ񂹂iV_͍Ȃj
+ *			ʒuɂ钸_iUV @̌pځj͂܂Ƃ߂ēApڂɉkނ̂ŊȂ
+ *			덷͌̎Op`̕ʂ܂ł̋ʐςŏdݕt敽ς̌ς
+ */
+uint32_t simplifyMesh(const MeshVertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, uint32_t targetIndexCount,
+                      float maxError, uint32_t* destination, float* resultError, const SimplifyOptions& options = {});
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	LOD `F[
+ * @param	mesh		bVilods  LOD 0A indices Ŝ̌`ƂAindices  lods 蒼j
+ * @param	settings	ݒ
+ * @details	1 ̊ȗڕWȂ瑱Ařʂeiɂi덷͏Ɍ̌`ɑ΂lŁAiiނقǑ傫j
+ *			Op`قƂǌȂȂiőł؂
+ */
+void generateLodChain(Mesh& mesh, const LodChainSettings& settings = {});
@@ -0,0 +1,468 @@
+// \tgEFAIN[WJO
+
+#include "occlusion_buffer.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define OCCLUSION_BUFFER_SSE 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/// Srbg}XNs
+constexpr uint32_t FullRow = 0xffffffffu;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[lo, hi] ̃rbg𗧂Ă}XNsi͈͊O͐؂l߂j
+ */
+uint32_t spanMask(int32_t lo, int32_t hi) noexcept {
+    lo = std::max(lo, 0);
+    hi = std::min(hi, 31);
+    if (lo > hi) {
+        return 0;
+    }
+    const uint32_t width = static_cast<uint32_t>(hi - lo + 1);
+    return (width == 32 ? FullRow : ((1u << width) - 1)) << lo;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_ϊiclip = M * (p, 1)j
+ */
+void transformPoint(const float m[4][4], const float p[3], float clip[4]) noexcept {
+    for (int row = 0; row < 4; ++row) {
+        clip[row] = m[row][0] * p[0] + m[row][1] * p[1] + m[row][2] * p[2] + m[row][3];
+    }
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	width	
+ * @param	height	c
+ * @return	 true
+ */
+[[nodiscard]] bool OcclusionBuffer::create(uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) {
+        return false;
+    }
+    width_ = width;
+    height_ = height;
+    tilesX_ = (width + TileWidth - 1) / TileWidth;
+    tilesY_ = (height + TileHeight - 1) / TileHeight;
+    tiles_.resize(size_t(tilesX_) * tilesY_);
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t[n߂
+ * @param	viewProjection	sD 4x4 ̃r[ˉes
+ */
+void OcclusionBuffer::beginFrame(const float viewProjection[4][4]) noexcept {
+    std::memcpy(viewProjection_, viewProjection, sizeof(viewProjection_));
+    for (auto& tile : tiles_) {
+        std::memset(tile.mask, 0, sizeof(tile.mask));
+        tile.zMax0 = 1.0f;
+        tile.zMax1 = 0.0f;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	IN[_[
+ * @param	meshes		bV
+ * @param	count		bV
+ * @param	jobSystem	ɏꍇ̃WuVXe
+ */
+void OcclusionBuffer::rasterize(const OccluderMesh* meshes, uint32_t count, JobSystem* jobSystem) {
+    // Op`ʂɓeĕӂ̎Ɛ[x̕ʂ
+    triangles_.clear();
+    const float width = float(width_);
+    const float height = float(height_);
+    for (uint32_t m = 0; m < count; ++m) {
+        const OccluderMesh& mesh = meshes[m];
+        for (uint32_t t = 0; t < mesh.triangleCount; ++t) {
+            float x[3];
+            float y[3];
+            float z[3];
+            bool  clipped = false;
+            for (int v = 0; v < 3; ++v) {
+                float clip[4];
+                transformPoint(viewProjection_, &mesh.positions[mesh.indices[t * 3 + v] * 3], clip);
+                if (!(clip[3] > 0.0f) || clip[2] < 0.0f) {
+                    clipped = true;
+                    break;
+                }
+                x[v] = (clip[0] / clip[3] * 0.5f + 0.5f) * width;
+                y[v] = (0.5f - clip[1] / clip[3] * 0.5f) * height;
+                z[v] = clip[2] / clip[3];
+            }
+            if (clipped) {
+                continue;
+            }
+
+            const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+            if (!(std::fabs(area) > 0.0f)) {
+                continue;
+            }
+
+            ScreenTriangle triangle{};
+            const float    sign = area > 0.0f ? 1.0f : -1.0f;
+            for (int e = 0; e < 3; ++e) {
+                const int i = e;
+                const int j = (e + 1) % 3;
+                triangle.edge[e][0] = (y[i] - y[j]) * sign;
+                triangle.edge[e][1] = (x[j] - x[i]) * sign;
+                triangle.edge[e][2] = (x[i] * y[j] - x[j] * y[i]) * sign;
+            }
+            triangle.depth[0] = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+            triangle.depth[1] = ((x[1] - x[0]) * (z[2] - z[0]) - (x[2] - x[0]) * (z[1] - z[0])) / area;
+            triangle.depth[2] = z[0] - triangle.depth[0] * x[0] - triangle.depth[1] * y[0];
+            triangle.zMin = std::min({ z[0], z[1], z[2] });
+            triangle.zMax = std::max({ z[0], z[1], z[2] });
+
+            // sNZS (px + 0.5) Op`̊Oڋ`ɓ͈
+            const auto toPixel = [](float value, float limit) { return std::clamp(value, -1.0f, limit); };
+            triangle.bounds[0] = static_cast<int32_t>(toPixel(std::ceil(std::min({ x[0], x[1], x[2] }) - 0.5f), width));
+            triangle.bounds[1] = static_cast<int32_t>(toPixel(std::ceil(std::min({ y[0], y[1], y[2] }) - 0.5f), height));
+            triangle.bounds[2] = static_cast<int32_t>(toPixel(std::floor(std::max({ x[0], x[1], x[2] }) - 0.5f), width));
+            triangle.bounds[3] = static_cast<int32_t>(toPixel(std::floor(std::max({ y[0], y[1], y[2] }) - 0.5f), height));
+            triangle.bounds[0] = std::max(triangle.bounds[0], 0);
+            triangle.bounds[1] = std::max(triangle.bounds[1], 0);
+            triangle.bounds[2] = std::min(triangle.bounds[2], int32_t(width_) - 1);
+            triangle.bounds[3] = std::min(triangle.bounds[3], int32_t(height_) - 1);
+            if (triangle.bounds[0] > triangle.bounds[2] || triangle.bounds[1] > triangle.bounds[3]) {
+                continue;
+            }
+            triangles_.push_back(triangle);
+        }
+    }
+
+    // ^CsƂɕΏݐ悪dȂȂ̂ŃbN͗vȂ
+    if (jobSystem) {
+        jobSystem->parallelFor(tilesY_, 1, [this](uint32_t begin, uint32_t end) { rasterizeRows(begin, end); });
+    }
+    else {
+        rasterizeRows(0, tilesY_);
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Op`^Cs [tileRowBegin, tileRowEnd) ɏ
+ */
+void OcclusionBuffer::rasterizeRows(uint32_t tileRowBegin, uint32_t tileRowEnd) noexcept {
+    for (uint32_t tileRow = tileRowBegin; tileRow < tileRowEnd; ++tileRow) {
+        const int32_t rowTop = int32_t(tileRow * TileHeight);
+        const int32_t rowBottom = rowTop + int32_t(TileHeight) - 1;
+
+        for (const auto& triangle : triangles_) {
+            if (triangle.bounds[3] < rowTop || triangle.bounds[1] > rowBottom) {
+                continue;
+            }
+
+            // 8 sԂ̍[EE[ix Wj߂Be a*x + b*y + c >= 0  x ɂĉ
+            float left[TileHeight];
+            float right[TileHeight];
+#if OCCLUSION_BUFFER_SSE
+            for (uint32_t half = 0; half < TileHeight; half += 4) {
+                const float  base = float(rowTop + int32_t(half)) + 0.5f;
+                const __m128 y = _mm_setr_ps(base, base + 1.0f, base + 2.0f, base + 3.0f);
+                __m128       spanLeft = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+                __m128       spanRight = _mm_set1_ps(std::numeric_limits<float>::infinity());
+                for (const auto& edge : triangle.edge) {
+                    const __m128 value = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge[1]), y), _mm_set1_ps(edge[2]));
+                    if (edge[0] > 0.0f) {
+                        spanLeft = _mm_max_ps(spanLeft, _mm_div_ps(_mm_sub_ps(_mm_setzero_ps(), value), _mm_set1_ps(edge[0])));
+                    }
+                    else if (edge[0] < 0.0f) {
+                        spanRight = _mm_min_ps(spanRight, _mm_div_ps(_mm_sub_ps(_mm_setzero_ps(), value), _mm_set1_ps(edge[0])));
+                    }
+                    else {
+                        // ȕӂ͍sƂɑSSO
+                        const __m128 outside = _mm_cmplt_ps(value, _mm_setzero_ps());
+                        spanLeft = _mm_or_ps(_mm_andnot_ps(outside, spanLeft), _mm_and_ps(outside, _mm_set1_ps(std::numeric_limits<float>::infinity())));
+                    }
+                }
+                _mm_storeu_ps(left + half, spanLeft);
+                _mm_storeu_ps(right + half, spanRight);
+            }
+#else
+            for (uint32_t row = 0; row < TileHeight; ++row) {
+                const float y = float(rowTop + int32_t(row)) + 0.5f;
+                left[row] = -std::numeric_limits<float>::infinity();
+                right[row] = std::numeric_limits<float>::infinity();
+                for (const auto& edge : triangle.edge) {
+                    const float value = edge[1] * y + edge[2];
+                    if (edge[0] > 0.0f) {
+                        left[row] = std::max(left[row], (0.0f - value) / edge[0]);
+                    }
+                    else if (edge[0] < 0.0f) {
+                        right[row] = std::min(right[row], (0.0f - value) / edge[0]);
+                    }
+                    else if (value < 0.0f) {
+                        left[row] = std::numeric_limits<float>::infinity();
+                    }
+                }
+            }
+#endif
+
+            // sNZS [left, right] ɓ͈̔͂ɒ
+            int32_t first[TileHeight];
+            int32_t last[TileHeight];
+            for (uint32_t row = 0; row < TileHeight; ++row) {
+                const int32_t y = rowTop + int32_t(row);
+                if (y < triangle.bounds[1] || y > triangle.bounds[3]) {
+                    first[row] = 1;
+                    last[row] = 0;
+                    continue;
+                }
+                first[row] = std::max(triangle.bounds[0], static_cast<int32_t>(std::clamp(std::ceil(left[row] - 0.5f), -1.0f, float(width_))));
+                last[row] = std::min(triangle.bounds[2], static_cast<int32_t>(std::clamp(std::floor(right[row] - 0.5f), -1.0f, float(width_))));
+            }
+
+            const uint32_t tileBegin = uint32_t(triangle.bounds[0]) / TileWidth;
+            const uint32_t tileEnd = uint32_t(triangle.bounds[2]) / TileWidth;
+            for (uint32_t tileColumn = tileBegin; tileColumn <= tileEnd; ++tileColumn) {
+                const int32_t tileLeft = int32_t(tileColumn * TileWidth);
+                uint32_t      coverage[TileHeight];
+                uint32_t      any = 0;
+                for (uint32_t row = 0; row < TileHeight; ++row) {
+                    coverage[row] = spanMask(first[row] - tileLeft, last[row] - tileLeft);
+                    any |= coverage[row];
+                }
+                if (!any) {
+                    continue;
+                }
+
+                // ^C̎lŐ[x̕ʂ]A_̍őŗ}̂Op`̍łƂ
+                const float x0 = float(tileLeft);
+                const float x1 = x0 + float(TileWidth);
+                const float y0 = float(rowTop);
+                const float y1 = y0 + float(TileHeight);
+                const float* d = triangle.depth;
+                const float corner = std::max({ d[0] * x0 + d[1] * y0 + d[2], d[0] * x1 + d[1] * y0 + d[2],
+                                                d[0] * x0 + d[1] * y1 + d[2], d[0] * x1 + d[1] * y1 + d[2] });
+                updateTile(tiles_[size_t(tileRow) * tilesX_ + tileColumn], coverage, std::min(triangle.zMax, corner));
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	^COp`̔핢ōXV
+ * @param	tile		^C
+ * @param	coverage	Op`sNZ
+ * @param	zTriangle	sNZł̎Op`̍ł̐[x
+ */
+void OcclusionBuffer::updateTile(Tile& tile, const uint32_t coverage[TileHeight], float zTriangle) noexcept {
+    // QƑw艜Ȃ牽BȂ
+    if (zTriangle >= tile.zMax0) {
+        return;
+    }
+
+    // ƑwVOp`AQƑwƂ̍ȏɉȂƑŵĂĎ蒼
+    const float distanceToTriangle = tile.zMax1 - zTriangle;
+    const float distanceToReference = tile.zMax0 - tile.zMax1;
+    if (distanceToTriangle > distanceToReference) {
+        std::memset(tile.mask, 0, sizeof(tile.mask));
+        tile.zMax1 = 0.0f;
+    }
+
+    tile.zMax1 = std::max(tile.zMax1, zTriangle);
+    uint32_t full = FullRow;
+#if OCCLUSION_BUFFER_SSE
+    for (uint32_t half = 0; half < TileHeight; half += 4) {
+        const __m128i merged = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tile.mask + half)),
+                                            _mm_loadu_si128(reinterpret_cast<const __m128i*>(coverage + half)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(tile.mask + half), merged);
+        full &= _mm_movemask_epi8(_mm_cmpeq_epi32(merged, _mm_set1_epi32(-1))) == 0xffff ? FullRow : 0;
+    }
+#else
+    for (uint32_t row = 0; row < TileHeight; ++row) {
+        tile.mask[row] |= coverage[row];
+        full &= tile.mask[row];
+    }
+#endif
+
+    // ƑwŃ^C܂QƑwɏ
+    if (full == FullRow) {
+        tile.zMax0 = std::min(tile.zMax0, tile.zMax1);
+        tile.zMax1 = 0.0f;
+        std::memset(tile.mask, 0, sizeof(tile.mask));
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	E{bNX邩ׂ
+ * @param	bounds	[hԂ̋E{bNX
+ * @return	BĂȂ true
+ */
+[[nodiscard]] bool OcclusionBuffer::isVisible(const Aabb& bounds) const noexcept {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+    float zNear;
+#if OCCLUSION_BUFFER_SSE
+    // 8 _ 4  SoA ŕϊix, y ͉ʃrbg min/max Iԁj
+    const __m128 xs = _mm_setr_ps(bounds.min[0], bounds.max[0], bounds.min[0], bounds.max[0]);
+    const __m128 ys = _mm_setr_ps(bounds.min[1], bounds.min[1], bounds.max[1], bounds.max[1]);
+    __m128       screenMinX = _mm_set1_ps(std::numeric_limits<float>::max());
+    __m128       screenMinY = screenMinX;
+    __m128       screenMaxX = _mm_set1_ps(-std::numeric_limits<float>::max());
+    __m128       screenMaxY = screenMaxX;
+    __m128       depthMin = screenMinX;
+    for (int half = 0; half < 2; ++half) {
+        const __m128 zs = _mm_set1_ps(bounds.min[2] + (half ? bounds.max[2] - bounds.min[2] : 0.0f));
+        __m128       clip[4];
+        for (int row = 0; row < 4; ++row) {
+            const float* m = viewProjection_[row];
+            clip[row] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[0]), xs), _mm_mul_ps(_mm_set1_ps(m[1]), ys)),
+                                   _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m[2]), zs), _mm_set1_ps(m[3])));
+        }
+        // ÕNbvʂ܂ׂ̂͒Ȃ̂Ō鈵
+        const __m128 behind = _mm_or_ps(_mm_cmpnlt_ps(_mm_setzero_ps(), clip[3]), _mm_cmplt_ps(clip[2], _mm_setzero_ps()));
+        if (_mm_movemask_ps(behind)) {
+            return true;
+        }
+        const __m128 inverseW = _mm_div_ps(_mm_set1_ps(1.0f), clip[3]);
+        const __m128 half4 = _mm_set1_ps(0.5f);
+        const __m128 x = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(clip[0], inverseW), half4), half4), _mm_set1_ps(float(width_)));
+        const __m128 y = _mm_mul_ps(_mm_sub_ps(half4, _mm_mul_ps(_mm_mul_ps(clip[1], inverseW), half4)), _mm_set1_ps(float(height_)));
+        screenMinX = _mm_min_ps(screenMinX, x);
+        screenMaxX = _mm_max_ps(screenMaxX, x);
+        screenMinY = _mm_min_ps(screenMinY, y);
+        screenMaxY = _mm_max_ps(screenMaxY, y);
+        depthMin = _mm_min_ps(depthMin, _mm_mul_ps(clip[2], inverseW));
+    }
+    alignas(16) float lanes[5][4];
+    _mm_store_ps(lanes[0], screenMinX);
+    _mm_store_ps(lanes[1], screenMaxX);
+    _mm_store_ps(lanes[2], screenMinY);
+    _mm_store_ps(lanes[3], screenMaxY);
+    _mm_store_ps(lanes[4], depthMin);
+    minX = std::min({ lanes[0][0], lanes[0][1], lanes[0][2], lanes[0][3] });
+    maxX = std::max({ lanes[1][0], lanes[1][1], lanes[1][2], lanes[1][3] });
+    minY = std::min({ lanes[2][0], lanes[2][1], lanes[2][2], lanes[2][3] });
+    maxY = std::max({ lanes[3][0], lanes[3][1], lanes[3][2], lanes[3][3] });
+    zNear = std::min({ lanes[4][0], lanes[4][1], lanes[4][2], lanes[4][3] });
+#else
+    minX = minY = zNear = std::numeric_limits<float>::max();
+    maxX = maxY = -std::numeric_limits<float>::max();
+    for (int corner = 0; corner < 8; ++corner) {
+        const float p[3] = { (corner & 1) ? bounds.max[0] : bounds.min[0], (corner & 2) ? bounds.max[1] : bounds.min[1],
+                             (corner & 4) ? bounds.max[2] : bounds.min[2] };
+        float clip[4];
+        transformPoint(viewProjection_, p, clip);
+        if (!(clip[3] > 0.0f) || clip[2] < 0.0f) {
+            // ÕNbvʂ܂ׂ̂͒Ȃ̂Ō鈵
+            return true;
+        }
+        const float inverseW = 1.0f / clip[3];
+        const float x = (clip[0] * inverseW * 0.5f + 0.5f) * float(width_);
+        const float y = (0.5f - clip[1] * inverseW * 0.5f) * float(height_);
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        zNear = std::min(zNear, clip[2] * inverseW);
+    }
+#endif
+    if (zNear > 1.0f) {
+        return false;
+    }
+
+    // `ł|sNZ͈̔
+    const int32_t x0 = std::max(0, static_cast<int32_t>(std::clamp(std::floor(minX), -1.0f, float(width_))));
+    const int32_t y0 = std::max(0, static_cast<int32_t>(std::clamp(std::floor(minY), -1.0f, float(height_))));
+    const int32_t x1 = std::min(int32_t(width_) - 1, static_cast<int32_t>(std::clamp(std::ceil(maxX), -1.0f, float(width_))) - 1);
+    const int32_t y1 = std::min(int32_t(height_) - 1, static_cast<int32_t>(std::clamp(std::ceil(maxY), -1.0f, float(height_))) - 1);
+    if (x0 > x1 || y0 > y1) {
+        return false;
+    }
+
+    for (uint32_t tileRow = uint32_t(y0) / TileHeight; tileRow <= uint32_t(y1) / TileHeight; ++tileRow) {
+        const int32_t rowTop = int32_t(tileRow * TileHeight);
+        for (uint32_t tileColumn = uint32_t(x0) / TileWidth; tileColumn <= uint32_t(x1) / TileWidth; ++tileColumn) {
+            const Tile& tile = tiles_[size_t(tileRow) * tilesX_ + tileColumn];
+
+            // `͈̔͂SčƑwɓĂ΁AƑw̐[xł}
+            float          bound = tile.zMax0;
+            const uint32_t columns = spanMask(x0 - int32_t(tileColumn * TileWidth), x1 - int32_t(tileColumn * TileWidth));
+            bool           inWorkingLayer = true;
+            for (uint32_t row = 0; row < TileHeight; ++row) {
+                const int32_t y = rowTop + int32_t(row);
+                if (y >= y0 && y <= y1 && (columns & ~tile.mask[row])) {
+                    inWorkingLayer = false;
+                    break;
+                }
+            }
+            if (inWorkingLayer) {
+                bound = std::min(bound, tile.zMax1);
+            }
+            if (zNear <= bound) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̂̂c
+ * @param	bounds		E{bNX
+ * @param	candidates	ׂIuWFNgԍ
+ * @param	count		␔
+ * @param	visible		IuWFNgԍ̏ݐ
+ * @param	jobSystem	ɏꍇ̃WuVXe
+ * @return	IuWFNg
+ */
+uint32_t OcclusionBuffer::filterVisible(const Aabb* bounds, const uint32_t* candidates, uint32_t count, uint32_t* visible, JobSystem* jobSystem) {
+    static thread_local std::vector<uint8_t> flags;
+    flags.resize(count);
+    uint8_t*   flag = flags.data();
+    const auto test = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            flag[i] = isVisible(bounds[candidates[i]]) ? 1 : 0;
+        }
+    };
+    if (jobSystem) {
+        jobSystem->parallelFor(count, 1024, test);
+    }
+    else {
+        test(0, count);
+    }
+
+    // ݈ʒu͓ǂݏoʒuǂzȂ̂ candidates  visible łǂ
+    uint32_t visibleCount = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (flag[i]) {
+            visible[visibleCount++] = candidates[i];
+        }
+    }
+    return visibleCount;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	^C̍ł[xo
+ * @param	depths	ݐ
+ */
+void OcclusionBuffer::tileDepths(float* depths) const noexcept {
+    for (size_t i = 0; i < tiles_.size(); ++i) {
+        depths[i] = tiles_[i].zMax0;
+    }
+}
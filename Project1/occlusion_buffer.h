@@ -0,0 +1,127 @@
+// \tgEFAIN[WJO
+
+#pragma once
+
+#include "bvh.h"
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+/// IN[_[̃bVi[hԂ̎Op`Xgj
+struct OccluderMesh {
+    const float*    positions;      ///< _W XYZ ̕
+    const uint32_t* indices;        ///< Op`Ƃ 3 ̒_ԍ
+    uint32_t        triangleCount;  ///< Op`
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	}XNt[xobt@ɂIN[WJONX
+ * @details	ʂ 32x8 sNZ̃^CɕA^CƂɔ핢}XNi256 rbgj 2 ̐[x
+ *			- zMax0: ^CŜ̍ł[xiQƑwj
+ *			- zMax1: }XN̗ĂsNZ̍ł[xiƑwj
+ *			ƑwŃ^C܂QƑwɏށBsNZƂ̐[x͎Ȃ̂ŏA͕ێI
+ *			iBĂƔ肵͕̂KBĂjɂȂ
+ *			[x D3D Ɠ z/wi0 OA1 j
+ */
+class OcclusionBuffer final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	width	isNZj
+     * @param	height	cisNZj
+     * @return	 true
+     */
+    [[nodiscard]] bool create(uint32_t width, uint32_t height);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	t[n߂iobt@Ŗ߁Asoj
+     * @param	viewProjection	sD 4x4 ̃r[ˉesiclip = M * pj
+     */
+    void beginFrame(const float viewProjection[4][4]) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	IN[_[
+     * @param	meshes		bV
+     * @param	count		bV
+     * @param	jobSystem	ɏꍇ̃WuVXei^CsƂɕj
+     * @details	ÕNbvʂ܂Op`͏܂ȂiBʂ邾Ōʂ͕ێIȂ܂܁j
+     */
+    void rasterize(const OccluderMesh* meshes, uint32_t count, JobSystem* jobSystem = nullptr);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	E{bNX邩ׂ
+     * @param	bounds	[hԂ̋E{bNX
+     * @return	BĂȂ trueiʊO falsej
+     */
+    [[nodiscard]] bool isVisible(const Aabb& bounds) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̂̂c
+     * @param	bounds		E{bNXiԍ = IuWFNgԍj
+     * @param	candidates	ׂIuWFNgԍiJǑʂȂǁj
+     * @param	count		␔
+     * @param	visible		IuWFNgԍ̏ݐicount Bcandidates Ɠłǂj
+     * @param	jobSystem	ɏꍇ̃WuVXe
+     * @return	IuWFNgiԂ candidates Ɠj
+     */
+    uint32_t filterVisible(const Aabb* bounds, const uint32_t* candidates, uint32_t count, uint32_t* visible, JobSystem* jobSystem = nullptr);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	^C̍ł[xoimFpj
+     * @param	depths	ݐitileCountX() * tileCountY() j
+     */
+    void tileDepths(float* depths) const noexcept;
+
+    [[nodiscard]] uint32_t tileCountX() const noexcept { return tilesX_; }
+    [[nodiscard]] uint32_t tileCountY() const noexcept { return tilesY_; }
+
+    /// ^C̑傫
+    static constexpr uint32_t TileWidth = 32;
+    static constexpr uint32_t TileHeight = 8;
+
+private:
+    /// ^C
+    struct Tile {
+        uint32_t mask[TileHeight];  ///< Ƒw̔핢isƁAʃrbgj
+        float    zMax0;             ///< QƑw̐[x
+        float    zMax1;             ///< Ƒw̐[x
+    };
+
+    /// ʂɓeOp`
+    struct ScreenTriangle {
+        float    edge[3][3];   ///< ӂ̎ a*x + b*y + cij
+        float    depth[3];     ///< [x̕ z = d0*x + d1*y + d2
+        float    zMin;         ///< _̍łO̐[x
+        float    zMax;         ///< _̍ł̐[x
+        int32_t  bounds[4];    ///< sNZ͈̔́iEEEEA[܂ށj
+    };
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Op`^Cs [tileRowBegin, tileRowEnd) ɏ
+     */
+    void rasterizeRows(uint32_t tileRowBegin, uint32_t tileRowEnd) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	^COp`̔핢ōXV
+     */
+    static void updateTile(Tile& tile, const uint32_t coverage[TileHeight], float zTriangle) noexcept;
+
+private:
+    std::vector<Tile>           tiles_{};                 /// ^CisDj
+    std::vector<ScreenTriangle> triangles_{};             /// 񏑂ގOp`
+    float                       viewProjection_[4][4]{};  /// r[ˉes
+    uint32_t                    width_{};                 /// 
+    uint32_t                    height_{};                /// c
+    uint32_t                    tilesX_{};                /// ̃^C
+    uint32_t                    tilesY_{};                /// c̃^C
+};
@@ -0,0 +1,418 @@
+// p[eBN`NX
+
+#include "particle_renderer.h"
+#include "pipline_state_object.h"
+#include "root_signature_builder.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <Windows.h>
+#include <D3Dcompiler.h>
+#pragma comment(lib, "d3dcompiler.lib")
+
+namespace {
+
+/// V~[Vp̃[g萔iasset/particles.hlsl  SimulateConstants Ɠсj
+struct SimulateConstants {
+    float    gravity[3];
+    float    drag;
+    float    wind[3];
+    float    deltaTime;
+    uint32_t capacity;
+    uint32_t spawnCount;
+    uint32_t sourceCounter;
+};
+
+// [gp[^̔ԍ
+enum ComputeRootParameter : UINT {
+    ComputeRootConstants,
+    ComputeRootSpawned,
+    ComputeRootLooks,
+    ComputeRootSource,
+    ComputeRootDestination,
+    ComputeRootInstances,
+    ComputeRootCounters,
+};
+enum DrawRootParameter : UINT {
+    DrawRootCamera,
+    DrawRootInstances,
+};
+
+/// Ԑڈ̈ʒui 2 ̌j
+constexpr UINT64 ArgumentOffset = sizeof(uint32_t) * 2;
+
+/// `摤ǂޏ
+constexpr D3D12_RESOURCE_STATES InstanceReadState = D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Rs[gpCvC쐬
+ * @param	device			foCX
+ * @param	rootSignature	[gVOl`
+ * @param	entry			Gg|Cg
+ * @return	pCvCBsꍇ nullptr
+ */
+ID3D12PipelineState* createComputePipeline(ID3D12Device* device, ID3D12RootSignature* rootSignature, const char* entry) noexcept {
+    ID3DBlob* shader = nullptr;
+    ID3DBlob* error = nullptr;
+    const auto res = D3DCompileFromFile(L"asset/particles.hlsl", nullptr, nullptr, entry, "cs_5_0", D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, &shader, &error);
+    if (error) {
+        OutputDebugStringA(static_cast<const char*>(error->GetBufferPointer()));
+        error->Release();
+    }
+    if (FAILED(res)) {
+        assert(false && "p[eBNpVF[_̃RpCɎs");
+        return nullptr;
+    }
+
+    D3D12_COMPUTE_PIPELINE_STATE_DESC desc{};
+    desc.pRootSignature = rootSignature;
+    desc.CS = { shader->GetBufferPointer(), shader->GetBufferSize() };
+
+    ID3D12PipelineState* pipelineState = nullptr;
+    if (FAILED(device->CreateComputePipelineState(&desc, IID_PPV_ARGS(&pipelineState)))) {
+        pipelineState = nullptr;
+    }
+    shader->Release();
+    return pipelineState;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	obt@쐬
+ * @param	device		foCX
+ * @param	size		oCg
+ * @param	heapType	q[v̎
+ * @param	state		
+ * @return	obt@Bsꍇ nullptr
+ */
+ID3D12Resource* createBuffer(ID3D12Device* device, UINT64 size, D3D12_HEAP_TYPE heapType, D3D12_RESOURCE_STATES state) noexcept {
+    D3D12_HEAP_PROPERTIES heapProps{};
+    heapProps.Type = heapType;
+
+    D3D12_RESOURCE_DESC resDesc{};
+    resDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    resDesc.Width = size;
+    resDesc.Height = 1;
+    resDesc.DepthOrArraySize = 1;
+    resDesc.MipLevels = 1;
+    resDesc.SampleDesc.Count = 1;
+    resDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    resDesc.Flags = heapType == D3D12_HEAP_TYPE_DEFAULT ? D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS : D3D12_RESOURCE_FLAG_NONE;
+
+    ID3D12Resource* buffer = nullptr;
+    if (FAILED(device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resDesc, state, nullptr, IID_PPV_ARGS(&buffer)))) {
+        return nullptr;
+    }
+    return buffer;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ԑJڂ̃oA
+ * @param	resource	\[X
+ * @param	before		JڑȌ
+ * @param	after		Jڌ̏
+ * @return	oA
+ */
+D3D12_RESOURCE_BARRIER makeTransition(ID3D12Resource* resource, D3D12_RESOURCE_STATES before, D3D12_RESOURCE_STATES after) noexcept {
+    D3D12_RESOURCE_BARRIER barrier{};
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Transition.pResource = resource;
+    barrier.Transition.StateBefore = before;
+    barrier.Transition.StateAfter = after;
+    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    return barrier;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	COM IuWFNg
+ * @param	object	IuWFNginullptr ɂj
+ */
+template <class T>
+void safeRelease(T*& object) noexcept {
+    if (object) {
+        object->Release();
+        object = nullptr;
+    }
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+ParticleRenderer::~ParticleRenderer() {
+    destroy();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	device				foCXNX̃CX^X
+ * @param	rootSignatureCache	[gVOl`LbV
+ * @param	pipelineCache		pCvCXe[gLbV
+ * @param	capacity			őp[eBN
+ * @param	maxSpawn			GPU ł 1 t[ɏoő吔
+ * @param	maxEmitters			őG~b^
+ * @param	renderTargetFormat	`ރ_[^[Qbǧ`
+ * @param	depth				[xobt@̎g
+ * @return	 true
+ */
+[[nodiscard]] bool ParticleRenderer::create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache,
+                                            uint32_t capacity, uint32_t maxSpawn, uint32_t maxEmitters, DXGI_FORMAT renderTargetFormat,
+                                            const DepthSetup& depth) noexcept {
+    assert(capacity > 0 && maxSpawn > 0 && maxEmitters > 0);
+    assert((capacity + ParticleGroupSize - 1) / ParticleGroupSize <= D3D12_CS_DISPATCH_MAX_THREAD_GROUPS_PER_DIMENSION && "őp[eBN܂");
+    capacity_ = capacity;
+    maxSpawn_ = maxSpawn;
+    maxEmitters_ = maxEmitters;
+    pipelineCache_ = &pipelineCache;
+    auto* d3dDevice = device.get();
+
+    // V~[V: 萔 b0, Vp[eBN t0,  t1,  2 {Er{[hE u0`u3 ͑Să[gɒڒu
+    RootSignatureBuilder computeBuilder;
+    computeBuilder.addConstants(sizeof(SimulateConstants) / 4, 0)
+        .addSRV(0)
+        .addSRV(1)
+        .addUAV(0)
+        .addUAV(1)
+        .addUAV(2)
+        .addUAV(3)
+        .setFlags(D3D12_ROOT_SIGNATURE_FLAG_NONE);
+    computeRootSignature_ = rootSignatureCache.getOrCreate(device, computeBuilder);
+
+    // `: J b0, r{[h t0
+    RootSignatureBuilder drawBuilder;
+    drawBuilder.addConstants(sizeof(ParticleCamera) / 4, 0, 0, D3D12_SHADER_VISIBILITY_VERTEX).addSRV(0, 0, D3D12_SHADER_VISIBILITY_VERTEX);
+    drawRootSignature_ = rootSignatureCache.getOrCreate(device, drawBuilder);
+    if (!computeRootSignature_ || !drawRootSignature_) {
+        return false;
+    }
+
+    resetPipeline_ = createComputePipeline(d3dDevice, computeRootSignature_->get(), "resetCS");
+    simulatePipeline_ = createComputePipeline(d3dDevice, computeRootSignature_->get(), "simulateCS");
+    emitPipeline_ = createComputePipeline(d3dDevice, computeRootSignature_->get(), "emitCS");
+    argsPipeline_ = createComputePipeline(d3dDevice, computeRootSignature_->get(), "argsCS");
+    if (!resetPipeline_ || !simulatePipeline_ || !emitPipeline_ || !argsPipeline_) {
+        return false;
+    }
+
+    if (!drawShader_.create(device, L"asset/particle_draw.hlsl", {})) {
+        return false;
+    }
+    // _obt@͎g킸AZŐ[x̓eXg
+    PipelineStateDesc drawDesc = PiplineStateObject::defaultDesc();
+    drawDesc.inputLayout.clear();
+    drawDesc.blend = BlendMode::Additive;
+    drawDesc.cull = CullMode::None;
+    drawDesc.renderTargetFormats[0] = static_cast<uint32_t>(renderTargetFormat);
+    drawPipeline_ = pipelineCache.request(makeDepthPipelineDesc(drawDesc, depth, DepthPass::Color), drawShader_, *drawRootSignature_);
+
+    // R}h 1  = DrawInstanced ̈
+    D3D12_INDIRECT_ARGUMENT_DESC argument{};
+    argument.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
+
+    D3D12_COMMAND_SIGNATURE_DESC signatureDesc{};
+    signatureDesc.ByteStride = sizeof(D3D12_DRAW_ARGUMENTS);
+    signatureDesc.NumArgumentDescs = 1;
+    signatureDesc.pArgumentDescs = &argument;
+    // [gςȂ̂Ń[gVOl`͗vȂ
+    if (FAILED(d3dDevice->CreateCommandSignature(&signatureDesc, nullptr, IID_PPV_ARGS(&commandSignature_)))) {
+        assert(false && "R}hVOl`̍쐬Ɏs");
+        return false;
+    }
+
+    // ͍쐬 0iR~bgꂽ\[X 0 ŏj
+    const UINT64 stateSize = UINT64(sizeof(ParticleState)) * capacity;
+    const UINT64 instanceSize = UINT64(sizeof(ParticleInstance)) * capacity;
+    stateBuffers_[0] = createBuffer(d3dDevice, stateSize, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    stateBuffers_[1] = createBuffer(d3dDevice, stateSize, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    instanceBuffer_ = createBuffer(d3dDevice, instanceSize, D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    counterBuffer_ = createBuffer(d3dDevice, ArgumentOffset + sizeof(D3D12_DRAW_ARGUMENTS), D3D12_HEAP_TYPE_DEFAULT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+    spawnBuffer_ = createBuffer(d3dDevice, UINT64(sizeof(ParticleState)) * maxSpawn, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+    lookBuffer_ = createBuffer(d3dDevice, UINT64(sizeof(ParticleLook)) * maxEmitters, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+    uploadInstanceBuffer_ = createBuffer(d3dDevice, instanceSize, D3D12_HEAP_TYPE_UPLOAD, D3D12_RESOURCE_STATE_GENERIC_READ);
+    if (!stateBuffers_[0] || !stateBuffers_[1] || !instanceBuffer_ || !counterBuffer_ || !spawnBuffer_ || !lookBuffer_ || !uploadInstanceBuffer_) {
+        assert(false && "p[eBÑobt@쐬Ɏs");
+        return false;
+    }
+
+    D3D12_RANGE readRange{ 0, 0 };
+    if (FAILED(spawnBuffer_->Map(0, &readRange, reinterpret_cast<void**>(&mappedSpawn_))) ||
+        FAILED(lookBuffer_->Map(0, &readRange, reinterpret_cast<void**>(&mappedLooks_))) ||
+        FAILED(uploadInstanceBuffer_->Map(0, &readRange, reinterpret_cast<void**>(&mappedInstances_)))) {
+        return false;
+    }
+    sourceCounter_ = 0;
+    spawnOffset_ = 0;
+    source_ = Source::None;
+    gpuReadable_ = false;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Sĉ
+ */
+void ParticleRenderer::destroy() noexcept {
+    if (uploadInstanceBuffer_ && mappedInstances_) {
+        uploadInstanceBuffer_->Unmap(0, nullptr);
+        mappedInstances_ = nullptr;
+    }
+    if (lookBuffer_ && mappedLooks_) {
+        lookBuffer_->Unmap(0, nullptr);
+        mappedLooks_ = nullptr;
+    }
+    if (spawnBuffer_ && mappedSpawn_) {
+        spawnBuffer_->Unmap(0, nullptr);
+        mappedSpawn_ = nullptr;
+    }
+    safeRelease(uploadInstanceBuffer_);
+    safeRelease(lookBuffer_);
+    safeRelease(spawnBuffer_);
+    safeRelease(counterBuffer_);
+    safeRelease(instanceBuffer_);
+    safeRelease(stateBuffers_[1]);
+    safeRelease(stateBuffers_[0]);
+    safeRelease(commandSignature_);
+    safeRelease(argsPipeline_);
+    safeRelease(emitPipeline_);
+    safeRelease(simulatePipeline_);
+    safeRelease(resetPipeline_);
+    source_ = Source::None;
+    uploadCount_ = 0;
+    spawnOffset_ = 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t[n߂
+ */
+void ParticleRenderer::beginFrame() noexcept {
+    spawnOffset_ = 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GPU ł̃V~[ṼRs[gpXς
+ * @param	commandList	R}hXg
+ * @param	system		G~b^Ɨ
+ * @param	deltaTime	oߕb
+ */
+void ParticleRenderer::simulate(ID3D12GraphicsCommandList* commandList, ParticleSystem& system, float deltaTime) noexcept {
+    assert(mappedSpawn_ && "p[eBN`悪쐬ł");
+    const auto& looks = system.looks();
+    assert(looks.size() <= maxEmitters_ && "G~b^܂");
+
+    // Vp[eBN CPU ōiƒ[̌Jz CPU łƓj
+    // t[Őɐς񂾃pX܂ǂłȂ̂ŁǍɏ
+    const uint32_t spawnOffset = spawnOffset_;
+    const uint32_t spawnCount = system.spawn(deltaTime, mappedSpawn_ + spawnOffset, maxSpawn_ - spawnOffset);
+    spawnOffset_ += spawnCount;
+    std::memcpy(mappedLooks_, looks.data(), sizeof(ParticleLook) * std::min<size_t>(looks.size(), maxEmitters_));
+
+    // Õt[ŕ`悪ǂ񂾃obt@݉\ɖ߂
+    if (gpuReadable_) {
+        const D3D12_RESOURCE_BARRIER toUav[] = {
+            makeTransition(instanceBuffer_, InstanceReadState, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+            makeTransition(counterBuffer_, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT, D3D12_RESOURCE_STATE_UNORDERED_ACCESS),
+        };
+        commandList->ResourceBarrier(2, toUav);
+    }
+
+    const auto&             forces = system.forces();
+    const SimulateConstants constants{
+        { forces.gravity[0], forces.gravity[1], forces.gravity[2] },
+        forces.drag,
+        { forces.wind[0], forces.wind[1], forces.wind[2] },
+        deltaTime,
+        capacity_,
+        spawnCount,
+        sourceCounter_,
+    };
+    commandList->SetComputeRootSignature(computeRootSignature_->get());
+    commandList->SetComputeRoot32BitConstants(ComputeRootConstants, sizeof(SimulateConstants) / 4, &constants, 0);
+    commandList->SetComputeRootShaderResourceView(ComputeRootSpawned, spawnBuffer_->GetGPUVirtualAddress() + sizeof(ParticleState) * spawnOffset);
+    commandList->SetComputeRootShaderResourceView(ComputeRootLooks, lookBuffer_->GetGPUVirtualAddress());
+    commandList->SetComputeRootUnorderedAccessView(ComputeRootSource, stateBuffers_[sourceCounter_]->GetGPUVirtualAddress());
+    commandList->SetComputeRootUnorderedAccessView(ComputeRootDestination, stateBuffers_[sourceCounter_ ^ 1]->GetGPUVirtualAddress());
+    commandList->SetComputeRootUnorderedAccessView(ComputeRootInstances, instanceBuffer_->GetGPUVirtualAddress());
+    commandList->SetComputeRootUnorderedAccessView(ComputeRootCounters, counterBuffer_->GetGPUVirtualAddress());
+
+    // 4 iK̊Ԃ͑O̒iK݂̏悤 UAV oA
+    D3D12_RESOURCE_BARRIER uavBarrier{};
+    uavBarrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+
+    commandList->SetPipelineState(resetPipeline_);
+    commandList->Dispatch(1, 1, 1);
+    commandList->ResourceBarrier(1, &uavBarrier);
+
+    //  GPU ɂȂ̂ōő吔̃O[vNA𒴂Xbh͂I
+    commandList->SetPipelineState(simulatePipeline_);
+    commandList->Dispatch((capacity_ + ParticleGroupSize - 1) / ParticleGroupSize, 1, 1);
+    commandList->ResourceBarrier(1, &uavBarrier);
+
+    if (spawnCount) {
+        commandList->SetPipelineState(emitPipeline_);
+        commandList->Dispatch((spawnCount + ParticleGroupSize - 1) / ParticleGroupSize, 1, 1);
+        commandList->ResourceBarrier(1, &uavBarrier);
+    }
+
+    commandList->SetPipelineState(argsPipeline_);
+    commandList->Dispatch(1, 1, 1);
+
+    // r{[h͒_VF[_AԐڈ ExecuteIndirect ǂ߂Ԃɂ
+    const D3D12_RESOURCE_BARRIER toRead[] = {
+        makeTransition(instanceBuffer_, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, InstanceReadState),
+        makeTransition(counterBuffer_, D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT),
+    };
+    commandList->ResourceBarrier(2, toRead);
+    gpuReadable_ = true;
+    sourceCounter_ ^= 1;
+    source_ = Source::Gpu;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CPU ł̃V~[Vʂr{[hɂď
+ * @param	system		update ς݂̃p[eBNVXe
+ * @param	jobSystem	ɏꍇ̃WuVXe
+ */
+void ParticleRenderer::upload(const ParticleSystem& system, JobSystem* jobSystem) noexcept {
+    assert(mappedInstances_ && "p[eBN`悪쐬ł");
+    assert(system.size() <= capacity_ && "p[eBN܂");
+    uploadCount_ = system.writeInstances(mappedInstances_, jobSystem);
+    source_ = Source::Cpu;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	p[eBN`
+ * @param	commandList	R}hXg
+ * @param	camera		J
+ */
+void ParticleRenderer::draw(ID3D12GraphicsCommandList* commandList, const ParticleCamera& camera) noexcept {
+    // pCvC쐬͕̂`ȂiV~[V͐i߂j
+    ID3D12PipelineState* pipelineState = pipelineCache_->get(drawPipeline_);
+    if (!pipelineState || source_ == Source::None || (source_ == Source::Cpu && uploadCount_ == 0)) {
+        return;
+    }
+    const bool gpu = source_ == Source::Gpu;
+
+    commandList->SetGraphicsRootSignature(drawRootSignature_->get());
+    commandList->SetGraphicsRoot32BitConstants(DrawRootCamera, sizeof(ParticleCamera) / 4, &camera, 0);
+    commandList->SetGraphicsRootShaderResourceView(DrawRootInstances, (gpu ? instanceBuffer_ : uploadInstanceBuffer_)->GetGPUVirtualAddress());
+    commandList->SetPipelineState(pipelineState);
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+
+    // GPU ł̕`搔 GPU ԐڈgACPU ɓǂݖ߂Ȃ
+    if (gpu) {
+        commandList->ExecuteIndirect(commandSignature_, 1, counterBuffer_, ArgumentOffset, nullptr, 0);
+    }
+    else {
+        commandList->DrawInstanced(4, uploadCount_, 0, 0);
+    }
+}
@@ -0,0 +1,142 @@
+// p[eBN`NX
+
+#pragma once
+
+#include "device.h"
+#include "particle_system.h"
+#include "pipeline_state_cache.h"
+#include "root_signature_cache.h"
+#include "shader.h"
+#include <cstdint>
+#include <d3d12.h>
+
+class JobSystem;
+
+/// r{[h`̃[g萔iasset/particle_draw.hlsl  BillboardConstants Ɠсj
+struct ParticleCamera {
+    float viewProjection[4][4];  ///< r[ˉesiclip = M * pj
+    float right[4];              ///< J̉Eixyzj
+    float up[4];                 ///< J̏ixyzj
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	p[eBN`NX
+ * @details	GPU : simulate ŃRs[gVF[_ԃobt@ϕċl߁Ar{[hƕ`搔
+ *			`搔 CPU ɓǂݖ߂AExecuteIndirect ŊԐڈ`
+ *			CPU : upload  ParticleSystem::update ̌ʂr{[hɂď݁ACX^X`悷
+ *			ǂ_obt@g킸Ar{[h 1  1 CX^XƂĉZŕ`
+ */
+class ParticleRenderer final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    ParticleRenderer() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~ParticleRenderer();
+
+    // Rs[֎~
+    ParticleRenderer(const ParticleRenderer&) = delete;
+    ParticleRenderer& operator=(const ParticleRenderer&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	device				foCXNX̃CX^X
+     * @param	rootSignatureCache	[gVOl`LbV
+     * @param	pipelineCache		pCvCXe[gLbV
+     * @param	capacity			őp[eBN
+     * @param	maxSpawn			GPU ł 1 t[ɏoő吔
+     * @param	maxEmitters			őG~b^
+     * @param	renderTargetFormat	`ރ_[^[Qbǧ`
+     * @param	depth				[xobt@̎gi[x̓eXgďȂj
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache, uint32_t capacity,
+                              uint32_t maxSpawn, uint32_t maxEmitters, DXGI_FORMAT renderTargetFormat, const DepthSetup& depth = {}) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Sĉ
+     */
+    void destroy() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	t[n߂iÕt[ GPU IĂÃt[ simulate OɌĂԁj
+     * @details	Vp[eBN݈̏ʒu擪ɖ߂
+     */
+    void beginFrame() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GPU ł̃V~[ṼRs[gpXςށibeginFrame ̌ɌĂԁj
+     * @param	commandList	R}hXg
+     * @param	system		G~b^Ɨ́ispawn ŐVp[eBNoBCPU ł̔z͎gȂj
+     * @param	deltaTime	oߕb
+     * @details	1 t[ɉςł悢iŒ݂̍ƂɐςށjBVp[eBN͌ĂԂт
+     *			Abv[hobt@̑ɏ̂ŁAt[Ŝ maxSpawn 𒴂͏oȂ
+     */
+    void simulate(ID3D12GraphicsCommandList* commandList, ParticleSystem& system, float deltaTime) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	CPU ł̃V~[Vʂr{[hɂďށiÕt[ GPU IĂĂԁj
+     * @param	system		update ς݂̃p[eBNVXe
+     * @param	jobSystem	ɏꍇ̃WuVXe
+     */
+    void upload(const ParticleSystem& system, JobSystem* jobSystem = nullptr) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	p[eBN`iO simulate  upload ̌ʂ`j
+     * @param	commandList	R}hXgi_[^[QbgE[xobt@Er[|[g͐ݒς݂̂Ɓj
+     * @param	camera		J
+     * @details	`p̃pCvC쐬͉̂`Ȃ
+     */
+    void draw(ID3D12GraphicsCommandList* commandList, const ParticleCamera& camera) noexcept;
+
+private:
+    /// ǂ̌ʂ`
+    enum class Source : uint8_t {
+        None,  ///< ܂Ȃ
+        Gpu,   ///< simulate ̌
+        Cpu,   ///< upload ̌
+    };
+
+    Shader                     drawShader_{};             /// `pVF[_
+    const RootSignature*       drawRootSignature_{};      /// `p[gVOl`iLbVLj
+    const RootSignature*       computeRootSignature_{};   /// V~[Vp[gVOl`iLbVLj
+    PipelineStateCache*        pipelineCache_{};          /// pCvCXe[gLbV
+    PipelineStateCache::Handle drawPipeline_{};           /// `ppCvC
+    ID3D12PipelineState*       resetPipeline_{};          /// resetCS
+    ID3D12PipelineState*       simulatePipeline_{};       /// simulateCS
+    ID3D12PipelineState*       emitPipeline_{};           /// emitCS
+    ID3D12PipelineState*       argsPipeline_{};           /// argsCS
+    ID3D12CommandSignature*    commandSignature_{};       /// `悾̃R}hVOl`
+
+    ID3D12Resource*            stateBuffers_[2]{};        /// ԁit[ւj
+    ID3D12Resource*            instanceBuffer_{};         /// GPU ł̃r{[h
+    ID3D12Resource*            counterBuffer_{};          ///  2 ƊԐڈ
+    ID3D12Resource*            spawnBuffer_{};            /// Vp[eBNiAbv[hq[vj
+    ParticleState*             mappedSpawn_{};            /// spawnBuffer_  Map 
+    ID3D12Resource*            lookBuffer_{};             /// G~b^Ƃ̌ځiAbv[hq[vj
+    ParticleLook*              mappedLooks_{};            /// lookBuffer_  Map 
+    ID3D12Resource*            uploadInstanceBuffer_{};   /// CPU ł̃r{[hiAbv[hq[vj
+    ParticleInstance*          mappedInstances_{};        /// uploadInstanceBuffer_  Map 
+
+    uint32_t                   capacity_{};               /// őp[eBN
+    uint32_t                   maxSpawn_{};               /// 1 t[ɏoő吔
+    uint32_t                   maxEmitters_{};            /// őG~b^
+    uint32_t                   sourceCounter_{};          ///  simulate œǂݍ݌ɂԃobt@̔ԍ
+    uint32_t                   spawnOffset_{};            /// ̃t[ spawnBuffer_ ɏ
+    uint32_t                   uploadCount_{};            /// CPU ł̃r{[h
+    Source                     source_ = Source::None;    /// `
+    bool                       gpuReadable_{};            /// GPU ł̌ʂ`œǂ߂ԂȂ true
+};
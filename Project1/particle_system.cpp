@@ -0,0 +1,541 @@
+// p[eBNVXe
+
+#include "particle_system.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define PARTICLE_SYSTEM_SSE 1
+#include <immintrin.h>
+#endif
+#if defined(__AVX2__)
+#define PARTICLE_SYSTEM_AVX2 1
+#endif
+
+namespace {
+
+/// 1 `Ñp[eBNiSIMD ̔̕{j
+constexpr uint32_t ChunkSize = 4096;
+
+/// ϕɎgliSIMD łłlgj
+struct Integration {
+    float deltaTime;   ///< oߕb
+    float gravity[3];  ///< d͉x
+    float wind[3];     ///< CR񂹂鑬x
+    float drag;        ///< CR̋
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	xorshift32  [-1, 1) ̗
+ * @param	state	̏ԁiXVj
+ * @return	
+ */
+float randomSigned(uint32_t& state) noexcept {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return float(state >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[begin, end) ̂c鐔𐔂iXJ[j
+ */
+uint32_t countAliveScalar(const float* age, const float* lifetime, uint32_t begin, uint32_t end, float deltaTime) noexcept {
+    uint32_t count = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+        count += (age[i] + deltaTime < lifetime[i]) ? 1 : 0;
+    }
+    return count;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	1 ϕiSIMD łƓ]j
+ */
+inline void integrateAxis(float& position, float& velocity, float gravity, float wind, float drag, float deltaTime) noexcept {
+    const float acceleration = gravity + (wind - velocity) * drag;
+    velocity = velocity + acceleration * deltaTime;
+    position = position + velocity * deltaTime;
+}
+
+#if PARTICLE_SYSTEM_SSE
+//---------------------------------------------------------------------------------
+/**
+ * @brief	}XN̗Ă郌[̐𐔂
+ */
+inline uint32_t countLanes(uint32_t mask, uint32_t width) noexcept {
+    uint32_t count = 0;
+    for (uint32_t lane = 0; lane < width; ++lane) {
+        count += (mask >> lane) & 1;
+    }
+    return count;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[begin, end) ̂c鐔𐔂iSSE  4 j
+ */
+uint32_t countAliveSse(const float* age, const float* lifetime, uint32_t begin, uint32_t end, float deltaTime) noexcept {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    uint32_t     count = 0;
+    uint32_t     i = begin;
+    for (; i + 4 <= end; i += 4) {
+        const __m128 alive = _mm_cmplt_ps(_mm_add_ps(_mm_loadu_ps(age + i), dt), _mm_loadu_ps(lifetime + i));
+        count += countLanes(static_cast<uint32_t>(_mm_movemask_ps(alive)), 4);
+    }
+    return count + countAliveScalar(age, lifetime, i, end, deltaTime);
+}
+#endif
+
+#if PARTICLE_SYSTEM_AVX2
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[begin, end) ̂c鐔𐔂iAVX2  8 j
+ */
+uint32_t countAliveAvx2(const float* age, const float* lifetime, uint32_t begin, uint32_t end, float deltaTime) noexcept {
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    uint32_t     count = 0;
+    uint32_t     i = begin;
+    for (; i + 8 <= end; i += 8) {
+        const __m256 alive = _mm256_cmp_ps(_mm256_add_ps(_mm256_loadu_ps(age + i), dt), _mm256_loadu_ps(lifetime + i), _CMP_LT_OQ);
+        count += countLanes(static_cast<uint32_t>(_mm256_movemask_ps(alive)), 8);
+    }
+    return count + countAliveScalar(age, lifetime, i, end, deltaTime);
+}
+#endif
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	capacity	őp[eBN
+ * @return	 true
+ */
+[[nodiscard]] bool ParticleSystem::create(uint32_t capacity) {
+    if (capacity == 0) {
+        assert(false && "őp[eBN 0 ł");
+        return false;
+    }
+    capacity_ = capacity;
+    size_ = 0;
+    front_ = 0;
+    for (auto& pool : pools_) {
+        for (auto* values : { &pool.x, &pool.y, &pool.z, &pool.vx, &pool.vy, &pool.vz, &pool.age, &pool.lifetime }) {
+            values->assign(capacity, 0.0f);
+        }
+        pool.emitter.assign(capacity, 0);
+    }
+    chunkOffsets_.assign((capacity + ChunkSize - 1) / ChunkSize, 0);
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	G~b^ǉ
+ * @param	emitter	G~b^
+ * @return	G~b^ԍ
+ */
+uint32_t ParticleSystem::addEmitter(const ParticleEmitter& emitter) {
+    const uint32_t index = static_cast<uint32_t>(emitters_.size());
+    emitters_.push_back(emitter);
+    looks_.push_back(emitter.look);
+    spawnCarry_.push_back(0.0f);
+    // ̏Ԃ 0 ɂłȂ̂Ŕԍ
+    randomStates_.push_back(0x9e3779b9u * (index + 1));
+    return index;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	G~b^擾
+ * @param	index	G~b^ԍ
+ * @return	G~b^
+ */
+[[nodiscard]] ParticleEmitter& ParticleSystem::emitter(uint32_t index) noexcept {
+    assert(index < emitters_.size());
+    return emitters_[index];
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	͂ݒ肷
+ * @param	forces	
+ */
+void ParticleSystem::setForces(const ParticleForces& forces) noexcept {
+    forces_ = forces;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	͂擾
+ * @return	
+ */
+[[nodiscard]] const ParticleForces& ParticleSystem::forces() const noexcept {
+    return forces_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Ԃi߂
+ * @param	deltaTime	oߕb
+ * @param	jobSystem	ɏꍇ̃WuVXe
+ * @param	simd		g߃Zbg
+ */
+void ParticleSystem::update(float deltaTime, JobSystem* jobSystem, CullSimd simd) {
+    assert(capacity_ && "p[eBNVXe쐬ł");
+    simd = simd > bestCullSimd() ? bestCullSimd() : simd;
+    const Pool&    source = pools_[front_];
+    Pool&          destination = pools_[front_ ^ 1];
+    const uint32_t chunkCount = (size_ + ChunkSize - 1) / ChunkSize;
+    const Integration integration{
+        deltaTime,
+        { forces_.gravity[0], forces_.gravity[1], forces_.gravity[2] },
+        { forces_.wind[0], forces_.wind[1], forces_.wind[2] },
+        forces_.drag,
+    };
+
+    // 1. `NƂɐc鐔𐔂
+    const auto count = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t chunk = begin; chunk < end; ++chunk) {
+            const uint32_t first = chunk * ChunkSize;
+            const uint32_t last = std::min(first + ChunkSize, size_);
+            switch (simd) {
+#if PARTICLE_SYSTEM_AVX2
+            case CullSimd::Avx2:
+                chunkOffsets_[chunk] = countAliveAvx2(source.age.data(), source.lifetime.data(), first, last, deltaTime);
+                break;
+#endif
+#if PARTICLE_SYSTEM_SSE
+            case CullSimd::Sse:
+                chunkOffsets_[chunk] = countAliveSse(source.age.data(), source.lifetime.data(), first, last, deltaTime);
+                break;
+#endif
+            default:
+                chunkOffsets_[chunk] = countAliveScalar(source.age.data(), source.lifetime.data(), first, last, deltaTime);
+                break;
+            }
+        }
+    };
+
+    // 3. ϕāAĉ𗠂̔z̃`N̊Jnʒu珇ɏ
+    const auto integrate = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t chunk = begin; chunk < end; ++chunk) {
+            const uint32_t first = chunk * ChunkSize;
+            const uint32_t last = std::min(first + ChunkSize, size_);
+            uint32_t       out = chunkOffsets_[chunk];
+
+            // ĉ𗠂̔zɏ
+            const auto write = [&](uint32_t i, float x, float y, float z, float vx, float vy, float vz, float age) {
+                destination.x[out] = x;
+                destination.y[out] = y;
+                destination.z[out] = z;
+                destination.vx[out] = vx;
+                destination.vy[out] = vy;
+                destination.vz[out] = vz;
+                destination.age[out] = age;
+                destination.lifetime[out] = source.lifetime[i];
+                destination.emitter[out] = source.emitter[i];
+                ++out;
+            };
+
+            uint32_t i = first;
+#if PARTICLE_SYSTEM_AVX2
+            if (simd == CullSimd::Avx2) {
+                const __m256 dt = _mm256_set1_ps(integration.deltaTime);
+                const __m256 drag = _mm256_set1_ps(integration.drag);
+                const __m256 gravity[3] = { _mm256_set1_ps(integration.gravity[0]), _mm256_set1_ps(integration.gravity[1]),
+                                            _mm256_set1_ps(integration.gravity[2]) };
+                const __m256 wind[3] = { _mm256_set1_ps(integration.wind[0]), _mm256_set1_ps(integration.wind[1]),
+                                         _mm256_set1_ps(integration.wind[2]) };
+                const float* positions[3] = { source.x.data(), source.y.data(), source.z.data() };
+                const float* velocities[3] = { source.vx.data(), source.vy.data(), source.vz.data() };
+                alignas(32) float p[3][8];
+                alignas(32) float v[3][8];
+                alignas(32) float a[8];
+                for (; i + 8 <= last; i += 8) {
+                    // FMA ͎gȂiXJ[łƊۂ߂𑵂j
+                    for (int axis = 0; axis < 3; ++axis) {
+                        __m256       velocity = _mm256_loadu_ps(velocities[axis] + i);
+                        const __m256 acceleration = _mm256_add_ps(gravity[axis], _mm256_mul_ps(_mm256_sub_ps(wind[axis], velocity), drag));
+                        velocity = _mm256_add_ps(velocity, _mm256_mul_ps(acceleration, dt));
+                        _mm256_store_ps(v[axis], velocity);
+                        _mm256_store_ps(p[axis], _mm256_add_ps(_mm256_loadu_ps(positions[axis] + i), _mm256_mul_ps(velocity, dt)));
+                    }
+                    const __m256 age = _mm256_add_ps(_mm256_loadu_ps(source.age.data() + i), dt);
+                    _mm256_store_ps(a, age);
+                    const uint32_t alive =
+                        static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(age, _mm256_loadu_ps(source.lifetime.data() + i), _CMP_LT_OQ)));
+                    if (alive == 0xFF) {
+                        // S[ciقƂǂ̏ꍇjȂ܂Ƃ߂ď
+                        float* const destinations[7] = { destination.x.data(), destination.y.data(), destination.z.data(), destination.vx.data(),
+                                                         destination.vy.data(), destination.vz.data(), destination.age.data() };
+                        const float* const values[7] = { p[0], p[1], p[2], v[0], v[1], v[2], a };
+                        for (int k = 0; k < 7; ++k) {
+                            _mm256_storeu_ps(destinations[k] + out, _mm256_loadu_ps(values[k]));
+                        }
+                        _mm256_storeu_ps(destination.lifetime.data() + out, _mm256_loadu_ps(source.lifetime.data() + i));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination.emitter.data() + out),
+                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source.emitter.data() + i)));
+                        out += 8;
+                        continue;
+                    }
+                    for (uint32_t lane = 0; lane < 8; ++lane) {
+                        if ((alive >> lane) & 1) {
+                            write(i + lane, p[0][lane], p[1][lane], p[2][lane], v[0][lane], v[1][lane], v[2][lane], a[lane]);
+                        }
+                    }
+                }
+            }
+#endif
+#if PARTICLE_SYSTEM_SSE
+            if (simd != CullSimd::Scalar) {
+                const __m128 dt = _mm_set1_ps(integration.deltaTime);
+                const __m128 drag = _mm_set1_ps(integration.drag);
+                const __m128 gravity[3] = { _mm_set1_ps(integration.gravity[0]), _mm_set1_ps(integration.gravity[1]),
+                                            _mm_set1_ps(integration.gravity[2]) };
+                const __m128 wind[3] = { _mm_set1_ps(integration.wind[0]), _mm_set1_ps(integration.wind[1]), _mm_set1_ps(integration.wind[2]) };
+                const float* positions[3] = { source.x.data(), source.y.data(), source.z.data() };
+                const float* velocities[3] = { source.vx.data(), source.vy.data(), source.vz.data() };
+                alignas(16) float p[3][4];
+                alignas(16) float v[3][4];
+                alignas(16) float a[4];
+                for (; i + 4 <= last; i += 4) {
+                    for (int axis = 0; axis < 3; ++axis) {
+                        __m128       velocity = _mm_loadu_ps(velocities[axis] + i);
+                        const __m128 acceleration = _mm_add_ps(gravity[axis], _mm_mul_ps(_mm_sub_ps(wind[axis], velocity), drag));
+                        velocity = _mm_add_ps(velocity, _mm_mul_ps(acceleration, dt));
+                        _mm_store_ps(v[axis], velocity);
+                        _mm_store_ps(p[axis], _mm_add_ps(_mm_loadu_ps(positions[axis] + i), _mm_mul_ps(velocity, dt)));
+                    }
+                    const __m128 age = _mm_add_ps(_mm_loadu_ps(source.age.data() + i), dt);
+                    _mm_store_ps(a, age);
+                    const uint32_t alive = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmplt_ps(age, _mm_loadu_ps(source.lifetime.data() + i))));
+                    if (alive == 0xF) {
+                        // S[ciقƂǂ̏ꍇjȂ܂Ƃ߂ď
+                        float* const destinations[7] = { destination.x.data(), destination.y.data(), destination.z.data(), destination.vx.data(),
+                                                         destination.vy.data(), destination.vz.data(), destination.age.data() };
+                        const float* const values[7] = { p[0], p[1], p[2], v[0], v[1], v[2], a };
+                        for (int k = 0; k < 7; ++k) {
+                            _mm_storeu_ps(destinations[k] + out, _mm_loadu_ps(values[k]));
+                        }
+                        _mm_storeu_ps(destination.lifetime.data() + out, _mm_loadu_ps(source.lifetime.data() + i));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination.emitter.data() + out),
+                                _mm_loadu_si128(reinterpret_cast<const __m128i*>(source.emitter.data() + i)));
+                        out += 4;
+                        continue;
+                    }
+                    for (uint32_t lane = 0; lane < 4; ++lane) {
+                        if ((alive >> lane) & 1) {
+                            write(i + lane, p[0][lane], p[1][lane], p[2][lane], v[0][lane], v[1][lane], v[2][lane], a[lane]);
+                        }
+                    }
+                }
+            }
+#endif
+            for (; i < last; ++i) {
+                float x = source.x[i], y = source.y[i], z = source.z[i];
+                float vx = source.vx[i], vy = source.vy[i], vz = source.vz[i];
+                integrateAxis(x, vx, integration.gravity[0], integration.wind[0], integration.drag, integration.deltaTime);
+                integrateAxis(y, vy, integration.gravity[1], integration.wind[1], integration.drag, integration.deltaTime);
+                integrateAxis(z, vz, integration.gravity[2], integration.wind[2], integration.drag, integration.deltaTime);
+                const float age = source.age[i] + integration.deltaTime;
+                if (age < source.lifetime[i]) {
+                    write(i, x, y, z, vx, vy, vz, age);
+                }
+            }
+        }
+    };
+
+    if (jobSystem) {
+        jobSystem->parallelFor(chunkCount, 1, count);
+    }
+    else {
+        count(0, chunkCount);
+    }
+
+    // 2. `N̊Jnʒu̗ݐ
+    uint32_t alive = 0;
+    for (uint32_t chunk = 0; chunk < chunkCount; ++chunk) {
+        const uint32_t chunkAlive = chunkOffsets_[chunk];
+        chunkOffsets_[chunk] = alive;
+        alive += chunkAlive;
+    }
+
+    if (jobSystem) {
+        jobSystem->parallelFor(chunkCount, 1, integrate);
+    }
+    else {
+        integrate(0, chunkCount);
+    }
+    front_ ^= 1;
+    size_ = alive;
+
+    // Vp[eBN͖ɑispawn Ɠ菇ŏoj
+    Pool&          pool = pools_[front_];
+    const uint32_t room = capacity_ - size_;
+    for (uint32_t e = 0; e < emitters_.size(); ++e) {
+        looks_[e] = emitters_[e].look;
+    }
+    uint32_t written = 0;
+    for (uint32_t e = 0; e < emitters_.size() && written < room; ++e) {
+        const uint32_t count = takeSpawnCount(e, deltaTime);
+        for (uint32_t k = 0; k < count && written < room; ++k) {
+            const ParticleState state = makeParticle(e);
+            const uint32_t      index = size_ + written++;
+            pool.x[index] = state.position[0];
+            pool.y[index] = state.position[1];
+            pool.z[index] = state.position[2];
+            pool.vx[index] = state.velocity[0];
+            pool.vy[index] = state.velocity[1];
+            pool.vz[index] = state.velocity[2];
+            pool.age[index] = state.age;
+            pool.lifetime[index] = state.lifetime;
+            pool.emitter[index] = state.emitter;
+        }
+    }
+    size_ += written;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	G~b^Vp[eBNo
+ * @param	deltaTime	oߕb
+ * @param	out			ݐ
+ * @param	maxCount	߂ő吔
+ * @return	񂾐
+ */
+uint32_t ParticleSystem::spawn(float deltaTime, ParticleState* out, uint32_t maxCount) noexcept {
+    for (uint32_t e = 0; e < emitters_.size(); ++e) {
+        looks_[e] = emitters_[e].look;
+    }
+    uint32_t written = 0;
+    for (uint32_t e = 0; e < emitters_.size() && written < maxCount; ++e) {
+        const uint32_t count = takeSpawnCount(e, deltaTime);
+        for (uint32_t k = 0; k < count && written < maxCount; ++k) {
+            out[written++] = makeParticle(e);
+        }
+    }
+    return written;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`悷r{[h
+ * @param	out			ݐ
+ * @param	jobSystem	ɏꍇ̃WuVXe
+ * @return	񂾐
+ */
+uint32_t ParticleSystem::writeInstances(ParticleInstance* out, JobSystem* jobSystem) const {
+    const Pool&    pool = pools_[front_];
+    const uint32_t chunkCount = (size_ + ChunkSize - 1) / ChunkSize;
+    const auto     write = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin * ChunkSize; i < std::min(end * ChunkSize, size_); ++i) {
+            const auto& look = looks_[pool.emitter[i]];
+            const float t = pool.age[i] / pool.lifetime[i];
+            auto&       instance = out[i];
+            instance.position[0] = pool.x[i];
+            instance.position[1] = pool.y[i];
+            instance.position[2] = pool.z[i];
+            instance.size = look.startSize + (look.endSize - look.startSize) * t;
+            for (int c = 0; c < 4; ++c) {
+                instance.color[c] = look.startColor[c] + (look.endColor[c] - look.startColor[c]) * t;
+            }
+        }
+    };
+    if (jobSystem) {
+        jobSystem->parallelFor(chunkCount, 1, write);
+    }
+    else {
+        write(0, chunkCount);
+    }
+    return size_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	G~b^Ƃ̌ڂ擾
+ * @return	G~b^ԍ̌
+ */
+[[nodiscard]] const std::vector<ParticleLook>& ParticleSystem::looks() const noexcept {
+    return looks_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Ăp[eBN擾
+ * @return	p[eBN
+ */
+[[nodiscard]] uint32_t ParticleSystem::size() const noexcept {
+    return size_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	őp[eBN擾
+ * @return	p[eBN
+ */
+[[nodiscard]] uint32_t ParticleSystem::capacity() const noexcept {
+    return capacity_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	p[eBN 1 ̏Ԃ擾
+ * @param	index	ԍ
+ * @return	
+ */
+[[nodiscard]] ParticleState ParticleSystem::particle(uint32_t index) const noexcept {
+    assert(index < size_);
+    const Pool&   pool = pools_[front_];
+    ParticleState state{};
+    state.position[0] = pool.x[index];
+    state.position[1] = pool.y[index];
+    state.position[2] = pool.z[index];
+    state.velocity[0] = pool.vx[index];
+    state.velocity[1] = pool.vy[index];
+    state.velocity[2] = pool.vz[index];
+    state.age = pool.age[index];
+    state.lifetime = pool.lifetime[index];
+    state.emitter = pool.emitter[index];
+    return state;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	G~b^̃t[ɏo߂i[͌Jzj
+ * @param	emitter		G~b^ԍ
+ * @param	deltaTime	oߕb
+ * @return	o
+ */
+uint32_t ParticleSystem::takeSpawnCount(uint32_t emitter, float deltaTime) noexcept {
+    spawnCarry_[emitter] += emitters_[emitter].rate * deltaTime;
+    const uint32_t count = static_cast<uint32_t>(spawnCarry_[emitter]);
+    spawnCarry_[emitter] -= float(count);
+    return count;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	G~b^Vp[eBN 1 
+ * @param	emitter	G~b^ԍ
+ * @return	
+ */
+ParticleState ParticleSystem::makeParticle(uint32_t emitter) noexcept {
+    const auto&   source = emitters_[emitter];
+    auto&         random = randomStates_[emitter];
+    ParticleState state{};
+    for (int axis = 0; axis < 3; ++axis) {
+        state.position[axis] = source.position[axis] + randomSigned(random) * source.positionJitter;
+        state.velocity[axis] = source.velocity[axis] + randomSigned(random) * source.velocityJitter;
+    }
+    const float unit = randomSigned(random) * 0.5f + 0.5f;
+    state.age = 0.0f;
+    state.lifetime = source.minLifetime + (source.maxLifetime - source.minLifetime) * unit;
+    state.emitter = emitter;
+    return state;
+}
@@ -0,0 +1,204 @@
+// p[eBNVXe
+
+#pragma once
+
+#include "frustum_culling.h"
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+/// V~[ṼXbhO[v̑傫iasset/particles.hlsl  numthreads Ɠj
+inline constexpr uint32_t ParticleGroupSize = 64;
+
+/// p[eBN 1 ̏ԁiGPU ł̏ԃobt@ƁACPU ŐēnVp[eBN̕сj
+struct ParticleState {
+    float    position[3];  ///< ʒu
+    float    age;          ///< ܂Ă̕b
+    float    velocity[3];  ///< x
+    float    lifetime;     ///< ibj
+    uint32_t emitter;      ///< G~b^ԍiڂj
+    uint32_t reserved[3];  ///< 16 oCgEɑ邽߂̗\
+};
+static_assert(sizeof(ParticleState) == 48, "HLSL  ParticleState ƂĂ܂");
+
+/// G~b^Ƃ̌ځiɉĎn߂I֕ԂBHLSL  ParticleLook Ɠсj
+struct ParticleLook {
+    float startColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };  ///< ܂ꂽ̐F
+    float endColor[4] = { 1.0f, 1.0f, 1.0f, 0.0f };    ///< s鎞̐F
+    float startSize = 0.05f;                           ///< ܂ꂽ̑傫
+    float endSize = 0.05f;                             ///< s鎞̑傫
+    float reserved[2]{};                               ///< 16 oCgEɑ邽߂̗\
+};
+static_assert(sizeof(ParticleLook) == 48, "HLSL  ParticleLook ƂĂ܂");
+
+/// `悷r{[h 1 iHLSL  ParticleInstance Ɠсj
+struct ParticleInstance {
+    float position[3];  ///< S
+    float size;         ///< ӂ̔
+    float color[4];     ///< F
+};
+static_assert(sizeof(ParticleInstance) == 32, "HLSL  ParticleInstance ƂĂ܂");
+
+/// G~b^
+struct ParticleEmitter {
+    float        position[3]{};                       ///< ʒu
+    float        positionJitter = 0.0f;               ///< ʒû΂ie }j
+    float        velocity[3]{};                       ///< 
+    float        velocityJitter = 0.0f;               ///< ̂΂ie }j
+    float        rate = 100.0f;                       ///< 1 bɏo
+    float        minLifetime = 1.0f;                  ///< ̍ŏ
+    float        maxLifetime = 1.0f;                  ///< ̍ő
+    ParticleLook look{};                              ///< 
+};
+
+/// Sp[eBNɊ|́ix = gravity + (wind - velocity) * dragj
+struct ParticleForces {
+    float gravity[3] = { 0.0f, -9.8f, 0.0f };  ///< d͉x
+    float drag = 0.0f;                         ///< CR̋i1/bj
+    float wind[3]{};                           ///< CR񂹂鑬x
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	p[eBNVXeiCPU ł̃V~[Vj
+ * @details	p[eBN͐Ƃ̔ziSoAjɋl߂ĎASIMD ł܂Ƃ߂Đϕ
+ *			`NPʂŁuc鐔𐔂  `N̊Jnʒu̗ݐ  ϕċl߂v 3 iKŏA
+ *			񂾃p[eBNė̔zɏԂۂďA\Ɠւ
+ *			ʂ͖߃Zbgƕ񐔂ɂ炸rbgPʂňvBz create ŊmۂAt[̊mۂ͋NȂ
+ */
+class ParticleSystem final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	capacity	őp[eBN
+     * @return	 true
+     */
+    [[nodiscard]] bool create(uint32_t capacity);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	G~b^ǉ
+     * @param	emitter	G~b^
+     * @return	G~b^ԍ
+     */
+    uint32_t addEmitter(const ParticleEmitter& emitter);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	G~b^擾iʒuoςĂ悢j
+     * @param	index	G~b^ԍ
+     * @return	G~b^
+     */
+    [[nodiscard]] ParticleEmitter& emitter(uint32_t index) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	͂ݒ肷
+     * @param	forces	
+     */
+    void setForces(const ParticleForces& forces) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	͂擾
+     * @return	
+     */
+    [[nodiscard]] const ParticleForces& forces() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Ԃi߂iϕĎ񂾂̂AG~b^Voj
+     * @param	deltaTime	oߕb
+     * @param	jobSystem	ɏꍇ̃WuVXeinullptr ȂĂяoXbhŏj
+     * @param	simd		g߃ZbgĩrhŎgȂ̂ bestCullSimd() ɗƂj
+     */
+    void update(float deltaTime, JobSystem* jobSystem = nullptr, CullSimd simd = bestCullSimd());
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	G~b^Vp[eBNoiGPU łɓnj
+     * @param	deltaTime	oߕb
+     * @param	out			ݐ
+     * @param	maxCount	߂ő吔î͎Ăj
+     * @return	񂾐
+     * @details	CPU ł̔zɂ͒ǉȂBupdate Ɠƒ[̌Jzg
+     */
+    uint32_t spawn(float deltaTime, ParticleState* out, uint32_t maxCount) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	`悷r{[h
+     * @param	out			ݐisize() j
+     * @param	jobSystem	ɏꍇ̃WuVXe
+     * @return	񂾐
+     */
+    uint32_t writeInstances(ParticleInstance* out, JobSystem* jobSystem = nullptr) const;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	G~b^Ƃ̌ڂ擾iGPU łɓnj
+     * @return	G~b^ԍ̌
+     */
+    [[nodiscard]] const std::vector<ParticleLook>& looks() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Ăp[eBN擾
+     * @return	p[eBN
+     */
+    [[nodiscard]] uint32_t size() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	őp[eBN擾
+     * @return	p[eBN
+     */
+    [[nodiscard]] uint32_t capacity() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	p[eBN 1 ̏Ԃ擾
+     * @param	index	ԍi0 ` size() - 1j
+     * @return	
+     */
+    [[nodiscard]] ParticleState particle(uint32_t index) const noexcept;
+
+private:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	G~b^̃t[ɏo߂i[͌Jzj
+     */
+    uint32_t takeSpawnCount(uint32_t emitter, float deltaTime) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	G~b^Vp[eBN 1 
+     */
+    ParticleState makeParticle(uint32_t emitter) noexcept;
+
+    /// SoA ̃p[eBNz
+    struct Pool {
+        std::vector<float>    x;         ///< ʒu X
+        std::vector<float>    y;         ///< ʒu Y
+        std::vector<float>    z;         ///< ʒu Z
+        std::vector<float>    vx;        ///< x X
+        std::vector<float>    vy;        ///< x Y
+        std::vector<float>    vz;        ///< x Z
+        std::vector<float>    age;       ///< ܂Ă̕b
+        std::vector<float>    lifetime;  ///< 
+        std::vector<uint32_t> emitter;   ///< G~b^ԍ
+    };
+
+    ParticleForces               forces_{};         /// 
+    std::vector<ParticleEmitter> emitters_{};       /// G~b^
+    std::vector<ParticleLook>    looks_{};          /// G~b^Ƃ̌
+    std::vector<float>           spawnCarry_{};     /// G~b^Ƃ̏oȂ[
+    std::vector<uint32_t>        randomStates_{};   /// G~b^Ƃ̗̏
+    Pool                         pools_[2]{};       /// \Ɨ̔z
+    uint32_t                     front_{};          /// \̔z̔ԍ
+    std::vector<uint32_t>        chunkOffsets_{};   /// `NƂ̐c鐔Jnʒu
+    uint32_t                     size_{};           /// Ăp[eBN
+    uint32_t                     capacity_{};       /// őp[eBN
+};
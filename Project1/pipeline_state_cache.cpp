@@ -0,0 +1,264 @@
+// pCvCXe[gLbVNX
+
+#include "pipeline_state_cache.h"
+#include "pipline_state_object.h"
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+
+namespace {
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	nh烉Cu̖O
+ * @param	handle	nh
+ * @return	O
+ */
+std::wstring makePipelineName(uint64_t handle) {
+    wchar_t buffer[32]{};
+    std::swprintf(buffer, 32, L"pso_%016llx", static_cast<unsigned long long>(handle));
+    return buffer;
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+PipelineStateCache::~PipelineStateCache() {
+    destroy();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	LbV쐬
+ * @param	device		foCXNX̃CX^X
+ * @param	jobSystem	񓯊쐬ɎgWuVXe
+ * @param	libraryPath	pCvCCu̕ۑ
+ * @return	 true
+ */
+[[nodiscard]] bool PipelineStateCache::create(const Device& device, JobSystem& jobSystem, std::wstring libraryPath) noexcept {
+    device_ = device.get();
+    jobSystem_ = &jobSystem;
+    libraryPath_ = std::move(libraryPath);
+
+    // pCvCCu ID3D12Device1 g
+    if (FAILED(device_->QueryInterface(IID_PPV_ARGS(&device1_)))) {
+        return true;
+    }
+
+    // O̕ۑeǂ
+    std::ifstream file(libraryPath_, std::ios::binary | std::ios::ate);
+    if (file) {
+        libraryBlob_.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(libraryBlob_.data(), static_cast<std::streamsize>(libraryBlob_.size()));
+    }
+
+    if (!libraryBlob_.empty()) {
+        // hCoXVȂǂŎgȂȂĂꍇ͍蒼
+        const auto res = device1_->CreatePipelineLibrary(libraryBlob_.data(), libraryBlob_.size(), IID_PPV_ARGS(&library_));
+        if (FAILED(res)) {
+            library_ = nullptr;
+            libraryBlob_.clear();
+        }
+    }
+    if (!library_) {
+        if (FAILED(device1_->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&library_)))) {
+            // CuΉ̃hCoBLbV̓ゾœ
+            library_ = nullptr;
+        }
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬҂Sđ҂Ă烉CuۑASĉ
+ */
+void PipelineStateCache::destroy() noexcept {
+    waitIdle();
+
+    if (library_) {
+        [[maybe_unused]] const bool saved = save();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(entriesMutex_);
+        for (auto& [handle, entry] : entries_) {
+            if (auto* pipelineState = entry->pipelineState.exchange(nullptr)) {
+                pipelineState->Release();
+            }
+        }
+        entries_.clear();
+    }
+
+    if (library_) {
+        library_->Release();
+        library_ = nullptr;
+    }
+    libraryBlob_.clear();
+
+    if (device1_) {
+        device1_->Release();
+        device1_ = nullptr;
+    }
+    device_ = nullptr;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvC̍쐬v
+ * @param	desc			pCvCXe[gLq
+ * @param	shader			VF[_NX̃CX^X
+ * @param	rootSignature	[gVOl`NX̃CX^X
+ * @return	nh
+ */
+[[nodiscard]] PipelineStateCache::Handle PipelineStateCache::request(const PipelineStateDesc& desc, const Shader& shader, const RootSignature& rootSignature) noexcept {
+    assert(device_ && "pCvCXe[gLbV쐬ł");
+
+    // VF[_ƃ[gVOl`͒gŎʂi|C^͎sƂɕς̂ŎgȂj
+    auto normalized = normalizePipelineStateDesc(desc);
+    normalized.vertexShaderHash = hashBytes(shader.vertexShader()->GetBufferPointer(), shader.vertexShader()->GetBufferSize());
+    // [xvpX̓sNZVF[_gȂ̂ŁA_VF[_Ȃ狤L
+    normalized.pixelShaderHash = normalized.depthOnly ? 0 : hashBytes(shader.pixelShader()->GetBufferPointer(), shader.pixelShader()->GetBufferSize());
+    normalized.rootSignatureHash = rootSignature.hash();
+    Handle handle = hashPipelineStateDesc(normalized);
+
+    Entry* entry = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(entriesMutex_);
+        for (;; ++handle) {
+            auto& slot = entries_[handle];
+            if (!slot) {
+                slot = std::make_unique<Entry>();
+                slot->desc = std::move(normalized);
+                entry = slot.get();
+                break;
+            }
+            if (slot->desc == normalized) {
+                // e͍쐬ς݂쐬
+                return handle;
+            }
+            // nbVՓ˂ʂ̋LqB̒lT
+        }
+    }
+
+    ++pending_;
+    jobSystem_->submit([this, entry, handle, &shader, &rootSignature] {
+        // entry  destroy ܂ŏAdesc ͍쐬ɏȂ
+        build(*entry, handle, entry->desc, shader, rootSignature);
+        --pending_;
+    });
+
+    return handle;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvCXe[g擾
+ * @param	handle		request œnh
+ * @param	fallback	쐬̏ꍇɑɕԂpCvC
+ * @return	Ă΂̃pCvCA쐬Ȃ fallback
+ */
+[[nodiscard]] ID3D12PipelineState* PipelineStateCache::get(Handle handle, ID3D12PipelineState* fallback) const noexcept {
+    std::lock_guard<std::mutex> lock(entriesMutex_);
+    const auto it = entries_.find(handle);
+    if (it == entries_.end()) {
+        assert(false && "request ĂȂnhł");
+        return fallback;
+    }
+
+    auto* pipelineState = it->second->pipelineState.load(std::memory_order_acquire);
+    return pipelineState ? pipelineState : fallback;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬҂̃pCvCȂ܂ő҂
+ */
+void PipelineStateCache::waitIdle() const noexcept {
+    while (pending_.load() != 0) {
+        std::this_thread::yield();
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvCCut@Cɕۑ
+ * @return	 true
+ */
+[[nodiscard]] bool PipelineStateCache::save() noexcept {
+    std::lock_guard<std::mutex> lock(libraryMutex_);
+    if (!library_ || !libraryDirty_) {
+        return true;
+    }
+
+    std::vector<char> data(library_->GetSerializedSize());
+    if (FAILED(library_->Serialize(data.data(), data.size()))) {
+        assert(false && "pCvCCũVACYɎs");
+        return false;
+    }
+
+    std::ofstream file(libraryPath_, std::ios::binary | std::ios::trunc);
+    if (!file.write(data.data(), static_cast<std::streamsize>(data.size()))) {
+        return false;
+    }
+
+    libraryDirty_ = false;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬҂̐擾
+ * @return	쐬҂̐
+ */
+[[nodiscard]] uint32_t PipelineStateCache::pendingCount() const noexcept {
+    return pending_.load();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvC쐬i[J[XbhŌĂ΂j
+ * @param	entry			ʂ̊i[
+ * @param	handle			nh
+ * @param	desc			pCvCXe[gLq
+ * @param	shader			VF[_NX̃CX^X
+ * @param	rootSignature	[gVOl`NX̃CX^X
+ */
+void PipelineStateCache::build(Entry& entry, Handle handle, const PipelineStateDesc& desc, const Shader& shader, const RootSignature& rootSignature) noexcept {
+    std::vector<D3D12_INPUT_ELEMENT_DESC> inputElements;
+    const auto psoDesc = PiplineStateObject::toD3D12Desc(desc, shader, rootSignature, inputElements);
+    const auto name = makePipelineName(handle);
+
+    ID3D12PipelineState* pipelineState = nullptr;
+
+    // ۑς݂ȂhCõRpCȗł
+    if (library_) {
+        std::lock_guard<std::mutex> lock(libraryMutex_);
+        if (FAILED(library_->LoadGraphicsPipeline(name.c_str(), &psoDesc, IID_PPV_ARGS(&pipelineState)))) {
+            pipelineState = nullptr;
+        }
+    }
+
+    if (!pipelineState) {
+        // RpC͏d̂ŃbN̊Oōs
+        if (FAILED(device_->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&pipelineState)))) {
+            assert(false && "pCvCXe[g̍쐬Ɏs");
+            return;
+        }
+
+        if (library_) {
+            std::lock_guard<std::mutex> lock(libraryMutex_);
+            if (SUCCEEDED(library_->StorePipeline(name.c_str(), pipelineState))) {
+                libraryDirty_ = true;
+            }
+        }
+    }
+
+    entry.pipelineState.store(pipelineState, std::memory_order_release);
+}
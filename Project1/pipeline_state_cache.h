@@ -0,0 +1,133 @@
+// pCvCXe[gLbVNX
+
+#pragma once
+
+#include "device.h"
+#include "job_system.h"
+#include "pipeline_state_desc.h"
+#include "root_signature.h"
+#include "shader.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvCXe[gLbVNX
+ * @details	KLq̃nbVŃpCvCdȂǗ
+ *			nbVՓ˂ꍇ͋Lqׂ̂̂ČAʂ̃nh蓖Ă
+ *			쐬̓WuVXeŔ񓯊ɍsA܂ł͌ĂяõtH[obNԂ
+ *			Ăяo͍쐬҂Aget  nullptr ̊Ԃ͂̕`ȂA쐬pCvCnđɎg
+ *			hCõRpCʂ ID3D12PipelineLibrary Ńt@CɕۑANɍėp
+ */
+class PipelineStateCache final {
+public:
+    /// pCvC̃nhiKLq̃nbVBՓ˂ꍇ͂̎̋󂢂Ălj
+    using Handle = uint64_t;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    PipelineStateCache() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~PipelineStateCache();
+
+    // Rs[֎~
+    PipelineStateCache(const PipelineStateCache&) = delete;
+    PipelineStateCache& operator=(const PipelineStateCache&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	LbV쐬
+     * @param	device		foCXNX̃CX^X
+     * @param	jobSystem	񓯊쐬ɎgWuVXe
+     * @param	libraryPath	pCvCCu̕ۑ
+     * @return	 trueiCugȂł̃LbVƂĂ͓j
+     */
+    [[nodiscard]] bool create(const Device& device, JobSystem& jobSystem, std::wstring libraryPath) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬҂Sđ҂Ă烉CuۑASĉ
+     */
+    void destroy() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	pCvC̍쐬v
+     * @param	desc			pCvCXe[gLqiVF[_ƃ[gVOl`̃nbV͂Ŗ߂j
+     * @param	shader			VF[_NX̃CX^X
+     * @param	rootSignature	[gVOl`NX̃CX^X
+     * @return	nhBe̗vɂ͓nhԂA쐬 1 xs
+     * @details	shader  rootSignature ͍쐬I܂ŔjȂ
+     */
+    [[nodiscard]] Handle request(const PipelineStateDesc& desc, const Shader& shader, const RootSignature& rootSignature) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	pCvCXe[g擾
+     * @param	handle		request œnh
+     * @param	fallback	쐬̏ꍇɑɕԂpCvC
+     * @return	Ă΂̃pCvCA쐬Ȃ fallback
+     */
+    [[nodiscard]] ID3D12PipelineState* get(Handle handle, ID3D12PipelineState* fallback = nullptr) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬҂̃pCvCȂ܂ő҂
+     */
+    void waitIdle() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	pCvCCut@Cɕۑ
+     * @return	 trueiۑeꍇ truej
+     */
+    [[nodiscard]] bool save() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬҂̐擾
+     * @return	쐬҂̐
+     */
+    [[nodiscard]] uint32_t pendingCount() const noexcept;
+
+private:
+    /// LbV̗vf
+    struct Entry {
+        PipelineStateDesc                 desc{};           /// KLqinbV̏Փ˂j
+        std::atomic<ID3D12PipelineState*> pipelineState{};  /// pCvC
+    };
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	pCvC쐬i[J[XbhŌĂ΂j
+     * @param	entry			ʂ̊i[
+     * @param	handle			nh
+     * @param	desc			pCvCXe[gLq
+     * @param	shader			VF[_NX̃CX^X
+     * @param	rootSignature	[gVOl`NX̃CX^X
+     */
+    void build(Entry& entry, Handle handle, const PipelineStateDesc& desc, const Shader& shader, const RootSignature& rootSignature) noexcept;
+
+private:
+    ID3D12Device*                                      device_{};         /// foCX
+    ID3D12Device1*                                     device1_{};        /// pCvCCup̃foCX
+    ID3D12PipelineLibrary*                             library_{};        /// pCvCCu
+    std::vector<char>                                  libraryBlob_{};    /// ǂݍ񂾃Cuilibrary_ QƂj
+    std::wstring                                       libraryPath_{};    /// Cu̕ۑ
+    bool                                               libraryDirty_{};   /// ۑKv
+    std::mutex                                         libraryMutex_{};   /// library_ ̕ی
+    JobSystem*                                         jobSystem_{};      /// WuVXe
+    mutable std::mutex                                 entriesMutex_{};   /// entries_ ̕ی
+    std::unordered_map<Handle, std::unique_ptr<Entry>> entries_{};        /// nhƂ̗vf
+    std::atomic<uint32_t>                              pending_{};        /// 쐬҂̐
+};
@@ -0,0 +1,218 @@
+// pCvCXe[gLq
+
+#include "pipeline_state_desc.h"
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SẴo
+ * @param	other	ׂLq
+ * @return	 true
+ */
+[[nodiscard]] bool PipelineStateDesc::operator==(const PipelineStateDesc& other) const noexcept {
+    return vertexShaderHash == other.vertexShaderHash && pixelShaderHash == other.pixelShaderHash && rootSignatureHash == other.rootSignatureHash &&
+           inputLayout == other.inputLayout && blend == other.blend && cull == other.cull && fill == other.fill && depth == other.depth &&
+           depthCompare == other.depthCompare && depthOnly == other.depthOnly && topology == other.topology && renderTargetCount == other.renderTargetCount &&
+           std::equal(std::begin(renderTargetFormats), std::end(renderTargetFormats), std::begin(other.renderTargetFormats)) &&
+           depthStencilFormat == other.depthStencilFormat && sampleCount == other.sampleCount;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	DXGI_FORMAT  1 vf̃oCg擾
+ * @param	format	DXGI_FORMAT ̒l
+ * @return	oCgB_CAEgŎgȂ` 0
+ */
+[[nodiscard]] uint32_t formatByteSize(uint32_t format) noexcept {
+    // dxgiformat.h ǂ܂ɍςނ悤lŎ
+    switch (format) {
+    case 2:   // R32G32B32A32_FLOAT
+    case 3:   // R32G32B32A32_UINT
+    case 4:   // R32G32B32A32_SINT
+        return 16;
+    case 6:   // R32G32B32_FLOAT
+    case 7:   // R32G32B32_UINT
+    case 8:   // R32G32B32_SINT
+        return 12;
+    case 10:  // R16G16B16A16_FLOAT
+    case 16:  // R32G32_FLOAT
+    case 17:  // R32G32_UINT
+    case 18:  // R32G32_SINT
+        return 8;
+    case 24:  // R10G10B10A2_UNORM
+    case 28:  // R8G8B8A8_UNORM
+    case 30:  // R8G8B8A8_UINT
+    case 34:  // R16G16_FLOAT
+    case 41:  // R32_FLOAT
+    case 42:  // R32_UINT
+    case 43:  // R32_SINT
+    case 87:  // B8G8R8A8_UNORM
+        return 4;
+    case 54:  // R16_FLOAT
+    case 57:  // R16_UINT
+        return 2;
+    default:
+        return 0;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[x̎gɍ킹pCvCXe[gLq
+ * @param	desc	̋Lqi[xȊO̐ݒgj
+ * @param	setup	[xobt@̎g
+ * @param	pass	pCvC̖
+ * @return	Lq
+ */
+[[nodiscard]] PipelineStateDesc makeDepthPipelineDesc(PipelineStateDesc desc, const DepthSetup& setup, DepthPass pass) {
+    desc.depthStencilFormat = setup.format;
+    desc.depthOnly = false;
+    if (setup.format == 0) {
+        desc.depth = DepthMode::Disabled;
+        return desc;
+    }
+
+    // reverseZ ł͎Oقǐ[x傫
+    const auto nearer = setup.reverseZ ? DepthCompare::Greater : DepthCompare::Less;
+    const auto nearerOrEqual = setup.reverseZ ? DepthCompare::GreaterEqual : DepthCompare::LessEqual;
+
+    if (pass == DepthPass::Prepass) {
+        desc.depth = DepthMode::ReadWrite;
+        desc.depthCompare = nearer;
+        desc.depthOnly = true;
+    }
+    else if (setup.prepass || desc.blend != BlendMode::Opaque) {
+        // vpX̐[xƈv鏊 Equal łʂ邪Aۂ߂̈Ⴂɋ `Equal ɂ
+        desc.depth = DepthMode::ReadOnly;
+        desc.depthCompare = nearerOrEqual;
+    }
+    else {
+        desc.depth = DepthMode::ReadWrite;
+        desc.depthCompare = nearer;
+    }
+    return desc;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvCXe[gLq𐳋K
+ * @param	desc	KLq
+ * @return	KLq
+ */
+[[nodiscard]] PipelineStateDesc normalizePipelineStateDesc(PipelineStateDesc desc) {
+    // _CAEg
+    uint32_t slotOffsets[16]{};
+    for (auto& element : desc.inputLayout) {
+        for (auto& c : element.semanticName) {
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        }
+
+        // 傫̕Ȃ`̌ AppendAligned ̂܂܎cAItZbǧvZ D3D12 ɔC
+        const uint32_t slot = element.inputSlot < 16 ? element.inputSlot : 15;
+        if (element.alignedByteOffset == PipelineStateDesc::AppendAligned) {
+            element.alignedByteOffset = slotOffsets[slot];
+        }
+        const uint32_t size = formatByteSize(element.format);
+        slotOffsets[slot] = (element.alignedByteOffset == PipelineStateDesc::AppendAligned || size == 0) ? PipelineStateDesc::AppendAligned
+                                                                                                          : element.alignedByteOffset + size;
+
+        if (!element.perInstance) {
+            element.instanceStepRate = 0;
+        }
+    }
+
+    // _[^[Qbg
+    if (desc.renderTargetCount > PipelineStateDesc::MaxRenderTargets) {
+        desc.renderTargetCount = PipelineStateDesc::MaxRenderTargets;
+    }
+    for (uint32_t i = desc.renderTargetCount; i < PipelineStateDesc::MaxRenderTargets; ++i) {
+        desc.renderTargetFormats[i] = 0;
+    }
+    if (desc.sampleCount == 0) {
+        desc.sampleCount = 1;
+    }
+
+    // C / |Cg͖ʂȂ̂ŃJOƓhԂ͌ʂɉeȂ
+    if (desc.topology != PrimitiveTopology::Triangle) {
+        desc.cull = CullMode::None;
+        desc.fill = FillMode::Solid;
+    }
+
+    // fvX
+    if (desc.depth == DepthMode::Disabled) {
+        desc.depthCompare = DepthCompare::LessEqual;
+    }
+    if (desc.depthOnly) {
+        desc.pixelShaderHash = 0;
+        desc.blend = BlendMode::Opaque;
+        desc.renderTargetCount = 0;
+        std::fill(std::begin(desc.renderTargetFormats), std::end(desc.renderTargetFormats), 0u);
+    }
+
+    return desc;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvCXe[gLq̃nbVvZ
+ * @param	desc	LqiŐKĂnbVj
+ * @return	64bit nbV
+ */
+[[nodiscard]] uint64_t hashPipelineStateDesc(const PipelineStateDesc& desc) {
+    const auto normalized = normalizePipelineStateDesc(desc);
+
+    // \̂̃pfBO܂߂Ȃ悤Ao 1 
+    uint64_t hash  = hashBytes(nullptr, 0);
+    auto     value = [&hash](auto v) { hash = hashBytes(&v, sizeof(v), hash); };
+
+    value(normalized.vertexShaderHash);
+    value(normalized.pixelShaderHash);
+    value(normalized.rootSignatureHash);
+
+    value(static_cast<uint32_t>(normalized.inputLayout.size()));
+    for (const auto& element : normalized.inputLayout) {
+        hash = hashBytes(element.semanticName.data(), element.semanticName.size(), hash);
+        value(element.semanticIndex);
+        value(element.format);
+        value(element.inputSlot);
+        value(element.alignedByteOffset);
+        value(static_cast<uint8_t>(element.perInstance));
+        value(element.instanceStepRate);
+    }
+
+    value(static_cast<uint8_t>(normalized.blend));
+    value(static_cast<uint8_t>(normalized.cull));
+    value(static_cast<uint8_t>(normalized.fill));
+    value(static_cast<uint8_t>(normalized.depth));
+    value(static_cast<uint8_t>(normalized.depthCompare));
+    value(static_cast<uint8_t>(normalized.depthOnly));
+    value(static_cast<uint8_t>(normalized.topology));
+    value(normalized.renderTargetCount);
+    for (uint32_t i = 0; i < normalized.renderTargetCount; ++i) {
+        value(normalized.renderTargetFormats[i]);
+    }
+    value(normalized.depthStencilFormat);
+    value(normalized.sampleCount);
+
+    return hash;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	oCg̃nbVvZiFNV-1a 64bitj
+ * @param	data	f[^
+ * @param	size	oCg
+ * @param	seed	liănbVꍇ͑Ǒʁj
+ * @return	64bit nbV
+ */
+[[nodiscard]] uint64_t hashBytes(const void* data, size_t size, uint64_t seed) noexcept {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t    hash  = seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
@@ -0,0 +1,179 @@
+// pCvCXe[gLq
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// uh̎
+enum class BlendMode : uint8_t {
+    Opaque,         ///< ㏑
+    Alpha,          ///< At@uh
+    Additive,       ///< Z
+    Premultiplied,  ///< Zς݃At@
+};
+
+/// JO̎
+enum class CullMode : uint8_t {
+    None,
+    Front,
+    Back,
+};
+
+/// hԂ̎
+enum class FillMode : uint8_t {
+    Solid,
+    Wireframe,
+};
+
+/// fvX̎g
+enum class DepthMode : uint8_t {
+    Disabled,   ///< eXg݂Ȃ
+    ReadWrite,  ///< eXgď
+    ReadOnly,   ///< eXĝ
+};
+
+/// [x̔r
+enum class DepthCompare : uint8_t {
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    Always,
+};
+
+/// v~eBu̎
+enum class PrimitiveTopology : uint8_t {
+    Triangle,
+    Line,
+    Point,
+};
+
+/// _CAEg̗vfiD3D12_INPUT_ELEMENT_DESC ɑΉj
+struct PipelineInputElement {
+    std::string semanticName;       ///< Z}eBNX
+    uint32_t    semanticIndex;      ///< Z}eBNXԍ
+    uint32_t    format;             ///< DXGI_FORMAT ̒l
+    uint32_t    inputSlot;          ///< ̓Xbg
+    uint32_t    alignedByteOffset;  ///< vf̃ItZbgiAppendAligned ŒO̗vfɑj
+    bool        perInstance;        ///< CX^XPʂ̃f[^Ȃ true
+    uint32_t    instanceStepRate;   ///< CX^Xf[^i߂Ԋu
+
+    bool operator==(const PipelineInputElement& other) const noexcept {
+        return semanticName == other.semanticName && semanticIndex == other.semanticIndex && format == other.format && inputSlot == other.inputSlot &&
+               alignedByteOffset == other.alignedByteOffset && perInstance == other.perInstance && instanceStepRate == other.instanceStepRate;
+    }
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvCXe[gLq
+ * @details	D3D12_GRAPHICS_PIPELINE_STATE_DESC ̂Aۂɑgݍ킹ƂĎg
+ *			D3D ɈˑȂ̂ŁAKƃnbV Linux łʂɂȂ
+ *			VF[_ƃ[gVOl`̓oCgR[h̓ẽnbVŕ\
+ */
+struct PipelineStateDesc {
+    /// AppendAlignediD3D12_APPEND_ALIGNED_ELEMENT Ɠlj
+    static constexpr uint32_t AppendAligned = 0xffffffff;
+
+    /// _[^[Qbg̍ő吔
+    static constexpr uint32_t MaxRenderTargets = 8;
+
+    uint64_t                          vertexShaderHash{};                    ///< _VF[_̃oCgR[h̃nbV
+    uint64_t                          pixelShaderHash{};                     ///< sNZVF[_̃oCgR[h̃nbV
+    uint64_t                          rootSignatureHash{};                   ///< [gVOl`̃nbV
+    std::vector<PipelineInputElement> inputLayout{};                         ///< _CAEg
+    BlendMode                         blend = BlendMode::Opaque;             ///< uh
+    CullMode                          cull = CullMode::Back;                 ///< JO
+    FillMode                          fill = FillMode::Solid;                ///< hԂ
+    DepthMode                         depth = DepthMode::Disabled;           ///< fvX
+    DepthCompare                      depthCompare = DepthCompare::LessEqual; ///< fvX̔r
+    bool                              depthOnly{};                           ///< sNZVF[_ƃ_[^[QbggȂi[xvpXj
+    PrimitiveTopology                 topology = PrimitiveTopology::Triangle; ///< v~eBu
+    uint32_t                          renderTargetCount = 1;                 ///< _[^[Qbg
+    uint32_t                          renderTargetFormats[MaxRenderTargets]{}; ///< DXGI_FORMAT ̒l
+    uint32_t                          depthStencilFormat{};                  ///< DXGI_FORMAT ̒l
+    uint32_t                          sampleCount = 1;                       ///< MSAA ̃Tv
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	SẴo
+     * @param	other	ׂLq
+     * @return	 true
+     * @details	̈Ⴂ͋zȂ̂ŁApCvC𒲂ׂɂ͐KLqǂŔׂ
+     */
+    [[nodiscard]] bool operator==(const PipelineStateDesc& other) const noexcept;
+};
+
+/// [xobt@̎gipCvC̑gݍ킹߂j
+struct DepthSetup {
+    uint32_t format{};         ///< DXGI_FORMAT ̒li0 Ȃ[xgȂj
+    bool     reverseZ = true;  ///< O 1A 0 ɂifloat ̐[xŉ̐xオj
+    bool     prepass{};        ///< sɐ[xŕ`AF̃pXł͐[xvh
+};
+
+/// [x̎gŕpCvC̖
+enum class DepthPass : uint8_t {
+    Prepass,  ///< [x
+    Color,    ///< Fh
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	DXGI_FORMAT  1 vf̃oCg擾
+ * @param	format	DXGI_FORMAT ̒l
+ * @return	oCgB_CAEgŎgȂ` 0
+ */
+[[nodiscard]] uint32_t formatByteSize(uint32_t format) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[x̎gɍ킹pCvCXe[gLq
+ * @param	desc	̋Lqi[xȊO̐ݒgj
+ * @param	setup	[xobt@̎g
+ * @param	pass	pCvC̖
+ * @return	Lq
+ * @details	Prepass:  [xށireverseZ Ȃ GreaterAłȂ Lessj
+ *			Color:    vpXΏ܂ GreaterEqual / LessEqualA΃eXgď
+ *			          iblend  Opaque ȊOj̓vpX̗Lɂ炸eXgs
+ */
+[[nodiscard]] PipelineStateDesc makeDepthPipelineDesc(PipelineStateDesc desc, const DepthSetup& setup, DepthPass pass);
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvCXe[gLq𐳋K
+ * @param	desc	KLq
+ * @return	KLq
+ * @details	ʂɂȂ鏑̈ႢzApCvCnbVɂȂ悤ɂ
+ *			EAppendAligned ۂ̃ItZbgɒuiformatByteSize  0 ̌`͒uȂj
+ *			EZ}eBNX啶ɂ낦iHLSL ͑啶ʂȂj
+ *			E_Pʂ̗vf instanceStepRate  0 ɂ
+ *			EgȂ_[^[Qbǧ` 0 ɂ
+ *			ETv 0  1 ɂ
+ *			EC / |Cgł̓JOƓhԂݒlɂ
+ *			EfvXgȂΔrlɂ
+ *			E[xvpXł̓_[^[QbgƃsNZVF[_ƃuh𖳂ɂ
+ */
+[[nodiscard]] PipelineStateDesc normalizePipelineStateDesc(PipelineStateDesc desc);
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvCXe[gLq̃nbVvZ
+ * @param	desc	LqiŐKĂnbVj
+ * @return	64bit nbV
+ * @details	hCõpCvCCu̖OɂĝŁAsƂɕςȂlɂĂ
+ */
+[[nodiscard]] uint64_t hashPipelineStateDesc(const PipelineStateDesc& desc);
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	oCg̃nbVvZiFNV-1a 64bitj
+ * @param	data	f[^
+ * @param	size	oCg
+ * @param	seed	liănbVꍇ͑Ǒʁj
+ * @return	64bit nbV
+ */
+[[nodiscard]] uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ull) noexcept;
@@ -24,31 +24,104 @@ PiplineStateObject::~PiplineStateObject() {
  * @return	 true
  */
 [[nodiscard]] bool PiplineStateObject::create(const Device& device, const Shader& shader, const RootSignature& rootSignature) noexcept {
+    return create(device, shader, rootSignature, defaultDesc());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Lqw肵ăpCvCXe[gIuWFNg쐬
+ * @param	device			foCXNX̃CX^X
+ * @param	shader			VF[_NX̃CX^X
+ * @param	rootSignature	[gVOl`NX̃CX^X
+ * @param	desc			pCvCXe[gLq
+ * @return	 true
+ */
+[[nodiscard]] bool PiplineStateObject::create(const Device& device, const Shader& shader, const RootSignature& rootSignature, const PipelineStateDesc& desc) noexcept {
+    std::vector<D3D12_INPUT_ELEMENT_DESC> inputElements;
+    const auto psoDesc = toD3D12Desc(desc, shader, rootSignature, inputElements);
+
+    auto res = device.get()->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&pipelineState_));
+    if (FAILED(res)) {
+        assert(false && "pCvCXe[g̍쐬Ɏs");
+        return false;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	V[p̊̃pCvCXe[gLq擾
+ * @return	POSITION / COLOR ̒_CAEgAsAʃJOAfvX
+ */
+[[nodiscard]] PipelineStateDesc PiplineStateObject::defaultDesc() {
     // _CAEg
     // _obt@̃tH[}bgɍ킹Đݒ肷
-    D3D12_INPUT_ELEMENT_DESC inputElementDescs[] = {
-        {"POSITION", 0,    DXGI_FORMAT_R32G32B32_FLOAT, 0,  0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {   "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+    PipelineStateDesc desc{};
+    desc.inputLayout = {
+        {"POSITION", 0,    DXGI_FORMAT_R32G32B32_FLOAT, 0,  0, false, 0},
+        {   "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, false, 0},
     };
+    desc.blend = BlendMode::Opaque;
+    desc.cull = CullMode::Back;
+    desc.fill = FillMode::Solid;
+    desc.depth = DepthMode::Disabled;
+    desc.topology = PrimitiveTopology::Triangle;
+    desc.renderTargetCount = 1;
+    desc.renderTargetFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.depthStencilFormat = DXGI_FORMAT_UNKNOWN;
+    desc.sampleCount = 1;
+    return desc;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	pCvCXe[gLq D3D12 ̍\̂ɕϊ
+ * @param	desc			pCvCXe[gLq
+ * @param	shader			VF[_NX̃CX^X
+ * @param	rootSignature	[gVOl`NX̃CX^X
+ * @param	inputElements	_CAEg̊i[i߂lQƂ̂ŎgI܂ŕێ邱Ɓj
+ * @return	D3D12 ̃pCvCXe[gLq
+ */
+[[nodiscard]] D3D12_GRAPHICS_PIPELINE_STATE_DESC PiplineStateObject::toD3D12Desc(const PipelineStateDesc& desc, const Shader& shader, const RootSignature& rootSignature, std::vector<D3D12_INPUT_ELEMENT_DESC>& inputElements) noexcept {
+    // _CAEg
+    // Z}eBNX desc ̕ŵ desc ێĂ
+    inputElements.clear();
+    inputElements.reserve(desc.inputLayout.size());
+    for (const auto& element : desc.inputLayout) {
+        D3D12_INPUT_ELEMENT_DESC e{};
+        e.SemanticName = element.semanticName.c_str();
+        e.SemanticIndex = element.semanticIndex;
+        e.Format = static_cast<DXGI_FORMAT>(element.format);
+        e.InputSlot = element.inputSlot;
+        e.AlignedByteOffset = element.alignedByteOffset;
+        e.InputSlotClass = element.perInstance ? D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA : D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA;
+        e.InstanceDataStepRate = element.perInstance ? element.instanceStepRate : 0;
+        inputElements.push_back(e);
+    }
 
     // X^CUXe[g
     // |S̓hԂ@◠ʃJO̐ݒs
     D3D12_RASTERIZER_DESC rasterizerDesc{};
-    rasterizerDesc.FillMode = D3D12_FILL_MODE_SOLID;
-    rasterizerDesc.CullMode = D3D12_CULL_MODE_BACK;
+    rasterizerDesc.FillMode = desc.fill == FillMode::Wireframe ? D3D12_FILL_MODE_WIREFRAME : D3D12_FILL_MODE_SOLID;
+    switch (desc.cull) {
+    case CullMode::None:  rasterizerDesc.CullMode = D3D12_CULL_MODE_NONE;  break;
+    case CullMode::Front: rasterizerDesc.CullMode = D3D12_CULL_MODE_FRONT; break;
+    case CullMode::Back:  rasterizerDesc.CullMode = D3D12_CULL_MODE_BACK;  break;
+    }
     rasterizerDesc.FrontCounterClockwise = false;
     rasterizerDesc.DepthBias = D3D12_DEFAULT_DEPTH_BIAS;
     rasterizerDesc.DepthBiasClamp = D3D12_DEFAULT_DEPTH_BIAS_CLAMP;
     rasterizerDesc.SlopeScaledDepthBias = D3D12_DEFAULT_SLOPE_SCALED_DEPTH_BIAS;
     rasterizerDesc.DepthClipEnable = true;
-    rasterizerDesc.MultisampleEnable = false;
+    rasterizerDesc.MultisampleEnable = desc.sampleCount > 1;
     rasterizerDesc.AntialiasedLineEnable = false;
     rasterizerDesc.ForcedSampleCount = 0;
     rasterizerDesc.ConservativeRaster = D3D12_CONSERVATIVE_RASTERIZATION_MODE_OFF;
 
     // uhXe[g
     // `挋ʂ̍@ݒ肷
-    const D3D12_RENDER_TARGET_BLEND_DESC defaultRenderTargetBlendDesc = {
+    D3D12_RENDER_TARGET_BLEND_DESC renderTargetBlendDesc = {
         FALSE,
         FALSE,
         D3D12_BLEND_ONE,
@@ -60,35 +133,79 @@ PiplineStateObject::~PiplineStateObject() {
         D3D12_LOGIC_OP_NOOP,
         D3D12_COLOR_WRITE_ENABLE_ALL,
     };
+    switch (desc.blend) {
+    case BlendMode::Opaque:
+        break;
+    case BlendMode::Alpha:
+        renderTargetBlendDesc.BlendEnable = TRUE;
+        renderTargetBlendDesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+        renderTargetBlendDesc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+        renderTargetBlendDesc.DestBlendAlpha = D3D12_BLEND_INV_SRC_ALPHA;
+        break;
+    case BlendMode::Additive:
+        renderTargetBlendDesc.BlendEnable = TRUE;
+        renderTargetBlendDesc.SrcBlend = D3D12_BLEND_SRC_ALPHA;
+        renderTargetBlendDesc.DestBlend = D3D12_BLEND_ONE;
+        renderTargetBlendDesc.DestBlendAlpha = D3D12_BLEND_ONE;
+        break;
+    case BlendMode::Premultiplied:
+        renderTargetBlendDesc.BlendEnable = TRUE;
+        renderTargetBlendDesc.SrcBlend = D3D12_BLEND_ONE;
+        renderTargetBlendDesc.DestBlend = D3D12_BLEND_INV_SRC_ALPHA;
+        renderTargetBlendDesc.DestBlendAlpha = D3D12_BLEND_INV_SRC_ALPHA;
+        break;
+    }
     D3D12_BLEND_DESC blendDesc{};
     blendDesc.AlphaToCoverageEnable = false;
     blendDesc.IndependentBlendEnable = false;
     for (UINT i = 0; i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i) {
-        blendDesc.RenderTarget[i] = defaultRenderTargetBlendDesc;
+        blendDesc.RenderTarget[i] = renderTargetBlendDesc;
+    }
+
+    // fvXXeVXe[g
+    D3D12_DEPTH_STENCIL_DESC depthStencilDesc{};
+    depthStencilDesc.DepthEnable = desc.depth != DepthMode::Disabled;
+    depthStencilDesc.DepthWriteMask = desc.depth == DepthMode::ReadWrite ? D3D12_DEPTH_WRITE_MASK_ALL : D3D12_DEPTH_WRITE_MASK_ZERO;
+    switch (desc.depthCompare) {
+    case DepthCompare::Less:         depthStencilDesc.DepthFunc = D3D12_COMPARISON_FUNC_LESS;          break;
+    case DepthCompare::LessEqual:    depthStencilDesc.DepthFunc = D3D12_COMPARISON_FUNC_LESS_EQUAL;    break;
+    case DepthCompare::Greater:      depthStencilDesc.DepthFunc = D3D12_COMPARISON_FUNC_GREATER;       break;
+    case DepthCompare::GreaterEqual: depthStencilDesc.DepthFunc = D3D12_COMPARISON_FUNC_GREATER_EQUAL; break;
+    case DepthCompare::Equal:        depthStencilDesc.DepthFunc = D3D12_COMPARISON_FUNC_EQUAL;         break;
+    case DepthCompare::Always:       depthStencilDesc.DepthFunc = D3D12_COMPARISON_FUNC_ALWAYS;        break;
+    }
+    depthStencilDesc.StencilEnable = false;
+
+    // v~eBu
+    D3D12_PRIMITIVE_TOPOLOGY_TYPE topologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+    switch (desc.topology) {
+    case PrimitiveTopology::Triangle: topologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE; break;
+    case PrimitiveTopology::Line:     topologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_LINE;     break;
+    case PrimitiveTopology::Point:    topologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_POINT;    break;
     }
 
     // pCvCXe[g
     // eݒ\̂ɂ܂Ƃ߂
     D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc{};
-    psoDesc.InputLayout = { inputElementDescs, _countof(inputElementDescs) };
+    psoDesc.InputLayout = { inputElements.data(), static_cast<UINT>(inputElements.size()) };
     psoDesc.pRootSignature = rootSignature.get();
     psoDesc.VS = { shader.vertexShader()->GetBufferPointer(), shader.vertexShader()->GetBufferSize() };
-    psoDesc.PS = { shader.pixelShader()->GetBufferPointer(), shader.pixelShader()->GetBufferSize() };
+    // [xvpX̓sNZVF[_A[xeXgōς܂
+    if (!desc.depthOnly) {
+        psoDesc.PS = { shader.pixelShader()->GetBufferPointer(), shader.pixelShader()->GetBufferSize() };
+    }
     psoDesc.RasterizerState = rasterizerDesc;
     psoDesc.BlendState = blendDesc;
-    psoDesc.DepthStencilState.DepthEnable = false;
-    psoDesc.DepthStencilState.StencilEnable = false;
+    psoDesc.DepthStencilState = depthStencilDesc;
     psoDesc.SampleMask = UINT_MAX;
-    psoDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
-    psoDesc.NumRenderTargets = 1;
-    psoDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
-    psoDesc.SampleDesc.Count = 1;
-    auto res = device.get()->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&pipelineState_));
-    if (FAILED(res)) {
-        assert(false && "pCvCXe[g̍쐬Ɏs");
+    psoDesc.PrimitiveTopologyType = topologyType;
+    psoDesc.NumRenderTargets = desc.depthOnly ? 0 : desc.renderTargetCount;
+    for (UINT i = 0; i < psoDesc.NumRenderTargets && i < D3D12_SIMULTANEOUS_RENDER_TARGET_COUNT; ++i) {
+        psoDesc.RTVFormats[i] = static_cast<DXGI_FORMAT>(desc.renderTargetFormats[i]);
     }
-
-    return true;
+    psoDesc.DSVFormat = static_cast<DXGI_FORMAT>(desc.depthStencilFormat);
+    psoDesc.SampleDesc.Count = desc.sampleCount;
+    return psoDesc;
 }
 
 //---------------------------------------------------------------------------------
@@ -5,6 +5,8 @@
 #include "device.h"
 #include "shader.h"
 #include "root_signature.h"
+#include "pipeline_state_desc.h"
+#include <vector>
 
 //---------------------------------------------------------------------------------
 /**
@@ -34,6 +36,17 @@ public:
      */
     [[nodiscard]] bool create(const Device& device, const Shader& shader, const RootSignature& rootSignature) noexcept;
 
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Lqw肵ăpCvCXe[gIuWFNg쐬
+     * @param	device			foCXNX̃CX^X
+     * @param	shader			VF[_NX̃CX^X
+     * @param	rootSignature	[gVOl`NX̃CX^X
+     * @param	desc			pCvCXe[gLq
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, const Shader& shader, const RootSignature& rootSignature, const PipelineStateDesc& desc) noexcept;
+
     //---------------------------------------------------------------------------------
     /**
      * @brief	pCvCXe[g擾
@@ -41,6 +54,24 @@ public:
      */
     [[nodiscard]] ID3D12PipelineState* get() const noexcept;
 
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	V[p̊̃pCvCXe[gLq擾
+     * @return	POSITION / COLOR ̒_CAEgAsAʃJOAfvX
+     */
+    [[nodiscard]] static PipelineStateDesc defaultDesc();
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	pCvCXe[gLq D3D12 ̍\̂ɕϊ
+     * @param	desc			pCvCXe[gLq
+     * @param	shader			VF[_NX̃CX^X
+     * @param	rootSignature	[gVOl`NX̃CX^X
+     * @param	inputElements	_CAEg̊i[i߂lQƂ̂ŎgI܂ŕێ邱Ɓj
+     * @return	D3D12 ̃pCvCXe[gLq
+     */
+    [[nodiscard]] static D3D12_GRAPHICS_PIPELINE_STATE_DESC toD3D12Desc(const PipelineStateDesc& desc, const Shader& shader, const RootSignature& rootSignature, std::vector<D3D12_INPUT_ELEMENT_DESC>& inputElements) noexcept;
+
 private:
     ID3D12PipelineState* pipelineState_ = {};  ///< pCvCXe[g
 };
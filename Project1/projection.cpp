@@ -0,0 +1,45 @@
+// ˉes
+
+#include "projection.h"
+#include <cmath>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	esinAr[Ԃ +Z AsD clip = M * pj
+ * @param	matrix		
+ * @param	fovY		c̉piWAj
+ * @param	aspect		 / c
+ * @param	nearZ		ÕNbvʂ܂ł̋
+ * @param	farZ		̃Nbvʂ܂ł̋ireverseZ Ȃ疳włj
+ * @param	reverseZ	O 1A 0 ɂ
+ */
+void makePerspectiveProjection(float matrix[4][4], float fovY, float aspect, float nearZ, float farZ, bool reverseZ) noexcept {
+    const float yScale = 1.0f / std::tan(fovY * 0.5f);
+
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            matrix[row][column] = 0.0f;
+        }
+    }
+    matrix[0][0] = yScale / aspect;
+    matrix[1][1] = yScale;
+    matrix[3][2] = 1.0f;
+
+    // depth = (a * z + b) / z
+    //   ʏ:    z = near  0Az = far  1
+    //   reverse: z = near  1Az = far  0ifar Ȃ a = 0j
+    if (reverseZ) {
+        if (std::isinf(farZ)) {
+            matrix[2][2] = 0.0f;
+            matrix[2][3] = nearZ;
+        }
+        else {
+            matrix[2][2] = -nearZ / (farZ - nearZ);
+            matrix[2][3] = nearZ * farZ / (farZ - nearZ);
+        }
+    }
+    else {
+        matrix[2][2] = farZ / (farZ - nearZ);
+        matrix[2][3] = -nearZ * farZ / (farZ - nearZ);
+    }
+}
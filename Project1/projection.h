@@ -0,0 +1,17 @@
+// ˉes
+
+#pragma once
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	esinAr[Ԃ +Z AsD clip = M * pj
+ * @param	matrix		
+ * @param	fovY		c̉piWAj
+ * @param	aspect		 / c
+ * @param	nearZ		ÕNbvʂ܂ł̋
+ * @param	farZ		̃Nbvʂ܂ł̋ireverseZ Ȃ疳włj
+ * @param	reverseZ	O 1A 0 ɂ
+ * @details	[x D3D Ɠ z/w  0 ` 1BreverseZ  32bit float ̐[xobt@Ƒgݍ킹ƁA
+ *			float ̎w z/w  1/ ̕złAɂ炸قڈ̑ΐxɂȂ
+ */
+void makePerspectiveProjection(float matrix[4][4], float fovY, float aspect, float nearZ, float farZ, bool reverseZ) noexcept;
@@ -0,0 +1,71 @@
+// \[g
+
+#include "radix_sort.h"
+#include <cassert>
+#include <cstring>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	64bit L[ LSD \[gij
+ * @param	keys		\[gL[iʂɓj
+ * @param	scratch		Ɨ̈icount j
+ * @param	count		L[̐
+ * @param	beginBit	\[gΏۂ̍ŉʃrbg
+ * @param	endBit		\[gΏۂ̍ŏʃrbg + 1
+ */
+void radixSort(uint64_t* keys, uint64_t* scratch, size_t count, uint32_t beginBit, uint32_t endBit) noexcept {
+    assert(beginBit <= endBit && endBit <= 64);
+    if (count < 2 || beginBit == endBit) {
+        return;
+    }
+
+    constexpr uint32_t DigitBits = 8;
+    constexpr uint32_t DigitCount = 64 / DigitBits;
+    constexpr uint32_t Buckets = 1 << DigitBits;
+
+    const uint32_t firstDigit = beginBit / DigitBits;
+    const uint32_t lastDigit = (endBit + DigitBits - 1) / DigitBits;
+
+    // SĂ̌̃qXgO 1 ̑ō
+    static thread_local uint32_t histogram[DigitCount][Buckets];
+    std::memset(histogram, 0, sizeof(histogram));
+    for (size_t i = 0; i < count; ++i) {
+        const uint64_t key = keys[i];
+        for (uint32_t digit = firstDigit; digit < lastDigit; ++digit) {
+            ++histogram[digit][(key >> (digit * DigitBits)) & (Buckets - 1)];
+        }
+    }
+
+    uint64_t* source = keys;
+    uint64_t* destination = scratch;
+    for (uint32_t digit = firstDigit; digit < lastDigit; ++digit) {
+        auto& buckets = histogram[digit];
+        const uint32_t shift = digit * DigitBits;
+
+        // SL[œľ͕тςȂ
+        if (buckets[(source[0] >> shift) & (Buckets - 1)] == count) {
+            continue;
+        }
+
+        // qXgO݈ʒuɕϊ
+        uint32_t offset = 0;
+        for (auto& bucket : buckets) {
+            const uint32_t n = bucket;
+            bucket = offset;
+            offset += n;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            const uint64_t key = source[i];
+            destination[buckets[(key >> shift) & (Buckets - 1)]++] = key;
+        }
+
+        uint64_t* swap = source;
+        source = destination;
+        destination = swap;
+    }
+
+    if (source != keys) {
+        std::memcpy(keys, source, count * sizeof(uint64_t));
+    }
+}
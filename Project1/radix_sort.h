@@ -0,0 +1,20 @@
+// \[g
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	64bit L[ LSD \[gij
+ * @param	keys		\[gL[iʂɓj
+ * @param	scratch		Ɨ̈icount j
+ * @param	count		L[̐
+ * @param	beginBit	\[gΏۂ̍ŉʃrbgi艺̃rbg͊ɕł̂ƂĈj
+ * @param	endBit		\[gΏۂ̍ŏʃrbg + 1
+ * @details	8bit BSĂ̌̃qXgO͍ŏ 1 ̑ł܂Ƃ߂čA
+ *			SL[Œl͕בւȗ
+ *			lL[̉ʃrbgɖߍ߂ (L[, l) ̑g̃\[gƂĂg
+ */
+void radixSort(uint64_t* keys, uint64_t* scratch, size_t count, uint32_t beginBit = 0, uint32_t endBit = 64) noexcept;
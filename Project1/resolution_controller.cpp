@@ -0,0 +1,119 @@
+// I𑜓x̐
+
+#include "resolution_controller.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    RXgN^
+ * @param	settings	ݒ
+ */
+ResolutionController::ResolutionController(const ResolutionControllerSettings& settings) noexcept
+    : settings_(settings) {
+    assert(settings.minScale > 0.0f && settings.minScale <= settings.maxScale && settings.targetMilliseconds > 0.0f);
+    reset(settings.maxScale);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Ԃ߂ɖ߂
+ * @param	scale	ki㉺Ɏ߂j
+ */
+void ResolutionController::reset(float scale) noexcept {
+    scale = std::clamp(scale, settings_.minScale, settings_.maxScale);
+    area_ = scale * scale;
+    filtered_ = 0.0f;
+    error1_ = 0.0f;
+    error2_ = 0.0f;
+    holdFrames_ = 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GPU Ԃ 1 t[^ďkXV
+ * @param	gpuMilliseconds	v GPU ԁi~bjB0 ȉ͖
+ * @return	Vk
+ */
+float ResolutionController::update(float gpuMilliseconds) noexcept {
+    if (!(gpuMilliseconds > 0.0f)) {
+        return scale();
+    }
+
+    // Cɉ̌vl͉Ỏ𑜓x̂̂Ȃ̂ŁAςɂȂ
+    if (holdFrames_ > 0) {
+        --holdFrames_;
+        return scale();
+    }
+
+    filtered_ = filtered_ > 0.0f ? filtered_ + (gpuMilliseconds - filtered_) * settings_.smoothing : gpuMilliseconds;
+    const float minArea = settings_.minScale * settings_.minScale;
+    const float maxArea = settings_.maxScale * settings_.maxScale;
+    const float goal = settings_.targetMilliseconds * settings_.headroom;
+
+    // 傫AԂʐςɔႷƂ݂Ȃ 1 ő_̖ʐςɂ
+    if (gpuMilliseconds > settings_.targetMilliseconds * settings_.panicRatio) {
+        area_ = std::clamp(area_ * goal / gpuMilliseconds, minArea, maxArea);
+        filtered_ = 0.0f;
+        error1_ = 0.0f;
+        error2_ = 0.0f;
+        holdFrames_ = settings_.latency;
+        return scale();
+    }
+
+    float error = goal / filtered_ - 1.0f;
+    if (std::fabs(error) < settings_.deadZone) {
+        error = 0.0f;
+    }
+
+    const float delta = settings_.integralGain * error + settings_.proportionalGain * (error - error1_) +
+                        settings_.derivativeGain * (error - 2.0f * error1_ + error2_);
+    error2_ = error1_;
+    error1_ = error;
+
+    // グ͏iグė\Z𒴂ƁA܂ŉt[j
+    area_ = std::clamp(area_ * (1.0f + std::min(delta, settings_.maxStep)), minArea, maxArea);
+    return scale();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	k擾
+ * @return	c̏k
+ */
+[[nodiscard]] float ResolutionController::scale() const noexcept {
+    return std::sqrt(area_);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	k|`TCY擾
+ * @param	width		ő̕isNZj
+ * @param	height		ő̍
+ * @param	outWidth	`悷镝i1 ȏj
+ * @param	outHeight	`悷鍂i1 ȏj
+ */
+void ResolutionController::renderSize(uint32_t width, uint32_t height, uint32_t& outWidth, uint32_t& outHeight) const noexcept {
+    const float s = scale();
+    outWidth = std::clamp(static_cast<uint32_t>(std::lround(width * s)), 1u, std::max(width, 1u));
+    outHeight = std::clamp(static_cast<uint32_t>(std::lround(height * s)), 1u, std::max(height, 1u));
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ς GPU Ԃ擾
+ * @return	~bi܂v 0j
+ */
+[[nodiscard]] float ResolutionController::filteredMilliseconds() const noexcept {
+    return filtered_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ݒ擾
+ * @return	ݒ
+ */
+[[nodiscard]] const ResolutionControllerSettings& ResolutionController::settings() const noexcept {
+    return settings_;
+}
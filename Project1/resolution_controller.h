@@ -0,0 +1,95 @@
+// I𑜓x̐
+
+#pragma once
+
+#include <cstdint>
+
+/// I𑜓x̐ݒ
+struct ResolutionControllerSettings {
+    float    targetMilliseconds = 16.6f;  ///< GPU Ԃ̗\Zi~bj
+    float    headroom = 0.9f;             ///< \Ẑۂɑ_ihŗ\Z𒴂Ȃ悤ɗ]Tj
+    float    minScale = 0.5f;             ///< c̏k̉
+    float    maxScale = 1.0f;             ///< c̏k̏
+    float    proportionalGain = 0.4f;     ///< QCi덷̕ωɑ΂锽j
+    float    integralGain = 0.25f;        ///< ϕQCi덷̂̂ɑ΂锽B1  1 ŖڕWɓ͂j
+    float    derivativeGain = 0.05f;      ///< QCi덷̕ω̕ωɑ΂锽j
+    float    smoothing = 0.5f;            ///< vl̎wړςŐVlɊ|d݁i1 ŕςȂj
+    float    deadZone = 0.03f;            ///< ̑Ό덷菬ΏkςȂiׂȗhhj
+    float    maxStep = 0.08f;             ///< 1 ɕςʐς̊̏iグ̂݁j
+    float    panicRatio = 1.3f;           ///< \Ẑ̔{𒴂Aϕ҂ɈCɉ
+    uint32_t latency = 2;                 ///< k̕ύXvlɌ܂ł̃t[
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	I𑜓x̐
+ * @details	GPU Ԃ󂯎A3D V[`c̏k߂
+ *			GPU Ԃ͂ނ˕`sNZik 2 jɔႷ̂ŁAʐς𑬓x` PID œ
+ *			  ʐ += ʐ * (Ki * e + Kp * (e - e1) + Kd * (e - 2 e1 + e2))Ae = _ / v - 1
+ *			x`͏o͂̏㉺Ŏ~܂Ăϕ܂ȂiChAbvȂj
+ *			\Z傫֌WCɉAύXvlɌ܂Łilatencyj͎̕ύX҂
+ *			D3D ɈˑȂ̂ŁALinux łV~[VŊm߂
+ */
+class ResolutionController final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     * @param	settings	ݒ
+     */
+    explicit ResolutionController(const ResolutionControllerSettings& settings = {}) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Ԃ߂ɖ߂
+     * @param	scale	ki㉺Ɏ߂j
+     */
+    void reset(float scale) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GPU Ԃ 1 t[^ďkXV
+     * @param	gpuMilliseconds	v GPU ԁi~bjB0 ȉ͖
+     * @return	Vk
+     */
+    float update(float gpuMilliseconds) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	k擾
+     * @return	c̏k
+     */
+    [[nodiscard]] float scale() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	k|`TCY擾
+     * @param	width		ő̕isNZj
+     * @param	height		ő̍
+     * @param	outWidth	`悷镝i1 ȏj
+     * @param	outHeight	`悷鍂i1 ȏj
+     */
+    void renderSize(uint32_t width, uint32_t height, uint32_t& outWidth, uint32_t& outHeight) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ς GPU Ԃ擾
+     * @return	~bi܂v 0j
+     */
+    [[nodiscard]] float filteredMilliseconds() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ݒ擾
+     * @return	ݒ
+     */
+    [[nodiscard]] const ResolutionControllerSettings& settings() const noexcept;
+
+private:
+    ResolutionControllerSettings settings_{};    /// ݒ
+    float                        area_{};        /// ʐς̊ik 2 j
+    float                        filtered_{};    /// ς GPU 
+    float                        error1_{};      /// 1 Ǒ덷
+    float                        error2_{};      /// 2 Ǒ덷
+    uint32_t                     holdFrames_{};  /// CɉAvlɌ܂ő҂ct[
+};
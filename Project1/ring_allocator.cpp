@@ -0,0 +1,82 @@
+// OAP[^NX
+
+#include "ring_allocator.h"
+#include <cassert>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	
+ * @param	capacity	obt@̃oCg
+ * @param	frameCount	 GPU QƂt[
+ */
+void RingAllocator::create(uint64_t capacity, uint32_t frameCount) {
+    assert(capacity > 0 && frameCount > 0);
+    capacity_ = capacity;
+    head_ = 0;
+    used_ = 0;
+    frameIndex_ = 0;
+    frameUsed_.assign(frameCount, 0);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t[Jn
+ * @param	frameIndex	t[ԍ (0 ` frameCount - 1)
+ */
+void RingAllocator::beginFrame(uint32_t frameIndex) noexcept {
+    assert(frameIndex < frameUsed_.size());
+
+    // mۂ͏ɃOȂ̂ŁAłÂt[̕Ԃ΋󂫂͘A܂
+    used_ -= frameUsed_[frameIndex];
+    frameUsed_[frameIndex] = 0;
+    frameIndex_ = frameIndex;
+    if (used_ == 0) {
+        head_ = 0;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̈mۂ
+ * @param	size		oCg
+ * @param	alignment	ACgi2 ׂ̂j
+ * @return	擪̃ItZbgB󂫂 InvalidOffset
+ */
+[[nodiscard]] uint64_t RingAllocator::allocate(uint64_t size, uint64_t alignment) noexcept {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+    uint64_t offset = (head_ + alignment - 1) & ~(alignment - 1);
+    uint64_t consumed = offset - head_ + size;
+
+    // Ɏ܂Ȃΐ擪ɖ߂i̗]͕ԋp܂ŎgpƂĈj
+    if (offset + size > capacity_) {
+        offset = 0;
+        consumed = capacity_ - head_ + size;
+    }
+    if (used_ + consumed > capacity_) {
+        return InvalidOffset;
+    }
+
+    used_ += consumed;
+    frameUsed_[frameIndex_] += consumed;
+    head_ = offset + size;
+    return offset;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	gp̃oCg擾
+ * @return	oCg
+ */
+[[nodiscard]] uint64_t RingAllocator::usedBytes() const noexcept {
+    return used_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	obt@̃oCg擾
+ * @return	oCg
+ */
+[[nodiscard]] uint64_t RingAllocator::capacity() const noexcept {
+    return capacity_;
+}
@@ -0,0 +1,77 @@
+// OAP[^NX
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	OAP[^NX
+ * @details	1 ̃obt@擪珇ɐ؂oAɒB擪ɖ߂
+ *			t[ƂɎgʂoĂÃt[ GPU I_
+ *			it[ԍ beginFramejł܂Ƃ߂ĕԋp
+ *			ItZbǧvZsA͎ȂiAbv[hq[vȂǂƑgݍ킹j
+ */
+class RingAllocator final {
+public:
+    /// mۂłȂꍇ̃ItZbg
+    static constexpr uint64_t InvalidOffset = ~0ull;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    RingAllocator() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~RingAllocator() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	
+     * @param	capacity	obt@̃oCg
+     * @param	frameCount	 GPU QƂt[
+     */
+    void create(uint64_t capacity, uint32_t frameCount);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	t[Jn
+     * @param	frameIndex	t[ԍ (0 ` frameCount - 1)BO񂱂̃t[ԍŊmۂԋp
+     */
+    void beginFrame(uint32_t frameIndex) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̈mۂ
+     * @param	size		oCg
+     * @param	alignment	ACgi2 ׂ̂j
+     * @return	擪̃ItZbgB󂫂 InvalidOffset
+     */
+    [[nodiscard]] uint64_t allocate(uint64_t size, uint64_t alignment) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	gp̃oCg擾
+     * @return	oCgiACgƐ܂ԂŎ̂Ă܂ށj
+     */
+    [[nodiscard]] uint64_t usedBytes() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	obt@̃oCg擾
+     * @return	oCg
+     */
+    [[nodiscard]] uint64_t capacity() const noexcept;
+
+private:
+    uint64_t              capacity_{};     /// obt@̃oCg
+    uint64_t              head_{};         /// ɐ؂oʒu
+    uint64_t              used_{};         /// gp̃oCg
+    uint32_t              frameIndex_{};   /// ݂̃t[ԍ
+    std::vector<uint64_t> frameUsed_{};    /// t[Ƃ̎gp
+};
@@ -1,6 +1,7 @@
 // [gVOl`NX
 
 #include "root_signature.h"
+#include "pipeline_state_desc.h"
 #include <cassert>
 
 //---------------------------------------------------------------------------------
@@ -24,28 +25,29 @@ RootSignature::~RootSignature() {
 [[nodiscard]] bool RootSignature::create(const Device& device) noexcept {
     // `ɕKvȃ\[XVF[_ɓ`
     // ͓Ƀ\[X𗘗pȂ̂ŋŗp
-    D3D12_ROOT_SIGNATURE_DESC rootSignatureDesc{};
-    rootSignatureDesc.NumParameters = 0;
-    rootSignatureDesc.pParameters = nullptr;
-    rootSignatureDesc.NumStaticSamplers = 0;
-    rootSignatureDesc.pStaticSamplers = nullptr;
-    rootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT;
+    return create(device, RootSignatureBuilder{});
+}
 
+//---------------------------------------------------------------------------------
+/**
+ * @brief	r_[̓eŃ[gVOl`쐬
+ * @param	device	foCXNX̃CX^X
+ * @param	builder	[gVOl`r_[
+ * @return	 true
+ */
+[[nodiscard]] bool RootSignature::create(const Device& device, const RootSignatureBuilder& builder) noexcept {
     // [gVOl`̃VACY
     ID3DBlob* signature{};
-    auto      res = D3D12SerializeRootSignature(
-        &rootSignatureDesc,
-        D3D_ROOT_SIGNATURE_VERSION_1,
-        &signature,
-        nullptr);
-
-    bool success = SUCCEEDED(res);
+    bool success = builder.serialize(device, &signature);
     if (!success) {
         assert(false && "[gVOl`̃VACYɎs");
     }
     else {
+        // pCvCLbṼL[ɎĝœẽnbVĂ
+        hash_ = hashBytes(signature->GetBufferPointer(), signature->GetBufferSize());
+
         // [gVOl`̐
-        res = device.get()->CreateRootSignature(
+        const auto res = device.get()->CreateRootSignature(
             0,
             signature->GetBufferPointer(),
             signature->GetBufferSize(),
@@ -76,3 +78,12 @@ RootSignature::~RootSignature() {
 
     return rootSignature_;
 }
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VACYʂ̃nbV擾
+ * @return	e[gVOl`Ȃ瓯l
+ */
+[[nodiscard]] uint64_t RootSignature::hash() const noexcept {
+    return hash_;
+}
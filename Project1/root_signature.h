@@ -3,6 +3,8 @@
 #pragma once
 
 #include "device.h"
+#include "root_signature_builder.h"
+#include <cstdint>
 
 //---------------------------------------------------------------------------------
 /**
@@ -30,6 +32,15 @@ public:
      */
     [[nodiscard]] bool create(const Device& device) noexcept;
 
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	r_[̓eŃ[gVOl`쐬
+     * @param	device	foCXNX̃CX^X
+     * @param	builder	[gVOl`r_[
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, const RootSignatureBuilder& builder) noexcept;
+
     //---------------------------------------------------------------------------------
     /**
      * @brief	[gVOl`擾
@@ -37,6 +48,14 @@ public:
      */
     [[nodiscard]] ID3D12RootSignature* get() const noexcept;
 
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	VACYʂ̃nbV擾
+     * @return	e[gVOl`Ȃ瓯l
+     */
+    [[nodiscard]] uint64_t hash() const noexcept;
+
 private:
     ID3D12RootSignature* rootSignature_{};  /// [gVOl`
+    uint64_t             hash_{};           /// VACYʂ̃nbV
 };
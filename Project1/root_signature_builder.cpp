@@ -0,0 +1,335 @@
+// [gVOl`r_[NX
+
+#include "root_signature_builder.h"
+#include "pipeline_state_desc.h"
+#include <cassert>
+
+namespace {
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	͈͂̎ނƂ̊tO擾
+ * @param	type	͈͂̎
+ * @return	tO
+ */
+D3D12_DESCRIPTOR_RANGE_FLAGS defaultRangeFlags(D3D12_DESCRIPTOR_RANGE_TYPE type) noexcept {
+    switch (type) {
+    case D3D12_DESCRIPTOR_RANGE_TYPE_CBV:
+    case D3D12_DESCRIPTOR_RANGE_TYPE_SRV:
+        // R}hsɒgςȂƂhCoɓ`
+        return D3D12_DESCRIPTOR_RANGE_FLAG_DATA_STATIC_WHILE_SET_AT_EXECUTE;
+    case D3D12_DESCRIPTOR_RANGE_TYPE_UAV:
+        return D3D12_DESCRIPTOR_RANGE_FLAG_DATA_VOLATILE;
+    default:
+        // Tv[ɂ DATA ñtOtȂ
+        return D3D12_DESCRIPTOR_RANGE_FLAG_NONE;
+    }
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[g萔ǉ
+ */
+RootSignatureBuilder& RootSignatureBuilder::addConstants(UINT num32BitValues, UINT shaderRegister, UINT space, D3D12_SHADER_VISIBILITY visibility) {
+    D3D12_ROOT_PARAMETER1 parameter{};
+    parameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    parameter.Constants.ShaderRegister = shaderRegister;
+    parameter.Constants.RegisterSpace = space;
+    parameter.Constants.Num32BitValues = num32BitValues;
+    parameter.ShaderVisibility = visibility;
+    parameters_.push_back(parameter);
+    ranges_.emplace_back();
+    return *this;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[g CBV ǉ
+ */
+RootSignatureBuilder& RootSignatureBuilder::addCBV(UINT shaderRegister, UINT space, D3D12_SHADER_VISIBILITY visibility, D3D12_ROOT_DESCRIPTOR_FLAGS flags) {
+    D3D12_ROOT_PARAMETER1 parameter{};
+    parameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
+    parameter.Descriptor = { shaderRegister, space, flags };
+    parameter.ShaderVisibility = visibility;
+    parameters_.push_back(parameter);
+    ranges_.emplace_back();
+    return *this;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[g SRV ǉ
+ */
+RootSignatureBuilder& RootSignatureBuilder::addSRV(UINT shaderRegister, UINT space, D3D12_SHADER_VISIBILITY visibility, D3D12_ROOT_DESCRIPTOR_FLAGS flags) {
+    D3D12_ROOT_PARAMETER1 parameter{};
+    parameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_SRV;
+    parameter.Descriptor = { shaderRegister, space, flags };
+    parameter.ShaderVisibility = visibility;
+    parameters_.push_back(parameter);
+    ranges_.emplace_back();
+    return *this;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[g UAV ǉ
+ */
+RootSignatureBuilder& RootSignatureBuilder::addUAV(UINT shaderRegister, UINT space, D3D12_SHADER_VISIBILITY visibility, D3D12_ROOT_DESCRIPTOR_FLAGS flags) {
+    D3D12_ROOT_PARAMETER1 parameter{};
+    parameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_UAV;
+    parameter.Descriptor = { shaderRegister, space, flags };
+    parameter.ShaderVisibility = visibility;
+    parameters_.push_back(parameter);
+    ranges_.emplace_back();
+    return *this;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	fBXNv^e[uǉ
+ */
+RootSignatureBuilder& RootSignatureBuilder::addTable(const std::vector<Range>& ranges, D3D12_SHADER_VISIBILITY visibility) {
+    assert(ranges.size() > 0 && "̃fBXNv^e[u͍܂");
+
+    std::vector<D3D12_DESCRIPTOR_RANGE1> tableRanges;
+    tableRanges.reserve(ranges.size());
+    for (const auto& range : ranges) {
+        D3D12_DESCRIPTOR_RANGE1 r{};
+        r.RangeType = range.type;
+        r.NumDescriptors = range.count;
+        r.BaseShaderRegister = range.baseRegister;
+        r.RegisterSpace = range.space;
+        r.Flags = range.flags ? *range.flags : defaultRangeFlags(range.type);
+        r.OffsetInDescriptorsFromTableStart = D3D12_DESCRIPTOR_RANGE_OFFSET_APPEND;
+        tableRanges.push_back(r);
+    }
+
+    D3D12_ROOT_PARAMETER1 parameter{};
+    parameter.ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+    parameter.DescriptorTable.NumDescriptorRanges = static_cast<UINT>(tableRanges.size());
+    parameter.ShaderVisibility = visibility;
+    parameters_.push_back(parameter);
+    ranges_.push_back(std::move(tableRanges));
+    return *this;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ÓITv[ǉ
+ */
+RootSignatureBuilder& RootSignatureBuilder::addStaticSampler(UINT shaderRegister, D3D12_FILTER filter, D3D12_TEXTURE_ADDRESS_MODE addressMode, D3D12_SHADER_VISIBILITY visibility) {
+    D3D12_STATIC_SAMPLER_DESC desc{};
+    desc.Filter = filter;
+    desc.AddressU = addressMode;
+    desc.AddressV = addressMode;
+    desc.AddressW = addressMode;
+    desc.MipLODBias = 0.0f;
+    desc.MaxAnisotropy = 16;
+    desc.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+    desc.BorderColor = D3D12_STATIC_BORDER_COLOR_OPAQUE_BLACK;
+    desc.MinLOD = 0.0f;
+    desc.MaxLOD = D3D12_FLOAT32_MAX;
+    desc.ShaderRegister = shaderRegister;
+    desc.RegisterSpace = 0;
+    desc.ShaderVisibility = visibility;
+    return addStaticSampler(desc);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ÓITv[ǉ
+ */
+RootSignatureBuilder& RootSignatureBuilder::addStaticSampler(const D3D12_STATIC_SAMPLER_DESC& desc) {
+    samplers_.push_back(desc);
+    return *this;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[gVOl`̃tOݒ肷
+ */
+RootSignatureBuilder& RootSignatureBuilder::setFlags(D3D12_ROOT_SIGNATURE_FLAGS flags) {
+    flags_ = flags;
+    return *this;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VACY
+ * @param	device	foCXNX̃CX^XiΉo[W̊mFɎgj
+ * @param	blob	VACYʂ̊i[
+ * @return	 true
+ */
+[[nodiscard]] bool RootSignatureBuilder::serialize(const Device& device, ID3DBlob** blob) const noexcept {
+    // ΉĂŐVo[WmF
+    D3D12_FEATURE_DATA_ROOT_SIGNATURE feature{};
+    feature.HighestVersion = D3D_ROOT_SIGNATURE_VERSION_1_1;
+    if (FAILED(device.get()->CheckFeatureSupport(D3D12_FEATURE_ROOT_SIGNATURE, &feature, sizeof(feature)))) {
+        feature.HighestVersion = D3D_ROOT_SIGNATURE_VERSION_1_0;
+    }
+
+    // e[u͈̔̓|C^Ōqivector ̍ĊmۂŖɂȂȂ悤Ɂj
+    std::vector<D3D12_ROOT_PARAMETER1> parameters = parameters_;
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        if (parameters[i].ParameterType == D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE) {
+            parameters[i].DescriptorTable.pDescriptorRanges = ranges_[i].data();
+        }
+    }
+
+    D3D12_VERSIONED_ROOT_SIGNATURE_DESC desc{};
+
+    // 1.0 p̕ϊitO𗎂Ƃj
+    std::vector<D3D12_ROOT_PARAMETER>                parameters10;
+    std::vector<std::vector<D3D12_DESCRIPTOR_RANGE>> ranges10;
+
+    if (feature.HighestVersion >= D3D_ROOT_SIGNATURE_VERSION_1_1) {
+        desc.Version = D3D_ROOT_SIGNATURE_VERSION_1_1;
+        desc.Desc_1_1.NumParameters = static_cast<UINT>(parameters.size());
+        desc.Desc_1_1.pParameters = parameters.empty() ? nullptr : parameters.data();
+        desc.Desc_1_1.NumStaticSamplers = static_cast<UINT>(samplers_.size());
+        desc.Desc_1_1.pStaticSamplers = samplers_.empty() ? nullptr : samplers_.data();
+        desc.Desc_1_1.Flags = flags_;
+    }
+    else {
+        parameters10.resize(parameters.size());
+        ranges10.resize(parameters.size());
+        for (size_t i = 0; i < parameters.size(); ++i) {
+            const auto& src = parameters[i];
+            auto&       dst = parameters10[i];
+            dst.ParameterType = src.ParameterType;
+            dst.ShaderVisibility = src.ShaderVisibility;
+            switch (src.ParameterType) {
+            case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+                for (const auto& range : ranges_[i]) {
+                    ranges10[i].push_back({ range.RangeType, range.NumDescriptors, range.BaseShaderRegister, range.RegisterSpace, range.OffsetInDescriptorsFromTableStart });
+                }
+                dst.DescriptorTable.NumDescriptorRanges = static_cast<UINT>(ranges10[i].size());
+                dst.DescriptorTable.pDescriptorRanges = ranges10[i].data();
+                break;
+            case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+                dst.Constants = src.Constants;
+                break;
+            default:
+                dst.Descriptor.ShaderRegister = src.Descriptor.ShaderRegister;
+                dst.Descriptor.RegisterSpace = src.Descriptor.RegisterSpace;
+                break;
+            }
+        }
+        desc.Version = D3D_ROOT_SIGNATURE_VERSION_1_0;
+        desc.Desc_1_0.NumParameters = static_cast<UINT>(parameters10.size());
+        desc.Desc_1_0.pParameters = parameters10.empty() ? nullptr : parameters10.data();
+        desc.Desc_1_0.NumStaticSamplers = static_cast<UINT>(samplers_.size());
+        desc.Desc_1_0.pStaticSamplers = samplers_.empty() ? nullptr : samplers_.data();
+        desc.Desc_1_0.Flags = flags_;
+    }
+
+    ID3DBlob* error{};
+    const auto res = D3D12SerializeVersionedRootSignature(&desc, blob, &error);
+    if (error) {
+        OutputDebugStringA(static_cast<const char*>(error->GetBufferPointer()));
+        error->Release();
+    }
+    if (FAILED(res)) {
+        assert(false && "[gVOl`̃VACYɎs");
+        return false;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CAEg߂lɓn
+ * @param	value	l󂯎֐
+ */
+template <class Func>
+void RootSignatureBuilder::visitLayout(Func&& value) const {
+    // \̂̋p̂pfBO邽߁AӖ̂ln
+    value(static_cast<uint32_t>(flags_));
+    value(static_cast<uint32_t>(parameters_.size()));
+    for (size_t i = 0; i < parameters_.size(); ++i) {
+        const auto& parameter = parameters_[i];
+        value(static_cast<uint32_t>(parameter.ParameterType));
+        value(static_cast<uint32_t>(parameter.ShaderVisibility));
+        switch (parameter.ParameterType) {
+        case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+            value(static_cast<uint32_t>(ranges_[i].size()));
+            for (const auto& range : ranges_[i]) {
+                value(static_cast<uint32_t>(range.RangeType));
+                value(range.NumDescriptors);
+                value(range.BaseShaderRegister);
+                value(range.RegisterSpace);
+                value(static_cast<uint32_t>(range.Flags));
+                value(range.OffsetInDescriptorsFromTableStart);
+            }
+            break;
+        case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+            value(parameter.Constants.ShaderRegister);
+            value(parameter.Constants.RegisterSpace);
+            value(parameter.Constants.Num32BitValues);
+            break;
+        default:
+            value(parameter.Descriptor.ShaderRegister);
+            value(parameter.Descriptor.RegisterSpace);
+            value(static_cast<uint32_t>(parameter.Descriptor.Flags));
+            break;
+        }
+    }
+
+    value(static_cast<uint32_t>(samplers_.size()));
+    for (const auto& sampler : samplers_) {
+        value(static_cast<uint32_t>(sampler.Filter));
+        value(static_cast<uint32_t>(sampler.AddressU));
+        value(static_cast<uint32_t>(sampler.AddressV));
+        value(static_cast<uint32_t>(sampler.AddressW));
+        value(sampler.MipLODBias);
+        value(sampler.MaxAnisotropy);
+        value(static_cast<uint32_t>(sampler.ComparisonFunc));
+        value(static_cast<uint32_t>(sampler.BorderColor));
+        value(sampler.MinLOD);
+        value(sampler.MaxLOD);
+        value(sampler.ShaderRegister);
+        value(sampler.RegisterSpace);
+        value(static_cast<uint32_t>(sampler.ShaderVisibility));
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	LqẽnbVvZ
+ * @return	CAEgȂ瓯l
+ */
+[[nodiscard]] uint64_t RootSignatureBuilder::hash() const noexcept {
+    uint64_t hash = hashBytes(nullptr, 0);
+    visitLayout([&hash](auto v) { hash = hashBytes(&v, sizeof(v), hash); });
+    return hash;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CAEg
+ * @param	other	ׂr_[
+ * @return	hash ɎglSē true
+ */
+[[nodiscard]] bool RootSignatureBuilder::operator==(const RootSignatureBuilder& other) const {
+    const auto collect = [](const RootSignatureBuilder& builder) {
+        std::vector<uint8_t> bytes;
+        builder.visitLayout([&bytes](auto v) {
+            const auto* p = reinterpret_cast<const uint8_t*>(&v);
+            bytes.insert(bytes.end(), p, p + sizeof(v));
+        });
+        return bytes;
+    };
+    return collect(*this) == collect(other);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[gp[^擾
+ * @return	p[^
+ */
+[[nodiscard]] UINT RootSignatureBuilder::parameterCount() const noexcept {
+    return static_cast<UINT>(parameters_.size());
+}
@@ -0,0 +1,173 @@
+// [gVOl`r_[NX
+
+#pragma once
+
+#include "device.h"
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[gVOl`r_[NX
+ * @details	[g萔E[gfBXNv^EfBXNv^e[uEÓITv[ɐςݏグA
+ *			o[W 1.1 ŃVACYB1.1  DATA_STATIC ntOŃhCo̍œK
+ *			1.1 Ή̊ł 1.0 ɗƂăVACY
+ */
+class RootSignatureBuilder final {
+public:
+    /// fBXNv^e[u͈̔
+    struct Range {
+        D3D12_DESCRIPTOR_RANGE_TYPE                 type;          ///< CBV / SRV / UAV / SAMPLER
+        UINT                                        count;         ///< fBXNv^
+        UINT                                        baseRegister;  ///< 擪̃WX^ԍ
+        UINT                                        space = 0;     ///< WX^Xy[X
+        std::optional<D3D12_DESCRIPTOR_RANGE_FLAGS> flags{};       ///< ȗ͎ނƂ̊l
+    };
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    RootSignatureBuilder() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~RootSignatureBuilder() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[g萔ǉ
+     * @param	num32BitValues	32bit l̐
+     * @param	shaderRegister	WX^ԍ (b#)
+     * @param	space			WX^Xy[X
+     * @param	visibility		QƂVF[_Xe[W
+     * @return	g̎Q
+     */
+    RootSignatureBuilder& addConstants(UINT num32BitValues, UINT shaderRegister, UINT space = 0, D3D12_SHADER_VISIBILITY visibility = D3D12_SHADER_VISIBILITY_ALL);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[g CBV ǉ
+     * @param	shaderRegister	WX^ԍ (b#)
+     * @param	space			WX^Xy[X
+     * @param	visibility		QƂVF[_Xe[W
+     * @param	flags			f[^̈i̓R}hs͕sρj
+     * @return	g̎Q
+     */
+    RootSignatureBuilder& addCBV(UINT shaderRegister, UINT space = 0, D3D12_SHADER_VISIBILITY visibility = D3D12_SHADER_VISIBILITY_ALL,
+                                 D3D12_ROOT_DESCRIPTOR_FLAGS flags = D3D12_ROOT_DESCRIPTOR_FLAG_DATA_STATIC_WHILE_SET_AT_EXECUTE);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[g SRV ǉ
+     * @param	shaderRegister	WX^ԍ (t#)
+     * @param	space			WX^Xy[X
+     * @param	visibility		QƂVF[_Xe[W
+     * @param	flags			f[^̈i̓R}hs͕sρj
+     * @return	g̎Q
+     */
+    RootSignatureBuilder& addSRV(UINT shaderRegister, UINT space = 0, D3D12_SHADER_VISIBILITY visibility = D3D12_SHADER_VISIBILITY_ALL,
+                                 D3D12_ROOT_DESCRIPTOR_FLAGS flags = D3D12_ROOT_DESCRIPTOR_FLAG_DATA_STATIC_WHILE_SET_AT_EXECUTE);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[g UAV ǉ
+     * @param	shaderRegister	WX^ԍ (u#)
+     * @param	space			WX^Xy[X
+     * @param	visibility		QƂVF[_Xe[W
+     * @param	flags			f[^̈iUAV ͏܂̂Ŋ volatilej
+     * @return	g̎Q
+     */
+    RootSignatureBuilder& addUAV(UINT shaderRegister, UINT space = 0, D3D12_SHADER_VISIBILITY visibility = D3D12_SHADER_VISIBILITY_ALL,
+                                 D3D12_ROOT_DESCRIPTOR_FLAGS flags = D3D12_ROOT_DESCRIPTOR_FLAG_DATA_VOLATILE);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	fBXNv^e[uǉ
+     * @param	ranges		e[uɊ܂߂͈́i擪l߂Ĕzuj
+     * @param	visibility	QƂVF[_Xe[W
+     * @return	g̎Q
+     */
+    RootSignatureBuilder& addTable(const std::vector<Range>& ranges, D3D12_SHADER_VISIBILITY visibility = D3D12_SHADER_VISIBILITY_ALL);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ÓITv[ǉ
+     * @param	shaderRegister	WX^ԍ (s#)
+     * @param	filter			tB^
+     * @param	addressMode		UVW ʂ̃AhX[h
+     * @param	visibility		QƂVF[_Xe[W
+     * @return	g̎Q
+     */
+    RootSignatureBuilder& addStaticSampler(UINT shaderRegister, D3D12_FILTER filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR,
+                                           D3D12_TEXTURE_ADDRESS_MODE addressMode = D3D12_TEXTURE_ADDRESS_MODE_WRAP,
+                                           D3D12_SHADER_VISIBILITY visibility = D3D12_SHADER_VISIBILITY_PIXEL);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ÓITv[ǉ
+     * @param	desc	Tv[̐ݒ
+     * @return	g̎Q
+     */
+    RootSignatureBuilder& addStaticSampler(const D3D12_STATIC_SAMPLER_DESC& desc);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[gVOl`̃tOݒ肷
+     * @param	flags	tOi͓̓CAEg HS/DS/GS ւ̌J֎~j
+     * @return	g̎Q
+     */
+    RootSignatureBuilder& setFlags(D3D12_ROOT_SIGNATURE_FLAGS flags);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	VACY
+     * @param	device	foCXNX̃CX^XiΉo[W̊mFɎgj
+     * @param	blob	VACYʂ̊i[
+     * @return	 true
+     */
+    [[nodiscard]] bool serialize(const Device& device, ID3DBlob** blob) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	LqẽnbVvZ
+     * @return	CAEgȂ瓯l
+     */
+    [[nodiscard]] uint64_t hash() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	CAEg
+     * @param	other	ׂr_[
+     * @return	hash ɎglSē trueinbVՓ˂Ăʂ̃CAEg͌j
+     */
+    [[nodiscard]] bool operator==(const RootSignatureBuilder& other) const;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[gp[^擾
+     * @return	p[^
+     */
+    [[nodiscard]] UINT parameterCount() const noexcept;
+
+private:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	CAEg߂lɓnihash  operator== l悤ɂj
+     * @param	value	l󂯎֐
+     */
+    template <class Func>
+    void visitLayout(Func&& value) const;
+
+    std::vector<D3D12_ROOT_PARAMETER1>              parameters_{};  /// [gp[^ie[u͈̔̓|C^̓VACYɐݒj
+    std::vector<std::vector<D3D12_DESCRIPTOR_RANGE1>> ranges_{};    /// p[^Ƃ̃e[u͈̔
+    std::vector<D3D12_STATIC_SAMPLER_DESC>          samplers_{};    /// ÓITv[
+    D3D12_ROOT_SIGNATURE_FLAGS                      flags_ =        /// [gVOl`̃tO
+        D3D12_ROOT_SIGNATURE_FLAG_ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT |
+        D3D12_ROOT_SIGNATURE_FLAG_DENY_HULL_SHADER_ROOT_ACCESS |
+        D3D12_ROOT_SIGNATURE_FLAG_DENY_DOMAIN_SHADER_ROOT_ACCESS |
+        D3D12_ROOT_SIGNATURE_FLAG_DENY_GEOMETRY_SHADER_ROOT_ACCESS;
+};
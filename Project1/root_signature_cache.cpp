@@ -0,0 +1,43 @@
+// [gVOl`LbVNX
+
+#include "root_signature_cache.h"
+#include <cassert>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[gVOl`擾i΍쐬j
+ * @param	device	foCXNX̃CX^X
+ * @param	builder	[gVOl`r_[
+ * @return	[gVOl`B쐬Ɏsꍇ nullptr
+ */
+[[nodiscard]] const RootSignature* RootSignatureCache::getOrCreate(const Device& device, const RootSignatureBuilder& builder) noexcept {
+    // VACYÕCAEgň̂ŁAo^ς݂ȂVACYȗł
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (uint64_t key = builder.hash();; ++key) {
+        auto& slot = rootSignatures_[key];
+        if (!slot.rootSignature) {
+            auto rootSignature = std::make_unique<RootSignature>();
+            if (!rootSignature->create(device, builder)) {
+                rootSignatures_.erase(key);
+                return nullptr;
+            }
+            slot.builder       = builder;
+            slot.rootSignature = std::move(rootSignature);
+            return slot.rootSignature.get();
+        }
+        if (slot.builder == builder) {
+            return slot.rootSignature.get();
+        }
+        // nbVՓ˂ʂ̃CAEgB̒lT
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	o^Ă郋[gVOl`̐擾
+ * @return	[gVOl`̐
+ */
+[[nodiscard]] size_t RootSignatureCache::size() const noexcept {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return rootSignatures_.size();
+}
@@ -0,0 +1,64 @@
+// [gVOl`LbVNX
+
+#pragma once
+
+#include "device.h"
+#include "root_signature.h"
+#include "root_signature_builder.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[gVOl`LbVNX
+ * @details	r_[̓ẽnbVŃ[gVOl`L
+ *			nbVՓ˂ʂ̃CAEg̓r_[ׂČA̒lɓo^
+ *			CAEg̃}eAm͓|C^ɂȂ̂ŁA
+ *			pCvC؂ւĂ[gVOl`̍Đݒȗł
+ */
+class RootSignatureCache final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    RootSignatureCache() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~RootSignatureCache() = default;
+
+    // Rs[֎~
+    RootSignatureCache(const RootSignatureCache&) = delete;
+    RootSignatureCache& operator=(const RootSignatureCache&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[gVOl`擾i΍쐬j
+     * @param	device	foCXNX̃CX^X
+     * @param	builder	[gVOl`r_[
+     * @return	[gVOl`B쐬Ɏsꍇ nullptr
+     */
+    [[nodiscard]] const RootSignature* getOrCreate(const Device& device, const RootSignatureBuilder& builder) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	o^Ă郋[gVOl`̐擾
+     * @return	[gVOl`̐
+     */
+    [[nodiscard]] size_t size() const noexcept;
+
+private:
+    /// o^[gVOl`
+    struct Entry {
+        RootSignatureBuilder           builder{};        /// 쐬Ɏgr_[inbV̏Փ˂j
+        std::unique_ptr<RootSignature> rootSignature{};  /// 쐬[gVOl`
+    };
+
+    mutable std::mutex                  mutex_{};           /// rootSignatures_ ̕ی
+    std::unordered_map<uint64_t, Entry> rootSignatures_{};  /// nbVƂ̃[gVOl`
+};
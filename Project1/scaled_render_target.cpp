@@ -0,0 +1,204 @@
+// k`p̃_[^[QbgNX
+
+#include "scaled_render_target.h"
+#include "pipline_state_object.h"
+#include "root_signature_builder.h"
+#include <algorithm>
+#include <cassert>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+ScaledRenderTarget::~ScaledRenderTarget() {
+    if (texture_) {
+        texture_->Release();
+        texture_ = nullptr;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	device				foCXNX̃CX^X
+ * @param	rootSignatureCache	[gVOl`LbV
+ * @param	pipelineCache		pCvCXe[gLbV
+ * @param	width				ő̕isNZj
+ * @param	height				ő̍
+ * @param	outputFormat		L΂iobNobt@ǰ`
+ * @return	 true
+ */
+[[nodiscard]] bool ScaledRenderTarget::create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache,
+                                              uint32_t width, uint32_t height, DXGI_FORMAT outputFormat) noexcept {
+    assert(width > 0 && height > 0);
+    width_ = width;
+    height_ = height;
+    renderWidth_ = width;
+    renderHeight_ = height;
+
+    D3D12_HEAP_PROPERTIES heapProps{};
+    heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+    D3D12_RESOURCE_DESC resDesc{};
+    resDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    resDesc.Width = width;
+    resDesc.Height = height;
+    resDesc.DepthOrArraySize = 1;
+    resDesc.MipLevels = 1;
+    resDesc.Format = Format;
+    resDesc.SampleDesc.Count = 1;
+    resDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+    resDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+
+    // `ĂȂԂ̓VF[_ǂޏԂɂĂ
+    state_ = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    const auto res = device.get()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resDesc, state_, nullptr, IID_PPV_ARGS(&texture_));
+    if (FAILED(res)) {
+        assert(false && "k`p̃eNX`̍쐬Ɏs");
+        return false;
+    }
+
+    if (!rtvHeap_.create(device, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 1) ||
+        !srvHeap_.create(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 1, true)) {
+        return false;
+    }
+    device.get()->CreateRenderTargetView(texture_, nullptr, rtvHeap_.get()->GetCPUDescriptorHandleForHeapStart());
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+    srvDesc.Format = Format;
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.Texture2D.MipLevels = 1;
+    device.get()->CreateShaderResourceView(texture_, &srvDesc, srvHeap_.get()->GetCPUDescriptorHandleForHeapStart());
+
+    if (!shader_.create(device, L"asset/upscale.hlsl", {})) {
+        return false;
+    }
+
+    // b0: UV ̔{Əi[g萔j, t0: V[, s0: jATv[
+    RootSignatureBuilder builder;
+    builder.addConstants(4, 0, 0, D3D12_SHADER_VISIBILITY_ALL)
+        .addTable({ { D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0 } }, D3D12_SHADER_VISIBILITY_PIXEL)
+        .addStaticSampler(0, D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_TEXTURE_ADDRESS_MODE_CLAMP);
+    rootSignature_ = rootSignatureCache.getOrCreate(device, builder);
+    if (!rootSignature_) {
+        return false;
+    }
+
+    PipelineStateDesc desc = PiplineStateObject::defaultDesc();
+    desc.inputLayout.clear();
+    desc.cull = CullMode::None;
+    desc.depth = DepthMode::Disabled;
+    desc.depthStencilFormat = 0;
+    desc.renderTargetFormats[0] = static_cast<uint32_t>(outputFormat);
+    pipelineCache_ = &pipelineCache;
+    pipeline_ = pipelineCache.request(desc, shader_, *rootSignature_);
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	V[̕`n߂i_[^[QbgEr[|[gEVU[ݒ肵ăNAj
+ * @param	commandList		R}hXg
+ * @param	renderWidth		`i1 ` ő̕j
+ * @param	renderHeight	`i1 ` ő̍j
+ * @param	clearColor		NAF
+ * @param	depthStencil	ꏏɎg[xobt@iőTCYȏ̂ƁBnullptr j
+ */
+void ScaledRenderTarget::begin(ID3D12GraphicsCommandList* commandList, uint32_t renderWidth, uint32_t renderHeight, const float clearColor[4],
+                               const D3D12_CPU_DESCRIPTOR_HANDLE* depthStencil) noexcept {
+    assert(texture_ && "k`p̃_[^[Qbg쐬ł");
+    renderWidth_ = std::clamp(renderWidth, 1u, width_);
+    renderHeight_ = std::clamp(renderHeight, 1u, height_);
+
+    if (state_ != D3D12_RESOURCE_STATE_RENDER_TARGET) {
+        D3D12_RESOURCE_BARRIER barrier{};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Transition.pResource = texture_;
+        barrier.Transition.StateBefore = state_;
+        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        commandList->ResourceBarrier(1, &barrier);
+        state_ = D3D12_RESOURCE_STATE_RENDER_TARGET;
+    }
+
+    D3D12_VIEWPORT viewport{};
+    viewport.Width = float(renderWidth_);
+    viewport.Height = float(renderHeight_);
+    viewport.MinDepth = 0.0f;
+    viewport.MaxDepth = 1.0f;
+
+    D3D12_RECT scissor{};
+    scissor.right = LONG(renderWidth_);
+    scissor.bottom = LONG(renderHeight_);
+
+    const auto rtv = rtvHeap_.get()->GetCPUDescriptorHandleForHeapStart();
+    commandList->RSSetViewports(1, &viewport);
+    commandList->RSSetScissorRects(1, &scissor);
+    commandList->OMSetRenderTargets(1, &rtv, FALSE, depthStencil);
+
+    // `͈͂NA
+    commandList->ClearRenderTargetView(rtv, clearColor, 1, &scissor);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`͈͂L΂ĕ`
+ * @param	commandList	R}hXgiL΂̃_[^[Qbgƃr[|[g͐ݒς݂̂Ɓj
+ * @return	` trueBpCvC쐬Ȃ牽 false
+ */
+[[nodiscard]] bool ScaledRenderTarget::upscale(ID3D12GraphicsCommandList* commandList) noexcept {
+    assert(texture_ && "k`p̃_[^[Qbg쐬ł");
+
+    ID3D12PipelineState* pipelineState = pipelineCache_->get(pipeline_);
+    if (!pipelineState) {
+        return false;
+    }
+
+    if (state_ != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE) {
+        D3D12_RESOURCE_BARRIER barrier{};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Transition.pResource = texture_;
+        barrier.Transition.StateBefore = state_;
+        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        commandList->ResourceBarrier(1, &barrier);
+        state_ = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    }
+
+    // `͈͂̒[甼eNZ܂łɗ߁A͈͊ǑÂeɂ܂Ȃ悤ɂ
+    const float constants[4] = {
+        float(renderWidth_) / float(width_),
+        float(renderHeight_) / float(height_),
+        (float(renderWidth_) - 0.5f) / float(width_),
+        (float(renderHeight_) - 0.5f) / float(height_),
+    };
+
+    ID3D12DescriptorHeap* heaps[] = { srvHeap_.get() };
+    commandList->SetDescriptorHeaps(1, heaps);
+    commandList->SetGraphicsRootSignature(rootSignature_->get());
+    commandList->SetPipelineState(pipelineState);
+    commandList->SetGraphicsRoot32BitConstants(0, 4, constants, 0);
+    commandList->SetGraphicsRootDescriptorTable(1, srvHeap_.get()->GetGPUDescriptorHandleForHeapStart());
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    commandList->DrawInstanced(3, 1, 0, 0);
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ő̕擾
+ * @return	sNZ
+ */
+[[nodiscard]] uint32_t ScaledRenderTarget::width() const noexcept {
+    return width_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ő̍擾
+ * @return	sNZ
+ */
+[[nodiscard]] uint32_t ScaledRenderTarget::height() const noexcept {
+    return height_;
+}
@@ -0,0 +1,102 @@
+// k`p̃_[^[QbgNX
+
+#pragma once
+
+#include "descriptor_heap.h"
+#include "device.h"
+#include "pipeline_state_cache.h"
+#include "root_signature_cache.h"
+#include "shader.h"
+#include <cstdint>
+#include <d3d12.h>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	k`p̃_[^[QbgNX
+ * @details	őTCỸeNX` 1 A3D V[͂̍̈ꕔir[|[gŌ߂jɕ`
+ *			`͈͂oCjAŃobNobt@ŜɈL΂B傫t[ςĂ\[X͍蒼Ȃ
+ */
+class ScaledRenderTarget final {
+public:
+    /// F̌`
+    static constexpr DXGI_FORMAT Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    ScaledRenderTarget() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~ScaledRenderTarget();
+
+    // Rs[֎~
+    ScaledRenderTarget(const ScaledRenderTarget&) = delete;
+    ScaledRenderTarget& operator=(const ScaledRenderTarget&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	device				foCXNX̃CX^X
+     * @param	rootSignatureCache	[gVOl`LbV
+     * @param	pipelineCache		pCvCXe[gLbV
+     * @param	width				ő̕isNZj
+     * @param	height				ő̍
+     * @param	outputFormat		L΂iobNobt@ǰ`
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache, uint32_t width,
+                              uint32_t height, DXGI_FORMAT outputFormat) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	V[̕`n߂i_[^[QbgEr[|[gEVU[ݒ肵ăNAj
+     * @param	commandList		R}hXg
+     * @param	renderWidth		`i1 ` ő̕j
+     * @param	renderHeight	`i1 ` ő̍j
+     * @param	clearColor		NAF
+     * @param	depthStencil	ꏏɎg[xobt@iőTCYȏ̂ƁBnullptr j
+     */
+    void begin(ID3D12GraphicsCommandList* commandList, uint32_t renderWidth, uint32_t renderHeight, const float clearColor[4],
+               const D3D12_CPU_DESCRIPTOR_HANDLE* depthStencil) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	`͈͂L΂ĕ`
+     * @param	commandList	R}hXgiL΂̃_[^[Qbgƃr[|[g͐ݒς݂̂Ɓj
+     * @return	` trueBpCvC쐬Ȃ牽 falseiĂяoňL΂NAj
+     * @details	begin Ɠ傫ŕ`͈͂g
+     */
+    [[nodiscard]] bool upscale(ID3D12GraphicsCommandList* commandList) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ő̕擾
+     * @return	sNZ
+     */
+    [[nodiscard]] uint32_t width() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ő̍擾
+     * @return	sNZ
+     */
+    [[nodiscard]] uint32_t height() const noexcept;
+
+private:
+    Shader                     shader_{};              /// L΂pVF[_
+    const RootSignature*       rootSignature_{};       /// [gVOl`iLbVLj
+    PipelineStateCache*        pipelineCache_{};       /// pCvCXe[gLbV
+    PipelineStateCache::Handle pipeline_{};            /// L΂ppCvC
+    DescriptorHeap             rtvHeap_{};             /// RTV 1 
+    DescriptorHeap             srvHeap_{};             /// SRV 1 iVF[_猩j
+    ID3D12Resource*            texture_{};             /// V[`eNX`
+    D3D12_RESOURCE_STATES      state_{};               /// eNX`̍̏
+    uint32_t                   width_{};               /// ő̕
+    uint32_t                   height_{};              /// ő̍
+    uint32_t                   renderWidth_{};         /// ̃t[ŕ`
+    uint32_t                   renderHeight_{};        /// ̃t[ŕ`
+};
@@ -0,0 +1,514 @@
+// V[t@Ciǂݍ݂̑D悵oCi`j
+
+#include "scene_file.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr uint32_t SceneMagic = 0x454E4353;  // "SCNE"
+constexpr uint32_t SceneVersion = 1;
+
+/// R|[lg̔z̃ACgiSIMD ł̂܂ܓǂ߂悤Ɂj
+constexpr uint64_t ColumnAlignment = 16;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	l𑵂
+ */
+constexpr uint64_t alignUp(uint64_t value, uint64_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+/// õt@C
+struct SceneWriter {
+    std::vector<uint8_t>                      buffer{};         ///< t@C̒g
+    std::vector<uint64_t>                     fixups{};         ///< ScenePointer ̏ꏊ
+    std::vector<uint32_t>                     stringOffsets{};  ///< 񂲂Ƃ̊Jnʒu
+    std::string                               characters{};     ///< 
+    std::unordered_map<std::string, uint32_t> strings{};        ///< 񂩂ԍ
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̈mۂi0 Ŗ߂j
+     * @return	t@C̐擪̃oCgʒu
+     */
+    uint64_t allocate(uint64_t bytes, uint64_t alignment) {
+        const uint64_t offset = alignUp(buffer.size(), alignment);
+        buffer.resize(offset + bytes);
+        return offset;
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	l
+     */
+    template <typename T>
+    void write(uint64_t offset, const T& value) noexcept {
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	|C^[Afix-up ̕\ɍڂ
+     */
+    void setPointer(uint64_t field, uint64_t target) {
+        write(field, target);
+        fixups.push_back(field);
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	\ɑi 1 ɂ܂Ƃ߂j
+     * @return	̔ԍ
+     */
+    uint32_t addString(const char* text) {
+        const auto found = strings.find(text);
+        if (found != strings.end()) {
+            return found->second;
+        }
+        const uint32_t index = static_cast<uint32_t>(stringOffsets.size());
+        stringOffsets.push_back(static_cast<uint32_t>(characters.size()));
+        characters.append(text);
+        characters.push_back('\0');
+        strings.emplace(text, index);
+        return index;
+    }
+};
+
+/// oA[L^CvicollectChunks őĕԓgݍ킹̃`Nj
+struct ArchetypeRange {
+    ComponentMask mask;         ///< R|[lg̑gݍ킹
+    uint32_t      firstChunk;   ///< ŏ̃`N
+    uint32_t      chunkCount;   ///< `N
+    uint32_t      entityCount;  ///< GeBeB
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`ÑR|[lg̑gݍ킹߂
+ */
+ComponentMask chunkMask(const ChunkView& chunk) noexcept {
+    ComponentMask mask = 0;
+    for (ComponentId id = 0; id < componentCount(); ++id) {
+        if (chunk.column(id)) {
+            mask |= ComponentMask{ 1 } << id;
+        }
+    }
+    return mask;
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[h̃GeBeBV[t@Cɏo
+ * @param	path	t@CpX
+ * @param	world	[hiSẴGeBeBj
+ * @param	nameOf	GeBeB̖OԂiΖOȂBnullptr ԂGeBeBOj
+ * @return	 true
+ */
+bool saveScene(const std::string& path, EntityWorld& world, const std::function<const char*(Entity)>& nameOf) {
+    // SẴ`NA[L^CvƂɂ܂Ƃ߂
+    std::vector<ChunkView> chunks;
+    world.collectChunks(world.createQuery(0), chunks);
+    std::vector<ArchetypeRange> ranges;
+    ComponentMask               used = 0;
+    for (uint32_t i = 0; i < chunks.size(); ++i) {
+        const ComponentMask mask = chunkMask(chunks[i]);
+        if (ranges.empty() || ranges.back().mask != mask) {
+            ranges.push_back({ mask, i, 0, 0 });
+            used |= mask;
+        }
+        ++ranges.back().chunkCount;
+        ranges.back().entityCount += chunks[i].size();
+    }
+
+    SceneWriter writer;
+    const uint64_t header = writer.allocate(sizeof(SceneFileHeader), 8);
+
+    // R|[lg̎ށit@C̒̔ԍUj
+    std::vector<uint32_t>    fileComponents(MaxComponents, UINT32_MAX);
+    std::vector<ComponentId> usedIds;
+    for (ComponentId id = 0; id < MaxComponents; ++id) {
+        if (used & (ComponentMask{ 1 } << id)) {
+            fileComponents[id] = static_cast<uint32_t>(usedIds.size());
+            usedIds.push_back(id);
+        }
+    }
+    const uint64_t components = writer.allocate(sizeof(SceneComponent) * usedIds.size(), 8);
+    for (uint32_t i = 0; i < usedIds.size(); ++i) {
+        const ComponentInfo& info = componentInfo(usedIds[i]);
+        writer.write(components + sizeof(SceneComponent) * i, SceneComponent{ writer.addString(info.name), info.size, info.alignment, 0 });
+    }
+
+    // A[L^CvƂɗ̔z`N瑱Ďʂ
+    const uint64_t archetypes = writer.allocate(sizeof(SceneArchetype) * ranges.size(), 8);
+    uint32_t       entityCount = 0;
+    for (uint32_t a = 0; a < ranges.size(); ++a) {
+        const ArchetypeRange& range = ranges[a];
+        const uint64_t        archetype = archetypes + sizeof(SceneArchetype) * a;
+        std::vector<ComponentId> ids;
+        for (const ComponentId id : usedIds) {
+            if (range.mask & (ComponentMask{ 1 } << id)) {
+                ids.push_back(id);
+            }
+        }
+        writer.write(archetype + offsetof(SceneArchetype, entityCount), range.entityCount);
+        writer.write(archetype + offsetof(SceneArchetype, columnCount), static_cast<uint32_t>(ids.size()));
+        entityCount += range.entityCount;
+
+        if (!ids.empty()) {
+            const uint64_t columns = writer.allocate(sizeof(SceneColumn) * ids.size(), 8);
+            writer.setPointer(archetype + offsetof(SceneArchetype, columns), columns);
+            for (uint32_t c = 0; c < ids.size(); ++c) {
+                const uint32_t size = componentInfo(ids[c]).size;
+                const uint64_t column = columns + sizeof(SceneColumn) * c;
+                const uint64_t data = writer.allocate(uint64_t(size) * range.entityCount, ColumnAlignment);
+                writer.write(column + offsetof(SceneColumn, component), fileComponents[ids[c]]);
+                writer.setPointer(column + offsetof(SceneColumn, data), data);
+                uint64_t position = data;
+                for (uint32_t chunk = range.firstChunk; chunk < range.firstChunk + range.chunkCount; ++chunk) {
+                    const uint64_t bytes = uint64_t(size) * chunks[chunk].size();
+                    std::memcpy(writer.buffer.data() + position, chunks[chunk].column(ids[c]), bytes);
+                    position += bytes;
+                }
+            }
+        }
+
+        if (nameOf) {
+            const uint64_t names = writer.allocate(sizeof(uint32_t) * range.entityCount, 8);
+            writer.setPointer(archetype + offsetof(SceneArchetype, names), names);
+            uint32_t row = 0;
+            for (uint32_t chunk = range.firstChunk; chunk < range.firstChunk + range.chunkCount; ++chunk) {
+                for (uint32_t i = 0; i < chunks[chunk].size(); ++i, ++row) {
+                    const char* name = nameOf(chunks[chunk].entities()[i]);
+                    writer.write(names + sizeof(uint32_t) * row, name ? writer.addString(name) : UINT32_MAX);
+                }
+            }
+        }
+    }
+
+    // ̕\u
+    const uint64_t stringOffsets = writer.allocate(sizeof(uint32_t) * writer.stringOffsets.size(), 8);
+    const uint64_t characters = writer.allocate(writer.characters.size(), 8);
+    if (!writer.stringOffsets.empty()) {
+        std::memcpy(writer.buffer.data() + stringOffsets, writer.stringOffsets.data(), sizeof(uint32_t) * writer.stringOffsets.size());
+        std::memcpy(writer.buffer.data() + characters, writer.characters.data(), writer.characters.size());
+    }
+
+    // 擪̃|C^[ fix-up ̕\ɍڂĂ\
+    SceneFileHeader fileHeader{};
+    fileHeader.magic = SceneMagic;
+    fileHeader.version = SceneVersion;
+    fileHeader.componentCount = static_cast<uint32_t>(usedIds.size());
+    fileHeader.archetypeCount = static_cast<uint32_t>(ranges.size());
+    fileHeader.entityCount = entityCount;
+    fileHeader.stringCount = static_cast<uint32_t>(writer.stringOffsets.size());
+    fileHeader.characterBytes = writer.characters.size();
+    writer.write(header, fileHeader);
+    if (!usedIds.empty()) {
+        writer.setPointer(header + offsetof(SceneFileHeader, components), components);
+    }
+    if (!ranges.empty()) {
+        writer.setPointer(header + offsetof(SceneFileHeader, archetypes), archetypes);
+    }
+    if (!writer.stringOffsets.empty()) {
+        writer.setPointer(header + offsetof(SceneFileHeader, stringOffsets), stringOffsets);
+        writer.setPointer(header + offsetof(SceneFileHeader, characters), characters);
+    }
+    const uint64_t fixups = writer.allocate(sizeof(uint64_t) * writer.fixups.size(), 8);
+    if (!writer.fixups.empty()) {
+        std::memcpy(writer.buffer.data() + fixups, writer.fixups.data(), sizeof(uint64_t) * writer.fixups.size());
+    }
+    writer.write(header + offsetof(SceneFileHeader, fixupCount), uint64_t(writer.fixups.size()));
+    writer.write(header + offsetof(SceneFileHeader, fixups), fixups);
+    writer.allocate(0, 8);
+    writer.write(header + offsetof(SceneFileHeader, fileBytes), uint64_t(writer.buffer.size()));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(writer.buffer.data()), static_cast<std::streamsize>(writer.buffer.size()));
+    return static_cast<bool>(file);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+SceneFile::~SceneFile() {
+    close();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t@CJ
+ * @param	path	t@CpX
+ * @return	 truei`łႤAgĂꍇ falsej
+ */
+bool SceneFile::open(const std::string& path) {
+    close();
+#if defined(_WIN32)
+    // ʂ݂Ŋ蓖Ă̂ŁAfix-up ̏̓t@Cɖ߂Ȃ
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(SceneFileHeader))) {
+        CloseHandle(file);
+        return false;
+    }
+    mapping_ = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping_) {
+        return false;
+    }
+    base_ = static_cast<uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_COPY, 0, 0, 0));
+    bytes_ = static_cast<uint64_t>(size.QuadPart);
+#else
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return false;
+    }
+    struct stat status {};
+    if (fstat(file, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(SceneFileHeader))) {
+        ::close(file);
+        return false;
+    }
+    void* address = mmap(nullptr, static_cast<size_t>(status.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (address == MAP_FAILED) {
+        return false;
+    }
+    base_ = static_cast<uint8_t*>(address);
+    bytes_ = static_cast<uint64_t>(status.st_size);
+#endif
+    if (!base_ || !relocate()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t@C
+ */
+void SceneFile::close() noexcept {
+#if defined(_WIN32)
+    if (base_) {
+        UnmapViewOfFile(base_);
+    }
+    if (mapping_) {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+    }
+#else
+    if (base_) {
+        munmap(base_, static_cast<size_t>(bytes_));
+    }
+#endif
+    base_ = nullptr;
+    bytes_ = 0;
+    header_ = nullptr;
+    archetypeBegins_.clear();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeB[hɍ
+ * @param	world		쐬
+ * @param	entities	GeBeB̒ǉit@C̕яBnullptr ȂԂȂj
+ * @return	 trueit@C̃R|[lg[hɓo^ĂȂ傫Ⴆ falsej
+ */
+bool SceneFile::instantiate(EntityWorld& world, std::vector<Entity>* entities) const {
+    if (!header_) {
+        return false;
+    }
+
+    // ɑSĂ̖OĂArŎsă[hɔ[ɍȂ悤ɂ
+    std::vector<ComponentId> ids(header_->componentCount);
+    for (uint32_t i = 0; i < header_->componentCount; ++i) {
+        const SceneComponent& component = header_->components.pointer[i];
+        ids[i] = findComponent(string(component.name));
+        if (ids[i] == UINT32_MAX || componentInfo(ids[i]).size != component.size) {
+            return false;
+        }
+    }
+    std::vector<ComponentMask> masks(header_->archetypeCount);
+    for (uint32_t a = 0; a < header_->archetypeCount; ++a) {
+        const SceneArchetype& archetype = header_->archetypes.pointer[a];
+        for (uint32_t c = 0; c < archetype.columnCount; ++c) {
+            const ComponentMask bit = ComponentMask{ 1 } << ids[archetype.columns.pointer[c].component];
+            if (masks[a] & bit) {
+                return false;
+            }
+            masks[a] |= bit;
+        }
+    }
+
+    if (entities) {
+        entities->reserve(entities->size() + header_->entityCount);
+    }
+    for (uint32_t a = 0; a < header_->archetypeCount; ++a) {
+        const SceneArchetype& archetype = header_->archetypes.pointer[a];
+        world.createBatch(masks[a], archetype.entityCount, [&](const ChunkView& chunk, uint32_t row, uint32_t first) {
+            const uint32_t count = chunk.size() - row;
+            for (uint32_t c = 0; c < archetype.columnCount; ++c) {
+                const SceneColumn& column = archetype.columns.pointer[c];
+                const uint32_t     size = header_->components.pointer[column.component].size;
+                std::memcpy(static_cast<uint8_t*>(chunk.column(ids[column.component])) + size_t(size) * row, column.data.pointer + size_t(size) * first,
+                            size_t(size) * count);
+            }
+            if (entities) {
+                entities->insert(entities->end(), chunk.entities() + row, chunk.entities() + chunk.size());
+            }
+        });
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeB擾
+ * @return	GeBeB
+ */
+uint32_t SceneFile::entityCount() const noexcept {
+    return header_ ? header_->entityCount : 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	GeBeB̖O擾
+ * @param	index	t@C̕я̔ԍiinstantiate ŕԂтƓj
+ * @return	Oi nullptrj
+ */
+const char* SceneFile::entityName(uint32_t index) const noexcept {
+    if (index >= entityCount()) {
+        return nullptr;
+    }
+    const auto            found = std::upper_bound(archetypeBegins_.begin(), archetypeBegins_.end(), index) - 1;
+    const SceneArchetype& archetype = header_->archetypes.pointer[found - archetypeBegins_.begin()];
+    if (!archetype.names.pointer) {
+        return nullptr;
+    }
+    const uint32_t name = archetype.names.pointer[index - *found];
+    return name == UINT32_MAX ? nullptr : string(name);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	擾
+ * @param	index	̔ԍ
+ * @return	
+ */
+const char* SceneFile::string(uint32_t index) const noexcept {
+    return header_->characters.pointer + header_->stringOffsets.pointer[index];
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	fix-up 𓖂āAgt@CɎ܂邱Ƃm߂
+ */
+bool SceneFile::relocate() noexcept {
+    SceneFileHeader* header = reinterpret_cast<SceneFileHeader*>(base_);
+    if (header->magic != SceneMagic || header->version != SceneVersion || header->fileBytes != bytes_) {
+        return false;
+    }
+
+    // fix-up ̕\̓t@CɎ܂Aꏊ͕\O 8 oCgEɂ邱
+    const uint64_t table = header->fixups;
+    if (table % 8 != 0 || table > bytes_ || header->fixupCount > (bytes_ - table) / sizeof(uint64_t)) {
+        return false;
+    }
+    const uint64_t* fixups = reinterpret_cast<const uint64_t*>(base_ + table);
+    for (uint64_t i = 0; i < header->fixupCount; ++i) {
+        const uint64_t position = fixups[i];
+        if (position % 8 != 0 || position + sizeof(uint64_t) > table) {
+            return false;
+        }
+        uint64_t& field = *reinterpret_cast<uint64_t*>(base_ + position);
+        if (field == 0) {
+            continue;
+        }
+        // ꏊ 2 ڂĂ 2 ڂ̓t@C̊OŵŁAŒe
+        if (field >= bytes_) {
+            return false;
+        }
+        field = reinterpret_cast<uintptr_t>(base_) + field;
+    }
+
+    // |C^[wz񂪃t@CɎ܂邱
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(base_);
+    const uintptr_t end = begin + bytes_;
+    const auto      inFile = [&](const void* pointer, uint64_t count, uint64_t size, uint64_t alignment) {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+        if (count == 0) {
+            return true;
+        }
+        return address >= begin && address < end && address % alignment == 0 && count <= (end - address) / size;
+    };
+    if (!inFile(header->stringOffsets.pointer, header->stringCount, sizeof(uint32_t), alignof(uint32_t)) ||
+        !inFile(header->characters.pointer, header->characterBytes, 1, 1) ||
+        !inFile(header->components.pointer, header->componentCount, sizeof(SceneComponent), 8) ||
+        !inFile(header->archetypes.pointer, header->archetypeCount, sizeof(SceneArchetype), 8)) {
+        return false;
+    }
+    if (header->stringCount > 0 && (header->characterBytes == 0 || header->characters.pointer[header->characterBytes - 1] != '\0')) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->stringCount; ++i) {
+        if (header->stringOffsets.pointer[i] >= header->characterBytes) {
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < header->componentCount; ++i) {
+        const SceneComponent& component = header->components.pointer[i];
+        if (component.name >= header->stringCount || component.size == 0) {
+            return false;
+        }
+    }
+
+    uint64_t total = 0;
+    archetypeBegins_.resize(header->archetypeCount);
+    for (uint32_t a = 0; a < header->archetypeCount; ++a) {
+        const SceneArchetype& archetype = header->archetypes.pointer[a];
+        if (!inFile(archetype.columns.pointer, archetype.columnCount, sizeof(SceneColumn), 8) ||
+            !inFile(archetype.names.pointer, archetype.names.pointer ? archetype.entityCount : 0, sizeof(uint32_t), alignof(uint32_t))) {
+            return false;
+        }
+        for (uint32_t c = 0; c < archetype.columnCount; ++c) {
+            const SceneColumn& column = archetype.columns.pointer[c];
+            if (column.component >= header->componentCount ||
+                !inFile(column.data.pointer, archetype.entityCount, header->components.pointer[column.component].size, 1)) {
+                return false;
+            }
+        }
+        if (archetype.names.pointer) {
+            for (uint32_t i = 0; i < archetype.entityCount; ++i) {
+                if (archetype.names.pointer[i] != UINT32_MAX && archetype.names.pointer[i] >= header->stringCount) {
+                    return false;
+                }
+            }
+        }
+        archetypeBegins_[a] = static_cast<uint32_t>(total);
+        total += archetype.entityCount;
+    }
+    if (total != header->entityCount) {
+        return false;
+    }
+    header_ = header;
+    return true;
+}
@@ -0,0 +1,166 @@
+// V[t@Ciǂݍ݂̑D悵oCi`j
+
+#pragma once
+
+#include "entity_world.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// t@C̕сiS 8 oCgEBR|[lg̔z 16 oCgEj
+//   SceneFileHeader
+//   SceneComponent ~ componentCount       R|[lg̖Oi̔ԍjƃoCg
+//   SceneArchetype ~ archetypeCount       A[L^CvƂ̃GeBeBƗ
+//   SceneColumn ~ columnCount / z       񂲂Ƃ̃R|[lg̔zi`Nւ̂܂ memcpy łj
+//   uint32_t ~ entityCount                GeBeB̖Oi̔ԍj
+//   ̊Jnʒu /                   \i'\0' ؂j
+//   uint64_t ~ fixupCount                 ScenePointer ̏ꏊ
+// |C^[̓t@C̐擪̃oCgʒuŏAǂݍݎ fix-up ̕\̏ꏊ擪̃AhX𑫂ă|C^[ɂ
+
+/// t@Cw|C^[it@Cł͐擪̃oCgʒuB0 ͖j
+template <typename T>
+union ScenePointer {
+    uint64_t offset;   ///< t@C̐擪̃oCgʒu
+    T*       pointer;  ///< ǂݍ݌̃AhX
+};
+static_assert(sizeof(ScenePointer<const char>) == 8, "ScenePointer  8 oCgɂ");
+
+/// R|[lg̎
+struct SceneComponent {
+    uint32_t name;       ///< Oi̔ԍj
+    uint32_t size;       ///< oCg
+    uint32_t alignment;  ///< ACg
+    uint32_t reserved;   ///< \
+};
+
+/// i1 ނ̃R|[lg̔zj
+struct SceneColumn {
+    uint32_t                    component;  ///< R|[lg̎ށiSceneComponent ̔ԍj
+    uint32_t                    reserved;   ///< \
+    ScenePointer<const uint8_t> data;       ///< GeBeB̔z
+};
+
+/// A[L^Cv
+struct SceneArchetype {
+    uint32_t                        entityCount;  ///< GeBeB
+    uint32_t                        columnCount;  ///< ̐
+    ScenePointer<const SceneColumn> columns;      ///< 
+    ScenePointer<const uint32_t>    names;        ///< GeBeB̖Oi̔ԍBO UINT32_MAXj
+};
+
+/// t@C̐擪
+struct SceneFileHeader {
+    uint32_t                           magic;           ///< SceneMagic
+    uint32_t                           version;         ///< SceneVersion
+    uint64_t                           fileBytes;       ///< t@C̃oCg
+    uint32_t                           componentCount;  ///< R|[lg̎ނ̐
+    uint32_t                           archetypeCount;  ///< A[L^Cv̐
+    uint32_t                           entityCount;     ///< GeBeB
+    uint32_t                           stringCount;     ///< ̐
+    uint64_t                           characterBytes;  ///< ̃oCg
+    uint64_t                           fixupCount;      ///< fix-up ̐
+    ScenePointer<const SceneComponent> components;      ///< R|[lg̎
+    ScenePointer<const SceneArchetype> archetypes;      ///< A[L^Cv
+    ScenePointer<const uint32_t>       stringOffsets;   ///< 񂲂Ƃ̊Jnʒu
+    ScenePointer<const char>           characters;      ///< 
+    uint64_t                           fixups;          ///< fix-up ̕\̈ʒuiScenePointer ̏ꏊ̕сj
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[h̃GeBeBV[t@Cɏo
+ * @param	path	t@CpX
+ * @param	world	[hiSẴGeBeBj
+ * @param	nameOf	GeBeB̖OԂiΖOȂBnullptr ԂGeBeBOj
+ * @return	 true
+ */
+[[nodiscard]] bool saveScene(const std::string& path, EntityWorld& world, const std::function<const char*(Entity)>& nameOf = {});
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	V[t@CNX
+ * @details	t@C 1 񃁃Ɋ蓖āi͎茳Ɏcʂ݁jAfix-up ̕\̏ꏊ|C^[ɒ
+ *			IuWFNgƂ̉߂͖Ainstantiate ̓A[L^Cv̗`Nւ̂܂ memcpy 
+ *			ꂽt@CŔ͈͊Oǂ܂Ȃ悤Aopen Ń|C^[Ɣz񂪑Săt@CɎ܂邱Ƃm߂
+ */
+class SceneFile final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    SceneFile() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~SceneFile();
+
+    // Rs[֎~
+    SceneFile(const SceneFile&) = delete;
+    SceneFile& operator=(const SceneFile&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	t@CJ
+     * @param	path	t@CpX
+     * @return	 truei`łႤAgĂꍇ falsej
+     */
+    [[nodiscard]] bool open(const std::string& path);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	t@C
+     */
+    void close() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeB[hɍ
+     * @param	world		쐬
+     * @param	entities	GeBeB̒ǉit@C̕яBnullptr ȂԂȂj
+     * @return	 trueit@C̃R|[lg[hɓo^ĂȂ傫Ⴆ falsej
+     * @details	R|[lg componentId<T>() Őɓo^Ă
+     */
+    [[nodiscard]] bool instantiate(EntityWorld& world, std::vector<Entity>* entities = nullptr) const;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeB擾
+     * @return	GeBeB
+     */
+    [[nodiscard]] uint32_t entityCount() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	GeBeB̖O擾
+     * @param	index	t@C̕я̔ԍiinstantiate ŕԂтƓj
+     * @return	Oi nullptrj
+     */
+    [[nodiscard]] const char* entityName(uint32_t index) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	擾
+     * @param	index	̔ԍ
+     * @return	
+     */
+    [[nodiscard]] const char* string(uint32_t index) const noexcept;
+
+private:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	fix-up 𓖂āAgt@CɎ܂邱Ƃm߂
+     */
+    bool relocate() noexcept;
+
+    uint8_t*               base_{};             /// 蓖ĂAhX
+    uint64_t               bytes_{};            /// t@C̃oCg
+    const SceneFileHeader* header_{};           /// t@C̐擪
+    std::vector<uint32_t>  archetypeBegins_{};  /// A[L^CvƂ̍ŏ̃GeBeB̔ԍ
+#if defined(_WIN32)
+    void*                  mapping_{};          /// t@C}bsÕnh
+#endif
+};
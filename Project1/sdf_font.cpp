@@ -0,0 +1,123 @@
+// SDF tHg
+
+#include "sdf_font.h"
+#include <algorithm>
+#include <fstream>
+
+namespace {
+
+/// t@C̐擪
+struct SdfFontFileHeader {
+    uint32_t magic;          ///< SdfFontMagic
+    uint32_t version;        ///< SdfFontVersion
+    uint32_t atlasWidth;     ///< AgX̕
+    uint32_t atlasHeight;    ///< AgX̍
+    uint32_t glyphCount;     ///< 
+    float    baseSize;       ///< Ă̑̕傫
+    float    distanceRange;  ///< ̕
+    float    lineHeight;     ///< s̑
+    float    ascent;         ///< s̏[x[XC܂
+};
+
+constexpr uint32_t SdfFontMagic = 0x46464453;  // "SDFF"
+constexpr uint32_t SdfFontVersion = 1;
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R[h|CgɕׁAASCII ̈\
+ * @param	font	tHg
+ */
+void indexSdfFontGlyphs(SdfFont& font) {
+    std::sort(font.glyphs.begin(), font.glyphs.end(), [](const SdfGlyph& a, const SdfGlyph& b) { return a.codepoint < b.codepoint; });
+    font.asciiGlyphs.fill(-1);
+    for (size_t i = 0; i < font.glyphs.size() && font.glyphs[i].codepoint < font.asciiGlyphs.size(); ++i) {
+        font.asciiGlyphs[font.glyphs[i].codepoint] = static_cast<int16_t>(i);
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	T
+ * @param	font		tHg
+ * @param	codepoint	R[h|Cg
+ * @return	B nullptr
+ */
+[[nodiscard]] const SdfGlyph* findSdfGlyph(const SdfFont& font, uint32_t codepoint) noexcept {
+    // قƂǂ̕ ASCII Ȃ̂ŕ\ň
+    if (codepoint < font.asciiGlyphs.size()) {
+        const int16_t index = font.asciiGlyphs[codepoint];
+        return index >= 0 ? &font.glyphs[index] : nullptr;
+    }
+    const auto it = std::lower_bound(font.glyphs.begin(), font.glyphs.end(), codepoint,
+                                     [](const SdfGlyph& glyph, uint32_t value) { return glyph.codepoint < value; });
+    return it != font.glyphs.end() && it->codepoint == codepoint ? &*it : nullptr;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	tHgt@Cɏo
+ * @param	path	t@CpX
+ * @param	font	tHg
+ * @return	 true
+ */
+[[nodiscard]] bool saveSdfFont(const std::string& path, const SdfFont& font) {
+    SdfFontFileHeader header{};
+    header.magic = SdfFontMagic;
+    header.version = SdfFontVersion;
+    header.atlasWidth = font.atlasWidth;
+    header.atlasHeight = font.atlasHeight;
+    header.glyphCount = static_cast<uint32_t>(font.glyphs.size());
+    header.baseSize = font.baseSize;
+    header.distanceRange = font.distanceRange;
+    header.lineHeight = font.lineHeight;
+    header.ascent = font.ascent;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(font.glyphs.data()), static_cast<std::streamsize>(font.glyphs.size() * sizeof(SdfGlyph)));
+    file.write(reinterpret_cast<const char*>(font.atlas.data()), static_cast<std::streamsize>(font.atlas.size()));
+    return static_cast<bool>(file);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	tHgt@Cǂݍ
+ * @param	path	t@CpX
+ * @param	font	ǂݍݐ
+ * @return	 truei`łႤꍇ falsej
+ */
+[[nodiscard]] bool loadSdfFont(const std::string& path, SdfFont& font) {
+    std::ifstream     file(path, std::ios::binary);
+    SdfFontFileHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+    if (header.magic != SdfFontMagic || header.version != SdfFontVersion || header.baseSize <= 0.0f) {
+        return false;
+    }
+
+    font.atlasWidth = header.atlasWidth;
+    font.atlasHeight = header.atlasHeight;
+    font.baseSize = header.baseSize;
+    font.distanceRange = header.distanceRange;
+    font.lineHeight = header.lineHeight;
+    font.ascent = header.ascent;
+    font.glyphs.resize(header.glyphCount);
+    font.atlas.resize(size_t(header.atlasWidth) * header.atlasHeight);
+    file.read(reinterpret_cast<char*>(font.glyphs.data()), static_cast<std::streamsize>(font.glyphs.size() * sizeof(SdfGlyph)));
+    file.read(reinterpret_cast<char*>(font.atlas.data()), static_cast<std::streamsize>(font.atlas.size()));
+    if (!file) {
+        return false;
+    }
+
+    // ꂽt@CŃAgX̊OwȂ悤ɂ
+    for (const auto& glyph : font.glyphs) {
+        if (uint32_t(glyph.x) + glyph.width > header.atlasWidth || uint32_t(glyph.y) + glyph.height > header.atlasHeight) {
+            return false;
+        }
+    }
+    indexSdfFontGlyphs(font);
+    return true;
+}
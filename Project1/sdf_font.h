@@ -0,0 +1,68 @@
+// SDF tHg
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+///  1 iW͏Ă傫̃sNZAY ͉j
+struct SdfGlyph {
+    uint32_t codepoint;  ///< Unicode ̃R[h|Cg
+    uint16_t x;          ///< AgX̍ X
+    uint16_t y;          ///< AgX̍ Y
+    uint16_t width;      ///< AgX̕i0 Ȃ`B󔒂Ȃǁj
+    uint16_t height;     ///< AgX̍
+    float    offsetX;    ///< yʒuix[XCj猩lp`̍ X
+    float    offsetY;    ///< yʒu猩lp`̍ Yix[XCȂ畉j
+    float    advance;    ///< ̕܂ł̑
+};
+static_assert(sizeof(SdfGlyph) == 24, "SdfGlyph  24 oCgɂ");
+
+/// SDF tHgitools/sdf_font_baker ŏĂj
+struct SdfFont {
+    uint32_t                    atlasWidth{};     ///< AgX̕
+    uint32_t                    atlasHeight{};    ///< AgX̍
+    float                       baseSize{};       ///< Ă̑̕傫isNZj
+    float                       distanceRange{};  ///< AgX̒l 0`1 \̕iĂ傫̃sNZA0.5 ֊sj
+    float                       lineHeight{};     ///< s̑
+    float                       ascent{};         ///< s̏[x[XC܂
+    std::vector<SdfGlyph>       glyphs{};         ///< iR[h|Cgj
+    std::vector<uint8_t>        atlas{};          ///< AgXiR8AatlasWidth x atlasHeightj
+    std::array<int16_t, 128>    asciiGlyphs{};    ///< ASCII ̔̕ԍi -1BindexSdfFontGlyphs ōj
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	R[h|CgɕׁAASCII ̈\
+ * @param	font	tHg
+ */
+void indexSdfFontGlyphs(SdfFont& font);
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	T
+ * @param	font		tHg
+ * @param	codepoint	R[h|Cg
+ * @return	B nullptr
+ */
+[[nodiscard]] const SdfGlyph* findSdfGlyph(const SdfFont& font, uint32_t codepoint) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	tHgt@Cɏo
+ * @param	path	t@CpX
+ * @param	font	tHg
+ * @return	 true
+ */
+[[nodiscard]] bool saveSdfFont(const std::string& path, const SdfFont& font);
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	tHgt@Cǂݍ
+ * @param	path	t@CpX
+ * @param	font	ǂݍݐ
+ * @return	 truei`łႤꍇ falsej
+ */
+[[nodiscard]] bool loadSdfFont(const std::string& path, SdfFont& font);
@@ -1,6 +1,7 @@
 #include "shader.h"
 #include <cassert>
 #include <string>
+#include <vector>
 #include <Windows.h>
 
 #include <D3Dcompiler.h>
@@ -22,17 +23,33 @@ static void ShowCompileError(ID3DBlob* error, const char* title)
 }
 
 [[nodiscard]] bool Shader::create(const Device& device) noexcept
+{
+    return create(device, {});
+}
+
+[[nodiscard]] bool Shader::create(const Device& device, const std::vector<ShaderPermutation::Define>& defines) noexcept
 {
     // st@C̍ƃtH_  "asset/shader.hlsl" T
-    const wchar_t* filePath = L"asset/shader.hlsl";
+    return create(device, L"asset/shader.hlsl", defines);
+}
 
+[[nodiscard]] bool Shader::create(const Device& device, const std::wstring& filePath, const std::vector<ShaderPermutation::Define>& defines) noexcept
+{
     UINT flags = D3DCOMPILE_DEBUG | D3DCOMPILE_SKIP_OPTIMIZATION;
 
+    // p[~e[V̒` D3D_SHADER_MACRO ɕϊiI[ nullptrj
+    std::vector<D3D_SHADER_MACRO> macros;
+    macros.reserve(defines.size() + 1);
+    for (const auto& [name, value] : defines) {
+        macros.push_back({ name.c_str(), value.c_str() });
+    }
+    macros.push_back({ nullptr, nullptr });
+
     ID3DBlob* error = nullptr;
 
     // VS
     HRESULT hr = D3DCompileFromFile(
-        filePath, nullptr, nullptr,
+        filePath.c_str(), macros.data(), nullptr,
         "vs", "vs_5_0",
         flags, 0,
         &vertexShader_, &error);
@@ -46,7 +63,7 @@ static void ShowCompileError(ID3DBlob* error, const char* title)
 
     // PS
     hr = D3DCompileFromFile(
-        filePath, nullptr, nullptr,
+        filePath.c_str(), macros.data(), nullptr,
         "ps", "ps_5_0",
         flags, 0,
         &pixelShader_, &error);
@@ -61,6 +78,20 @@ static void ShowCompileError(ID3DBlob* error, const char* title)
     return true;
 }
 
+[[nodiscard]] bool Shader::createFromCompiled(const std::wstring& vertexShaderPath, const std::wstring& pixelShaderPath) noexcept
+{
+    // t@Cꍇ͎sԂiĂяoŎsRpCɐ؂ւj
+    if (FAILED(D3DReadFileToBlob(vertexShaderPath.c_str(), &vertexShader_))) {
+        return false;
+    }
+    if (FAILED(D3DReadFileToBlob(pixelShaderPath.c_str(), &pixelShader_))) {
+        vertexShader_->Release();
+        vertexShader_ = nullptr;
+        return false;
+    }
+    return true;
+}
+
 [[nodiscard]] ID3DBlob* Shader::vertexShader() const noexcept {
     assert(vertexShader_ && "vertex shader is null");
     return vertexShader_;
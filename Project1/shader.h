@@ -3,6 +3,9 @@
 #pragma once
 
 #include "device.h"
+#include "shader_permutation.h"
+#include <string>
+#include <vector>
 
 //---------------------------------------------------------------------------------
 /**
@@ -30,6 +33,34 @@ public:
      */
     [[nodiscard]] bool create(const Device& device) noexcept;
 
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	vvZbT`w肵ăVF[_쐬
+     * @param	device	foCXNX̃CX^X
+     * @param	defines	p[~e[V̒`
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, const std::vector<ShaderPermutation::Define>& defines) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	t@CƃvvZbT`w肵ăVF[_쐬
+     * @param	device		foCXNX̃CX^X
+     * @param	filePath	HLSL t@C̃pXiGg|Cg vs / psj
+     * @param	defines		p[~e[V̒`
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, const std::wstring& filePath, const std::vector<ShaderPermutation::Define>& defines) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ItCRpCς݂̃VF[_ǂݍ
+     * @param	vertexShaderPath	_VF[_ (.cso) ̃pX
+     * @param	pixelShaderPath		sNZVF[_ (.cso) ̃pX
+     * @return	ǂݍ߂ true
+     */
+    [[nodiscard]] bool createFromCompiled(const std::wstring& vertexShaderPath, const std::wstring& pixelShaderPath) noexcept;
+
     //---------------------------------------------------------------------------------
     /**
      * @brief	_VF[_擾
@@ -0,0 +1,27 @@
+// V[pVF[_̋@\L[`
+
+#pragma once
+
+#include "shader_permutation.h"
+
+/// V[pVF[_̃\[Xist@C̍ƃtH_̑΃pXj
+inline constexpr const char* SceneShaderPath = "asset/shader.hlsl";
+
+/// ItCRpCς݃VF[_̒uꏊ
+inline constexpr const char* SceneShaderCompiledDirectory = "asset/shader";
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	V[pVF[_̋@\L[錾
+ * @return	p[~e[V
+ * @details	s̃VF[_CuƃItCRpCc[̗̐錾g
+ *			@\𑝂₵ asset/shader.hlsl  #if 킹Ēǉ邱
+ */
+[[nodiscard]] inline ShaderPermutation makeSceneShaderPermutation() {
+    ShaderPermutation permutation;
+    [[maybe_unused]] bool success = true;
+    success &= permutation.addEnum("COLOR_SOURCE", { "VERTEX", "POSITION", "WHITE" });
+    success &= permutation.addBool("USE_GRAYSCALE");
+    success &= permutation.addBool("USE_INSTANCING");
+    return permutation;
+}
@@ -0,0 +1,76 @@
+// VF[_CuNX
+
+#include "shader_library.h"
+#include "shader_features.h"
+#include <atomic>
+#include <cassert>
+#include <string>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SoAg쐬
+ * @param	device		foCXNX̃CX^X
+ * @param	jobSystem	RpC𕪎UWuVXe
+ * @param	permutation	@\L[̐錾
+ * @return	SoAg̍쐬ɐ true
+ */
+[[nodiscard]] bool ShaderLibrary::create(const Device& device, JobSystem& jobSystem, const ShaderPermutation& permutation) noexcept {
+    permutation_ = permutation;
+
+    // L[̂܂ܓYɂi񋓒l͈̔͊ÕL[ nullptr ̂܂܁j
+    shaders_.clear();
+    shaders_.resize(permutation_.tableSize());
+
+    const auto keys = permutation_.enumerateKeys();
+
+    // 1 oAg[J[ɔz
+    std::atomic<bool> success = true;
+    jobSystem.parallelFor(static_cast<uint32_t>(keys.size()), 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const auto key    = keys[i];
+            auto       shader = std::make_unique<Shader>();
+
+            // ItCRpCς݂D悷
+            const std::string base = std::string(SceneShaderCompiledDirectory) + "/shader_" + ShaderPermutation::keyString(key);
+            const std::wstring basePath(base.begin(), base.end());
+            if (!shader->createFromCompiled(basePath + L".vs.cso", basePath + L".ps.cso")) {
+                if (!shader->create(device, permutation_.defines(key))) {
+                    success = false;
+                    continue;
+                }
+            }
+
+            // YƂɕʂ̗vfȂ̂ŃbNsv
+            shaders_[key] = std::move(shader);
+        }
+    });
+
+    if (!success) {
+        assert(false && "VF[_oAg̍쐬Ɏs܂");
+        return false;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	oAg擾
+ * @param	key	p[~e[VL[
+ * @return	VF[_BȃL[Ȃ nullptr
+ */
+[[nodiscard]] const Shader* ShaderLibrary::find(ShaderPermutation::Key key) const noexcept {
+    if (key >= shaders_.size()) {
+        return nullptr;
+    }
+    return shaders_[key].get();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	@\L[̐錾擾
+ * @return	p[~e[V
+ */
+[[nodiscard]] const ShaderPermutation& ShaderLibrary::permutation() const noexcept {
+    return permutation_;
+}
@@ -0,0 +1,60 @@
+// VF[_CuNX
+
+#pragma once
+
+#include "device.h"
+#include "job_system.h"
+#include "shader.h"
+#include "shader_permutation.h"
+#include <memory>
+#include <vector>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VF[_CuNX
+ * @details	p[~e[V̑SoAgɗpӂAL[ O(1) 
+ *			ItCRpCς (.cso) ΂ǂ݁AΎsɃRpC
+ */
+class ShaderLibrary final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    ShaderLibrary() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~ShaderLibrary() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	SoAg쐬
+     * @param	device		foCXNX̃CX^X
+     * @param	jobSystem	RpC𕪎UWuVXe
+     * @param	permutation	@\L[̐錾
+     * @return	SoAg̍쐬ɐ true
+     */
+    [[nodiscard]] bool create(const Device& device, JobSystem& jobSystem, const ShaderPermutation& permutation) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	oAg擾
+     * @param	key	p[~e[VL[
+     * @return	VF[_BȃL[Ȃ nullptr
+     */
+    [[nodiscard]] const Shader* find(ShaderPermutation::Key key) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	@\L[̐錾擾
+     * @return	p[~e[V
+     */
+    [[nodiscard]] const ShaderPermutation& permutation() const noexcept;
+
+private:
+    ShaderPermutation                    permutation_{};  /// @\L[̐錾
+    std::vector<std::unique_ptr<Shader>> shaders_{};      /// L[YɂoAg̕\i󂫂 nullptrj
+};
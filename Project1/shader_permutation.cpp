@@ -0,0 +1,192 @@
+// VF[_p[~e[VNX
+
+#include "shader_permutation.h"
+#include <cassert>
+#include <cstdio>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	bool ̋@\L[ǉiNAME=0/1 `j
+ * @param	name	}N
+ * @return	ǉł true
+ */
+[[nodiscard]] bool ShaderPermutation::addBool(std::string name) noexcept {
+    return addFeature({ std::move(name), {}, 2, 0, 0 });
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	񋓌^̋@\L[ǉ
+ * @param	name	}N
+ * @param	values	񋓒l̖OiNAME_VALUE=i  NAME=I𒆂 i `j
+ * @return	ǉł true
+ */
+[[nodiscard]] bool ShaderPermutation::addEnum(std::string name, std::vector<std::string> values) noexcept {
+    if (values.size() < 2) {
+        assert(false && "񋓌^̃L[ɂ 2 ȏ̒lKvł");
+        return false;
+    }
+    const auto count = static_cast<uint32_t>(values.size());
+    return addFeature({ std::move(name), std::move(values), count, 0, 0 });
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	@\L[ǉ
+ * @param	feature	ǉ@\L[
+ * @return	ǉł true
+ */
+[[nodiscard]] bool ShaderPermutation::addFeature(Feature feature) noexcept {
+    if (findFeature(feature.name) != UINT32_MAX) {
+        assert(false && "ÕL[o^ς݂ł");
+        return false;
+    }
+
+    // l̐\łŏ̃rbg
+    uint32_t bits = 0;
+    while ((1u << bits) < feature.valueCount) {
+        ++bits;
+    }
+
+    if (totalBits_ + bits > MaxKeyBits) {
+        assert(false && "p[~e[VL[̃rbg𒴂܂");
+        return false;
+    }
+
+    feature.shift = totalBits_;
+    feature.bits  = bits;
+    totalBits_ += bits;
+    features_.push_back(std::move(feature));
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	@\̒lL[
+ * @param	featureIndex	@\̓o^CfbNX
+ * @param	value			@\̒libool Ȃ 0/1j
+ * @return	̋@\ value ̃L[
+ */
+[[nodiscard]] ShaderPermutation::Key ShaderPermutation::makeKey(uint32_t featureIndex, uint32_t value) const noexcept {
+    assert(featureIndex < features_.size());
+    assert(value < features_[featureIndex].valueCount);
+    return value << features_[featureIndex].shift;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	O@\̃CfbNXT
+ * @param	name	}N
+ * @return	CfbNXBȂ UINT32_MAX
+ */
+[[nodiscard]] uint32_t ShaderPermutation::findFeature(const std::string& name) const noexcept {
+    for (uint32_t i = 0; i < features_.size(); ++i) {
+        if (features_[i].name == name) {
+            return i;
+        }
+    }
+    return UINT32_MAX;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	L[@\̒lo
+ * @param	key				p[~e[VL[
+ * @param	featureIndex	@\̓o^CfbNX
+ * @return	@\̒l
+ */
+[[nodiscard]] uint32_t ShaderPermutation::featureValue(Key key, uint32_t featureIndex) const noexcept {
+    assert(featureIndex < features_.size());
+    const auto& feature = features_[featureIndex];
+    return (key >> feature.shift) & ((1u << feature.bits) - 1);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	L[LȃoAgwĂ邩i񋓒l͈̔͊O܂܂Ȃj
+ * @param	key	p[~e[VL[
+ * @return	LȂ true
+ */
+[[nodiscard]] bool ShaderPermutation::isValid(Key key) const noexcept {
+    if (key >= tableSize()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < features_.size(); ++i) {
+        if (featureValue(key, i) >= features_[i].valueCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SoAg̃L[񋓂
+ * @return	LȃL[̈ꗗ
+ */
+[[nodiscard]] std::vector<ShaderPermutation::Key> ShaderPermutation::enumerateKeys() const {
+    std::vector<Key> keys;
+    keys.reserve(variantCount());
+    for (Key key = 0; key < tableSize(); ++key) {
+        if (isValid(key)) {
+            keys.push_back(key);
+        }
+    }
+    return keys;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	L[ɑΉvvZbT`
+ * @param	key	p[~e[VL[
+ * @return	`̈ꗗ
+ */
+[[nodiscard]] std::vector<ShaderPermutation::Define> ShaderPermutation::defines(Key key) const {
+    assert(isValid(key));
+
+    std::vector<Define> result;
+    for (uint32_t i = 0; i < features_.size(); ++i) {
+        const auto& feature = features_[i];
+
+        // 񋓒l͖Ot̒萔`āAVF[_ #if NAME == NAME_VALUE Ə悤ɂ
+        for (uint32_t v = 0; v < feature.values.size(); ++v) {
+            result.emplace_back(feature.name + "_" + feature.values[v], std::to_string(v));
+        }
+        result.emplace_back(feature.name, std::to_string(featureValue(key, i)));
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	L[t@Cp̕ɂi: "0005"j
+ * @param	key	p[~e[VL[
+ * @return	4  16 i
+ */
+[[nodiscard]] std::string ShaderPermutation::keyString(Key key) {
+    char buffer[16]{};
+    std::snprintf(buffer, sizeof(buffer), "%04x", key);
+    return buffer;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	oAg\̃TCYi1 << gprbgj擾
+ * @return	\̃TCY
+ */
+[[nodiscard]] uint32_t ShaderPermutation::tableSize() const noexcept {
+    return 1u << totalBits_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	LȃoAg̐擾
+ * @return	oAg
+ */
+[[nodiscard]] uint32_t ShaderPermutation::variantCount() const noexcept {
+    uint32_t count = 1;
+    for (const auto& feature : features_) {
+        count *= feature.valueCount;
+    }
+    return count;
+}
@@ -0,0 +1,149 @@
+// VF[_p[~e[VNX
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VF[_p[~e[VNX
+ * @details	bool / 񋓌^̋@\L[錾AeL[̒lrbgl߂L[ŃoAg\
+ *			L[͂̂܂܃oAg\̓YɂȂ̂Ŏš O(1)
+ *			D3D ɈˑȂ̂ŁALinux ̃ItCRpCc[p
+ */
+class ShaderPermutation final {
+public:
+    /// p[~e[VL[ie@\̒lrbgl߂́j
+    using Key = uint32_t;
+
+    /// vvZbT`iO, lj
+    using Define = std::pair<std::string, std::string>;
+
+    /// L[ɎgőrbgioAg\̃TCY 1 << ̒l ܂Łj
+    static constexpr uint32_t MaxKeyBits = 16;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    ShaderPermutation() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~ShaderPermutation() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	bool ̋@\L[ǉiNAME=0/1 `j
+     * @param	name	}N
+     * @return	ǉł true
+     */
+    [[nodiscard]] bool addBool(std::string name) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	񋓌^̋@\L[ǉ
+     * @param	name	}N
+     * @param	values	񋓒l̖OiNAME_VALUE=i  NAME=I𒆂 i `j
+     * @return	ǉł true
+     */
+    [[nodiscard]] bool addEnum(std::string name, std::vector<std::string> values) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	@\̒lL[
+     * @param	featureIndex	@\̓o^CfbNX
+     * @param	value			@\̒libool Ȃ 0/1j
+     * @return	̋@\ value ̃L[B̋@\̃L[ OR Ďg
+     */
+    [[nodiscard]] Key makeKey(uint32_t featureIndex, uint32_t value) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	O@\̃CfbNXT
+     * @param	name	}N
+     * @return	CfbNXBȂ UINT32_MAX
+     */
+    [[nodiscard]] uint32_t findFeature(const std::string& name) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	L[@\̒lo
+     * @param	key				p[~e[VL[
+     * @param	featureIndex	@\̓o^CfbNX
+     * @return	@\̒l
+     */
+    [[nodiscard]] uint32_t featureValue(Key key, uint32_t featureIndex) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	L[LȃoAgwĂ邩i񋓒l͈̔͊O܂܂Ȃj
+     * @param	key	p[~e[VL[
+     * @return	LȂ true
+     */
+    [[nodiscard]] bool isValid(Key key) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	SoAg̃L[񋓂
+     * @return	LȃL[̈ꗗ
+     */
+    [[nodiscard]] std::vector<Key> enumerateKeys() const;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	L[ɑΉvvZbT`
+     * @param	key	p[~e[VL[
+     * @return	`̈ꗗ
+     */
+    [[nodiscard]] std::vector<Define> defines(Key key) const;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	L[t@Cp̕ɂi: "0005"j
+     * @param	key	p[~e[VL[
+     * @return	4  16 i
+     */
+    [[nodiscard]] static std::string keyString(Key key);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	oAg\̃TCYi1 << gprbgj擾
+     * @return	\̃TCY
+     */
+    [[nodiscard]] uint32_t tableSize() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	LȃoAg̐擾
+     * @return	oAg
+     */
+    [[nodiscard]] uint32_t variantCount() const noexcept;
+
+private:
+    /// @\L[
+    struct Feature {
+        std::string              name;       /// }N
+        std::vector<std::string> values;     /// 񋓒l̖Oibool ̏ꍇ͋j
+        uint32_t                 valueCount; /// 肤l̐
+        uint32_t                 shift;      /// L[̃rbgʒu
+        uint32_t                 bits;       /// L[̃rbg
+    };
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	@\L[ǉ
+     * @param	feature	ǉ@\L[
+     * @return	ǉł true
+     */
+    [[nodiscard]] bool addFeature(Feature feature) noexcept;
+
+private:
+    std::vector<Feature> features_{};  /// @\L[̈ꗗ
+    uint32_t             totalBits_{}; /// L[̎gprbg
+};
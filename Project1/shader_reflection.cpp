@@ -0,0 +1,217 @@
+// VF[_tNV
+
+#include "shader_reflection.h"
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <Windows.h>
+#include <D3Dcompiler.h>
+#include <d3d12shader.h>
+#pragma comment(lib, "d3dcompiler.lib")
+#pragma comment(lib, "dxguid.lib")
+
+namespace {
+
+/// oChQƂXe[W
+enum StageMask : uint32_t {
+    StageVertex = 1 << 0,
+    StagePixel  = 1 << 1,
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	QƂXe[WJ͈͂߂
+ * @param	stages	StageMask ̑gݍ킹
+ * @return	J͈
+ */
+D3D12_SHADER_VISIBILITY toVisibility(uint32_t stages) noexcept {
+    switch (stages) {
+    case StageVertex:
+        return D3D12_SHADER_VISIBILITY_VERTEX;
+    case StagePixel:
+        return D3D12_SHADER_VISIBILITY_PIXEL;
+    default:
+        return D3D12_SHADER_VISIBILITY_ALL;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	\[X̎ނϊ
+ * @param	type	D3D ̃\[X̎
+ * @return	\[XoCh̎
+ */
+ShaderResourceType toResourceType(D3D_SHADER_INPUT_TYPE type) noexcept {
+    switch (type) {
+    case D3D_SIT_CBUFFER:
+        return ShaderResourceType::ConstantBuffer;
+    case D3D_SIT_SAMPLER:
+        return ShaderResourceType::Sampler;
+    case D3D_SIT_UAV_RWTYPED:
+    case D3D_SIT_UAV_RWSTRUCTURED:
+    case D3D_SIT_UAV_RWBYTEADDRESS:
+    case D3D_SIT_UAV_APPEND_STRUCTURED:
+    case D3D_SIT_UAV_CONSUME_STRUCTURED:
+    case D3D_SIT_UAV_RWSTRUCTURED_WITH_COUNTER:
+        return ShaderResourceType::UnorderedAccess;
+    default:
+        return ShaderResourceType::ShaderResource;
+    }
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VF[_̃oCgR[h烊tNV擾
+ * @param	shaderBlob	VF[_̃oCgR[h
+ * @param	out			ʂ̊i[
+ * @return	 true
+ */
+[[nodiscard]] bool reflectShader(ID3DBlob* shaderBlob, ShaderReflectionData& out) noexcept {
+    out = {};
+    if (!shaderBlob) {
+        return false;
+    }
+
+    ID3D12ShaderReflection* reflection{};
+    if (FAILED(D3DReflect(shaderBlob->GetBufferPointer(), shaderBlob->GetBufferSize(), IID_PPV_ARGS(&reflection)))) {
+        // DXIL  D3DReflect ł͓ǂ߂Ȃ
+        return false;
+    }
+
+    D3D12_SHADER_DESC shaderDesc{};
+    reflection->GetDesc(&shaderDesc);
+
+    // ̓VOl`
+    for (UINT i = 0; i < shaderDesc.InputParameters; ++i) {
+        D3D12_SIGNATURE_PARAMETER_DESC desc{};
+        reflection->GetInputParameterDesc(i, &desc);
+
+        ShaderInputParameter input{};
+        input.semanticName = desc.SemanticName;
+        input.semanticIndex = desc.SemanticIndex;
+        input.componentType = desc.ComponentType == D3D_REGISTER_COMPONENT_UINT32 ? ShaderComponentType::UInt
+                            : desc.ComponentType == D3D_REGISTER_COMPONENT_SINT32 ? ShaderComponentType::SInt
+                                                                                  : ShaderComponentType::Float;
+        input.componentCount = (desc.Mask & 1) + ((desc.Mask >> 1) & 1) + ((desc.Mask >> 2) & 1) + ((desc.Mask >> 3) & 1);
+        input.systemValue = desc.SystemValueType != D3D_NAME_UNDEFINED;
+        out.inputs.push_back(input);
+    }
+
+    // 萔obt@
+    for (UINT i = 0; i < shaderDesc.ConstantBuffers; ++i) {
+        auto* constantBuffer = reflection->GetConstantBufferByIndex(i);
+        D3D12_SHADER_BUFFER_DESC bufferDesc{};
+        constantBuffer->GetDesc(&bufferDesc);
+        if (bufferDesc.Type != D3D_CT_CBUFFER) {
+            continue;
+        }
+
+        ShaderConstantBuffer buffer{ bufferDesc.Name, bufferDesc.Size, {} };
+        for (UINT j = 0; j < bufferDesc.Variables; ++j) {
+            auto* variable = constantBuffer->GetVariableByIndex(j);
+            D3D12_SHADER_VARIABLE_DESC variableDesc{};
+            variable->GetDesc(&variableDesc);
+            D3D12_SHADER_TYPE_DESC typeDesc{};
+            variable->GetType()->GetDesc(&typeDesc);
+
+            std::string typeName = typeDesc.Name ? typeDesc.Name : "struct";
+            if (typeDesc.Class == D3D_SVC_MATRIX_ROWS) {
+                typeName = "row_major " + typeName;
+            }
+            buffer.variables.push_back({ variableDesc.Name, typeName, variableDesc.StartOffset, variableDesc.Size, std::max(1u, typeDesc.Elements) });
+        }
+        std::sort(buffer.variables.begin(), buffer.variables.end(), [](const auto& a, const auto& b) { return a.offset < b.offset; });
+        out.constantBuffers.push_back(std::move(buffer));
+    }
+
+    // \[XoCh
+    for (UINT i = 0; i < shaderDesc.BoundResources; ++i) {
+        D3D12_SHADER_INPUT_BIND_DESC desc{};
+        reflection->GetResourceBindingDesc(i, &desc);
+        out.bindings.push_back({ desc.Name, toResourceType(desc.Type), desc.BindPoint, desc.Space, desc.BindCount });
+    }
+
+    reflection->Release();
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	tNV񂩂烋[gVOl`r_[
+ * @param	vertexShader	_VF[_̃tNV
+ * @param	pixelShader		sNZVF[_̃tNV
+ * @return	[gVOl`r_[
+ */
+[[nodiscard]] RootSignatureBuilder makeRootSignatureBuilder(const ShaderReflectionData& vertexShader, const ShaderReflectionData& pixelShader) {
+    // (, Xy[X, WX^) ƂɎQƂXe[W܂Ƃ߂Bmap Ȃ̂œo^Ɉ˂炸тɂȂ
+    using Key = std::tuple<ShaderResourceType, uint32_t, uint32_t>;
+    std::map<Key, std::pair<uint32_t, uint32_t>> bindings;  // Xe[W, A
+    const auto collect = [&bindings](const ShaderReflectionData& data, uint32_t stage) {
+        for (const auto& binding : data.bindings) {
+            auto& entry = bindings[{ binding.type, binding.space, binding.bindPoint }];
+            entry.first |= stage;
+            entry.second = std::max(entry.second, binding.bindCount);
+        }
+    };
+    collect(vertexShader, StageVertex);
+    collect(pixelShader, StagePixel);
+
+    RootSignatureBuilder builder;
+
+    // CBV ͍XVpx̂Ń[gɒڒu
+    for (const auto& [key, entry] : bindings) {
+        const auto& [type, space, bindPoint] = key;
+        if (type == ShaderResourceType::ConstantBuffer) {
+            for (uint32_t i = 0; i < entry.second; ++i) {
+                builder.addCBV(bindPoint + i, space, toVisibility(entry.first));
+            }
+        }
+    }
+
+    // SRV / UAV ͌J͈͂Ƃ 1 ̃e[uɂ܂Ƃ߂
+    for (const uint32_t stages : { StageVertex | StagePixel, static_cast<uint32_t>(StageVertex), static_cast<uint32_t>(StagePixel) }) {
+        std::vector<RootSignatureBuilder::Range> ranges;
+        for (const auto& [key, entry] : bindings) {
+            const auto& [type, space, bindPoint] = key;
+            if (entry.first != stages) {
+                continue;
+            }
+            if (type == ShaderResourceType::ShaderResource) {
+                ranges.push_back({ D3D12_DESCRIPTOR_RANGE_TYPE_SRV, entry.second, bindPoint, space });
+            }
+            else if (type == ShaderResourceType::UnorderedAccess) {
+                ranges.push_back({ D3D12_DESCRIPTOR_RANGE_TYPE_UAV, entry.second, bindPoint, space });
+            }
+        }
+        if (!ranges.empty()) {
+            builder.addTable(ranges, toVisibility(stages));
+        }
+    }
+
+    // Tv[͐ÓITv[ijAEbvjɂ
+    for (const auto& [key, entry] : bindings) {
+        const auto& [type, space, bindPoint] = key;
+        if (type != ShaderResourceType::Sampler) {
+            continue;
+        }
+        for (uint32_t i = 0; i < entry.second; ++i) {
+            D3D12_STATIC_SAMPLER_DESC desc{};
+            desc.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+            desc.AddressU = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+            desc.AddressV = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+            desc.AddressW = D3D12_TEXTURE_ADDRESS_MODE_WRAP;
+            desc.MaxAnisotropy = 16;
+            desc.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+            desc.BorderColor = D3D12_STATIC_BORDER_COLOR_OPAQUE_BLACK;
+            desc.MaxLOD = D3D12_FLOAT32_MAX;
+            desc.ShaderRegister = bindPoint + i;
+            desc.RegisterSpace = space;
+            desc.ShaderVisibility = toVisibility(entry.first);
+            builder.addStaticSampler(desc);
+        }
+    }
+
+    return builder;
+}
@@ -0,0 +1,29 @@
+// VF[_tNV
+
+#pragma once
+
+#include "root_signature_builder.h"
+#include "shader_reflection_data.h"
+#include <d3d12.h>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VF[_̃oCgR[h烊tNV擾
+ * @param	shaderBlob	VF[_̃oCgR[h
+ * @param	out			ʂ̊i[
+ * @return	 true
+ * @details	D3DReflect  FXC (DXBC) ̂ݑΉBDXC  .cso (DXIL)  false Ԃ̂ŁA
+ *			Ăяo͊̃CAEgɖ߂ tools/shader_reflect_tool ̐g
+ */
+[[nodiscard]] bool reflectShader(ID3DBlob* shaderBlob, ShaderReflectionData& out) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	tNV񂩂烋[gVOl`r_[
+ * @param	vertexShader	_VF[_̃tNV
+ * @param	pixelShader		sNZVF[_̃tNV
+ * @return	[gVOl`r_[
+ * @details	CBV ̓[g CBVASRV / UAV ͌J͈͂Ƃ 1 ̃fBXNv^e[uA
+ *			Tv[͐ÓITv[ɂB̃Xe[WŎĝ ALLAЕȂ炻̃Xe[WɌJ
+ */
+[[nodiscard]] RootSignatureBuilder makeRootSignatureBuilder(const ShaderReflectionData& vertexShader, const ShaderReflectionData& pixelShader);
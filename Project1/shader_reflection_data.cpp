@@ -0,0 +1,524 @@
+// VF[_tNV
+
+#include "shader_reflection_data.h"
+#include <algorithm>
+#include <cctype>
+#include <regex>
+#include <sstream>
+
+namespace {
+
+/// tAZuo͂̓ǂݎ蒆̃ZNV
+enum class Section {
+    None,
+    InputSignature,
+    BufferDefinitions,
+    ResourceBindings,
+};
+
+/// HLSL ̐l^̏
+struct NumericType {
+    std::string cppType;    ///< Ή C++ ̌^
+    uint32_t    rows;       ///< sixNgEXJ[ 1j
+    uint32_t    columns;    ///< 
+    bool        rowMajor;   ///< row_major wȂ true
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	RgLiDXC  ";"AFXC  "//"j菜
+ * @param	line	s
+ * @param	body	菜c̊i[
+ * @return	RgsȂ true
+ */
+bool stripCommentPrefix(const std::string& line, std::string& body) {
+    size_t pos = 0;
+    if (line.compare(0, 1, ";") == 0) {
+        pos = 1;
+    }
+    else if (line.compare(0, 2, "//") == 0) {
+        pos = 2;
+    }
+    else {
+        return false;
+    }
+    if (pos < line.size() && line[pos] == ' ') {
+        ++pos;
+    }
+    body = line.substr(pos);
+    while (!body.empty() && (body.back() == '\r' || body.back() == ' ')) {
+        body.pop_back();
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	󔒂ŋ؂
+ * @param	text	
+ * @return	؂P
+ */
+std::vector<std::string> splitTokens(const std::string& text) {
+    std::istringstream       stream(text);
+    std::vector<std::string> tokens;
+    std::string              token;
+    while (stream >> token) {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	HLSL ̌^͂
+ * @param	typeName	^irow_major / column_major tj
+ * @param	out			ʂ̊i[
+ * @return	XJ[ExNgEsƂĉ߂ł true
+ */
+bool parseNumericType(const std::string& typeName, NumericType& out) {
+    static const std::regex pattern(R"(^(?:(row_major|column_major)\s+)?(float|half|int|uint|dword|bool)([1-4])?(?:x([1-4]))?$)");
+    std::smatch             match;
+    if (!std::regex_match(typeName, match, pattern)) {
+        return false;
+    }
+
+    const std::string base = match[2];
+    out.cppType  = (base == "float" || base == "half") ? "float" : (base == "int" ? "int32_t" : "uint32_t");
+    out.rowMajor = match[1] == "row_major";
+    if (match[4].matched) {
+        out.rows    = static_cast<uint32_t>(std::stoul(match[3]));
+        out.columns = static_cast<uint32_t>(std::stoul(match[4]));
+    }
+    else {
+        out.rows    = 1;
+        out.columns = match[3].matched ? static_cast<uint32_t>(std::stoul(match[3])) : 1;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	萔obt@̃pbLOKł 1 vf̃TCY߂
+ * @param	type	^̏
+ * @return	oCgis̓WX^E܂܂ށj
+ */
+uint32_t packedSize(const NumericType& type) {
+    if (type.rows == 1) {
+        return type.columns * 4;
+    }
+    // column_major ͗񂲂ƁArow_major ͍sƂ 16 oCg̃WX^g
+    const uint32_t registers = type.rowMajor ? type.rows : type.columns;
+    const uint32_t perReg    = type.rowMajor ? type.columns : type.rows;
+    return (registers - 1) * 16 + perReg * 4;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Z}eBNX C++ ̃oi: TEXCOORD1 -> texcoord1j
+ * @param	input	̓p[^
+ * @return	o
+ */
+std::string memberName(const ShaderInputParameter& input) {
+    std::string name = input.semanticName;
+    for (auto& c : name) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    if (input.semanticIndex != 0) {
+        name += std::to_string(input.semanticIndex);
+    }
+    return name;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CX^XPʂ̓͂
+ * @param	semanticName	Z}eBNX
+ * @return	INSTANCE_ Ŏn܂ true
+ */
+bool isInstanceSemantic(const std::string& semanticName) {
+    return semanticName.compare(0, 9, "INSTANCE_") == 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_͂̍\̂o͂
+ * @param	out			o͐
+ * @param	name		\̖
+ * @param	inputs		̓p[^
+ * @param	instance	CX^XPʂ̗vfo͂Ȃ true
+ */
+void writeInputStruct(std::ostringstream& out, const char* name, const std::vector<ShaderInputParameter>& inputs, bool instance) {
+    std::vector<const ShaderInputParameter*> members;
+    for (const auto& input : inputs) {
+        if (!input.systemValue && isInstanceSemantic(input.semanticName) == instance) {
+            members.push_back(&input);
+        }
+    }
+    if (members.empty()) {
+        return;
+    }
+
+    uint32_t size = 0;
+    out << "//---------------------------------------------------------------------------------\n"
+        << "/**\n * @brief\t" << (instance ? "CX^XP" : "_P") << "̓́i_CAEgƓсj\n */\n"
+        << "struct " << name << " {\n";
+    for (const auto* input : members) {
+        const char* type = input->componentType == ShaderComponentType::Float ? "float" : (input->componentType == ShaderComponentType::UInt ? "uint32_t" : "int32_t");
+        out << "    " << type << " " << memberName(*input);
+        if (input->componentCount > 1) {
+            out << "[" << input->componentCount << "]";
+        }
+        out << ";  ///< " << input->semanticName << input->semanticIndex << "\n";
+        size += input->componentCount * 4;
+    }
+    out << "};\n";
+
+    uint32_t offset = 0;
+    for (const auto* input : members) {
+        out << "static_assert(offsetof(" << name << ", " << memberName(*input) << ") == " << offset << ", \"_CAEgƂĂ܂\");\n";
+        offset += input->componentCount * 4;
+    }
+    out << "static_assert(sizeof(" << name << ") == " << size << ", \"_CAEgƂĂ܂\");\n\n";
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	萔obt@̍\̂o͂
+ * @param	out			o͐
+ * @param	buffer		萔obt@
+ * @param	binding		ΉoChi nullptrj
+ * @param	report		|[g̏o͐
+ */
+void writeConstantBufferStruct(std::ostringstream& out, const ShaderConstantBuffer& buffer, const ShaderResourceBinding* binding, std::ostringstream& report) {
+    const uint32_t alignedSize = (buffer.size + 15) & ~15u;
+
+    out << "//---------------------------------------------------------------------------------\n"
+        << "/**\n * @brief\t萔obt@ " << buffer.name;
+    if (binding) {
+        out << " (b" << binding->bindPoint << (binding->space ? ", space" + std::to_string(binding->space) : "") << ")";
+    }
+    out << "\n */\n"
+        << "struct alignas(16) " << buffer.name << " {\n";
+
+    // HLSL ̃pbLOŋ󂢂Ԃ̓pfBOƂĖ
+    uint32_t cursor       = 0;
+    uint32_t dataBytes    = 0;
+    uint32_t paddingCount = 0;
+    std::vector<std::pair<std::string, uint32_t>> asserts;
+    for (const auto& variable : buffer.variables) {
+        if (variable.offset > cursor) {
+            out << "    uint8_t _padding" << paddingCount++ << "[" << (variable.offset - cursor) << "];\n";
+        }
+
+        NumericType type{};
+        uint32_t    bytes = variable.size;
+        if (parseNumericType(variable.typeName, type) && variable.elementCount <= 1 && packedSize(type) == type.rows * type.columns * 4) {
+            // ԂȂԌ^͂̂܂ܔzɂ
+            bytes = type.rows * type.columns * 4;
+            out << "    " << type.cppType << " " << variable.name;
+            if (bytes > 4) {
+                out << "[" << bytes / 4 << "]";
+            }
+        }
+        else if (parseNumericType(variable.typeName, type) && variable.elementCount > 1 && type.rows == 1 && variable.size >= variable.elementCount * 16) {
+            // z͗vfƂ 16 oCgEɒu
+            bytes = variable.elementCount * 16;
+            out << "    " << type.cppType << " " << variable.name << "[" << variable.elementCount << "][4]";
+        }
+        else {
+            // ȊO̓CAEg킹̃[h
+            bytes = std::max(4u, variable.size & ~3u);
+            out << "    uint32_t " << variable.name << "[" << bytes / 4 << "]";
+        }
+        out << ";  ///< " << variable.typeName;
+        if (variable.elementCount > 1) {
+            out << "[" << variable.elementCount << "]";
+        }
+        out << " (offset " << variable.offset << ")\n";
+
+        asserts.emplace_back(variable.name, variable.offset);
+        cursor = variable.offset + bytes;
+
+        NumericType natural{};
+        dataBytes += parseNumericType(variable.typeName, natural) ? natural.rows * natural.columns * 4 * std::max(1u, variable.elementCount) : variable.size;
+    }
+    if (alignedSize > cursor) {
+        out << "    uint8_t _padding" << paddingCount++ << "[" << (alignedSize - cursor) << "];\n";
+    }
+    out << "};\n";
+
+    for (const auto& [name, offset] : asserts) {
+        out << "static_assert(offsetof(" << buffer.name << ", " << name << ") == " << offset << ", \"HLSL ̃pbLOƂĂ܂\");\n";
+    }
+    out << "static_assert(sizeof(" << buffer.name << ") == " << alignedSize << ", \"HLSL ̃pbLOƂĂ܂\");\n\n";
+
+    const uint32_t padding = alignedSize > dataBytes ? alignedSize - dataBytes : 0;
+    report << buffer.name << ": " << alignedSize << " bytes, data " << dataBytes << ", padding " << padding;
+    if (alignedSize) {
+        report << " (" << (padding * 100 / alignedSize) << "%)";
+    }
+    report << "\n";
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	DXC (-Fc) / FXC (/Fc) ̋tAZuo͂烊tNVǂ
+ * @param	text	tAZuo
+ * @param	out		ʂ̊i[
+ * @return	̓VOl`\[XoCĥǂ炩ǂ߂ true
+ */
+[[nodiscard]] bool parseShaderDisassembly(const std::string& text, ShaderReflectionData& out) {
+    static const std::regex cbufferPattern(R"(^cbuffer\s+(\w+))");
+    static const std::regex memberPattern(R"(^\s*((?:(?:row_major|column_major)\s+)?\w+)\s+(\w+)(?:\[(\d+)\])?;\s*(?:;|//)\s*Offset:\s*(\d+)(?:\s+Size:\s*(\d+))?)");
+    static const std::regex closePattern(R"(^\s*\}\s*(\w+)?;\s*(?:;|//)\s*Offset:\s*(\d+)(?:\s+Size:\s*(\d+))?)");
+    static const std::regex bindPattern(R"(^(cb|t|s|u)(\d+)(?:,space(\d+))?$)");
+
+    out = {};
+
+    Section               section   = Section::None;
+    bool                  inTable   = false;
+    ShaderConstantBuffer* buffer    = nullptr;
+    int                   depth     = 0;
+    int                   memberDepth = 0;
+
+    std::istringstream stream(text);
+    std::string        line;
+    std::string        body;
+    while (std::getline(stream, line)) {
+        if (!stripCommentPrefix(line, body)) {
+            continue;
+        }
+
+        // ZNVoi ':' ŏIsj
+        if (!body.empty() && body[0] != ' ' && body.back() == ':') {
+            inTable = false;
+            buffer  = nullptr;
+            if (body == "Input signature:") {
+                section = Section::InputSignature;
+            }
+            else if (body == "Buffer Definitions:") {
+                section = Section::BufferDefinitions;
+            }
+            else if (body == "Resource Bindings:") {
+                section = Section::ResourceBindings;
+            }
+            else {
+                section = Section::None;
+            }
+            continue;
+        }
+
+        switch (section) {
+        case Section::InputSignature:
+        case Section::ResourceBindings: {
+            if (body.compare(0, 3, "---") == 0) {
+                inTable = true;
+                continue;
+            }
+            if (!inTable) {
+                continue;
+            }
+            const auto tokens = splitTokens(body);
+            if (tokens.empty()) {
+                inTable = false;
+                continue;
+            }
+
+            if (section == Section::InputSignature) {
+                // Name Index Mask Register SysValue Format [Used]
+                if (tokens.size() < 6) {
+                    continue;
+                }
+                ShaderInputParameter input{};
+                input.semanticName   = tokens[0];
+                input.semanticIndex  = static_cast<uint32_t>(std::stoul(tokens[1]));
+                input.componentCount = static_cast<uint32_t>(std::count_if(tokens[2].begin(), tokens[2].end(), [](char c) { return c == 'x' || c == 'y' || c == 'z' || c == 'w'; }));
+                input.systemValue    = tokens[4] != "NONE";
+                input.componentType  = tokens[5] == "uint" ? ShaderComponentType::UInt : (tokens[5] == "int" ? ShaderComponentType::SInt : ShaderComponentType::Float);
+                out.inputs.push_back(input);
+            }
+            else {
+                // DXC: Name Type Format Dim ID HLSLBind Count / FXC: Name Type Format Dim HLSLBind Count
+                if (tokens.size() < 6) {
+                    continue;
+                }
+                std::smatch match;
+                const auto& bind = tokens[tokens.size() - 2];
+                if (!std::regex_match(bind, match, bindPattern)) {
+                    continue;
+                }
+                ShaderResourceBinding binding{};
+                binding.name      = tokens[0];
+                binding.bindPoint = static_cast<uint32_t>(std::stoul(match[2]));
+                binding.space     = match[3].matched ? static_cast<uint32_t>(std::stoul(match[3])) : 0;
+                binding.bindCount = static_cast<uint32_t>(std::stoul(tokens.back()));
+                const std::string kind = match[1];
+                binding.type = kind == "cb" ? ShaderResourceType::ConstantBuffer
+                             : kind == "t"  ? ShaderResourceType::ShaderResource
+                             : kind == "u"  ? ShaderResourceType::UnorderedAccess
+                                            : ShaderResourceType::Sampler;
+                out.bindings.push_back(binding);
+            }
+            break;
+        }
+
+        case Section::BufferDefinitions: {
+            std::smatch match;
+            if (std::regex_search(body, match, cbufferPattern)) {
+                out.constantBuffers.push_back({ match[1], 0, {} });
+                buffer      = &out.constantBuffers.back();
+                depth       = 0;
+                memberDepth = 0;
+                continue;
+            }
+            if (!buffer) {
+                continue;
+            }
+
+            const auto open = std::count(body.begin(), body.end(), '{');
+            if (open) {
+                depth += static_cast<int>(open);
+                continue;
+            }
+
+            if (std::regex_search(body, match, closePattern)) {
+                --depth;
+                if (match[3].matched && depth < memberDepth) {
+                    // DXC ͊O struct ̕őŜ̃TCYo
+                    buffer->size = static_cast<uint32_t>(std::stoul(match[3]));
+                }
+                else if (depth == memberDepth && match[1].matched) {
+                    // q struct ^̃o
+                    buffer->variables.push_back({ match[1], "struct", static_cast<uint32_t>(std::stoul(match[2])), 0, 1 });
+                }
+                continue;
+            }
+            if (body.find('}') != std::string::npos) {
+                --depth;
+                continue;
+            }
+
+            if (std::regex_search(body, match, memberPattern)) {
+                if (memberDepth == 0) {
+                    memberDepth = depth;
+                }
+                if (depth != memberDepth) {
+                    continue;
+                }
+                ShaderConstantVariable variable{};
+                variable.typeName     = match[1];
+                variable.name         = match[2];
+                variable.elementCount = match[3].matched ? static_cast<uint32_t>(std::stoul(match[3])) : 1;
+                variable.offset       = static_cast<uint32_t>(std::stoul(match[4]));
+                variable.size         = match[5].matched ? static_cast<uint32_t>(std::stoul(match[5])) : 0;
+                buffer->variables.push_back(variable);
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+
+    // DXC ̓õTCYoȂ̂ŁÃo܂ł̋狁߂
+    for (auto& cb : out.constantBuffers) {
+        auto& variables = cb.variables;
+        std::sort(variables.begin(), variables.end(), [](const auto& a, const auto& b) { return a.offset < b.offset; });
+        for (size_t i = 0; i < variables.size(); ++i) {
+            if (variables[i].size == 0) {
+                const uint32_t end = i + 1 < variables.size() ? variables[i + 1].offset : cb.size;
+                variables[i].size  = end > variables[i].offset ? end - variables[i].offset : 0;
+            }
+        }
+        if (cb.size == 0 && !variables.empty()) {
+            cb.size = variables.back().offset + variables.back().size;
+        }
+    }
+
+    return !out.inputs.empty() || !out.bindings.empty();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_VF[_̃tNV񂩂璸_CAEg
+ * @param	vertexShader	_VF[_̃tNV
+ * @return	_CAEgi錾ɋl߂Ĕzuj
+ */
+[[nodiscard]] std::vector<PipelineInputElement> makeInputLayout(const ShaderReflectionData& vertexShader) {
+    // ̌^Ɛ DXGI_FORMAT ̒l
+    static constexpr uint32_t formats[3][4] = {
+        { 41, 16, 6, 2 },  // R32_FLOAT ` R32G32B32A32_FLOAT
+        { 42, 17, 7, 3 },  // R32_UINT ` R32G32B32A32_UINT
+        { 43, 18, 8, 4 },  // R32_SINT ` R32G32B32A32_SINT
+    };
+
+    std::vector<PipelineInputElement> layout;
+    for (const auto& input : vertexShader.inputs) {
+        if (input.systemValue || input.componentCount == 0) {
+            continue;
+        }
+        const bool instance = isInstanceSemantic(input.semanticName);
+
+        PipelineInputElement element{};
+        element.semanticName      = input.semanticName;
+        element.semanticIndex     = input.semanticIndex;
+        element.format            = formats[static_cast<uint32_t>(input.componentType)][std::min(input.componentCount, 4u) - 1];
+        element.inputSlot         = instance ? 1 : 0;
+        element.alignedByteOffset = PipelineStateDesc::AppendAligned;
+        element.perInstance       = instance;
+        element.instanceStepRate  = instance ? 1 : 0;
+        layout.push_back(element);
+    }
+    // ItZbg͐KŊm肳ĂinbVLq̏ɈˑȂ悤Ɂj
+    PipelineStateDesc desc{};
+    desc.inputLayout = std::move(layout);
+    return normalizePipelineStateDesc(std::move(desc)).inputLayout;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	萔obt@ƒ_͂ C++ \̂܂ރwb_𐶐
+ * @param	vertexShader	_VF[_̃tNV
+ * @param	pixelShader		sNZVF[_̃tNV
+ * @param	report			pfBO̖ʂȂǂ̃|[g̊i[isvȂ nullptrj
+ * @return	wb_̓e
+ */
+[[nodiscard]] std::string generateShaderReflectionHeader(const ShaderReflectionData& vertexShader, const ShaderReflectionData& pixelShader, std::string* report) {
+    std::ostringstream out;
+    std::ostringstream log;
+
+    out << "// VF[_tNV玩itools/shader_reflect_tooljBŕҏWȂ\n\n"
+        << "#pragma once\n\n"
+        << "#include <cstddef>\n"
+        << "#include <cstdint>\n\n";
+
+    writeInputStruct(out, "VertexInput", vertexShader.inputs, false);
+    writeInputStruct(out, "InstanceInput", vertexShader.inputs, true);
+
+    // VS  PS ŋLĂ萔obt@ 1 񂾂o
+    std::vector<std::string> written;
+    for (const auto* data : { &vertexShader, &pixelShader }) {
+        for (const auto& buffer : data->constantBuffers) {
+            if (std::find(written.begin(), written.end(), buffer.name) != written.end()) {
+                continue;
+            }
+            written.push_back(buffer.name);
+
+            const ShaderResourceBinding* binding = nullptr;
+            for (const auto& b : data->bindings) {
+                if (b.type == ShaderResourceType::ConstantBuffer && b.name == buffer.name) {
+                    binding = &b;
+                }
+            }
+            writeConstantBufferStruct(out, buffer, binding, log);
+        }
+    }
+
+    if (report) {
+        *report = log.str();
+    }
+    return out.str();
+}
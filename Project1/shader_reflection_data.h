@@ -0,0 +1,96 @@
+// VF[_tNV
+
+#pragma once
+
+#include "pipeline_state_desc.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// ͗vf̐̌^
+enum class ShaderComponentType : uint8_t {
+    Float,
+    UInt,
+    SInt,
+};
+
+/// \[XoCh̎
+enum class ShaderResourceType : uint8_t {
+    ConstantBuffer,   ///< b#
+    ShaderResource,   ///< t#
+    UnorderedAccess,  ///< u#
+    Sampler,          ///< s#
+};
+
+/// VF[_̓̓p[^
+struct ShaderInputParameter {
+    std::string         semanticName;    ///< Z}eBNX
+    uint32_t            semanticIndex;   ///< Z}eBNXԍ
+    ShaderComponentType componentType;   ///< ̌^
+    uint32_t            componentCount;  ///<  (1`4)
+    bool                systemValue;     ///< SV_VertexID Ȃǂ̃VXelȂ truei_CAEgɊ܂߂Ȃj
+};
+
+/// 萔obt@̕ϐ
+struct ShaderConstantVariable {
+    std::string name;          ///< ϐ
+    std::string typeName;      ///< HLSL ̌^i: float4x4j
+    uint32_t    offset;        ///< 擪̃ItZbg
+    uint32_t    size;          ///< HLSL ̃pbLOKł̃TCY
+    uint32_t    elementCount;  ///< zvfizłȂ 1j
+};
+
+/// 萔obt@
+struct ShaderConstantBuffer {
+    std::string                         name;       ///< O
+    uint32_t                            size;       ///< TCY
+    std::vector<ShaderConstantVariable> variables;  ///< ϐiItZbgj
+};
+
+/// \[XoCh
+struct ShaderResourceBinding {
+    std::string        name;       ///< O
+    ShaderResourceType type;       ///< 
+    uint32_t           bindPoint;  ///< WX^ԍ
+    uint32_t           space;      ///< WX^Xy[X
+    uint32_t           bindCount;  ///< A郌WX^
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VF[_tNV
+ * @details	s D3DReflectAItC (Linux)  DXC ̋tAZuo͂瓯`ɋl߂
+ */
+struct ShaderReflectionData {
+    std::vector<ShaderInputParameter>  inputs{};           ///< ̓VOl`
+    std::vector<ShaderConstantBuffer>  constantBuffers{};  ///< 萔obt@
+    std::vector<ShaderResourceBinding> bindings{};         ///< \[XoCh
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	DXC (-Fc) / FXC (/Fc) ̋tAZuo͂烊tNVǂ
+ * @param	text	tAZuo
+ * @param	out		ʂ̊i[
+ * @return	̓VOl`\[XoCĥǂ炩ǂ߂ true
+ */
+[[nodiscard]] bool parseShaderDisassembly(const std::string& text, ShaderReflectionData& out);
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_VF[_̃tNV񂩂璸_CAEg
+ * @param	vertexShader	_VF[_̃tNV
+ * @return	_CAEgi錾ɋl߂Ĕzuj
+ * @details	INSTANCE_ Ŏn܂Z}eBNX̓Xbg 1 ̃CX^XPʃf[^ɂ
+ */
+[[nodiscard]] std::vector<PipelineInputElement> makeInputLayout(const ShaderReflectionData& vertexShader);
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	萔obt@ƒ_͂ C++ \̂܂ރwb_𐶐
+ * @param	vertexShader	_VF[_̃tNV
+ * @param	pixelShader		sNZVF[_̃tNV
+ * @param	report			pfBO̖ʂȂǂ̃|[g̊i[isvȂ nullptrj
+ * @return	wb_̓eiItZbgƃTCY static_assert Ōj
+ */
+[[nodiscard]] std::string generateShaderReflectionHeader(const ShaderReflectionData& vertexShader, const ShaderReflectionData& pixelShader, std::string* report);
@@ -0,0 +1,244 @@
+// VhE}bṽAgX蓖
+
+#include "shadow_atlas.h"
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[̐擪̃m[hԍ߂i[ l ̃m[h 4^l j
+ * @param	level	[
+ * @return	m[hԍ
+ */
+constexpr uint32_t levelOffset(uint32_t level) noexcept {
+    return ((1u << (2 * level)) - 1) / 3;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	2 ׂ̂悩肷
+ */
+constexpr bool isPowerOfTwo(uint32_t value) noexcept {
+    return value && (value & (value - 1)) == 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	2 Ƃΐi2 ׂ̂̂݁j
+ */
+uint32_t log2(uint32_t value) noexcept {
+    uint32_t result = 0;
+    while (value > 1) {
+        value >>= 1;
+        ++result;
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Morton ̔ԍ̋rbgl߂
+ */
+uint32_t compactBits(uint32_t value) noexcept {
+    value &= 0x55555555u;
+    value = (value | (value >> 1)) & 0x33333333u;
+    value = (value | (value >> 2)) & 0x0f0f0f0fu;
+    value = (value | (value >> 4)) & 0x00ff00ffu;
+    value = (value | (value >> 8)) & 0x0000ffffu;
+    return value;
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	size		AgẌ
+ * @param	minTileSize	^C̍ŏ̈
+ * @return	 true
+ */
+[[nodiscard]] bool ShadowAtlas::create(uint32_t size, uint32_t minTileSize) {
+    if (!isPowerOfTwo(size) || !isPowerOfTwo(minTileSize) || minTileSize > size) {
+        assert(false && "AgXƃ^C̈ӂ 2 ׂ̂ɂĂ");
+        return false;
+    }
+    size_ = size;
+    levelCount_ = log2(size / minTileSize) + 1;
+    if (levelCount_ > 10) {
+        assert(false && "AgX̕[܂");
+        return false;
+    }
+
+    const uint32_t nodeCount = levelOffset(levelCount_);
+    states_.assign(nodeCount, NodeState::Unused);
+    freeSlots_.assign(nodeCount, 0);
+    freeLists_.resize(levelCount_);
+    for (uint32_t level = 0; level < levelCount_; ++level) {
+        freeLists_[level].reserve(size_t(1) << (2 * level));
+    }
+    reset();
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	^C蓖Ă
+ * @param	size	~
+ * @return	^CB󂫂Ȃ valid()  false
+ */
+[[nodiscard]] ShadowTile ShadowAtlas::allocate(uint32_t size) noexcept {
+    assert(size_ && "AgX쐬ł");
+    const uint32_t minTileSize = size_ >> (levelCount_ - 1);
+    uint32_t       tileSize = minTileSize;
+    while (tileSize < size && tileSize < size_) {
+        tileSize <<= 1;
+    }
+    const uint32_t target = log2(size_ / tileSize);
+
+    // ~[󂢕֋󂫂Ti󂫂ɎgA傫󂫂cj
+    uint32_t level = target + 1;
+    while (level > 0 && freeLists_[level - 1].empty()) {
+        --level;
+    }
+    if (level == 0) {
+        return {};
+    }
+    --level;
+
+    uint32_t node = freeLists_[level].back();
+    removeFree(level, node);
+
+    // ~傫ɂȂ܂ 4 ɊAgĎc͋󂫂ɂ
+    while (level < target) {
+        states_[levelOffset(level) + node] = NodeState::Split;
+        ++level;
+        node *= 4;
+        for (uint32_t child = 3; child > 0; --child) {
+            states_[levelOffset(level) + node + child] = NodeState::Free;
+            pushFree(level, node + child);
+        }
+    }
+    states_[levelOffset(level) + node] = NodeState::Used;
+    freeArea_ -= uint64_t(tileSize) * tileSize;
+    return makeTile(level, node);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	^C
+ * @param	tile	allocate œ^C
+ */
+void ShadowAtlas::release(const ShadowTile& tile) noexcept {
+    if (!tile.valid()) {
+        return;
+    }
+    uint32_t level = 0;
+    while (level + 1 < levelCount_ && levelOffset(level + 1) <= tile.node) {
+        ++level;
+    }
+    uint32_t node = tile.node - levelOffset(level);
+    assert(states_[tile.node] == NodeState::Used && "蓖ĂĂȂ^C܂");
+    freeArea_ += uint64_t(tile.size) * tile.size;
+
+    // Z 4 Sċ󂢂eɂ܂Ƃ߂
+    while (level > 0) {
+        const uint32_t first = node & ~3u;
+        const uint32_t offset = levelOffset(level);
+        bool           siblingsFree = true;
+        for (uint32_t sibling = first; sibling < first + 4; ++sibling) {
+            siblingsFree = siblingsFree && (sibling == node || states_[offset + sibling] == NodeState::Free);
+        }
+        if (!siblingsFree) {
+            break;
+        }
+        for (uint32_t sibling = first; sibling < first + 4; ++sibling) {
+            if (sibling != node) {
+                removeFree(level, sibling);
+            }
+            states_[offset + sibling] = NodeState::Unused;
+        }
+        node /= 4;
+        --level;
+    }
+    states_[levelOffset(level) + node] = NodeState::Free;
+    pushFree(level, node);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Sĉ
+ */
+void ShadowAtlas::reset() noexcept {
+    std::fill(states_.begin(), states_.end(), NodeState::Unused);
+    for (auto& freeList : freeLists_) {
+        freeList.clear();
+    }
+    states_[0] = NodeState::Free;
+    pushFree(0, 0);
+    freeArea_ = uint64_t(size_) * size_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	AgẌӂ擾
+ * @return	eNZ
+ */
+[[nodiscard]] uint32_t ShadowAtlas::size() const noexcept {
+    return size_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	󂢂Ăʐς擾
+ * @return	eNZ
+ */
+[[nodiscard]] uint64_t ShadowAtlas::freeArea() const noexcept {
+    return freeArea_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	m[h󂫃Xgɓ
+ * @param	level	[
+ * @param	node	[̔ԍ
+ */
+void ShadowAtlas::pushFree(uint32_t level, uint32_t node) noexcept {
+    auto& freeList = freeLists_[level];
+    freeSlots_[levelOffset(level) + node] = static_cast<uint32_t>(freeList.size());
+    freeList.push_back(node);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	m[h󂫃XgOiƓւďj
+ * @param	level	[
+ * @param	node	[̔ԍ
+ */
+void ShadowAtlas::removeFree(uint32_t level, uint32_t node) noexcept {
+    auto&          freeList = freeLists_[level];
+    const uint32_t slot = freeSlots_[levelOffset(level) + node];
+    assert(slot < freeList.size() && freeList[slot] == node);
+    const uint32_t last = freeList.back();
+    freeList[slot] = last;
+    freeSlots_[levelOffset(level) + last] = slot;
+    freeList.pop_back();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	m[h̃^C
+ * @param	level	[
+ * @param	node	[̔ԍiMorton Ȃ̂ŋrbg XArbg Yj
+ * @return	^C
+ */
+[[nodiscard]] ShadowTile ShadowAtlas::makeTile(uint32_t level, uint32_t node) const noexcept {
+    const uint32_t tileSize = size_ >> level;
+    ShadowTile     tile;
+    tile.x = compactBits(node) * tileSize;
+    tile.y = compactBits(node >> 1) * tileSize;
+    tile.size = tileSize;
+    tile.node = levelOffset(level) + node;
+    return tile;
+}
@@ -0,0 +1,109 @@
+// VhE}bṽAgX蓖
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/// 蓖ĂɎs^C node
+inline constexpr uint32_t InvalidShadowTile = 0xffffffffu;
+
+/// AgX̃^CieNZPʂ̐`j
+struct ShadowTile {
+    uint32_t x = 0;                     ///<  X
+    uint32_t y = 0;                     ///<  Y
+    uint32_t size = 0;                  ///< 
+    uint32_t node = InvalidShadowTile;  ///< l؂̃m[hԍiɎgj
+
+    /// 蓖čς݂Ȃ true
+    [[nodiscard]] bool valid() const noexcept { return node != InvalidShadowTile; }
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VhE}bṽAgX蓖ăNX
+ * @details	ӂ 2 ׂ̂̐`̃AgXl؂ŕĊ蓖Ă
+ *			v 2 ׂ̂ɐ؂グA󂫂ȂΑ傫󂫃m[h 4 ɊĎg
+ *			m[h͌Z 4 Sċ󂯂ΐeɂ܂Ƃߒ̂ŁA蓖ĂƉJԂĂfЉȂ
+ *			蓖āEƂɃm[hɂ炸؂̐[ɔႷ鎞Ԃōς݁Amۂ create ̎
+ */
+class ShadowAtlas final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	size		AgẌӁi2 ׂ̂j
+     * @param	minTileSize	^C̍ŏ̈Ӂi2 ׂ̂Asize ȉj
+     * @return	 true
+     */
+    [[nodiscard]] bool create(uint32_t size, uint32_t minTileSize);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	^C蓖Ă
+     * @param	size	~Ӂi2 ׂ̂ɐ؂グAŏ̈Ӂ`AgẌӂɎ߂j
+     * @return	^CB󂫂Ȃ valid()  false
+     */
+    [[nodiscard]] ShadowTile allocate(uint32_t size) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	^C
+     * @param	tile	allocate œ^Ciȃ^CȂ牽Ȃj
+     */
+    void release(const ShadowTile& tile) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Sĉ
+     */
+    void reset() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	AgẌӂ擾
+     * @return	eNZ
+     */
+    [[nodiscard]] uint32_t size() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	󂢂Ăʐς擾
+     * @return	eNZ
+     */
+    [[nodiscard]] uint64_t freeArea() const noexcept;
+
+private:
+    /// m[h̏
+    enum class NodeState : uint8_t {
+        Unused,  ///< eĂȂi݂Ȃj
+        Free,    ///< 
+        Split,   ///< 4 ɊĂ
+        Used,    ///< 蓖čς
+    };
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	m[h󂫃Xgɓ
+     */
+    void pushFree(uint32_t level, uint32_t node) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	m[h󂫃XgO
+     */
+    void removeFree(uint32_t level, uint32_t node) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	m[h̃^C
+     */
+    [[nodiscard]] ShadowTile makeTile(uint32_t level, uint32_t node) const noexcept;
+
+    std::vector<NodeState>             states_{};      /// m[h̏ԁi[A[ Morton j
+    std::vector<uint32_t>              freeSlots_{};   /// m[h̋󂫃Xg̈ʒu
+    std::vector<std::vector<uint32_t>> freeLists_{};   /// [Ƃ̋󂫃m[h
+    uint32_t                           size_{};        /// AgẌ
+    uint32_t                           levelCount_{};  /// [̐
+    uint64_t                           freeArea_{};    /// 󂢂Ăʐ
+};
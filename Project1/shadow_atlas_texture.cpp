@@ -0,0 +1,229 @@
+// VhE}bṽAgXeNX`NX
+
+#include "shadow_atlas_texture.h"
+#include "pipline_state_object.h"
+#include "root_signature_builder.h"
+#include <cassert>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+ShadowAtlasTexture::~ShadowAtlasTexture() {
+    if (texture_) {
+        texture_->Release();
+        texture_ = nullptr;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	device				foCXNX̃CX^X
+ * @param	rootSignatureCache	[gVOl`LbV
+ * @param	pipelineCache		pCvCXe[gLbV
+ * @param	size				AgẌ
+ * @param	reverseZ			O 1A 0 ɂ
+ * @return	 true
+ */
+[[nodiscard]] bool ShadowAtlasTexture::create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache,
+                                              uint32_t size, bool reverseZ) noexcept {
+    assert(size > 0);
+    size_ = size;
+    reverseZ_ = reverseZ;
+
+    D3D12_HEAP_PROPERTIES heapProps{};
+    heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+    D3D12_RESOURCE_DESC resDesc{};
+    resDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    resDesc.Width = size;
+    resDesc.Height = size;
+    resDesc.DepthOrArraySize = 1;
+    resDesc.MipLevels = 1;
+    resDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+    resDesc.SampleDesc.Count = 1;
+    resDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+    resDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL;
+
+    D3D12_CLEAR_VALUE clearValue{};
+    clearValue.Format = Format;
+    clearValue.DepthStencil.Depth = clearDepth();
+
+    // `ĂȂԂ̓VF[_ǂޏԂɂĂ
+    state_ = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    const auto res = device.get()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resDesc, state_, &clearValue, IID_PPV_ARGS(&texture_));
+    if (FAILED(res)) {
+        assert(false && "VhEAgX̍쐬Ɏs");
+        return false;
+    }
+
+    if (!dsvHeap_.create(device, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, 1) ||
+        !srvHeap_.create(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 1, true)) {
+        return false;
+    }
+    D3D12_DEPTH_STENCIL_VIEW_DESC dsvDesc{};
+    dsvDesc.Format = Format;
+    dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
+    device.get()->CreateDepthStencilView(texture_, &dsvDesc, dsvHeap_.get()->GetCPUDescriptorHandleForHeapStart());
+    createShaderResourceView(device, srvHeap_.get()->GetCPUDescriptorHandleForHeapStart());
+
+    if (!copyShader_.create(device, L"asset/shadow_copy.hlsl", {})) {
+        return false;
+    }
+
+    // b0: ʂƎʂ̍i[g萔j, t0: ʂ̃AgX
+    RootSignatureBuilder builder;
+    builder.addConstants(2, 0, 0, D3D12_SHADER_VISIBILITY_PIXEL).addTable({ { D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0 } }, D3D12_SHADER_VISIBILITY_PIXEL);
+    rootSignature_ = rootSignatureCache.getOrCreate(device, builder);
+    if (!rootSignature_) {
+        return false;
+    }
+
+    // F͏A[xeXgɂ̂܂܏
+    PipelineStateDesc desc = PiplineStateObject::defaultDesc();
+    desc.inputLayout.clear();
+    desc.cull = CullMode::None;
+    desc.depth = DepthMode::ReadWrite;
+    desc.depthCompare = DepthCompare::Always;
+    desc.renderTargetCount = 0;
+    desc.depthStencilFormat = static_cast<uint32_t>(Format);
+    pipelineCache_ = &pipelineCache;
+    copyPipeline_ = pipelineCache.request(desc, copyShader_, *rootSignature_);
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	^Cɕ`n߂
+ * @param	commandList	R}hXg
+ * @param	tile		`^C
+ */
+void ShadowAtlasTexture::beginTile(ID3D12GraphicsCommandList* commandList, const ShadowTile& tile) noexcept {
+    setTarget(commandList, tile);
+
+    const D3D12_RECT rect{ LONG(tile.x), LONG(tile.y), LONG(tile.x + tile.size), LONG(tile.y + tile.size) };
+    commandList->ClearDepthStencilView(dsvHeap_.get()->GetCPUDescriptorHandleForHeapStart(), D3D12_CLEAR_FLAG_DEPTH, clearDepth(), 0, 1, &rect);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ʂ̃AgX̃^CʂĂ`n߂
+ * @param	commandList	R}hXg
+ * @param	source		ʂ̃AgX
+ * @param	sourceTile	ʂ̃^C
+ * @param	tile		`^C
+ * @return	ʂ trueBRs[̃pCvC쐬Ȃʂ beginTile ƓNA false
+ */
+[[nodiscard]] bool ShadowAtlasTexture::copyTile(ID3D12GraphicsCommandList* commandList, ShadowAtlasTexture& source, const ShadowTile& sourceTile,
+                                                const ShadowTile& tile) noexcept {
+    assert(&source != this && "AgX̒ł͎ʂ܂");
+    assert(sourceTile.size == tile.size && "ʂƎʂ̑傫Ⴂ܂");
+    ID3D12PipelineState* pipelineState = pipelineCache_->get(copyPipeline_);
+    if (!pipelineState) {
+        beginTile(commandList, tile);
+        return false;
+    }
+    source.transition(commandList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    setTarget(commandList, tile);
+
+    const int32_t offset[2] = { int32_t(sourceTile.x) - int32_t(tile.x), int32_t(sourceTile.y) - int32_t(tile.y) };
+    ID3D12DescriptorHeap* heaps[] = { source.srvHeap_.get() };
+    commandList->SetDescriptorHeaps(1, heaps);
+    commandList->SetGraphicsRootSignature(rootSignature_->get());
+    commandList->SetPipelineState(pipelineState);
+    commandList->SetGraphicsRoot32BitConstants(0, 2, offset, 0);
+    commandList->SetGraphicsRootDescriptorTable(1, source.srvHeap_.get()->GetGPUDescriptorHandleForHeapStart());
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    commandList->DrawInstanced(3, 1, 0, 0);
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`IăVF[_ǂ߂Ԃɂ
+ * @param	commandList	R}hXg
+ */
+void ShadowAtlasTexture::finish(ID3D12GraphicsCommandList* commandList) noexcept {
+    transition(commandList, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VF[_\[Xr[
+ * @param	device	foCXNX̃CX^X
+ * @param	handle	ݐ̃fBXNv^
+ */
+void ShadowAtlasTexture::createShaderResourceView(const Device& device, D3D12_CPU_DESCRIPTOR_HANDLE handle) const noexcept {
+    assert(texture_ && "VhEAgX쐬ł");
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+    srvDesc.Format = DXGI_FORMAT_R32_FLOAT;
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.Texture2D.MipLevels = 1;
+    device.get()->CreateShaderResourceView(texture_, &srvDesc, handle);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	eNX`擾
+ * @return	eNX`
+ */
+[[nodiscard]] ID3D12Resource* ShadowAtlasTexture::texture() const noexcept {
+    return texture_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NA[x擾
+ * @return	reverseZ Ȃ 0AłȂ 1
+ */
+[[nodiscard]] float ShadowAtlasTexture::clearDepth() const noexcept {
+    return reverseZ_ ? 0.0f : 1.0f;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Ԃς
+ * @param	commandList	R}hXg
+ * @param	state		ς̏
+ */
+void ShadowAtlasTexture::transition(ID3D12GraphicsCommandList* commandList, D3D12_RESOURCE_STATES state) noexcept {
+    if (state_ == state) {
+        return;
+    }
+    D3D12_RESOURCE_BARRIER barrier{};
+    barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barrier.Transition.pResource = texture_;
+    barrier.Transition.StateBefore = state_;
+    barrier.Transition.StateAfter = state;
+    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+    commandList->ResourceBarrier(1, &barrier);
+    state_ = state;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[xobt@Er[|[gEVU[^Cɍ킹
+ * @param	commandList	R}hXg
+ * @param	tile		`^C
+ */
+void ShadowAtlasTexture::setTarget(ID3D12GraphicsCommandList* commandList, const ShadowTile& tile) noexcept {
+    assert(texture_ && "VhEAgX쐬ł");
+    assert(tile.valid() && tile.x + tile.size <= size_ && tile.y + tile.size <= size_);
+    transition(commandList, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+
+    D3D12_VIEWPORT viewport{};
+    viewport.TopLeftX = float(tile.x);
+    viewport.TopLeftY = float(tile.y);
+    viewport.Width = float(tile.size);
+    viewport.Height = float(tile.size);
+    viewport.MinDepth = 0.0f;
+    viewport.MaxDepth = 1.0f;
+
+    const D3D12_RECT scissor{ LONG(tile.x), LONG(tile.y), LONG(tile.x + tile.size), LONG(tile.y + tile.size) };
+    const auto       dsv = dsvHeap_.get()->GetCPUDescriptorHandleForHeapStart();
+    commandList->RSSetViewports(1, &viewport);
+    commandList->RSSetScissorRects(1, &scissor);
+    commandList->OMSetRenderTargets(0, nullptr, FALSE, &dsv);
+}
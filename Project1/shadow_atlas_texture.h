@@ -0,0 +1,125 @@
+// VhE}bṽAgXeNX`NX
+
+#pragma once
+
+#include "descriptor_heap.h"
+#include "device.h"
+#include "pipeline_state_cache.h"
+#include "root_signature_cache.h"
+#include "shader.h"
+#include "shadow_atlas.h"
+#include <cstdint>
+#include <d3d12.h>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VhE}bṽAgXeNX`NX
+ * @details	ShadowCache ̃AgX 1 ̐[xeNX`B^CƂɃr[|[gEVU[킹
+ *			͈̔͂NAĕ`BLive AgXւ̓LbṼ^C[x̂܂܎ʂĂ瓮LX^[d˂
+ */
+class ShadowAtlasTexture final {
+public:
+    /// [x̌`i\[X R32_TYPELESS ōADSV  D32_FLOATASRV  R32_FLOAT Ōj
+    static constexpr DXGI_FORMAT Format = DXGI_FORMAT_D32_FLOAT;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    ShadowAtlasTexture() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~ShadowAtlasTexture();
+
+    // Rs[֎~
+    ShadowAtlasTexture(const ShadowAtlasTexture&) = delete;
+    ShadowAtlasTexture& operator=(const ShadowAtlasTexture&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	device				foCXNX̃CX^X
+     * @param	rootSignatureCache	[gVOl`LbV
+     * @param	pipelineCache		pCvCXe[gLbV
+     * @param	size				AgẌӁiShadowCache Ɠj
+     * @param	reverseZ			O 1A 0 ɂiNA[xςj
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache, uint32_t size,
+                              bool reverseZ) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	^Cɕ`n߂i[xobt@Er[|[gEVU[ݒ肵ă^CNAj
+     * @param	commandList	R}hXg
+     * @param	tile		`^C
+     */
+    void beginTile(ID3D12GraphicsCommandList* commandList, const ShadowTile& tile) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ʂ̃AgX̃^CʂĂ`n߂i[xobt@Er[|[gEVU[ݒ肷j
+     * @param	commandList	R}hXg
+     * @param	source		ʂ̃AgXiVF[_ǂޏԂɂj
+     * @param	sourceTile	ʂ̃^C
+     * @param	tile		`^CiʂƓ傫j
+     * @return	ʂ trueBRs[̃pCvC쐬ȂʂɃNA falseiÓIȕ̂`Ɓj
+     */
+    [[nodiscard]] bool copyTile(ID3D12GraphicsCommandList* commandList, ShadowAtlasTexture& source, const ShadowTile& sourceTile, const ShadowTile& tile) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	`IăVF[_ǂ߂Ԃɂ
+     * @param	commandList	R}hXg
+     */
+    void finish(ID3D12GraphicsCommandList* commandList) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	VF[_\[Xr[
+     * @param	device	foCXNX̃CX^X
+     * @param	handle	ݐ̃fBXNv^
+     */
+    void createShaderResourceView(const Device& device, D3D12_CPU_DESCRIPTOR_HANDLE handle) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	eNX`擾
+     * @return	eNX`
+     */
+    [[nodiscard]] ID3D12Resource* texture() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	NA[x擾
+     * @return	reverseZ Ȃ 0AłȂ 1
+     */
+    [[nodiscard]] float clearDepth() const noexcept;
+
+private:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	Ԃς
+     */
+    void transition(ID3D12GraphicsCommandList* commandList, D3D12_RESOURCE_STATES state) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[xobt@Er[|[gEVU[^Cɍ킹
+     */
+    void setTarget(ID3D12GraphicsCommandList* commandList, const ShadowTile& tile) noexcept;
+
+    Shader                     copyShader_{};      /// ʂpVF[_
+    const RootSignature*       rootSignature_{};   /// ʂp[gVOl`iLbVLj
+    PipelineStateCache*        pipelineCache_{};   /// pCvCXe[gLbV
+    PipelineStateCache::Handle copyPipeline_{};    /// ʂppCvC
+    DescriptorHeap             dsvHeap_{};         /// DSV 1 
+    DescriptorHeap             srvHeap_{};         /// ʂƂēǂ SRV 1 iVF[_猩j
+    ID3D12Resource*            texture_{};         /// [xeNX`
+    D3D12_RESOURCE_STATES      state_{};           /// eNX`̍̏
+    uint32_t                   size_{};            /// AgẌ
+    bool                       reverseZ_{};        /// O 1A 0 ɂ邩
+};
@@ -0,0 +1,248 @@
+// VhE}bṽLbV
+
+#include "shadow_cache.h"
+#include "job_system.h"
+#include <cassert>
+#include <cstring>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	atlasSize	AgẌ
+ * @param	minTileSize	^C̍ŏ̈
+ * @return	 true
+ */
+[[nodiscard]] bool ShadowCache::create(uint32_t atlasSize, uint32_t minTileSize) {
+    views_.clear();
+    freeViews_.clear();
+    requests_.clear();
+    casterIndices_.clear();
+    return cacheAtlas_.create(atlasSize, minTileSize) && liveAtlas_.create(atlasSize, minTileSize);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	r[ǉ
+ * @param	resolution	VhE}bv̈
+ * @return	r[ԍBAgXɋ󂫂Ȃ InvalidShadowView
+ */
+[[nodiscard]] uint32_t ShadowCache::addView(uint32_t resolution) {
+    const ShadowTile tile = cacheAtlas_.allocate(resolution);
+    if (!tile.valid()) {
+        return InvalidShadowView;
+    }
+
+    uint32_t view;
+    if (freeViews_.empty()) {
+        view = static_cast<uint32_t>(views_.size());
+        views_.emplace_back();
+        staticVisible_.resize(views_.size());
+        movingVisible_.resize(views_.size());
+        staticCounts_.resize(views_.size());
+        movingCounts_.resize(views_.size());
+    }
+    else {
+        view = freeViews_.back();
+        freeViews_.pop_back();
+    }
+
+    auto& entry = views_[view];
+    entry = View{};
+    entry.cacheTile = tile;
+    entry.resolution = resolution;
+    entry.active = true;
+    entry.dirty = true;
+    return view;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	r[폜
+ * @param	view	r[ԍ
+ */
+void ShadowCache::removeView(uint32_t view) noexcept {
+    assert(view < views_.size() && views_[view].active && "폜ς݂̃r[ł");
+    auto& entry = views_[view];
+    cacheAtlas_.release(entry.cacheTile);
+    liveAtlas_.release(entry.liveTile);
+    entry = View{};
+    freeViews_.push_back(view);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	r[̉𑜓xς
+ * @param	view		r[ԍ
+ * @param	resolution	VhE}bv̈
+ * @return	蓖Ă true
+ */
+[[nodiscard]] bool ShadowCache::setResolution(uint32_t view, uint32_t resolution) noexcept {
+    assert(view < views_.size() && views_[view].active && "폜ς݂̃r[ł");
+    auto& entry = views_[view];
+
+    // ɉƁAꏊ܂Ƃߒ傫󂫂g
+    cacheAtlas_.release(entry.cacheTile);
+    liveAtlas_.release(entry.liveTile);
+    entry.liveTile = {};
+    ShadowTile tile = cacheAtlas_.allocate(resolution);
+    const bool succeeded = tile.valid();
+    if (!succeeded) {
+        tile = cacheAtlas_.allocate(entry.resolution);
+        assert(tile.valid() && "̑傫̃^C܂");
+    }
+    else {
+        entry.resolution = resolution;
+    }
+    entry.cacheTile = tile;
+    entry.dirty = true;
+    return succeeded;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	r[ˉesݒ肷
+ * @param	view			r[ԍ
+ * @param	viewProjection	sD 4x4 ̃r[ˉes
+ */
+void ShadowCache::setViewProjection(uint32_t view, const float viewProjection[4][4]) noexcept {
+    assert(view < views_.size() && views_[view].active && "폜ς݂̃r[ł");
+    auto& entry = views_[view];
+    if (entry.hasMatrix && std::memcmp(entry.viewProjection, viewProjection, sizeof(entry.viewProjection)) == 0) {
+        return;
+    }
+    std::memcpy(entry.viewProjection, viewProjection, sizeof(entry.viewProjection));
+    entry.frustum = makeCullFrustum(viewProjection);
+    entry.hasMatrix = true;
+    entry.dirty = true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ÓIȃLX^[ς͈͂Ɋ|r[𖳌ɂ
+ * @param	bounds	ς͈͂̋E
+ */
+void ShadowCache::invalidate(const float bounds[4]) noexcept {
+    for (auto& entry : views_) {
+        if (entry.active && entry.hasMatrix && !entry.dirty && isSphereInFrustum(entry.frustum, bounds)) {
+            entry.dirty = true;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SẴr[𖳌ɂ
+ */
+void ShadowCache::invalidateAll() noexcept {
+    for (auto& entry : views_) {
+        entry.dirty = entry.active;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̃t[ɕ`^CƃLX^[߂
+ * @param	staticCasters	ÓIȃLX^[̋E
+ * @param	movingCasters	LX^[̋E
+ * @param	jobSystem		ɏꍇ̃WuVXe
+ * @return	`^C̐
+ */
+uint32_t ShadowCache::prepare(const BoundingSpheres& staticCasters, const BoundingSpheres& movingCasters, JobSystem* jobSystem) {
+    const uint32_t viewCount = static_cast<uint32_t>(views_.size());
+
+    // r[ƂɃJOBÓIȃLX^[͕`r[
+    const auto cull = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t view = begin; view < end; ++view) {
+            const auto& entry = views_[view];
+            staticCounts_[view] = 0;
+            movingCounts_[view] = 0;
+            if (!entry.active || !entry.hasMatrix) {
+                continue;
+            }
+            if (entry.dirty) {
+                staticVisible_[view].resize(staticCasters.size());
+                staticCounts_[view] = cullSpheres(entry.frustum, staticCasters, staticVisible_[view].data());
+            }
+            movingVisible_[view].resize(movingCasters.size());
+            movingCounts_[view] = cullSpheres(entry.frustum, movingCasters, movingVisible_[view].data());
+        }
+    };
+    if (jobSystem) {
+        jobSystem->parallelFor(viewCount, 1, cull);
+    }
+    else {
+        cull(0, viewCount);
+    }
+
+    requests_.clear();
+    casterIndices_.clear();
+
+    // LbV`^C
+    for (uint32_t view = 0; view < viewCount; ++view) {
+        auto& entry = views_[view];
+        if (!entry.active || !entry.hasMatrix || !entry.dirty) {
+            continue;
+        }
+        const uint32_t first = static_cast<uint32_t>(casterIndices_.size());
+        casterIndices_.insert(casterIndices_.end(), staticVisible_[view].begin(), staticVisible_[view].begin() + staticCounts_[view]);
+        requests_.push_back({ view, ShadowAtlasKind::Cache, entry.cacheTile, {}, first, staticCounts_[view] });
+        entry.dirty = false;
+    }
+
+    // LX^[d˂^CBĂȂr[ Live ̃^CԂ
+    for (uint32_t view = 0; view < viewCount; ++view) {
+        auto& entry = views_[view];
+        if (!entry.active) {
+            continue;
+        }
+        if (movingCounts_[view] == 0) {
+            liveAtlas_.release(entry.liveTile);
+            entry.liveTile = {};
+            continue;
+        }
+        if (!entry.liveTile.valid()) {
+            entry.liveTile = liveAtlas_.allocate(entry.cacheTile.size);
+            if (!entry.liveTile.valid()) {
+                // Live ɋ󂫂ȂΓLX^[̉e͒߁ALbV̂܂܎g
+                continue;
+            }
+        }
+        const uint32_t first = static_cast<uint32_t>(casterIndices_.size());
+        casterIndices_.insert(casterIndices_.end(), movingVisible_[view].begin(), movingVisible_[view].begin() + movingCounts_[view]);
+        requests_.push_back({ view, ShadowAtlasKind::Live, entry.liveTile, entry.cacheTile, first, movingCounts_[view] });
+    }
+    return static_cast<uint32_t>(requests_.size());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̃t[ɕ`^C擾
+ * @return	prepare ̌
+ */
+[[nodiscard]] const std::vector<ShadowRenderRequest>& ShadowCache::requests() const noexcept {
+    return requests_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	`LX^[̔ԍ擾
+ * @return	requests()  firstCaster  casterCount 
+ */
+[[nodiscard]] const std::vector<uint32_t>& ShadowCache::casterIndices() const noexcept {
+    return casterIndices_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	r[Tv^C擾
+ * @param	view	r[ԍ
+ * @return	LX^[d˂Ȃ LiveAłȂ΃LbṼ^C
+ */
+[[nodiscard]] ShadowSample ShadowCache::sample(uint32_t view) const noexcept {
+    assert(view < views_.size() && views_[view].active && "폜ς݂̃r[ł");
+    const auto& entry = views_[view];
+    if (entry.liveTile.valid()) {
+        return { ShadowAtlasKind::Live, entry.liveTile };
+    }
+    return { ShadowAtlasKind::Cache, entry.cacheTile };
+}
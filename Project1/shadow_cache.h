@@ -0,0 +1,162 @@
+// VhE}bṽLbV
+
+#pragma once
+
+#include "frustum_culling.h"
+#include "indirect_cull.h"
+#include "shadow_atlas.h"
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+/// ȃr[ԍ
+inline constexpr uint32_t InvalidShadowView = 0xffffffffu;
+
+/// e`AgX
+enum class ShadowAtlasKind : uint8_t {
+    Cache,  ///< ÓIȃLX^[`Ďg񂷃AgX
+    Live,   ///< LbVʂēLX^[d˂At[`AgX
+};
+
+/// 1 t[ɕ`^C 1 
+struct ShadowRenderRequest {
+    uint32_t        view;         ///< r[ԍ
+    ShadowAtlasKind atlas;        ///< `AgX
+    ShadowTile      tile;         ///< `^C
+    ShadowTile      copySource;   ///< Live ̎AɎʂLbṼ^C
+    uint32_t        firstCaster;  ///< casterIndices() ̊Jnʒu
+    uint32_t        casterCount;  ///< `LX^[iCache ȂÓIALive Ȃ瓮LX^[̔ԍj
+};
+
+/// r[`ʂ̃^CiVF[_͂Tvj
+struct ShadowSample {
+    ShadowAtlasKind atlas;  ///< AgX
+    ShadowTile      tile;   ///< ^Ci蓖ĂȂ valid()  falsej
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VhE}bṽLbVNX
+ * @details	Cg 1 EJXP[h 1 iur[vƌĂсAr[ƂɃLbVpAgX̃^C蓖Ă
+ *			LbṼ^Cɂ͐ÓIȃLX^[`Ar[ˉes񂪕ς邩 invalidate 
+ *			ɂ܂ŕ`ȂBLX^[ɓĂr[At[
+ *			LbV Live AgXɎʂĂ瓮LX^[d˂
+ *			LX^[̓r[ƂɎJOĂ`̂ŁA`搔͂قړLX^[̐Ō܂
+ *			D3D12 ɈˑȂ̂ŁA蓖ĂƖ̎菇 Linux łm߂
+ */
+class ShadowCache final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	atlasSize	AgẌӁi2 ׂ̂BLbV Live œ傫j
+     * @param	minTileSize	^C̍ŏ̈Ӂi2 ׂ̂j
+     * @return	 true
+     */
+    [[nodiscard]] bool create(uint32_t atlasSize, uint32_t minTileSize);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	r[ǉ
+     * @param	resolution	VhE}bv̈Ӂi2 ׂ̂ɐ؂グj
+     * @return	r[ԍBAgXɋ󂫂Ȃ InvalidShadowView
+     */
+    [[nodiscard]] uint32_t addView(uint32_t resolution);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	r[폜i^Cj
+     * @param	view	r[ԍ
+     */
+    void removeView(uint32_t view) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	r[̉𑜓xςi^C蓖ĒĖɂj
+     * @param	view		r[ԍ
+     * @param	resolution	VhE}bv̈
+     * @return	蓖Ă trueBsꍇ͌̃^Ĉ܂
+     */
+    [[nodiscard]] bool setResolution(uint32_t view, uint32_t resolution) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	r[ˉesݒ肷iOƈႦΖɂj
+     * @param	view			r[ԍ
+     * @param	viewProjection	sD 4x4 ̃r[ˉesiclip = M * pAD3D  z  0`1j
+     * @details	JXP[h̓eNZPʂɃXibvsnƁAJ̏ȓŖɂȂȂ
+     */
+    void setViewProjection(uint32_t view, const float viewProjection[4][4]) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ÓIȃLX^[ς͈͂Ɋ|r[𖳌ɂ
+     * @param	bounds	ς͈͂̋EiS XYZ, ajBȂOƌ̗n
+     */
+    void invalidate(const float bounds[4]) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	SẴr[𖳌ɂ
+     */
+    void invalidateAll() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̃t[ɕ`^CƃLX^[߂
+     * @param	staticCasters	ÓIȃLX^[̋E
+     * @param	movingCasters	LX^[̋E
+     * @param	jobSystem		ɏꍇ̃WuVXeinullptr ȂĂяoXbhŏj
+     * @return	`^C̐irequests() ̐j
+     * @details	ʂ requests()  casterIndices() Ŏ擾BĂ񂾎_Ŗȃr[͕`ꂽ̂ƂĈ
+     *			v Cache  Live ̏ɕԂ̂ŁȀɕ`Ύʂ͕`IĂ
+     */
+    uint32_t prepare(const BoundingSpheres& staticCasters, const BoundingSpheres& movingCasters, JobSystem* jobSystem = nullptr);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̃t[ɕ`^C擾
+     * @return	prepare ̌
+     */
+    [[nodiscard]] const std::vector<ShadowRenderRequest>& requests() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	`LX^[̔ԍ擾
+     * @return	requests()  firstCaster  casterCount 
+     */
+    [[nodiscard]] const std::vector<uint32_t>& casterIndices() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	r[Tv^C擾
+     * @param	view	r[ԍ
+     * @return	LX^[d˂Ȃ LiveAłȂ΃LbṼ^C
+     */
+    [[nodiscard]] ShadowSample sample(uint32_t view) const noexcept;
+
+private:
+    /// r[
+    struct View {
+        float       viewProjection[4][4];  ///< r[ˉes
+        CullFrustum frustum;               ///< 
+        ShadowTile  cacheTile;             ///< LbṼ^C
+        ShadowTile  liveTile;              ///< Live ̃^CiLX^[ĂԂj
+        uint32_t    resolution;            ///< 
+        bool        active;                ///< gpȂ true
+        bool        hasMatrix;             ///< r[ˉesݒς݂Ȃ true
+        bool        dirty;                 ///< LbV`Ȃ true
+    };
+
+    ShadowAtlas                        cacheAtlas_{};     /// LbṼAgX
+    ShadowAtlas                        liveAtlas_{};      /// Live ̃AgX
+    std::vector<View>                  views_{};          /// r[i폜ԍ͍ėpj
+    std::vector<uint32_t>              freeViews_{};      /// 폜r[ԍ
+    std::vector<std::vector<uint32_t>> staticVisible_{};  /// r[Ƃ̐ÓIȃLX^[̃JO
+    std::vector<std::vector<uint32_t>> movingVisible_{};  /// r[Ƃ̓LX^[̃JO
+    std::vector<uint32_t>              staticCounts_{};   /// r[Ƃ̐ÓIȃLX^[̉
+    std::vector<uint32_t>              movingCounts_{};   /// r[Ƃ̓LX^[̉
+    std::vector<ShadowRenderRequest>   requests_{};       /// ̃t[ɕ`^C
+    std::vector<uint32_t>              casterIndices_{};  /// `LX^[̔ԍ
+};
@@ -0,0 +1,398 @@
+// SIMD wCuixNgEsENH[^jIj
+
+#include "simd_math.h"
+#include "projection.h"
+
+#if SIMD_MATH_SSE
+#include <immintrin.h>
+#endif
+#if defined(__AVX2__)
+#define SIMD_MATH_AVX2 1
+#endif
+
+namespace {
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_̕тϊiXJ[Łj
+ */
+void transformPointsScalar(const Mat4& m, const Vec3* points, Vec4* out, uint32_t count) noexcept {
+    for (uint32_t i = 0; i < count; ++i) {
+        out[i] = m * Vec4(points[i], 1.0f);
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	xNg̕тϊiXJ[Łj
+ */
+void transformVectorsScalar(const Mat4& m, const Vec4* vectors, Vec4* out, uint32_t count) noexcept {
+    for (uint32_t i = 0; i < count; ++i) {
+        out[i] = m * vectors[i];
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	s̐ς܂Ƃ߂ċ߂iXJ[Łj
+ */
+void multiplyMatricesScalar(const Mat4* a, const Mat4* b, Mat4* out, uint32_t count) noexcept {
+    for (uint32_t n = 0; n < count; ++n) {
+        Mat4 result;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                result.m[i][j] = ((a[n].m[i][0] * b[n].m[0][j] + a[n].m[i][1] * b[n].m[1][j]) + a[n].m[i][2] * b[n].m[2][j]) + a[n].m[i][3] * b[n].m[3][j];
+            }
+        }
+        out[n] = result;
+    }
+}
+
+#if SIMD_MATH_SSE
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_̕тϊiSSE Łj
+ * @details	s̗ 1 xǂ݁A = 0 * x + 1 * y + 2 * z + 3 ̏ɑ
+ */
+void transformPointsSse(const Mat4& m, const Vec3* points, Vec4* out, uint32_t count) noexcept {
+    const Mat4   t = transpose(m);
+    const __m128 c0 = _mm_load_ps(t.m[0]);
+    const __m128 c1 = _mm_load_ps(t.m[1]);
+    const __m128 c2 = _mm_load_ps(t.m[2]);
+    const __m128 c3 = _mm_load_ps(t.m[3]);
+    for (uint32_t i = 0; i < count; ++i) {
+        __m128 r = _mm_mul_ps(c0, _mm_set1_ps(points[i].x));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(points[i].y)));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(points[i].z)));
+        // w = 1 Ȃ̂Ŋ|Z͌ʂςȂ
+        r = _mm_add_ps(r, c3);
+        _mm_store_ps(&out[i].x, r);
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	xNg̕тϊiSSE Łj
+ */
+void transformVectorsSse(const Mat4& m, const Vec4* vectors, Vec4* out, uint32_t count) noexcept {
+    const Mat4   t = transpose(m);
+    const __m128 c0 = _mm_load_ps(t.m[0]);
+    const __m128 c1 = _mm_load_ps(t.m[1]);
+    const __m128 c2 = _mm_load_ps(t.m[2]);
+    const __m128 c3 = _mm_load_ps(t.m[3]);
+    for (uint32_t i = 0; i < count; ++i) {
+        const __m128 v = _mm_load_ps(&vectors[i].x);
+        __m128       r = _mm_mul_ps(c0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)));
+        r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1))));
+        r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))));
+        r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))));
+        _mm_store_ps(&out[i].x, r);
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	s̐ς܂Ƃ߂ċ߂iSSE Łj
+ */
+void multiplyMatricesSse(const Mat4* a, const Mat4* b, Mat4* out, uint32_t count) noexcept {
+    for (uint32_t n = 0; n < count; ++n) {
+        out[n] = a[n] * b[n];
+    }
+}
+#endif
+
+#if SIMD_MATH_AVX2
+//---------------------------------------------------------------------------------
+/**
+ * @brief	xNg̕тϊiAVX2 Łj
+ * @details	128 rbg̏㉺ 1 A2 ̃xNg𓯎ɕϊ
+ */
+void transformVectorsAvx2(const Mat4& m, const Vec4* vectors, Vec4* out, uint32_t count) noexcept {
+    const Mat4   t = transpose(m);
+    const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(t.m[0]));
+    const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(t.m[1]));
+    const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(t.m[2]));
+    const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(t.m[3]));
+    uint32_t     i = 0;
+    for (; i + 2 <= count; i += 2) {
+        const __m256 v = _mm256_loadu_ps(&vectors[i].x);
+        __m256       r = _mm256_mul_ps(c0, _mm256_permute_ps(v, _MM_SHUFFLE(0, 0, 0, 0)));
+        r = _mm256_add_ps(r, _mm256_mul_ps(c1, _mm256_permute_ps(v, _MM_SHUFFLE(1, 1, 1, 1))));
+        r = _mm256_add_ps(r, _mm256_mul_ps(c2, _mm256_permute_ps(v, _MM_SHUFFLE(2, 2, 2, 2))));
+        r = _mm256_add_ps(r, _mm256_mul_ps(c3, _mm256_permute_ps(v, _MM_SHUFFLE(3, 3, 3, 3))));
+        _mm256_storeu_ps(&out[i].x, r);
+    }
+    transformVectorsSse(m, vectors + i, out + i, count - i);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	s̐ς܂Ƃ߂ċ߂iAVX2 Łj
+ * @details	ʂ 2 si㉺ 128 rbgj𓯎ɋ߂Bb ̍s͏㉺ɓ̂u
+ */
+void multiplyMatricesAvx2(const Mat4* a, const Mat4* b, Mat4* out, uint32_t count) noexcept {
+    for (uint32_t n = 0; n < count; ++n) {
+        const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b[n].m[0]));
+        const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b[n].m[1]));
+        const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b[n].m[2]));
+        const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(b[n].m[3]));
+        const __m256 a01 = _mm256_loadu_ps(a[n].m[0]);
+        const __m256 a23 = _mm256_loadu_ps(a[n].m[2]);
+        __m256       r01 = _mm256_mul_ps(_mm256_permute_ps(a01, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_permute_ps(a01, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_permute_ps(a01, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+        r01 = _mm256_add_ps(r01, _mm256_mul_ps(_mm256_permute_ps(a01, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+        __m256 r23 = _mm256_mul_ps(_mm256_permute_ps(a23, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_permute_ps(a23, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_permute_ps(a23, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+        r23 = _mm256_add_ps(r23, _mm256_mul_ps(_mm256_permute_ps(a23, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+        _mm256_storeu_ps(out[n].m[0], r01);
+        _mm256_storeu_ps(out[n].m[2], r23);
+    }
+}
+#endif
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̃rhŎg閽߃ZbgɊۂ߂
+ */
+CullSimd clampSimd(CullSimd simd) noexcept {
+    return simd > bestCullSimd() ? bestCullSimd() : simd;
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ƊpxNH[^jI
+ * @param	axis	]iKς݂̂Ɓj
+ * @param	angle	pxiWAj
+ * @return	NH[^jI
+ */
+Quat Quat::axisAngle(const Vec3& axis, float angle) noexcept {
+    const float s = std::sin(angle * 0.5f);
+    return { axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f) };
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	]s
+ * @param	q	NH[^jIiKς݂̂Ɓj
+ * @return	]s
+ */
+Mat4 Mat4::rotation(const Quat& q) noexcept {
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+    return { { 1.0f - 2.0f * (yy + zz), 2.0f * (xy - wz), 2.0f * (xz + wy), 0.0f },
+             { 2.0f * (xy + wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz - wx), 0.0f },
+             { 2.0f * (xz - wy), 2.0f * (yz + wx), 1.0f - 2.0f * (xx + yy), 0.0f },
+             { 0.0f, 0.0f, 0.0f, 1.0f } };
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	gE]Esړ̏Ɋ|siT * R * Sj
+ * @param	translation	sړ
+ * @param	rotation	]iKς݂̂Ɓj
+ * @param	scale		g
+ * @return	s
+ */
+Mat4 Mat4::trs(const Vec3& translation, const Quat& rotation, const Vec3& scale) noexcept {
+    Mat4 m = Mat4::rotation(rotation);
+    for (int i = 0; i < 3; ++i) {
+        m.m[i][0] *= scale.x;
+        m.m[i][1] *= scale.y;
+        m.m[i][2] *= scale.z;
+    }
+    m.m[0][3] = translation.x;
+    m.m[1][3] = translation.y;
+    m.m[2][3] = translation.z;
+    return m;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	r[sinAr[Ԃ +Z ̌j
+ * @param	eye		_
+ * @param	target	_
+ * @param	up		̌
+ * @return	r[s
+ */
+Mat4 Mat4::lookAt(const Vec3& eye, const Vec3& target, const Vec3& up) noexcept {
+    const Vec3 z = normalize(target - eye);
+    const Vec3 x = normalize(cross(up, z));
+    const Vec3 y = cross(z, x);
+    return { { x.x, x.y, x.z, -dot(x, eye) }, { y.x, y.y, y.z, -dot(y, eye) }, { z.x, z.y, z.z, -dot(z, eye) }, { 0.0f, 0.0f, 0.0f, 1.0f } };
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	esimakePerspectiveProjection Ɠj
+ * @param	fovY		c̉piWAj
+ * @param	aspect		 / c
+ * @param	nearZ		ÕNbvʂ܂ł̋
+ * @param	farZ		̃Nbvʂ܂ł̋ireverseZ Ȃ疳włj
+ * @param	reverseZ	O 1A 0 ɂ
+ * @return	es
+ */
+Mat4 Mat4::perspective(float fovY, float aspect, float nearZ, float farZ, bool reverseZ) noexcept {
+    Mat4 m;
+    makePerspectiveProjection(m.m, fovY, aspect, nearZ, farZ, reverseZ);
+    return m;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ts߂i]qWJj
+ * @param	m		s
+ * @param	result	ts̊i[
+ * @return	ts񂪂 true
+ */
+bool inverse(const Mat4& m, Mat4& result) noexcept {
+    const float* a = &m.m[0][0];
+    float        inv[16];
+    inv[0] = a[5] * a[10] * a[15] - a[5] * a[11] * a[14] - a[9] * a[6] * a[15] + a[9] * a[7] * a[14] + a[13] * a[6] * a[11] - a[13] * a[7] * a[10];
+    inv[4] = -a[4] * a[10] * a[15] + a[4] * a[11] * a[14] + a[8] * a[6] * a[15] - a[8] * a[7] * a[14] - a[12] * a[6] * a[11] + a[12] * a[7] * a[10];
+    inv[8] = a[4] * a[9] * a[15] - a[4] * a[11] * a[13] - a[8] * a[5] * a[15] + a[8] * a[7] * a[13] + a[12] * a[5] * a[11] - a[12] * a[7] * a[9];
+    inv[12] = -a[4] * a[9] * a[14] + a[4] * a[10] * a[13] + a[8] * a[5] * a[14] - a[8] * a[6] * a[13] - a[12] * a[5] * a[10] + a[12] * a[6] * a[9];
+    inv[1] = -a[1] * a[10] * a[15] + a[1] * a[11] * a[14] + a[9] * a[2] * a[15] - a[9] * a[3] * a[14] - a[13] * a[2] * a[11] + a[13] * a[3] * a[10];
+    inv[5] = a[0] * a[10] * a[15] - a[0] * a[11] * a[14] - a[8] * a[2] * a[15] + a[8] * a[3] * a[14] + a[12] * a[2] * a[11] - a[12] * a[3] * a[10];
+    inv[9] = -a[0] * a[9] * a[15] + a[0] * a[11] * a[13] + a[8] * a[1] * a[15] - a[8] * a[3] * a[13] - a[12] * a[1] * a[11] + a[12] * a[3] * a[9];
+    inv[13] = a[0] * a[9] * a[14] - a[0] * a[10] * a[13] - a[8] * a[1] * a[14] + a[8] * a[2] * a[13] + a[12] * a[1] * a[10] - a[12] * a[2] * a[9];
+    inv[2] = a[1] * a[6] * a[15] - a[1] * a[7] * a[14] - a[5] * a[2] * a[15] + a[5] * a[3] * a[14] + a[13] * a[2] * a[7] - a[13] * a[3] * a[6];
+    inv[6] = -a[0] * a[6] * a[15] + a[0] * a[7] * a[14] + a[4] * a[2] * a[15] - a[4] * a[3] * a[14] - a[12] * a[2] * a[7] + a[12] * a[3] * a[6];
+    inv[10] = a[0] * a[5] * a[15] - a[0] * a[7] * a[13] - a[4] * a[1] * a[15] + a[4] * a[3] * a[13] + a[12] * a[1] * a[7] - a[12] * a[3] * a[5];
+    inv[14] = -a[0] * a[5] * a[14] + a[0] * a[6] * a[13] + a[4] * a[1] * a[14] - a[4] * a[2] * a[13] - a[12] * a[1] * a[6] + a[12] * a[2] * a[5];
+    inv[3] = -a[1] * a[6] * a[11] + a[1] * a[7] * a[10] + a[5] * a[2] * a[11] - a[5] * a[3] * a[10] - a[9] * a[2] * a[7] + a[9] * a[3] * a[6];
+    inv[7] = a[0] * a[6] * a[11] - a[0] * a[7] * a[10] - a[4] * a[2] * a[11] + a[4] * a[3] * a[10] + a[8] * a[2] * a[7] - a[8] * a[3] * a[6];
+    inv[11] = -a[0] * a[5] * a[11] + a[0] * a[7] * a[9] + a[4] * a[1] * a[11] - a[4] * a[3] * a[9] - a[8] * a[1] * a[7] + a[8] * a[3] * a[5];
+    inv[15] = a[0] * a[5] * a[10] - a[0] * a[6] * a[9] - a[4] * a[1] * a[10] + a[4] * a[2] * a[9] + a[8] * a[1] * a[6] - a[8] * a[2] * a[5];
+
+    const float determinant = a[0] * inv[0] + a[1] * inv[4] + a[2] * inv[8] + a[3] * inv[12];
+    if (determinant == 0.0f || !std::isfinite(determinant)) {
+        return false;
+    }
+    const float scale = 1.0f / determinant;
+    for (int i = 0; i < 16; ++i) {
+        (&result.m[0][0])[i] = inv[i] * scale;
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ԂĐK
+ * @param	a	t = 0 ̉]
+ * @param	b	t = 1 ̉]
+ * @param	t	ԌW
+ * @return	]
+ */
+Quat nlerp(const Quat& a, const Quat& b, float t) noexcept {
+    // q  -q ͓]Ȃ̂ŁA𑵂ĒZʂ
+    const float sign = dot(a, b) < 0.0f ? -1.0f : 1.0f;
+    const float s = 1.0f - t;
+    const float u = t * sign;
+    return normalize(Quat{ a.x * s + b.x * u, a.y * s + b.y * u, a.z * s + b.z * u, a.w * s + b.w * u });
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ʐ`
+ * @param	a	t = 0 ̉]iKς݂̂Ɓj
+ * @param	b	t = 1 ̉]iKς݂̂Ɓj
+ * @param	t	ԌW
+ * @return	]
+ */
+Quat slerp(const Quat& a, const Quat& b, float t) noexcept {
+    float       cosine = dot(a, b);
+    const float sign = cosine < 0.0f ? -1.0f : 1.0f;
+    cosine *= sign;
+    // قړȂ sin ŊƐx̂ŒŕԂ
+    if (cosine > 0.9995f) {
+        return nlerp(a, b, t);
+    }
+    const float angle = std::acos(cosine);
+    const float inverseSine = 1.0f / std::sin(angle);
+    const float s = std::sin((1.0f - t) * angle) * inverseSine;
+    const float u = std::sin(t * angle) * inverseSine * sign;
+    return { a.x * s + b.x * u, a.y * s + b.y * u, a.z * s + b.z * u, a.w * s + b.w * u };
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_̕тϊ
+ * @param	matrix	s
+ * @param	points	_
+ * @param	out		ݐ
+ * @param	count	_̐
+ * @param	simd	g߃Zbg
+ */
+void transformPoints(const Mat4& matrix, const Vec3* points, Vec4* out, uint32_t count, CullSimd simd) noexcept {
+    // _ 12 oCg 2 ɓǂޗ_̂ŁAAVX2 ł SSE łg
+    switch (clampSimd(simd)) {
+#if SIMD_MATH_SSE
+    case CullSimd::Avx2:
+    case CullSimd::Sse:
+        transformPointsSse(matrix, points, out, count);
+        break;
+#endif
+    default:
+        transformPointsScalar(matrix, points, out, count);
+        break;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	4 vf̃xNg̕тϊ
+ * @param	matrix	s
+ * @param	vectors	xNg
+ * @param	out		ݐ
+ * @param	count	xNg̐
+ * @param	simd	g߃Zbg
+ */
+void transformVectors(const Mat4& matrix, const Vec4* vectors, Vec4* out, uint32_t count, CullSimd simd) noexcept {
+    switch (clampSimd(simd)) {
+#if SIMD_MATH_AVX2
+    case CullSimd::Avx2:
+        transformVectorsAvx2(matrix, vectors, out, count);
+        break;
+#endif
+#if SIMD_MATH_SSE
+    case CullSimd::Sse:
+        transformVectorsSse(matrix, vectors, out, count);
+        break;
+#endif
+    default:
+        transformVectorsScalar(matrix, vectors, out, count);
+        break;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	s̐ς܂Ƃ߂ċ߂
+ * @param	a		̍s
+ * @param	b		E̍s
+ * @param	out		ݐ
+ * @param	count	s̐
+ * @param	simd	g߃Zbg
+ */
+void multiplyMatrices(const Mat4* a, const Mat4* b, Mat4* out, uint32_t count, CullSimd simd) noexcept {
+    switch (clampSimd(simd)) {
+#if SIMD_MATH_AVX2
+    case CullSimd::Avx2:
+        multiplyMatricesAvx2(a, b, out, count);
+        break;
+#endif
+#if SIMD_MATH_SSE
+    case CullSimd::Sse:
+        multiplyMatricesSse(a, b, out, count);
+        break;
+#endif
+    default:
+        multiplyMatricesScalar(a, b, out, count);
+        break;
+    }
+}
@@ -0,0 +1,262 @@
+// SIMD wCuixNgEsENH[^jIj
+
+#pragma once
+
+#include "frustum_culling.h"
+#include <cmath>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#define SIMD_MATH_SSE 1
+#include <emmintrin.h>
+#endif
+
+// ̕т HLSL Ɠɂ
+//   Vec3 = float3i12 oCgBcbuffer ł͌ float  1 l߂j
+//   Vec4 / Quat = float4
+//   Mat4 = float4  4 sicbuffer  float4 m[4]  row_major float4x4Bclip = M * pj
+// 1 ̉Z SSE  SSEA΃XJ[ŌvZBт̑ϊ transformVectors Ȃǂł܂Ƃ߂čs
+// ǂ̎ FMA g킸AԂ (((x + y) + z) + w) ɑĂ̂ŁAʂ̓rbgPʂňv
+
+/// 3 vf̃xNg
+struct Vec3 {
+    float x, y, z;
+
+    constexpr Vec3() noexcept : x(0.0f), y(0.0f), z(0.0f) {}
+    constexpr Vec3(float x, float y, float z) noexcept : x(x), y(y), z(z) {}
+    constexpr explicit Vec3(float s) noexcept : x(s), y(s), z(s) {}
+};
+static_assert(sizeof(Vec3) == 12, "Vec3  HLSL  float3 Ɠ 12 oCgɂ");
+
+/// 4 vf̃xNg
+struct alignas(16) Vec4 {
+    float x, y, z, w;
+
+    constexpr Vec4() noexcept : x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
+    constexpr Vec4(float x, float y, float z, float w) noexcept : x(x), y(y), z(z), w(w) {}
+    constexpr Vec4(const Vec3& v, float w) noexcept : x(v.x), y(v.y), z(v.z), w(w) {}
+    constexpr explicit Vec4(float s) noexcept : x(s), y(s), z(s), w(s) {}
+    constexpr Vec3 xyz() const noexcept { return { x, y, z }; }
+};
+static_assert(sizeof(Vec4) == 16, "Vec4  HLSL  float4 Ɠ 16 oCgɂ");
+
+/// NH[^jIix, y, z Aw j
+struct alignas(16) Quat {
+    float x, y, z, w;
+
+    constexpr Quat() noexcept : x(0.0f), y(0.0f), z(0.0f), w(1.0f) {}
+    constexpr Quat(float x, float y, float z, float w) noexcept : x(x), y(y), z(z), w(w) {}
+    static constexpr Quat identity() noexcept { return {}; }
+    static Quat axisAngle(const Vec3& axis, float angle) noexcept;
+};
+static_assert(sizeof(Quat) == 16, "Quat  HLSL  float4 Ɠ 16 oCgɂ");
+
+/// 4x4 sisDAclip = M * pBsړ 4 ځj
+struct alignas(16) Mat4 {
+    float m[4][4];  ///< m[s][]Bfloat[4][4] 󂯎̊֐ւ̂܂ܓn
+
+    constexpr Mat4() noexcept : m{} {}
+    constexpr Mat4(const Vec4& r0, const Vec4& r1, const Vec4& r2, const Vec4& r3) noexcept
+        : m{ { r0.x, r0.y, r0.z, r0.w }, { r1.x, r1.y, r1.z, r1.w }, { r2.x, r2.y, r2.z, r2.w }, { r3.x, r3.y, r3.z, r3.w } } {}
+    constexpr Vec4 row(int i) const noexcept { return { m[i][0], m[i][1], m[i][2], m[i][3] }; }
+    constexpr Vec4 column(int i) const noexcept { return { m[0][i], m[1][i], m[2][i], m[3][i] }; }
+
+    static constexpr Mat4 identity() noexcept { return { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } }; }
+    static constexpr Mat4 translation(const Vec3& t) noexcept { return { { 1, 0, 0, t.x }, { 0, 1, 0, t.y }, { 0, 0, 1, t.z }, { 0, 0, 0, 1 } }; }
+    static constexpr Mat4 scale(const Vec3& s) noexcept { return { { s.x, 0, 0, 0 }, { 0, s.y, 0, 0 }, { 0, 0, s.z, 0 }, { 0, 0, 0, 1 } }; }
+    static Mat4 rotation(const Quat& q) noexcept;
+    static Mat4 trs(const Vec3& translation, const Quat& rotation, const Vec3& scale) noexcept;
+    static Mat4 lookAt(const Vec3& eye, const Vec3& target, const Vec3& up) noexcept;
+    static Mat4 perspective(float fovY, float aspect, float nearZ, float farZ, bool reverseZ) noexcept;
+};
+static_assert(sizeof(Mat4) == 64, "Mat4  HLSL  float4x4 Ɠ 64 oCgɂ");
+
+// --------------------
+// Vec3
+// --------------------
+constexpr Vec3 operator+(const Vec3& a, const Vec3& b) noexcept { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+constexpr Vec3 operator-(const Vec3& a, const Vec3& b) noexcept { return { a.x - b.x, a.y - b.y, a.z - b.z }; }
+constexpr Vec3 operator*(const Vec3& a, const Vec3& b) noexcept { return { a.x * b.x, a.y * b.y, a.z * b.z }; }
+constexpr Vec3 operator*(const Vec3& a, float s) noexcept { return { a.x * s, a.y * s, a.z * s }; }
+constexpr Vec3 operator*(float s, const Vec3& a) noexcept { return a * s; }
+constexpr Vec3 operator-(const Vec3& a) noexcept { return { -a.x, -a.y, -a.z }; }
+constexpr float dot(const Vec3& a, const Vec3& b) noexcept { return (a.x * b.x + a.y * b.y) + a.z * b.z; }
+constexpr Vec3 cross(const Vec3& a, const Vec3& b) noexcept { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+inline float length(const Vec3& a) noexcept { return std::sqrt(dot(a, a)); }
+inline Vec3 normalize(const Vec3& a) noexcept { return a * (1.0f / length(a)); }
+constexpr Vec3 lerp(const Vec3& a, const Vec3& b, float t) noexcept { return a + (b - a) * t; }
+
+// --------------------
+// Vec4
+// --------------------
+#if SIMD_MATH_SSE
+inline __m128 loadVec4(const Vec4& v) noexcept { return _mm_load_ps(&v.x); }
+inline Vec4 storeVec4(__m128 v) noexcept {
+    Vec4 result;
+    _mm_store_ps(&result.x, v);
+    return result;
+}
+inline Vec4 operator+(const Vec4& a, const Vec4& b) noexcept { return storeVec4(_mm_add_ps(loadVec4(a), loadVec4(b))); }
+inline Vec4 operator-(const Vec4& a, const Vec4& b) noexcept { return storeVec4(_mm_sub_ps(loadVec4(a), loadVec4(b))); }
+inline Vec4 operator*(const Vec4& a, const Vec4& b) noexcept { return storeVec4(_mm_mul_ps(loadVec4(a), loadVec4(b))); }
+inline Vec4 operator*(const Vec4& a, float s) noexcept { return storeVec4(_mm_mul_ps(loadVec4(a), _mm_set1_ps(s))); }
+#else
+inline Vec4 operator+(const Vec4& a, const Vec4& b) noexcept { return { a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w }; }
+inline Vec4 operator-(const Vec4& a, const Vec4& b) noexcept { return { a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w }; }
+inline Vec4 operator*(const Vec4& a, const Vec4& b) noexcept { return { a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w }; }
+inline Vec4 operator*(const Vec4& a, float s) noexcept { return { a.x * s, a.y * s, a.z * s, a.w * s }; }
+#endif
+inline Vec4 operator*(float s, const Vec4& a) noexcept { return a * s; }
+constexpr float dot(const Vec4& a, const Vec4& b) noexcept { return ((a.x * b.x + a.y * b.y) + a.z * b.z) + a.w * b.w; }
+inline float length(const Vec4& a) noexcept { return std::sqrt(dot(a, a)); }
+inline Vec4 normalize(const Vec4& a) noexcept { return a * (1.0f / length(a)); }
+
+// --------------------
+// Mat4
+// --------------------
+//---------------------------------------------------------------------------------
+/**
+ * @brief	s̐ρia * bBb Ɋ|j
+ */
+inline Mat4 operator*(const Mat4& a, const Mat4& b) noexcept {
+    Mat4 result;
+#if SIMD_MATH_SSE
+    // ʂ i s = a[i][0] * b  0 s + ... + a[i][3] * b  3 s
+    const __m128 b0 = _mm_load_ps(b.m[0]);
+    const __m128 b1 = _mm_load_ps(b.m[1]);
+    const __m128 b2 = _mm_load_ps(b.m[2]);
+    const __m128 b3 = _mm_load_ps(b.m[3]);
+    for (int i = 0; i < 4; ++i) {
+        __m128 row = _mm_mul_ps(_mm_set1_ps(a.m[i][0]), b0);
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][1]), b1));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][2]), b2));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][3]), b3));
+        _mm_store_ps(result.m[i], row);
+    }
+#else
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            result.m[i][j] = ((a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j]) + a.m[i][2] * b.m[2][j]) + a.m[i][3] * b.m[3][j];
+        }
+    }
+#endif
+    return result;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	xNgϊim * vj
+ */
+inline Vec4 operator*(const Mat4& m, const Vec4& v) noexcept {
+    return { dot(m.row(0), v), dot(m.row(1), v), dot(m.row(2), v), dot(m.row(3), v) };
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_ϊiw = 1 ƂĊ|Aw ł͊Ȃj
+ */
+inline Vec3 transformPoint(const Mat4& m, const Vec3& p) noexcept {
+    return (m * Vec4(p, 1.0f)).xyz();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ϊiw = 0 ƂĊ|Bsړ͌Ȃj
+ */
+inline Vec3 transformVector(const Mat4& m, const Vec3& v) noexcept {
+    return (m * Vec4(v, 0.0f)).xyz();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	]u
+ */
+constexpr Mat4 transpose(const Mat4& m) noexcept {
+    return { m.column(0), m.column(1), m.column(2), m.column(3) };
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ts߂
+ * @param	m		s
+ * @param	result	ts̊i[
+ * @return	ts񂪂 truei result ͕ςȂj
+ */
+bool inverse(const Mat4& m, Mat4& result) noexcept;
+
+// --------------------
+// Quat
+// --------------------
+//---------------------------------------------------------------------------------
+/**
+ * @brief	NH[^jI̐ρia * bBb ̉]ɍsj
+ */
+constexpr Quat operator*(const Quat& a, const Quat& b) noexcept {
+    return { a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y, a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+             a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w, a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z };
+}
+constexpr Quat conjugate(const Quat& q) noexcept { return { -q.x, -q.y, -q.z, q.w }; }
+constexpr float dot(const Quat& a, const Quat& b) noexcept { return ((a.x * b.x + a.y * b.y) + a.z * b.z) + a.w * b.w; }
+inline Quat normalize(const Quat& q) noexcept {
+    const float s = 1.0f / std::sqrt(dot(q, q));
+    return { q.x * s, q.y * s, q.z * s, q.w * s };
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	xNg]iq ͐Kς݂̂Ɓj
+ */
+constexpr Vec3 rotate(const Quat& q, const Vec3& v) noexcept {
+    // v + 2w(u x v) + 2u x (u x v)
+    const Vec3 u{ q.x, q.y, q.z };
+    const Vec3 t = cross(u, v) * 2.0f;
+    return v + t * q.w + cross(u, t);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ԂĐKiŽʂʂBpx͈łȂj
+ */
+Quat nlerp(const Quat& a, const Quat& b, float t) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ʐ`ԁiŽʂ̊pxŒʂj
+ */
+Quat slerp(const Quat& a, const Quat& b, float t) noexcept;
+
+// --------------------
+// ܂Ƃ߂ĕϊ
+// --------------------
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_̕тϊiw = 1 ƂĊ|ANbvWȂǂ 4 vfŏoj
+ * @param	matrix	s
+ * @param	points	_
+ * @param	out		ݐicount j
+ * @param	count	_̐
+ * @param	simd	g߃ZbgĩrhŎgȂw肵g钆ōł̍Lɂj
+ */
+void transformPoints(const Mat4& matrix, const Vec3* points, Vec4* out, uint32_t count, CullSimd simd = bestCullSimd()) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	4 vf̃xNg̕тϊ
+ * @param	matrix	s
+ * @param	vectors	xNg
+ * @param	out		ݐicount Bvectors Ɠł悢j
+ * @param	count	xNg̐
+ * @param	simd	g߃Zbg
+ */
+void transformVectors(const Mat4& matrix, const Vec4* vectors, Vec4* out, uint32_t count, CullSimd simd = bestCullSimd()) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	s̐ς܂Ƃ߂ċ߂iout[i] = a[i] * b[i]j
+ * @param	a		̍s
+ * @param	b		E̍s
+ * @param	out		ݐicount Ba  b Ɠł悢j
+ * @param	count	s̐
+ * @param	simd	g߃Zbg
+ */
+void multiplyMatrices(const Mat4* a, const Mat4* b, Mat4* out, uint32_t count, CullSimd simd = bestCullSimd()) noexcept;
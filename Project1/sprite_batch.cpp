@@ -0,0 +1,142 @@
+// XvCgob`NX
+
+#include "sprite_batch.h"
+#include "job_system.h"
+#include "radix_sort.h"
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+// L[̃rbgzu: C[ 16 | uh 4 | eNX` 20 | ǉ 24
+constexpr uint32_t IndexBits   = 24;
+constexpr uint32_t TextureBits = 20;
+constexpr uint32_t BlendBits   = 4;
+constexpr uint32_t StateShift  = IndexBits;
+constexpr uint32_t LayerShift  = IndexBits + TextureBits + BlendBits;
+constexpr uint64_t IndexMask   = (1ull << IndexBits) - 1;
+constexpr uint64_t StateMask   = (1ull << (TextureBits + BlendBits)) - 1;
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t[̃XvCgSĎ̂Ăimۍς݂̗eʂ͎cj
+ */
+void SpriteBatch::clear() noexcept {
+    instances_.clear();
+    keys_.clear();
+    batches_.clear();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	XvCgǉ
+ * @param	sprite	XvCg
+ */
+void SpriteBatch::draw(const Sprite& sprite) {
+    assert(instances_.size() < MaxSprites && "XvCg܂");
+    assert(sprite.texture < (1u << TextureBits) && "eNX`ԍ傫܂");
+
+    const auto index = static_cast<uint64_t>(instances_.size());
+
+    SpriteInstance instance;
+    instance.rect[0] = sprite.x;
+    instance.rect[1] = sprite.y;
+    instance.rect[2] = sprite.width;
+    instance.rect[3] = sprite.height;
+    instance.uv[0] = sprite.uv[0];
+    instance.uv[1] = sprite.uv[1];
+    instance.uv[2] = sprite.uv[2];
+    instance.uv[3] = sprite.uv[3];
+    // ]͒_Ƃł͂Ȃ 1 񂾂߂
+    instance.rotation[0] = sprite.rotation == 0.0f ? 1.0f : std::cos(sprite.rotation);
+    instance.rotation[1] = sprite.rotation == 0.0f ? 0.0f : std::sin(sprite.rotation);
+    instance.color = sprite.color;
+    instance.reserved = 0;
+    instances_.push_back(instance);
+
+    keys_.push_back((static_cast<uint64_t>(sprite.layer) << LayerShift) |
+                    (static_cast<uint64_t>(sprite.blend) << (StateShift + TextureBits)) |
+                    (static_cast<uint64_t>(sprite.texture) << StateShift) |
+                    index);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	\[gĕ`Pʂ߂
+ * @return	`揇̃ob`
+ */
+const std::vector<SpriteBatch::Batch>& SpriteBatch::build() {
+    batches_.clear();
+    if (keys_.empty()) {
+        return batches_;
+    }
+
+    // ǉ̔ԍ͍ŏ珸Ȃ̂ŁȀ̃rbgבւ
+    scratch_.resize(keys_.size());
+    radixSort(keys_.data(), scratch_.data(), keys_.size(), IndexBits, 64);
+
+    // C[ςĂԂȂ瓯`̂܂ܑ
+    uint64_t state = ~0ull;
+    for (uint32_t i = 0; i < keys_.size(); ++i) {
+        const uint64_t keyState = (keys_[i] >> StateShift) & StateMask;
+        if (keyState != state) {
+            state = keyState;
+            batches_.push_back({ static_cast<uint32_t>(keyState & ((1u << TextureBits) - 1)),
+                                 static_cast<BlendMode>(keyState >> TextureBits), i, 0 });
+        }
+        ++batches_.back().instanceCount;
+    }
+    return batches_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CX^Xf[^`揇ɋl߂ibuild ̌ɌĂԁj
+ * @param	destination	ݐispriteCount j
+ * @param	jobSystem	ɋl߂ꍇ̃WuVXe
+ */
+void SpriteBatch::pack(SpriteInstance* destination, JobSystem* jobSystem) const noexcept {
+    assert(destination);
+
+    // ǂݍ݂͂΂΂炾݂͘AɂȂi݌ɂ͘A݂dvj
+    const auto packRange = [this, destination](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            destination[i] = instances_[keys_[i] & IndexMask];
+        }
+    };
+
+    const auto count = spriteCount();
+    if (jobSystem) {
+        jobSystem->parallelFor(count, 16384, packRange);
+    }
+    else {
+        packRange(0, count);
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ǉꂽXvCg擾
+ * @return	XvCg
+ */
+[[nodiscard]] uint32_t SpriteBatch::spriteCount() const noexcept {
+    return static_cast<uint32_t>(instances_.size());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	XvCg̒_CAEg擾
+ * @param	slot	̓Xbg
+ * @return	_CAEg
+ */
+[[nodiscard]] std::vector<PipelineInputElement> SpriteBatch::inputLayout(uint32_t slot) {
+    // DXGI_FORMAT_R32G32B32A32_FLOAT / R32G32_FLOAT / R8G8B8A8_UNORMiXgCh SpriteInstance  48 oCgj
+    return {
+        { "INSTANCE_RECT", 0, 2, slot, PipelineStateDesc::AppendAligned, true, 1 },
+        { "INSTANCE_UV", 0, 2, slot, PipelineStateDesc::AppendAligned, true, 1 },
+        { "INSTANCE_ROTATION", 0, 16, slot, PipelineStateDesc::AppendAligned, true, 1 },
+        { "INSTANCE_COLOR", 0, 28, slot, PipelineStateDesc::AppendAligned, true, 1 },
+    };
+}
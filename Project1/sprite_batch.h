@@ -0,0 +1,116 @@
+// XvCgob`NX
+
+#pragma once
+
+#include "pipeline_state_desc.h"
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+/// `悷XvCg
+struct Sprite {
+    float     x;               ///< S X WisNZA㌴_j
+    float     y;               ///< S Y W
+    float     width;           ///< isNZj
+    float     height;          ///< 
+    float     rotation;        ///< ]iWAAS܂j
+    float     uv[4];           ///< eNX`W (u0, v0, u1, v1)
+    uint32_t  color;           ///< ZJ[ (0xAABBGGRR)
+    uint32_t  texture;         ///< eNX`ԍ
+    BlendMode blend;           ///< uh
+    uint16_t  layer;           ///< C[iقǉj
+};
+
+/// GPU ɓn 1 XvCg̃CX^Xf[^iINSTANCE_RECT / UV / ROTATION / COLORj
+struct alignas(16) SpriteInstance {
+    float    rect[4];      ///< S XY ƕE
+    float    uv[4];        ///< eNX`W
+    float    rotation[2];  ///< ] cos, sin
+    uint32_t color;        ///< ZJ[
+    uint32_t reserved;     ///< 16 oCgEɑ邽߂̗\
+};
+static_assert(sizeof(SpriteInstance) == 48, "XvCg̒_CAEgƂĂ܂");
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	XvCgob`NX
+ * @details	t[̃XvCgW߁AC[uheNX`̏ 64bit L[
+ *			\[gAԂς鏊ł`𕪂
+ *			lp`͒_VF[_ SV_VertexID WĴŁA1 XvCg 48 oCg̃CX^X 1 
+ *			L[̉ 24bit ͒ǉ̔ԍŁAԂ̒ł͒ǉۂ
+ */
+class SpriteBatch final {
+public:
+    /// 1 t[ɒǉłő吔iL[̔ԍ̃rbgŌ܂j
+    static constexpr uint32_t MaxSprites = 1u << 24;
+
+    /// 1 ̕`ɂ܂Ƃ߂XvCg
+    struct Batch {
+        uint32_t  texture;        ///< eNX`ԍ
+        BlendMode blend;          ///< uh
+        uint32_t  firstInstance;  ///< CX^X̊Jnʒu
+        uint32_t  instanceCount;  ///< CX^X
+    };
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    SpriteBatch() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~SpriteBatch() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	t[̃XvCgSĎ̂Ăimۍς݂̗eʂ͎cj
+     */
+    void clear() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	XvCgǉ
+     * @param	sprite	XvCg
+     */
+    void draw(const Sprite& sprite);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	\[gĕ`Pʂ߂
+     * @return	`揇̃ob`
+     */
+    const std::vector<Batch>& build();
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	CX^Xf[^`揇ɋl߂ibuild ̌ɌĂԁj
+     * @param	destination	ݐispriteCount j
+     * @param	jobSystem	ɋl߂ꍇ̃WuVXeinullptr ȂĂяoXbhŋl߂j
+     */
+    void pack(SpriteInstance* destination, JobSystem* jobSystem = nullptr) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ǉꂽXvCg擾
+     * @return	XvCg
+     */
+    [[nodiscard]] uint32_t spriteCount() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	XvCg̒_CAEg擾
+     * @param	slot	̓Xbg
+     * @return	_CAEgiSăCX^XPʁj
+     */
+    [[nodiscard]] static std::vector<PipelineInputElement> inputLayout(uint32_t slot = 1);
+
+private:
+    std::vector<SpriteInstance> instances_{};  /// ǉ̃CX^Xf[^
+    std::vector<uint64_t>       keys_{};       /// \[gL[
+    std::vector<uint64_t>       scratch_{};    /// \[g̍Ɨ̈
+    std::vector<Batch>          batches_{};    /// `揇̃ob`
+};
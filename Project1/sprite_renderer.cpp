@@ -0,0 +1,115 @@
+// XvCg`NX
+
+#include "sprite_renderer.h"
+#include "pipline_state_object.h"
+#include "root_signature_builder.h"
+#include <cassert>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	device				foCXNX̃CX^X
+ * @param	rootSignatureCache	[gVOl`LbV
+ * @param	pipelineCache		pCvCXe[gLbV
+ * @param	maxSprites			1 t[ɕ`őXvCg
+ * @param	frameCount			 GPU QƂt[
+ * @return	 true
+ */
+[[nodiscard]] bool SpriteRenderer::create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache,
+                                          uint32_t maxSprites, uint32_t frameCount) noexcept {
+    if (!shader_.create(device, L"asset/sprite.hlsl", {})) {
+        return false;
+    }
+
+    // b0: r[|[g̋ti[g萔j, t0: eNX`, s0: jATv[
+    RootSignatureBuilder builder;
+    builder.addConstants(2, 0, 0, D3D12_SHADER_VISIBILITY_VERTEX)
+        .addTable({ { D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0 } }, D3D12_SHADER_VISIBILITY_PIXEL)
+        .addStaticSampler(0, D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_TEXTURE_ADDRESS_MODE_CLAMP);
+    rootSignature_ = rootSignatureCache.getOrCreate(device, builder);
+    if (!rootSignature_) {
+        return false;
+    }
+
+    pipelineCache_ = &pipelineCache;
+    for (uint32_t i = 0; i < BlendModeCount; ++i) {
+        PipelineStateDesc desc = PiplineStateObject::defaultDesc();
+        desc.inputLayout = SpriteBatch::inputLayout();
+        desc.blend = static_cast<BlendMode>(i);
+        desc.cull = CullMode::None;
+        desc.depth = DepthMode::Disabled;
+        pipelines_[i] = pipelineCache.request(desc, shader_, *rootSignature_);
+    }
+
+    return ring_.create(device, uint64_t(sizeof(SpriteInstance)) * maxSprites, frameCount);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	XvCg`悷
+ * @param	commandList		R}hXg
+ * @param	batch			XvCgob`
+ * @param	frameIndex		t[ԍ
+ * @param	viewportWidth	r[|[g̕isNZj
+ * @param	viewportHeight	r[|[g̍
+ * @param	resolveTexture	eNX`ԍ SRV ֐
+ * @param	jobSystem		lߍ݂񉻂ꍇ̃WuVXe
+ * @return	`R[
+ */
+uint32_t SpriteRenderer::render(ID3D12GraphicsCommandList* commandList, SpriteBatch& batch, uint32_t frameIndex, float viewportWidth, float viewportHeight,
+                                const TextureResolver& resolveTexture, JobSystem* jobSystem) noexcept {
+    assert(rootSignature_ && "XvCg`悪쐬ł");
+
+    ring_.beginFrame(frameIndex);
+
+    const auto& batches = batch.build();
+    const auto count = batch.spriteCount();
+    if (batches.empty()) {
+        return 0;
+    }
+
+    // dȂ菇Ȃ悤ASuh̃pCvCoオ܂ł͉`Ȃ
+    ID3D12PipelineState* pipelineStates[BlendModeCount]{};
+    for (uint32_t i = 0; i < BlendModeCount; ++i) {
+        pipelineStates[i] = pipelineCache_->get(pipelines_[i]);
+        if (!pipelineStates[i]) {
+            return 0;
+        }
+    }
+
+    UploadRing::Allocation allocation{};
+    if (!ring_.allocate(uint64_t(sizeof(SpriteInstance)) * count, alignof(SpriteInstance), allocation)) {
+        assert(false && "XvCg̃O܂");
+        return 0;
+    }
+    batch.pack(static_cast<SpriteInstance*>(allocation.cpuAddress), jobSystem);
+
+    D3D12_VERTEX_BUFFER_VIEW view{};
+    view.BufferLocation = allocation.gpuAddress;
+    view.SizeInBytes = static_cast<UINT>(allocation.size);
+    view.StrideInBytes = sizeof(SpriteInstance);
+
+    const float inverseViewport[2] = { 1.0f / viewportWidth, 1.0f / viewportHeight };
+    commandList->SetGraphicsRootSignature(rootSignature_->get());
+    commandList->SetGraphicsRoot32BitConstants(0, 2, inverseViewport, 0);
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    commandList->IASetVertexBuffers(1, 1, &view);
+
+    // Ԃςݒ肷
+    int currentBlend = -1;
+    uint32_t currentTexture = UINT32_MAX;
+    for (const auto& b : batches) {
+        const int blend = static_cast<int>(b.blend);
+        if (blend != currentBlend) {
+            currentBlend = blend;
+            commandList->SetPipelineState(pipelineStates[blend]);
+        }
+        if (b.texture != currentTexture) {
+            currentTexture = b.texture;
+            commandList->SetGraphicsRootDescriptorTable(1, resolveTexture(b.texture));
+        }
+        commandList->DrawInstanced(4, b.instanceCount, 0, b.firstInstance);
+    }
+
+    return static_cast<uint32_t>(batches.size());
+}
@@ -0,0 +1,81 @@
+// XvCg`NX
+
+#pragma once
+
+#include "device.h"
+#include "pipeline_state_cache.h"
+#include "root_signature_cache.h"
+#include "shader.h"
+#include "sprite_batch.h"
+#include "upload_ring.h"
+#include <cstdint>
+#include <d3d12.h>
+#include <functional>
+
+class JobSystem;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	XvCg`NX
+ * @details	SpriteBatch ̓eAbv[hO֋l߁Aob`Ƃ DrawInstanced(4, n) ŕ`
+ *			pCvC̓uh̎ނƂ 1 AeNX`̓fBXNv^e[uŐ؂ւ
+ *			ԂÕob`ƓȂݒ肵Ȃ
+ */
+class SpriteRenderer final {
+public:
+    /// eNX`ԍ SRV ̃fBXNv^֐
+    using TextureResolver = std::function<D3D12_GPU_DESCRIPTOR_HANDLE(uint32_t texture)>;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    SpriteRenderer() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~SpriteRenderer() = default;
+
+    // Rs[֎~
+    SpriteRenderer(const SpriteRenderer&) = delete;
+    SpriteRenderer& operator=(const SpriteRenderer&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	device				foCXNX̃CX^X
+     * @param	rootSignatureCache	[gVOl`LbV
+     * @param	pipelineCache		pCvCXe[gLbV
+     * @param	maxSprites			1 t[ɕ`őXvCg
+     * @param	frameCount			 GPU QƂt[
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache,
+                              uint32_t maxSprites, uint32_t frameCount) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	XvCg`悷
+     * @param	commandList		R}hXgi_[^[QbgEr[|[gEfBXNv^q[v͐ݒς݂̂Ɓj
+     * @param	batch			XvCgob`
+     * @param	frameIndex		t[ԍ
+     * @param	viewportWidth	r[|[g̕isNZj
+     * @param	viewportHeight	r[|[g̍
+     * @param	resolveTexture	eNX`ԍ SRV ֐
+     * @param	jobSystem		lߍ݂񉻂ꍇ̃WuVXeinullptr j
+     * @return	`R[BŐ󂫂ȂpCvC쐬Ȃ 0
+     */
+    uint32_t render(ID3D12GraphicsCommandList* commandList, SpriteBatch& batch, uint32_t frameIndex, float viewportWidth, float viewportHeight,
+                    const TextureResolver& resolveTexture, JobSystem* jobSystem = nullptr) noexcept;
+
+private:
+    static constexpr uint32_t BlendModeCount = 4;  /// BlendMode ̎ސ
+
+    Shader                       shader_{};                       /// XvCgpVF[_
+    const RootSignature*         rootSignature_{};                /// [gVOl`iLbVLj
+    PipelineStateCache*          pipelineCache_{};                /// pCvCXe[gLbV
+    PipelineStateCache::Handle   pipelines_[BlendModeCount]{};    /// uh̎ނƂ̃pCvC
+    UploadRing                   ring_{};                         /// CX^Xf[^̃O
+};
@@ -0,0 +1,98 @@
+// VXeXPW[[NX
+
+#include "system_scheduler.h"
+#include "job_system.h"
+#include <algorithm>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VXeo^
+ * @param	world	VXes郏[hiNGj
+ * @param	desc	VXe
+ * @return	VXe̔ԍ
+ */
+uint32_t SystemScheduler::add(EntityWorld& world, const SystemDesc& desc) {
+    System system;
+    system.desc = desc;
+    system.query = world.createQuery(desc.reads | desc.writes, desc.exclude);
+
+    // Ԃ̃VXêł̒i̎ɒu
+    for (const System& other : systems_) {
+        const bool conflict = (desc.writes & (other.desc.reads | other.desc.writes)) || (desc.reads & other.desc.writes);
+        if (conflict) {
+            system.stage = std::max(system.stage, other.stage + 1);
+        }
+    }
+    stageCount_ = std::max(stageCount_, system.stage + 1);
+    systems_.push_back(std::move(system));
+    return static_cast<uint32_t>(systems_.size() - 1);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SẴVXesAL^ꂽ\̕ύX𔽉f
+ * @param	world		[hiadd Ɠ́j
+ * @param	jobSystem	ɏꍇ̃WuVXeinullptr ȂĂяoXbhŏj
+ */
+void SystemScheduler::run(EntityWorld& world, JobSystem* jobSystem) {
+    for (uint32_t stage = 0; stage < stageCount_; ++stage) {
+        // ȋSẴVXẽ`N 1 ̕тɂ
+        tasks_.clear();
+        for (uint32_t index = 0; index < systems_.size(); ++index) {
+            System& system = systems_[index];
+            if (system.stage != stage) {
+                continue;
+            }
+            chunks_.clear();
+            world.collectChunks(system.query, chunks_);
+            if (system.commandBuffers.size() < chunks_.size()) {
+                system.commandBuffers.resize(chunks_.size());
+            }
+            for (uint32_t chunk = 0; chunk < chunks_.size(); ++chunk) {
+                tasks_.push_back({ index, chunk, chunks_[chunk] });
+            }
+        }
+
+        const auto execute = [this](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                const Task& task = tasks_[i];
+                System&     system = systems_[task.system];
+                system.desc.update(task.view, system.commandBuffers[task.chunk]);
+            }
+        };
+        if (jobSystem) {
+            jobSystem->parallelFor(static_cast<uint32_t>(tasks_.size()), 1, execute);
+        }
+        else {
+            execute(0, static_cast<uint32_t>(tasks_.size()));
+        }
+    }
+
+    // \̕ύX͑SĂ̒iIĂ猈܂ɔf
+    for (System& system : systems_) {
+        for (EntityCommandBuffer& commandBuffer : system.commandBuffers) {
+            if (!commandBuffer.empty()) {
+                commandBuffer.playback(world);
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VXe̒uꂽi擾
+ * @param	system	VXe̔ԍ
+ * @return	ii0 j
+ */
+uint32_t SystemScheduler::stage(uint32_t system) const noexcept {
+    return systems_[system].stage;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	i̐擾
+ * @return	i̐
+ */
+uint32_t SystemScheduler::stageCount() const noexcept {
+    return stageCount_;
+}
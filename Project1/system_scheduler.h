@@ -0,0 +1,87 @@
+// VXeXPW[[NX
+
+#pragma once
+
+#include "entity_command_buffer.h"
+#include "entity_world.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+class JobSystem;
+
+/// VXeiNGɍ`NƂɌĂ΂鏈j
+struct SystemDesc {
+    std::string   name;       ///< O
+    ComponentMask reads{};    ///< ǂނ̃R|[lg
+    ComponentMask writes{};   ///< R|[lg
+    ComponentMask exclude{};  ///< ĂGeBeBR|[lg
+    /// update(`N, \̕ύX̋L^) ̌`ŌĂ΂鏈Breads / writes ȊÕR|[lgɂ͐GȂ
+    std::function<void(const ChunkView&, EntityCommandBuffer&)> update;
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	VXeXPW[[NX
+ * @details	VXe reads | writes SĎGeBeB̃`NƂɌĂ΂
+ *			o^ɁAɓo^VXeƓǂݏԂiЕR|[lgЕǂނjȂ
+ *			̌̒iɒuAԂȂΓiɒuBĩVXe͑SẴ`N킹ĕɎs
+ *			\̕ύX̓`NƂ̃R}hobt@ɋL^ASĂ̒iIĂo^E`Nɔf̂ŁA
+ *			ʂ͕񐔂ɂȂ
+ */
+class SystemScheduler final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	VXeo^
+     * @param	world	VXes郏[hiNGj
+     * @param	desc	VXe
+     * @return	VXe̔ԍ
+     */
+    uint32_t add(EntityWorld& world, const SystemDesc& desc);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	SẴVXesAL^ꂽ\̕ύX𔽉f
+     * @param	world		[hiadd Ɠ́j
+     * @param	jobSystem	ɏꍇ̃WuVXeinullptr ȂĂяoXbhŏj
+     */
+    void run(EntityWorld& world, JobSystem* jobSystem = nullptr);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	VXe̒uꂽi擾
+     * @param	system	VXe̔ԍ
+     * @return	ii0 j
+     */
+    [[nodiscard]] uint32_t stage(uint32_t system) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	i̐擾
+     * @return	i̐
+     */
+    [[nodiscard]] uint32_t stageCount() const noexcept;
+
+private:
+    /// o^VXe
+    struct System {
+        SystemDesc                       desc{};            ///< VXe
+        QueryId                          query{};           ///< Ώۂ̃NG
+        uint32_t                         stage{};           ///< i
+        std::vector<EntityCommandBuffer> commandBuffers{};  ///< `NƂ̍\̕ύX̋L^
+    };
+
+    /// sdiVXeƃ`N̑gj
+    struct Task {
+        uint32_t  system;  ///< VXe̔ԍ
+        uint32_t  chunk;   ///< VXe̒̃`N̔ԍ
+        ChunkView view;    ///< `N
+    };
+
+    std::vector<System>    systems_{};     /// o^̃VXe
+    std::vector<Task>      tasks_{};       /// i̎dit[g񂷁j
+    std::vector<ChunkView> chunks_{};      /// `NW߂Əꏊ
+    uint32_t               stageCount_{};  /// i̐
+};
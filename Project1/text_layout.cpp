@@ -0,0 +1,215 @@
+// ̃CAEg
+
+#include "text_layout.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace {
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	UTF-8  1 ǂ
+ * @param	p	ǂވʒuii߂j
+ * @param	end	̏I
+ * @return	R[h|Cgiꂽт U+FFFDj
+ */
+uint32_t decodeUtf8(const char*& p, const char* end) noexcept {
+    const auto lead = static_cast<uint8_t>(*p++);
+    if (lead < 0x80) {
+        return lead;
+    }
+    const uint32_t length = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+    if (length == 0 || end - p < std::ptrdiff_t(length)) {
+        return 0xFFFD;
+    }
+    uint32_t codepoint = lead & (0x3F >> length);
+    for (uint32_t i = 0; i < length; ++i) {
+        const auto next = static_cast<uint8_t>(*p);
+        if ((next & 0xC0) != 0x80) {
+            return 0xFFFD;
+        }
+        codepoint = (codepoint << 6) | (next & 0x3F);
+        ++p;
+    }
+    return codepoint;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	L[̃nbV߂iFNV-1aj
+ * @param	font	tHg
+ * @param	text	
+ * @param	size	̑傫
+ * @return	nbV
+ */
+uint64_t hashKey(const SdfFont* font, std::string_view text, float size) noexcept {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    const auto mix = [&hash](const void* data, size_t length) {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < length; ++i) {
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+        }
+    };
+    mix(&font, sizeof(font));
+    mix(&size, sizeof(size));
+    mix(text.data(), text.size());
+    return hash;
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CAEgiLbVȂj
+ * @param	font		tHg
+ * @param	text		UTF-8 ̕
+ * @param	size		̑傫isNZj
+ * @param	out			ݐ
+ * @param	maxGlyphs	߂ő吔
+ * @param	width		Ԓs̊̕i[
+ * @param	height		̊i[
+ * @return	񂾐
+ */
+uint32_t layoutText(const SdfFont& font, std::string_view text, float size, TextGlyph* out, uint32_t maxGlyphs, float& width, float& height) noexcept {
+    const float scale = size / font.baseSize;
+    const float lineAdvance = font.lineHeight * scale;
+    const float inverseWidth = 1.0f / float(font.atlasWidth);
+    const float inverseHeight = 1.0f / float(font.atlasHeight);
+    const SdfGlyph* fallback = findSdfGlyph(font, '?');
+
+    float    penX = 0.0f;
+    float    baseline = font.ascent * scale;
+    uint32_t lineCount = 1;
+    uint32_t count = 0;
+    width = 0.0f;
+
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end) {
+        const uint32_t codepoint = decodeUtf8(p, end);
+        if (codepoint == '\n') {
+            penX = 0.0f;
+            baseline += lineAdvance;
+            ++lineCount;
+            continue;
+        }
+        const SdfGlyph* glyph = findSdfGlyph(font, codepoint);
+        glyph = glyph ? glyph : fallback;
+        if (!glyph) {
+            continue;
+        }
+        if (glyph->width && count < maxGlyphs) {
+            auto& quad = out[count++];
+            quad.rect[0] = penX + glyph->offsetX * scale;
+            quad.rect[1] = baseline + glyph->offsetY * scale;
+            quad.rect[2] = quad.rect[0] + glyph->width * scale;
+            quad.rect[3] = quad.rect[1] + glyph->height * scale;
+            quad.uv[0] = glyph->x * inverseWidth;
+            quad.uv[1] = glyph->y * inverseHeight;
+            quad.uv[2] = (glyph->x + glyph->width) * inverseWidth;
+            quad.uv[3] = (glyph->y + glyph->height) * inverseHeight;
+        }
+        penX += glyph->advance * scale;
+        width = std::max(width, penX);
+    }
+    height = lineAdvance * lineCount;
+    return count;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	maxEntries		oĂ镶̐
+ * @param	maxGlyphs		oĂ镶̑
+ * @param	maxTextBytes	oĂ镶̑oCg
+ * @return	 true
+ */
+[[nodiscard]] bool TextLayoutCache::create(uint32_t maxEntries, uint32_t maxGlyphs, uint32_t maxTextBytes) {
+    if (maxEntries == 0 || maxGlyphs == 0 || maxTextBytes == 0) {
+        assert(false && "CAEgLbV̗eʂ 0 ł");
+        return false;
+    }
+    // nbV\͔ȉ܂Ȃ 2 ׂ̂ɂ
+    uint32_t slotCount = 1;
+    while (slotCount < maxEntries * 2) {
+        slotCount <<= 1;
+    }
+    entries_.assign(maxEntries, Entry{});
+    slots_.assign(slotCount, 0);
+    glyphs_.assign(maxGlyphs, TextGlyph{});
+    text_.assign(maxTextBytes, 0);
+    clear();
+    statistics_ = {};
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CAEg擾i΃CAEgĊoj
+ * @param	font	tHg
+ * @param	text	UTF-8 ̕
+ * @param	size	̑傫isNZj
+ * @return	CAEg
+ */
+TextLayout TextLayoutCache::get(const SdfFont& font, std::string_view text, float size) noexcept {
+    assert(!slots_.empty() && "CAEgLbV쐬ł");
+    const uint64_t hash = hashKey(&font, text, size);
+    const uint32_t mask = static_cast<uint32_t>(slots_.size() - 1);
+
+    uint32_t slot = static_cast<uint32_t>(hash) & mask;
+    for (; slots_[slot]; slot = (slot + 1) & mask) {
+        const Entry& entry = entries_[slots_[slot] - 1];
+        if (entry.hash == hash && entry.font == &font && entry.size == size && entry.textLength == text.size() &&
+            std::memcmp(text_.data() + entry.textOffset, text.data(), text.size()) == 0) {
+            ++statistics_.hits;
+            return { glyphs_.data() + entry.firstGlyph, entry.glyphCount, entry.width, entry.height };
+        }
+    }
+    ++statistics_.misses;
+
+    // 1 oCg 1 ȏɂ͂ȂȂ̂ŁAoCg̋󂫂Α
+    const auto length = static_cast<uint32_t>(text.size());
+    if (entryCount_ == entries_.size() || glyphs_.size() - glyphCount_ < length || text_.size() - textSize_ < length) {
+        clear();
+        ++statistics_.resets;
+        slot = static_cast<uint32_t>(hash) & mask;
+    }
+
+    // ɂĂȂ͊oɃCAEgi鏊܂ł̕Ԃj
+    const auto maxGlyphs = static_cast<uint32_t>(glyphs_.size()) - glyphCount_;
+    TextGlyph* const glyphs = glyphs_.data() + glyphCount_;
+    TextLayout       layout{ glyphs, 0, 0.0f, 0.0f };
+    layout.glyphCount = layoutText(font, text, size, glyphs, maxGlyphs, layout.width, layout.height);
+    if (length > glyphs_.size() || length > text_.size()) {
+        return layout;
+    }
+
+    Entry& entry = entries_[entryCount_];
+    entry = { hash, &font, size, textSize_, length, glyphCount_, layout.glyphCount, layout.width, layout.height };
+    std::memcpy(text_.data() + textSize_, text.data(), text.size());
+    textSize_ += length;
+    glyphCount_ += layout.glyphCount;
+    slots_[slot] = ++entryCount_;
+    return layout;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SĎ̂Ăimۍς݂̗eʂ͎cj
+ */
+void TextLayoutCache::clear() noexcept {
+    std::fill(slots_.begin(), slots_.end(), 0u);
+    entryCount_ = 0;
+    glyphCount_ = 0;
+    textSize_ = 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	v擾
+ * @return	v
+ */
+[[nodiscard]] const TextLayoutCache::Statistics& TextLayoutCache::statistics() const noexcept {
+    return statistics_;
+}
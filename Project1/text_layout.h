@@ -0,0 +1,110 @@
+// ̃CAEg
+
+#pragma once
+
+#include "sdf_font.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/// CAEg 1 ̎lp`i̍ォ̃sNZj
+struct TextGlyph {
+    float rect[4];  ///<  XY ƉE XY
+    float uv[4];    ///< eNX`W (u0, v0, u1, v1)
+};
+
+/// CAEg
+struct TextLayout {
+    const TextGlyph* glyphs;      ///< `i󔒂Ȃǂ̕`͊܂܂Ȃj
+    uint32_t         glyphCount;  ///< 
+    float            width;       ///< Ԓs̕
+    float            height;      ///< s x s̑
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CAEgiLbVȂj
+ * @param	font		tHg
+ * @param	text		UTF-8 ̕i'\n' ŉsj
+ * @param	size		̑傫isNZj
+ * @param	out			ݐ
+ * @param	maxGlyphs	߂ő吔i͕`ȂAƍɂ͊܂߂j
+ * @param	width		Ԓs̊̕i[
+ * @param	height		̊i[
+ * @return	񂾐
+ * @details	tHgɖ '?' ŁA'?' Δ΂
+ */
+uint32_t layoutText(const SdfFont& font, std::string_view text, float size, TextGlyph* out, uint32_t maxGlyphs, float& width, float& height) noexcept;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̃CAEg̃LbV
+ * @details	EtHgE傫̑gL[ɁACAEgς݂̕oĂ
+ *			ځEE̒u create őSĊmۂAǂꂩӂꂽSĎ̂Ăċlߒ
+ *			ixɑŜĂ̂ŁAt[`Ԃł̓q[vmۂ̂ĒNȂj
+ */
+class TextLayoutCache final {
+public:
+    /// v
+    struct Statistics {
+        uint64_t hits;    ///< LbVɂ
+        uint64_t misses;  ///< CAEg
+        uint64_t resets;  ///< ӂđSĎ̂Ă
+    };
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	maxEntries		oĂ镶̐
+     * @param	maxGlyphs		oĂ镶̑
+     * @param	maxTextBytes	oĂ镶̑oCg
+     * @return	 true
+     */
+    [[nodiscard]] bool create(uint32_t maxEntries, uint32_t maxGlyphs, uint32_t maxTextBytes);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	CAEg擾i΃CAEgĊoj
+     * @param	font	tHgiL[̓AhXȂ̂ŁAoĂԂ͓ȂƁj
+     * @param	text	UTF-8 ̕
+     * @param	size	̑傫isNZj
+     * @return	CAEgi̔z͎ get  clear ĂԂ܂ŗLj
+     */
+    TextLayout get(const SdfFont& font, std::string_view text, float size) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	SĎ̂Ăimۍς݂̗eʂ͎cj
+     */
+    void clear() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	v擾
+     * @return	v
+     */
+    [[nodiscard]] const Statistics& statistics() const noexcept;
+
+private:
+    /// oĂ镶 1 
+    struct Entry {
+        uint64_t       hash;        ///< L[̃nbV
+        const SdfFont* font;        ///< tHg
+        float          size;        ///< ̑傫
+        uint32_t       textOffset;  ///< text_ ̈̕ʒu
+        uint32_t       textLength;  ///< ̃oCg
+        uint32_t       firstGlyph;  ///< glyphs_ ̐擪
+        uint32_t       glyphCount;  ///< 
+        float          width;       ///< 
+        float          height;      ///< 
+    };
+
+    std::vector<Entry>     entries_{};     /// oĂ镶
+    std::vector<uint32_t>  slots_{};       /// nbV\ientries_ ̔ԍ + 1A0 ͋󂫁B`Tj
+    std::vector<TextGlyph> glyphs_{};      /// CAEgς݂̕
+    std::vector<char>      text_{};        /// L[̕
+    uint32_t               entryCount_{};  /// gĂ鍀ڐ
+    uint32_t               glyphCount_{};  /// gĂ镶
+    uint32_t               textSize_{};    /// gĂ镶̃oCg
+    Statistics             statistics_{};  /// v
+};
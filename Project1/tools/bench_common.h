@@ -0,0 +1,59 @@
+// c[ŋʂ̎ԌvƊmFʂ̕\
+//
+// tools/ ̃x`}[NƊmFp̃vO͂ǂ 1 t@CŊA
+// vƊmF̍g݂̃wb_ŋLiwb_Ȃ̂Ńrhɒǉ͖̂j
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/// vɎgv
+using Clock = std::chrono::steady_clock;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	oߎԂ~bŋ߂
+ * @param	begin	Jn
+ * @param	end		I
+ * @return	~b
+ */
+inline double milliseconds(Clock::time_point begin, Clock::time_point end) noexcept {
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	l߂
+ * @param	values	liבւj
+ * @return	l
+ */
+inline double median(std::vector<double> values) {
+    std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+    return values[values.size() / 2];
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	mFʂ 1 s\
+ * @param	condition	mF
+ * @param	what		mFe
+ * @return	condition
+ */
+inline bool check(bool condition, const char* what) {
+    std::printf("%s: %s\n", what, condition ? "ok" : "MISMATCH");
+    return condition;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SĂ̊mF̌ʂ\
+ * @param	passed	SĂ̊mFʂ true
+ * @return	vZX̏IR[h
+ */
+inline int finish(bool passed) {
+    std::printf("\n%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
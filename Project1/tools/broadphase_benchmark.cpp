@@ -0,0 +1,334 @@
+// Փ˂̃u[htF[YiXC[vAhv[j̊mFƃx`}[N
+//
+// mF: 镨̂̑g𑍓Ɣׂirŕ̂̍폜EǉEuԈړj
+// ߃ZbgiXJ[ / SSE / AVX2jƕ̗Lőg̕т܂ňv邱ƁAȖ傫IԂƁA
+// тɕĂт܂̂̑gdȂ邱Ƃm߂
+// x`}[N: X ɒ Z ɒZԂ𓮂 1 `10 ̂̕ŁA1 t[̑g߂鎞Ԃׂ
+// ׂ鑊 BVHirefit ĕ̂ƂɏdȂ₢킹j
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -pthread -I.. broadphase_benchmark.cpp ../broadphase.cpp ../bvh.cpp ../frustum_culling.cpp ../indirect_cull.cpp ../job_system.cpp -o broadphase_benchmark
+//   iAVX2 łɂ -mavx2 tj
+// s:
+//   tools/broadphase_benchmark [ő̐̕]
+
+#include "bench_common.h"
+#include "broadphase.h"
+#include "bvh.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// t[
+constexpr int Frames = 30;
+/// t[̌oߎ
+constexpr float DeltaTime = 1.0f / 60.0f;
+
+/// 
+std::mt19937 generator(12345);
+
+/// 镨
+struct Body {
+    float position[3];  ///< S
+    float velocity[3];  ///< x
+    float extent[3];    ///< ̑傫
+};
+
+/// ̂
+struct World {
+    float             size[3];  ///< 傫i_琳̌j
+    std::vector<Body> bodies;   ///< 
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̂΂܂i1 ̑̐ς𑵂AX : Y : Z = ratio ̋Ԃɂj
+     */
+    World(uint32_t count, const float ratio[3]) {
+        const float scale = std::cbrt(8.0f * count / (ratio[0] * ratio[1] * ratio[2]));
+        for (int a = 0; a < 3; ++a) {
+            size[a] = ratio[a] * scale;
+        }
+        bodies.resize(count);
+        for (Body& body : bodies) {
+            scatter(body);
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̂ 1 Ԃ̂ǂ֒u
+     */
+    void scatter(Body& body) {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        for (int a = 0; a < 3; ++a) {
+            body.extent[a] = 0.2f + 0.4f * unit(generator);
+            body.position[a] = body.extent[a] + (size[a] - 2.0f * body.extent[a]) * unit(generator);
+            body.velocity[a] = (unit(generator) * 2.0f - 1.0f) * 2.0f;
+        }
+    }
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	1 t[iǂŒ˕Ԃj
+     */
+    void step() {
+        for (Body& body : bodies) {
+            for (int a = 0; a < 3; ++a) {
+                body.position[a] += body.velocity[a] * DeltaTime;
+                if (body.position[a] < body.extent[a] || body.position[a] > size[a] - body.extent[a]) {
+                    body.velocity[a] = -body.velocity[a];
+                    body.position[a] = std::clamp(body.position[a], body.extent[a], size[a] - body.extent[a]);
+                }
+            }
+        }
+    }
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̂̋E{bNX߂
+ */
+Aabb boundsOf(const Body& body) noexcept {
+    Aabb bounds;
+    for (int a = 0; a < 3; ++a) {
+        bounds.min[a] = body.position[a] - body.extent[a];
+        bounds.max[a] = body.position[a] + body.extent[a];
+    }
+    return bounds;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	E{bNXdȂ邩iԁj
+ */
+bool overlaps(const Aabb& a, const Aabb& b) noexcept {
+    return a.min[0] <= b.max[0] && a.max[0] >= b.min[0] && a.min[1] <= b.max[1] && a.max[1] >= b.min[1] && a.min[2] <= b.max[2] && a.max[2] >= b.min[2];
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	gԍɕׂ
+ */
+std::vector<BroadphasePair> sorted(std::vector<BroadphasePair> pairs) {
+    std::sort(pairs.begin(), pairs.end(), [](const BroadphasePair& x, const BroadphasePair& y) { return x.a < y.a || (x.a == y.a && x.b < y.b); });
+    return pairs;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	2 ̑g̕т
+ */
+bool samePairs(const std::vector<BroadphasePair>& x, const std::vector<BroadphasePair>& y) {
+    return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin(), [](const BroadphasePair& p, const BroadphasePair& q) { return p.a == q.a && p.b == q.b; });
+}
+
+/// ߃Zbg̖O
+const char* simdName(CullSimd simd) {
+    switch (simd) {
+    case CullSimd::Avx2:
+        return "avx2";
+    case CullSimd::Sse:
+        return "sse";
+    default:
+        return "scalar";
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t maxBodies = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100000;
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+    std::vector<CullSimd> simds = { CullSimd::Scalar };
+    if (bestCullSimd() >= CullSimd::Sse) {
+        simds.push_back(CullSimd::Sse);
+    }
+    if (bestCullSimd() >= CullSimd::Avx2) {
+        simds.push_back(CullSimd::Avx2);
+    }
+    std::printf("workers %u, best simd %s\n", jobSystem.workerCount(), simdName(bestCullSimd()));
+    bool passed = true;
+
+    // ƔׂBĂ镨̂ԍŊoA폜EǉEuԈړ
+    {
+        const float                 ratio[3] = { 4.0f, 1.0f, 2.0f };
+        World                       world(4000, ratio);
+        SweepAndPrune               sap;
+        std::vector<uint32_t>       handles(world.bodies.size());
+        std::vector<bool>           alive(world.bodies.size(), true);
+        std::vector<BroadphasePair> pairs, other, expected;
+        for (size_t i = 0; i < world.bodies.size(); ++i) {
+            handles[i] = sap.add(boundsOf(world.bodies[i]));
+        }
+        bool     ok = true;
+        uint32_t resorts = 0;
+        size_t   pairCount = 0;
+        for (int frame = 0; frame < 40 && ok; ++frame) {
+            world.step();
+            if (frame == 10) {
+                // 3  1 폜
+                for (size_t i = 0; i < world.bodies.size(); i += 3) {
+                    sap.remove(handles[i]);
+                    alive[i] = false;
+                }
+            }
+            if (frame == 20) {
+                // 폜̂ʂ̏ꏊɖ߂iԍg񂷁j
+                for (size_t i = 0; i < world.bodies.size(); i += 3) {
+                    world.scatter(world.bodies[i]);
+                    handles[i] = sap.add(boundsOf(world.bodies[i]));
+                    alive[i] = true;
+                }
+            }
+            if (frame == 30) {
+                // 1 uԈړi}\[g̗\Z𒴂ĕגj
+                for (size_t i = 0; i < world.bodies.size(); i += 10) {
+                    world.scatter(world.bodies[i]);
+                }
+            }
+            for (size_t i = 0; i < world.bodies.size(); ++i) {
+                if (alive[i]) {
+                    sap.setBounds(handles[i], boundsOf(world.bodies[i]));
+                }
+            }
+
+            expected.clear();
+            for (size_t i = 0; i < world.bodies.size(); ++i) {
+                for (size_t j = i + 1; alive[i] && j < world.bodies.size(); ++j) {
+                    if (alive[j] && overlaps(boundsOf(world.bodies[i]), boundsOf(world.bodies[j]))) {
+                        const uint32_t a = handles[i], b = handles[j];
+                        expected.push_back(a < b ? BroadphasePair{ a, b } : BroadphasePair{ b, a });
+                    }
+                }
+            }
+            sap.findPairs(pairs, nullptr, CullSimd::Scalar);
+            resorts += sap.resorted();
+            ok = samePairs(sorted(pairs), sorted(expected)) && sap.size() == std::count(alive.begin(), alive.end(), true);
+            for (const CullSimd simd : simds) {
+                for (JobSystem* jobs : { static_cast<JobSystem*>(nullptr), &jobSystem }) {
+                    sap.findPairs(other, jobs, simd);
+                    ok = ok && samePairs(pairs, other);
+                }
+            }
+            pairCount += pairs.size();
+        }
+        std::printf("brute force, simd and parallel: %s (%zu pairs over 40 frames, %u full sorts, axis %u, %u slabs)\n", ok ? "ok" : "MISMATCH", pairCount,
+                    resorts, sap.axis(), sap.slabCount());
+        // т܂̂̑gdɐĂ邱Ƃm߂邽߁AтɕĂ邱
+        ok = ok && sap.axis() == 0 && resorts >= 2 && sap.slabCount() > 1;
+        passed = passed && ok;
+    }
+
+    // U̍ł傫I
+    {
+        bool ok = true;
+        for (uint32_t axis = 0; axis < 3; ++axis) {
+            float ratio[3] = { 1.0f, 1.0f, 1.0f };
+            ratio[axis] = 8.0f;
+            World                       world(2000, ratio);
+            SweepAndPrune               sap;
+            std::vector<BroadphasePair> pairs;
+            for (const Body& body : world.bodies) {
+                sap.add(boundsOf(body));
+            }
+            sap.findPairs(pairs);
+            ok = ok && sap.axis() == axis;
+        }
+        passed = check(ok, "dominant axis") && passed;
+    }
+
+    // x`}[N
+    std::printf("\nfind pairs per frame (ms)\n");
+    std::printf("  %7s %8s %6s", "bodies", "pairs", "slabs");
+    for (const CullSimd simd : simds) {
+        std::printf(" %8s %8s", simdName(simd), "parallel");
+    }
+    std::printf(" %8s %8s\n", "resort", "bvh");
+    for (uint32_t count : { 10000u, 30000u, 100000u }) {
+        if (count > maxBodies) {
+            break;
+        }
+        const float                 ratio[3] = { 4.0f, 1.0f, 2.0f };
+        World                       world(count, ratio);
+        SweepAndPrune               sap;
+        std::vector<BroadphasePair> pairs;
+        std::vector<Aabb>           bounds(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            bounds[i] = boundsOf(world.bodies[i]);
+            sap.add(bounds[i]);
+        }
+        sap.findPairs(pairs);
+        Bvh bvh;
+        bvh.build(bounds.data(), count);
+
+        // ߃Zbgƕ̗LƂɓ𑪂î͑Oj
+        std::vector<std::vector<double>> times(simds.size() * 2);
+        std::vector<double>              resortTimes, bvhTimes;
+        std::vector<uint32_t>            found;
+        size_t                           pairCount = 0;
+        for (int frame = 0; frame < Frames; ++frame) {
+            world.step();
+            for (uint32_t i = 0; i < count; ++i) {
+                bounds[i] = boundsOf(world.bodies[i]);
+                sap.setBounds(i, bounds[i]);
+            }
+            for (size_t s = 0; s < simds.size(); ++s) {
+                for (int parallel = 0; parallel < 2; ++parallel) {
+                    const auto begin = Clock::now();
+                    sap.findPairs(pairs, parallel ? &jobSystem : nullptr, simds[s]);
+                    times[s * 2 + parallel].push_back(milliseconds(begin, Clock::now()));
+                }
+            }
+            pairCount = pairs.size();
+
+            // t[Sĕגꍇiςj
+            {
+                SweepAndPrune fresh;
+                for (uint32_t i = 0; i < count; ++i) {
+                    fresh.add(bounds[i]);
+                }
+                std::vector<BroadphasePair> freshPairs;
+                const auto                  begin = Clock::now();
+                fresh.findPairs(freshPairs);
+                resortTimes.push_back(milliseconds(begin, Clock::now()));
+                passed = passed && freshPairs.size() == pairs.size();
+            }
+
+            // BVH: refit ĕ̂Ƃɖ₢킹Aԍ̑傫肾𐔂
+            if (frame < 5) {
+                const auto begin = Clock::now();
+                for (uint32_t i = 0; i < count; ++i) {
+                    bvh.setBounds(i, bounds[i]);
+                }
+                bvh.refit();
+                size_t bvhPairs = 0;
+                for (uint32_t i = 0; i < count; ++i) {
+                    found.clear();
+                    bvh.queryOverlap(bounds[i], found);
+                    for (const uint32_t j : found) {
+                        bvhPairs += j > i;
+                    }
+                }
+                bvhTimes.push_back(milliseconds(begin, Clock::now()));
+                passed = passed && bvhPairs == pairs.size();
+            }
+        }
+        std::printf("  %7u %8zu %6u", count, pairCount, sap.slabCount());
+        for (const auto& t : times) {
+            std::printf(" %8.2f", median(t));
+        }
+        std::printf(" %8.2f %8.2f\n", median(resortTimes), median(bvhTimes));
+    }
+
+    return finish(passed);
+}
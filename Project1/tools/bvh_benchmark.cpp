@@ -0,0 +1,231 @@
+// I BVH ̃x`}[N
+//
+// Œu AABB  Bvh \zA\zErefitE / dȂ / C̊eNG̎Ԃ𑪂
+// NGʂ͑Si cullBoxesjƈv邱ƁAraycast4  raycast ƈv邱Ƃm߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -pthread -I.. bvh_benchmark.cpp ../bvh.cpp ../frustum_culling.cpp ../indirect_cull.cpp ../job_system.cpp -o bvh_benchmark
+// s:
+//   tools/bvh_benchmark [IuWFNg] [NG]
+
+#include "bench_common.h"
+#include "bvh.h"
+#include "frustum_culling.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SŃCƍŏɌ AABB ߂iBvh::raycast Ɠ莮j
+ */
+RayHit bruteForceRaycast(const std::vector<Aabb>& bounds, const float origin[3], const float direction[3], float maxDistance) {
+    const float inverse[3] = { 1.0f / direction[0], 1.0f / direction[1], 1.0f / direction[2] };
+    RayHit      hit{ Bvh::InvalidObject, maxDistance };
+    for (uint32_t i = 0; i < bounds.size(); ++i) {
+        float nearest = 0.0f;
+        float farthest = hit.distance;
+        for (int axis = 0; axis < 3; ++axis) {
+            const float t0 = (bounds[i].min[axis] - origin[axis]) * inverse[axis];
+            const float t1 = (bounds[i].max[axis] - origin[axis]) * inverse[axis];
+            nearest = std::max(nearest, std::min(t0, t1));
+            farthest = std::min(farthest, std::max(t0, t1));
+        }
+        if (nearest <= farthest && (nearest < hit.distance || (nearest == hit.distance && i < hit.object))) {
+            hit = { i, nearest };
+        }
+    }
+    return hit;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ԍבւĔׂ
+ */
+bool sameSet(std::vector<uint32_t> a, std::vector<uint32_t> b) {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    return a == b;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t objectCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1000000;
+    const uint32_t queryCount  = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 1000;
+
+    std::mt19937                          random(42);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.1f, 1.0f);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<Aabb> bounds(objectCount);
+    const auto        makeBox = [&](Aabb& box) {
+        const float center[3] = { position(random), position(random), position(random) };
+        const float extent = size(random);
+        for (int axis = 0; axis < 3; ++axis) {
+            box.min[axis] = center[axis] - extent;
+            box.max[axis] = center[axis] + extent;
+        }
+    };
+    for (auto& box : bounds) {
+        makeBox(box);
+    }
+
+    // ₢킹Ƃ̌ʂ͑SƔׁAނƂɂ܂Ƃ߂ĕ\
+    bool frustumSame = true;
+    bool overlapSame = true;
+    bool packetSame = true;
+    bool raySame = true;
+
+    // \z
+    Bvh        bvh;
+    const auto b0 = Clock::now();
+    bvh.build(bounds.data(), objectCount);
+    const auto b1 = Clock::now();
+    const float builtCost = bvh.sahCost();
+    std::printf("build   objects %u: %.1f ms, nodes %u, SAH %.1f\n", objectCount, milliseconds(b0, b1), bvh.nodeCount(), builtCost);
+
+    // 1  refit
+    const uint32_t      movedCount = objectCount / 10;
+    std::vector<double> refitTimes;
+    for (int frame = 0; frame < 10; ++frame) {
+        for (uint32_t i = 0; i < movedCount; ++i) {
+            const uint32_t object = static_cast<uint32_t>(random() % objectCount);
+            Aabb           box = bounds[object];
+            for (int axis = 0; axis < 3; ++axis) {
+                const float offset = unit(random) * 0.5f;
+                box.min[axis] += offset;
+                box.max[axis] += offset;
+            }
+            bounds[object] = box;
+            bvh.setBounds(object, box);
+        }
+        const auto r0 = Clock::now();
+        bvh.refit();
+        refitTimes.push_back(milliseconds(r0, Clock::now()));
+    }
+    std::printf("refit   moved %u: %.2f ms, SAH %.1f -> %.1f\n", movedCount, median(refitTimes), builtCost, bvh.sahCost());
+
+    // icullBoxes ̑SƔׂj
+    BoundingBoxes boxes;
+    for (const auto& box : bounds) {
+        boxes.add(box.min, box.max);
+    }
+    std::vector<uint32_t> visible(objectCount);
+    std::vector<uint32_t> found;
+    double                bvhTime = 0.0;
+    double                scanTime = 0.0;
+    size_t                foundTotal = 0;
+    const uint32_t        frustumCount = std::max(1u, queryCount / 10);
+    for (uint32_t q = 0; q < frustumCount; ++q) {
+        // _痐̕ic }0.2je
+        const float eye[3] = { position(random), position(random), position(random) };
+        const float viewProjection[4][4] = {
+            { 5.0f, 0, 0, -5.0f * eye[0] },
+            { 0, 5.0f, 0, -5.0f * eye[1] },
+            { 0, 0, 1.001f, -1.001f * eye[2] - 0.1f },
+            { 0, 0, 1, -eye[2] },
+        };
+        const CullFrustum frustum = makeCullFrustum(viewProjection);
+
+        found.clear();
+        const auto t0 = Clock::now();
+        bvh.queryFrustum(frustum, found);
+        const auto t1 = Clock::now();
+        const uint32_t count = cullBoxes(frustum, boxes, visible.data(), nullptr, CullSimd::Scalar);
+        const auto t2 = Clock::now();
+        bvhTime += milliseconds(t0, t1);
+        scanTime += milliseconds(t1, t2);
+        foundTotal += found.size();
+        frustumSame = frustumSame && sameSet(found, std::vector<uint32_t>(visible.begin(), visible.begin() + count));
+    }
+    std::printf("frustum queries %u: bvh %.3f ms, scan %.3f ms per query, %.0f visible\n", frustumCount, bvhTime / frustumCount,
+                scanTime / frustumCount, double(foundTotal) / frustumCount);
+
+    // dȂ
+    bvhTime = 0.0;
+    scanTime = 0.0;
+    foundTotal = 0;
+    for (uint32_t q = 0; q < queryCount; ++q) {
+        Aabb query;
+        makeBox(query);
+        for (int axis = 0; axis < 3; ++axis) {
+            query.min[axis] -= 4.0f;
+            query.max[axis] += 4.0f;
+        }
+
+        found.clear();
+        const auto t0 = Clock::now();
+        bvh.queryOverlap(query, found);
+        const auto t1 = Clock::now();
+        std::vector<uint32_t> reference;
+        for (uint32_t i = 0; i < objectCount; ++i) {
+            const Aabb& box = bounds[i];
+            if (box.min[0] <= query.max[0] && box.max[0] >= query.min[0] && box.min[1] <= query.max[1] && box.max[1] >= query.min[1] &&
+                box.min[2] <= query.max[2] && box.max[2] >= query.min[2]) {
+                reference.push_back(i);
+            }
+        }
+        const auto t2 = Clock::now();
+        bvhTime += milliseconds(t0, t1);
+        scanTime += milliseconds(t1, t2);
+        foundTotal += found.size();
+        overlapSame = overlapSame && sameSet(found, reference);
+    }
+    std::printf("overlap queries %u: bvh %.4f ms, scan %.3f ms per query, %.1f hits\n", queryCount, bvhTime / queryCount,
+                scanTime / queryCount, double(foundTotal) / queryCount);
+
+    // Ci4 {Braycast / raycast4 / Sׂj
+    double   singleTime = 0.0;
+    double   packetTime = 0.0;
+    uint32_t hitCount = 0;
+    for (uint32_t q = 0; q < queryCount; q += 4) {
+        float origins[4][3];
+        float directions[4][3];
+        for (int ray = 0; ray < 4; ++ray) {
+            // ӂ肩玗ɔ΂ipPbg܂Ƃ܂ĒH󋵁j
+            for (int axis = 0; axis < 3; ++axis) {
+                origins[ray][axis] = (ray == 0 ? position(random) : origins[0][axis] + unit(random));
+                directions[ray][axis] = (ray == 0 ? unit(random) : directions[0][axis] + unit(random) * 0.05f);
+            }
+        }
+
+        RayHit     single[4];
+        RayHit     packet[4];
+        const auto t0 = Clock::now();
+        for (int ray = 0; ray < 4; ++ray) {
+            hitCount += bvh.raycast(origins[ray], directions[ray], 1000.0f, single[ray]) ? 1 : 0;
+        }
+        const auto t1 = Clock::now();
+        bvh.raycast4(origins, directions, 1000.0f, packet);
+        const auto t2 = Clock::now();
+        singleTime += milliseconds(t0, t1);
+        packetTime += milliseconds(t1, t2);
+
+        for (int ray = 0; ray < 4; ++ray) {
+            packetSame = packetSame && single[ray].object == packet[ray].object && single[ray].distance == packet[ray].distance;
+        }
+        if (q < 64) {
+            for (int ray = 0; ray < 4; ++ray) {
+                const RayHit reference = bruteForceRaycast(bounds, origins[ray], directions[ray], 1000.0f);
+                raySame = raySame && single[ray].object == reference.object && single[ray].distance == reference.distance;
+            }
+        }
+    }
+    const uint32_t rayCount = (queryCount + 3) / 4 * 4;
+    std::printf("rays %u: raycast %.2f us, raycast4 %.2f us per ray, %u hits\n", rayCount, singleTime * 1000.0 / rayCount,
+                packetTime * 1000.0 / rayCount, hitCount);
+
+    bool passed = true;
+    passed = check(frustumSame, "queryFrustum matches cullBoxes") && passed;
+    passed = check(overlapSame, "queryOverlap matches brute force") && passed;
+    passed = check(packetSame, "raycast4 matches raycast") && passed;
+    passed = check(raySame, "raycast matches brute force") && passed;
+    return finish(passed);
+}
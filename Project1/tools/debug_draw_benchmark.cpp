@@ -0,0 +1,187 @@
+// fobO`iCPU j̃x`}[N
+//
+// EEE 1 ςނ̂ɂ鎞ԂA1 XbhƃWuVXȇSXbhőB
+// ɂɐςތĂяocꍇ̎ԂƁASXbh̕ 1 {ɋl߂ gather ̎ԂB
+// Ǝ̊pA̔aAɐς񂾒_Aӂꂽ}`̐m߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -pthread -I.. debug_draw_benchmark.cpp ../debug_draw.cpp ../indirect_cull.cpp ../job_system.cpp -o debug_draw_benchmark
+// s:
+//   tools/debug_draw_benchmark [ςސ}`]
+
+#include "bench_common.h"
+#include "debug_draw.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+/// 
+constexpr int Repeats = 7;
+
+/// }`̎
+enum class Shape {
+    Line,
+    Box,
+    Sphere,
+    Frustum,
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	}` begin ` end Ԃ܂Őς
+ */
+void push(DebugDraw& debugDraw, Shape shape, const CullFrustum& frustum, uint32_t begin, uint32_t end) {
+    for (uint32_t i = begin; i < end; ++i) {
+        const float a[3] = { float(i & 255), float((i >> 8) & 255), float(i >> 16) };
+        const float b[3] = { a[0] + 1.0f, a[1] + 1.0f, a[2] + 1.0f };
+        switch (shape) {
+        case Shape::Line:
+            debugDraw.line(a, b, 0xFF00FF00);
+            break;
+        case Shape::Box:
+            debugDraw.box(a, b, 0xFF00FFFF);
+            break;
+        case Shape::Sphere:
+            debugDraw.sphere(a, 0.5f, 0xFFFF0000);
+            break;
+        case Shape::Frustum:
+            debugDraw.frustum(frustum, 0xFFFFFFFF);
+            break;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_WɊ܂܂邩
+ */
+bool hasPoint(const std::vector<DebugVertex>& vertices, uint32_t count, float x, float y, float z) {
+    for (uint32_t i = 0; i < count; ++i) {
+        const float* p = vertices[i].position;
+        if (std::fabs(p[0] - x) < 1.0e-4f && std::fabs(p[1] - y) < 1.0e-4f && std::fabs(p[2] - z) < 1.0e-4f) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t primitiveCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 20000;
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+    const uint32_t threadCount = jobSystem.workerCount() + 1;
+    std::printf("workers %u, %u primitives\n", jobSystem.workerCount(), primitiveCount);
+
+    const float       identity[4][4] = { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } };
+    const CullFrustum frustum = makeCullFrustum(identity);
+    bool              passed = true;
+
+    // `̊mFi͊p 8 APʍs̎̓NbvԂ̔A͒S甼a̋j
+    {
+        DebugDraw debugDraw;
+        if (!debugDraw.create(64, 1024)) {
+            return 1;
+        }
+        const float min[3] = { -1.0f, -2.0f, -3.0f };
+        const float max[3] = { 1.0f, 2.0f, 3.0f };
+        std::vector<DebugVertex> vertices(1024);
+        debugDraw.box(min, max, 0);
+        uint32_t count = debugDraw.gather(vertices.data(), 1024);
+        bool     ok = count == 24;
+        for (int i = 0; i < 8; ++i) {
+            ok = ok && hasPoint(vertices, count, (i & 1 ? max : min)[0], (i & 2 ? max : min)[1], (i & 4 ? max : min)[2]);
+        }
+        debugDraw.frustum(frustum, 0);
+        count = debugDraw.gather(vertices.data(), 1024);
+        ok = ok && count == 24;
+        for (int i = 0; i < 8; ++i) {
+            ok = ok && hasPoint(vertices, count, i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : 0.0f);
+        }
+        const float center[3] = { 5.0f, 6.0f, 7.0f };
+        debugDraw.sphere(center, 2.0f, 0);
+        count = debugDraw.gather(vertices.data(), 1024);
+        ok = ok && count > 0 && count % 2 == 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            const float* p = vertices[i].position;
+            const float  distance = std::sqrt((p[0] - 5.0f) * (p[0] - 5.0f) + (p[1] - 6.0f) * (p[1] - 6.0f) + (p[2] - 7.0f) * (p[2] - 7.0f));
+            ok = ok && std::fabs(distance - 2.0f) < 1.0e-4f;
+        }
+        passed = check(ok, "shapes") && passed;
+    }
+
+    // ӂꂽ}`͔[ɏɐBgather œ肫Ȃ͐PʂŐ
+    {
+        DebugDraw debugDraw;
+        if (!debugDraw.create(64, 50)) {
+            return 1;
+        }
+        const float a[3] = {};
+        debugDraw.box(a, a, 0);     // 24
+        debugDraw.box(a, a, 0);     // 48
+        debugDraw.box(a, a, 0);     // ӂ
+        debugDraw.line(a, a, 0);    // 50
+        debugDraw.line(a, a, 0);    // ӂ
+        std::vector<DebugVertex> vertices(64);
+        const bool               full = debugDraw.vertexCount() == 50 && debugDraw.gather(vertices.data(), 64) == 50 && debugDraw.droppedCount() == 2;
+        debugDraw.box(a, a, 0);
+        const bool truncated = debugDraw.gather(vertices.data(), 10) == 10 && debugDraw.droppedCount() == 7 && debugDraw.vertexCount() == 0;
+        std::printf("overflow: %s\n", full && truncated ? "ok" : "MISMATCH");
+        passed = passed && full && truncated;
+    }
+
+    const char* const shapeNames[] = { "line", "box", "sphere", "frustum" };
+    const uint32_t    shapeVertices[] = { 2, 24, 96, 24 };
+    std::printf("\n%-8s %12s %12s %12s %14s\n", "shape", "1 thread", "all threads", "disabled", "gather");
+    for (int s = 0; s < 4; ++s) {
+        const Shape shape = static_cast<Shape>(s);
+        DebugDraw   debugDraw;
+        // ǂ̃Xbhςނ͌܂Ȃ̂ŁAǂ̃obt@SĂ
+        if (!debugDraw.create(threadCount, primitiveCount * shapeVertices[s])) {
+            return 1;
+        }
+        std::vector<DebugVertex> merged(size_t(primitiveCount) * shapeVertices[s]);
+        std::vector<double>      serialTimes;
+        std::vector<double>      parallelTimes;
+        std::vector<double>      disabledTimes;
+        std::vector<double>      gatherTimes;
+        for (int r = 0; r < Repeats; ++r) {
+            auto begin = Clock::now();
+            push(debugDraw, shape, frustum, 0, primitiveCount);
+            serialTimes.push_back(milliseconds(begin, Clock::now()) * 1.0e6 / primitiveCount);
+            debugDraw.gather(merged.data(), uint32_t(merged.size()));
+
+            // SXbhŕāAꂼꎩ̃obt@ɐς
+            begin = Clock::now();
+            jobSystem.parallelFor(primitiveCount, 256, [&](uint32_t first, uint32_t last) { push(debugDraw, shape, frustum, first, last); });
+            parallelTimes.push_back(milliseconds(begin, Clock::now()) * 1.0e6 / primitiveCount);
+            const uint32_t expected = debugDraw.vertexCount();
+
+            begin = Clock::now();
+            const uint32_t count = debugDraw.gather(merged.data(), uint32_t(merged.size()));
+            gatherTimes.push_back(milliseconds(begin, Clock::now()));
+            passed = passed && count == expected && count == primitiveCount * shapeVertices[s] && debugDraw.droppedCount() == 0;
+
+            debugDraw.setEnabled(false);
+            begin = Clock::now();
+            push(debugDraw, shape, frustum, 0, primitiveCount);
+            disabledTimes.push_back(milliseconds(begin, Clock::now()) * 1.0e6 / primitiveCount);
+            debugDraw.setEnabled(true);
+            passed = passed && debugDraw.vertexCount() == 0;
+        }
+        std::printf("%-8s %9.2f ns %9.2f ns %9.2f ns %11.3f ms\n", shapeNames[s], median(serialTimes), median(parallelTimes), median(disabledTimes),
+                    median(gatherTimes));
+    }
+    std::printf("(all threads: wall time per primitive split across %u threads; gather: merging every thread's buffer)\n", threadCount);
+
+    return finish(passed);
+}
@@ -0,0 +1,176 @@
+// [xobt@̐x̔rc[
+//
+// makePerspectiveProjection ̍sŋ[xɕϊAGPU Ɠ float  z/w ߂Ă
+// [xobt@̌`i24bit UNORM / 32bit floatjɊۂ߂
+// ƂɁuǂꂾꂽ 2 ʂȂO邩vi΋jʏ reverseZ Ŕׂ
+// ܂AOƉ̃NbvʂҒʂ̐[xɂȂ邱ƁAقǐ[x̑召ԂƂƁA
+// makeDepthPipelineDesc vpXEF̃pXꂼɕʂ̃pCvC邱Ƃm߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -I.. depth_precision_tool.cpp ../projection.cpp ../pipeline_state_desc.cpp -o depth_precision_tool
+// s:
+//   tools/depth_precision_tool [near] [far]
+
+#include "bench_common.h"
+#include "pipeline_state_desc.h"
+#include "projection.h"
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+constexpr float Pi = 3.14159265358979f;
+
+/// ׂgݍ킹
+struct DepthConfig {
+    const char* name;      ///< \
+    bool        reverseZ;  ///< reverseZ 
+    bool        infinite;  ///< ̃Nbvʂ𖳌ɂ邩
+    bool        unorm24;   ///< 24bit UNORM Ɋۂ߂邩ifalse Ȃ 32bit floatj
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[xobt@ɏlɂ
+ */
+double storedDepth(const float matrix[4][4], float distance, bool unorm24) {
+    const float z = matrix[2][2] * distance + matrix[2][3];
+    const float w = matrix[3][2] * distance;
+    const float depth = z / w;
+    if (unorm24) {
+        const double scale = double((1u << 24) - 1);
+        return std::nearbyint(std::fmin(std::fmax(double(depth), 0.0), 1.0) * scale) / scale;
+    }
+    return depth;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	 distance ̖ʂƌŏ̑΋߂
+ * @return	΋i1 𒴂猩Ȃj
+ */
+double resolution(const float matrix[4][4], float distance, bool unorm24) {
+    const double base = storedDepth(matrix, distance, unorm24);
+    for (double epsilon = 1.0e-8; epsilon < 1.0; epsilon *= 1.05) {
+        const float other = static_cast<float>(distance * (1.0 + epsilon));
+        if (other != distance && storedDepth(matrix, other, unorm24) != base) {
+            return epsilon;
+        }
+    }
+    return 1.0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const float nearZ = argc > 1 ? static_cast<float>(std::atof(argv[1])) : 0.1f;
+    const float farZ = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 10000.0f;
+    if (!(nearZ > 0.0f) || !(farZ > nearZ)) {
+        std::printf("need 0 < near < far\n");
+        return 1;
+    }
+
+    const DepthConfig configs[] = {
+        {"standard D24", false, false, true},
+        {"standard D32F", false, false, false},
+        {"reverse D32F", true, false, false},
+        {"reverse D32F inf", true, true, false},
+    };
+    const float distances[] = {nearZ * 2.0f, 1.0f, 10.0f, 100.0f, 1000.0f, farZ * 0.9f};
+
+    bool ok = true;
+    std::printf("near %g, far %g: smallest separable relative distance\n", nearZ, farZ);
+    std::printf("  %-18s", "distance");
+    for (const auto d : distances) {
+        std::printf(" %10g", d);
+    }
+    std::printf("\n");
+
+    double worst[4]{};
+    for (int c = 0; c < 4; ++c) {
+        const auto& config = configs[c];
+        float       matrix[4][4];
+        makePerspectiveProjection(matrix, 60.0f * Pi / 180.0f, 16.0f / 9.0f, nearZ, config.infinite ? std::numeric_limits<float>::infinity() : farZ,
+                                  config.reverseZ);
+
+        // ÕNbvʂƉ̃Nbv
+        const double atNear = storedDepth(matrix, nearZ, false);
+        const double atFar = config.infinite ? storedDepth(matrix, farZ * 1.0e6f, false) : storedDepth(matrix, farZ, false);
+        const double expectedNear = config.reverseZ ? 1.0 : 0.0;
+        const double expectedFar = config.reverseZ ? 0.0 : 1.0;
+        if (std::fabs(atNear - expectedNear) > 1.0e-5 || std::fabs(atFar - expectedFar) > 1.0e-5) {
+            std::printf("  %s: near -> %g, far -> %g (expected %g, %g)\n", config.name, atNear, atFar, expectedNear, expectedFar);
+            ok = false;
+        }
+
+        // قǐ[xPɕԁireverseZ ͌Aʏ͑j
+        // ʏ̐[x͉Ŋۂߌ덷Oւ̂ŁA\邾ɂ
+        uint32_t inversions = 0;
+        double   previous = storedDepth(matrix, nearZ, config.unorm24);
+        for (float d = nearZ; d < farZ; d *= 1.0001f) {
+            const double value = storedDepth(matrix, d, config.unorm24);
+            if (config.reverseZ ? value > previous : value < previous) {
+                ++inversions;
+            }
+            previous = value;
+        }
+        if (config.reverseZ && inversions > 0) {
+            ok = false;
+        }
+
+        std::printf("  %-18s", config.name);
+        for (const auto d : distances) {
+            const double r = resolution(matrix, d, config.unorm24);
+            worst[c] = std::fmax(worst[c], r);
+            std::printf(" %10.2e", r);
+        }
+        std::printf("  (order inversions %u)\n", inversions);
+    }
+
+    // reverseZ + float ͋ɂ炸 float ̉x̐xۂ
+    std::printf("worst: standard D24 %.2e, standard D32F %.2e, reverse D32F %.2e, reverse D32F inf %.2e\n", worst[0], worst[1], worst[2],
+                worst[3]);
+    if (!(worst[2] < 1.0e-5) || !(worst[3] < 1.0e-5) || !(worst[2] < worst[1])) {
+        ok = false;
+    }
+
+    // [x̎gƂ̃pCvC
+    PipelineStateDesc base;
+    base.vertexShaderHash = 1;
+    base.pixelShaderHash = 2;
+    base.renderTargetFormats[0] = 28;  // R8G8B8A8_UNORM
+    const DepthSetup withPrepass{40, true, true};  // D32_FLOAT
+    const DepthSetup withoutPrepass{40, true, false};
+    const auto       prepass = normalizePipelineStateDesc(makeDepthPipelineDesc(base, withPrepass, DepthPass::Prepass));
+    const auto       colorAfterPrepass = makeDepthPipelineDesc(base, withPrepass, DepthPass::Color);
+    const auto       color = makeDepthPipelineDesc(base, withoutPrepass, DepthPass::Color);
+    const auto       standardColor = makeDepthPipelineDesc(base, DepthSetup{40, false, false}, DepthPass::Color);
+    const auto       noDepth = makeDepthPipelineDesc(base, DepthSetup{}, DepthPass::Color);
+    if (prepass.pixelShaderHash != 0 || prepass.renderTargetCount != 0 || prepass.depth != DepthMode::ReadWrite ||
+        prepass.depthCompare != DepthCompare::Greater) {
+        std::printf("  prepass pipeline is not depth only\n");
+        ok = false;
+    }
+    if (colorAfterPrepass.depth != DepthMode::ReadOnly || colorAfterPrepass.depthCompare != DepthCompare::GreaterEqual ||
+        color.depth != DepthMode::ReadWrite || color.depthCompare != DepthCompare::Greater ||
+        standardColor.depthCompare != DepthCompare::Less || noDepth.depth != DepthMode::Disabled) {
+        std::printf("  color pipeline depth state is wrong\n");
+        ok = false;
+    }
+    const uint64_t hashes[] = {hashPipelineStateDesc(prepass), hashPipelineStateDesc(colorAfterPrepass), hashPipelineStateDesc(color),
+                               hashPipelineStateDesc(standardColor), hashPipelineStateDesc(noDepth)};
+    for (size_t i = 0; i < std::size(hashes); ++i) {
+        for (size_t j = i + 1; j < std::size(hashes); ++j) {
+            if (hashes[i] == hashes[j]) {
+                std::printf("  pipeline variants %zu and %zu share a hash\n", i, j);
+                ok = false;
+            }
+        }
+    }
+
+    return finish(ok);
+}
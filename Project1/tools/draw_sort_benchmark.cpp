@@ -0,0 +1,204 @@
+// `̃\[gL[̃x`}[N
+//
+// ΂΂̏Őς񂾕`isƔApCvC 64E[gVOl` 4E}eA 1024EbV 256 
+// gݍ킹f 4096 ̂ǂꂩj DrawQueue ̊\[gŕׁAstd::sort ƎԂׂB
+// ʂ std::sort Ɠijł邱ƂƁAOɕԂƁAspCvCƂ 1 񂾂A
+// pCvCE}eAEbV̑g 1 񂾂؂ւ邱Ƃm߂
+// ܂AׂOƌ SetPipelineState / SetGraphicsRootSignature / IASetVertexBuffers / }eAݒ
+// 񐔂ǂς邩\
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -I.. draw_sort_benchmark.cpp ../draw_queue.cpp ../radix_sort.cpp -o draw_sort_benchmark
+// s:
+//   tools/draw_sort_benchmark [`搔]
+
+#include "bench_common.h"
+#include "draw_queue.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr uint32_t PipelineCount = 64;
+constexpr uint32_t RootSignatureCount = 4;
+constexpr uint32_t MaterialCount = 1024;
+constexpr uint32_t MeshCount = 256;
+constexpr uint32_t ModelCount = 4096;
+constexpr uint32_t OpaquePass = 0;
+constexpr uint32_t TransparentPass = 1;
+
+/// V[̃IuWFNg
+struct Object {
+    DrawPacket packet;  ///< `
+    uint32_t   pass;    ///< pX
+    uint32_t   layer;   ///< C[
+    float      depth;   ///< J̋
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	IuWFNgifbVƃ}eAA}eApCvCApCvC[gVOl`߂j
+ */
+std::vector<Object> makeObjects(uint32_t count) {
+    std::mt19937                          random(1);
+    std::uniform_int_distribution<uint32_t> material(0, MaterialCount - 1);
+    std::uniform_int_distribution<uint32_t> mesh(0, MeshCount - 1);
+    std::uniform_int_distribution<uint32_t> model(0, ModelCount - 1);
+    std::uniform_real_distribution<float> depth(0.5f, 1000.0f);
+    std::uniform_int_distribution<uint32_t> percent(0, 99);
+
+    std::vector<DrawPacket> models(ModelCount);
+    for (auto& packet : models) {
+        const uint32_t m = material(random);
+        const uint32_t pipeline = m % PipelineCount;
+        packet = {pipeline / (PipelineCount / RootSignatureCount), pipeline, mesh(random), m, 36, 1, 0, 0};
+    }
+
+    std::vector<Object> objects(count);
+    for (auto& object : objects) {
+        object.packet = models[model(random)];
+        object.pass = percent(random) < 85 ? OpaquePass : TransparentPass;
+        object.layer = percent(random) < 10 ? 1 : 0;
+        object.depth = depth(random);
+    }
+    return objects;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Ԃ̐؂ւ񐔂\
+ */
+void printStats(const char* label, const DrawStats& stats) {
+    std::printf("  %-9s draws %7u  root signature %6u  pipeline %7u  vertex buffer %7u  material %7u\n", label, stats.draws,
+                stats.rootSignatureChanges, stats.pipelineChanges, stats.vertexBufferChanges, stats.materialChanges);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t count = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100000;
+    if (count == 0 || count > DrawQueue::MaxPackets) {
+        std::printf("draw count must be 1..%u\n", DrawQueue::MaxPackets);
+        return 1;
+    }
+    const auto objects = makeObjects(count);
+
+    // L[ĐςގԂƁA\[g̎
+    DrawQueue             queue;
+    std::vector<double>   buildTimes;
+    std::vector<double>   radixTimes;
+    std::vector<double>   stdTimes;
+    std::vector<uint64_t> reference;
+    for (int repeat = 0; repeat < 21; ++repeat) {
+        const auto begin = Clock::now();
+        queue.clear();
+        for (const auto& object : objects) {
+            const auto order = object.pass == TransparentPass ? DrawOrder::BackToFront : DrawOrder::StateFirst;
+            queue.add(makeDrawKey(object.pass, object.layer, object.packet.pipeline, object.packet.material, object.packet.vertexBuffer, object.depth, order),
+                      object.packet);
+        }
+        const auto built = Clock::now();
+        queue.sort();
+        const auto sorted = Clock::now();
+        buildTimes.push_back(milliseconds(begin, built));
+        radixTimes.push_back(milliseconds(built, sorted));
+
+        reference.clear();
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto& object = objects[i];
+            const auto  order = object.pass == TransparentPass ? DrawOrder::BackToFront : DrawOrder::StateFirst;
+            reference.push_back(
+                makeDrawKey(object.pass, object.layer, object.packet.pipeline, object.packet.material, object.packet.vertexBuffer, object.depth, order) | i);
+        }
+        const auto stdBegin = Clock::now();
+        std::sort(reference.begin(), reference.end());
+        stdTimes.push_back(milliseconds(stdBegin, Clock::now()));
+    }
+    const double radix = median(radixTimes);
+    const double standard = median(stdTimes);
+    std::printf("draws %u\n", count);
+    std::printf("  build keys %.3f ms, radix sort %.3f ms (%.1f Mkeys/s), std::sort %.3f ms (%.1f Mkeys/s)\n", median(buildTimes), radix,
+                count / radix / 1000.0, standard, count / standard / 1000.0);
+
+    bool ok = true;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (queue.key(i) != reference[i]) {
+            std::printf("  order differs from std::sort at %u\n", i);
+            ok = false;
+            break;
+        }
+    }
+
+    // ͉OAs̓pXEC[̒ŃpCvCƁApCvCE}eAEbV̑gƂ 1 
+    std::vector<uint32_t> runs(PipelineCount, 0);
+    std::vector<uint8_t>  stateRuns(uint64_t(MaterialCount) * MeshCount, 0);
+    uint32_t              lastPipeline = UINT32_MAX;
+    uint32_t              lastState = UINT32_MAX;
+    float                 lastDepth = 1.0e30f;
+    uint32_t              lastGroup = UINT32_MAX;
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto&    object = objects[queue.key(i) & (DrawQueue::MaxPackets - 1)];
+        const uint32_t group = object.pass * 16 + object.layer;
+        if (group != lastGroup) {
+            std::fill(runs.begin(), runs.end(), 0);
+            std::fill(stateRuns.begin(), stateRuns.end(), 0);
+            lastPipeline = UINT32_MAX;
+            lastState = UINT32_MAX;
+            lastDepth = 1.0e30f;
+            lastGroup = group;
+        }
+        if (object.pass == TransparentPass) {
+            // [x 16bit Ɋۂ߂̂ŁA 1% ȓ̋t]͋
+            if (object.depth > lastDepth * 1.01f) {
+                std::printf("  transparent draw %u is not back to front\n", i);
+                ok = false;
+                break;
+            }
+            lastDepth = object.depth;
+            continue;
+        }
+        if (object.packet.pipeline != lastPipeline) {
+            if (++runs[object.packet.pipeline] > 1) {
+                std::printf("  pipeline %u is split in the opaque pass\n", object.packet.pipeline);
+                ok = false;
+                break;
+            }
+            lastPipeline = object.packet.pipeline;
+        }
+        // }eApCvC߂̂ŁA}eAƃbV̑gŏԂ܂
+        const uint32_t state = object.packet.material * MeshCount + object.packet.vertexBuffer;
+        if (state != lastState) {
+            if (++stateRuns[state] > 1) {
+                std::printf("  material %u / mesh %u is split in the opaque pass\n", object.packet.material, object.packet.vertexBuffer);
+                ok = false;
+                break;
+            }
+            lastState = state;
+        }
+    }
+
+    // ς񂾏̂܂ܒoꍇƁAׂĒoꍇ
+    DrawQueue unsorted;
+    for (const auto& object : objects) {
+        unsorted.add(0, object.packet);
+    }
+    DrawStateTracker before;
+    unsorted.simulate(before);
+    DrawStateTracker after;
+    queue.simulate(after);
+    std::printf("state changes\n");
+    printStats("unsorted", before.stats());
+    printStats("sorted", after.stats());
+
+    const auto& s = after.stats();
+    const auto& u = before.stats();
+    if (s.draws != u.draws || s.pipelineChanges >= u.pipelineChanges || s.rootSignatureChanges >= u.rootSignatureChanges ||
+        s.materialChanges >= u.materialChanges || s.vertexBufferChanges >= u.vertexBufferChanges) {
+        ok = false;
+    }
+
+    return finish(ok);
+}
@@ -0,0 +1,492 @@
+// ECSiGeBeB[hER}hobt@EVXeXPW[[j̊mFƃx`}[N
+//
+// mF: 쐬E폜ER|[lg̒ǉƍ폜_ɌJԂAGeBeBԍňfȕ\ƒlׂ
+// NGォłA[L^CvEƁAR}hobt@L^ɔf邱ƁA
+// XPW[[̒i̕ƁA1 XbhƕŌʁilƐcGeBeBjv邱Ƃm߂
+// x`}[N: 100 GeBeB̈ʒu̍XVA`N SoA ƃq[vɎU΂IuWFNg̉z֐ĂяoŔׂ
+// 쐬E܂Ƃ߂č쐬ER|[lg̒ǉƍ폜E폜ER}hobt@̔f̎Ԃ
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -pthread -I.. ecs_benchmark.cpp ../entity_world.cpp ../entity_command_buffer.cpp ../system_scheduler.cpp ../job_system.cpp -o ecs_benchmark
+// s:
+//   tools/ecs_benchmark [GeBeB]
+
+#include "bench_common.h"
+#include "entity_command_buffer.h"
+#include "entity_world.h"
+#include "job_system.h"
+#include "system_scheduler.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+/// 
+constexpr int Repeats = 5;
+
+struct Position {
+    float x, y, z;
+};
+struct Velocity {
+    float x, y, z;
+};
+struct Health {
+    float value;
+};
+struct Frozen {
+    uint8_t reason;
+};
+
+/// 
+std::mt19937 generator(12345);
+
+/// m߂鑤GeBeB
+struct Expected {
+    Entity        entity;
+    ComponentMask mask;
+    Position      position;
+    Velocity      velocity;
+    Health        health;
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[h̒lm߂鑤̕\ƈv邩
+ */
+bool matches(const EntityWorld& world, const std::unordered_map<uint32_t, Expected>& expected) {
+    if (world.size() != expected.size()) {
+        return false;
+    }
+    for (const auto& [index, e] : expected) {
+        if (!world.isAlive(e.entity) || world.mask(e.entity) != e.mask) {
+            return false;
+        }
+        const Position* position = world.get<Position>(e.entity);
+        const Velocity* velocity = world.get<Velocity>(e.entity);
+        const Health*   health = world.get<Health>(e.entity);
+        if ((position != nullptr) != bool(e.mask & componentMask<Position>()) || (position && std::memcmp(position, &e.position, sizeof(Position)))) {
+            return false;
+        }
+        if ((velocity != nullptr) != bool(e.mask & componentMask<Velocity>()) || (velocity && std::memcmp(velocity, &e.velocity, sizeof(Velocity)))) {
+            return false;
+        }
+        if ((health != nullptr) != bool(e.mask & componentMask<Health>()) || (health && health->value != e.health.value)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// ׂ邽߂̃q[vɎU΂IuWFNg
+class GameObject {
+public:
+    virtual ~GameObject() = default;
+    virtual void update(float deltaTime) = 0;
+};
+
+/// IuWFNg
+class MovingObject final : public GameObject {
+public:
+    void update(float deltaTime) override {
+        position.x += velocity.x * deltaTime;
+        position.y += velocity.y * deltaTime;
+        position.z += velocity.z * deltaTime;
+    }
+    Position position{};
+    Velocity velocity{};
+    char     other[64]{};  ///< ۂ̃IuWFNgق̃f[^
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Q[̂悤ȑgݍ킹̃[hi4 ̃A[L^Cvɕj
+ */
+void populate(EntityWorld& world, uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        const float    f = float(i);
+        const Entity   entity = world.create(Position{ f, f * 0.5f, -f }, Velocity{ 1.0f, 0.5f, f * 0.001f });
+        if (i % 3 == 0) {
+            world.add(entity, Health{ 100.0f - float(i % 200) });
+        }
+        if (i % 7 == 0) {
+            world.add(entity, Frozen{ 1 });
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	m߂邽߂̃VXeo^
+ */
+void addSystems(SystemScheduler& scheduler, EntityWorld& world, float deltaTime) {
+    // ʒui߂iĂ̂͏j
+    SystemDesc movement;
+    movement.name = "movement";
+    movement.reads = componentMask<Velocity>();
+    movement.writes = componentMask<Position>();
+    movement.exclude = componentMask<Frozen>();
+    movement.update = [deltaTime](const ChunkView& chunk, EntityCommandBuffer&) {
+        Position*       position = chunk.get<Position>();
+        const Velocity* velocity = chunk.get<Velocity>();
+        for (uint32_t i = 0; i < chunk.size(); ++i) {
+            position[i].x += velocity[i].x * deltaTime;
+            position[i].y += velocity[i].y * deltaTime;
+            position[i].z += velocity[i].z * deltaTime;
+        }
+    };
+    scheduler.add(world, movement);
+
+    // ̗͂炵Asiʒu̍XVƂԂȂ̂œij
+    SystemDesc decay;
+    decay.name = "decay";
+    decay.writes = componentMask<Health>();
+    decay.update = [deltaTime](const ChunkView& chunk, EntityCommandBuffer& commands) {
+        Health*       health = chunk.get<Health>();
+        const Entity* entities = chunk.entities();
+        for (uint32_t i = 0; i < chunk.size(); ++i) {
+            health[i].value -= 30.0f * deltaTime;
+            if (health[i].value <= 0.0f) {
+                commands.destroy(entities[i]);
+            }
+        }
+    };
+    scheduler.add(world, decay);
+
+    // xςimovement ǂނ̂Ŏ̒ij
+    SystemDesc gravity;
+    gravity.name = "gravity";
+    gravity.writes = componentMask<Velocity>();
+    gravity.update = [deltaTime](const ChunkView& chunk, EntityCommandBuffer&) {
+        Velocity* velocity = chunk.get<Velocity>();
+        for (uint32_t i = 0; i < chunk.size(); ++i) {
+            velocity[i].y -= 9.8f * deltaTime;
+        }
+    };
+    scheduler.add(world, gravity);
+
+    // ̂𓀂点imovement ʒuǂނ̂Ŏ̒ij
+    SystemDesc bounds;
+    bounds.name = "bounds";
+    bounds.reads = componentMask<Position>();
+    bounds.exclude = componentMask<Frozen>();
+    bounds.update = [](const ChunkView& chunk, EntityCommandBuffer& commands) {
+        const Position* position = chunk.get<Position>();
+        const Entity*   entities = chunk.entities();
+        for (uint32_t i = 0; i < chunk.size(); ++i) {
+            if (position[i].y < -50.0f) {
+                commands.add(entities[i], Frozen{ 2 });
+            }
+        }
+    };
+    scheduler.add(world, bounds);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[h̒gGeBeBԍɕׂiׂ邽߁j
+ */
+std::vector<Expected> snapshot(const EntityWorld& world, uint32_t maxIndex) {
+    std::vector<Expected> result;
+    for (uint32_t index = 0; index < maxIndex; ++index) {
+        for (uint32_t generation = 0; generation < 4; ++generation) {
+            const Entity entity{ index, generation };
+            if (!world.isAlive(entity)) {
+                continue;
+            }
+            Expected e{ entity, world.mask(entity), {}, {}, {} };
+            if (const Position* p = world.get<Position>(entity)) {
+                e.position = *p;
+            }
+            if (const Velocity* v = world.get<Velocity>(entity)) {
+                e.velocity = *v;
+            }
+            if (const Health* h = world.get<Health>(entity)) {
+                e.health = *h;
+            }
+            result.push_back(e);
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t entityCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1000000;
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+    std::printf("workers %u, %u entities\n", jobSystem.workerCount(), entityCount);
+    bool passed = true;
+
+    // 쐬E폜EǉE폜_ɌJԂAfȕ\Ɣׂ
+    {
+        EntityWorld                            world;
+        std::unordered_map<uint32_t, Expected> expected;
+        std::vector<Entity>                    alive;
+        std::vector<Entity>                    dead;
+        bool                                   ok = true;
+        for (uint32_t step = 0; step < 200000; ++step) {
+            const uint32_t action = generator() % 10;
+            const float    value = float(step);
+            if (action < 4 || alive.empty()) {
+                const Entity entity = world.create(Position{ value, value, value });
+                expected[entity.index] = { entity, componentMask<Position>(), { value, value, value }, {}, {} };
+                alive.push_back(entity);
+            }
+            else {
+                const uint32_t pick = generator() % alive.size();
+                const Entity   entity = alive[pick];
+                Expected&      e = expected[entity.index];
+                switch (action) {
+                case 4:
+                case 5:
+                    world.add(entity, Velocity{ value, -value, 1.0f });
+                    e.mask |= componentMask<Velocity>();
+                    e.velocity = { value, -value, 1.0f };
+                    break;
+                case 6:
+                    world.add(entity, Health{ value });
+                    e.mask |= componentMask<Health>();
+                    e.health = { value };
+                    break;
+                case 7:
+                    if (world.remove<Position>(entity) != bool(e.mask & componentMask<Position>())) {
+                        ok = false;
+                    }
+                    e.mask &= ~componentMask<Position>();
+                    break;
+                default:
+                    ok = ok && world.destroy(entity);
+                    expected.erase(entity.index);
+                    alive[pick] = alive.back();
+                    alive.pop_back();
+                    dead.push_back(entity);
+                    break;
+                }
+            }
+        }
+        ok = ok && matches(world, expected);
+        // 폜nh͔ԍg񂳂Ă
+        for (const Entity& entity : dead) {
+            ok = ok && !world.isAlive(entity) && !world.destroy(entity) && world.get<Position>(entity) == nullptr;
+        }
+        std::printf("random structural changes: %s (%u entities, %u archetypes, %u chunks)\n", ok ? "ok" : "MISMATCH", world.size(),
+                    world.archetypeCount(), world.allocatedChunkCount());
+        passed = passed && ok;
+    }
+
+    // NG͌ォłA[L^CvEAȂ瓯ԍԂ
+    {
+        EntityWorld   world;
+        const QueryId moving = world.createQuery(componentMask<Position, Velocity>(), componentMask<Frozen>());
+        bool          ok = world.count(moving) == 0 && world.createQuery(componentMask<Position, Velocity>(), componentMask<Frozen>()) == moving;
+        populate(world, 1000);
+        uint32_t expectedCount = 0;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            expectedCount += i % 7 != 0 ? 1 : 0;
+        }
+        uint32_t visited = 0;
+        world.each<Position, Velocity>(moving, [&](Position&, Velocity&) { ++visited; });
+        ok = ok && world.count(moving) == expectedCount && visited == expectedCount;
+
+        // ܂Ƃ߂č쐬GeBeB̓`NPʂŖ߂
+        std::vector<Position> source(5000);
+        for (uint32_t i = 0; i < source.size(); ++i) {
+            source[i] = { float(i), 0.0f, 0.0f };
+        }
+        std::vector<Entity> created;
+        world.createBatch(componentMask<Position>(), uint32_t(source.size()), [&](const ChunkView& chunk, uint32_t row, uint32_t first) {
+            const uint32_t n = chunk.size() - row;
+            std::memcpy(chunk.get<Position>() + row, source.data() + first, sizeof(Position) * n);
+            created.insert(created.end(), chunk.entities() + row, chunk.entities() + chunk.size());
+        });
+        ok = ok && created.size() == source.size();
+        for (uint32_t i = 0; i < created.size(); ++i) {
+            ok = ok && world.get<Position>(created[i])->x == float(i) && world.mask(created[i]) == componentMask<Position>();
+        }
+        passed = check(ok, "queries / batch create") && passed;
+    }
+
+    // R}hobt@͋L^ɔfA폜ς݂̃GeBeBւ̋L^͔΂
+    {
+        EntityWorld         world;
+        const Entity        a = world.create(Position{ 1.0f, 2.0f, 3.0f });
+        const Entity        b = world.create(Position{ 4.0f, 5.0f, 6.0f });
+        EntityCommandBuffer commands;
+        Velocity            velocity{ 7.0f, 8.0f, 9.0f };
+        commands.add(a, velocity);
+        velocity.x = -1.0f;  // L^ɕςĂfȂ
+        commands.destroy(b);
+        commands.add(b, Health{ 1.0f });
+        commands.create(Position{ 10.0f, 11.0f, 12.0f }, Health{ 50.0f });
+        commands.create(componentMask<Velocity>());
+        commands.remove<Position>(a);
+        bool ok = commands.commandCount() == 8 && world.size() == 2;
+        commands.playback(world);
+        ok = ok && commands.empty() && world.size() == 3 && !world.isAlive(b);
+        ok = ok && world.mask(a) == componentMask<Velocity>() && world.get<Velocity>(a)->x == 7.0f;
+        const QueryId healthy = world.createQuery(componentMask<Position, Health>());
+        world.each<Position, Health>(healthy, [&](Position& p, Health& h) { ok = ok && p.z == 12.0f && h.value == 50.0f; });
+        const QueryId velocityOnly = world.createQuery(componentMask<Velocity>(), componentMask<Position>());
+        ok = ok && world.count(healthy) == 1 && world.count(velocityOnly) == 2;
+        passed = check(ok, "command buffer") && passed;
+    }
+
+    // i̕ƁA1 XbhƕŌʂv邱
+    {
+        EntityWorld     serialWorld;
+        EntityWorld     parallelWorld;
+        SystemScheduler serial;
+        SystemScheduler parallel;
+        populate(serialWorld, 50000);
+        populate(parallelWorld, 50000);
+        addSystems(serial, serialWorld, 1.0f / 60.0f);
+        addSystems(parallel, parallelWorld, 1.0f / 60.0f);
+        bool ok = serial.stageCount() == 2 && serial.stage(0) == 0 && serial.stage(1) == 0 && serial.stage(2) == 1 && serial.stage(3) == 1;
+        for (int frame = 0; frame < 300; ++frame) {
+            serial.run(serialWorld);
+            parallel.run(parallelWorld, &jobSystem);
+        }
+        const std::vector<Expected> a = snapshot(serialWorld, 50000);
+        const std::vector<Expected> b = snapshot(parallelWorld, 50000);
+        ok = ok && serialWorld.size() < 50000 && a.size() == b.size();
+        for (size_t i = 0; ok && i < a.size(); ++i) {
+            ok = a[i].entity == b[i].entity && a[i].mask == b[i].mask && std::memcmp(&a[i].position, &b[i].position, sizeof(Position)) == 0 &&
+                 std::memcmp(&a[i].velocity, &b[i].velocity, sizeof(Velocity)) == 0;
+        }
+        std::printf("scheduler stages / determinism: %s (%u survivors)\n", ok ? "ok" : "MISMATCH", serialWorld.size());
+        passed = passed && ok;
+    }
+
+    // ʒu̍XV: `N SoA ƃq[vɎU΂IuWFNg
+    {
+        const float deltaTime = 1.0f / 60.0f;
+        EntityWorld world;
+        populate(world, entityCount);
+        const QueryId   moving = world.createQuery(componentMask<Position, Velocity>(), componentMask<Frozen>());
+        SystemScheduler scheduler;
+        SystemDesc      movement;
+        movement.reads = componentMask<Velocity>();
+        movement.writes = componentMask<Position>();
+        movement.exclude = componentMask<Frozen>();
+        movement.update = [deltaTime](const ChunkView& chunk, EntityCommandBuffer&) {
+            Position*       position = chunk.get<Position>();
+            const Velocity* velocity = chunk.get<Velocity>();
+            for (uint32_t i = 0; i < chunk.size(); ++i) {
+                position[i].x += velocity[i].x * deltaTime;
+                position[i].y += velocity[i].y * deltaTime;
+                position[i].z += velocity[i].z * deltaTime;
+            }
+        };
+        scheduler.add(world, movement);
+
+        // IuWFNg͊Ԃɕʂ̊mۂōA΂΂ɂ
+        std::vector<std::unique_ptr<GameObject>> objects;
+        std::vector<std::unique_ptr<char[]>>     noise;
+        for (uint32_t i = 0; i < world.count(moving); ++i) {
+            objects.push_back(std::make_unique<MovingObject>());
+            noise.push_back(std::make_unique<char[]>(16 + generator() % 256));
+        }
+        std::shuffle(objects.begin(), objects.end(), generator);
+        noise.clear();
+
+        std::vector<double> eachTimes, serialTimes, parallelTimes, objectTimes;
+        for (int r = 0; r < Repeats; ++r) {
+            auto begin = Clock::now();
+            world.each<Position, Velocity>(moving, [deltaTime](Position& p, const Velocity& v) {
+                p.x += v.x * deltaTime;
+                p.y += v.y * deltaTime;
+                p.z += v.z * deltaTime;
+            });
+            eachTimes.push_back(milliseconds(begin, Clock::now()));
+            begin = Clock::now();
+            scheduler.run(world);
+            serialTimes.push_back(milliseconds(begin, Clock::now()));
+            begin = Clock::now();
+            scheduler.run(world, &jobSystem);
+            parallelTimes.push_back(milliseconds(begin, Clock::now()));
+            begin = Clock::now();
+            for (const auto& object : objects) {
+                object->update(deltaTime);
+            }
+            objectTimes.push_back(milliseconds(begin, Clock::now()));
+        }
+        const double count = world.count(moving);
+        std::printf("\niteration (%u moving entities, %u archetypes)\n", uint32_t(count), world.archetypeCount());
+        std::printf("  each               %8.3f ms %6.2f ns/entity\n", median(eachTimes), median(eachTimes) * 1.0e6 / count);
+        std::printf("  system 1 thread    %8.3f ms %6.2f ns/entity\n", median(serialTimes), median(serialTimes) * 1.0e6 / count);
+        std::printf("  system all threads %8.3f ms %6.2f ns/entity\n", median(parallelTimes), median(parallelTimes) * 1.0e6 / count);
+        std::printf("  heap objects       %8.3f ms %6.2f ns/entity\n", median(objectTimes), median(objectTimes) * 1.0e6 / count);
+    }
+
+    // \̕ύX
+    {
+        const uint32_t      changeCount = entityCount / 10;
+        std::vector<double> createTimes, batchTimes, addTimes, removeTimes, destroyTimes, recordTimes, playbackTimes;
+        for (int r = 0; r < Repeats; ++r) {
+            EntityWorld         world;
+            std::vector<Entity> entities(entityCount);
+            auto                begin = Clock::now();
+            for (uint32_t i = 0; i < entityCount; ++i) {
+                entities[i] = world.create(Position{ 0.0f, 0.0f, 0.0f }, Velocity{ 1.0f, 0.0f, 0.0f });
+            }
+            createTimes.push_back(milliseconds(begin, Clock::now()) * 1.0e6 / entityCount);
+
+            EntityWorld batchWorld;
+            begin = Clock::now();
+            batchWorld.createBatch(componentMask<Position, Velocity>(), entityCount, [](const ChunkView& chunk, uint32_t row, uint32_t) {
+                std::memset(chunk.get<Position>() + row, 0, sizeof(Position) * (chunk.size() - row));
+                std::memset(chunk.get<Velocity>() + row, 0, sizeof(Velocity) * (chunk.size() - row));
+            });
+            batchTimes.push_back(milliseconds(begin, Clock::now()) * 1.0e6 / entityCount);
+
+            std::shuffle(entities.begin(), entities.end(), generator);
+            begin = Clock::now();
+            for (uint32_t i = 0; i < changeCount; ++i) {
+                world.add(entities[i], Health{ 1.0f });
+            }
+            addTimes.push_back(milliseconds(begin, Clock::now()) * 1.0e6 / changeCount);
+            begin = Clock::now();
+            for (uint32_t i = 0; i < changeCount; ++i) {
+                world.remove<Health>(entities[i]);
+            }
+            removeTimes.push_back(milliseconds(begin, Clock::now()) * 1.0e6 / changeCount);
+
+            EntityCommandBuffer commands;
+            begin = Clock::now();
+            for (uint32_t i = changeCount; i < changeCount * 2; ++i) {
+                commands.add(entities[i], Frozen{ 3 });
+            }
+            recordTimes.push_back(milliseconds(begin, Clock::now()) * 1.0e6 / changeCount);
+            begin = Clock::now();
+            commands.playback(world);
+            playbackTimes.push_back(milliseconds(begin, Clock::now()) * 1.0e6 / changeCount);
+
+            begin = Clock::now();
+            for (uint32_t i = 0; i < changeCount; ++i) {
+                world.destroy(entities[i]);
+            }
+            destroyTimes.push_back(milliseconds(begin, Clock::now()) * 1.0e6 / changeCount);
+            passed = passed && world.size() == entityCount - changeCount && batchWorld.size() == entityCount;
+        }
+        std::printf("\nstructural changes (ns per entity)\n");
+        std::printf("  create             %8.2f\n", median(createTimes));
+        std::printf("  create batch       %8.2f\n", median(batchTimes));
+        std::printf("  add component      %8.2f\n", median(addTimes));
+        std::printf("  remove component   %8.2f\n", median(removeTimes));
+        std::printf("  destroy            %8.2f\n", median(destroyTimes));
+        std::printf("  command record     %8.2f\n", median(recordTimes));
+        std::printf("  command playback   %8.2f\n", median(playbackTimes));
+    }
+
+    return finish(passed);
+}
@@ -0,0 +1,100 @@
+// JÕx`}[N
+//
+// E AABB 𗐐ŕׁA߃ZbgiXJ[ / SSE / AVX2jƒȆgݍ킹Ƃ
+// cullSpheres / cullBoxes ̎Ԃ𑪂BSĂ̑gݍ킹œԍɂȂ邱Ƃm߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -mavx2 -pthread -I.. frustum_culling_benchmark.cpp ../frustum_culling.cpp ../indirect_cull.cpp ../job_system.cpp -o frustum_culling_benchmark
+// s:
+//   tools/frustum_culling_benchmark [IuWFNg] [t[]
+
+#include "bench_common.h"
+#include "frustum_culling.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t objectCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1000000;
+    const uint32_t frameCount  = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 20;
+
+    // eic 60 xA16:9Anear 0.1Afar 100jŌ_ +Z J
+    const float       f         = 1.0f / 0.57735f;
+    const float       aspect    = 16.0f / 9.0f;
+    const float       nearZ     = 0.1f;
+    const float       farZ      = 100.0f;
+    const float       projection[4][4] = {
+        { f / aspect, 0, 0, 0 },
+        { 0, f, 0, 0 },
+        { 0, 0, farZ / (farZ - nearZ), -nearZ * farZ / (farZ - nearZ) },
+        { 0, 0, 1, 0 },
+    };
+    const CullFrustum frustum = makeCullFrustum(projection);
+
+    // J̎ 200 x 200 x 200 ɎU炷iɓ̂ 1 j
+    BoundingSpheres                       spheres;
+    BoundingBoxes                         boxes;
+    std::mt19937                          random(42);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> size(0.1f, 2.0f);
+    for (uint32_t i = 0; i < objectCount; ++i) {
+        const float center[3] = { position(random), position(random), position(random) };
+        const float extent    = size(random);
+        const float min[3]    = { center[0] - extent, center[1] - extent, center[2] - extent };
+        const float max[3]    = { center[0] + extent, center[1] + extent, center[2] + extent };
+        spheres.add(center, extent * 1.7320508f);
+        boxes.add(min, max);
+    }
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+    std::printf("objects %u, workers %u\n", objectCount, jobSystem.workerCount());
+
+    const char* const     simdNames[] = { "scalar", "sse", "avx2" };
+    std::vector<uint32_t> visible(objectCount);
+    bool                  identical = true;
+
+    for (const bool useBoxes : { false, true }) {
+        std::vector<uint32_t> reference;
+        for (const CullSimd simd : { CullSimd::Scalar, CullSimd::Sse, CullSimd::Avx2 }) {
+            if (simd > bestCullSimd()) {
+                continue;
+            }
+            for (const bool useJobs : { false, true }) {
+                std::vector<double> times;
+                uint32_t            count = 0;
+                for (uint32_t frame = 0; frame < frameCount; ++frame) {
+                    const auto t0 = Clock::now();
+                    count = useBoxes ? cullBoxes(frustum, boxes, visible.data(), useJobs ? &jobSystem : nullptr, simd)
+                                     : cullSpheres(frustum, spheres, visible.data(), useJobs ? &jobSystem : nullptr, simd);
+                    times.push_back(milliseconds(t0, Clock::now()));
+                }
+                const double time = median(times);
+                std::printf("%-7s %-6s %-8s visible %7u: %7.3f ms (%.2f ns/object)\n", useBoxes ? "boxes" : "spheres",
+                            simdNames[static_cast<int>(simd)], useJobs ? "parallel" : "serial", count, time, time * 1e6 / objectCount);
+
+                // ŏ̌ʁiXJ[EjƔׂ
+                if (reference.empty()) {
+                    reference.assign(visible.begin(), visible.begin() + count);
+                }
+                else if (!std::equal(reference.begin(), reference.end(), visible.begin()) || count != reference.size()) {
+                    std::fprintf(stderr, "MISMATCH: %s %s %s\n", useBoxes ? "boxes" : "spheres", simdNames[static_cast<int>(simd)],
+                                 useJobs ? "parallel" : "serial");
+                    identical = false;
+                }
+            }
+        }
+    }
+
+    std::printf("all variants: %s\n", identical ? "identical" : "MISMATCH");
+    return finish(identical);
+}
@@ -0,0 +1,256 @@
+// Q[[viŒ݂̍ƕ`̕ԁj̊mF
+//
+// U̎vŎ̏ʂ𓮂AV~[V̉񐔁E`掞EԂʒum߂
+//   E\̑: 30 / 60 / 144 / 240 Hzihtj 60 Hz ̃V~[V  񐔂͌oߎԂǂA`掞̓t[̌oߎԂǂɐi݁A
+//                 œ̂̕Ԃʒu`掞̈ʒuƈv
+//   ẼXpC: V~[V 1 񂪍݂d   1 t[ŉ񂷉񐔂AΎ~܂
+//   E: 1 t[ 5 b  񂵂Ďĉ͎āǍ͌ǂ
+//   Ev̊߂: 񂳂Ȃ
+// ۂ̎vŁAV~[Vp̃Xbhŉ񂷂ƕ`̏dƌ݂ɉeȂƁA
+// XibvVbgԒɏĂǂ 2 ȂƂm߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -pthread -I.. game_loop_sim.cpp ../game_loop.cpp ../simd_math.cpp ../projection.cpp ../frustum_culling.cpp ../indirect_cull.cpp ../job_system.cpp -o game_loop_sim
+// s:
+//   tools/game_loop_sim
+
+#include "bench_common.h"
+#include "game_loop.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// V~[V̍
+constexpr double TickSeconds = 1.0 / 60.0;
+/// œ̂̑
+constexpr float Speed = 3.0f;
+
+/// 
+std::mt19937 generator(12345);
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ۂ̎vibj
+ */
+double realClock() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	œ̂ 1 XibvVbgu
+ */
+void publishMoving(TransformSnapshots& snapshots, double time) {
+    Transform transform;
+    transform.position = { Speed * static_cast<float>(time), 0.0f, 0.0f };
+    snapshots.publish(&transform, 1, time);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	\̑ςĊm߂
+ */
+bool checkDisplayRate(double hz) {
+    double             now = 0.0;
+    TransformSnapshots snapshots;
+    GameLoop           loop;
+    publishMoving(snapshots, 0.0);
+    GameLoopSettings settings;
+    settings.timestep.tickSeconds = TickSeconds;
+    if (!loop.start(settings, [&] { return now; }, [&](double time, double) { publishMoving(snapshots, time); })) {
+        return false;
+    }
+
+    std::uniform_real_distribution<double> jitter(0.9, 1.1);
+    std::vector<Transform>                 out;
+    double                                 lastRender = -1.0;
+    double                                 maxError = 0.0;
+    bool                                   ok = true;
+    constexpr double                       Seconds = 10.0;
+    while (now < Seconds) {
+        const double step = jitter(generator) / hz;
+        now += step;
+        const double render = loop.frame();
+        // `掞̓t[̌oߎԂǂɐiށiV~[V񂵂񐔂ɍEȂj
+        ok = ok && (lastRender < 0.0 || std::abs(render - lastRender - step) < 1.0e-9);
+        ok = ok && render >= lastRender && render <= loop.tickCount() * TickSeconds && render >= (loop.tickCount() - 1.0) * TickSeconds - 1.0e-9;
+        lastRender = render;
+        ok = ok && snapshots.interpolate(render, out) && out.size() == 1;
+        if (render >= 0.0) {
+            maxError = std::max(maxError, double(std::abs(out[0].position.x - Speed * float(render))));
+        }
+    }
+    const uint64_t expected = static_cast<uint64_t>(now / TickSeconds);
+    ok = ok && loop.tickCount() + 1 >= expected && loop.tickCount() <= expected && loop.droppedSeconds() == 0.0 && maxError < 1.0e-3;
+    std::printf("display %5.0f Hz: %llu ticks in %.2f s, max position error %.2e: %s\n", hz, static_cast<unsigned long long>(loop.tickCount()), now,
+                maxError, ok ? "ok" : "MISMATCH");
+    return ok;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	V~[V݂dꍇm߂
+ * @param	maxTicks	1 t[ŉ񂷏
+ * @param	frames		t[
+ * @return	Ō̃t[ŉ񂵂
+ */
+uint32_t spiral(uint32_t maxTicks, uint32_t frames, double& dropped) {
+    double           now = 0.0;
+    uint32_t         ticks = 0;
+    GameLoop         loop;
+    GameLoopSettings settings;
+    settings.timestep.tickSeconds = TickSeconds;
+    settings.timestep.maxTicksPerFrame = maxTicks;
+    if (!loop.start(settings, [&] { return now; }, [&](double, double) {
+            // 1 ɍ݂ 1.5 {
+            now += TickSeconds * 1.5;
+            ++ticks;
+        })) {
+        return 0;
+    }
+    for (uint32_t frame = 0; frame < frames; ++frame) {
+        now += 1.0 / 60.0;
+        ticks = 0;
+        loop.frame();
+    }
+    dropped = loop.droppedSeconds();
+    return ticks;
+}
+
+}  // namespace
+
+int main() {
+    bool passed = true;
+
+    for (const double hz : { 30.0, 60.0, 144.0, 240.0 }) {
+        passed = checkDisplayRate(hz) && passed;
+    }
+
+    // Ɖ񂷉񐔂A΂Ŏ~܂
+    {
+        double         dropped = 0.0;
+        const uint32_t unbounded = spiral(1u << 30, 20, dropped);
+        const bool     runaway = unbounded > 1000 && dropped == 0.0;
+        const uint32_t bounded = spiral(5, 1000, dropped);
+        const bool     ok = runaway && bounded == 5 && dropped > 0.0;
+        std::printf("spiral of death: unbounded %u ticks in frame 20, bounded %u ticks in frame 1000 (dropped %.1f s): %s\n", unbounded, bounded, dropped,
+                    ok ? "ok" : "MISMATCH");
+        passed = passed && ok;
+    }
+
+    // 1 t[ 5 b
+    {
+        double           now = 0.0;
+        uint32_t         ticks = 0;
+        GameLoop         loop;
+        GameLoopSettings settings;
+        settings.timestep.tickSeconds = TickSeconds;
+        settings.timestep.maxTicksPerFrame = 4;
+        bool ok = loop.start(settings, [&] { return now; }, [&](double, double) { ++ticks; });
+        for (int frame = 0; frame < 60; ++frame) {
+            now += TickSeconds;
+            loop.frame();
+        }
+        const uint64_t before = loop.tickCount();
+        now += 5.0;
+        ticks = 0;
+        const double render = loop.frame();
+        ok = ok && ticks == 4 && std::abs(loop.droppedSeconds() - (5.0 - 4 * TickSeconds)) < TickSeconds && render <= (before + 4) * TickSeconds;
+        ticks = 0;
+        for (int frame = 0; frame < 60; ++frame) {
+            now += TickSeconds;
+            loop.frame();
+        }
+        ok = ok && ticks >= 59 && ticks <= 61;
+        std::printf("hitch: 4 ticks then %.2f s dropped, %u ticks in the next 60 frames: %s\n", loop.droppedSeconds(), ticks, ok ? "ok" : "MISMATCH");
+        passed = passed && ok;
+    }
+
+    // v̊߂
+    {
+        FixedTimestep timestep;
+        const bool    ok = timestep.advance(-1.0) == 0 && timestep.advance(TickSeconds * 2.5) == 2 && timestep.advance(-5.0) == 0 &&
+                        std::abs(timestep.alpha() - 0.5f) < 1.0e-5f && timestep.tickCount() == 2;
+        passed = check(ok, "clock going backwards") && passed;
+    }
+
+    // ۂ̎v: d`ƏdV~[VAXbhƐp̃Xbhŉ
+    // `ƃV~[V̏d sleep Ŗ͂iCPU gȂ̂ 1 RAłdȂȂj
+    for (const bool threaded : { false, true }) {
+        constexpr double       Seconds = 1.0;
+        constexpr auto         RenderCost = std::chrono::milliseconds(12);
+        constexpr auto         TickCost = std::chrono::milliseconds(8);
+        TransformSnapshots     snapshots;
+        GameLoop               loop;
+        GameLoopSettings       settings;
+        std::vector<Transform> out;
+        settings.timestep.tickSeconds = TickSeconds;
+        settings.threaded = threaded;
+        publishMoving(snapshots, 0.0);
+        bool ok = loop.start(settings, realClock, [&](double time, double) {
+            std::this_thread::sleep_for(TickCost);
+            publishMoving(snapshots, time);
+        });
+        const double begin = realClock();
+        double       lastRender = -1.0;
+        float        lastPosition = -1.0e9f;
+        uint32_t     frames = 0;
+        while (realClock() - begin < Seconds) {
+            const double render = loop.frame();
+            ok = ok && render >= lastRender - 1.0e-9 && snapshots.interpolate(render, out) && out[0].position.x >= lastPosition - 1.0e-4f;
+            lastRender = render;
+            lastPosition = out[0].position.x;
+            std::this_thread::sleep_for(RenderCost);
+            ++frames;
+        }
+        const double elapsed = realClock() - begin;
+        loop.stop();
+        const double frameMilliseconds = elapsed * 1000.0 / frames;
+        const double tickRate = loop.tickCount() / elapsed;
+        // p̃XbhȂ`̓V~[V̏d҂Ȃ
+        ok = ok && tickRate > 50.0 && tickRate < 70.0 && (!threaded || frameMilliseconds < 12.0 + 4.0);
+        std::printf("%-17s %3u frames (%.1f ms each), %.1f ticks/s: %s\n", threaded ? "threaded:" : "same thread:", frames, frameMilliseconds, tickRate,
+                    ok ? "ok" : "MISMATCH");
+        passed = passed && ok;
+    }
+
+    // XibvVbgȂԂiSĂ̗vf 2 ԂĂ邱Ɓj
+    {
+        constexpr uint32_t     Count = 10000;
+        TransformSnapshots     snapshots;
+        std::vector<Transform> source(Count);
+        std::vector<Transform> out;
+        GameLoop               loop;
+        GameLoopSettings       settings;
+        settings.timestep.tickSeconds = 0.001;
+        settings.threaded = true;
+        const auto publish = [&](double time, double) {
+            for (uint32_t i = 0; i < Count; ++i) {
+                source[i].position = { float(time * 1000.0), float(i), 0.0f };
+            }
+            snapshots.publish(source.data(), Count, time);
+        };
+        publish(0.0, 0.0);
+        bool         ok = loop.start(settings, realClock, publish);
+        const double begin = realClock();
+        uint32_t     reads = 0;
+        while (realClock() - begin < 0.3) {
+            ok = ok && snapshots.interpolate(loop.frame(), out) && out.size() == Count;
+            for (uint32_t i = 1; ok && i < Count; ++i) {
+                ok = out[i].position.x == out[0].position.x && out[i].position.y == float(i);
+            }
+            ++reads;
+        }
+        loop.stop();
+        std::printf("concurrent snapshots: %u reads over %llu ticks: %s\n", reads, static_cast<unsigned long long>(loop.tickCount()), ok ? "ok" : "MISMATCH");
+        passed = passed && ok;
+    }
+
+    return finish(passed);
+}
@@ -0,0 +1,85 @@
+// GPU 쓮JO CPU ̃x`}[N
+//
+// IuWFNg𗐐ŕׁAcullAndCompact ̒łƕł̎Ԃ𑪂
+// ŁEŁEfpȒ 3 R}hɂȂ邱Ƃm߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -pthread -I.. indirect_cull_benchmark.cpp ../indirect_cull.cpp ../job_system.cpp -o indirect_cull_benchmark
+// s:
+//   tools/indirect_cull_benchmark [IuWFNg] [t[]
+
+#include "bench_common.h"
+#include "indirect_cull.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t objectCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1000000;
+    const uint32_t frameCount  = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 10;
+
+    // [-2, 2] ̗̂ɎU炷BiPʍs = [-1,1]x[-1,1]x[0,1]jɓ̂ 1/16 x
+    std::vector<DrawObject>               objects(objectCount);
+    std::mt19937                          random(42);
+    std::uniform_real_distribution<float> position(-2.0f, 2.0f);
+    std::uniform_real_distribution<float> radius(0.001f, 0.05f);
+    for (auto& object : objects) {
+        object = {};
+        object.bounds[0]   = position(random);
+        object.bounds[1]   = position(random);
+        object.bounds[2]   = position(random);
+        object.bounds[3]   = radius(random);
+        object.vertexCount = 3;
+    }
+
+    const float identity[4][4] = { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } };
+    const CullFrustum frustum  = makeCullFrustum(identity);
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+
+    std::vector<IndirectDrawCommand> serial(objectCount);
+    std::vector<IndirectDrawCommand> parallel(objectCount);
+    uint32_t                         serialCount   = 0;
+    uint32_t                         parallelCount = 0;
+
+    for (const bool useJobs : { false, true }) {
+        std::vector<double> times;
+        for (uint32_t frame = 0; frame < frameCount; ++frame) {
+            const auto t0 = Clock::now();
+            if (useJobs) {
+                parallelCount = cullAndCompact(objects.data(), objectCount, frustum, parallel.data(), &jobSystem);
+            }
+            else {
+                serialCount = cullAndCompact(objects.data(), objectCount, frustum, serial.data());
+            }
+            times.push_back(milliseconds(t0, Clock::now()));
+        }
+        std::printf("%-8s objects %u, visible %u: %.2f ms\n", useJobs ? "parallel" : "serial", objectCount,
+                    useJobs ? parallelCount : serialCount, median(times));
+    }
+
+    // fpȒ
+    std::vector<IndirectDrawCommand> reference;
+    for (uint32_t i = 0; i < objectCount; ++i) {
+        if (isSphereInFrustum(frustum, objects[i].bounds)) {
+            reference.push_back({ i, objects[i].vertexCount, 1, objects[i].startVertex, 0 });
+        }
+    }
+
+    const bool identical = serialCount == reference.size() && parallelCount == reference.size() &&
+                           std::memcmp(serial.data(), reference.data(), reference.size() * sizeof(IndirectDrawCommand)) == 0 &&
+                           std::memcmp(parallel.data(), reference.data(), reference.size() * sizeof(IndirectDrawCommand)) == 0;
+    std::printf("serial / parallel / reference: %s\n", identical ? "identical" : "MISMATCH");
+    return finish(identical);
+}
@@ -0,0 +1,147 @@
+// CX^VÕx`}[N
+//
+// 10 CX^X InstanceBatcher ŏW߂ċl߂܂ł CPU Ԃ𑪂
+// GPU gȂ̂ Linux łB`R[̓ob`ƓɂȂ
+// ŋl߂ʂ 1 XbhƓƁAob`pCvCEbVɌԂȂсA
+// eCX^X̃ob`ɒǉœ邱Ƃm߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -pthread -I.. instancing_benchmark.cpp ../instance_batcher.cpp ../job_system.cpp ../pipeline_state_desc.cpp -o instancing_benchmark
+// s:
+//   tools/instancing_benchmark [CX^X] [pCvC] [bV] [t[]
+
+#include "bench_common.h"
+#include "instance_batcher.h"
+#include "job_system.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// 1 t[̌vʁi}CNbj
+struct FrameTime {
+    double gather;  ///< add
+    double build;   ///< build
+    double pack;    ///< pack
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	oߎԂ}CNbŋ߂
+ * @param	begin	Jn
+ * @param	end		I
+ * @return	}CNb
+ */
+double microseconds(Clock::time_point begin, Clock::time_point end) {
+    return std::chrono::duration<double, std::micro>(end - begin).count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t instanceCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100000;
+    const uint32_t pipelineCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 8;
+    const uint32_t meshCount     = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 16;
+    const uint32_t frameCount    = argc > 4 ? static_cast<uint32_t>(std::atoi(argv[4])) : 30;
+
+    // V[̃IuWFNgipCvCƃbV͂΂΂̏ŕłzj
+    struct Object {
+        uint64_t     pipeline;
+        uint32_t     mesh;
+        InstanceData data;
+    };
+    std::vector<Object> objects(instanceCount);
+    std::mt19937        random(1234);
+    for (uint32_t i = 0; i < instanceCount; ++i) {
+        auto& object    = objects[i];
+        object.pipeline = 0x1000 + random() % pipelineCount;
+        object.mesh     = random() % meshCount;
+        object.data     = { { { 1, 0, 0, float(i) }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 } }, { 1, 1, 1, 1 }, i };
+    }
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+
+    InstanceBatcher                     batcher;
+    std::vector<InstanceBatcher::Batch> batches;
+    std::vector<InstanceData>           serial(instanceCount);
+    std::vector<InstanceData> parallel(instanceCount);
+
+    for (const bool useJobs : { false, true }) {
+        auto&                  destination = useJobs ? parallel : serial;
+        std::vector<FrameTime> times;
+        size_t                 batchCount = 0;
+
+        for (uint32_t frame = 0; frame < frameCount; ++frame) {
+            const auto t0 = Clock::now();
+            batcher.clear();
+            for (const auto& object : objects) {
+                batcher.add(object.pipeline, object.mesh, object.data);
+            }
+            const auto  t1    = Clock::now();
+            const auto& built = batcher.build();
+            const auto  t2    = Clock::now();
+            batcher.pack(destination.data(), useJobs ? &jobSystem : nullptr);
+            const auto  t3    = Clock::now();
+
+            batchCount = built.size();
+            batches = built;
+            times.push_back({ microseconds(t0, t1), microseconds(t1, t2), microseconds(t2, t3) });
+        }
+
+        // ̓mۂ܂ނ̂ŒlŔׂ
+        const auto medianOf = [&times](double FrameTime::*member) {
+            std::vector<double> values;
+            for (const auto& time : times) {
+                values.push_back(time.*member);
+            }
+            return median(std::move(values));
+        };
+        const double gather = medianOf(&FrameTime::gather);
+        const double build  = medianOf(&FrameTime::build);
+        const double pack   = medianOf(&FrameTime::pack);
+        std::printf("%-8s instances %u, draws %zu (vs %u without instancing): gather %.1f us, build %.1f us, pack %.1f us, total %.1f us (%.1f ns/instance)\n",
+                    useJobs ? "parallel" : "serial", instanceCount, batchCount, instanceCount, gather, build, pack, gather + build + pack,
+                    (gather + build + pack) * 1000.0 / std::max(1u, instanceCount));
+    }
+
+    std::printf("%u workers\n\n", jobSystem.workerCount() + 1);
+
+    // ŋl߂Ăʂ͓ł邱
+    bool passed = true;
+    passed = check(std::memcmp(serial.data(), parallel.data(), serial.size() * sizeof(InstanceData)) == 0, "parallel pack matches serial pack") &&
+             passed;
+
+    // ob`̓pCvCEbVɌԂȂсAL[Ƃ 1 B
+    // CX^X materialIndex ͒ǉ̔ԍȂ̂ŁAob`̒őĂΒǉɓĂ
+    std::vector<bool> seen(size_t(pipelineCount) * meshCount, false);
+    bool              layout = true;
+    uint32_t          next = 0;
+    for (size_t b = 0; layout && b < batches.size(); ++b) {
+        const auto&    batch = batches[b];
+        const uint32_t key = uint32_t(batch.pipeline - 0x1000) * meshCount + batch.mesh;
+        layout = batch.firstInstance == next && batch.instanceCount > 0 && key < seen.size() && !seen[key];
+        if (layout && b > 0) {
+            const auto& previous = batches[b - 1];
+            layout = previous.pipeline < batch.pipeline || (previous.pipeline == batch.pipeline && previous.mesh < batch.mesh);
+        }
+        for (uint32_t i = 0; layout && i < batch.instanceCount; ++i) {
+            const uint32_t object = serial[batch.firstInstance + i].materialIndex;
+            layout = object < instanceCount && objects[object].pipeline == batch.pipeline && objects[object].mesh == batch.mesh &&
+                     (i == 0 || object > serial[batch.firstInstance + i - 1].materialIndex);
+        }
+        if (layout) {
+            seen[key] = true;
+            next += batch.instanceCount;
+        }
+    }
+    passed = check(layout && next == instanceCount, "batches cover every instance once, grouped by pipeline and mesh") && passed;
+    return finish(passed);
+}
@@ -0,0 +1,174 @@
+// NX^CeBÕCg蓖Ẵx`}[N
+//
+// CgɗŕׁA߃ZbgiXJ[ / SSE / AVX2jƒȆgݍ킹Ƃ
+// LightClusterBuilder::build ̎Ԃ𑪂BSĂ̑gݍ킹őiassignLightsReferencej
+// ͈͂ƃCgԍɂȂ邱ƁAeʂ𒴂ꍇ؂l߂邱ƁA
+// sNZ findCluster ňNX^ɂ̃sNZ֓͂SCgĂ邱Ƃm߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -mavx2 -pthread -I.. light_cluster_benchmark.cpp ../light_clusters.cpp ../frustum_culling.cpp ../indirect_cull.cpp ../job_system.cpp ../projection.cpp -o light_cluster_benchmark
+// s:
+//   tools/light_cluster_benchmark [t[]
+
+#include "bench_common.h"
+#include "job_system.h"
+#include "light_clusters.h"
+#include "projection.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Cgɗŕׂ
+ * @param	count		Cg
+ * @param	projection	ˉes
+ * @param	maxZ		s̍ő
+ * @param	random		
+ * @return	Cg
+ */
+std::vector<ClusterLight> makeLights(uint32_t count, const float projection[4][4], float maxZ, std::mt19937& random) {
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+    std::uniform_real_distribution<float> radius(0.5f, 8.0f);
+    std::vector<ClusterLight>             lights(count);
+    for (auto& light : lights) {
+        // s͎OɊ񂹂i߂̃NX^قǏ̂Ōj
+        const float z = 0.5f + maxZ * depth(random) * depth(random);
+        light.position[0] = unit(random) * z / projection[0][0];
+        light.position[1] = unit(random) * z / projection[1][1];
+        light.position[2] = z;
+        light.radius = radius(random);
+        light.color[0] = light.color[1] = light.color[2] = 1.0f;
+        light.intensity = 1.0f;
+    }
+    return lights;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	蓖Ă̌ʂׂ
+ */
+bool isSameAssignment(const std::vector<ClusterRange>& rangesA, const std::vector<uint32_t>& indicesA, const std::vector<ClusterRange>& rangesB,
+                      const std::vector<uint32_t>& indicesB, uint32_t indexCount) {
+    for (size_t i = 0; i < rangesA.size(); ++i) {
+        if (rangesA[i].offset != rangesB[i].offset || rangesA[i].count != rangesB[i].count) {
+            return false;
+        }
+    }
+    return std::equal(indicesA.begin(), indicesA.begin() + indexCount, indicesB.begin());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t frameCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 20;
+
+    // c 60 xA16:9Areverse-Z ̃JBNX^ 16 x 9 x 24As 0.1 ` 200
+    const uint32_t viewportWidth = 1920;
+    const uint32_t viewportHeight = 1080;
+    const float    nearZ = 0.1f;
+    const float    farZ = 200.0f;
+    float          projection[4][4];
+    makePerspectiveProjection(projection, 1.0471976f, float(viewportWidth) / float(viewportHeight), nearZ, farZ, true);
+    const ClusterGrid          grid = makeClusterGrid(projection, nearZ, farZ);
+    std::vector<ClusterBounds> bounds(grid.clusterCount());
+    computeClusterBounds(grid, bounds.data());
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+    std::printf("clusters %u (%ux%ux%u), workers %u\n", grid.clusterCount(), grid.tilesX, grid.tilesY, grid.slices, jobSystem.workerCount());
+
+    const char* const simdNames[] = { "scalar", "sse", "avx2" };
+    std::mt19937      random(42);
+    bool              passed = true;
+
+    for (const uint32_t lightCount : { 256u, 1024u, 4096u }) {
+        const auto lights = makeLights(lightCount, projection, farZ * 0.5f, random);
+
+        // ̌ʁieʂ͏\Ɏj
+        const uint32_t            capacity = grid.clusterCount() * lightCount;
+        std::vector<ClusterRange> referenceRanges(grid.clusterCount());
+        std::vector<uint32_t>     referenceIndices(capacity);
+        const auto                referenceBegin = Clock::now();
+        const uint32_t total = assignLightsReference(grid, bounds.data(), lights.data(), lightCount, capacity, referenceRanges.data(), referenceIndices.data());
+        const double              referenceTime = milliseconds(referenceBegin, Clock::now());
+        std::printf("\nlights %u: %u indices (%.1f per cluster), reference %.2f ms\n", lightCount, total, double(total) / grid.clusterCount(),
+                    referenceTime);
+
+        LightClusterBuilder builder;
+        for (int simd = 0; simd <= int(bestCullSimd()); ++simd) {
+            for (const bool parallel : { false, true }) {
+                JobSystem* const    jobs = parallel ? &jobSystem : nullptr;
+                std::vector<double> times;
+                for (uint32_t frame = 0; frame < frameCount; ++frame) {
+                    const auto begin = Clock::now();
+                    const uint32_t result = builder.build(grid, bounds.data(), lights.data(), lightCount, capacity, jobs, CullSimd(simd));
+                    times.push_back(milliseconds(begin, Clock::now()));
+                    if (result != total) {
+                        passed = false;
+                    }
+                }
+                const bool same = builder.indices().size() == total &&
+                                  isSameAssignment(builder.ranges(), builder.indices(), referenceRanges, referenceIndices, total);
+                passed = passed && same;
+                std::printf("  %-6s %-8s %8.3f ms  %s\n", simdNames[simd], parallel ? "parallel" : "serial", median(times), same ? "ok" : "MISMATCH");
+            }
+        }
+
+        // eʂ𒴂ꍇƓʒuŐ؂l߂
+        const uint32_t            smallCapacity = total / 3;
+        std::vector<ClusterRange> clampedRanges(grid.clusterCount());
+        std::vector<uint32_t>     clampedIndices(smallCapacity);
+        assignLightsReference(grid, bounds.data(), lights.data(), lightCount, smallCapacity, clampedRanges.data(), clampedIndices.data());
+        const uint32_t clampedTotal = builder.build(grid, bounds.data(), lights.data(), lightCount, smallCapacity, &jobSystem);
+        const bool     clamped = clampedTotal == total && builder.indices().size() == smallCapacity &&
+                             isSameAssignment(builder.ranges(), builder.indices(), clampedRanges, clampedIndices, smallCapacity);
+        passed = passed && clamped;
+        std::printf("  capacity %u of %u: %s\n", smallCapacity, total, clamped ? "ok" : "MISMATCH");
+
+        // sNZNX^ɁÃsNZ֓͂SCgĂ邩
+        builder.build(grid, bounds.data(), lights.data(), lightCount, capacity, &jobSystem);
+        const ClusterShadingConstants         constants = makeClusterShadingConstants(grid, projection, viewportWidth, viewportHeight, lightCount);
+        std::uniform_real_distribution<float> pixelX(0.0f, float(viewportWidth));
+        std::uniform_real_distribution<float> pixelY(0.0f, float(viewportHeight));
+        std::uniform_real_distribution<float> depth(0.0f, 1.0f);
+        uint32_t                              missing = 0;
+        uint64_t                              reached = 0;
+        for (uint32_t sample = 0; sample < 20000; ++sample) {
+            const float px = pixelX(random);
+            const float py = pixelY(random);
+            const float z = nearZ + (farZ * 0.5f) * depth(random) * depth(random);
+            const float view[3] = {
+                (px / float(viewportWidth) * 2.0f - 1.0f) * z / projection[0][0],
+                (1.0f - py / float(viewportHeight) * 2.0f) * z / projection[1][1],
+                z,
+            };
+            const auto& range = builder.ranges()[findCluster(constants, px, py, z)];
+            const auto  first = builder.indices().begin() + range.offset;
+            for (uint32_t i = 0; i < lightCount; ++i) {
+                const float dx = view[0] - lights[i].position[0];
+                const float dy = view[1] - lights[i].position[1];
+                const float dz = view[2] - lights[i].position[2];
+                // E̊ۂߌ덷͌ 0 ɂȂ鉏Ȃ̂ŁAa 0.1% Ŕ肷
+                if (std::sqrt(dx * dx + dy * dy + dz * dz) < lights[i].radius * 0.999f) {
+                    ++reached;
+                    if (!std::binary_search(first, first + range.count, i)) {
+                        ++missing;
+                    }
+                }
+            }
+        }
+        passed = passed && missing == 0;
+        std::printf("  pixel lookup: %llu light hits, %u missing\n", static_cast<unsigned long long>(reached), missing);
+    }
+
+    return finish(passed);
+}
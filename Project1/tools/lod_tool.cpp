@@ -0,0 +1,473 @@
+// LOD `F[̐c[
+//
+// bViOBJAw肪ΐpڕt̋Ɖ̊Jn`j LOD `F[A
+// iƂ̎Op`Eς덷Ě덷i̒_ LOD ̎Op`܂ł̍ő勗j\
+// ʂm߂e:
+//   - CfbNX͈͓ŁAԂꂽOp`
+//   - bVɌipڂ̊jJAJ̐Ȃ
+//   - 덷iiނقǑ傫
+//   - ot@Cǂݖ߂ƓɂȂ邱
+//  LOD IAJEڂŗh炷EoCAXς 3 ʂŊm߁A
+// ̃CX^X̑IԂ𑪂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -pthread -I.. lod_tool.cpp ../mesh.cpp ../mesh_simplifier.cpp ../lod_selection.cpp ../job_system.cpp -o lod_tool
+// s:
+//   tools/lod_tool [.obj o.mesh]
+
+#include "bench_common.h"
+#include "job_system.h"
+#include "lod_selection.h"
+#include "mesh.h"
+#include "mesh_simplifier.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+constexpr float Pi = 3.14159265358979f;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	łڂ̋iox 0  1 ̒_ UV Ⴄ̂ŕʂ̒_ɂj
+ */
+Mesh makeSphere(uint32_t rings, uint32_t segments) {
+    Mesh mesh;
+    for (uint32_t ring = 0; ring <= rings; ++ring) {
+        const float v = float(ring) / float(rings);
+        const float theta = v * Pi;
+        for (uint32_t segment = 0; segment <= segments; ++segment) {
+            const float u = float(segment) / float(segments);
+            const float phi = u * 2.0f * Pi;
+            const float n[3] = {std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+            const float r = 1.0f + 0.04f * std::sin(theta * 6.0f) * std::sin(phi * 5.0f);
+            MeshVertex vertex{};
+            for (int axis = 0; axis < 3; ++axis) {
+                vertex.position[axis] = n[axis] * r;
+                vertex.normal[axis] = n[axis];
+            }
+            // ɂƌox 0 ̈ʒu낦Aʒu̒_ƂĈ悤ɂ
+            if (ring == 0 || ring == rings) {
+                vertex.position[0] = vertex.position[2] = 0.0f;
+                vertex.position[1] = ring == 0 ? 1.0f : -1.0f;
+            }
+            if (segment == segments) {
+                std::memcpy(vertex.position, mesh.vertices[ring * (segments + 1)].position, sizeof(vertex.position));
+            }
+            vertex.uv[0] = u;
+            vertex.uv[1] = v;
+            mesh.vertices.push_back(vertex);
+        }
+    }
+    for (uint32_t ring = 0; ring < rings; ++ring) {
+        for (uint32_t segment = 0; segment < segments; ++segment) {
+            const uint32_t a = ring * (segments + 1) + segment;
+            const uint32_t b = a + segments + 1;
+            if (ring != 0) {
+                mesh.indices.insert(mesh.indices.end(), {a, a + 1, b});
+            }
+            if (ring != rings - 1) {
+                mesh.indices.insert(mesh.indices.end(), {a + 1, b + 1, b});
+            }
+        }
+    }
+    computeMeshBounds(mesh);
+    return mesh;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̊Jn`
+ */
+Mesh makeTerrain(uint32_t size) {
+    Mesh mesh;
+    const auto height = [](float x, float z) { return 0.15f * std::sin(x * 3.0f) * std::cos(z * 2.0f) + 0.05f * std::sin(x * 11.0f + z * 7.0f); };
+    for (uint32_t row = 0; row <= size; ++row) {
+        for (uint32_t column = 0; column <= size; ++column) {
+            const float x = float(column) / float(size) * 2.0f - 1.0f;
+            const float z = float(row) / float(size) * 2.0f - 1.0f;
+            const float e = 1.0e-3f;
+            const float dx = (height(x + e, z) - height(x - e, z)) / (2.0f * e);
+            const float dz = (height(x, z + e) - height(x, z - e)) / (2.0f * e);
+            const float length = std::sqrt(dx * dx + 1.0f + dz * dz);
+            MeshVertex  vertex{{x, height(x, z), z}, {-dx / length, 1.0f / length, -dz / length}, {x * 0.5f + 0.5f, z * 0.5f + 0.5f}};
+            mesh.vertices.push_back(vertex);
+        }
+    }
+    for (uint32_t row = 0; row < size; ++row) {
+        for (uint32_t column = 0; column < size; ++column) {
+            const uint32_t a = row * (size + 1) + column;
+            const uint32_t b = a + size + 1;
+            mesh.indices.insert(mesh.indices.end(), {a, b, a + 1, a + 1, b, b + 1});
+        }
+    }
+    computeMeshBounds(mesh);
+    return mesh;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	OBJ ǂށiv / vt / vn / f ̂݁Bp`͐`ɕj
+ */
+bool loadObj(const std::string& path, Mesh& mesh) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+    std::vector<float>                                      positions;
+    std::vector<float>                                      uvs;
+    std::vector<float>                                      normals;
+    std::map<std::tuple<int, int, int>, uint32_t>           vertexOf;
+    std::string                                             line;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        std::string        type;
+        stream >> type;
+        if (type == "v" || type == "vn") {
+            float x = 0.0f;
+            float y = 0.0f;
+            float z = 0.0f;
+            stream >> x >> y >> z;
+            auto& list = type == "v" ? positions : normals;
+            list.insert(list.end(), {x, y, z});
+        } else if (type == "vt") {
+            float u = 0.0f;
+            float v = 0.0f;
+            stream >> u >> v;
+            uvs.insert(uvs.end(), {u, v});
+        } else if (type == "f") {
+            std::vector<uint32_t> face;
+            std::string           corner;
+            while (stream >> corner) {
+                int p = 0;
+                int t = 0;
+                int n = 0;
+                if (std::sscanf(corner.c_str(), "%d/%d/%d", &p, &t, &n) != 3 && std::sscanf(corner.c_str(), "%d//%d", &p, &n) != 2 &&
+                    std::sscanf(corner.c_str(), "%d/%d", &p, &t) != 2) {
+                    std::sscanf(corner.c_str(), "%d", &p);
+                }
+                const auto key = std::make_tuple(p, t, n);
+                auto       found = vertexOf.find(key);
+                if (found == vertexOf.end()) {
+                    MeshVertex vertex{};
+                    if (p > 0 && size_t(p) * 3 <= positions.size()) {
+                        std::memcpy(vertex.position, &positions[(p - 1) * 3], sizeof(vertex.position));
+                    }
+                    if (n > 0 && size_t(n) * 3 <= normals.size()) {
+                        std::memcpy(vertex.normal, &normals[(n - 1) * 3], sizeof(vertex.normal));
+                    }
+                    if (t > 0 && size_t(t) * 2 <= uvs.size()) {
+                        std::memcpy(vertex.uv, &uvs[(t - 1) * 2], sizeof(vertex.uv));
+                    }
+                    found = vertexOf.emplace(key, static_cast<uint32_t>(mesh.vertices.size())).first;
+                    mesh.vertices.push_back(vertex);
+                }
+                face.push_back(found->second);
+            }
+            for (size_t i = 2; i < face.size(); ++i) {
+                mesh.indices.insert(mesh.indices.end(), {face[0], face[i - 1], face[i]});
+            }
+        }
+    }
+    computeMeshBounds(mesh);
+    return !mesh.indices.empty();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_ƎOp`̋̓
+ */
+float pointTriangleDistance2(const float* p, const float* a, const float* b, const float* c) {
+    const auto sub = [](const float* x, const float* y, float* r) {
+        r[0] = x[0] - y[0];
+        r[1] = x[1] - y[1];
+        r[2] = x[2] - y[2];
+    };
+    const auto dot = [](const float* x, const float* y) { return x[0] * y[0] + x[1] * y[1] + x[2] * y[2]; };
+    const auto closest = [&](float s, float t, const float* e0, const float* e1) {
+        float q[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            q[axis] = a[axis] + s * e0[axis] + t * e1[axis] - p[axis];
+        }
+        return dot(q, q);
+    };
+    float ab[3];
+    float ac[3];
+    float ap[3];
+    sub(b, a, ab);
+    sub(c, a, ac);
+    sub(p, a, ap);
+    const float d00 = dot(ab, ab);
+    const float d01 = dot(ab, ac);
+    const float d11 = dot(ac, ac);
+    const float d20 = dot(ap, ab);
+    const float d21 = dot(ap, ac);
+    const float denominator = d00 * d11 - d01 * d01;
+    if (denominator > 1.0e-20f) {
+        const float s = (d11 * d20 - d01 * d21) / denominator;
+        const float t = (d00 * d21 - d01 * d20) / denominator;
+        if (s >= 0.0f && t >= 0.0f && s + t <= 1.0f) {
+            return closest(s, t, ab, ac);
+        }
+    }
+    // ʂ̊OȂ 3 ӂ̂ł߂_
+    float      best = 1.0e30f;
+    const float* corners[3] = {a, b, c};
+    for (int edge = 0; edge < 3; ++edge) {
+        const float* e0 = corners[edge];
+        const float* e1 = corners[(edge + 1) % 3];
+        float        direction[3];
+        float        offset[3];
+        sub(e1, e0, direction);
+        sub(p, e0, offset);
+        const float length2 = dot(direction, direction);
+        const float t = length2 > 0.0f ? std::clamp(dot(offset, direction) / length2, 0.0f, 1.0f) : 0.0f;
+        float       q[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            q[axis] = e0[axis] + direction[axis] * t - p[axis];
+        }
+        best = std::min(best, dot(q, q));
+    }
+    return best;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̒_ԈāALOD ̎Op`܂ł̍ő勗𑪂
+ */
+float measureDeviation(const Mesh& mesh, const MeshLod& lod, uint32_t samples) {
+    const uint32_t step = std::max<uint32_t>(1, static_cast<uint32_t>(mesh.vertices.size()) / samples);
+    float          worst = 0.0f;
+    for (size_t v = 0; v < mesh.vertices.size(); v += step) {
+        float best = 1.0e30f;
+        for (uint32_t i = lod.firstIndex; i < lod.firstIndex + lod.indexCount; i += 3) {
+            best = std::min(best, pointTriangleDistance2(mesh.vertices[v].position, mesh.vertices[mesh.indices[i]].position,
+                                                         mesh.vertices[mesh.indices[i + 1]].position, mesh.vertices[mesh.indices[i + 2]].position));
+        }
+        worst = std::max(worst, best);
+    }
+    return std::sqrt(worst);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ʒuŌJ̐𐔂ipڂ̒_͓ʒuȂ瓯Ƃ݂Ȃj
+ */
+uint32_t countBorderEdges(const Mesh& mesh, const MeshLod& lod) {
+    std::map<std::tuple<float, float, float>, uint32_t> positionId;
+    const auto id = [&](uint32_t vertex) {
+        const auto& p = mesh.vertices[vertex].position;
+        return positionId.emplace(std::make_tuple(p[0], p[1], p[2]), static_cast<uint32_t>(positionId.size())).first->second;
+    };
+    std::map<std::pair<uint32_t, uint32_t>, uint32_t> uses;
+    for (uint32_t i = lod.firstIndex; i < lod.firstIndex + lod.indexCount; i += 3) {
+        for (int corner = 0; corner < 3; ++corner) {
+            const uint32_t a = id(mesh.indices[i + corner]);
+            const uint32_t b = id(mesh.indices[i + (corner + 1) % 3]);
+            ++uses[std::minmax(a, b)];
+        }
+    }
+    uint32_t border = 0;
+    for (const auto& [edge, count] : uses) {
+        border += count == 1 ? 1 : 0;
+    }
+    return border;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	LOD `F[ĕ\Aʂm߂
+ * @return	肪 true
+ */
+bool processMesh(const char* name, Mesh& mesh, const char* outputPath) {
+    std::printf("%s: %zu vertices, %zu triangles, radius %.3f\n", name, mesh.vertices.size(), mesh.indices.size() / 3, mesh.radius);
+
+    const auto begin = Clock::now();
+    generateLodChain(mesh);
+    const auto end = Clock::now();
+    std::printf("  chain built in %.1f ms\n", milliseconds(begin, end));
+
+    bool           ok = true;
+    const uint32_t baseBorder = countBorderEdges(mesh, mesh.lods[0]);
+    std::printf("  %-4s %10s %7s %12s %12s %8s\n", "lod", "triangles", "ratio", "error", "measured", "borders");
+    for (size_t l = 0; l < mesh.lods.size(); ++l) {
+        const auto&    lod = mesh.lods[l];
+        const float    measured = measureDeviation(mesh, lod, 1000);
+        const uint32_t border = countBorderEdges(mesh, lod);
+        std::printf("  %-4zu %10u %6.1f%% %12.6f %12.6f %8u\n", l, lod.indexCount / 3, 100.0 * lod.indexCount / mesh.lods[0].indexCount, lod.error,
+                    measured, border);
+
+        for (uint32_t i = lod.firstIndex; i < lod.firstIndex + lod.indexCount; i += 3) {
+            const uint32_t* t = &mesh.indices[i];
+            if (t[0] >= mesh.vertices.size() || t[1] >= mesh.vertices.size() || t[2] >= mesh.vertices.size() || t[0] == t[1] || t[1] == t[2] ||
+                t[0] == t[2]) {
+                std::printf("  lod %zu: invalid triangle at %u\n", l, i / 3);
+                ok = false;
+                break;
+            }
+        }
+        if ((baseBorder == 0 && border != 0) || border > baseBorder) {
+            std::printf("  lod %zu: border edges grew (crack)\n", l);
+            ok = false;
+        }
+        if (l > 0 && (lod.error < mesh.lods[l - 1].error || lod.indexCount >= mesh.lods[l - 1].indexCount)) {
+            std::printf("  lod %zu: not coarser than the previous lod\n", l);
+            ok = false;
+        }
+    }
+
+    Mesh loaded;
+    if (!saveMesh(outputPath, mesh) || !loadMesh(outputPath, loaded) || loaded.indices != mesh.indices || loaded.lods.size() != mesh.lods.size() ||
+        std::memcmp(loaded.vertices.data(), mesh.vertices.data(), mesh.vertices.size() * sizeof(MeshVertex)) != 0 ||
+        std::memcmp(loaded.lods.data(), mesh.lods.data(), mesh.lods.size() * sizeof(MeshLod)) != 0 || loaded.radius != mesh.radius) {
+        std::printf("  save / load round trip: MISMATCH\n");
+        ok = false;
+    } else {
+        std::printf("  save / load round trip: identical (%s)\n", outputPath);
+    }
+    return ok;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	LOD Im߂
+ * @return	肪 true
+ */
+bool testSelection(const Mesh& mesh, JobSystem& jobSystem) {
+    bool                 ok = true;
+    LodSelectionSettings settings{};
+    settings.projectionScale = lodProjectionScale(1080.0f, 60.0f * Pi / 180.0f);
+
+    // ƑeA߂ÂƍׂȂ邾ŁAtɂ͓Ȃ
+    std::printf("selection (1080p, 60 deg, threshold %.1f px, hysteresis %.0f%%)\n", settings.threshold, settings.hysteresis * 100.0f);
+    std::printf("  %10s %6s %12s\n", "distance", "lod", "error px");
+    uint32_t lod = InvalidLod;
+    uint32_t previous = 0;
+    for (float distance = 0.01f; distance < 5000.0f; distance *= 1.02f) {
+        lod = selectLod(mesh.lods.data(), static_cast<uint32_t>(mesh.lods.size()), distance, lod, settings);
+        if (lod < previous) {
+            std::printf("  moving away switched to a finer lod at %.2f\n", distance);
+            ok = false;
+        }
+        if (lod != previous || distance == 0.01f) {
+            std::printf("  %10.2f %6u %12.3f\n", distance, lod, mesh.lods[lod].error * settings.projectionScale / distance);
+        }
+        previous = lod;
+    }
+    for (float distance = 5000.0f; distance > 0.01f; distance /= 1.02f) {
+        const uint32_t next = selectLod(mesh.lods.data(), static_cast<uint32_t>(mesh.lods.size()), distance, lod, settings);
+        if (next > lod) {
+            std::printf("  approaching switched to a coarser lod at %.2f\n", distance);
+            ok = false;
+        }
+        lod = next;
+    }
+    if (lod != 0) {
+        std::printf("  close up did not return to lod 0\n");
+        ok = false;
+    }
+
+    // ؂ւ鋗̑O 2% ŗh炵Ƃ̐؂ւ
+    const float switchDistance = mesh.lods.size() > 1 ? mesh.lods[1].error * settings.projectionScale / settings.threshold : 1.0f;
+    for (const float hysteresis : {0.0f, settings.hysteresis}) {
+        LodSelectionSettings jitter = settings;
+        jitter.hysteresis = hysteresis;
+        uint32_t current = InvalidLod;
+        uint32_t switches = 0;
+        for (int frame = 0; frame < 1000; ++frame) {
+            const float    distance = switchDistance * (frame % 2 == 0 ? 0.98f : 1.02f);
+            const uint32_t next = selectLod(mesh.lods.data(), static_cast<uint32_t>(mesh.lods.size()), distance, current, jitter);
+            switches += current != InvalidLod && next != current ? 1 : 0;
+            current = next;
+        }
+        std::printf("  jitter around %.2f, hysteresis %3.0f%%: %u switches in 1000 frames\n", switchDistance, hysteresis * 100.0f, switches);
+        if (hysteresis > 0.0f && switches != 0) {
+            ok = false;
+        }
+    }
+
+    // oCAXŐ؂ւ鋗ς
+    for (const float bias : {-1.0f, 0.0f, 1.0f}) {
+        LodSelectionSettings biased = settings;
+        biased.bias = bias;
+        float firstSwitch = 0.0f;
+        for (float distance = 0.01f; distance < 5000.0f; distance *= 1.01f) {
+            if (selectLod(mesh.lods.data(), static_cast<uint32_t>(mesh.lods.size()), distance, InvalidLod, biased) != 0) {
+                firstSwitch = distance;
+                break;
+            }
+        }
+        std::printf("  bias %+.0f: leaves lod 0 at distance %.2f\n", bias, firstSwitch);
+    }
+
+    // ̃CX^X
+    const uint32_t                  instanceCount = 1000000;
+    std::vector<std::array<float, 4>> spheres(instanceCount);
+    std::mt19937                    random(1);
+    std::uniform_real_distribution<float> position(-2000.0f, 2000.0f);
+    for (auto& sphere : spheres) {
+        sphere = {position(random), 0.0f, position(random), mesh.radius};
+    }
+    const float camera[3] = {0.0f, 2.0f, 0.0f};
+    std::vector<uint32_t> serial(instanceCount, InvalidLod);
+    std::vector<uint32_t> parallel(instanceCount, InvalidLod);
+    for (const bool useJobs : {false, true}) {
+        auto&      selected = useJobs ? parallel : serial;
+        const auto begin = Clock::now();
+        selectLods(mesh.lods.data(), static_cast<uint32_t>(mesh.lods.size()), camera, reinterpret_cast<const float(*)[4]>(spheres.data()),
+                   instanceCount, selected.data(), settings, useJobs ? &jobSystem : nullptr);
+        const auto end = Clock::now();
+        std::vector<uint32_t> histogram(mesh.lods.size(), 0);
+        for (const auto l : selected) {
+            ++histogram[l];
+        }
+        std::printf("  %-8s %u instances in %.2f ms, per lod:", useJobs ? "parallel" : "serial", instanceCount, milliseconds(begin, end));
+        for (const auto count : histogram) {
+            std::printf(" %u", count);
+        }
+        std::printf("\n");
+    }
+    if (serial != parallel) {
+        std::printf("  serial / parallel: MISMATCH\n");
+        ok = false;
+    }
+    return ok;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        std::printf("job system creation failed\n");
+        return 1;
+    }
+
+    bool ok = true;
+    if (argc >= 3) {
+        Mesh mesh;
+        if (!loadObj(argv[1], mesh)) {
+            std::printf("failed to read %s\n", argv[1]);
+            return 1;
+        }
+        ok = processMesh(argv[1], mesh, argv[2]) && testSelection(mesh, jobSystem);
+    } else {
+        Mesh sphere = makeSphere(128, 256);
+        ok = processMesh("sphere", sphere, "sphere.mesh") && ok;
+        Mesh terrain = makeTerrain(200);
+        ok = processMesh("terrain", terrain, "terrain.mesh") && ok;
+        ok = testSelection(sphere, jobSystem) && ok;
+    }
+
+    return finish(ok);
+}
@@ -0,0 +1,274 @@
+// SIMD wCůmFƃx`}[N
+//
+// mF: s̐ρExNg̕ϊEtsENH[^jỈ]ƕԁElookAt / perspective 
+// double ŌvZfȎƔׂB܂Ƃ߂ĕϊ֐͖߃ZbgiXJ[ / SSE / AVX2jɂ炸A
+// 1 ̉ZqƂrbgPʂňv邱Ƃm߂Bconstexpr ō邱Ƃ̓RpCɊm߂
+// x`}[N: transformPoints / transformVectors / multiplyMatrices 𖽗߃ZbgƂɑ
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -mavx2 -I.. math_benchmark.cpp ../simd_math.cpp ../projection.cpp ../frustum_culling.cpp ../indirect_cull.cpp ../job_system.cpp -pthread -o math_benchmark
+// s:
+//   tools/math_benchmark [vf]
+
+#include "bench_common.h"
+#include "simd_math.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+// constexpr ō邱
+constexpr Mat4 ConstantMatrix = Mat4::translation({ 1.0f, 2.0f, 3.0f });
+static_assert(ConstantMatrix.m[0][3] == 1.0f && ConstantMatrix.m[3][3] == 1.0f, "translation  constexpr łȂ");
+static_assert(transpose(ConstantMatrix).m[3][2] == 3.0f, "transpose  constexpr łȂ");
+static_assert(dot(Vec3(1.0f, 2.0f, 3.0f), Vec3(4.0f, 5.0f, 6.0f)) == 32.0f, "dot  constexpr łȂ");
+static_assert(rotate(Quat::identity(), Vec3(1.0f, 2.0f, 3.0f)).y == 2.0f, "rotate  constexpr łȂ");
+
+/// 
+constexpr int Repeats = 7;
+
+/// 
+std::mt19937 random(12345);
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	-1 ` 1 ̗
+ */
+float randomFloat() {
+    return std::uniform_real_distribution<float>(-1.0f, 1.0f)(random);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̍s
+ */
+Mat4 randomMatrix() {
+    Mat4 m;
+    for (auto& row : m.m) {
+        for (auto& value : row) {
+            value = randomFloat();
+        }
+    }
+    return m;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̉]
+ */
+Quat randomRotation() {
+    return normalize(Quat{ randomFloat(), randomFloat(), randomFloat(), randomFloat() });
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	double ōs̐ς߂iQƎj
+ */
+void referenceMultiply(const Mat4& a, const Mat4& b, double out[4][4]) {
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            out[i][j] = 0.0;
+            for (int k = 0; k < 4; ++k) {
+                out[i][j] += double(a.m[i][k]) * b.m[k][j];
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	s񂪋߂
+ */
+bool isNear(const Mat4& a, const double b[4][4], double tolerance) {
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            if (std::fabs(a.m[i][j] - b[i][j]) > tolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	xNg߂
+ */
+bool isNear(const Vec3& a, const Vec3& b, float tolerance) {
+    return std::fabs(a.x - b.x) <= tolerance && std::fabs(a.y - b.y) <= tolerance && std::fabs(a.z - b.z) <= tolerance;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t count = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1 << 20;
+    std::printf("best simd %d\n", int(bestCullSimd()));
+    bool passed = true;
+
+    // s̐ςƃxNg̕ϊ double ̎QƎɋ߂
+    {
+        bool ok = true;
+        for (int n = 0; n < 1000; ++n) {
+            const Mat4 a = randomMatrix();
+            const Mat4 b = randomMatrix();
+            double     expected[4][4];
+            referenceMultiply(a, b, expected);
+            ok = ok && isNear(a * b, expected, 1.0e-5);
+
+            const Vec4 v{ randomFloat(), randomFloat(), randomFloat(), randomFloat() };
+            const Vec4 r = a * v;
+            const float values[4] = { r.x, r.y, r.z, r.w };
+            for (int i = 0; i < 4; ++i) {
+                const double e = double(a.m[i][0]) * v.x + double(a.m[i][1]) * v.y + double(a.m[i][2]) * v.z + double(a.m[i][3]) * v.w;
+                ok = ok && std::fabs(values[i] - e) < 1.0e-5;
+            }
+        }
+        passed = check(ok, "multiply / transform") && passed;
+    }
+
+    // ts|ƒPʍs
+    {
+        bool ok = true;
+        for (int n = 0; n < 1000; ++n) {
+            const Mat4 m = Mat4::trs({ randomFloat() * 10.0f, randomFloat(), randomFloat() }, randomRotation(),
+                                     { 0.5f + std::fabs(randomFloat()), 1.0f, 2.0f });
+            Mat4 inv;
+            ok = ok && inverse(m, inv);
+            const double identity[4][4] = { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } };
+            ok = ok && isNear(m * inv, identity, 1.0e-4);
+        }
+        Mat4 singular = Mat4::scale({ 1.0f, 0.0f, 1.0f });
+        Mat4 unchanged = Mat4::identity();
+        ok = ok && !inverse(singular, unchanged) && unchanged.m[1][1] == 1.0f;
+        passed = check(ok, "inverse") && passed;
+    }
+
+    // NH[^jỈ]͉]sƓŁAς͉]̍
+    {
+        bool ok = true;
+        for (int n = 0; n < 1000; ++n) {
+            const Quat a = randomRotation();
+            const Quat b = randomRotation();
+            const Vec3 v{ randomFloat(), randomFloat(), randomFloat() };
+            ok = ok && isNear(rotate(a, v), transformVector(Mat4::rotation(a), v), 1.0e-5f);
+            ok = ok && isNear(rotate(a * b, v), rotate(a, rotate(b, v)), 1.0e-5f);
+            ok = ok && isNear(rotate(conjugate(a), rotate(a, v)), v, 1.0e-5f);
+        }
+        // Y ܂ 90 x +X  -Z ցinŏォ猩Ďvj
+        const Quat quarter = Quat::axisAngle({ 0.0f, 1.0f, 0.0f }, 1.57079632679f);
+        ok = ok && isNear(rotate(quarter, { 1.0f, 0.0f, 0.0f }), { 0.0f, 0.0f, -1.0f }, 1.0e-6f);
+        passed = check(ok, "quaternion rotate") && passed;
+    }
+
+    // slerp ͒[_ʂApx
+    {
+        bool ok = true;
+        for (int n = 0; n < 1000; ++n) {
+            const Quat a = randomRotation();
+            const Quat b = randomRotation();
+            const Vec3 v{ 1.0f, 0.0f, 0.0f };
+            ok = ok && isNear(rotate(slerp(a, b, 0.0f), v), rotate(a, v), 1.0e-5f);
+            ok = ok && isNear(rotate(slerp(a, b, 1.0f), v), rotate(b, v), 1.0e-4f);
+            // a 璆_܂  _ b ܂ł̊px͓
+            const Quat  middle = slerp(a, b, 0.5f);
+            const float first = std::fabs(dot(a, middle));
+            const float second = std::fabs(dot(middle, b));
+            ok = ok && std::fabs(first - second) < 1.0e-4f;
+            ok = ok && std::fabs(dot(nlerp(a, b, 0.3f), nlerp(a, b, 0.3f)) - 1.0f) < 1.0e-5f;
+        }
+        passed = check(ok, "slerp / nlerp") && passed;
+    }
+
+    // lookAt Ŏ__A_ +Z ɗBperspective  makePerspectiveProjection Ɠ
+    {
+        const Vec3 eye{ 3.0f, 4.0f, -5.0f };
+        const Vec3 target{ 0.0f, 1.0f, 2.0f };
+        const Mat4 view = Mat4::lookAt(eye, target, { 0.0f, 1.0f, 0.0f });
+        bool       ok = isNear(transformPoint(view, eye), {}, 1.0e-5f);
+        const Vec3 t = transformPoint(view, target);
+        ok = ok && std::fabs(t.x) < 1.0e-5f && std::fabs(t.y) < 1.0e-5f && std::fabs(t.z - length(target - eye)) < 1.0e-5f;
+
+        const Mat4 projection = Mat4::perspective(1.0f, 16.0f / 9.0f, 0.1f, 100.0f, true);
+        // reverseZ Ȃ̂ŎO̖ʂ 1A̖ʂ 0
+        const Vec4 nearClip = projection * Vec4(0.0f, 0.0f, 0.1f, 1.0f);
+        const Vec4 farClip = projection * Vec4(0.0f, 0.0f, 100.0f, 1.0f);
+        ok = ok && std::fabs(nearClip.z / nearClip.w - 1.0f) < 1.0e-5f && std::fabs(farClip.z / farClip.w) < 1.0e-5f;
+        passed = check(ok, "lookAt / perspective") && passed;
+    }
+
+    // ܂Ƃ߂ĕϊ֐͖߃Zbgɂ炸AZqƃrbgPʂňv
+    std::vector<Vec3> points(count);
+    std::vector<Vec4> vectors(count);
+    std::vector<Mat4> left(count / 16);
+    std::vector<Mat4> right(count / 16);
+    for (uint32_t i = 0; i < count; ++i) {
+        points[i] = { randomFloat() * 100.0f, randomFloat() * 100.0f, randomFloat() * 100.0f };
+        vectors[i] = { randomFloat(), randomFloat(), randomFloat(), randomFloat() };
+    }
+    for (size_t i = 0; i < left.size(); ++i) {
+        left[i] = randomMatrix();
+        right[i] = randomMatrix();
+    }
+    const Mat4 viewProjection = Mat4::perspective(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f, true) *
+                                Mat4::lookAt({ 0.0f, 50.0f, -200.0f }, {}, { 0.0f, 1.0f, 0.0f });
+
+    std::vector<Vec4> expectedPoints(count);
+    std::vector<Vec4> expectedVectors(count);
+    std::vector<Mat4> expectedMatrices(left.size());
+    for (uint32_t i = 0; i < count; ++i) {
+        expectedPoints[i] = viewProjection * Vec4(points[i], 1.0f);
+        expectedVectors[i] = viewProjection * vectors[i];
+    }
+    for (size_t i = 0; i < left.size(); ++i) {
+        expectedMatrices[i] = left[i] * right[i];
+    }
+
+    const char* const simdNames[] = { "scalar", "sse", "avx2" };
+    std::vector<Vec4> outPoints(count);
+    std::vector<Vec4> outVectors(count);
+    std::vector<Mat4> outMatrices(left.size());
+    std::printf("\n%u points / vectors, %u matrices\n", count, uint32_t(left.size()));
+    std::printf("%-8s %16s %16s %16s\n", "simd", "points", "vectors", "matrices");
+    for (int s = 0; s <= int(bestCullSimd()); ++s) {
+        const auto          simd = static_cast<CullSimd>(s);
+        std::vector<double> pointTimes, vectorTimes, matrixTimes;
+        for (int r = 0; r < Repeats; ++r) {
+            auto begin = Clock::now();
+            transformPoints(viewProjection, points.data(), outPoints.data(), count, simd);
+            pointTimes.push_back(milliseconds(begin, Clock::now()));
+            begin = Clock::now();
+            transformVectors(viewProjection, vectors.data(), outVectors.data(), count, simd);
+            vectorTimes.push_back(milliseconds(begin, Clock::now()));
+            begin = Clock::now();
+            multiplyMatrices(left.data(), right.data(), outMatrices.data(), uint32_t(left.size()), simd);
+            matrixTimes.push_back(milliseconds(begin, Clock::now()));
+        }
+        const bool same = std::memcmp(outPoints.data(), expectedPoints.data(), sizeof(Vec4) * count) == 0 &&
+                          std::memcmp(outVectors.data(), expectedVectors.data(), sizeof(Vec4) * count) == 0 &&
+                          std::memcmp(outMatrices.data(), expectedMatrices.data(), sizeof(Mat4) * left.size()) == 0;
+        passed = passed && same;
+        const double pointMs = median(pointTimes);
+        const double vectorMs = median(vectorTimes);
+        const double matrixMs = median(matrixTimes);
+        std::printf("%-8s %7.3f ms %4.1fns %7.3f ms %4.1fns %7.3f ms %4.1fns  %s\n", simdNames[s], pointMs, pointMs * 1.0e6 / count, vectorMs,
+                    vectorMs * 1.0e6 / count, matrixMs, matrixMs * 1.0e6 / left.size(), same ? "bit-exact" : "MISMATCH");
+    }
+
+    // ݐ悪͂Ɠł悢
+    {
+        std::vector<Vec4> inPlace(vectors.begin(), vectors.begin() + 33);
+        std::vector<Mat4> matrices(left.begin(), left.begin() + 5);
+        transformVectors(viewProjection, inPlace.data(), inPlace.data(), 33);
+        multiplyMatrices(matrices.data(), right.data(), matrices.data(), 5);
+        const bool ok = std::memcmp(inPlace.data(), expectedVectors.data(), sizeof(Vec4) * 33) == 0 &&
+                        std::memcmp(matrices.data(), expectedMatrices.data(), sizeof(Mat4) * 5) == 0;
+        passed = check(ok, "\nin-place batch") && passed;
+    }
+
+    return finish(passed);
+}
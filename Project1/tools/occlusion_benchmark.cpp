@@ -0,0 +1,271 @@
+// \tgEFAIN[WJÕx`}[N
+//
+// 傫ȔiǁjIN[_[Ƃ OcclusionBuffer ɏ݁AɎU炵Ȕ𔻒肷
+// IN[_[݂̏Ɣ̎Ԃ𒼗EőA҂̌ʂv邱Ƃm߂
+// ܂AsNZƂ̐[xfpȃX^CUƔׂāABĂƔ肵
+// {ɉBĂ邱Ɓi肪ێIł邱Ɓjm߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -pthread -I.. occlusion_benchmark.cpp ../occlusion_buffer.cpp ../job_system.cpp -o occlusion_benchmark
+// s:
+//   tools/occlusion_benchmark [IuWFNg] [IN[_[] [] [c]
+
+#include "bench_common.h"
+#include "job_system.h"
+#include "occlusion_buffer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_ϊiclip = M * (p, 1)j
+ */
+void transformPoint(const float m[4][4], const float p[3], float clip[4]) {
+    for (int row = 0; row < 4; ++row) {
+        clip[row] = m[row][0] * p[0] + m[row][1] * p[1] + m[row][2] * p[2] + m[row][3];
+    }
+}
+
+/// sNZƂ̐[xfpȃX^CUiOcclusionBuffer Ɠ핢Kj
+class ReferenceRasterizer {
+public:
+    ReferenceRasterizer(uint32_t width, uint32_t height, const float (*viewProjection)[4])
+        : width_(width), height_(height), viewProjection_(viewProjection), depth_(size_t(width) * height, 1.0f) {}
+
+    void rasterize(const OccluderMesh& mesh) {
+        for (uint32_t t = 0; t < mesh.triangleCount; ++t) {
+            float x[3];
+            float y[3];
+            float z[3];
+            bool  clipped = false;
+            for (int v = 0; v < 3; ++v) {
+                float clip[4];
+                transformPoint(viewProjection_, &mesh.positions[mesh.indices[t * 3 + v] * 3], clip);
+                if (!(clip[3] > 0.0f) || clip[2] < 0.0f) {
+                    clipped = true;
+                    break;
+                }
+                x[v] = (clip[0] / clip[3] * 0.5f + 0.5f) * float(width_);
+                y[v] = (0.5f - clip[1] / clip[3] * 0.5f) * float(height_);
+                z[v] = clip[2] / clip[3];
+            }
+            const float area = clipped ? 0.0f : (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+            if (!(std::fabs(area) > 0.0f)) {
+                continue;
+            }
+            const float sign = area > 0.0f ? 1.0f : -1.0f;
+            float       edge[3][3];
+            for (int e = 0; e < 3; ++e) {
+                const int i = e;
+                const int j = (e + 1) % 3;
+                edge[e][0] = (y[i] - y[j]) * sign;
+                edge[e][1] = (x[j] - x[i]) * sign;
+                edge[e][2] = (x[i] * y[j] - x[j] * y[i]) * sign;
+            }
+            const float d0 = ((z[1] - z[0]) * (y[2] - y[0]) - (z[2] - z[0]) * (y[1] - y[0])) / area;
+            const float d1 = ((x[1] - x[0]) * (z[2] - z[0]) - (x[2] - x[0]) * (z[1] - z[0])) / area;
+            const float d2 = z[0] - d0 * x[0] - d1 * y[0];
+            const float zMin = std::min({ z[0], z[1], z[2] });
+            const float zMax = std::max({ z[0], z[1], z[2] });
+
+            for (uint32_t py = 0; py < height_; ++py) {
+                const float cy = float(py) + 0.5f;
+                float       left = -std::numeric_limits<float>::infinity();
+                float       right = std::numeric_limits<float>::infinity();
+                for (const auto& e : edge) {
+                    const float value = e[1] * cy + e[2];
+                    if (e[0] > 0.0f) {
+                        left = std::max(left, (0.0f - value) / e[0]);
+                    }
+                    else if (e[0] < 0.0f) {
+                        right = std::min(right, (0.0f - value) / e[0]);
+                    }
+                    else if (value < 0.0f) {
+                        left = std::numeric_limits<float>::infinity();
+                    }
+                }
+                for (uint32_t px = 0; px < width_; ++px) {
+                    const float cx = float(px) + 0.5f;
+                    if (cx >= left && cx <= right) {
+                        const float depth = std::clamp(d0 * cx + d1 * cy + d2, zMin, zMax);
+                        float&      stored = depth_[size_t(py) * width_ + px];
+                        stored = std::min(stored, depth);
+                    }
+                }
+            }
+        }
+    }
+
+    /// ̋`̑SsNZŁA̍łOOɉ true
+    bool isOccluded(const Aabb& bounds) const {
+        float minX = std::numeric_limits<float>::max();
+        float minY = std::numeric_limits<float>::max();
+        float maxX = -std::numeric_limits<float>::max();
+        float maxY = -std::numeric_limits<float>::max();
+        float zNear = std::numeric_limits<float>::max();
+        for (int corner = 0; corner < 8; ++corner) {
+            const float p[3] = { (corner & 1) ? bounds.max[0] : bounds.min[0], (corner & 2) ? bounds.max[1] : bounds.min[1],
+                                 (corner & 4) ? bounds.max[2] : bounds.min[2] };
+            float clip[4];
+            transformPoint(viewProjection_, p, clip);
+            if (!(clip[3] > 0.0f) || clip[2] < 0.0f) {
+                return false;
+            }
+            minX = std::min(minX, (clip[0] / clip[3] * 0.5f + 0.5f) * float(width_));
+            maxX = std::max(maxX, (clip[0] / clip[3] * 0.5f + 0.5f) * float(width_));
+            minY = std::min(minY, (0.5f - clip[1] / clip[3] * 0.5f) * float(height_));
+            maxY = std::max(maxY, (0.5f - clip[1] / clip[3] * 0.5f) * float(height_));
+            zNear = std::min(zNear, clip[2] / clip[3]);
+        }
+        const int32_t x0 = std::max(0, int32_t(std::max(std::floor(minX), -1.0f)));
+        const int32_t y0 = std::max(0, int32_t(std::max(std::floor(minY), -1.0f)));
+        const int32_t x1 = std::min(int32_t(width_) - 1, int32_t(std::min(std::ceil(maxX), float(width_))) - 1);
+        const int32_t y1 = std::min(int32_t(height_) - 1, int32_t(std::min(std::ceil(maxY), float(height_))) - 1);
+        for (int32_t y = y0; y <= y1; ++y) {
+            for (int32_t x = x0; x <= x1; ++x) {
+                if (!(depth_[size_t(y) * width_ + x] < zNear)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    uint32_t            width_;
+    uint32_t            height_;
+    const float (*viewProjection_)[4];
+    std::vector<float>  depth_;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t objectCount   = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 100000;
+    const uint32_t occluderCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 16;
+    const uint32_t width         = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 320;
+    const uint32_t height        = argc > 4 ? static_cast<uint32_t>(std::atoi(argv[4])) : 180;
+    const uint32_t frameCount    = 20;
+
+    // _ +Z eic 60 xA16:9Anear 0.1Afar 200j
+    const float f = 1.0f / 0.57735f;
+    const float aspect = float(width) / float(height);
+    const float nearZ = 0.1f;
+    const float farZ = 200.0f;
+    const float viewProjection[4][4] = {
+        { f / aspect, 0, 0, 0 },
+        { 0, f, 0, 0 },
+        { 0, 0, farZ / (farZ - nearZ), -nearZ * farZ / (farZ - nearZ) },
+        { 0, 0, 1, 0 },
+    };
+
+    std::mt19937                          random(7);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    // IN[_[: Oɕׂ傫Ȕi12 Op`j
+    static const uint32_t boxIndices[36] = {
+        0, 1, 3, 0, 3, 2, 4, 6, 7, 4, 7, 5, 0, 4, 5, 0, 5, 1, 2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3,
+    };
+    std::vector<float>        occluderPositions(size_t(occluderCount) * 8 * 3);
+    std::vector<OccluderMesh> occluders(occluderCount);
+    for (uint32_t i = 0; i < occluderCount; ++i) {
+        const float z = 8.0f + unit(random) * 12.0f;
+        const float cx = (unit(random) * 2.0f - 1.0f) * z * 0.8f;
+        const float cy = (unit(random) * 2.0f - 1.0f) * z * 0.4f;
+        const float halfSize[3] = { 1.5f + unit(random) * z * 0.3f, 1.5f + unit(random) * z * 0.3f, 0.5f };
+        float*      p = &occluderPositions[size_t(i) * 24];
+        for (int corner = 0; corner < 8; ++corner) {
+            p[corner * 3 + 0] = cx + ((corner & 1) ? halfSize[0] : -halfSize[0]);
+            p[corner * 3 + 1] = cy + ((corner & 2) ? halfSize[1] : -halfSize[1]);
+            p[corner * 3 + 2] = z + ((corner & 4) ? halfSize[2] : -halfSize[2]);
+        }
+        occluders[i] = { p, boxIndices, 12 };
+    }
+
+    // IuWFNg: ɎU炵Ȕ
+    std::vector<Aabb> objects(objectCount);
+    for (auto& box : objects) {
+        const float z = 10.0f + unit(random) * 150.0f;
+        const float cx = (unit(random) * 2.0f - 1.0f) * z * 0.9f;
+        const float cy = (unit(random) * 2.0f - 1.0f) * z * 0.5f;
+        const float size = 0.2f + unit(random) * 0.8f;
+        box = { { cx - size, cy - size, z - size }, { cx + size, cy + size, z + size } };
+    }
+    std::vector<uint32_t> candidates(objectCount);
+    for (uint32_t i = 0; i < objectCount; ++i) {
+        candidates[i] = i;
+    }
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+    OcclusionBuffer buffer;
+    if (!buffer.create(width, height)) {
+        return 1;
+    }
+    std::printf("buffer %ux%u (%ux%u tiles), occluders %u, objects %u, workers %u\n", width, height, buffer.tileCountX(),
+                buffer.tileCountY(), occluderCount, objectCount, jobSystem.workerCount());
+
+    std::vector<float>    depths[2];
+    std::vector<uint32_t> results[2];
+    for (const bool useJobs : { false, true }) {
+        JobSystem*          jobs = useJobs ? &jobSystem : nullptr;
+        std::vector<double> rasterTimes, testTimes;
+        std::vector<uint32_t>& visible = results[useJobs];
+        visible.resize(objectCount);
+        uint32_t visibleCount = 0;
+        for (uint32_t frame = 0; frame < frameCount; ++frame) {
+            const auto t0 = Clock::now();
+            buffer.beginFrame(viewProjection);
+            buffer.rasterize(occluders.data(), occluderCount, jobs);
+            const auto t1 = Clock::now();
+            visibleCount = buffer.filterVisible(objects.data(), candidates.data(), objectCount, visible.data(), jobs);
+            const auto t2 = Clock::now();
+            rasterTimes.push_back(milliseconds(t0, t1));
+            testTimes.push_back(milliseconds(t1, t2));
+        }
+        visible.resize(visibleCount);
+        depths[useJobs].resize(size_t(buffer.tileCountX()) * buffer.tileCountY());
+        buffer.tileDepths(depths[useJobs].data());
+
+        const double testTime = median(testTimes);
+        std::printf("%-8s rasterize %.3f ms, test %.3f ms (%.1f ns/object), visible %u / %u\n", useJobs ? "parallel" : "serial",
+                    median(rasterTimes), testTime, testTime * 1e6 / objectCount, visibleCount, objectCount);
+    }
+
+    bool ok = depths[0] == depths[1] && results[0] == results[1];
+    std::printf("serial / parallel: %s\n", ok ? "identical" : "MISMATCH");
+
+    // BĂƔ肵̂{ɉBĂ邩
+    ReferenceRasterizer reference(width, height, viewProjection);
+    for (const auto& occluder : occluders) {
+        reference.rasterize(occluder);
+    }
+    uint32_t culled = 0;
+    uint32_t wrong = 0;
+    uint32_t missed = 0;
+    size_t   next = 0;
+    for (uint32_t i = 0; i < objectCount; ++i) {
+        const bool visible = next < results[0].size() && results[0][next] == i;
+        next += visible ? 1 : 0;
+        const bool occluded = reference.isOccluded(objects[i]);
+        if (!visible) {
+            ++culled;
+            // ʊÔ͎̂QƑł͉BĂȂɂȂ̂ŏ
+            wrong += (!occluded && buffer.isVisible(objects[i])) ? 1 : 0;
+        }
+        else if (occluded) {
+            ++missed;
+        }
+    }
+    std::printf("culled %u, truly occluded but kept %u (conservative), wrongly culled %u\n", culled, missed, wrong);
+    return finish(ok && wrong == 0);
+}
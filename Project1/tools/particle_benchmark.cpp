@@ -0,0 +1,182 @@
+// p[eBNVXeiCPU Łj̃x`}[N
+//
+// G~b^oĒԂŎw萔̃p[eBNĂ悤ɂA
+// ߃ZbgiXJ[ / SSE / AVX2jƒȆgݍ킹Ƃ ParticleSystem::update 
+// writeInstances ̎Ԃ𑪂BSĂ̑gݍ킹Ŗt[̐ƍŌ̑SԂrbgPʂňv邱ƁA
+// spawn  update Ɠp[eBNoƁAeʂ𒴂̂Ă邱Ƃm߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -mavx2 -pthread -I.. particle_benchmark.cpp ../particle_system.cpp ../frustum_culling.cpp ../indirect_cull.cpp ../job_system.cpp -o particle_benchmark
+// s:
+//   tools/particle_benchmark [t[]
+
+#include "bench_common.h"
+#include "job_system.h"
+#include "particle_system.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/// 1 t[̕b
+constexpr float DeltaTime = 1.0f / 60.0f;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Ԃ count قǐĂp[eBNVXepӂ
+ * @param	system		pӂVXe
+ * @param	count		Ԃ̃p[eBN
+ * @param	capacity	őp[eBN
+ * @return	 true
+ */
+bool setup(ParticleSystem& system, uint32_t count, uint32_t capacity) {
+    if (!system.create(capacity)) {
+        return false;
+    }
+    ParticleForces forces;
+    forces.drag = 0.3f;
+    forces.wind[0] = 2.0f;
+    system.setForces(forces);
+
+    // ͕ 2 bȂ̂ŁA2 ̃G~b^ 1 b count / 2 o
+    ParticleEmitter fountain;
+    fountain.positionJitter = 0.1f;
+    fountain.velocity[1] = 8.0f;
+    fountain.velocityJitter = 2.0f;
+    fountain.rate = float(count) * 0.25f;
+    fountain.minLifetime = 1.0f;
+    fountain.maxLifetime = 3.0f;
+    system.addEmitter(fountain);
+
+    ParticleEmitter smoke = fountain;
+    smoke.position[0] = 5.0f;
+    smoke.velocity[1] = 1.0f;
+    smoke.look.startSize = 0.1f;
+    smoke.look.endSize = 0.5f;
+    system.addEmitter(smoke);
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Sp[eBN̏Ԃׂ
+ */
+bool isSameState(const ParticleSystem& a, const ParticleSystem& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.size(); ++i) {
+        const ParticleState sa = a.particle(i);
+        const ParticleState sb = b.particle(i);
+        if (std::memcmp(&sa, &sb, sizeof(ParticleState)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t measureFrames = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 30;
+    // ̍ői3 bj蒷񂵂ĒԂɂ
+    const uint32_t warmupFrames = 200;
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+    std::printf("workers %u, best simd %d\n", jobSystem.workerCount(), int(bestCullSimd()));
+
+    const char* const simdNames[] = { "scalar", "sse", "avx2" };
+    bool              passed = true;
+
+    // spawn  update Ɠp[eBN𓯂ɏo
+    {
+        ParticleSystem cpu;
+        ParticleSystem gpu;
+        if (!setup(cpu, 10000, 100000) || !setup(gpu, 10000, 100000)) {
+            return 1;
+        }
+        std::vector<ParticleState> spawned(cpu.capacity());
+        bool                       same = true;
+        for (uint32_t frame = 0; frame < 3; ++frame) {
+            // ZԂ͎ȂȂ̂ŁAupdate ŖɑꂽƔׂ
+            const uint32_t before = cpu.size();
+            cpu.update(DeltaTime);
+            const uint32_t count = gpu.spawn(DeltaTime, spawned.data(), uint32_t(spawned.size()));
+            same = same && count == cpu.size() - before;
+            for (uint32_t i = 0; same && i < count; ++i) {
+                const ParticleState state = cpu.particle(before + i);
+                same = std::memcmp(&state, &spawned[i], sizeof(ParticleState)) == 0;
+            }
+        }
+        passed = passed && same;
+        std::printf("spawn matches update: %s\n", same ? "ok" : "MISMATCH");
+    }
+
+    // eʂ𒴂͎̂Ă
+    {
+        ParticleSystem system;
+        if (!setup(system, 100000, 1000)) {
+            return 1;
+        }
+        bool clamped = true;
+        for (uint32_t frame = 0; frame < 10; ++frame) {
+            system.update(DeltaTime);
+            // 1 t[ڂ͂܂eʂɓ͂Ȃ
+            clamped = clamped && (frame == 0 || system.size() == system.capacity());
+        }
+        passed = passed && clamped;
+        std::printf("capacity clamp: %s\n", clamped ? "ok" : "MISMATCH");
+    }
+
+    for (const uint32_t count : { 1000000u, 4000000u }) {
+        const uint32_t capacity = count + count / 2;
+
+        // XJ[Ěʂɂ
+        ParticleSystem           reference;
+        std::vector<uint32_t>    referenceSizes;
+        if (!setup(reference, count, capacity)) {
+            return 1;
+        }
+        for (uint32_t frame = 0; frame < warmupFrames + measureFrames; ++frame) {
+            reference.update(DeltaTime, nullptr, CullSimd::Scalar);
+            referenceSizes.push_back(reference.size());
+        }
+        std::printf("\nparticles %u alive (capacity %u)\n", reference.size(), capacity);
+
+        std::vector<ParticleInstance> instances(capacity);
+        for (int simd = 0; simd <= int(bestCullSimd()); ++simd) {
+            for (const bool parallel : { false, true }) {
+                JobSystem* const    jobs = parallel ? &jobSystem : nullptr;
+                ParticleSystem      system;
+                std::vector<double> updateTimes;
+                std::vector<double> instanceTimes;
+                bool                same = setup(system, count, capacity);
+                for (uint32_t frame = 0; frame < warmupFrames + measureFrames; ++frame) {
+                    const auto begin = Clock::now();
+                    system.update(DeltaTime, jobs, CullSimd(simd));
+                    const auto updated = Clock::now();
+                    system.writeInstances(instances.data(), jobs);
+                    const auto written = Clock::now();
+                    if (frame >= warmupFrames) {
+                        updateTimes.push_back(milliseconds(begin, updated));
+                        instanceTimes.push_back(milliseconds(updated, written));
+                    }
+                    same = same && system.size() == referenceSizes[frame];
+                }
+                same = same && isSameState(system, reference);
+                passed = passed && same;
+                const double updateTime = median(updateTimes);
+                std::printf("  %-6s %-8s update %8.3f ms (%7.1f M/s)  instances %8.3f ms  %s\n", simdNames[simd], parallel ? "parallel" : "serial",
+                            updateTime, double(system.size()) / updateTime * 1e-3, median(instanceTimes), same ? "ok" : "MISMATCH");
+            }
+        }
+    }
+
+    return finish(passed);
+}
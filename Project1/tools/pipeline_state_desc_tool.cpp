@@ -0,0 +1,273 @@
+// pCvCXe[gLq̐KƃnbV̊mF
+//
+// ႤLqLqEnbVɂȂAʂ̕ςႢ͕ʂ̃nbVɂȂ邱Ƃm߂
+//   EAppendAligned ̃ItZbg̉iXbgƁAItZbǧɑꍇ܂ށjƃZ}eBNX̑啶
+//   E傫̕Ȃ` AppendAligned Ɏc
+//   EgȂ_[^[Qbǧ`̏AC / |Cgł̃JOƓhԂ̊l
+//   EfvXgȂꍇ̔rA[xvpXidepthOnlyjł̃sNZVF[_EuhE_[^[Qbg̏
+//   EnbViFNV-1a 64bitjm̒lƈvAeo̕ύXőSĕʂ̒lɂȂ邱
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -I.. pipeline_state_desc_tool.cpp ../pipeline_state_desc.cpp -o pipeline_state_desc_tool
+// s:
+//   tools/pipeline_state_desc_tool
+
+#include "bench_common.h"
+#include "pipeline_state_desc.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/// DXGI_FORMAT ̒l
+constexpr uint32_t FormatR32G32B32A32Float = 2;
+constexpr uint32_t FormatR32G32B32Float = 6;
+constexpr uint32_t FormatR32G32Float = 16;
+constexpr uint32_t FormatR8G8B8A8Unorm = 28;
+constexpr uint32_t FormatD32Float = 40;
+constexpr uint32_t FormatR16G16B16A16Float = 10;
+constexpr uint32_t FormatR8G8Unorm = 49;  // formatByteSize Ȃ`
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	mFɎg{̋LqiʒuƐF̒_ + CX^X̍sj
+ */
+PipelineStateDesc baseDesc() {
+    PipelineStateDesc desc;
+    desc.vertexShaderHash = 0x1111;
+    desc.pixelShaderHash = 0x2222;
+    desc.rootSignatureHash = 0x3333;
+    desc.inputLayout = {
+        { "POSITION", 0, FormatR32G32B32Float, 0, 0, false, 0 },
+        { "COLOR", 0, FormatR32G32B32A32Float, 0, 12, false, 0 },
+        { "INSTANCE", 0, FormatR32G32B32A32Float, 1, 0, true, 1 },
+        { "INSTANCE", 1, FormatR32G32B32A32Float, 1, 16, true, 1 },
+    };
+    desc.depth = DepthMode::ReadWrite;
+    desc.depthCompare = DepthCompare::Greater;
+    desc.renderTargetFormats[0] = FormatR8G8B8A8Unorm;
+    desc.depthStencilFormat = FormatD32Float;
+    return desc;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	2 ̋LqKēLqEnbVɂȂ邩
+ */
+bool sameAfterNormalize(const PipelineStateDesc& a, const PipelineStateDesc& b) {
+    return normalizePipelineStateDesc(a) == normalizePipelineStateDesc(b) && hashPipelineStateDesc(a) == hashPipelineStateDesc(b);
+}
+
+}  // namespace
+
+int main() {
+    bool passed = true;
+
+    // FNV-1a 64bit ̊m̒lipCvCCu̖OɎĝŁAsƂɕςĂ͂Ȃj
+    {
+        const bool ok = hashBytes(nullptr, 0) == 0xcbf29ce484222325ull && hashBytes("a", 1) == 0xaf63dc4c8601ec8cull &&
+                        hashBytes("foobar", 6) == 0x85944171f73967e8ull && hashBytes("bar", 3, hashBytes("foo", 3)) == hashBytes("foobar", 6);
+        passed = check(ok, "hashBytes matches FNV-1a 64 test vectors") && passed;
+    }
+
+    // AppendAligned ̓XbgƂɒO̗vf̌֋l߂
+    {
+        PipelineStateDesc appended = baseDesc();
+        for (auto& element : appended.inputLayout) {
+            element.alignedByteOffset = PipelineStateDesc::AppendAligned;
+        }
+        const PipelineStateDesc normalized = normalizePipelineStateDesc(appended);
+        const bool offsets = normalized.inputLayout[0].alignedByteOffset == 0 && normalized.inputLayout[1].alignedByteOffset == 12 &&
+                             normalized.inputLayout[2].alignedByteOffset == 0 && normalized.inputLayout[3].alignedByteOffset == 16;
+        passed = check(offsets, "AppendAligned resolves per input slot") && passed;
+        passed = check(sameAfterNormalize(appended, baseDesc()), "AppendAligned equals explicit offsets") && passed;
+
+        // ItZbǧ́A̗vf̏I肩瑱iXbg݂ɕł悢j
+        PipelineStateDesc mixed;
+        mixed.inputLayout = {
+            { "POSITION", 0, FormatR32G32B32Float, 0, 16, false, 0 },
+            { "INSTANCE", 0, FormatR32G32B32A32Float, 1, PipelineStateDesc::AppendAligned, true, 1 },
+            { "TEXCOORD", 0, FormatR32G32Float, 0, PipelineStateDesc::AppendAligned, false, 0 },
+            { "COLOR", 0, FormatR16G16B16A16Float, 0, PipelineStateDesc::AppendAligned, false, 0 },
+        };
+        const PipelineStateDesc mixedNormalized = normalizePipelineStateDesc(mixed);
+        const bool              mixedOffsets = mixedNormalized.inputLayout[0].alignedByteOffset == 16 && mixedNormalized.inputLayout[1].alignedByteOffset == 0 &&
+                                  mixedNormalized.inputLayout[2].alignedByteOffset == 28 && mixedNormalized.inputLayout[3].alignedByteOffset == 36;
+        passed = check(mixedOffsets, "AppendAligned continues after an explicit offset") && passed;
+
+        // 傫̕Ȃ` 0 ŏd˂AD3D12 ɉCiItZbg͂܂vZłj
+        PipelineStateDesc unknown;
+        unknown.inputLayout = {
+            { "POSITION", 0, FormatR32G32B32Float, 0, PipelineStateDesc::AppendAligned, false, 0 },
+            { "TEXCOORD", 0, FormatR8G8Unorm, 0, PipelineStateDesc::AppendAligned, false, 0 },
+            { "COLOR", 0, FormatR32G32B32A32Float, 0, PipelineStateDesc::AppendAligned, false, 0 },
+            { "NORMAL", 0, FormatR32G32B32Float, 0, 32, false, 0 },
+            { "TANGENT", 0, FormatR32G32B32Float, 0, PipelineStateDesc::AppendAligned, false, 0 },
+        };
+        const PipelineStateDesc unknownNormalized = normalizePipelineStateDesc(unknown);
+        const bool unknownOffsets = unknownNormalized.inputLayout[0].alignedByteOffset == 0 && unknownNormalized.inputLayout[1].alignedByteOffset == 12 &&
+                                    unknownNormalized.inputLayout[2].alignedByteOffset == PipelineStateDesc::AppendAligned &&
+                                    unknownNormalized.inputLayout[3].alignedByteOffset == 32 && unknownNormalized.inputLayout[4].alignedByteOffset == 44;
+        passed = check(unknownOffsets, "AppendAligned stays unresolved after an unknown format") && passed;
+    }
+
+    // Z}eBNX͑啶ʂȂ
+    {
+        PipelineStateDesc lower = baseDesc();
+        lower.inputLayout[0].semanticName = "position";
+        lower.inputLayout[1].semanticName = "Color";
+        const PipelineStateDesc normalized = normalizePipelineStateDesc(lower);
+        passed = check(normalized.inputLayout[0].semanticName == "POSITION" && normalized.inputLayout[1].semanticName == "COLOR",
+                       "semantic names are upper-cased") &&
+                 passed;
+        passed = check(sameAfterNormalize(lower, baseDesc()), "semantic name case does not change the hash") && passed;
+    }
+
+    // _Pʂ̗vf instanceStepRate ͎gȂ
+    {
+        PipelineStateDesc stepRate = baseDesc();
+        stepRate.inputLayout[0].instanceStepRate = 7;
+        passed = check(normalizePipelineStateDesc(stepRate).inputLayout[0].instanceStepRate == 0 && sameAfterNormalize(stepRate, baseDesc()),
+                       "per-vertex instanceStepRate is ignored") &&
+                 passed;
+    }
+
+    // gȂ_[^[Qbǧ`ƃTv 0
+    {
+        PipelineStateDesc unused = baseDesc();
+        unused.renderTargetFormats[3] = FormatR8G8B8A8Unorm;
+        unused.renderTargetFormats[7] = FormatR16G16B16A16Float;
+        const PipelineStateDesc normalized = normalizePipelineStateDesc(unused);
+        const bool cleared = std::all_of(normalized.renderTargetFormats + 1, normalized.renderTargetFormats + PipelineStateDesc::MaxRenderTargets,
+                                         [](uint32_t format) { return format == 0; }) &&
+                             normalized.renderTargetFormats[0] == FormatR8G8B8A8Unorm;
+        passed = check(cleared && sameAfterNormalize(unused, baseDesc()), "unused render target formats are cleared") && passed;
+
+        PipelineStateDesc tooMany = baseDesc();
+        tooMany.renderTargetCount = 100;
+        passed = check(normalizePipelineStateDesc(tooMany).renderTargetCount == PipelineStateDesc::MaxRenderTargets, "render target count is clamped") &&
+                 passed;
+
+        PipelineStateDesc zeroSamples = baseDesc();
+        zeroSamples.sampleCount = 0;
+        passed = check(sameAfterNormalize(zeroSamples, baseDesc()), "sample count 0 equals 1") && passed;
+    }
+
+    // C / |Cg͖ʂȂ̂ŁAJOƓhԂlɂiOp`͎cj
+    {
+        bool ok = true;
+        for (const PrimitiveTopology topology : { PrimitiveTopology::Line, PrimitiveTopology::Point }) {
+            PipelineStateDesc a = baseDesc();
+            a.topology = topology;
+            a.cull = CullMode::Front;
+            a.fill = FillMode::Wireframe;
+            PipelineStateDesc b = baseDesc();
+            b.topology = topology;
+            b.cull = CullMode::Back;
+            const PipelineStateDesc normalized = normalizePipelineStateDesc(a);
+            ok = ok && normalized.cull == CullMode::None && normalized.fill == FillMode::Solid && sameAfterNormalize(a, b);
+        }
+        PipelineStateDesc front = baseDesc();
+        front.cull = CullMode::Front;
+        ok = ok && normalizePipelineStateDesc(front).cull == CullMode::Front && !sameAfterNormalize(front, baseDesc());
+        passed = check(ok, "cull and fill reset for line and point topologies") && passed;
+    }
+
+    // fvXgȂΔr͌ʂɉeȂ
+    {
+        PipelineStateDesc a = baseDesc();
+        a.depth = DepthMode::Disabled;
+        a.depthCompare = DepthCompare::Always;
+        PipelineStateDesc b = baseDesc();
+        b.depth = DepthMode::Disabled;
+        b.depthCompare = DepthCompare::Less;
+        passed = check(normalizePipelineStateDesc(a).depthCompare == DepthCompare::LessEqual && sameAfterNormalize(a, b),
+                       "depth compare ignored when depth is disabled") &&
+                 passed;
+    }
+
+    // [xvpX̓sNZVF[_EuhE_[^[QbggȂ
+    {
+        PipelineStateDesc a = baseDesc();
+        a.depthOnly = true;
+        PipelineStateDesc b = baseDesc();
+        b.depthOnly = true;
+        b.pixelShaderHash = 0x9999;
+        b.blend = BlendMode::Additive;
+        b.renderTargetCount = 2;
+        b.renderTargetFormats[1] = FormatR16G16B16A16Float;
+        const PipelineStateDesc normalized = normalizePipelineStateDesc(b);
+        const bool cleared = normalized.pixelShaderHash == 0 && normalized.blend == BlendMode::Opaque && normalized.renderTargetCount == 0 &&
+                             std::all_of(std::begin(normalized.renderTargetFormats), std::end(normalized.renderTargetFormats),
+                                         [](uint32_t format) { return format == 0; });
+        passed = check(cleared && sameAfterNormalize(a, b), "depthOnly drops pixel shader, blend and targets") && passed;
+        passed = check(!sameAfterNormalize(a, baseDesc()), "depthOnly differs from the color pass") && passed;
+
+        // [x̐ݒ̓vpXłʂɉe
+        PipelineStateDesc c = a;
+        c.depthCompare = DepthCompare::GreaterEqual;
+        passed = check(!sameAfterNormalize(a, c), "depthOnly keeps depth settings") && passed;
+    }
+
+    // ʂςႢ͑Sĕʂ̃nbVɂȂ
+    {
+        std::vector<PipelineStateDesc> variants(1, baseDesc());
+        const auto vary = [&variants](auto change) {
+            PipelineStateDesc desc = baseDesc();
+            change(desc);
+            variants.push_back(desc);
+        };
+        vary([](PipelineStateDesc& d) { d.vertexShaderHash ^= 1; });
+        vary([](PipelineStateDesc& d) { d.pixelShaderHash ^= 1; });
+        vary([](PipelineStateDesc& d) { d.rootSignatureHash ^= 1; });
+        vary([](PipelineStateDesc& d) { d.inputLayout.pop_back(); });
+        vary([](PipelineStateDesc& d) { d.inputLayout[0].semanticName = "NORMAL"; });
+        vary([](PipelineStateDesc& d) { d.inputLayout[0].semanticIndex = 1; });
+        vary([](PipelineStateDesc& d) { d.inputLayout[1].format = FormatR8G8B8A8Unorm; });
+        vary([](PipelineStateDesc& d) { d.inputLayout[1].inputSlot = 2; });
+        vary([](PipelineStateDesc& d) { d.inputLayout[1].alignedByteOffset = 16; });
+        vary([](PipelineStateDesc& d) { d.inputLayout[2].perInstance = false; });
+        vary([](PipelineStateDesc& d) { d.inputLayout[2].instanceStepRate = 2; });
+        vary([](PipelineStateDesc& d) { std::swap(d.inputLayout[0], d.inputLayout[1]); });
+        vary([](PipelineStateDesc& d) { d.blend = BlendMode::Alpha; });
+        vary([](PipelineStateDesc& d) { d.blend = BlendMode::Premultiplied; });
+        vary([](PipelineStateDesc& d) { d.cull = CullMode::None; });
+        vary([](PipelineStateDesc& d) { d.fill = FillMode::Wireframe; });
+        vary([](PipelineStateDesc& d) { d.depth = DepthMode::ReadOnly; });
+        vary([](PipelineStateDesc& d) { d.depth = DepthMode::Disabled; });
+        vary([](PipelineStateDesc& d) { d.depthCompare = DepthCompare::GreaterEqual; });
+        vary([](PipelineStateDesc& d) { d.topology = PrimitiveTopology::Line; });
+        vary([](PipelineStateDesc& d) { d.renderTargetCount = 2; });
+        vary([](PipelineStateDesc& d) { d.renderTargetFormats[0] = FormatR16G16B16A16Float; });
+        vary([](PipelineStateDesc& d) { d.depthStencilFormat = 0; });
+        vary([](PipelineStateDesc& d) { d.sampleCount = 4; });
+
+        std::vector<uint64_t> hashes;
+        bool                  unequal = true;
+        for (size_t i = 0; i < variants.size(); ++i) {
+            hashes.push_back(hashPipelineStateDesc(variants[i]));
+            for (size_t j = 0; j < i; ++j) {
+                unequal = unequal && !(normalizePipelineStateDesc(variants[i]) == normalizePipelineStateDesc(variants[j]));
+            }
+        }
+        std::sort(hashes.begin(), hashes.end());
+        const bool distinct = std::adjacent_find(hashes.begin(), hashes.end()) == hashes.end();
+        std::printf("%zu variants, %zu distinct hashes\n", variants.size(), size_t(std::unique(hashes.begin(), hashes.end()) - hashes.begin()));
+        passed = check(distinct && unequal, "every changed member gives a different hash") && passed;
+    }
+
+    // nbV͋LqRs[ĂAKĂnbVĂ
+    {
+        const PipelineStateDesc desc = baseDesc();
+        const PipelineStateDesc copy = desc;
+        passed = check(hashPipelineStateDesc(desc) == hashPipelineStateDesc(copy) &&
+                           hashPipelineStateDesc(normalizePipelineStateDesc(desc)) == hashPipelineStateDesc(desc),
+                       "hash is stable under copy and re-normalization") &&
+                 passed;
+    }
+
+    return finish(passed);
+}
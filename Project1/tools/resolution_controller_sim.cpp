@@ -0,0 +1,196 @@
+// I𑜓x̐̃V~[V
+//
+// GPU  = 𑜓xɈ˂Ȃ + sNZ̎ * ʐ *  Ɍv̗h|A
+// k̕ύX latency t[xČvlɌ GPU ͂ ResolutionController 𓮂
+// ̏ʂŁA_̎ԂɎ܂邱ƁA㉺邱ƁAׂ̋}ς߂邱ƁAɗhȂƂm߂
+//   Ed:     {ł͗\Z𒴂  \ZɎ܂kŗ
+//   Ey:     {ł]  ɒt
+//   Ed: ł  ɒtA艺Ȃ
+//   E}:     rŕׂ 2 {ɂȂA܂߂  t[ŗ\Zɖ߂Aׂ߂Ή𑜓x߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -I.. resolution_controller_sim.cpp ../resolution_controller.cpp -o resolution_controller_sim
+// s:
+//   tools/resolution_controller_sim [\Z~b]
+
+#include "bench_common.h"
+#include "resolution_controller.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// ͋[ GPU
+struct GpuModel {
+    float fixedMilliseconds = 2.0f;  ///< 𑜓xɈ˂Ȃ
+    float pixelMilliseconds{};       ///< {̖ʐςɂ鎞
+    float noise = 0.04f;             ///< v̗hi΂̕W΍j
+};
+
+/// V~[V̌
+struct SimulationResult {
+    std::vector<float> scales;        ///< t[Ƃ̏k
+    std::vector<float> milliseconds;  ///< t[Ƃ GPU 
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	V~[V
+ * @param	settings	̐ݒ
+ * @param	gpu			͋[ GPU
+ * @param	frames		t[
+ * @param	load		t[ԍ畉ׂ̔{Ԃ֐
+ * @return	
+ */
+SimulationResult simulate(const ResolutionControllerSettings& settings, const GpuModel& gpu, uint32_t frames,
+                          const std::function<float(uint32_t)>& load) {
+    ResolutionController controller(settings);
+    std::mt19937         random(7);
+    std::normal_distribution<float> jitter(1.0f, gpu.noise);
+
+    // GPU  latency t[Ȍkŕ`Ă
+    std::deque<float> inFlight(settings.latency, controller.scale());
+    SimulationResult  result;
+    for (uint32_t frame = 0; frame < frames; ++frame) {
+        inFlight.push_back(controller.scale());
+        const float drawnScale = inFlight.front();
+        inFlight.pop_front();
+
+        const float area = drawnScale * drawnScale;
+        const float ms = (gpu.fixedMilliseconds + gpu.pixelMilliseconds * area * load(frame)) * std::max(jitter(random), 0.5f);
+        result.scales.push_back(drawnScale);
+        result.milliseconds.push_back(ms);
+        controller.update(ms);
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Ԃ̕
+ */
+float mean(const std::vector<float>& values, uint32_t begin, uint32_t end) {
+    double sum = 0.0;
+    for (uint32_t i = begin; i < end; ++i) {
+        sum += values[i];
+    }
+    return static_cast<float>(sum / (end - begin));
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Ԃ̕W΍
+ */
+float deviation(const std::vector<float>& values, uint32_t begin, uint32_t end) {
+    const float m = mean(values, begin, end);
+    double      sum = 0.0;
+    for (uint32_t i = begin; i < end; ++i) {
+        sum += (values[i] - m) * (values[i] - m);
+    }
+    return static_cast<float>(std::sqrt(sum / (end - begin)));
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Ԃŗ\Z𒴂t[̊
+ */
+float overBudget(const std::vector<float>& values, uint32_t begin, uint32_t end, float budget) {
+    uint32_t count = 0;
+    for (uint32_t i = begin; i < end; ++i) {
+        count += values[i] > budget ? 1 : 0;
+    }
+    return float(count) / float(end - begin);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    ResolutionControllerSettings settings;
+    if (argc > 1) {
+        settings.targetMilliseconds = static_cast<float>(std::atof(argv[1]));
+    }
+    if (!(settings.targetMilliseconds > 3.0f)) {
+        std::printf("budget must be larger than 3 ms\n");
+        return 1;
+    }
+    const float budget = settings.targetMilliseconds;
+    const float goal = budget * settings.headroom;
+    const auto  constant = [](uint32_t) { return 1.0f; };
+    bool        ok = true;
+    std::printf("budget %.2f ms, goal %.2f ms, scale %.2f..%.2f, latency %u frames\n", budget, goal, settings.minScale, settings.maxScale,
+                settings.latency);
+
+    // d: {ŗ\Z 1.45 {
+    {
+        GpuModel gpu;
+        gpu.pixelMilliseconds = budget * 1.45f - gpu.fixedMilliseconds;
+        const auto  r = simulate(settings, gpu, 600, constant);
+        const float expected = std::sqrt((goal - gpu.fixedMilliseconds) / gpu.pixelMilliseconds);
+        const float settled = mean(r.scales, 150, 600);
+        std::printf("heavy:     scale %.3f (ideal %.3f, sd %.4f), gpu %.2f ms, over budget %.1f%%\n", settled, expected,
+                    deviation(r.scales, 150, 600), mean(r.milliseconds, 150, 600), overBudget(r.milliseconds, 150, 600, budget) * 100.0f);
+        ok &= check(std::fabs(settled - expected) < 0.03f, "settles near the ideal scale");
+        ok &= check(std::fabs(mean(r.milliseconds, 150, 600) / goal - 1.0f) < 0.05f, "gpu time within 5% of the goal");
+        ok &= check(overBudget(r.milliseconds, 150, 600, budget) < 0.05f, "less than 5% of frames over budget");
+        ok &= check(deviation(r.scales, 150, 600) < 0.02f, "scale does not oscillate");
+    }
+
+    // y: {ŗ\Z̔
+    {
+        GpuModel gpu;
+        gpu.pixelMilliseconds = budget * 0.5f - gpu.fixedMilliseconds;
+        const auto r = simulate(settings, gpu, 300, constant);
+        std::printf("light:     scale %.3f..%.3f after frame 60\n", *std::min_element(r.scales.begin() + 60, r.scales.end()),
+                    *std::max_element(r.scales.begin() + 60, r.scales.end()));
+        ok &= check(*std::min_element(r.scales.begin() + 60, r.scales.end()) >= settings.maxScale - 1.0e-4f, "stays at the upper bound");
+    }
+
+    // d: ł\Z 1.3 {
+    {
+        GpuModel gpu;
+        gpu.pixelMilliseconds = (budget * 1.3f - gpu.fixedMilliseconds) / (settings.minScale * settings.minScale);
+        const auto r = simulate(settings, gpu, 300, constant);
+        const float lowest = *std::min_element(r.scales.begin(), r.scales.end());
+        std::printf("overload:  scale %.3f..%.3f after frame 30, lowest %.3f\n", *std::min_element(r.scales.begin() + 30, r.scales.end()),
+                    *std::max_element(r.scales.begin() + 30, r.scales.end()), lowest);
+        ok &= check(lowest >= settings.minScale - 1.0e-4f, "never goes below the lower bound");
+        ok &= check(*std::max_element(r.scales.begin() + 30, r.scales.end()) <= settings.minScale + 1.0e-4f, "stays at the lower bound");
+    }
+
+    // }: {ł傤Ǒ_̎  300 t[ڂ畉 2 {  600 t[ڂŌɖ߂
+    {
+        GpuModel gpu;
+        gpu.pixelMilliseconds = goal - gpu.fixedMilliseconds;
+        const auto r = simulate(settings, gpu, 900, [](uint32_t frame) { return frame >= 300 && frame < 600 ? 2.0f : 1.0f; });
+
+        uint32_t recovered = 300;
+        for (uint32_t i = 300; i < 600; ++i) {
+            if (r.milliseconds[i] > budget) {
+                recovered = i + 1;
+            }
+            if (i >= 330) {
+                break;
+            }
+        }
+        uint32_t restored = 900;
+        for (uint32_t i = 600; i < 900; ++i) {
+            if (r.scales[i] >= settings.maxScale * 0.97f) {
+                restored = i;
+                break;
+            }
+        }
+        std::printf("step:      %u frames over budget after the load doubles, scale %.3f under load, back to %.2f after %u frames\n",
+                    recovered - 300, mean(r.scales, 400, 600), settings.maxScale * 0.97f, restored - 600);
+        ok &= check(recovered - 300 <= settings.latency + 4, "back within budget a few frames after the load doubles");
+        ok &= check(overBudget(r.milliseconds, 330, 600, budget) < 0.05f, "stays within budget under the doubled load");
+        ok &= check(restored - 600 < 200, "resolution comes back after the load drops");
+    }
+
+    return finish(ok);
+}
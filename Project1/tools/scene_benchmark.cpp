@@ -0,0 +1,591 @@
+// V[t@C̊mFƃx`}[N
+//
+// mF: Ot̃GeBeBނ̃A[L^CvɍăV[t@CƓg JSON ɏoA
+// ǂ炩ǂ񂾃[h̃[hƃR|[lg̒lirbgPʁjEgݍ킹EOv邱Ƃm߂
+// ꂽt@Ci`ႤErŐ؂ĂEfix-up ̏ꏊw悪t@C̊Oj open eƂm߂
+// x`}[N: V[t@Cimmap  fix-up  `Nւ memcpyj JSONiǂݍ    GeBeBƂ̍쐬j̓ǂݍݎԂׂ
+// ǂ 2 ڈȍ~̓y[WLbVɍڂԂő
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -I.. scene_benchmark.cpp ../scene_file.cpp ../entity_world.cpp -o scene_benchmark
+// s:
+//   tools/scene_benchmark [GeBeB] [ƃfBNg]
+
+#include "bench_common.h"
+#include "entity_world.h"
+#include "scene_file.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// 
+constexpr int Repeats = 5;
+
+struct Position {
+    static constexpr const char* ComponentName = "Position";
+    float                        x, y, z;
+};
+struct Rotation {
+    static constexpr const char* ComponentName = "Rotation";
+    float                        x, y, z, w;
+};
+struct Velocity {
+    static constexpr const char* ComponentName = "Velocity";
+    float                        x, y, z;
+};
+struct Health {
+    static constexpr const char* ComponentName = "Health";
+    float                        value;
+    uint32_t                     team;
+};
+
+/// 
+std::mt19937 generator(12345);
+
+/// ̃[hiO̓GeBeBԍňj
+struct Scene {
+    EntityWorld              world;
+    std::vector<std::string> names;  ///< GeBeBԍƂ̖OiȂ疼Oj
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Q[̂悤ȑgݍ킹̃[h
+ * @details	4 ̃A[L^CvɕA3  1 ͖OAꕔ͓Oi\ł܂Ƃ܂jɂ
+ */
+void populate(Scene& scene, uint32_t count) {
+    std::uniform_real_distribution<float> value(-1000.0f, 1000.0f);
+    for (uint32_t i = 0; i < count; ++i) {
+        const Position position{ value(generator), value(generator), value(generator) };
+        const Rotation rotation{ value(generator), value(generator), value(generator), value(generator) };
+        const Velocity velocity{ value(generator), value(generator), value(generator) };
+        const Health   health{ value(generator), i % 4 };
+        Entity         entity;
+        switch (i % 4) {
+        case 0:
+            entity = scene.world.create(position, rotation);
+            break;
+        case 1:
+            entity = scene.world.create(position, rotation, velocity);
+            break;
+        case 2:
+            entity = scene.world.create(position, rotation, velocity, health);
+            break;
+        default:
+            entity = scene.world.create(health);
+            break;
+        }
+        if (scene.names.size() <= entity.index) {
+            scene.names.resize(entity.index + 1);
+        }
+        if (i % 3 != 0) {
+            scene.names[entity.index] = i % 5 == 0 ? "crate" : "entity_" + std::to_string(i);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	JSON ̕iO͉pȂ̂ŃGXP[v "  \ j
+ */
+void writeJsonString(std::string& out, const char* text) {
+    out.push_back('"');
+    for (; *text; ++text) {
+        if (*text == '"' || *text == '\\') {
+            out.push_back('\\');
+        }
+        out.push_back(*text);
+    }
+    out.push_back('"');
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	JSON ̐̔zifloat  %.9g Ō̒lɖ߂j
+ */
+void writeJsonFloats(std::string& out, const char* key, const float* values, uint32_t count) {
+    char text[32];
+    out += ",\"";
+    out += key;
+    out += "\":[";
+    for (uint32_t i = 0; i < count; ++i) {
+        std::snprintf(text, sizeof(text), i ? ",%.9g" : "%.9g", double(values[i]));
+        out += text;
+    }
+    out.push_back(']');
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	V[t@CƓg JSON ɏiGeBeB̕тɂj
+ */
+bool saveJson(const std::string& path, Scene& scene) {
+    std::vector<ChunkView> chunks;
+    scene.world.collectChunks(scene.world.createQuery(0), chunks);
+    std::string out = "{\"entities\":[\n";
+    bool        first = true;
+    for (const ChunkView& chunk : chunks) {
+        const Position* positions = chunk.get<Position>();
+        const Rotation* rotations = chunk.get<Rotation>();
+        const Velocity* velocities = chunk.get<Velocity>();
+        const Health*   healths = chunk.get<Health>();
+        for (uint32_t i = 0; i < chunk.size(); ++i) {
+            out += first ? "{\"name\":" : ",\n{\"name\":";
+            first = false;
+            const std::string& name = scene.names[chunk.entities()[i].index];
+            if (name.empty()) {
+                out += "null";
+            }
+            else {
+                writeJsonString(out, name.c_str());
+            }
+            if (positions) {
+                writeJsonFloats(out, "Position", &positions[i].x, 3);
+            }
+            if (rotations) {
+                writeJsonFloats(out, "Rotation", &rotations[i].x, 4);
+            }
+            if (velocities) {
+                writeJsonFloats(out, "Velocity", &velocities[i].x, 3);
+            }
+            if (healths) {
+                writeJsonFloats(out, "Health", &healths[i].value, 1);
+                out += ",\"team\":" + std::to_string(healths[i].team);
+            }
+            out.push_back('}');
+        }
+    }
+    out += "\n]}\n";
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+/// JSON ̒liׂ鑊ƂāA悭ėp DOM ɂj
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object };
+    Type                                           type = Type::Null;
+    bool                                           boolean = false;
+    double                                         number = 0.0;
+    std::string                                    string;
+    std::vector<JsonValue>                         array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	IuWFNg̃L[T
+     * @return	li nullptrj
+     */
+    const JsonValue* find(const char* key) const noexcept {
+        for (const auto& [name, value] : object) {
+            if (name == key) {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+};
+
+/// JSON ̉
+class JsonParser {
+public:
+    JsonParser(const char* begin, const char* end) : cursor_(begin), end_(end) {}
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	l 1 ͂
+     * @return	 true
+     */
+    bool parse(JsonValue& value) {
+        skipSpace();
+        if (cursor_ == end_) {
+            return false;
+        }
+        switch (*cursor_) {
+        case '{': {
+            value.type = JsonValue::Type::Object;
+            ++cursor_;
+            skipSpace();
+            if (consume('}')) {
+                return true;
+            }
+            do {
+                skipSpace();
+                std::string key;
+                if (!parseString(key) || (skipSpace(), !consume(':'))) {
+                    return false;
+                }
+                value.object.emplace_back(std::move(key), JsonValue{});
+                if (!parse(value.object.back().second)) {
+                    return false;
+                }
+                skipSpace();
+            } while (consume(','));
+            return consume('}');
+        }
+        case '[':
+            value.type = JsonValue::Type::Array;
+            ++cursor_;
+            skipSpace();
+            if (consume(']')) {
+                return true;
+            }
+            do {
+                value.array.emplace_back();
+                if (!parse(value.array.back())) {
+                    return false;
+                }
+                skipSpace();
+            } while (consume(','));
+            return consume(']');
+        case '"':
+            value.type = JsonValue::Type::String;
+            return parseString(value.string);
+        case 't':
+            value.type = JsonValue::Type::Bool;
+            value.boolean = true;
+            return literal("true");
+        case 'f':
+            value.type = JsonValue::Type::Bool;
+            return literal("false");
+        case 'n':
+            return literal("null");
+        default: {
+            value.type = JsonValue::Type::Number;
+            char* next = nullptr;
+            value.number = std::strtod(cursor_, &next);
+            if (next == cursor_) {
+                return false;
+            }
+            cursor_ = next;
+            return true;
+        }
+        }
+    }
+
+private:
+    void skipSpace() noexcept {
+        while (cursor_ != end_ && (*cursor_ == ' ' || *cursor_ == '\n' || *cursor_ == '\r' || *cursor_ == '\t')) {
+            ++cursor_;
+        }
+    }
+    bool consume(char c) noexcept {
+        if (cursor_ != end_ && *cursor_ == c) {
+            ++cursor_;
+            return true;
+        }
+        return false;
+    }
+    bool literal(const char* text) noexcept {
+        const size_t length = std::strlen(text);
+        if (size_t(end_ - cursor_) < length || std::memcmp(cursor_, text, length) != 0) {
+            return false;
+        }
+        cursor_ += length;
+        return true;
+    }
+    bool parseString(std::string& out) {
+        if (!consume('"')) {
+            return false;
+        }
+        while (cursor_ != end_ && *cursor_ != '"') {
+            if (*cursor_ == '\\' && ++cursor_ == end_) {
+                return false;
+            }
+            out.push_back(*cursor_++);
+        }
+        return consume('"');
+    }
+
+    const char* cursor_;  ///< ɓǂޕ
+    const char* end_;     ///< I
+};
+
+/// JSON ǂ񂾃[h
+struct JsonScene {
+    EntityWorld              world;
+    std::vector<Entity>      entities;  ///< t@C̕я̃GeBeB
+    std::vector<std::string> names;     ///< t@C̕я̖O
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	JSON ̐̔z float Ɏʂ
+ */
+bool readJsonFloats(const JsonValue* value, float* out, uint32_t count) {
+    if (!value || value->type != JsonValue::Type::Array || value->array.size() != count) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        out[i] = static_cast<float>(value->array[i].number);
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	DOM GeBeB
+ */
+bool instantiateJson(const JsonValue& document, JsonScene& scene) {
+    const JsonValue* entities = document.find("entities");
+    if (!entities || entities->type != JsonValue::Type::Array) {
+        return false;
+    }
+    scene.entities.reserve(entities->array.size());
+    scene.names.reserve(entities->array.size());
+    for (const JsonValue& object : entities->array) {
+        const JsonValue* position = object.find("Position");
+        const JsonValue* rotation = object.find("Rotation");
+        const JsonValue* velocity = object.find("Velocity");
+        const JsonValue* health = object.find("Health");
+        const JsonValue* name = object.find("name");
+        ComponentMask    mask = 0;
+        mask |= position ? componentMask<Position>() : 0;
+        mask |= rotation ? componentMask<Rotation>() : 0;
+        mask |= velocity ? componentMask<Velocity>() : 0;
+        mask |= health ? componentMask<Health>() : 0;
+        const Entity entity = scene.world.create(mask);
+        if ((position && !readJsonFloats(position, &scene.world.get<Position>(entity)->x, 3)) ||
+            (rotation && !readJsonFloats(rotation, &scene.world.get<Rotation>(entity)->x, 4)) ||
+            (velocity && !readJsonFloats(velocity, &scene.world.get<Velocity>(entity)->x, 3)) ||
+            (health && !readJsonFloats(health, &scene.world.get<Health>(entity)->value, 1))) {
+            return false;
+        }
+        if (health) {
+            const JsonValue* team = object.find("team");
+            scene.world.get<Health>(entity)->team = team ? static_cast<uint32_t>(team->number) : 0;
+        }
+        scene.entities.push_back(entity);
+        scene.names.push_back(name && name->type == JsonValue::Type::String ? name->string : std::string());
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t@CSēǂ
+ */
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t@Cɏ
+ */
+void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	2 ̃GeBeB̑gݍ킹ƒlv邩
+ */
+bool sameEntity(const EntityWorld& a, Entity entityA, const EntityWorld& b, Entity entityB) {
+    const ComponentMask mask = a.mask(entityA);
+    if (!a.isAlive(entityA) || !b.isAlive(entityB) || mask != b.mask(entityB)) {
+        return false;
+    }
+    for (ComponentId id = 0; id < componentCount(); ++id) {
+        if ((mask & (ComponentMask{ 1 } << id)) && std::memcmp(a.get(entityA, id), b.get(entityB, id), componentInfo(id).size) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	fix-up ̕\̈ʒuǂ
+ */
+uint64_t fixupTable(const std::string& bytes, uint64_t& count) {
+    uint64_t table = 0;
+    std::memcpy(&count, bytes.data() + offsetof(SceneFileHeader, fixupCount), sizeof(count));
+    std::memcpy(&table, bytes.data() + offsetof(SceneFileHeader, fixups), sizeof(table));
+    return table;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t    entityCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1000000;
+    const std::string directory = argc > 2 ? argv[2] : "/tmp";
+    const std::string scenePath = directory + "/scene_benchmark.scene";
+    const std::string jsonPath = directory + "/scene_benchmark.json";
+    const std::string brokenPath = directory + "/scene_benchmark_broken.scene";
+    std::printf("%u entities\n", entityCount);
+    bool passed = true;
+
+    auto scene = std::make_unique<Scene>();
+    populate(*scene, entityCount);
+    const auto nameOf = [&](Entity entity) -> const char* {
+        const std::string& name = scene->names[entity.index];
+        return name.empty() ? nullptr : name.c_str();
+    };
+    auto begin = Clock::now();
+    if (!saveScene(scenePath, scene->world, nameOf)) {
+        std::printf("saveScene failed\n");
+        return 1;
+    }
+    const double saveSceneTime = milliseconds(begin, Clock::now());
+    begin = Clock::now();
+    if (!saveJson(jsonPath, *scene)) {
+        std::printf("saveJson failed\n");
+        return 1;
+    }
+    const double saveJsonTime = milliseconds(begin, Clock::now());
+    const std::string sceneBytes = readFile(scenePath);
+    const size_t      jsonBytes = readFile(jsonPath).size();
+    std::printf("scene file %8.2f MB (write %7.1f ms)\n", sceneBytes.size() / 1048576.0, saveSceneTime);
+    std::printf("json       %8.2f MB (write %7.1f ms)\n", jsonBytes / 1048576.0, saveJsonTime);
+
+    // ̃[h̃t@C̕сicollectChunks ̏j
+    std::vector<Entity> original;
+    scene->world.forEachChunk(scene->world.createQuery(0), [&](const ChunkView& chunk) {
+        original.insert(original.end(), chunk.entities(), chunk.entities() + chunk.size());
+    });
+
+    // V[t@Cǂ񂾃[hׂ
+    {
+        SceneFile           file;
+        EntityWorld         world;
+        std::vector<Entity> entities;
+        bool ok = file.open(scenePath) && file.instantiate(world, &entities) && file.entityCount() == entityCount && entities.size() == original.size() &&
+                  world.size() == entityCount && world.archetypeCount() == scene->world.archetypeCount();
+        for (uint32_t i = 0; ok && i < original.size(); ++i) {
+            const char* name = file.entityName(i);
+            ok = sameEntity(scene->world, original[i], world, entities[i]) && scene->names[original[i].index] == (name ? name : "");
+        }
+        // [hւx΁AO͂̂̕܂܂œ
+        ok = ok && file.instantiate(world) && world.size() == entityCount * 2 && sameEntity(world, entities.front(), scene->world, original.front());
+        passed = check(ok, "scene file round trip") && passed;
+    }
+
+    // JSON ǂ񂾃[hׂ
+    {
+        JsonScene json;
+        JsonValue document;
+        const std::string text = readFile(jsonPath);
+        bool ok = JsonParser(text.data(), text.data() + text.size()).parse(document) && instantiateJson(document, json) &&
+                  json.entities.size() == original.size();
+        for (uint32_t i = 0; ok && i < original.size(); ++i) {
+            ok = sameEntity(scene->world, original[i], json.world, json.entities[i]) && scene->names[original[i].index] == json.names[i];
+        }
+        passed = check(ok, "json round trip") && passed;
+    }
+
+    // ̃[h
+    {
+        EntityWorld empty;
+        SceneFile   file;
+        EntityWorld world;
+        const bool  ok = saveScene(brokenPath, empty) && file.open(brokenPath) && file.entityCount() == 0 && file.instantiate(world) && world.size() == 0;
+        passed = check(ok, "empty scene") && passed;
+    }
+
+    // ꂽt@Ce
+    {
+        uint64_t       fixupCount = 0;
+        const uint64_t table = fixupTable(sceneBytes, fixupCount);
+        uint64_t       firstFixup = 0;
+        std::memcpy(&firstFixup, sceneBytes.data() + table, sizeof(firstFixup));
+        const auto rejects = [&](const char* label, std::string bytes) {
+            writeFile(brokenPath, bytes);
+            SceneFile  file;
+            const bool ok = !file.open(brokenPath) && file.entityCount() == 0;
+            std::printf("rejects %-28s %s\n", label, ok ? "ok" : "MISMATCH");
+            return ok;
+        };
+        std::string bytes = sceneBytes;
+        bytes[0] ^= 1;
+        passed = rejects("bad magic", bytes) && passed;
+        passed = rejects("truncated", sceneBytes.substr(0, sceneBytes.size() / 2)) && passed;
+        passed = rejects("header only", sceneBytes.substr(0, sizeof(SceneFileHeader))) && passed;
+
+        bytes = sceneBytes;
+        const uint64_t outside = table + 8;
+        std::memcpy(&bytes[table], &outside, sizeof(outside));
+        passed = rejects("fixup inside the fixup table", bytes) && passed;
+
+        bytes = sceneBytes;
+        const uint64_t huge = uint64_t(1) << 40;
+        std::memcpy(&bytes[firstFixup], &huge, sizeof(huge));
+        passed = rejects("pointer outside the file", bytes) && passed;
+
+        bytes = sceneBytes;
+        std::memcpy(&bytes[table + 8], &firstFixup, sizeof(firstFixup));
+        passed = rejects("duplicated fixup", bytes) && passed;
+
+        // ̔z񂪃t@C̏I͂ݏoiŏ̃A[L^CṽGeBeB𑝂₷j
+        bytes = sceneBytes;
+        uint64_t archetypes = 0;
+        std::memcpy(&archetypes, bytes.data() + offsetof(SceneFileHeader, archetypes), sizeof(archetypes));
+        const uint32_t tooMany = entityCount * 4;
+        std::memcpy(&bytes[archetypes + offsetof(SceneArchetype, entityCount)], &tooMany, sizeof(tooMany));
+        passed = rejects("column past the end", bytes) && passed;
+
+        SceneFile missing;
+        const bool ok = !missing.open(directory + "/scene_benchmark_missing.scene");
+        std::printf("rejects %-28s %s\n", "missing file", ok ? "ok" : "MISMATCH");
+        passed = passed && ok;
+    }
+
+    // ǂݍݎ
+    std::vector<double> openTimes, instantiateTimes, sceneTimes, readTimes, parseTimes, createTimes, jsonTimes;
+    for (int r = 0; r < Repeats; ++r) {
+        {
+            EntityWorld world;
+            SceneFile   file;
+            begin = Clock::now();
+            passed = file.open(scenePath) && passed;
+            const auto opened = Clock::now();
+            passed = file.instantiate(world) && passed;
+            const auto end = Clock::now();
+            openTimes.push_back(milliseconds(begin, opened));
+            instantiateTimes.push_back(milliseconds(opened, end));
+            sceneTimes.push_back(milliseconds(begin, end));
+        }
+        {
+            auto json = std::make_unique<JsonScene>();
+            auto document = std::make_unique<JsonValue>();
+            begin = Clock::now();
+            const std::string text = readFile(jsonPath);
+            const auto        read = Clock::now();
+            passed = JsonParser(text.data(), text.data() + text.size()).parse(*document) && passed;
+            const auto parsed = Clock::now();
+            passed = instantiateJson(*document, *json) && passed;
+            const auto end = Clock::now();
+            readTimes.push_back(milliseconds(begin, read));
+            parseTimes.push_back(milliseconds(read, parsed));
+            createTimes.push_back(milliseconds(parsed, end));
+            jsonTimes.push_back(milliseconds(begin, end));
+        }
+    }
+    std::printf("\nload (ms)\n");
+    std::printf("  scene file open (mmap + fixups)  %8.2f\n", median(openTimes));
+    std::printf("  scene file instantiate (memcpy)  %8.2f\n", median(instantiateTimes));
+    std::printf("  scene file total                 %8.2f\n", median(sceneTimes));
+    std::printf("  json read                        %8.2f\n", median(readTimes));
+    std::printf("  json parse                       %8.2f\n", median(parseTimes));
+    std::printf("  json create entities             %8.2f\n", median(createTimes));
+    std::printf("  json total                       %8.2f\n", median(jsonTimes));
+    std::printf("  speedup                          %8.1fx\n", median(jsonTimes) / median(sceneTimes));
+
+    std::remove(scenePath.c_str());
+    std::remove(jsonPath.c_str());
+    std::remove(brokenPath.c_str());
+    return finish(passed);
+}
@@ -0,0 +1,278 @@
+// SDF tHgĂc[iUiRenderer / UiBatch p .sdffont j
+//
+// FreeType ŕĂ傫̐{ 2 lɕ`AƊOꂼ̐mȃ[Nbhϊ
+// (Felzenszwalb & Huttenlocher) 畄t߂ďĂ傫֏k߁AIl߂ŃAgXɕׂB
+// l 0.5 ֊sAقǑ傫A0`1  }spread sNZiĂ傫j\
+//
+// s͏ĂǂނȂ̂ŁAFreeType v̂͂̃c[
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -I.. sdf_font_baker.cpp ../sdf_font.cpp $(pkg-config --cflags --libs freetype2) -o sdf_font_baker
+// s:
+//   tools/sdf_font_baker font.ttf asset/ui_font.sdffont [Ă傫=32] [spread=4] [ǉ͈̔ 擪- (16 i) ...]
+//   tools/sdf_font_baker font.ttf asset/ui_font.sdffont 32 4 3040-30FF
+
+#include "sdf_font.h"
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+namespace {
+
+/// ߂鎞ɉ{̑傫ŕ`
+constexpr uint32_t Oversample = 8;
+
+/// AgX̕
+constexpr uint32_t AtlasWidth = 512;
+
+/// ΐuv
+constexpr float Infinity = 1.0e20f;
+
+/// Ă 1 
+struct BakedGlyph {
+    SdfGlyph             glyph;   ///< ̏ix, y ͋l߂Ɍ܂j
+    std::vector<uint8_t> pixels;  ///< iwidth x heightj
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	1 ̋ϊi拗̉j
+ * @param	f	́i0  InfinityjBʂ̓拗ŏ㏑
+ * @param	n	vf
+ * @param	v	Ɨ̈in j
+ * @param	z	Ɨ̈in + 1 j
+ * @param	d	Ɨ̈in j
+ */
+void distanceTransform1d(float* f, uint32_t n, uint32_t* v, float* z, float* d) {
+    uint32_t k = 0;
+    v[0] = 0;
+    z[0] = -Infinity;
+    z[1] = Infinity;
+    for (uint32_t q = 1; q < n; ++q) {
+        float s = ((f[q] + float(q) * q) - (f[v[k]] + float(v[k]) * v[k])) / (2.0f * q - 2.0f * v[k]);
+        while (s <= z[k]) {
+            --k;
+            s = ((f[q] + float(q) * q) - (f[v[k]] + float(v[k]) * v[k])) / (2.0f * q - 2.0f * v[k]);
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = Infinity;
+    }
+    k = 0;
+    for (uint32_t q = 0; q < n; ++q) {
+        while (z[k + 1] < float(q)) {
+            ++k;
+        }
+        const float dq = float(q) - float(v[k]);
+        d[q] = dq * dq + f[v[k]];
+    }
+    std::copy(d, d + n, f);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	2 ̋ϊiAs̏ 1 ̕ϊj
+ * @param	grid	́iΏۂ̉f 0AȊO InfinityjBł߂Ώۂ܂ł̓拗ŏ㏑
+ * @param	width	
+ * @param	height	
+ */
+void distanceTransform2d(std::vector<float>& grid, uint32_t width, uint32_t height) {
+    const uint32_t        n = std::max(width, height);
+    std::vector<float>    f(n), z(n + 1), d(n);
+    std::vector<uint32_t> v(n);
+    for (uint32_t x = 0; x < width; ++x) {
+        for (uint32_t y = 0; y < height; ++y) {
+            f[y] = grid[size_t(y) * width + x];
+        }
+        distanceTransform1d(f.data(), height, v.data(), z.data(), d.data());
+        for (uint32_t y = 0; y < height; ++y) {
+            grid[size_t(y) * width + x] = f[y];
+        }
+    }
+    for (uint32_t y = 0; y < height; ++y) {
+        distanceTransform1d(grid.data() + size_t(y) * width, width, v.data(), z.data(), d.data());
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	1 Ă
+ * @param	face		FreeType ̃tFCXiOversample {̑傫ɐݒς݁j
+ * @param	codepoint	R[h|Cg
+ * @param	spread		\iĂ傫̃sNZj
+ * @param	out			i[
+ * @return	tHgɕ true
+ */
+bool bakeGlyph(FT_Face face, uint32_t codepoint, uint32_t spread, BakedGlyph& out) {
+    const FT_UInt index = FT_Get_Char_Index(face, codepoint);
+    if (index == 0 || FT_Load_Glyph(face, index, FT_LOAD_RENDER | FT_LOAD_TARGET_MONO) != 0) {
+        return false;
+    }
+    const FT_GlyphSlot  slot = face->glyph;
+    const FT_Bitmap&    bitmap = slot->bitmap;
+    SdfGlyph&           glyph = out.glyph;
+    glyph = {};
+    glyph.codepoint = codepoint;
+    glyph.advance = float(slot->advance.x) / 64.0f / Oversample;
+    if (bitmap.width == 0 || bitmap.rows == 0) {
+        out.pixels.clear();
+        return true;
+    }
+
+    //  spread ̗]tAk߂Ɋ؂傫ɂ
+    const uint32_t pad = spread * Oversample;
+    const uint32_t width = (bitmap.width + 2 * pad + Oversample - 1) / Oversample * Oversample;
+    const uint32_t height = (bitmap.rows + 2 * pad + Oversample - 1) / Oversample * Oversample;
+    std::vector<uint8_t> inside(size_t(width) * height, 0);
+    for (uint32_t y = 0; y < bitmap.rows; ++y) {
+        const uint8_t* row = bitmap.buffer + std::ptrdiff_t(y) * bitmap.pitch;
+        for (uint32_t x = 0; x < bitmap.width; ++x) {
+            inside[size_t(y + pad) * width + x + pad] = (row[x >> 3] >> (7 - (x & 7))) & 1;
+        }
+    }
+
+    // Ỏf܂ł̋ƁẢfO܂ł̋
+    std::vector<float> toInside(inside.size());
+    std::vector<float> toOutside(inside.size());
+    for (size_t i = 0; i < inside.size(); ++i) {
+        toInside[i] = inside[i] ? 0.0f : Infinity;
+        toOutside[i] = inside[i] ? Infinity : 0.0f;
+    }
+    distanceTransform2d(toInside, width, height);
+    distanceTransform2d(toOutside, width, height);
+
+    // f̒Sm̋Ȃ̂ŁA֊sׂ͗荇Ỏf̒ԂƂ 0.5 炷
+    glyph.width = static_cast<uint16_t>(width / Oversample);
+    glyph.height = static_cast<uint16_t>(height / Oversample);
+    glyph.offsetX = float(slot->bitmap_left) / Oversample - float(spread);
+    glyph.offsetY = -float(slot->bitmap_top) / Oversample - float(spread);
+    out.pixels.assign(size_t(glyph.width) * glyph.height, 0);
+    for (uint32_t by = 0; by < glyph.height; ++by) {
+        for (uint32_t bx = 0; bx < glyph.width; ++bx) {
+            // k߂ 1 fɓ Oversample x Oversample f̕
+            float sum = 0.0f;
+            for (uint32_t y = by * Oversample; y < (by + 1) * Oversample; ++y) {
+                for (uint32_t x = bx * Oversample; x < (bx + 1) * Oversample; ++x) {
+                    const size_t i = size_t(y) * width + x;
+                    sum += inside[i] ? std::sqrt(toOutside[i]) - 0.5f : 0.5f - std::sqrt(toInside[i]);
+                }
+            }
+            const float distance = sum / float(Oversample * Oversample) / Oversample;
+            const float value = std::clamp(0.5f + distance / float(2 * spread), 0.0f, 1.0f);
+            out.pixels[size_t(by) * glyph.width + bx] = static_cast<uint8_t>(std::lround(value * 255.0f));
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::printf("usage: sdf_font_baker font.ttf out.sdffont [size=32] [spread=4] [first-last (hex) ...]\n");
+        return 1;
+    }
+    const uint32_t baseSize = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 32;
+    const uint32_t spread = argc > 4 ? static_cast<uint32_t>(std::atoi(argv[4])) : 4;
+    if (baseSize == 0 || spread == 0) {
+        std::printf("size and spread must be positive\n");
+        return 1;
+    }
+
+    // ASCII ̕\ł镶ƁAő͈
+    std::vector<uint32_t> codepoints;
+    for (uint32_t c = 32; c < 127; ++c) {
+        codepoints.push_back(c);
+    }
+    for (int i = 5; i < argc; ++i) {
+        unsigned first = 0;
+        unsigned last = 0;
+        if (std::sscanf(argv[i], "%x-%x", &first, &last) != 2 || first > last) {
+            std::printf("bad range: %s\n", argv[i]);
+            return 1;
+        }
+        for (uint32_t c = first; c <= last; ++c) {
+            codepoints.push_back(c);
+        }
+    }
+    std::sort(codepoints.begin(), codepoints.end());
+    codepoints.erase(std::unique(codepoints.begin(), codepoints.end()), codepoints.end());
+
+    FT_Library library;
+    FT_Face    face;
+    if (FT_Init_FreeType(&library) != 0 || FT_New_Face(library, argv[1], 0, &face) != 0) {
+        std::printf("cannot open %s\n", argv[1]);
+        return 1;
+    }
+    FT_Set_Pixel_Sizes(face, 0, baseSize * Oversample);
+
+    SdfFont font;
+    font.baseSize = float(baseSize);
+    font.distanceRange = float(2 * spread);
+    font.lineHeight = float(face->size->metrics.height) / 64.0f / Oversample;
+    font.ascent = float(face->size->metrics.ascender) / 64.0f / Oversample;
+
+    std::vector<BakedGlyph> baked;
+    for (const uint32_t codepoint : codepoints) {
+        BakedGlyph glyph;
+        if (bakeGlyph(face, codepoint, spread, glyph)) {
+            baked.push_back(std::move(glyph));
+        }
+    }
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+
+    // ɒI֋l߂i̊Ԃ 1 f󂯂Ăɂ݂hj
+    std::vector<uint32_t> order(baked.size());
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return baked[a].glyph.height > baked[b].glyph.height; });
+    uint32_t shelfX = 1;
+    uint32_t shelfY = 1;
+    uint32_t shelfHeight = 0;
+    for (const uint32_t i : order) {
+        SdfGlyph& glyph = baked[i].glyph;
+        if (glyph.width == 0) {
+            continue;
+        }
+        if (shelfX + glyph.width + 1 > AtlasWidth) {
+            shelfX = 1;
+            shelfY += shelfHeight + 1;
+            shelfHeight = 0;
+        }
+        glyph.x = static_cast<uint16_t>(shelfX);
+        glyph.y = static_cast<uint16_t>(shelfY);
+        shelfX += glyph.width + 1;
+        shelfHeight = std::max<uint32_t>(shelfHeight, glyph.height);
+    }
+    uint32_t atlasHeight = 1;
+    while (atlasHeight < shelfY + shelfHeight + 1) {
+        atlasHeight <<= 1;
+    }
+
+    font.atlasWidth = AtlasWidth;
+    font.atlasHeight = atlasHeight;
+    font.atlas.assign(size_t(AtlasWidth) * atlasHeight, 0);
+    for (const BakedGlyph& glyph : baked) {
+        for (uint32_t y = 0; y < glyph.glyph.height; ++y) {
+            std::copy_n(glyph.pixels.data() + size_t(y) * glyph.glyph.width, glyph.glyph.width,
+                        font.atlas.data() + size_t(glyph.glyph.y + y) * AtlasWidth + glyph.glyph.x);
+        }
+        font.glyphs.push_back(glyph.glyph);
+    }
+    indexSdfFontGlyphs(font);
+    if (!saveSdfFont(argv[2], font)) {
+        std::printf("cannot write %s\n", argv[2]);
+        return 1;
+    }
+    std::printf("%u glyphs, atlas %ux%u, base %u px, spread %u px -> %s\n", uint32_t(font.glyphs.size()), font.atlasWidth, font.atlasHeight, baseSize,
+                spread, argv[2]);
+    return 0;
+}
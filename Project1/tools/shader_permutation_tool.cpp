@@ -0,0 +1,89 @@
+// VF[_p[~e[ṼItCRpCc[
+//
+// shader_features.h Ő錾SoAg DXC ŕɃRpCA
+// ShaderLibrary ǂݍ asset/shader/shader_XXXX.{vs,ps}.cso o͂
+// Windows / Linux ǂ DXC ł悤AOvZXĂяoŊĂ
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -pthread -I.. shader_permutation_tool.cpp ../shader_permutation.cpp ../job_system.cpp -o shader_permutation_tool
+// s (Project1 tH_):
+//   tools/shader_permutation_tool asset/shader.hlsl asset/shader dxc
+
+#include "job_system.h"
+#include "shader_features.h"
+#include "shader_permutation.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	1 Xe[W DXC R}hC
+ * @param	dxc			DXC ̎st@C
+ * @param	source		HLSL t@C
+ * @param	entry		Gg|Cg
+ * @param	profile		VF[_vt@C
+ * @param	defines		p[~e[V̒`
+ * @param	output		o̓t@C
+ * @return	R}hC
+ */
+std::string makeCommand(const std::string& dxc, const std::string& source, const char* entry, const char* profile,
+                        const std::vector<ShaderPermutation::Define>& defines, const std::string& output) {
+    std::string command = "\"" + dxc + "\" -nologo -O3 -E " + entry + " -T " + profile;
+    for (const auto& [name, value] : defines) {
+        command += " -D " + name + "=" + value;
+    }
+    command += " -Fo \"" + output + "\" \"" + source + "\"";
+    return command;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const std::string source    = argc > 1 ? argv[1] : SceneShaderPath;
+    const std::string outputDir = argc > 2 ? argv[2] : SceneShaderCompiledDirectory;
+    const std::string dxc       = argc > 3 ? argv[3] : "dxc";
+
+    std::error_code ec;
+    std::filesystem::create_directories(outputDir, ec);
+    if (ec) {
+        std::fprintf(stderr, "cannot create %s: %s\n", outputDir.c_str(), ec.message().c_str());
+        return 1;
+    }
+
+    const auto permutation = makeSceneShaderPermutation();
+    const auto keys        = permutation.enumerateKeys();
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+
+    // DXC  1 vZX 1 RAȂ̂ŁAoAgPʂŃRAɔz
+    std::atomic<uint32_t> failed = 0;
+    jobSystem.parallelFor(static_cast<uint32_t>(keys.size()), 1, [&](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            const auto key     = keys[i];
+            const auto defines = permutation.defines(key);
+            const auto base    = outputDir + "/shader_" + ShaderPermutation::keyString(key);
+
+            const std::string commands[] = {
+                makeCommand(dxc, source, "vs", "vs_6_0", defines, base + ".vs.cso"),
+                makeCommand(dxc, source, "ps", "ps_6_0", defines, base + ".ps.cso"),
+            };
+            for (const auto& command : commands) {
+                if (std::system(command.c_str()) != 0) {
+                    std::fprintf(stderr, "failed: %s\n", command.c_str());
+                    ++failed;
+                }
+            }
+        }
+    });
+
+    std::printf("%zu variants, %u workers, %u failures\n", keys.size(), jobSystem.workerCount() + 1, failed.load());
+    return failed == 0 ? 0 : 1;
+}
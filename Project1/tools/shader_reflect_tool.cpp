@@ -0,0 +1,117 @@
+// VF[_tNṼItCc[
+//
+// DXC ̋tAZuo (-Fc) 璸_͂ƒ萔obt@ C++ \̂𐶐
+// wb_ offsetof / sizeof  static_assert Ō̂ŁA
+// HLSL ̃CAEgύX C++ Ǐ]ĂȂ΃RpCG[ɂȂ
+// DXIL  D3DReflect œǂ߂Ȃ߁Asł͂Ȃ̃c[ŎOɐĂ
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -I.. shader_reflect_tool.cpp ../shader_reflection_data.cpp ../pipeline_state_desc.cpp -o shader_reflect_tool
+// s (Project1 tH_):
+//   tools/shader_reflect_tool asset/shader.hlsl asset/shader/shader_reflection.h dxc
+//   tools/shader_reflect_tool --listing vs.txt ps.txt asset/shader/shader_reflection.h
+
+#include "shader_features.h"
+#include "shader_reflection_data.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace {
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t@CSēǂ
+ * @param	path	pX
+ * @param	text	e̊i[
+ * @return	ǂ߂ true
+ */
+bool readFile(const std::string& path, std::string& text) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    text = stream.str();
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	DXC  1 Xe[WRpCċtAZuo͂𓾂
+ * @param	dxc			DXC ̎st@C
+ * @param	source		HLSL t@C
+ * @param	entry		Gg|Cg
+ * @param	profile		VF[_vt@C
+ * @param	listing		tAZuo͂̏o
+ * @return	 true
+ */
+bool disassemble(const std::string& dxc, const std::string& source, const char* entry, const char* profile, const std::string& listing) {
+    const std::string command = "\"" + dxc + "\" -nologo -E " + entry + " -T " + profile + " -Fc \"" + listing + "\" \"" + source + "\"";
+    if (std::system(command.c_str()) != 0) {
+        std::fprintf(stderr, "failed: %s\n", command.c_str());
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string vertexListing;
+    std::string pixelListing;
+    std::string output;
+
+    if (argc > 1 && std::string(argv[1]) == "--listing") {
+        // tAZuo͂𒼐ړn
+        if (argc < 4) {
+            std::fprintf(stderr, "usage: %s --listing vs.txt ps.txt [output.h]\n", argv[0]);
+            return 1;
+        }
+        vertexListing = argv[2];
+        pixelListing  = argv[3];
+        output        = argc > 4 ? argv[4] : std::string(SceneShaderCompiledDirectory) + "/shader_reflection.h";
+    }
+    else {
+        const std::string source = argc > 1 ? argv[1] : SceneShaderPath;
+        const std::string dxc    = argc > 3 ? argv[3] : "dxc";
+        output        = argc > 2 ? argv[2] : std::string(SceneShaderCompiledDirectory) + "/shader_reflection.h";
+        vertexListing = output + ".vs.txt";
+        pixelListing  = output + ".ps.txt";
+        if (!disassemble(dxc, source, "vs", "vs_6_0", vertexListing) || !disassemble(dxc, source, "ps", "ps_6_0", pixelListing)) {
+            return 1;
+        }
+    }
+
+    std::string          text;
+    ShaderReflectionData vertexShader;
+    ShaderReflectionData pixelShader;
+    if (!readFile(vertexListing, text) || !parseShaderDisassembly(text, vertexShader)) {
+        std::fprintf(stderr, "cannot parse %s\n", vertexListing.c_str());
+        return 1;
+    }
+    if (!readFile(pixelListing, text) || !parseShaderDisassembly(text, pixelShader)) {
+        std::fprintf(stderr, "cannot parse %s\n", pixelListing.c_str());
+        return 1;
+    }
+
+    std::string report;
+    const auto  header = generateShaderReflectionHeader(vertexShader, pixelShader, &report);
+
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    if (!file.write(header.data(), static_cast<std::streamsize>(header.size()))) {
+        std::fprintf(stderr, "cannot write %s\n", output.c_str());
+        return 1;
+    }
+
+    // _CAEgƃpfBO̖ʂ\
+    for (const auto& element : makeInputLayout(vertexShader)) {
+        std::printf("input %s%u slot %u offset %u%s\n", element.semanticName.c_str(), element.semanticIndex, element.inputSlot,
+                    element.alignedByteOffset, element.perInstance ? " (instance)" : "");
+    }
+    std::printf("%s", report.c_str());
+    return 0;
+}
@@ -0,0 +1,305 @@
+// VhE}bṽLbṼV~[V
+//
+// 1. ShadowAtlas ɗ̑傫Ŋ蓖ĂƉJԂAĂ^CdȂȂƁA
+//    󂫖ʐςƁASĉΐeɂ܂ƂߒĈꖇɖ߂邱Ƃm߂
+// 2. ÓIȃLX^[~l߂nʂɓLX^[𑖂点AJXP[h 4 iƃX|bgCg 24 
+//    ShadowCache 񂷁Bt[Sr[`ꍇƕ`搔ׁALbV̒g
+//    ŋ߂̐ÓIȃLX^[ƏɈv邱ƁALive ̗vLX^[̉W
+//    v邱Ƃm߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -mavx2 -pthread -I.. shadow_cache_sim.cpp ../shadow_cache.cpp ../shadow_atlas.cpp ../frustum_culling.cpp ../indirect_cull.cpp ../job_system.cpp -o shadow_cache_sim
+// s:
+//   tools/shadow_cache_sim [t[]
+
+#include "bench_common.h"
+#include "job_system.h"
+#include "shadow_cache.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	AgX̊蓖ĂƉJԂĊm߂
+ * @return	肪Ȃ true
+ */
+bool testAtlas() {
+    constexpr uint32_t AtlasSize = 8192;
+    constexpr uint32_t MinTileSize = 128;
+    constexpr uint32_t Cells = AtlasSize / MinTileSize;
+
+    ShadowAtlas atlas;
+    if (!atlas.create(AtlasSize, MinTileSize)) {
+        return false;
+    }
+
+    std::mt19937                            random(7);
+    std::uniform_int_distribution<uint32_t> sizeShift(0, 5);
+    std::uniform_int_distribution<uint32_t> coin(0, 2);
+    std::vector<ShadowTile>                 live;
+    std::vector<uint8_t>                    occupied(Cells * Cells);
+    uint64_t                                usedArea = 0;
+    uint32_t                                failures = 0;
+    bool                                    passed = true;
+
+    for (uint32_t step = 0; step < 20000; ++step) {
+        if (live.empty() || coin(random) != 0) {
+            const uint32_t request = (MinTileSize << sizeShift(random)) - (random() % 64);
+            const auto     tile = atlas.allocate(request);
+            if (!tile.valid()) {
+                ++failures;
+                continue;
+            }
+            // 2 ׂ̂ɐ؂グAAgX̒ŏdȂȂ
+            passed = passed && tile.size >= request && (tile.size & (tile.size - 1)) == 0 && tile.x % tile.size == 0 && tile.y % tile.size == 0 &&
+                     tile.x + tile.size <= AtlasSize && tile.y + tile.size <= AtlasSize;
+            for (uint32_t y = tile.y / MinTileSize; y < (tile.y + tile.size) / MinTileSize; ++y) {
+                for (uint32_t x = tile.x / MinTileSize; x < (tile.x + tile.size) / MinTileSize; ++x) {
+                    passed = passed && occupied[y * Cells + x] == 0;
+                    occupied[y * Cells + x] = 1;
+                }
+            }
+            usedArea += uint64_t(tile.size) * tile.size;
+            live.push_back(tile);
+        }
+        else {
+            const size_t index = random() % live.size();
+            const auto   tile = live[index];
+            live[index] = live.back();
+            live.pop_back();
+            for (uint32_t y = tile.y / MinTileSize; y < (tile.y + tile.size) / MinTileSize; ++y) {
+                for (uint32_t x = tile.x / MinTileSize; x < (tile.x + tile.size) / MinTileSize; ++x) {
+                    occupied[y * Cells + x] = 0;
+                }
+            }
+            usedArea -= uint64_t(tile.size) * tile.size;
+            atlas.release(tile);
+        }
+        passed = passed && atlas.freeArea() + usedArea == uint64_t(AtlasSize) * AtlasSize;
+    }
+    const size_t peak = live.size();
+
+    for (const auto& tile : live) {
+        atlas.release(tile);
+    }
+    const auto whole = atlas.allocate(AtlasSize);
+    passed = passed && whole.valid() && whole.x == 0 && whole.y == 0 && whole.size == AtlasSize;
+
+    std::printf("atlas: %zu live tiles at end, %u failed allocations, merge back to one tile: %s\n", peak, failures, whole.valid() ? "ok" : "NG");
+    return passed;
+}
+
+/// LX^[
+struct Mover {
+    float centerX;  ///< ~̒S
+    float centerZ;
+    float radius;   ///< ~̔a
+    float speed;    ///< pxiWA / t[j
+    float phase;    ///< ʑ
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	^ォ猩낷seiJXP[hj̃r[ˉes
+ */
+void makeCascade(float m[4][4], float centerX, float centerZ, float halfSize) {
+    const float top = 100.0f;
+    const float range = 200.0f;
+    const float matrix[4][4] = {
+        { 1.0f / halfSize, 0.0f, 0.0f, -centerX / halfSize },
+        { 0.0f, 0.0f, 1.0f / halfSize, -centerZ / halfSize },
+        { 0.0f, -1.0f / range, 0.0f, top / range },
+        { 0.0f, 0.0f, 0.0f, 1.0f },
+    };
+    std::copy(&matrix[0][0], &matrix[0][0] + 16, &m[0][0]);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	^X|bgCg̃r[ˉesic 60 xj
+ */
+void makeSpot(float m[4][4], float x, float height, float z) {
+    const float f = 1.7320508f;
+    const float nearZ = 0.5f;
+    const float farZ = 60.0f;
+    const float a = farZ / (farZ - nearZ);
+    const float b = -nearZ * farZ / (farZ - nearZ);
+    const float matrix[4][4] = {
+        { f, 0.0f, 0.0f, -f * x },
+        { 0.0f, 0.0f, f, -f * z },
+        { 0.0f, -a, 0.0f, a * height + b },
+        { 0.0f, -1.0f, 0.0f, height },
+    };
+    std::copy(&matrix[0][0], &matrix[0][0] + 16, &m[0][0]);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ɓ鋫E𑍓ŏW߂
+ */
+void collectVisible(const CullFrustum& frustum, const BoundingSpheres& spheres, std::vector<uint32_t>& out) {
+    out.clear();
+    for (uint32_t i = 0; i < spheres.size(); ++i) {
+        const float bounds[4] = { spheres.x()[i], spheres.y()[i], spheres.z()[i], spheres.radius()[i] };
+        if (isSphereInFrustum(frustum, bounds)) {
+            out.push_back(i);
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t frameCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 600;
+    bool           passed = testAtlas();
+
+    // 400 x 400 ̒nʂ 4 ԊuŐÓIȃLX^[ׂ
+    BoundingSpheres staticCasters;
+    for (int z = 0; z < 100; ++z) {
+        for (int x = 0; x < 100; ++x) {
+            const float center[3] = { -198.0f + x * 4.0f, 1.0f, -198.0f + z * 4.0f };
+            staticCasters.add(center, 1.0f);
+        }
+    }
+
+    // _̎铮LX^[
+    std::mt19937                          random(42);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<Mover>                    movers(32);
+    BoundingSpheres                       movingCasters;
+    for (auto& mover : movers) {
+        mover = { (unit(random) - 0.5f) * 200.0f, (unit(random) - 0.5f) * 200.0f, 5.0f + unit(random) * 40.0f, 0.005f + unit(random) * 0.02f,
+                  unit(random) * 6.2831853f };
+        const float center[3] = { 0.0f, 1.0f, 0.0f };
+        movingCasters.add(center, 1.0f);
+    }
+
+    ShadowCache cache;
+    if (!cache.create(8192, 128)) {
+        return 1;
+    }
+    std::vector<uint32_t> views;
+    std::vector<float>    matrices;
+    const float           cascadeSizes[] = { 25.0f, 50.0f, 100.0f, 200.0f };
+    for (const float halfSize : cascadeSizes) {
+        float m[4][4];
+        makeCascade(m, 0.0f, 0.0f, halfSize);
+        views.push_back(cache.addView(2048));
+        cache.setViewProjection(views.back(), m);
+        matrices.insert(matrices.end(), &m[0][0], &m[0][0] + 16);
+    }
+    for (uint32_t i = 0; i < 24; ++i) {
+        float m[4][4];
+        makeSpot(m, (unit(random) - 0.5f) * 360.0f, 30.0f, (unit(random) - 0.5f) * 360.0f);
+        views.push_back(cache.addView(512));
+        cache.setViewProjection(views.back(), m);
+        matrices.insert(matrices.end(), &m[0][0], &m[0][0] + 16);
+    }
+    for (const uint32_t view : views) {
+        passed = passed && view != InvalidShadowView;
+    }
+
+    // LbVɕ`ÓIȃLX^[iԍƈʒujoĂȀԂƔׂ
+    std::vector<std::vector<uint32_t>> cachedIndices(views.size());
+    std::vector<std::vector<float>>    cachedPositions(views.size());
+    std::vector<uint32_t>              visible;
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+
+    uint64_t naiveDraws = 0;
+    uint64_t cachedDraws = 0;
+    uint64_t cacheRenders = 0;
+    uint32_t staleViews = 0;
+    uint32_t wrongLive = 0;
+    for (uint32_t frame = 0; frame < frameCount; ++frame) {
+        for (uint32_t i = 0; i < movers.size(); ++i) {
+            const auto& mover = movers[i];
+            const float angle = mover.phase + mover.speed * float(frame);
+            const float center[3] = { mover.centerX + std::cos(angle) * mover.radius, 1.0f, mover.centerZ + std::sin(angle) * mover.radius };
+            movingCasters.set(i, center, 1.0f);
+        }
+
+        // ܂ɐÓIȃLX^[ 1 uiJj
+        if (frame % 50 == 25) {
+            const uint32_t index = random() % staticCasters.size();
+            const float    before[4] = { staticCasters.x()[index], staticCasters.y()[index], staticCasters.z()[index], staticCasters.radius()[index] };
+            const float    center[3] = { before[0] + 1.5f, before[1], before[2] };
+            const float    after[4] = { center[0], center[1], center[2], before[3] };
+            staticCasters.set(index, center, before[3]);
+            cache.invalidate(before);
+            cache.invalidate(after);
+        }
+
+        cache.prepare(staticCasters, movingCasters, &jobSystem);
+        for (const auto& request : cache.requests()) {
+            cachedDraws += request.casterCount;
+            if (request.atlas == ShadowAtlasKind::Cache) {
+                ++cacheRenders;
+                auto& indices = cachedIndices[request.view];
+                auto& positions = cachedPositions[request.view];
+                indices.assign(cache.casterIndices().begin() + request.firstCaster,
+                               cache.casterIndices().begin() + request.firstCaster + request.casterCount);
+                positions.clear();
+                for (const uint32_t index : indices) {
+                    positions.push_back(staticCasters.x()[index]);
+                    positions.push_back(staticCasters.z()[index]);
+                }
+            }
+        }
+
+        for (uint32_t v = 0; v < views.size(); ++v) {
+            float m[4][4];
+            std::copy(matrices.begin() + v * 16, matrices.begin() + v * 16 + 16, &m[0][0]);
+            const CullFrustum frustum = makeCullFrustum(m);
+
+            // t[`ꍇ̕`搔
+            collectVisible(frustum, staticCasters, visible);
+            naiveDraws += visible.size();
+            bool stale = visible != cachedIndices[v];
+            for (size_t i = 0; !stale && i < visible.size(); ++i) {
+                stale = staticCasters.x()[visible[i]] != cachedPositions[v][i * 2] || staticCasters.z()[visible[i]] != cachedPositions[v][i * 2 + 1];
+            }
+            staleViews += stale ? 1 : 0;
+
+            collectVisible(frustum, movingCasters, visible);
+            naiveDraws += visible.size();
+            const auto sample = cache.sample(views[v]);
+            const auto live = std::find_if(cache.requests().begin(), cache.requests().end(),
+                                           [&](const ShadowRenderRequest& r) { return r.view == views[v] && r.atlas == ShadowAtlasKind::Live; });
+            if (visible.empty()) {
+                wrongLive += (live != cache.requests().end() || sample.atlas != ShadowAtlasKind::Cache) ? 1 : 0;
+            }
+            else {
+                const bool same = live != cache.requests().end() && sample.atlas == ShadowAtlasKind::Live && live->casterCount == visible.size() &&
+                                  std::equal(visible.begin(), visible.end(), cache.casterIndices().begin() + live->firstCaster);
+                wrongLive += same ? 0 : 1;
+            }
+        }
+    }
+
+    const double ratio = double(naiveDraws) / double(std::max<uint64_t>(cachedDraws, 1));
+    std::printf("views %zu, static casters %u, moving casters %u, frames %u\n", views.size(), staticCasters.size(), movingCasters.size(), frameCount);
+    std::printf("draws per frame: every view every frame %.0f, cached %.1f (%.1fx fewer), cache re-renders %llu\n", double(naiveDraws) / frameCount,
+                double(cachedDraws) / frameCount, ratio, static_cast<unsigned long long>(cacheRenders));
+    std::printf("stale cache views %u, wrong live requests %u\n", staleViews, wrongLive);
+    passed = passed && staleViews == 0 && wrongLive == 0 && ratio >= 10.0;
+
+    // 𑜓xグĂ蓖ĒĖɂȂ
+    const bool resized = cache.setResolution(views[4], 1024);
+    cache.prepare(staticCasters, movingCasters, nullptr);
+    const bool rerendered = std::any_of(cache.requests().begin(), cache.requests().end(), [&](const ShadowRenderRequest& r) {
+        return r.view == views[4] && r.atlas == ShadowAtlasKind::Cache && r.tile.size == 1024;
+    });
+    passed = check(resized && rerendered, "resize view") && passed;
+
+    return finish(passed);
+}
@@ -0,0 +1,95 @@
+// XvCgob`̃x`}[N
+//
+// 100 XvCg SpriteBatch ɐς݁A\[gƋlߍ݂ɂ CPU Ԃ𑪂
+// \[ǧʂ std::stable_sort ƈv邱Ƃm߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -pthread -I.. sprite_benchmark.cpp ../sprite_batch.cpp ../radix_sort.cpp ../job_system.cpp ../pipeline_state_desc.cpp -o sprite_benchmark
+// s:
+//   tools/sprite_benchmark [XvCg] [eNX`] [C[] [t[]
+
+#include "bench_common.h"
+#include "job_system.h"
+#include "radix_sort.h"
+#include "sprite_batch.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t spriteCount  = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1000000;
+    const uint32_t textureCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 64;
+    const uint32_t layerCount   = argc > 3 ? static_cast<uint32_t>(std::atoi(argv[3])) : 8;
+    const uint32_t frameCount   = argc > 4 ? static_cast<uint32_t>(std::atoi(argv[4])) : 10;
+
+    std::vector<Sprite> sprites(spriteCount);
+    std::mt19937        random(42);
+    for (auto& sprite : sprites) {
+        sprite = { float(random() % 1920), float(random() % 1080), 16, 16, (random() % 4) ? 0.0f : 0.5f,
+                   { 0, 0, 1, 1 }, 0xffffffff, static_cast<uint32_t>(random() % textureCount), static_cast<BlendMode>(random() % 3),
+                   static_cast<uint16_t>(random() % layerCount) };
+    }
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+
+    SpriteBatch                 batch;
+    std::vector<SpriteInstance> serial(spriteCount);
+    std::vector<SpriteInstance> parallel(spriteCount);
+    size_t                      drawCount = 0;
+
+    for (const bool useJobs : { false, true }) {
+        std::vector<double> submitTimes, sortTimes, packTimes;
+        for (uint32_t frame = 0; frame < frameCount; ++frame) {
+            const auto t0 = Clock::now();
+            batch.clear();
+            for (const auto& sprite : sprites) {
+                batch.draw(sprite);
+            }
+            const auto t1 = Clock::now();
+            drawCount     = batch.build().size();
+            const auto t2 = Clock::now();
+            batch.pack(useJobs ? parallel.data() : serial.data(), useJobs ? &jobSystem : nullptr);
+            const auto t3 = Clock::now();
+
+            submitTimes.push_back(milliseconds(t0, t1));
+            sortTimes.push_back(milliseconds(t1, t2));
+            packTimes.push_back(milliseconds(t2, t3));
+        }
+        std::printf("%-8s sprites %u, draws %zu: submit %.2f ms, sort %.2f ms, pack %.2f ms\n", useJobs ? "parallel" : "serial",
+                    spriteCount, drawCount, median(submitTimes), median(sortTimes), median(packTimes));
+    }
+
+    if (std::memcmp(serial.data(), parallel.data(), serial.size() * sizeof(SpriteInstance)) != 0) {
+        std::fprintf(stderr, "parallel pack differs from serial pack\n");
+        return 1;
+    }
+
+    // \[gƔr\[g̔riL[gj
+    std::vector<uint64_t> keys(spriteCount);
+    for (uint32_t i = 0; i < spriteCount; ++i) {
+        const auto& sprite = sprites[i];
+        keys[i] = (uint64_t(sprite.layer) << 48) | (uint64_t(sprite.blend) << 44) | (uint64_t(sprite.texture) << 24) | i;
+    }
+    std::vector<uint64_t> radixKeys = keys;
+    std::vector<uint64_t> scratch(spriteCount);
+    const auto            r0 = Clock::now();
+    radixSort(radixKeys.data(), scratch.data(), radixKeys.size(), 24, 64);
+    const auto            r1 = Clock::now();
+    std::vector<uint64_t> stdKeys = keys;
+    std::stable_sort(stdKeys.begin(), stdKeys.end(), [](uint64_t a, uint64_t b) { return (a >> 24) < (b >> 24); });
+    const auto            r2 = Clock::now();
+    std::printf("radix sort %.2f ms, std::stable_sort %.2f ms, %s\n", milliseconds(r0, r1), milliseconds(r1, r2),
+                radixKeys == stdKeys ? "identical" : "MISMATCH");
+
+    return finish(radixKeys == stdKeys);
+}
@@ -0,0 +1,297 @@
+// gXtH[Kw̃x`}[N
+//
+// 100 m[h̖؂Atm[h̊ς update ̎Ԃ 1 XbhƃWuVXeőB
+// גiadd ̌̍ŏ updatejƁAGPU ɋl߂ writeGpuTransforms ̎ԂB
+// [hs̓m[hԍɐefɊ|ʂƃrbgPʂŔׁAvZtm[h̎q̐
+// v邱Ƃm߂Be̕tւEqƂ̍폜Eԍ̎g񂵂m߂
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -pthread -I.. transform_benchmark.cpp ../transform_hierarchy.cpp ../simd_math.cpp ../projection.cpp ../frustum_culling.cpp ../indirect_cull.cpp ../job_system.cpp -o transform_benchmark
+// s:
+//   tools/transform_benchmark [m[h]
+
+#include "bench_common.h"
+#include "transform_hierarchy.h"
+#include "job_system.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// 
+constexpr int Repeats = 7;
+
+/// ؂̍ő̐[
+constexpr uint32_t MaxDepth = 12;
+
+/// 
+std::mt19937 random(12345);
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̃gXtH[
+ */
+Transform randomTransform() {
+    std::uniform_real_distribution<float> signedUnit(-1.0f, 1.0f);
+    Transform                             transform;
+    transform.position = { signedUnit(random) * 10.0f, signedUnit(random) * 10.0f, signedUnit(random) * 10.0f };
+    transform.rotation = normalize(Quat{ signedUnit(random), signedUnit(random), signedUnit(random), signedUnit(random) });
+    transform.scale = Vec3(1.0f + signedUnit(random) * 0.1f);
+    return transform;
+}
+
+/// m߂鑤؁im[hԍňj
+struct Reference {
+    std::vector<uint32_t>  parents;  ///< ẽm[hԍ
+    std::vector<Transform> locals;   ///< [J̃gXtH[
+    std::vector<bool>      alive;    ///< gĂ邩
+};
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[hsefɋ߂
+ * @param	reference	m߂鑤̖
+ * @param	node		m[hԍ
+ * @param	worlds		߂[hsi߂ĂȂ m[3][3]  0j
+ */
+const Mat4& referenceWorld(const Reference& reference, uint32_t node, std::vector<Mat4>& worlds) {
+    if (worlds[node].m[3][3] == 0.0f) {
+        const Transform& local = reference.locals[node];
+        const Mat4       matrix = Mat4::trs(local.position, local.rotation, local.scale);
+        const uint32_t   parent = reference.parents[node];
+        worlds[node] = parent == TransformHierarchy::None ? matrix : referenceWorld(reference, parent, worlds) * matrix;
+    }
+    return worlds[node];
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	SẴm[h̃[hs񂪑fɋ߂ƃrbgPʂňv邩
+ */
+bool matchesReference(const TransformHierarchy& hierarchy, const Reference& reference) {
+    std::vector<Mat4> worlds(reference.parents.size());
+    uint32_t          aliveCount = 0;
+    for (uint32_t node = 0; node < reference.parents.size(); ++node) {
+        if (!reference.alive[node]) {
+            continue;
+        }
+        ++aliveCount;
+        if (std::memcmp(&hierarchy.world(node), &referenceWorld(reference, node, worlds), sizeof(Mat4)) != 0) {
+            return false;
+        }
+    }
+    return aliveCount == hierarchy.size();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	m[hԍɐeɍ郉_Ȗ؂
+ */
+void build(TransformHierarchy& hierarchy, Reference& reference, uint32_t nodeCount) {
+    const uint32_t        rootCount = std::max(nodeCount / 1000, 1u);
+    std::vector<uint32_t> depths;
+    hierarchy.reserve(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; ++i) {
+        uint32_t parent = TransformHierarchy::None;
+        if (i >= rootCount) {
+            // Õ̕m[heɑIт₷āA[U炷
+            parent = std::uniform_int_distribution<uint32_t>(i / 2, i - 1)(random);
+            if (depths[parent] + 1 >= MaxDepth) {
+                parent = std::uniform_int_distribution<uint32_t>(0, rootCount - 1)(random);
+            }
+        }
+        const Transform local = randomTransform();
+        const uint32_t  node = hierarchy.add(parent, local);
+        depths.push_back(parent == TransformHierarchy::None ? 0 : depths[parent] + 1);
+        reference.parents.push_back(parent);
+        reference.locals.push_back(local);
+        reference.alive.push_back(true);
+        if (node != i) {
+            std::printf("unexpected node id %u\n", node);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	tm[h̎q܂߂𐔂
+ */
+uint32_t countAffected(const Reference& reference, const std::vector<bool>& dirty) {
+    // ẽm[hԍ͎q菬̂ŁAԍɐěʂp
+    std::vector<bool> affected(reference.parents.size());
+    uint32_t          count = 0;
+    for (uint32_t node = 0; node < reference.parents.size(); ++node) {
+        const uint32_t parent = reference.parents[node];
+        affected[node] = dirty[node] || (parent != TransformHierarchy::None && affected[parent]);
+        count += affected[node] ? 1 : 0;
+    }
+    return count;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	_ɑI񂾃m[h̃[Jς
+ * @return	tm[h
+ */
+std::vector<bool> touch(TransformHierarchy& hierarchy, Reference& reference, double ratio) {
+    const uint32_t    nodeCount = static_cast<uint32_t>(reference.parents.size());
+    const uint32_t    touchCount = static_cast<uint32_t>(nodeCount * ratio);
+    std::vector<bool> dirty(nodeCount);
+    for (uint32_t i = 0; i < touchCount; ++i) {
+        const uint32_t node = ratio >= 1.0 ? i : std::uniform_int_distribution<uint32_t>(0, nodeCount - 1)(random);
+        reference.locals[node] = randomTransform();
+        hierarchy.setLocal(node, reference.locals[node]);
+        dirty[node] = true;
+    }
+    return dirty;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t nodeCount = argc > 1 ? static_cast<uint32_t>(std::atoi(argv[1])) : 1000000;
+
+    JobSystem jobSystem;
+    if (!jobSystem.create()) {
+        return 1;
+    }
+    std::printf("workers %u, %u nodes\n", jobSystem.workerCount(), nodeCount);
+    bool passed = true;
+
+    // ͑SČvZBג̎Ԃő
+    TransformHierarchy hierarchy;
+    Reference          reference;
+    build(hierarchy, reference, nodeCount);
+    auto           begin = Clock::now();
+    const uint32_t initial = hierarchy.update(&jobSystem);
+    const double   firstUpdateMs = milliseconds(begin, Clock::now());
+    {
+        const bool ok = initial == nodeCount && matchesReference(hierarchy, reference);
+        std::printf("%u depths, first update (sort + all) %.2f ms\n", hierarchy.depthCount(), firstUpdateMs);
+        passed = check(ok, "initial worlds") && passed;
+    }
+
+    // tqvZA1 XbhłłʂɂȂ
+    {
+        bool ok = true;
+        for (int pass = 0; pass < 4; ++pass) {
+            const std::vector<bool> dirty = touch(hierarchy, reference, 0.01);
+            const uint32_t          expected = countAffected(reference, dirty);
+            const uint32_t          updated = hierarchy.update(pass & 1 ? &jobSystem : nullptr);
+            ok = ok && updated == expected && matchesReference(hierarchy, reference);
+        }
+        ok = ok && hierarchy.update(&jobSystem) == 0;
+        passed = check(ok, "incremental") && passed;
+    }
+
+    // tւEqƂ̍폜Eԍ̎g
+    {
+        TransformHierarchy small;
+        Reference          smallReference;
+        build(small, smallReference, 2000);
+        small.update();
+        // qւ͕tւȂ
+        const uint32_t child = 1500;
+        uint32_t       ancestor = smallReference.parents[child];
+        while (smallReference.parents[ancestor] != TransformHierarchy::None) {
+            ancestor = smallReference.parents[ancestor];
+        }
+        bool ok = !small.setParent(ancestor, child) && !small.setParent(child, child);
+        // tւq͐VeɂĂ
+        ok = ok && small.setParent(child, 0);
+        smallReference.parents[child] = 0;
+        small.update(&jobSystem);
+        ok = ok && matchesReference(small, smallReference);
+
+        // qƏ
+        const uint32_t removed = 700;
+        small.remove(removed);
+        std::vector<bool> gone(2000);
+        gone[removed] = true;
+        for (uint32_t node = 0; node < 2000; ++node) {
+            const uint32_t parent = smallReference.parents[node];
+            gone[node] = gone[node] || (parent != TransformHierarchy::None && parent < node && gone[parent]);
+        }
+        // tւŐeqɂȂm[hE
+        for (bool changed = true; changed;) {
+            changed = false;
+            for (uint32_t node = 0; node < 2000; ++node) {
+                const uint32_t parent = smallReference.parents[node];
+                if (!gone[node] && parent != TransformHierarchy::None && gone[parent]) {
+                    gone[node] = changed = true;
+                }
+            }
+        }
+        uint32_t goneCount = 0;
+        for (uint32_t node = 0; node < 2000; ++node) {
+            smallReference.alive[node] = !gone[node];
+            goneCount += gone[node] ? 1 : 0;
+        }
+        small.update();
+        ok = ok && small.size() == 2000 - goneCount && matchesReference(small, smallReference);
+
+        // 󂢂ԍg񂵁AVm[h͐ẻɕt
+        const Transform local = randomTransform();
+        const uint32_t  reused = small.add(5, local);
+        ok = ok && reused < 2000 && gone[reused];
+        smallReference.parents[reused] = 5;
+        smallReference.locals[reused] = local;
+        smallReference.alive[reused] = true;
+        small.update(&jobSystem);
+        ok = ok && small.size() == 2000 - goneCount + 1 && matchesReference(small, smallReference);
+
+        // GPU ̕тłs
+        std::vector<GpuTransform> gpu(small.size());
+        ok = ok && small.writeGpuTransforms(gpu.data(), &jobSystem) == small.size();
+        for (uint32_t node = 0; node < 2000; ++node) {
+            if (smallReference.alive[node]) {
+                ok = ok && std::memcmp(gpu[small.gpuIndex(node)].rows, small.world(node).m, sizeof(GpuTransform)) == 0;
+            }
+        }
+        passed = check(ok, "structure changes") && passed;
+    }
+
+    // t銄Ƃ update ̎
+    const double ratios[] = { 0.0, 0.001, 0.01, 0.1, 1.0 };
+    std::printf("\n%-8s %10s %12s %12s\n", "dirty", "updated", "1 thread", "all threads");
+    for (const double ratio : ratios) {
+        std::vector<double> serialTimes;
+        std::vector<double> parallelTimes;
+        uint32_t            updated = 0;
+        for (int r = 0; r < Repeats; ++r) {
+            touch(hierarchy, reference, ratio);
+            begin = Clock::now();
+            updated = hierarchy.update();
+            serialTimes.push_back(milliseconds(begin, Clock::now()));
+
+            touch(hierarchy, reference, ratio);
+            begin = Clock::now();
+            hierarchy.update(&jobSystem);
+            parallelTimes.push_back(milliseconds(begin, Clock::now()));
+        }
+        std::printf("%6.1f %% %10u %9.3f ms %9.3f ms\n", ratio * 100.0, updated, median(serialTimes), median(parallelTimes));
+    }
+    passed = passed && matchesReference(hierarchy, reference);
+
+    // GPU ɋl߂
+    {
+        std::vector<GpuTransform> gpu(hierarchy.size());
+        std::vector<double>       serialTimes;
+        std::vector<double>       parallelTimes;
+        for (int r = 0; r < Repeats; ++r) {
+            begin = Clock::now();
+            hierarchy.writeGpuTransforms(gpu.data());
+            serialTimes.push_back(milliseconds(begin, Clock::now()));
+            begin = Clock::now();
+            hierarchy.writeGpuTransforms(gpu.data(), &jobSystem);
+            parallelTimes.push_back(milliseconds(begin, Clock::now()));
+        }
+        std::printf("%-8s %10u %9.3f ms %9.3f ms\n", "gpu pack", hierarchy.size(), median(serialTimes), median(parallelTimes));
+    }
+
+    return finish(passed);
+}
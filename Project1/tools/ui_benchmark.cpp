@@ -0,0 +1,210 @@
+// UI ob`ĩCAEgƎlp`̋lߍ݁j̃x`}[N
+//
+// t[APF̎lp`E񓯂ixjEς镶il\j UiBatch ɐς݁A
+// 1 t[ɂ CPU Ԃ𑪂BGPU ɓnOiUiRenderer  memcpy zj܂łΏہB
+// LbVԂCAEg layoutText ƈv邱ƁAӂꂽ邱ƁA
+// Ԃ̃t[Ńq[vmۂ 1 NȂƂm߂
+//
+// tHgnȂ΍tHggiAgX̒g͑ΏۂɊ֌WȂj
+//
+// rh (Linux):
+//   g++ -std=c++17 -O2 -I.. ui_benchmark.cpp ../ui_batch.cpp ../text_layout.cpp ../sdf_font.cpp -o ui_benchmark
+// s:
+//   tools/ui_benchmark [sdffont t@C] [t[]
+
+#include "bench_common.h"
+#include "sdf_font.h"
+#include "text_layout.h"
+#include "ui_batch.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// q[vmۂ̉񐔁ioperator new uĐj
+std::atomic<uint64_t> allocationCount{ 0 };
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ASCII ̓tHg
+ * @param	font	i[
+ */
+void makeSyntheticFont(SdfFont& font) {
+    constexpr uint32_t Cell = 16;
+    font.atlasWidth = 256;
+    font.atlasHeight = 128;
+    font.baseSize = 16.0f;
+    font.distanceRange = 4.0f;
+    font.lineHeight = 20.0f;
+    font.ascent = 15.0f;
+    font.atlas.assign(size_t(font.atlasWidth) * font.atlasHeight, 0);
+    font.glyphs.clear();
+    for (uint32_t c = 32; c < 127; ++c) {
+        const uint32_t i = c - 32;
+        SdfGlyph       glyph{};
+        glyph.codepoint = c;
+        glyph.x = static_cast<uint16_t>(i % 16 * Cell);
+        glyph.y = static_cast<uint16_t>(i / 16 * Cell);
+        glyph.width = c == ' ' ? 0 : 12;
+        glyph.height = c == ' ' ? 0 : 16;
+        glyph.offsetX = -2.0f;
+        glyph.offsetY = -14.0f;
+        glyph.advance = 9.0f;
+        font.glyphs.push_back(glyph);
+    }
+    indexSdfFontGlyphs(font);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	LbṼCAEg layoutText Ɠׂ
+ */
+bool isSameLayout(const TextLayout& layout, const SdfFont& font, const char* text, float size) {
+    std::vector<TextGlyph> expected(std::strlen(text));
+    float                  width = 0.0f;
+    float                  height = 0.0f;
+    const uint32_t         count = layoutText(font, text, size, expected.data(), uint32_t(expected.size()), width, height);
+    return count == layout.glyphCount && width == layout.width && height == layout.height &&
+           (count == 0 || std::memcmp(expected.data(), layout.glyphs, sizeof(TextGlyph) * count) == 0);
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+    ++allocationCount;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+int main(int argc, char** argv) {
+    SdfFont font;
+    if (argc > 1 && std::strcmp(argv[1], "-") != 0) {
+        if (!loadSdfFont(argv[1], font)) {
+            std::printf("cannot load %s\n", argv[1]);
+            return 1;
+        }
+    } else {
+        makeSyntheticFont(font);
+    }
+    const uint32_t measureFrames = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 300;
+    std::printf("font: %u glyphs, atlas %ux%u, base %.0f px\n", uint32_t(font.glyphs.size()), font.atlasWidth, font.atlasHeight, font.baseSize);
+
+    bool passed = true;
+
+    // LbVԂCAEg͒ڃCAEgƓ
+    {
+        TextLayoutCache cache;
+        if (!cache.create(16, 256, 256)) {
+            return 1;
+        }
+        const char* const texts[] = { "Hello, world", "two\nlines", "", "   ", "caf\xC3\xA9 \xE2\x82\xAC?" };
+        bool              same = true;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (const char* text : texts) {
+                same = same && isSameLayout(cache.get(font, text, 24.0f), font, text, 24.0f);
+            }
+        }
+        same = same && cache.statistics().hits == 5 && cache.statistics().misses == 5;
+        // 傫ႦΕʂ̃CAEg
+        same = same && isSameLayout(cache.get(font, "Hello, world", 12.0f), font, "Hello, world", 12.0f);
+        // eʂ𒴂鐔ƑSĎ̂ĂĂ蒼
+        char buffer[32];
+        for (int i = 0; i < 40; ++i) {
+            std::snprintf(buffer, sizeof(buffer), "item %d", i);
+            same = same && isSameLayout(cache.get(font, buffer, 16.0f), font, buffer, 16.0f);
+        }
+        same = same && cache.statistics().resets > 0;
+        // eʂ蒷͊oȂCAEg͕Ԃ
+        const std::string longText(300, 'x');
+        const TextLayout  layout = cache.get(font, longText, 16.0f);
+        same = same && layout.glyphCount == 256;
+        passed = check(same, "layout cache") && passed;
+    }
+
+    // z񂩂炠ӂꂽ͕`ɐ
+    {
+        UiBatch batch;
+        if (!batch.create(8)) {
+            return 1;
+        }
+        batch.setFont(&font);
+        batch.rect(0.0f, 0.0f, 10.0f, 10.0f, 0xFFFFFFFF);
+        batch.text(0.0f, 0.0f, "abcdefghij", 16.0f, 0xFFFFFFFF);
+        const bool dropped = batch.quadCount() == 8 && batch.droppedCount() == 3;
+        passed = check(dropped, "overflow") && passed;
+    }
+
+    // 1 t[ UI: pl 200 Ax 100 At[ς鐔l 20 
+    constexpr uint32_t RectCount = 200;
+    constexpr uint32_t LabelCount = 100;
+    constexpr uint32_t ValueCount = 20;
+    std::vector<std::string> labels;
+    for (uint32_t i = 0; i < LabelCount; ++i) {
+        labels.push_back("Setting " + std::to_string(i) + ": Shadow Quality");
+    }
+
+    UiBatch batch;
+    if (!batch.create(16384)) {
+        return 1;
+    }
+    batch.setFont(&font);
+    std::vector<double> frameTimes;
+    frameTimes.reserve(measureFrames);
+
+    const auto buildFrame = [&](uint32_t frame) {
+        batch.clear();
+        for (uint32_t i = 0; i < RectCount; ++i) {
+            batch.rect(float(i % 20) * 60.0f, float(i / 20) * 30.0f, 56.0f, 26.0f, 0xC0202020);
+        }
+        for (uint32_t i = 0; i < LabelCount; ++i) {
+            batch.text(8.0f, float(i) * 20.0f, labels[i], 16.0f, 0xFFFFFFFF);
+        }
+        char buffer[64];
+        for (uint32_t i = 0; i < ValueCount; ++i) {
+            std::snprintf(buffer, sizeof(buffer), "%.2f ms", double(frame * ValueCount + i) * 0.01);
+            batch.text(600.0f, float(i) * 20.0f, buffer, 16.0f, 0xFF00FFFF);
+        }
+    };
+
+    // ŏ̐t[ŃCAEgLbVɓ
+    for (uint32_t frame = 0; frame < 10; ++frame) {
+        buildFrame(frame);
+    }
+    const TextLayoutCache::Statistics before = batch.layoutCache().statistics();
+    const uint64_t                    allocationsBefore = allocationCount.load();
+    for (uint32_t frame = 10; frame < 10 + measureFrames; ++frame) {
+        const auto begin = Clock::now();
+        buildFrame(frame);
+        frameTimes.push_back(milliseconds(begin, Clock::now()));
+    }
+    const uint64_t allocations = allocationCount.load() - allocationsBefore;
+    const auto&    after = batch.layoutCache().statistics();
+
+    const double frameMs = median(frameTimes);
+    std::printf("\nframe: %u rects, %u labels, %u dynamic strings -> %u quads (%u dropped), 1 draw\n", RectCount, LabelCount, ValueCount,
+                batch.quadCount(), batch.droppedCount());
+    std::printf("  build %8.4f ms/frame (median of %u), %.1f ns/quad, upload %u KB\n", frameMs, measureFrames,
+                frameMs * 1.0e6 / batch.quadCount(), uint32_t(batch.quadCount() * sizeof(UiQuad) / 1024));
+    std::printf("  cache hits %llu, misses %llu, resets %llu\n", (unsigned long long)(after.hits - before.hits),
+                (unsigned long long)(after.misses - before.misses), (unsigned long long)(after.resets - before.resets));
+    std::printf("  heap allocations in steady state: %llu\n", (unsigned long long)allocations);
+    passed = passed && allocations == 0 && batch.droppedCount() == 0;
+
+    return finish(passed);
+}
@@ -0,0 +1,350 @@
+// gXtH[KwNX
+
+#include "transform_hierarchy.h"
+#include "job_system.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstring>
+
+namespace {
+
+/// 1 ̕񏈗Ŏ󂯎m[h
+constexpr uint32_t GrainSize = 4096;
+
+/// [J̃gXtH[ςiupdate ́u[hsvZvj
+constexpr uint8_t Dirty = 1;
+/// 폜҂Ă
+constexpr uint8_t Removed = 2;
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	zVтɕבւ
+ * @param	values	ziבւƓւj
+ * @param	order	VʒuƂ̌̈ʒu
+ */
+template <typename T>
+void permute(std::vector<T>& values, const std::vector<uint32_t>& order) {
+    std::vector<T> sorted(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        sorted[i] = values[order[i]];
+    }
+    values.swap(sorted);
+}
+
+}  // namespace
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	z̗eʂmۂ
+ * @param	capacity	m[h
+ */
+void TransformHierarchy::reserve(uint32_t capacity) {
+    positions_.reserve(capacity);
+    rotations_.reserve(capacity);
+    scales_.reserve(capacity);
+    worlds_.reserve(capacity);
+    parents_.reserve(capacity);
+    flags_.reserve(capacity);
+    nodes_.reserve(capacity);
+    slots_.reserve(capacity);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	m[hǉ
+ * @param	parent	ẽm[hԍiNone Ȃ烋[gj
+ * @param	local	[J̃gXtH[
+ * @return	m[hԍi폜ꂽm[h̔ԍg񂷁j
+ */
+uint32_t TransformHierarchy::add(uint32_t parent, const Transform& local) {
+    assert(parent == None || (parent < slots_.size() && slots_[parent] != None));
+
+    // ג܂ł͖ɒu
+    const uint32_t slot = static_cast<uint32_t>(positions_.size());
+    positions_.push_back(local.position);
+    rotations_.push_back(local.rotation);
+    scales_.push_back(local.scale);
+    worlds_.emplace_back();
+    parents_.push_back(parent == None ? None : slots_[parent]);
+    flags_.push_back(Dirty);
+
+    uint32_t node;
+    if (!freeNodes_.empty()) {
+        node = freeNodes_.back();
+        freeNodes_.pop_back();
+        slots_[node] = slot;
+    }
+    else {
+        node = static_cast<uint32_t>(slots_.size());
+        slots_.push_back(slot);
+    }
+    nodes_.push_back(node);
+    structureChanged_ = true;
+    return node;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	m[hqƍ폜iԍ͎ update ŋ󂭁j
+ * @param	node	m[hԍ
+ */
+void TransformHierarchy::remove(uint32_t node) noexcept {
+    assert(node < slots_.size() && slots_[node] != None);
+    // q͕גɐeHȂȂ̂ňꏏɏ
+    flags_[slots_[node]] |= Removed;
+    structureChanged_ = true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	etւ
+ * @param	node	m[hԍ
+ * @param	parent	Vẽm[hԍiNone Ȃ烋[gj
+ * @return	tւ trueiparent  node g̎qȂ牽 falsej
+ */
+bool TransformHierarchy::setParent(uint32_t node, uint32_t parent) noexcept {
+    assert(node < slots_.size() && slots_[node] != None);
+    const uint32_t slot = slots_[node];
+    const uint32_t parentSlot = parent == None ? None : slots_[parent];
+
+    // VecH node ɒւɂȂ
+    for (uint32_t ancestor = parentSlot; ancestor != None; ancestor = parents_[ancestor]) {
+        if (ancestor == slot) {
+            return false;
+        }
+    }
+    parents_[slot] = parentSlot;
+    flags_[slot] |= Dirty;
+    structureChanged_ = true;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[J̃gXtH[ݒ肷i update Ŏqƃ[hsvZj
+ * @param	node	m[hԍ
+ * @param	local	[J̃gXtH[
+ */
+void TransformHierarchy::setLocal(uint32_t node, const Transform& local) noexcept {
+    assert(node < slots_.size() && slots_[node] != None);
+    const uint32_t slot = slots_[node];
+    positions_[slot] = local.position;
+    rotations_[slot] = local.rotation;
+    scales_[slot] = local.scale;
+    markDirty(slot);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[J̃gXtH[擾
+ * @param	node	m[hԍ
+ * @return	[J̃gXtH[
+ */
+Transform TransformHierarchy::local(uint32_t node) const noexcept {
+    const uint32_t slot = slots_[node];
+    return { positions_[slot], rotations_[slot], scales_[slot] };
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[hs擾iupdate ̌̒lj
+ * @param	node	m[hԍ
+ * @return	[hs
+ */
+const Mat4& TransformHierarchy::world(uint32_t node) const noexcept {
+    return worlds_[slots_[node]];
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[hsvZ
+ * @param	jobSystem	ɏꍇ̃WuVXeinullptr ȂĂяoXbhŏj
+ * @return	vZm[h
+ */
+uint32_t TransformHierarchy::update(JobSystem* jobSystem) {
+    if (structureChanged_) {
+        sortByDepth();
+    }
+
+    // ̖󂢐[͔΂B[ d vZ鎞 d - 1 ̈ueςvƂēǂ݁A
+    // d IĂ d - 1 ̈
+    const uint32_t        depths = depthCount();
+    const uint32_t        first = std::min(firstDirtyLevel_, depths);
+    std::atomic<uint32_t> updated{};
+    for (uint32_t depth = first; depth < depths; ++depth) {
+        const uint32_t levelBegin = levels_[depth];
+        const uint32_t levelEnd = levels_[depth + 1];
+        const auto     compute = [&](uint32_t begin, uint32_t end) {
+            uint32_t count = 0;
+            for (uint32_t slot = levelBegin + begin; slot < levelBegin + end; ++slot) {
+                const uint32_t parent = parents_[slot];
+                if (!((flags_[slot] | (parent == None ? 0 : flags_[parent])) & Dirty)) {
+                    continue;
+                }
+                const Mat4 local = Mat4::trs(positions_[slot], rotations_[slot], scales_[slot]);
+                worlds_[slot] = parent == None ? local : worlds_[parent] * local;
+                flags_[slot] = Dirty;
+                ++count;
+            }
+            updated.fetch_add(count, std::memory_order_relaxed);
+        };
+        if (jobSystem) {
+            jobSystem->parallelFor(levelEnd - levelBegin, GrainSize, compute);
+        }
+        else {
+            compute(0, levelEnd - levelBegin);
+        }
+        if (depth > first) {
+            std::fill(flags_.begin() + levels_[depth - 1], flags_.begin() + levelBegin, uint8_t(0));
+        }
+    }
+    if (first < depths) {
+        std::fill(flags_.begin() + levels_[depths - 1], flags_.end(), uint8_t(0));
+    }
+    firstDirtyLevel_ = UINT32_MAX;
+    return updated.load();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[hs GPU ɋl߂ďށiupdate ̌ɌĂԁj
+ * @param	out			ݐisize() BAbv[hq[v Map ł悢j
+ * @param	jobSystem	ɏꍇ̃WuVXe
+ * @return	񂾐
+ */
+uint32_t TransformHierarchy::writeGpuTransforms(GpuTransform* out, JobSystem* jobSystem) const {
+    assert(!structureChanged_);
+    const uint32_t count = size();
+    const auto     write = [&](uint32_t begin, uint32_t end) {
+        for (uint32_t slot = begin; slot < end; ++slot) {
+            // 4 sڂ͏ (0, 0, 0, 1) Ȃ̂őȂ
+            std::memcpy(out[slot].rows, worlds_[slot].m, sizeof(GpuTransform));
+        }
+    };
+    if (jobSystem) {
+        jobSystem->parallelFor(count, GrainSize, write);
+    }
+    else {
+        write(0, count);
+    }
+    return count;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	writeGpuTransforms ŏ̃m[ḧʒu擾
+ * @param	node	m[hԍ
+ * @return	ʒuiadd / remove / setParent ̌ update ŕςj
+ */
+uint32_t TransformHierarchy::gpuIndex(uint32_t node) const noexcept {
+    return slots_[node];
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	m[h擾iupdate ̌̒lj
+ * @return	m[h
+ */
+uint32_t TransformHierarchy::size() const noexcept {
+    return levels_.back();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	[̐擾iupdate ̌̒lB[gȂ 1j
+ * @return	[̐
+ */
+uint32_t TransformHierarchy::depthCount() const noexcept {
+    return static_cast<uint32_t>(levels_.size() - 1);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	폜ꂽm[hAz[ɕג
+ */
+void TransformHierarchy::sortByDepth() {
+    const uint32_t count = static_cast<uint32_t>(positions_.size());
+
+    // eƂ̎q̕
+    std::vector<uint32_t> childOffsets(count + 1);
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        if (parents_[slot] != None) {
+            ++childOffsets[parents_[slot] + 1];
+        }
+    }
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        childOffsets[slot + 1] += childOffsets[slot];
+    }
+    std::vector<uint32_t> children(childOffsets[count]);
+    {
+        std::vector<uint32_t> cursor(childOffsets.begin(), childOffsets.end() - 1);
+        for (uint32_t slot = 0; slot < count; ++slot) {
+            if (parents_[slot] != None) {
+                children[cursor[parents_[slot]]++] = slot;
+            }
+        }
+    }
+
+    // [g[ƂɒHB폜ꂽm[h̎q͒HȂ̂ňꏏɗ
+    std::vector<uint32_t> order;
+    order.reserve(count);
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        if (parents_[slot] == None && !(flags_[slot] & Removed)) {
+            order.push_back(slot);
+        }
+    }
+    levels_.assign(1, 0);
+    for (uint32_t begin = 0; begin < order.size();) {
+        const uint32_t end = static_cast<uint32_t>(order.size());
+        for (uint32_t i = begin; i < end; ++i) {
+            for (uint32_t c = childOffsets[order[i]]; c < childOffsets[order[i] + 1]; ++c) {
+                if (!(flags_[children[c]] & Removed)) {
+                    order.push_back(children[c]);
+                }
+            }
+        }
+        levels_.push_back(end);
+        begin = end;
+    }
+
+    // HȂm[h̔ԍ󂯂
+    std::vector<uint32_t> remap(count, None);
+    for (uint32_t i = 0; i < order.size(); ++i) {
+        remap[order[i]] = i;
+    }
+    for (uint32_t slot = 0; slot < count; ++slot) {
+        if (remap[slot] == None) {
+            slots_[nodes_[slot]] = None;
+            freeNodes_.push_back(nodes_[slot]);
+        }
+    }
+
+    permute(positions_, order);
+    permute(rotations_, order);
+    permute(scales_, order);
+    permute(worlds_, order);
+    permute(flags_, order);
+    permute(nodes_, order);
+    permute(parents_, order);
+    for (uint32_t& parent : parents_) {
+        parent = parent == None ? None : remap[parent];
+    }
+    for (uint32_t slot = 0; slot < order.size(); ++slot) {
+        slots_[nodes_[slot]] = slot;
+    }
+    firstDirtyLevel_ = 0;
+    structureChanged_ = false;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	z̈ʒuɈt
+ */
+void TransformHierarchy::markDirty(uint32_t slot) noexcept {
+    flags_[slot] |= Dirty;
+    if (!structureChanged_) {
+        const uint32_t depth = static_cast<uint32_t>(std::upper_bound(levels_.begin(), levels_.end(), slot) - levels_.begin()) - 1;
+        firstDirtyLevel_ = std::min(firstDirtyLevel_, depth);
+    }
+}
@@ -0,0 +1,159 @@
+// gXtH[KwNX
+
+#pragma once
+
+#include "simd_math.h"
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+/// [J̃gXtH[ie猩ʒuE]Egj
+struct Transform {
+    Vec3 position{};            ///< ʒu
+    Quat rotation{};            ///< ]
+    Vec3 scale{ 1.0f };         ///< g
+};
+
+/// GPU ɓn[hsisD 3x4BInstanceData::transform Ɠ INSTANCE_DATA0`2 ̕сj
+struct GpuTransform {
+    float rows[3][4];  ///< [hs 0`2 s
+};
+static_assert(sizeof(GpuTransform) == 48, "INSTANCE_DATA0`2 ̃CAEgƂĂ܂");
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	gXtH[KwNX
+ * @details	m[ḧʒuE]EgE[hsEe𐬕Ƃ̔ziSoAjɎA[i[̒ł͐ȅjɕׂ
+ *			e͕KO̐[ɂ̂ŁA[ƂɑO珇ɌvZΐẽ[hs͋܂Ă
+ *			[̃m[h݂͌ɓƗȂ̂ŁA[ƂɃWuVXeŕɌvZ
+ *			setLocal ňtm[hƁA[hs񂪕ςem[hvZ
+ *			m[h̔ԍ͒ǉ폜܂ŕςȂBz̕ג add / remove / setParent ̌ update ł܂Ƃ߂čs
+ */
+class TransformHierarchy final {
+public:
+    /// eƂ\ԍ
+    static constexpr uint32_t None = UINT32_MAX;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	z̗eʂmۂ
+     * @param	capacity	m[h
+     */
+    void reserve(uint32_t capacity);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	m[hǉ
+     * @param	parent	ẽm[hԍiNone Ȃ烋[gj
+     * @param	local	[J̃gXtH[
+     * @return	m[hԍi폜ꂽm[h̔ԍg񂷁j
+     */
+    uint32_t add(uint32_t parent, const Transform& local = {});
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	m[hqƍ폜iԍ͎ update ŋ󂭁j
+     * @param	node	m[hԍ
+     */
+    void remove(uint32_t node) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	etւ
+     * @param	node	m[hԍ
+     * @param	parent	Vẽm[hԍiNone Ȃ烋[gj
+     * @return	tւ trueiparent  node g̎qȂ牽 falsej
+     */
+    [[nodiscard]] bool setParent(uint32_t node, uint32_t parent) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[J̃gXtH[ݒ肷i update Ŏqƃ[hsvZj
+     * @param	node	m[hԍ
+     * @param	local	[J̃gXtH[
+     */
+    void setLocal(uint32_t node, const Transform& local) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[J̃gXtH[擾
+     * @param	node	m[hԍ
+     * @return	[J̃gXtH[
+     */
+    [[nodiscard]] Transform local(uint32_t node) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[hs擾iupdate ̌̒lj
+     * @param	node	m[hԍ
+     * @return	[hs
+     */
+    [[nodiscard]] const Mat4& world(uint32_t node) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[hsvZ
+     * @param	jobSystem	ɏꍇ̃WuVXeinullptr ȂĂяoXbhŏj
+     * @return	vZm[h
+     */
+    uint32_t update(JobSystem* jobSystem = nullptr);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[hs GPU ɋl߂ďށiupdate ̌ɌĂԁj
+     * @param	out			ݐisize() BAbv[hq[v Map ł悢j
+     * @param	jobSystem	ɏꍇ̃WuVXe
+     * @return	񂾐
+     * @details	[̔z̕тŏBm[ḧʒu gpuIndex ŋ߂
+     */
+    uint32_t writeGpuTransforms(GpuTransform* out, JobSystem* jobSystem = nullptr) const;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	writeGpuTransforms ŏ̃m[ḧʒu擾
+     * @param	node	m[hԍ
+     * @return	ʒuiadd / remove / setParent ̌ update ŕςj
+     */
+    [[nodiscard]] uint32_t gpuIndex(uint32_t node) const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	m[h擾iupdate ̌̒lj
+     * @return	m[h
+     */
+    [[nodiscard]] uint32_t size() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	[̐擾iupdate ̌̒lB[gȂ 1j
+     * @return	[̐
+     */
+    [[nodiscard]] uint32_t depthCount() const noexcept;
+
+private:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	폜ꂽm[hAz[ɕג
+     */
+    void sortByDepth();
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	z̈ʒuɈt
+     */
+    void markDirty(uint32_t slot) noexcept;
+
+    std::vector<Vec3>     positions_{};         /// z̈ʒuƂ̃[J̈ʒu
+    std::vector<Quat>     rotations_{};         /// z̈ʒuƂ̃[J̉]
+    std::vector<Vec3>     scales_{};            /// z̈ʒuƂ̃[J̊g
+    std::vector<Mat4>     worlds_{};            /// z̈ʒuƂ̃[hs
+    std::vector<uint32_t> parents_{};           /// z̈ʒuƂ̐ëʒui[g Nonej
+    std::vector<uint8_t>  flags_{};             /// z̈ʒuƂ̈iDirty / Removedj
+    std::vector<uint32_t> nodes_{};             /// z̈ʒum[hԍ
+    std::vector<uint32_t> slots_{};             /// m[hԍz̈ʒui󂫔ԍ Nonej
+    std::vector<uint32_t> freeNodes_{};         /// 󂢂Ăm[hԍ
+    std::vector<uint32_t> levels_{ 0 };         /// [Ƃ̊Jnʒui͑Ŝ̐j
+    uint32_t              firstDirtyLevel_{};   /// ̕tm[hł󂢐[
+    bool                  structureChanged_{};  /// גKv
+};
@@ -0,0 +1,167 @@
+// UI ob`NX
+
+#include "ui_batch.h"
+#include <cassert>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	maxQuads		1 t[ɕ`ő̎lp`
+ * @param	maxLayouts		CAEgoĂ镶̐
+ * @param	maxLayoutGlyphs	CAEgoĂ镶̑
+ * @return	 true
+ */
+[[nodiscard]] bool UiBatch::create(uint32_t maxQuads, uint32_t maxLayouts, uint32_t maxLayoutGlyphs) {
+    if (maxQuads == 0) {
+        assert(false && "UI ̍őlp` 0 ł");
+        return false;
+    }
+    quads_.assign(maxQuads, UiQuad{});
+    clear();
+    // ̃oCg͕ȏȂ̂ŁAĂ
+    return layoutCache_.create(maxLayouts, maxLayoutGlyphs, maxLayoutGlyphs);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ɎgtHgݒ肷
+ * @param	font	tHg
+ */
+void UiBatch::setFont(const SdfFont* font) noexcept {
+    font_ = font;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t[̎lp`SĎ̂Ăimۍς݂̗eʂ͎cj
+ */
+void UiBatch::clear() noexcept {
+    quadCount_ = 0;
+    droppedCount_ = 0;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	PF̎lp`ǉ
+ * @param	x		 X WisNZj
+ * @param	y		 Y W
+ * @param	width	
+ * @param	height	
+ * @param	color	F (0xAABBGGRR)
+ */
+void UiBatch::rect(float x, float y, float width, float height, uint32_t color) noexcept {
+    if (quadCount_ == quads_.size()) {
+        ++droppedCount_;
+        return;
+    }
+    quads_[quadCount_++] = { { x, y, x + width, y + height }, { 0.0f, 0.0f, 0.0f, 0.0f }, color, 0.0f };
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ǉ
+ * @param	x		 X WisNZj
+ * @param	y		 Y W
+ * @param	text	UTF-8 ̕
+ * @param	size	̑傫isNZj
+ * @param	color	F (0xAABBGGRR)
+ * @return	̕
+ */
+float UiBatch::text(float x, float y, std::string_view text, float size, uint32_t color) noexcept {
+    if (!font_) {
+        return 0.0f;
+    }
+    const TextLayout layout = layoutCache_.get(*font_, text, size);
+
+    // ͕̑̕傫ɔႵĉʏōL
+    const float    sdfRange = font_->distanceRange * size / font_->baseSize;
+    const uint32_t room = static_cast<uint32_t>(quads_.size()) - quadCount_;
+    const uint32_t count = layout.glyphCount < room ? layout.glyphCount : room;
+    for (uint32_t i = 0; i < count; ++i) {
+        const TextGlyph& glyph = layout.glyphs[i];
+        UiQuad&          quad = quads_[quadCount_ + i];
+        quad.rect[0] = x + glyph.rect[0];
+        quad.rect[1] = y + glyph.rect[1];
+        quad.rect[2] = x + glyph.rect[2];
+        quad.rect[3] = y + glyph.rect[3];
+        quad.uv[0] = glyph.uv[0];
+        quad.uv[1] = glyph.uv[1];
+        quad.uv[2] = glyph.uv[2];
+        quad.uv[3] = glyph.uv[3];
+        quad.color = color;
+        quad.sdfRange = sdfRange;
+    }
+    quadCount_ += count;
+    droppedCount_ += layout.glyphCount - count;
+    return layout.width;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̑傫𑪂
+ * @param	text	UTF-8 ̕
+ * @param	size	̑傫isNZj
+ * @param	width	̊i[
+ * @param	height	̊i[
+ */
+void UiBatch::measure(std::string_view text, float size, float& width, float& height) noexcept {
+    if (!font_) {
+        width = height = 0.0f;
+        return;
+    }
+    const TextLayout layout = layoutCache_.get(*font_, text, size);
+    width = layout.width;
+    height = layout.height;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ǉꂽlp`擾
+ * @return	Ă񂾏̎lp`
+ */
+[[nodiscard]] const UiQuad* UiBatch::quads() const noexcept {
+    return quads_.data();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	ǉꂽlp`̐擾
+ * @return	lp`̐
+ */
+[[nodiscard]] uint32_t UiBatch::quadCount() const noexcept {
+    return quadCount_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̃t[ɂӂĕ`Ȃlp`̐擾
+ * @return	lp`̐
+ */
+[[nodiscard]] uint32_t UiBatch::droppedCount() const noexcept {
+    return droppedCount_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	CAEg̃LbV擾
+ * @return	LbV
+ */
+[[nodiscard]] const TextLayoutCache& UiBatch::layoutCache() const noexcept {
+    return layoutCache_;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	UI ̒_CAEg擾
+ * @param	slot	̓Xbg
+ * @return	_CAEg
+ */
+[[nodiscard]] std::vector<PipelineInputElement> UiBatch::inputLayout(uint32_t slot) {
+    // DXGI_FORMAT_R32G32B32A32_FLOAT / R8G8B8A8_UNORM / R32_FLOATiXgCh UiQuad  40 oCgj
+    return {
+        { "QUAD_RECT", 0, 2, slot, PipelineStateDesc::AppendAligned, true, 1 },
+        { "QUAD_UV", 0, 2, slot, PipelineStateDesc::AppendAligned, true, 1 },
+        { "QUAD_COLOR", 0, 28, slot, PipelineStateDesc::AppendAligned, true, 1 },
+        { "QUAD_SDF_RANGE", 0, 41, slot, PipelineStateDesc::AppendAligned, true, 1 },
+    };
+}
@@ -0,0 +1,127 @@
+// UI ob`NX
+
+#pragma once
+
+#include "pipeline_state_desc.h"
+#include "text_layout.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/// GPU ɓn 1 lp`̃CX^Xf[^iQUAD_RECT / UV / COLOR / SDF_RANGEj
+struct UiQuad {
+    float    rect[4];   ///<  XY ƉE XYisNZA㌴_j
+    float    uv[4];     ///< AgX̃eNX`W
+    uint32_t color;     ///< F (0xAABBGGRR)
+    float    sdfRange;  ///< 0 ȂPFAȂAgX̒l 0`1 \̕iʂ̃sNZj
+};
+static_assert(sizeof(UiQuad) == 40, "UI ̒_CAEgƂĂ܂");
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	UI ob`NX
+ * @details	lp`ƕt[ɌĂ񂾏̂܂ 1 {̔zɋl߁A1 ̕`ŕ`
+ *			̃CAEg TextLayoutCache ɊoĂAE傫Ȃg
+ *			z create ŊmۂAӂꂽ͕`ɐ邾Ȃ̂ŁAt[̃q[vmۂ͋NȂ
+ */
+class UiBatch final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	maxQuads		1 t[ɕ`ő̎lp`
+     * @param	maxLayouts		CAEgoĂ镶̐
+     * @param	maxLayoutGlyphs	CAEgoĂ镶̑
+     * @return	 true
+     */
+    [[nodiscard]] bool create(uint32_t maxQuads, uint32_t maxLayouts = 1024, uint32_t maxLayoutGlyphs = 65536);
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ɎgtHgݒ肷iUiRenderer ɓnAgXƓ́j
+     * @param	font	tHginullptr Ȃ當͕`Ȃj
+     */
+    void setFont(const SdfFont* font) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	t[̎lp`SĎ̂Ăimۍς݂̗eʂ͎cj
+     */
+    void clear() noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	PF̎lp`ǉ
+     * @param	x		 X WisNZj
+     * @param	y		 Y W
+     * @param	width	
+     * @param	height	
+     * @param	color	F (0xAABBGGRR)
+     */
+    void rect(float x, float y, float width, float height, uint32_t color) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ǉ
+     * @param	x		 X WisNZj
+     * @param	y		 Y Wi1 sڂ̏[j
+     * @param	text	UTF-8 ̕i'\n' ŉsj
+     * @param	size	̑傫isNZj
+     * @param	color	F (0xAABBGGRR)
+     * @return	̕
+     */
+    float text(float x, float y, std::string_view text, float size, uint32_t color) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̑傫𑪂i`ȂBCAEg̓LbVɓj
+     * @param	text	UTF-8 ̕
+     * @param	size	̑傫isNZj
+     * @param	width	̊i[
+     * @param	height	̊i[
+     */
+    void measure(std::string_view text, float size, float& width, float& height) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ǉꂽlp`擾
+     * @return	Ă񂾏̎lp`
+     */
+    [[nodiscard]] const UiQuad* quads() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	ǉꂽlp`̐擾
+     * @return	lp`̐
+     */
+    [[nodiscard]] uint32_t quadCount() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̃t[ɂӂĕ`Ȃlp`̐擾
+     * @return	lp`̐
+     */
+    [[nodiscard]] uint32_t droppedCount() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	CAEg̃LbV擾
+     * @return	LbV
+     */
+    [[nodiscard]] const TextLayoutCache& layoutCache() const noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	UI ̒_CAEg擾
+     * @param	slot	̓Xbg
+     * @return	_CAEgiSăCX^XPʁj
+     */
+    [[nodiscard]] static std::vector<PipelineInputElement> inputLayout(uint32_t slot = 0);
+
+private:
+    std::vector<UiQuad> quads_{};         /// Ă񂾏̎lp`ieʂ create Ŋmہj
+    uint32_t            quadCount_{};     /// gĂlp`̐
+    uint32_t            droppedCount_{};  /// ӂꂽlp`̐
+    const SdfFont*      font_{};          /// ̃tHg
+    TextLayoutCache     layoutCache_{};   /// CAEg̃LbV
+};
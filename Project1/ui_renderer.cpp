@@ -0,0 +1,222 @@
+// UI `NX
+
+#include "ui_renderer.h"
+#include "pipline_state_object.h"
+#include "root_signature_builder.h"
+#include <cassert>
+#include <cstring>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+UiRenderer::~UiRenderer() {
+    releaseAtlas();
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	쐬
+ * @param	device				foCXNX̃CX^X
+ * @param	rootSignatureCache	[gVOl`LbV
+ * @param	pipelineCache		pCvCXe[gLbV
+ * @param	maxQuads			1 t[ɕ`ő̎lp`
+ * @param	frameCount			 GPU QƂt[
+ * @param	renderTargetFormat	`ރ_[^[Qbǧ`
+ * @return	 true
+ */
+[[nodiscard]] bool UiRenderer::create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache, uint32_t maxQuads,
+                                      uint32_t frameCount, DXGI_FORMAT renderTargetFormat) noexcept {
+    if (!shader_.create(device, L"asset/ui.hlsl", {})) {
+        return false;
+    }
+
+    // b0: r[|[g̋ti[g萔j, t0: AgX, s0: jATv[
+    RootSignatureBuilder builder;
+    builder.addConstants(2, 0, 0, D3D12_SHADER_VISIBILITY_VERTEX)
+        .addTable({ { D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0 } }, D3D12_SHADER_VISIBILITY_PIXEL)
+        .addStaticSampler(0, D3D12_FILTER_MIN_MAG_MIP_LINEAR, D3D12_TEXTURE_ADDRESS_MODE_CLAMP);
+    rootSignature_ = rootSignatureCache.getOrCreate(device, builder);
+    if (!rootSignature_) {
+        return false;
+    }
+
+    PipelineStateDesc desc = PiplineStateObject::defaultDesc();
+    desc.inputLayout = UiBatch::inputLayout();
+    desc.blend = BlendMode::Alpha;
+    desc.cull = CullMode::None;
+    desc.depth = DepthMode::Disabled;
+    desc.depthStencilFormat = 0;
+    desc.renderTargetFormats[0] = static_cast<uint32_t>(renderTargetFormat);
+    pipelineCache_ = &pipelineCache;
+    pipeline_ = pipelineCache.request(desc, shader_, *rootSignature_);
+
+    // tHgĂ`悤Aŏ͉ SRV uĂiǂނ 0j
+    if (!srvHeap_.create(device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 1, true)) {
+        return false;
+    }
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+    srvDesc.Format = DXGI_FORMAT_R8_UNORM;
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.Texture2D.MipLevels = 1;
+    device.get()->CreateShaderResourceView(nullptr, &srvDesc, srvHeap_.get()->GetCPUDescriptorHandleForHeapStart());
+
+    return ring_.create(device, uint64_t(sizeof(UiQuad)) * maxQuads, frameCount);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̃AgX
+ * @param	device	foCXNX̃CX^X
+ * @param	font	tHg
+ * @return	 true
+ * @details	ÕAgX͉̂ŁAGPU gIĂĂ
+ */
+[[nodiscard]] bool UiRenderer::setFont(const Device& device, const SdfFont& font) noexcept {
+    assert(rootSignature_ && "UI `悪쐬ł");
+    assert(font.atlas.size() == size_t(font.atlasWidth) * font.atlasHeight);
+    releaseAtlas();
+    auto* d3dDevice = device.get();
+
+    D3D12_HEAP_PROPERTIES heapProps{};
+    heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
+
+    D3D12_RESOURCE_DESC resDesc{};
+    resDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    resDesc.Width = font.atlasWidth;
+    resDesc.Height = font.atlasHeight;
+    resDesc.DepthOrArraySize = 1;
+    resDesc.MipLevels = 1;
+    resDesc.Format = DXGI_FORMAT_R8_UNORM;
+    resDesc.SampleDesc.Count = 1;
+    resDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
+    if (FAILED(d3dDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr,
+                                                  IID_PPV_ARGS(&atlas_)))) {
+        assert(false && "AgX̍쐬Ɏs");
+        return false;
+    }
+
+    // s̕т 256 oCgEɑKv̂ŁAzu₢킹 1 sʂ
+    UINT64 uploadSize = 0;
+    d3dDevice->GetCopyableFootprints(&resDesc, 0, 1, 0, &atlasFootprint_, nullptr, nullptr, &uploadSize);
+
+    heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+    D3D12_RESOURCE_DESC uploadDesc{};
+    uploadDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    uploadDesc.Width = uploadSize;
+    uploadDesc.Height = 1;
+    uploadDesc.DepthOrArraySize = 1;
+    uploadDesc.MipLevels = 1;
+    uploadDesc.SampleDesc.Count = 1;
+    uploadDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+    if (FAILED(d3dDevice->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &uploadDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+                                                  IID_PPV_ARGS(&atlasUpload_)))) {
+        assert(false && "AgX̓]̍쐬Ɏs");
+        return false;
+    }
+    uint8_t*    mapped = nullptr;
+    D3D12_RANGE readRange{ 0, 0 };
+    if (FAILED(atlasUpload_->Map(0, &readRange, reinterpret_cast<void**>(&mapped)))) {
+        return false;
+    }
+    for (uint32_t y = 0; y < font.atlasHeight; ++y) {
+        std::memcpy(mapped + atlasFootprint_.Offset + size_t(y) * atlasFootprint_.Footprint.RowPitch, &font.atlas[size_t(y) * font.atlasWidth],
+                    font.atlasWidth);
+    }
+    atlasUpload_->Unmap(0, nullptr);
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
+    srvDesc.Format = DXGI_FORMAT_R8_UNORM;
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.Texture2D.MipLevels = 1;
+    d3dDevice->CreateShaderResourceView(atlas_, &srvDesc, srvHeap_.get()->GetCPUDescriptorHandleForHeapStart());
+    atlasPending_ = true;
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	UI `悷
+ * @param	commandList		R}hXg
+ * @param	batch			UI ob`
+ * @param	frameIndex		t[ԍ
+ * @param	viewportWidth	r[|[g̕isNZj
+ * @param	viewportHeight	r[|[g̍
+ * @return	`R[
+ */
+uint32_t UiRenderer::render(ID3D12GraphicsCommandList* commandList, const UiBatch& batch, uint32_t frameIndex, float viewportWidth,
+                            float viewportHeight) noexcept {
+    assert(rootSignature_ && "UI `悪쐬ł");
+
+    ring_.beginFrame(frameIndex);
+
+    // AgX̓]͍ŏ 1 񂾂ς
+    if (atlasPending_) {
+        D3D12_TEXTURE_COPY_LOCATION destination{};
+        destination.pResource = atlas_;
+        destination.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
+        destination.SubresourceIndex = 0;
+        D3D12_TEXTURE_COPY_LOCATION source{};
+        source.pResource = atlasUpload_;
+        source.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
+        source.PlacedFootprint = atlasFootprint_;
+        commandList->CopyTextureRegion(&destination, 0, 0, 0, &source, nullptr);
+
+        D3D12_RESOURCE_BARRIER barrier{};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Transition.pResource = atlas_;
+        barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_COPY_DEST;
+        barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        commandList->ResourceBarrier(1, &barrier);
+        atlasPending_ = false;
+    }
+
+    // pCvC쐬͕̂`Ȃ
+    ID3D12PipelineState* pipelineState = pipelineCache_->get(pipeline_);
+    const uint32_t       count = batch.quadCount();
+    if (!pipelineState || count == 0) {
+        return 0;
+    }
+    UploadRing::Allocation allocation{};
+    if (!ring_.allocate(uint64_t(sizeof(UiQuad)) * count, alignof(UiQuad), allocation)) {
+        assert(false && "UI ̃O܂");
+        return 0;
+    }
+    std::memcpy(allocation.cpuAddress, batch.quads(), sizeof(UiQuad) * count);
+
+    D3D12_VERTEX_BUFFER_VIEW view{};
+    view.BufferLocation = allocation.gpuAddress;
+    view.SizeInBytes = static_cast<UINT>(allocation.size);
+    view.StrideInBytes = sizeof(UiQuad);
+
+    const float           inverseViewport[2] = { 1.0f / viewportWidth, 1.0f / viewportHeight };
+    ID3D12DescriptorHeap* heaps[] = { srvHeap_.get() };
+    commandList->SetDescriptorHeaps(1, heaps);
+    commandList->SetGraphicsRootSignature(rootSignature_->get());
+    commandList->SetGraphicsRoot32BitConstants(0, 2, inverseViewport, 0);
+    commandList->SetGraphicsRootDescriptorTable(1, srvHeap_.get()->GetGPUDescriptorHandleForHeapStart());
+    commandList->SetPipelineState(pipelineState);
+    commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP);
+    commandList->IASetVertexBuffers(0, 1, &view);
+    commandList->DrawInstanced(4, count, 0, 0);
+    return 1;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	AgX
+ */
+void UiRenderer::releaseAtlas() noexcept {
+    if (atlasUpload_) {
+        atlasUpload_->Release();
+        atlasUpload_ = nullptr;
+    }
+    if (atlas_) {
+        atlas_->Release();
+        atlas_ = nullptr;
+    }
+    atlasPending_ = false;
+}
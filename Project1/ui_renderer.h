@@ -0,0 +1,93 @@
+// UI `NX
+
+#pragma once
+
+#include "descriptor_heap.h"
+#include "device.h"
+#include "pipeline_state_cache.h"
+#include "root_signature_cache.h"
+#include "shader.h"
+#include "ui_batch.h"
+#include "upload_ring.h"
+#include <cstdint>
+#include <d3d12.h>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	UI `NX
+ * @details	UiBatch ̎lp`Abv[hOւ̂܂܎ʂADrawInstanced(4, n) 1 ŕ`
+ *			PFƕ͓pCvCŁAlp`Ƃ sdfRange ŃsNZVF[_hς
+ *			AgX 1 ̂ŁA setFont œn 1 ̃tHgŕ`
+ */
+class UiRenderer final {
+public:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    UiRenderer() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~UiRenderer();
+
+    // Rs[֎~
+    UiRenderer(const UiRenderer&) = delete;
+    UiRenderer& operator=(const UiRenderer&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	쐬
+     * @param	device				foCXNX̃CX^X
+     * @param	rootSignatureCache	[gVOl`LbV
+     * @param	pipelineCache		pCvCXe[gLbV
+     * @param	maxQuads			1 t[ɕ`ő̎lp`
+     * @param	frameCount			 GPU QƂt[
+     * @param	renderTargetFormat	`ރ_[^[Qbǧ`
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, RootSignatureCache& rootSignatureCache, PipelineStateCache& pipelineCache, uint32_t maxQuads,
+                              uint32_t frameCount, DXGI_FORMAT renderTargetFormat) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̃AgXi]͎ render ŃR}hXgɐςށj
+     * @param	device	foCXNX̃CX^X
+     * @param	font	tHg
+     * @return	 true
+     */
+    [[nodiscard]] bool setFont(const Device& device, const SdfFont& font) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	UI `悷
+     * @param	commandList		R}hXgi_[^[QbgEr[|[g͐ݒς݂̂ƁBfBXNv^q[v͍ւj
+     * @param	batch			UI ob`
+     * @param	frameIndex		t[ԍ
+     * @param	viewportWidth	r[|[g̕isNZj
+     * @param	viewportHeight	r[|[g̍
+     * @return	`R[BŐ󂫂ȂpCvC쐬Ȃ 0
+     */
+    uint32_t render(ID3D12GraphicsCommandList* commandList, const UiBatch& batch, uint32_t frameIndex, float viewportWidth,
+                    float viewportHeight) noexcept;
+
+private:
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	AgX
+     */
+    void releaseAtlas() noexcept;
+
+    Shader                             shader_{};          /// UI pVF[_
+    const RootSignature*               rootSignature_{};   /// [gVOl`iLbVLj
+    PipelineStateCache*                pipelineCache_{};   /// pCvCXe[gLbV
+    PipelineStateCache::Handle         pipeline_{};        /// pCvC
+    UploadRing                         ring_{};            /// lp`̃O
+    DescriptorHeap                     srvHeap_{};         /// AgX SRV 1 iVF[_猩j
+    ID3D12Resource*                    atlas_{};           /// AgXiR8j
+    ID3D12Resource*                    atlasUpload_{};     /// AgX̓]iAbv[hq[vj
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT atlasFootprint_{};  /// ]̕
+    bool                               atlasPending_{};    /// ]܂ςłȂ true
+};
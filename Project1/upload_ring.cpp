@@ -0,0 +1,82 @@
+// Abv[hONX
+
+#include "upload_ring.h"
+#include <cassert>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief    fXgN^
+ */
+UploadRing::~UploadRing() {
+    if (buffer_) {
+        buffer_->Unmap(0, nullptr);
+        buffer_->Release();
+        buffer_ = nullptr;
+    }
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	O쐬
+ * @param	device		foCXNX̃CX^X
+ * @param	capacity	oCg
+ * @param	frameCount	 GPU QƂt[
+ * @return	 true
+ */
+[[nodiscard]] bool UploadRing::create(const Device& device, uint64_t capacity, uint32_t frameCount) noexcept {
+    D3D12_HEAP_PROPERTIES heapProps{};
+    heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+    D3D12_RESOURCE_DESC resDesc{};
+    resDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    resDesc.Width = capacity;
+    resDesc.Height = 1;
+    resDesc.DepthOrArraySize = 1;
+    resDesc.MipLevels = 1;
+    resDesc.SampleDesc.Count = 1;
+    resDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    const auto res = device.get()->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resDesc,
+                                                           D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&buffer_));
+    if (FAILED(res)) {
+        assert(false && "Abv[hO̍쐬Ɏs");
+        return false;
+    }
+
+    // CPU ͏ނȂ̂œǂݎ͈͂͋
+    D3D12_RANGE readRange{ 0, 0 };
+    if (FAILED(buffer_->Map(0, &readRange, reinterpret_cast<void**>(&mapped_)))) {
+        assert(false && "Abv[hO Map Ɏs");
+        return false;
+    }
+    gpuAddress_ = buffer_->GetGPUVirtualAddress();
+
+    allocator_.create(capacity, frameCount);
+    return true;
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	t[Jn
+ * @param	frameIndex	t[ԍ
+ */
+void UploadRing::beginFrame(uint32_t frameIndex) noexcept {
+    allocator_.beginFrame(frameIndex);
+}
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	̈mۂ
+ * @param	size		oCg
+ * @param	alignment	ACg
+ * @param	allocation	mۂ̈̊i[
+ * @return	󂫂 true
+ */
+[[nodiscard]] bool UploadRing::allocate(uint64_t size, uint64_t alignment, Allocation& allocation) noexcept {
+    const auto offset = allocator_.allocate(size, alignment);
+    if (offset == RingAllocator::InvalidOffset) {
+        return false;
+    }
+    allocation = { mapped_ + offset, gpuAddress_ + offset, size };
+    return true;
+}
@@ -0,0 +1,73 @@
+// Abv[hONX
+
+#pragma once
+
+#include "device.h"
+#include "ring_allocator.h"
+#include <cstdint>
+#include <d3d12.h>
+
+//---------------------------------------------------------------------------------
+/**
+ * @brief	Abv[hONX
+ * @details	쐬 1 񂾂 Map Abv[hq[v RingAllocator Ő؂蕪
+ *			t[钸_ECX^XE萔f[^ VertexBuffer::create Œu
+ */
+class UploadRing final {
+public:
+    /// mۂ̈
+    struct Allocation {
+        void*                     cpuAddress;  ///< ݐ
+        D3D12_GPU_VIRTUAL_ADDRESS gpuAddress;  ///< GPU 猩AhX
+        uint64_t                  size;        ///< oCg
+    };
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    RXgN^
+     */
+    UploadRing() = default;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief    fXgN^
+     */
+    ~UploadRing();
+
+    // Rs[֎~
+    UploadRing(const UploadRing&) = delete;
+    UploadRing& operator=(const UploadRing&) = delete;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	O쐬
+     * @param	device		foCXNX̃CX^X
+     * @param	capacity	oCg
+     * @param	frameCount	 GPU QƂt[
+     * @return	 true
+     */
+    [[nodiscard]] bool create(const Device& device, uint64_t capacity, uint32_t frameCount) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	t[Jnĩt[ԍ̑O GPU IĂĂԁj
+     * @param	frameIndex	t[ԍ
+     */
+    void beginFrame(uint32_t frameIndex) noexcept;
+
+    //---------------------------------------------------------------------------------
+    /**
+     * @brief	̈mۂ
+     * @param	size		oCg
+     * @param	alignment	ACg
+     * @param	allocation	mۂ̈̊i[
+     * @return	󂫂 true
+     */
+    [[nodiscard]] bool allocate(uint64_t size, uint64_t alignment, Allocation& allocation) noexcept;
+
+private:
+    ID3D12Resource*           buffer_{};      /// Abv[hq[ṽobt@
+    uint8_t*                  mapped_{};      /// Map 
+    D3D12_GPU_VIRTUAL_ADDRESS gpuAddress_{};  /// obt@ GPU AhX
+    RingAllocator             allocator_{};   /// ؂oʒůǗ
+};